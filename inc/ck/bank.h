@@ -62,6 +62,18 @@ public:
       */
     static CkBank* newBankFromMemory(void*, int bytes);
 
+    /** Loads a bank by mapping the file into memory. 
+      Sample data is read from the file as it is first played, rather than
+      all at once, and is shared with other processes that map the same file;
+      only the table of sounds is copied into memory.
+      If the file cannot be mapped (for example, on Windows Phone 8, on Android if it is an asset,
+      or if a custom file handler has been set), the bank is loaded with newBank() instead.
+      This will return NULL if the bank cannot be loaded.
+      If the bank file is embedded in a larger file, specify the offset and 
+      length of the embedded data; otherwise, leave them both as 0.
+      */
+    static CkBank* newBankMapped(const char* path, CkPathType = kCkPathType_Default, int offset = 0, int length = 0);
+
 
     /** Finds a loaded bank by name; returns NULL if not found. */
     static CkBank* find(const char* bankName);
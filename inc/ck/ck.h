@@ -30,6 +30,30 @@ void CkSuspend(void);
 void CkResume(void);
 
 
+/** Initializes Cricket Audio for offline rendering.  No audio output device is used;
+  instead, audio is rendered only when CkRenderOffline() is called, as fast as the
+  processor allows.  Use CkShutdown() when done.  Returns nonzero if successful. */
+int CkInitOffline(CkConfig*);
+
+/** Renders the next frames of the final audio output, after initializing with CkInitOffline().
+  The output is interleaved stereo 32-bit floating-point samples at the rate returned by
+  CkGetOutputSampleRate(), so the buffer must have room for 2*frames samples.  Any number
+  of frames may be rendered in one call.  Call CkUpdate() between calls, as you would once
+  per frame when rendering in real time.  Returns nonzero if any sounds were playing. */
+int CkRenderOffline(int frames, float* buf);
+
+/** Returns the sample rate of the final audio output, in Hz. */
+int CkGetOutputSampleRate(void);
+
+/** Returns the sample time of the final audio output: the number of sample frames
+  (at the rate returned by CkGetOutputSampleRate()) rendered since initialization.
+  It does not advance while Cricket Audio is suspended.  Use it with CkSound::playAt(),
+  CkSound::stopAt(), and CkSound::setVolumeAt() to schedule changes to the exact
+  sample frame; to be sure a change arrives in time, schedule it at least
+  CkConfig.audioUpdateMs ahead of this value. */
+long long CkGetSampleTime(void);
+
+
 /** Returns a rough estimate of the load on the audio processing thread.
   This is the fraction of the interval between audio callbacks that was actually spent
   rendering audio; it will range between 0 and 1. */
@@ -46,6 +70,62 @@ int CkGetClipFlag(void);
   exceeds the maximum value. */
 void CkResetClipFlag(void);
 
+/** Returns the gain reduction, in dB, applied by the output limiter to the most
+  recently rendered audio (see CkConfig.outputLimiter); 0 if there is no limiter.
+  This does not lock the audio thread. */
+float CkGetOutputGainReduction(void);
+
+
+/** Statistics about the cache of decoded sound data; see CkGetDecodeCacheStats()
+  and CkConfig.decodeCacheBytes. */
+typedef struct _CkDecodeCacheStats
+{
+    /** Number of times a sound used data that was already decoded. */
+    int hits;
+
+    /** Number of times a sound's data was decoded and added to the cache. */
+    int misses;
+
+    /** Number of times data was discarded to make room for other data. */
+    int evictions;
+
+    /** Number of times a sound's data was not cached because the cache was full
+      of data in use. */
+    int overflows;
+
+    /** Number of sounds whose data is in the cache. */
+    int entries;
+
+    /** Total size of the data in the cache, in bytes. */
+    int bytes;
+
+    /** Size of the data in the cache that cannot be discarded, because it is in
+      use by a sound or belongs to a "hot" sound, in bytes. */
+    int pinnedBytes;
+} CkDecodeCacheStats;
+
+/** Gets statistics about the cache of decoded sound data. */
+void CkGetDecodeCacheStats(CkDecodeCacheStats*);
+
+
+/** Numbers of real and virtual sounds, as of the most recent call to
+  CkUpdate(); see CkGetVoiceStats() and CkConfig.maxRealVoices. */
+typedef struct _CkVoiceStats
+{
+    /** Number of playing sounds that are rendered. */
+    int realVoices;
+
+    /** Number of playing sounds that are virtual (see CkSound::isVirtual()). */
+    int virtualVoices;
+
+    /** Number of sounds that were made virtual in the most recent update because
+      the limit on real voices was exceeded. */
+    int stolenVoices;
+} CkVoiceStats;
+
+/** Gets the numbers of real and virtual sounds. */
+void CkGetVoiceStats(CkVoiceStats*);
+
 
 /** Sets the maximum rate at which volumes change on playing sounds, in ms per full volume scale. 
   Default value is 40 ms. */
@@ -78,6 +158,16 @@ void CkStartCapture(const char* path, CkPathType pathType);
 void CkStopCapture(void);
 
 
+/** Start recording when each sound, mixer, effect bus and effect is rendered, and how
+  long it takes, to a file.  The file is in the Chrome trace event JSON format, which
+  can be opened in Perfetto (ui.perfetto.dev) or chrome://tracing.  Recording adds
+  little overhead; events are written to the file during CkUpdate(). */
+void CkStartRenderTrace(const char* path, CkPathType pathType);
+
+/** Stop recording the render trace, and close the file. */
+void CkStopRenderTrace(void);
+
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
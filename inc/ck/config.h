@@ -6,6 +6,7 @@
 
 #pragma once
 #include "ck/platform.h"
+#include "ck/resamplequality.h"
 
 #if CK_PLATFORM_ANDROID
 #  include <jni.h>
@@ -59,6 +60,24 @@ typedef enum
 } CkSampleType;
 
 
+/** Levels of SIMD instructions used for audio processing */
+typedef enum
+{
+    /** Don't use SIMD instructions */
+    kCkSimdLevel_None,
+
+    /** Use 128-bit SIMD instructions (SSE2 on x86, NEON on ARM) */
+    kCkSimdLevel_Basic,
+
+    /** Use 256-bit AVX2 and FMA instructions where available (x86 only) */
+    kCkSimdLevel_Avx2,
+
+    /** Use the highest level supported by the processor */
+    kCkSimdLevel_Default
+
+} CkSimdLevel;
+
+
 ////////////////////////////////////////
 
 /** Configuration options */
@@ -155,15 +174,33 @@ struct _CkConfig
       Default is 500 ms. */
     float streamBufferMs;
 
-    /** Interval between file reads for stream sounds, in ms.
-      Shorter times will allow for smaller stream buffer sizes, but require more CPU.
-      This value should be set to significantly less than streamBufferMs, or your buffers will always underrun!
+    /** Maximum interval between checks of stream sound buffers, in ms.
+      Stream buffers are normally refilled as soon as they fall to half full; this
+      is a fallback in case a refill request is missed.
+      This value should be set to significantly less than streamBufferMs, or your buffers may underrun!
       Default is 100 ms. */
     float streamFileUpdateMs;
 
-    /** Initial size of the audio task buffer.  If you see a "Reallocating
-      audio task buffer" warning, consider increasing this from its default value
-      of 500 to avoid additional memory allocations at runtime. */
+    /** Amount of audio decoded before a stream sound that has just been
+      started or repositioned is ready to play, in ms.  The rest of the stream
+      buffer is filled afterward; streams that are priming are read before
+      streams that are refilling.
+      Default is 100 ms. */
+    float streamPrimeMs;
+
+    /** Number of threads used to read and decode stream sounds.
+      The stream closest to running out of buffered audio is always refilled first,
+      so with more than one thread, a slow file read or decode for one stream does
+      not delay the others.
+      Default is 2. */
+    int streamThreads;
+
+    /** Size of the audio task buffer, which passes commands to the audio thread
+      without locking.  If you see an "Audio task buffer is full" warning, consider 
+      increasing this from its default value of 500; commands that don't fit are held
+      on the main thread until the audio thread catches up.  This is also the number
+      of commands scheduled with CkSound::playAt() and similar that can wait for their
+      time; any more are executed early, with a warning. */
     int maxAudioTasks;
 
     /** Maximum render load. When the value of CkGetRenderLoad() exceeds this value,
@@ -171,11 +208,63 @@ struct _CkConfig
       Default is 0.8. */
     float maxRenderLoad;
 
+    /** Number of threads used to render audio, including the audio output thread.
+      If greater than 1, sounds and effect buses attached to the final mix are
+      rendered in parallel on a pool of worker threads; the output is the same as
+      with a single thread.  Custom effect processors may be called from any of
+      these threads, but each processor is only called from one thread at a time.
+      Default is 1 (all rendering is done on the audio output thread). */
+    int renderThreads;
+
     /** Sample type to be used internally for processing.  The default is 
       kCkSampleType_Default, which means that fixed-point samples are used on Android 
       armv5 and armv6 devices, which may lack hardware support for floating-point 
       operations, and that floating-point samples are used on all other devices. */
     CkSampleType sampleType;
+
+    /** Resampling method used for sounds whose resample quality is 
+      kCkResampleQuality_Default (see CkSound::setResampleQuality()).
+      Default is kCkResampleQuality_Linear. */
+    CkResampleQuality resampleQuality;
+
+    /** Highest level of SIMD instructions to use for audio processing.  If the
+      processor does not support this level, the highest level it does support
+      is used.  This is mostly useful for testing or for comparing performance.
+      On platforms with environment variables, setting CK_SIMD to "none", "basic",
+      or "avx2" overrides this value.
+      Default is kCkSimdLevel_Default (highest level supported by the processor). */
+    CkSimdLevel maxSimdLevel;
+
+    /** Size of the cache of decoded sound data, in bytes.  Bank sounds in ADPCM
+      or lossless format that are at most decodeCacheMaxSoundBytes when decoded,
+      or that are marked "hot" in the bank description file, are decoded once,
+      and the decoded data is shared by every sound that plays them.  When the cache is full, the least
+      recently used data that no sound is using is discarded.  Data for hot sounds is
+      kept until their bank is destroyed.  See CkGetDecodeCacheStats().
+      Default is 0 (no cache). */
+    int decodeCacheBytes;
+
+    /** Largest size, in bytes, of the decoded data of a bank sound that is not marked
+      "hot" for it to be kept in the decode cache (see decodeCacheBytes).
+      Default is 262144 (256 KB). */
+    int decodeCacheMaxSoundBytes;
+
+    /** If nonzero, the final mix goes through a true-peak look-ahead limiter,
+      instead of being clipped where it exceeds the maximum output level.  The
+      limiter delays the output by about 5 ms.  See CkGetOutputGainReduction().
+      Default is 0 (the output is clipped). */
+    int outputLimiter;
+
+    /** Highest output level of the limiter (see outputLimiter), in dB below full
+      scale.  Default is -1 dB. */
+    float outputLimiterCeiling;
+
+    /** Maximum number of sounds that are rendered at once.  If more sounds are
+      playing, the ones whose priority times volume is lowest become virtual
+      (see CkSound::setPriority() and CkSound::isVirtual()); this is updated
+      each time CkUpdate() is called.  See CkGetVoiceStats().
+      Default is 0 (no limit). */
+    int maxRealVoices;
 };
 
 typedef struct _CkConfig CkConfig;
@@ -189,12 +278,33 @@ extern const float CkConfig_streamBufferMsDefault;
 /** Default value of CkConfig.streamFileUpdateMs */
 extern const float CkConfig_streamFileUpdateMsDefault;
 
+/** Default value of CkConfig.streamPrimeMs */
+extern const float CkConfig_streamPrimeMsDefault;
+
+/** Default value of CkConfig.streamThreads */
+extern const int CkConfig_streamThreadsDefault;
+
 /** Default value of CkConfig.maxAudioTasks */
 extern const int CkConfig_maxAudioTasksDefault;
 
 /** Default value of CkConfig.maxRenderLoad */
 extern const float CkConfig_maxRenderLoadDefault;
 
+/** Default value of CkConfig.renderThreads */
+extern const int CkConfig_renderThreadsDefault;
+
+/** Default value of CkConfig.decodeCacheBytes */
+extern const int CkConfig_decodeCacheBytesDefault;
+
+/** Default value of CkConfig.decodeCacheMaxSoundBytes */
+extern const int CkConfig_decodeCacheMaxSoundBytesDefault;
+
+/** Default value of CkConfig.outputLimiterCeiling */
+extern const float CkConfig_outputLimiterCeilingDefault;
+
+/** Default value of CkConfig.maxRealVoices */
+extern const int CkConfig_maxRealVoicesDefault;
+
 ////////////////////////////////////////
 
 #ifdef __OBJC__
@@ -7,9 +7,11 @@
 #pragma once
 #include "ck/platform.h"
 #include "ck/effecttype.h"
+#include "ck/pathtype.h"
 #include <stddef.h>
 
 class CkEffectProcessor;
+class CkBank;
 
 
 /** An audio effect. */
@@ -51,11 +53,35 @@ public:
     virtual float getWetDryRatio() const = 0;
 
 
+    /** Gets the gain reduction, in dB, applied by a Compressor effect to the
+      most recently processed audio (0 means none).  Returns 0 for other effects.
+      This does not lock the audio thread, so it can be called every frame to
+      drive a meter. */
+    virtual float getGainReduction() const = 0;
+
+
     /** Create a built-in effect. 
       Effect types are found in ck/effecttype.h. */
     static CkEffect* newEffect(CkEffectType);
 
 
+    /** Create a convolution reverb effect, using a sound in a bank as its impulse response.
+      The impulse response may be mono or stereo; it is resampled to the output
+      sample rate and normalized.  The reverb output is delayed by 128 frames.
+      If bank is NULL, all loaded banks are searched for the first sound with
+      the given name.
+      Returns NULL if the sound is not found or can't be decoded.
+      See kCkConvolutionReverbParam values for parameter IDs. */
+    static CkEffect* newConvolutionReverb(CkBank* bank, const char* soundName);
+
+    /** Create a convolution reverb effect, using a .wav file as its impulse response.
+      The impulse response may be mono or stereo; it is resampled to the output
+      sample rate and normalized.  The reverb output is delayed by 128 frames.
+      Returns NULL if the file can't be read.
+      See kCkConvolutionReverbParam values for parameter IDs. */
+    static CkEffect* newConvolutionReverb(const char* path, CkPathType = kCkPathType_Default);
+
+
     /** Factory function for creating effect processors for custom effects. */
     typedef CkEffectProcessor* (*CustomEffectFunc)(void* arg);
 
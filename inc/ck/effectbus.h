@@ -64,6 +64,13 @@ public:
       "dry" signal is not mixed back into the processed audio. */
     virtual float getWetDryRatio() const = 0;
 
+
+    /** Gets the fraction of real time spent rendering this bus, averaged over
+      about 100 ms.  This includes the effects on the bus and the sounds and
+      buses whose output is sent to it, so it is comparable to CkGetRenderLoad().
+      This does not lock the audio thread. */
+    virtual float getRenderLoad() const = 0;
+
     ////////////////////////////////////////
 
     /** Create a new effect bus. */
@@ -88,6 +88,67 @@ enum
     kCkDistortionParam_Offset,
 };
 
+////////////////////////////////////////
+
+
+/** Parameters for the Reverb effect.
+  Changes are smoothed over a few tens of milliseconds; the room size changes
+  more slowly, since its delays can only change gradually. */
+enum
+{
+    /** Room size, from 0 (small) to 1 (large); the default is 0.5. */
+    kCkReverbParam_Size,
+
+    /** Time (in seconds) for the reverb to decay by 60 dB, in [0.1..30]; the default is 1.5. */
+    kCkReverbParam_DecayTime,
+
+    /** Damping of high frequencies, from 0 (bright) to 1 (dark); the default is 0.5. */
+    kCkReverbParam_Damping,
+
+    /** Milliseconds before the reverb starts, in [0..100]; the default is 20. */
+    kCkReverbParam_PreDelayMs,
+};
+
+////////////////////////////////////////
+
+
+/** Parameters for the Compressor effect. */
+enum
+{
+    /** Level (in dB) above which the gain is reduced, in [-60..0]; the default is -12. */
+    kCkCompressorParam_Threshold,
+
+    /** Amount of compression above the threshold, in [1..1000]; each dB above
+      the threshold becomes 1/ratio dB.  The default is 4.  A ratio of 1000 is
+      treated as infinite, for a limiter. */
+    kCkCompressorParam_Ratio,
+
+    /** Look-ahead time (in ms), in [0..20]; the default is 5.  This is also the
+      attack time, and the amount the output is delayed.  Changing it while
+      audio is playing may cause a click. */
+    kCkCompressorParam_LookaheadMs,
+
+    /** Time (in ms) for the gain to recover, in [1..5000]; the default is 100. */
+    kCkCompressorParam_ReleaseMs,
+
+    /** Gain (in dB) applied after compression, in [0..40]; the default is 0. */
+    kCkCompressorParam_MakeupGain,
+
+    /** If nonzero, peaks between samples are detected too, so the output stays
+      below the threshold after conversion to analog; the default is 0. */
+    kCkCompressorParam_TruePeak,
+};
+
+////////////////////////////////////////
+
+
+/** Parameters for the Convolution Reverb effect */
+enum
+{
+    /** Gain applied to the reverb output; the default is 1. */
+    kCkConvolutionReverbParam_Gain,
+};
+
 
 
 
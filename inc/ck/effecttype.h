@@ -27,6 +27,17 @@ typedef enum
       See kCkDistortionParam values for parameter IDs. */
     kCkEffectType_Distortion,
 
+    /** Reverb effect simulates the reflections of a room, with a feedback delay network.
+      It is cheap enough to use one on each of many effect buses.
+      See kCkReverbParam values for parameter IDs. */
+    kCkEffectType_Reverb,
+
+    /** Compressor effect reduces the level of loud audio, with a look-ahead
+      window so peaks are caught before they are output; with a high ratio, it
+      is a limiter.  Output is delayed by the look-ahead time.
+      See kCkCompressorParam values for parameter IDs, and CkEffect::getGainReduction(). */
+    kCkEffectType_Compressor,
+
 } CkEffectType;
 
 
@@ -23,6 +23,9 @@
 + (nullable CkoBank*) newBankAsync:(nonnull NSString*)path pathType:(CkPathType)pathType;
 + (nullable CkoBank*) newBankAsync:(nonnull NSString*)path pathType:(CkPathType)pathType offset:(int)offset length:(int)length;
 + (nullable CkoBank*) newBankFromMemory:(nonnull void*)buf bytes:(int)bytes;
++ (nullable CkoBank*) newBankMapped:(nonnull NSString*)path;
++ (nullable CkoBank*) newBankMapped:(nonnull NSString*)path pathType:(CkPathType)pathType;
++ (nullable CkoBank*) newBankMapped:(nonnull NSString*)path pathType:(CkPathType)pathType offset:(int)offset length:(int)length;
 
 + (nullable CkoBank*) find:(nonnull NSString*)name;
 
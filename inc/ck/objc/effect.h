@@ -3,6 +3,9 @@
 
 #import <Foundation/Foundation.h>
 #import "ck/effecttype.h"
+#import "ck/objc/pathtype.h"
+
+@class CkoBank;
 
 
 /** Objective-C interface for CkEffect.
@@ -11,6 +14,7 @@
 
 @property(nonatomic, assign) BOOL bypassed;
 @property(nonatomic, assign) float wetDryRatio;
+@property(nonatomic, readonly) float gainReduction;
 
 - (void) setParam:(int)paramId value:(float)value;
 
@@ -18,6 +22,9 @@
 
 + (nullable CkoEffect*) newEffect:(CkEffectType)type;
 + (nullable CkoEffect*) newCustomEffect:(int)id;
++ (nullable CkoEffect*) newConvolutionReverb:(nullable CkoBank*)bank name:(nonnull NSString*)name;
++ (nullable CkoEffect*) newConvolutionReverb:(nonnull NSString*)path;
++ (nullable CkoEffect*) newConvolutionReverb:(nonnull NSString*)path pathType:(CkPathType)pathType;
 
 @end
 
@@ -11,6 +11,7 @@
 
 @property(nonatomic, assign) BOOL bypassed;
 @property(nonatomic, assign) float wetDryRatio;
+@property(nonatomic, readonly) float renderLoad;
 @property(nonatomic, assign, nullable) CkoEffectBus* outputBus;
 
 - (void) addEffect:(nonnull CkoEffect*)effect;
@@ -0,0 +1,6 @@
+// Copyright 2016 Cricket Technology
+// www.crickettechnology.com
+
+#import "ck/resamplequality.h"
+
+
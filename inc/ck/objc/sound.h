@@ -3,6 +3,8 @@
 
 #import "ck/objc/pathtype.h"
 #import "ck/objc/attenuationmode.h"
+#import "ck/objc/resamplequality.h"
+#import "ck/objc/soundid.h"
 
 @class CkoBank;
 @class CkoMixer;
@@ -29,6 +31,8 @@
 @property(nonatomic, assign) float pan;
 @property(nonatomic, assign) float pitchShift;
 @property(nonatomic, assign) float speed;
+@property(nonatomic, assign) CkResampleQuality resampleQuality;
+@property(nonatomic, assign) float priority;
 @property(nonatomic, assign, nullable) CkoSound* nextSound;
 @property(nonatomic, readonly) int length;
 @property(nonatomic, readonly) float lengthMs;
@@ -40,6 +44,10 @@
 
 - (void) play;
 - (void) stop;
+- (void) playAt:(long long)sampleTime;
+- (void) stopAt:(long long)sampleTime;
+
+- (void) setVolume:(float)volume at:(long long)sampleTime;
 
 - (void) setLoop:(int)startFrame endFrame:(int)endFrame;
 - (void) releaseLoop;
@@ -74,6 +82,8 @@
 
 + (nullable CkoSound*) newBankSound:(nullable CkoBank*)bank index:(int)index;
 + (nullable CkoSound*) newBankSound:(nullable CkoBank*)bank name:(nonnull NSString*)name;
++ (nullable CkoSound*) newBankSound:(nullable CkoBank*)bank soundId:(CkSoundId)soundId;
++ (CkSoundId) getSoundId:(nonnull NSString*)name;
 + (nullable CkoSound*) newStreamSound:(nonnull NSString*)path; 
 + (nullable CkoSound*) newStreamSound:(nonnull NSString*)path pathType:(CkPathType)pathType;
 + (nullable CkoSound*) newStreamSound:(nonnull NSString*)path pathType:(CkPathType)pathType offset:(int)offset length:(int)length extension:(nonnull NSString*)extension;
@@ -0,0 +1,32 @@
+// Copyright 2016 Cricket Technology
+// www.crickettechnology.com
+/** @file */
+/** @defgroup CkResampleQuality CkResampleQuality */
+/** @{ */
+
+#pragma once
+#include "ck/platform.h"
+
+
+/** Indicates how sounds are resampled when their sample rate or playback speed
+  does not match the output sample rate. */
+typedef enum 
+{
+
+    /** Use the value of CkConfig.resampleQuality. */
+    kCkResampleQuality_Default = 0,
+
+    /** Linear interpolation.  This is the cheapest method, but high frequencies
+     are attenuated, and sounds played faster than their original speed may
+     have audible aliasing. */
+    kCkResampleQuality_Linear,
+
+    /** Band-limited interpolation with a windowed-sinc filter.  This is free
+     of audible aliasing, but takes several times as much CPU as linear
+     interpolation, and delays the sound by 17 frames. */
+    kCkResampleQuality_Sinc,
+
+} CkResampleQuality;
+
+/** @} */
+
@@ -8,6 +8,8 @@
 #include "ck/platform.h"
 #include "ck/pathtype.h"
 #include "ck/attenuationmode.h"
+#include "ck/resamplequality.h"
+#include "ck/soundid.h"
 #include <stddef.h>
 
 
@@ -16,6 +18,40 @@ class CkMixer;
 class CkEffectBus;
 class CkCustomStream;
 
+/** Statistics about how well a stream sound's buffer is being kept filled;
+  see CkSound::getStreamStats(). */
+struct CkStreamStats
+{
+    /** Number of times playback ran out of buffered audio, causing a skip. */
+    int underruns;
+
+    /** Number of times the buffer was refilled after falling to half full. */
+    int fills;
+
+    /** Average time from the buffer falling to half full until a refill started, in ms. */
+    float avgLatencyMs;
+
+    /** Maximum time from the buffer falling to half full until a refill started, in ms. */
+    float maxLatencyMs;
+
+    /** Average time spent reading and decoding per refill, in ms. */
+    float avgFillMs;
+
+    /** Maximum time spent reading and decoding per refill, in ms. */
+    float maxFillMs;
+
+    /** Number of times the buffer was primed after the sound was started or repositioned. */
+    int primes;
+
+    /** Maximum time spent reading and decoding to prime the buffer, in ms.
+      This is most of the delay before a newly started sound is ready to play. */
+    float maxPrimeMs;
+
+    /** Amount of audio currently buffered, in ms. */
+    float bufferedMs;
+};
+
+
 /** A sound (either memory-resident or streamed). */
 
 class CkSound 
@@ -44,6 +80,20 @@ public:
     /** Stop the sound. */
     virtual void stop() = 0;
 
+    /** Play the sound at the given sample time of the audio output (see CkGetSampleTime()).
+      The sound starts at exactly that sample frame.  If that time has already passed,
+      the sound plays as soon as possible.  Any later call to stop() cancels it.
+     @par Android note: 
+      For streams in formats other than .cks or Ogg Vorbis, this takes effect immediately. */
+    virtual void playAt(long long sampleTime) = 0;
+
+    /** Stop the sound at the given sample time of the audio output (see CkGetSampleTime()).
+      The sound stops at exactly that sample frame; until then, isPlaying() returns true.
+      If that time has already passed, the sound stops as soon as possible.
+     @par Android note: 
+      For streams in formats other than .cks or Ogg Vorbis, this takes effect immediately. */
+    virtual void stopAt(long long sampleTime) = 0;
+
     /** Gets whether the sound is playing. */
     virtual bool isPlaying() const = 0; 
 
@@ -129,6 +179,13 @@ public:
       mixer to which this sound is assigned. */
     virtual void setVolume(float) = 0;
 
+    /** Sets the volume of this sound at the given sample time of the audio output (see
+      CkGetSampleTime()).  getVolume() returns the new value immediately; the sound starts
+      changing to it at exactly that sample frame (at the rate set by CkSetVolumeRampTime()).
+     @par Android note: 
+      For streams in formats other than .cks or Ogg Vorbis, this takes effect immediately. */
+    virtual void setVolumeAt(float, long long sampleTime) = 0;
+
     /** Gets the volume of this sound.
       The volume can range from 0 to 1. The default value is 1. 
       Note that the actual volume used for mixing will also depend on the volume of the 
@@ -198,6 +255,29 @@ public:
     virtual float getSpeed() const = 0;
 
 
+    /** Sets the method used to resample the sound, when its sample rate or speed
+      does not match the output sample rate.  The default value is kCkResampleQuality_Default, 
+      which uses the value of CkConfig.resampleQuality.
+     @par Android note: 
+      This does not work for streams in formats other than .cks or Ogg Vorbis. */
+    virtual void setResampleQuality(CkResampleQuality) = 0;
+
+    /** Gets the method used to resample the sound, when its sample rate or speed
+      does not match the output sample rate.  The default value is kCkResampleQuality_Default. */
+    virtual CkResampleQuality getResampleQuality() const = 0;
+
+
+    /** Sets the priority of the sound, for voice limiting.
+      When more sounds are playing than CkConfig.maxRealVoices allows, the ones
+      with the lowest priority times volume become virtual (see isVirtual()).
+      The default value is 1. */
+    virtual void setPriority(float) = 0;
+
+    /** Gets the priority of the sound, for voice limiting.
+      The default value is 1. */
+    virtual float getPriority() const = 0;
+
+
     /** Sets the sound to be played when this sound finishes playing.
       The next sound will play immediately, with no gaps. 
      @par Android note:
@@ -227,6 +307,11 @@ public:
       Stream sounds will return -1 if they are not ready. */
     virtual int getChannels() const = 0;
 
+    /** Gets statistics about reading and decoding of a stream sound.
+      Returns false if this is not a stream sound, or if it is a stream decoded
+      by the platform (e.g. an MP3 stream on iOS or Android). */
+    virtual bool getStreamStats(CkStreamStats&) const = 0;
+
 
     /** Sets the effect bus to which this sound's audio is sent to be processed, or
       NULL for dry output (no effects).
@@ -253,11 +338,16 @@ public:
       on the sound and listener positions and the attenuation settings. */
     virtual bool is3dEnabled() const = 0;
 
-    /** Gets whether a 3D sound is virtual.
+    /** Gets whether a sound is virtual.
       If, due to distance attenuation, a 3D sound's volume becomes near enough to 0
-      to be inaudible, it becomes "virtual".  A virtual sound is effectively paused
-      and is not processed until it would become audible again; this reduces the 
-      amount of audio processing required. */
+      to be inaudible, it becomes "virtual".  A sound also becomes virtual if more
+      sounds are playing than CkConfig.maxRealVoices allows, and it is one of the
+      least important (see setPriority()).  A virtual sound is not resampled or
+      mixed, but its play position is kept up to date, so it resumes at the right
+      place when it becomes real again; this reduces the amount of audio
+      processing required.
+     @par Android note:
+      Streams in formats other than .cks or Ogg Vorbis are paused while virtual. */
     virtual bool isVirtual() const = 0;
 
     /** Sets the position of the sound emitter in 3D space.
@@ -365,6 +455,17 @@ public:
       This will return NULL if no sound with that name can be found. */
     static CkSound* newBankSound(CkBank*, const char* name);
 
+    /** Creates a sound from a bank by id.
+      If bank is NULL, all loaded banks are searched for the first matching sound. 
+      This will return NULL if no sound with that id can be found. 
+      In the unlikely case that two names in the banks being searched have the
+      same id, either sound may be returned; cktool warns about this within a bank. */
+    static CkSound* newBankSound(CkBank*, CkSoundId);
+
+    /** Returns the id for a bank sound name, for use with newBankSound(CkBank*, CkSoundId).
+      Ids do not depend on which banks are loaded, so they can be computed once ahead of time. */
+    static CkSoundId getSoundId(const char* name);
+
 
     ////////////////////////////////////////
     // streams
@@ -0,0 +1,18 @@
+// Copyright 2016 Cricket Technology
+// www.crickettechnology.com
+/** @file */
+/** @defgroup CkSoundId CkSoundId */
+/** @{ */
+
+#pragma once
+#include "ck/platform.h"
+
+
+/** Identifies a bank sound by a hash of its name; see CkSound::getSoundId().
+  Creating sounds by id skips hashing and comparing the name. */
+typedef struct 
+{
+    unsigned int hash;
+} CkSoundId;
+
+/** @} */
@@ -52,6 +52,13 @@ jlong Java_com_crickettechnology_audio_Bank_nativeNewBankAsync(JNIEnv* env, jcla
     return (jlong) bank;
 }
 
+jlong Java_com_crickettechnology_audio_Bank_nativeNewBankMapped(JNIEnv* env, jclass, jstring pathStr, jint pathType, jint offset, jint length)
+{
+    Cki::JavaStringRef path(env, pathStr);
+    CkBank* bank = CkBank::newBankMapped(path.getChars(), (CkPathType) pathType, offset, length);
+    return (jlong) bank;
+}
+
 jlong Java_com_crickettechnology_audio_Bank_nativeFind(JNIEnv* env, jclass, jstring nameStr)
 {
     Cki::JavaStringRef name(env, nameStr);
@@ -63,6 +63,14 @@ JNIEXPORT jlong JNICALL Java_com_crickettechnology_audio_Bank_nativeNewBank
 JNIEXPORT jlong JNICALL Java_com_crickettechnology_audio_Bank_nativeNewBankAsync
   (JNIEnv *, jclass, jstring, jint);
 
+/*
+ * Class:     com_crickettechnology_audio_Bank
+ * Method:    nativeNewBankMapped
+ * Signature: (Ljava/lang/String;III)J
+ */
+JNIEXPORT jlong JNICALL Java_com_crickettechnology_audio_Bank_nativeNewBankMapped
+  (JNIEnv *, jclass, jstring, jint, jint, jint);
+
 /*
  * Class:     com_crickettechnology_audio_Bank
  * Method:    nativeFind
@@ -116,6 +116,29 @@ void Java_com_crickettechnology_audio_Ck_nativeInit(JNIEnv* env, jclass, jobject
     jfieldID maxRenderLoadId = env->GetFieldID(configClass, "MaxRenderLoad", "F");
     config.maxRenderLoad = env->GetFloatField(configObj, maxRenderLoadId);
 
+    jfieldID resampleQualityId = env->GetFieldID(configClass, "ResampleQuality", "Lcom/crickettechnology/audio/ResampleQuality;");
+    jobject resampleQualityObj = env->GetObjectField(configObj, resampleQualityId);
+    if (resampleQualityObj)
+    {
+        jfieldID valueId = env->GetFieldID(env->GetObjectClass(resampleQualityObj), "value", "I");
+        config.resampleQuality = (CkResampleQuality) env->GetIntField(resampleQualityObj, valueId);
+    }
+
+    jfieldID decodeCacheBytesId = env->GetFieldID(configClass, "DecodeCacheBytes", "I");
+    config.decodeCacheBytes = env->GetIntField(configObj, decodeCacheBytesId);
+
+    jfieldID decodeCacheMaxSoundBytesId = env->GetFieldID(configClass, "DecodeCacheMaxSoundBytes", "I");
+    config.decodeCacheMaxSoundBytes = env->GetIntField(configObj, decodeCacheMaxSoundBytesId);
+
+    jfieldID outputLimiterId = env->GetFieldID(configClass, "OutputLimiter", "Z");
+    config.outputLimiter = env->GetBooleanField(configObj, outputLimiterId);
+
+    jfieldID outputLimiterCeilingId = env->GetFieldID(configClass, "OutputLimiterCeiling", "F");
+    config.outputLimiterCeiling = env->GetFloatField(configObj, outputLimiterCeilingId);
+
+    jfieldID maxRealVoicesId = env->GetFieldID(configClass, "MaxRealVoices", "I");
+    config.maxRealVoices = env->GetIntField(configObj, maxRealVoicesId);
+
 
     // set up callbacks and JNI stuff to maintain proxies
     g_mixerProxyInfo.init(env, "com/crickettechnology/audio/Mixer");
@@ -161,6 +184,11 @@ jfloat Java_com_crickettechnology_audio_Ck_nativeGetRenderLoad(JNIEnv*, jclass)
     return CkGetRenderLoad();
 }
 
+jlong Java_com_crickettechnology_audio_Ck_nativeGetSampleTime(JNIEnv*, jclass)
+{
+    return CkGetSampleTime();
+}
+
 jboolean Java_com_crickettechnology_audio_Ck_nativeGetClipFlag(JNIEnv*, jclass)
 {
     return CkGetClipFlag();
@@ -171,6 +199,29 @@ void Java_com_crickettechnology_audio_Ck_nativeResetClipFlag(JNIEnv*, jclass)
     CkResetClipFlag();
 }
 
+jfloat Java_com_crickettechnology_audio_Ck_nativeGetOutputGainReduction(JNIEnv*, jclass)
+{
+    return CkGetOutputGainReduction();
+}
+
+void Java_com_crickettechnology_audio_Ck_nativeGetDecodeCacheStats(JNIEnv* env, jclass, jintArray valuesArray)
+{
+    CkDecodeCacheStats stats;
+    CkGetDecodeCacheStats(&stats);
+
+    jint values[] = { stats.hits, stats.misses, stats.evictions, stats.overflows, stats.entries, stats.bytes, stats.pinnedBytes };
+    env->SetIntArrayRegion(valuesArray, 0, CK_ARRAY_COUNT(values), values);
+}
+
+void Java_com_crickettechnology_audio_Ck_nativeGetVoiceStats(JNIEnv* env, jclass, jintArray valuesArray)
+{
+    CkVoiceStats stats;
+    CkGetVoiceStats(&stats);
+
+    jint values[] = { stats.realVoices, stats.virtualVoices, stats.stolenVoices };
+    env->SetIntArrayRegion(valuesArray, 0, CK_ARRAY_COUNT(values), values);
+}
+
 void Java_com_crickettechnology_audio_Ck_nativeSetVolumeRampTime(JNIEnv*, jclass, jfloat ms)
 {
     CkSetVolumeRampTime(ms);
@@ -202,6 +253,17 @@ void Java_com_crickettechnology_audio_Ck_nativeStopCapture(JNIEnv*, jclass)
     CkStopCapture();
 }
 
+void Java_com_crickettechnology_audio_Ck_nativeStartRenderTrace(JNIEnv* env, jclass, jstring pathStr, jint pathType)
+{
+    Cki::JavaStringRef path(env, pathStr);
+    CkStartRenderTrace(path.getChars(), (CkPathType) pathType);
+}
+
+void Java_com_crickettechnology_audio_Ck_nativeStopRenderTrace(JNIEnv*, jclass)
+{
+    CkStopRenderTrace();
+}
+
 
 }
 
@@ -55,6 +55,14 @@ JNIEXPORT void JNICALL Java_com_crickettechnology_audio_Ck_nativeUpdate
 JNIEXPORT jfloat JNICALL Java_com_crickettechnology_audio_Ck_nativeGetRenderLoad
   (JNIEnv *, jclass);
 
+/*
+ * Class:     com_crickettechnology_audio_Ck
+ * Method:    nativeGetSampleTime
+ * Signature: ()J
+ */
+JNIEXPORT jlong JNICALL Java_com_crickettechnology_audio_Ck_nativeGetSampleTime
+  (JNIEnv *, jclass);
+
 /*
  * Class:     com_crickettechnology_audio_Ck
  * Method:    nativeGetClipFlag
@@ -71,6 +79,30 @@ JNIEXPORT jboolean JNICALL Java_com_crickettechnology_audio_Ck_nativeGetClipFlag
 JNIEXPORT void JNICALL Java_com_crickettechnology_audio_Ck_nativeResetClipFlag
   (JNIEnv *, jclass);
 
+/*
+ * Class:     com_crickettechnology_audio_Ck
+ * Method:    nativeGetOutputGainReduction
+ * Signature: ()F
+ */
+JNIEXPORT jfloat JNICALL Java_com_crickettechnology_audio_Ck_nativeGetOutputGainReduction
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     com_crickettechnology_audio_Ck
+ * Method:    nativeGetDecodeCacheStats
+ * Signature: ([I)V
+ */
+JNIEXPORT void JNICALL Java_com_crickettechnology_audio_Ck_nativeGetDecodeCacheStats
+  (JNIEnv *, jclass, jintArray);
+
+/*
+ * Class:     com_crickettechnology_audio_Ck
+ * Method:    nativeGetVoiceStats
+ * Signature: ([I)V
+ */
+JNIEXPORT void JNICALL Java_com_crickettechnology_audio_Ck_nativeGetVoiceStats
+  (JNIEnv *, jclass, jintArray);
+
 /*
  * Class:     com_crickettechnology_audio_Ck
  * Method:    nativeSetVolumeRampTime
@@ -87,6 +119,22 @@ JNIEXPORT void JNICALL Java_com_crickettechnology_audio_Ck_nativeSetVolumeRampTi
 JNIEXPORT jfloat JNICALL Java_com_crickettechnology_audio_Ck_nativeGetVolumeRampTime
   (JNIEnv *, jclass);
 
+/*
+ * Class:     com_crickettechnology_audio_Ck
+ * Method:    nativeStartRenderTrace
+ * Signature: (Ljava/lang/String;I)V
+ */
+JNIEXPORT void JNICALL Java_com_crickettechnology_audio_Ck_nativeStartRenderTrace
+  (JNIEnv *, jclass, jstring, jint);
+
+/*
+ * Class:     com_crickettechnology_audio_Ck
+ * Method:    nativeStopRenderTrace
+ * Signature: ()V
+ */
+JNIEXPORT void JNICALL Java_com_crickettechnology_audio_Ck_nativeStopRenderTrace
+  (JNIEnv *, jclass);
+
 #ifdef __cplusplus
 }
 #endif
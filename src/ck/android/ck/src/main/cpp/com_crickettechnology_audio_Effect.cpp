@@ -1,5 +1,6 @@
 #include <jni.h>
 #include "ck/effect.h"
+#include "ck/core/javastringref_android.h"
 
 extern "C"
 {
@@ -41,6 +42,12 @@ jfloat Java_com_crickettechnology_audio_Effect_nativeGetWetDryRatio(JNIEnv* env,
     return effect->getWetDryRatio();
 }
 
+jfloat Java_com_crickettechnology_audio_Effect_nativeGetGainReduction(JNIEnv* env, jclass, jlong inst)
+{
+    CkEffect* effect = (CkEffect*) inst;
+    return effect->getGainReduction();
+}
+
 jlong Java_com_crickettechnology_audio_Effect_nativeNewEffect(JNIEnv* env, jclass, jint type)
 {
     CkEffect* effect = CkEffect::newEffect((CkEffectType) type);
@@ -53,6 +60,21 @@ jlong Java_com_crickettechnology_audio_Effect_nativeNewCustomEffect(JNIEnv* env,
     return (jlong) effect;
 }
 
+jlong Java_com_crickettechnology_audio_Effect_nativeNewConvolutionReverbFromBank(JNIEnv* env, jclass, jlong bankInst, jstring nameStr)
+{
+    CkBank* bank = (CkBank*) bankInst;
+    Cki::JavaStringRef name(env, nameStr);
+    CkEffect* effect = CkEffect::newConvolutionReverb(bank, name.getChars());
+    return (jlong) effect;
+}
+
+jlong Java_com_crickettechnology_audio_Effect_nativeNewConvolutionReverbFromFile(JNIEnv* env, jclass, jstring pathStr, jint pathType)
+{
+    Cki::JavaStringRef path(env, pathStr);
+    CkEffect* effect = CkEffect::newConvolutionReverb(path.getChars(), (CkPathType) pathType);
+    return (jlong) effect;
+}
+
 void Java_com_crickettechnology_audio_Effect_nativeDestroy(JNIEnv*, jclass, jlong inst)
 {
     CkEffect* effect = (CkEffect*) inst;
@@ -55,6 +55,14 @@ JNIEXPORT void JNICALL Java_com_crickettechnology_audio_Effect_nativeSetWetDryRa
 JNIEXPORT jfloat JNICALL Java_com_crickettechnology_audio_Effect_nativeGetWetDryRatio
   (JNIEnv *, jclass, jlong);
 
+/*
+ * Class:     com_crickettechnology_audio_Effect
+ * Method:    nativeGetGainReduction
+ * Signature: (J)F
+ */
+JNIEXPORT jfloat JNICALL Java_com_crickettechnology_audio_Effect_nativeGetGainReduction
+  (JNIEnv *, jclass, jlong);
+
 /*
  * Class:     com_crickettechnology_audio_Effect
  * Method:    nativeNewEffect
@@ -63,6 +71,22 @@ JNIEXPORT jfloat JNICALL Java_com_crickettechnology_audio_Effect_nativeGetWetDry
 JNIEXPORT jlong JNICALL Java_com_crickettechnology_audio_Effect_nativeNewEffect
   (JNIEnv *, jclass, jint);
 
+/*
+ * Class:     com_crickettechnology_audio_Effect
+ * Method:    nativeNewConvolutionReverbFromBank
+ * Signature: (JLjava/lang/String;)J
+ */
+JNIEXPORT jlong JNICALL Java_com_crickettechnology_audio_Effect_nativeNewConvolutionReverbFromBank
+  (JNIEnv *, jclass, jlong, jstring);
+
+/*
+ * Class:     com_crickettechnology_audio_Effect
+ * Method:    nativeNewConvolutionReverbFromFile
+ * Signature: (Ljava/lang/String;I)J
+ */
+JNIEXPORT jlong JNICALL Java_com_crickettechnology_audio_Effect_nativeNewConvolutionReverbFromFile
+  (JNIEnv *, jclass, jstring, jint);
+
 /*
  * Class:     com_crickettechnology_audio_Effect
  * Method:    nativeDestroy
@@ -65,6 +65,12 @@ jfloat Java_com_crickettechnology_audio_EffectBus_nativeGetWetDryRatio(JNIEnv* e
     return effectBus->getWetDryRatio();
 }
 
+jfloat Java_com_crickettechnology_audio_EffectBus_nativeGetRenderLoad(JNIEnv* env, jclass, jlong inst)
+{
+    CkEffectBus* effectBus = (CkEffectBus*) inst;
+    return effectBus->getRenderLoad();
+}
+
 jlong Java_com_crickettechnology_audio_EffectBus_nativeNewEffectBus(JNIEnv* env, jclass)
 {
     CkEffectBus* effectBus = CkEffectBus::newEffectBus();
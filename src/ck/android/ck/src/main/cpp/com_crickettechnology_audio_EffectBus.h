@@ -87,6 +87,14 @@ JNIEXPORT void JNICALL Java_com_crickettechnology_audio_EffectBus_nativeSetWetDr
 JNIEXPORT jfloat JNICALL Java_com_crickettechnology_audio_EffectBus_nativeGetWetDryRatio
   (JNIEnv *, jclass, jlong);
 
+/*
+ * Class:     com_crickettechnology_audio_EffectBus
+ * Method:    nativeGetRenderLoad
+ * Signature: (J)F
+ */
+JNIEXPORT jfloat JNICALL Java_com_crickettechnology_audio_EffectBus_nativeGetRenderLoad
+  (JNIEnv *, jclass, jlong);
+
 /*
  * Class:     com_crickettechnology_audio_EffectBus
  * Method:    nativeNewEffectBus
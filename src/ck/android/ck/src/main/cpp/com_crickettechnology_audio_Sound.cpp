@@ -44,6 +44,18 @@ void Java_com_crickettechnology_audio_Sound_nativeStop(JNIEnv*, jclass, jlong in
     sound->stop();
 }
 
+void Java_com_crickettechnology_audio_Sound_nativePlayAt(JNIEnv*, jclass, jlong inst, jlong sampleTime)
+{
+    CkSound* sound = (CkSound*) inst;
+    sound->playAt(sampleTime);
+}
+
+void Java_com_crickettechnology_audio_Sound_nativeStopAt(JNIEnv*, jclass, jlong inst, jlong sampleTime)
+{
+    CkSound* sound = (CkSound*) inst;
+    sound->stopAt(sampleTime);
+}
+
 jboolean Java_com_crickettechnology_audio_Sound_nativeIsPlaying(JNIEnv*, jclass, jlong inst)
 {
     CkSound* sound = (CkSound*) inst;
@@ -144,6 +156,12 @@ void Java_com_crickettechnology_audio_Sound_nativeSetVolume(JNIEnv*, jclass, jlo
     sound->setVolume(volume);
 }
 
+void Java_com_crickettechnology_audio_Sound_nativeSetVolumeAt(JNIEnv*, jclass, jlong inst, jfloat volume, jlong sampleTime)
+{
+    CkSound* sound = (CkSound*) inst;
+    sound->setVolumeAt(volume, sampleTime);
+}
+
 jfloat Java_com_crickettechnology_audio_Sound_nativeGetVolume(JNIEnv*, jclass, jlong inst)
 {
     CkSound* sound = (CkSound*) inst;
@@ -210,6 +228,30 @@ jfloat Java_com_crickettechnology_audio_Sound_nativeGetSpeed(JNIEnv*, jclass, jl
     return (jfloat) sound->getSpeed();
 }
 
+void Java_com_crickettechnology_audio_Sound_nativeSetResampleQuality(JNIEnv*, jclass, jlong inst, jint quality)
+{
+    CkSound* sound = (CkSound*) inst;
+    sound->setResampleQuality((CkResampleQuality) quality);
+}
+
+jint Java_com_crickettechnology_audio_Sound_nativeGetResampleQuality(JNIEnv*, jclass, jlong inst)
+{
+    CkSound* sound = (CkSound*) inst;
+    return (jint) sound->getResampleQuality();
+}
+
+void Java_com_crickettechnology_audio_Sound_nativeSetPriority(JNIEnv*, jclass, jlong inst, jfloat priority)
+{
+    CkSound* sound = (CkSound*) inst;
+    sound->setPriority(priority);
+}
+
+jfloat Java_com_crickettechnology_audio_Sound_nativeGetPriority(JNIEnv*, jclass, jlong inst)
+{
+    CkSound* sound = (CkSound*) inst;
+    return (jfloat) sound->getPriority();
+}
+
 void Java_com_crickettechnology_audio_Sound_nativeSetNextSound(JNIEnv*, jclass, jlong inst, jlong nextInst)
 {
     CkSound* sound = (CkSound*) inst;
@@ -399,6 +441,21 @@ jlong Java_com_crickettechnology_audio_Sound_nativeNewBankSoundByName(JNIEnv* en
     return (jlong) sound;
 }
 
+jlong Java_com_crickettechnology_audio_Sound_nativeNewBankSoundById(JNIEnv* env, jclass, jlong bankInst, jint hash)
+{
+    CkBank* bank = (CkBank*) bankInst;
+    CkSoundId id;
+    id.hash = (unsigned int) hash;
+    CkSound* sound = CkSound::newBankSound(bank, id);
+    return (jlong) sound;
+}
+
+jint Java_com_crickettechnology_audio_Sound_nativeGetSoundId(JNIEnv* env, jclass, jstring nameStr)
+{
+    Cki::JavaStringRef name(env, nameStr);
+    return (jint) CkSound::getSoundId(name.getChars()).hash;
+}
+
 jlong Java_com_crickettechnology_audio_Sound_nativeNewStreamSound(JNIEnv* env, jclass, jstring pathStr, jint pathType, jint offset, jint length, jstring extensionStr)
 {
     Cki::JavaStringRef path(env, pathStr);
@@ -63,6 +63,22 @@ JNIEXPORT void JNICALL Java_com_crickettechnology_audio_Sound_nativePlay
 JNIEXPORT void JNICALL Java_com_crickettechnology_audio_Sound_nativeStop
   (JNIEnv *, jclass, jlong);
 
+/*
+ * Class:     com_crickettechnology_audio_Sound
+ * Method:    nativePlayAt
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_com_crickettechnology_audio_Sound_nativePlayAt
+  (JNIEnv *, jclass, jlong, jlong);
+
+/*
+ * Class:     com_crickettechnology_audio_Sound
+ * Method:    nativeStopAt
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_com_crickettechnology_audio_Sound_nativeStopAt
+  (JNIEnv *, jclass, jlong, jlong);
+
 /*
  * Class:     com_crickettechnology_audio_Sound
  * Method:    nativeIsPlaying
@@ -183,6 +199,14 @@ JNIEXPORT jfloat JNICALL Java_com_crickettechnology_audio_Sound_nativeGetPlayPos
 JNIEXPORT void JNICALL Java_com_crickettechnology_audio_Sound_nativeSetVolume
   (JNIEnv *, jclass, jlong, jfloat);
 
+/*
+ * Class:     com_crickettechnology_audio_Sound
+ * Method:    nativeSetVolumeAt
+ * Signature: (JFJ)V
+ */
+JNIEXPORT void JNICALL Java_com_crickettechnology_audio_Sound_nativeSetVolumeAt
+  (JNIEnv *, jclass, jlong, jfloat, jlong);
+
 /*
  * Class:     com_crickettechnology_audio_Sound
  * Method:    nativeGetVolume
@@ -263,6 +287,38 @@ JNIEXPORT void JNICALL Java_com_crickettechnology_audio_Sound_nativeSetSpeed
 JNIEXPORT jfloat JNICALL Java_com_crickettechnology_audio_Sound_nativeGetSpeed
   (JNIEnv *, jclass, jlong);
 
+/*
+ * Class:     com_crickettechnology_audio_Sound
+ * Method:    nativeSetResampleQuality
+ * Signature: (JI)V
+ */
+JNIEXPORT void JNICALL Java_com_crickettechnology_audio_Sound_nativeSetResampleQuality
+  (JNIEnv *, jclass, jlong, jint);
+
+/*
+ * Class:     com_crickettechnology_audio_Sound
+ * Method:    nativeGetResampleQuality
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_com_crickettechnology_audio_Sound_nativeGetResampleQuality
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     com_crickettechnology_audio_Sound
+ * Method:    nativeSetPriority
+ * Signature: (JF)V
+ */
+JNIEXPORT void JNICALL Java_com_crickettechnology_audio_Sound_nativeSetPriority
+  (JNIEnv *, jclass, jlong, jfloat);
+
+/*
+ * Class:     com_crickettechnology_audio_Sound
+ * Method:    nativeGetPriority
+ * Signature: (J)F
+ */
+JNIEXPORT jfloat JNICALL Java_com_crickettechnology_audio_Sound_nativeGetPriority
+  (JNIEnv *, jclass, jlong);
+
 /*
  * Class:     com_crickettechnology_audio_Sound
  * Method:    nativeGetLength
@@ -447,6 +503,22 @@ JNIEXPORT jlong JNICALL Java_com_crickettechnology_audio_Sound_nativeNewBankSoun
 JNIEXPORT jlong JNICALL Java_com_crickettechnology_audio_Sound_nativeNewBankSoundByName
   (JNIEnv *, jclass, jlong, jstring);
 
+/*
+ * Class:     com_crickettechnology_audio_Sound
+ * Method:    nativeNewBankSoundById
+ * Signature: (JI)J
+ */
+JNIEXPORT jlong JNICALL Java_com_crickettechnology_audio_Sound_nativeNewBankSoundById
+  (JNIEnv *, jclass, jlong, jint);
+
+/*
+ * Class:     com_crickettechnology_audio_Sound
+ * Method:    nativeGetSoundId
+ * Signature: (Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_com_crickettechnology_audio_Sound_nativeGetSoundId
+  (JNIEnv *, jclass, jstring);
+
 /*
  * Class:     com_crickettechnology_audio_Sound
  * Method:    nativeNewStreamSound
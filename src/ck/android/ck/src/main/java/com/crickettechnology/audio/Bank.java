@@ -138,6 +138,44 @@ public final class Bank extends Proxy
         return getBank(inst);
     }
 
+    /** Loads a bank by mapping the file into memory.
+      Equivalent to newBankMapped(filename, pathType, 0, 0).
+
+      This may return NULL if the bank cannot be loaded.
+
+      @param filename   Path to the bank file (.ckb).
+      @param pathType   Indicates how the path is to be interpreted.
+      @return The bank, or null if it could not be loaded
+      */
+    public static Bank newBankMapped(String filename, PathType pathType)
+    {
+        return newBankMapped(filename, pathType, 0, 0);
+    }
+
+    /** Loads a bank by mapping the file into memory.
+
+      Sample data is read from the file as it is first played, rather than
+      all at once; only the table of sounds is copied into memory.
+      Assets in the .apk cannot be mapped, so those banks are loaded as with
+      newBank().
+
+      This may return NULL if the bank cannot be loaded.
+
+      If the bank file is embedded in a larger file, specify the offset and 
+      length of the embedded data; otherwise, leave them both as 0.
+
+      @param filename   Path to the bank file (.ckb).
+      @param pathType   Indicates how the path is to be interpreted.
+      @param offset     The byte offset of the bank file data in the larger file.
+      @param length     The size of the bank file data in the larger file.
+      @return The bank, or null if it could not be loaded
+      */
+    public static Bank newBankMapped(String filename, PathType pathType, int offset, int length)
+    {
+        long inst = nativeNewBankMapped(filename, pathType.value, offset, length);
+        return getBank(inst);
+    }
+
 
     /** Find a loaded bank by name.
       @param name The bank name; should be 31 characters or less
@@ -219,6 +257,7 @@ public final class Bank extends Proxy
 
     private static native long      nativeNewBank(String filename, int pathType, int offset, int length);
     private static native long      nativeNewBankAsync(String filename, int pathType, int offset, int length);
+    private static native long      nativeNewBankMapped(String filename, int pathType, int offset, int length);
     private static native long      nativeFind(String name);
 
     private static native void      nativeDestroy(long inst);
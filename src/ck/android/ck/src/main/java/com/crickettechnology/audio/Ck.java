@@ -95,6 +95,16 @@ public final class Ck
         return nativeGetRenderLoad();
     }
 
+    /** Returns the sample time of the final audio output: the number of sample frames
+      rendered since initialization.  It does not advance while suspended.
+      Use it with Sound.playAt(), Sound.stopAt(), and Sound.setVolumeAt() to schedule
+      changes to the exact sample frame; to be sure a change arrives in time, schedule
+      it at least Config.AudioUpdateMs ahead of this value. */
+    public static long getSampleTime()
+    {
+        return nativeGetSampleTime();
+    }
+
     /** Returns the value of the clip flag.
       The clip flag is set to true whenever the final audio output "clips", i.e. 
       exceeds the maximum value. */
@@ -111,6 +121,44 @@ public final class Ck
         nativeResetClipFlag();
     }
 
+    /** Returns the gain reduction, in dB, applied by the output limiter to the most
+      recently rendered audio (see Config.OutputLimiter); 0 if there is no limiter.
+      This does not lock the audio thread. */
+    public static float getOutputGainReduction()
+    {
+        return nativeGetOutputGainReduction();
+    }
+
+    /** Gets statistics about the cache of decoded sound data. */
+    public static DecodeCacheStats getDecodeCacheStats()
+    {
+        int[] values = new int[7];
+        nativeGetDecodeCacheStats(values);
+
+        DecodeCacheStats stats = new DecodeCacheStats();
+        stats.hits = values[0];
+        stats.misses = values[1];
+        stats.evictions = values[2];
+        stats.overflows = values[3];
+        stats.entries = values[4];
+        stats.bytes = values[5];
+        stats.pinnedBytes = values[6];
+        return stats;
+    }
+
+    /** Gets the numbers of real and virtual sounds. */
+    public static VoiceStats getVoiceStats()
+    {
+        int[] values = new int[3];
+        nativeGetVoiceStats(values);
+
+        VoiceStats stats = new VoiceStats();
+        stats.realVoices = values[0];
+        stats.virtualVoices = values[1];
+        stats.stolenVoices = values[2];
+        return stats;
+    }
+
     /** Sets the maximum rate at which volumes change on playing sounds, in ms per full volume scale. 
       Default value is 40 ms. */
     public static void setVolumeRampTime(float ms)
@@ -154,6 +202,21 @@ public final class Ck
         nativeStopCapture();
     }
 
+    /** Start recording when each sound, mixer, effect bus and effect is rendered, and how
+      long it takes, to a file.  The file is in the Chrome trace event JSON format, which
+      can be opened in Perfetto (ui.perfetto.dev) or chrome://tracing.  Events are
+      written to the file during update(). */
+    public static void startRenderTrace(String path, PathType pathType)
+    {
+        nativeStartRenderTrace(path, pathType.value);
+    }
+
+    /** Stop recording the render trace, and close the file. */
+    public static void stopRenderTrace()
+    {
+        nativeStopRenderTrace();
+    }
+
     ////////////////////////////////////////
 
     private Ck() {}
@@ -165,14 +228,20 @@ public final class Ck
     private static native void nativeResume();
     private static native void nativeUpdate();
     private static native float nativeGetRenderLoad();
+    private static native long nativeGetSampleTime();
     private static native boolean nativeGetClipFlag();
     private static native void nativeResetClipFlag();
+    private static native float nativeGetOutputGainReduction();
+    private static native void nativeGetDecodeCacheStats(int[] values);
+    private static native void nativeGetVoiceStats(int[] values);
     private static native void nativeSetVolumeRampTime(float ms);
     private static native float nativeGetVolumeRampTime();
     private static native void nativeLockAudio();
     private static native void nativeUnlockAudio();
     private static native void nativeStartCapture(String path, int pathType);
     private static native void nativeStopCapture();
+    private static native void nativeStartRenderTrace(String path, int pathType);
+    private static native void nativeStopRenderTrace();
 }
 
 
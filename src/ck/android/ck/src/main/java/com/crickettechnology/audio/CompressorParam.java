@@ -0,0 +1,30 @@
+package com.crickettechnology.audio;
+
+/** Parameters for the Compressor effect */
+public final class CompressorParam
+{
+    /** Level (in dB) above which the gain is reduced, in [-60..0]; the default is -12. */
+    public static final int THRESHOLD = 0;
+
+    /** Amount of compression above the threshold, in [1..1000]; each dB above
+      the threshold becomes 1/ratio dB.  The default is 4.  A ratio of 1000 is
+      treated as infinite, for a limiter. */
+    public static final int RATIO = 1;
+
+    /** Look-ahead time (in ms), in [0..20]; the default is 5.  This is also the
+      attack time, and the amount the output is delayed. */
+    public static final int LOOKAHEAD_MS = 2;
+
+    /** Time (in ms) for the gain to recover, in [1..5000]; the default is 100. */
+    public static final int RELEASE_MS = 3;
+
+    /** Gain (in dB) applied after compression, in [0..40]; the default is 0. */
+    public static final int MAKEUP_GAIN = 4;
+
+    /** If nonzero, peaks between samples are detected too; the default is 0. */
+    public static final int TRUE_PEAK = 5;
+
+    private CompressorParam() {}
+}
+
+
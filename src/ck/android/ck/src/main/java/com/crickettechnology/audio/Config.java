@@ -57,4 +57,40 @@ public final class Config
       Default is 0.8. */
     public float MaxRenderLoad = 0.8f;
 
+    /** Method used to resample sounds whose resample quality is
+      ResampleQuality.Default (see Sound.setResampleQuality()).
+      Default is ResampleQuality.Linear. */
+    public ResampleQuality ResampleQuality = com.crickettechnology.audio.ResampleQuality.Linear;
+
+    /** Size of the cache of decoded sound data, in bytes.  Bank sounds in ADPCM
+      or lossless format that are at most DecodeCacheMaxSoundBytes when decoded,
+      or that are marked "hot" in the bank description file, are decoded once,
+      and the decoded data is shared by every sound that plays them.  When the cache is full, the least
+      recently used data that no sound is using is discarded.  Data for hot sounds is
+      kept until their bank is destroyed.  See Ck.getDecodeCacheStats().
+      Default is 0 (no cache). */
+    public int DecodeCacheBytes = 0;
+
+    /** Largest size, in bytes, of the decoded data of a bank sound that is not marked
+      "hot" for it to be kept in the decode cache (see DecodeCacheBytes).
+      Default is 262144 (256 KB). */
+    public int DecodeCacheMaxSoundBytes = 262144;
+
+    /** If true, the final mix goes through a true-peak look-ahead limiter,
+      instead of being clipped where it exceeds the maximum output level.  The
+      limiter delays the output by about 5 ms.  See Ck.getOutputGainReduction().
+      Default is false (the output is clipped). */
+    public boolean OutputLimiter = false;
+
+    /** Highest output level of the limiter (see OutputLimiter), in dB below full
+      scale.  Default is -1 dB. */
+    public float OutputLimiterCeiling = -1.0f;
+
+    /** Maximum number of sounds that are rendered at once.  If more sounds are
+      playing, the ones whose priority times volume is lowest become virtual
+      (see Sound.setPriority() and Sound.isVirtual()); this is updated
+      each time Ck.update() is called.  See Ck.getVoiceStats().
+      Default is 0 (no limit). */
+    public int MaxRealVoices = 0;
+
 }
@@ -0,0 +1,11 @@
+package com.crickettechnology.audio;
+
+/** Parameters for the Convolution Reverb effect */
+public final class ConvolutionReverbParam
+{
+    /** Gain applied to the reverb output; the default is 1. */
+    public static final int GAIN = 0;
+
+    private ConvolutionReverbParam() {}
+}
+
@@ -0,0 +1,29 @@
+package com.crickettechnology.audio;
+
+/** Statistics about the cache of decoded sound data; see Ck.getDecodeCacheStats()
+  and Config.DecodeCacheBytes. */
+public final class DecodeCacheStats
+{
+    /** Number of times a sound used data that was already decoded. */
+    public int hits;
+
+    /** Number of times a sound's data was decoded and added to the cache. */
+    public int misses;
+
+    /** Number of times data was discarded to make room for other data. */
+    public int evictions;
+
+    /** Number of times a sound's data was not cached because the cache was full
+      of data in use. */
+    public int overflows;
+
+    /** Number of sounds whose data is in the cache. */
+    public int entries;
+
+    /** Total size of the data in the cache, in bytes. */
+    public int bytes;
+
+    /** Size of the data in the cache that cannot be discarded, because it is in
+      use by a sound or belongs to a "hot" sound, in bytes. */
+    public int pinnedBytes;
+}
@@ -53,6 +53,14 @@ public final class Effect extends Proxy
         return nativeGetWetDryRatio(m_inst);
     }
 
+    /** Gets the gain reduction, in dB, applied by a Compressor effect to the
+      most recently processed audio (0 means none).  Returns 0 for other effects.
+      This does not lock the audio thread. */
+    public float getGainReduction()
+    {
+        return nativeGetGainReduction(m_inst);
+    }
+
     /** Create a built-in effect. */
     public static Effect newEffect(EffectType type)
     {
@@ -67,6 +75,47 @@ public final class Effect extends Proxy
         return getEffect(inst);
     }
 
+    /** Create a convolution reverb effect, using a sound in a bank as its impulse response.
+      The impulse response may be mono or stereo; it is resampled to the output
+      sample rate and normalized.  The reverb output is delayed by 128 frames.
+      See ConvolutionReverbParam for parameter IDs.
+
+      @param bank       The bank; if null, all loaded banks will be searched for a sound with a matching name
+      @param soundName  Name of the sound in the bank
+      @return The effect, or null if the sound is not found or can't be decoded
+      */
+    public static Effect newConvolutionReverb(Bank bank, String soundName)
+    {
+        long inst = nativeNewConvolutionReverbFromBank(bank == null ? 0 : bank.m_inst, soundName);
+        return getEffect(inst);
+    }
+
+    /** Create a convolution reverb effect, using a .wav file in the .apk as its impulse response.
+      Equivalent to newConvolutionReverb(path, PathType.Asset).
+
+      @param path   Path to the .wav file
+      @return The effect, or null if the file can't be read
+      */
+    public static Effect newConvolutionReverb(String path)
+    {
+        return newConvolutionReverb(path, PathType.Asset);
+    }
+
+    /** Create a convolution reverb effect, using a .wav file as its impulse response.
+      The impulse response may be mono or stereo; it is resampled to the output
+      sample rate and normalized.  The reverb output is delayed by 128 frames.
+      See ConvolutionReverbParam for parameter IDs.
+
+      @param path       Path to the .wav file
+      @param pathType   Indicates how the path is to be interpreted.
+      @return The effect, or null if the file can't be read
+      */
+    public static Effect newConvolutionReverb(String path, PathType pathType)
+    {
+        long inst = nativeNewConvolutionReverbFromFile(path, pathType.value);
+        return getEffect(inst);
+    }
+
     ////////////////////////////////////////
 
     protected void destroyImpl()
@@ -132,9 +181,12 @@ public final class Effect extends Proxy
     private static native boolean   nativeIsBypassed(long inst);
     private static native void      nativeSetWetDryRatio(long inst, float wetDry);
     private static native float     nativeGetWetDryRatio(long inst);
+    private static native float     nativeGetGainReduction(long inst);
 
     private static native long      nativeNewEffect(int type);
     private static native long      nativeNewCustomEffect(int id);
+    private static native long      nativeNewConvolutionReverbFromBank(long bankInst, String soundName);
+    private static native long      nativeNewConvolutionReverbFromFile(String path, int pathType);
 
     private static native void      nativeDestroy(long inst);
 }
@@ -80,6 +80,14 @@ public final class EffectBus extends Proxy
         return nativeGetWetDryRatio(m_inst);
     }
 
+    /** Gets the fraction of real time spent rendering this bus, averaged over
+      about 100 ms.  This includes the effects on the bus and the sounds and
+      buses whose output is sent to it, so it is comparable to Ck.getRenderLoad(). */
+    public float getRenderLoad()
+    {
+        return nativeGetRenderLoad(m_inst);
+    }
+
     ////////////////////////////////////////
 
     /** Create a new effect bus. */
@@ -166,6 +174,7 @@ public final class EffectBus extends Proxy
     private static native boolean   nativeIsBypassed(long inst);
     private static native void      nativeSetWetDryRatio(long inst, float wetDry);
     private static native float     nativeGetWetDryRatio(long inst);
+    private static native float     nativeGetRenderLoad(long inst);
 
     private static native long      nativeNewEffectBus();
     private static native long      nativeGetGlobalEffectBus();
@@ -18,7 +18,17 @@ public enum EffectType
 
     /** Distortion effect.
      See DistortionParam values for parameter IDs. */
-    DISTORTION(3);
+    DISTORTION(3),
+
+    /** Reverb effect simulates the reflections of a room, with a feedback delay network.
+     See ReverbParam values for parameter IDs. */
+    REVERB(4),
+
+    /** Compressor effect reduces the level of loud audio, with a look-ahead
+      window so peaks are caught before they are output; with a high ratio, it
+      is a limiter.  Output is delayed by the look-ahead time.
+     See CompressorParam values for parameter IDs. */
+    COMPRESSOR(5);
 
     ////////////////////////////////////////
 
@@ -0,0 +1,34 @@
+package com.crickettechnology.audio;
+
+/** Indicates how sounds are resampled when their sample rate or playback speed
+  does not match the output sample rate. */
+public class ResampleQuality
+{
+    private ResampleQuality(int _value) { value = _value; }
+    final int value;
+
+    /** Use the value of Config.ResampleQuality. */
+    public static final ResampleQuality Default = new ResampleQuality(0);
+
+    /** Linear interpolation.  This is the cheapest method, but high frequencies
+     are attenuated, and sounds played faster than their original speed may
+     have audible aliasing. */
+    public static final ResampleQuality Linear = new ResampleQuality(1);
+
+    /** Band-limited interpolation with a windowed-sinc filter.  This is free
+     of audible aliasing, but takes several times as much CPU as linear
+     interpolation, and delays the sound by 17 frames. */
+    public static final ResampleQuality Sinc = new ResampleQuality(2);
+
+    static ResampleQuality fromInt(int value)
+    {
+        if (value == Default.value)
+            return Default;
+        else if (value == Linear.value)
+            return Linear;
+        else if (value == Sinc.value)
+            return Sinc;
+        else
+            return null;
+    }
+}
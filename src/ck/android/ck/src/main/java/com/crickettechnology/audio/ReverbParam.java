@@ -0,0 +1,21 @@
+package com.crickettechnology.audio;
+
+/** Parameters for the Reverb effect */
+public final class ReverbParam
+{
+    /** Room size, from 0 (small) to 1 (large); the default is 0.5. */
+    public static final int SIZE = 0;
+
+    /** Time (in seconds) for the reverb to decay by 60 dB, in [0.1..30]; the default is 1.5. */
+    public static final int DECAY_TIME = 1;
+
+    /** Damping of high frequencies, from 0 (bright) to 1 (dark); the default is 0.5. */
+    public static final int DAMPING = 2;
+
+    /** Milliseconds before the reverb starts, in [0..100]; the default is 20. */
+    public static final int PRE_DELAY_MS = 3;
+
+    private ReverbParam() {}
+}
+
+
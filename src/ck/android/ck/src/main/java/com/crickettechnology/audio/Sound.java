@@ -44,6 +44,24 @@ public final class Sound extends Proxy
         nativeStop(m_inst);
     }
 
+    /** Play the sound at the given sample time of the audio output (see Ck.getSampleTime()).
+      The sound starts at exactly that sample frame.  If that time has already passed,
+      the sound plays as soon as possible.  Any later call to stop() cancels it.
+      For streams in formats other than .cks or Ogg Vorbis, this takes effect immediately. */
+    public void playAt(long sampleTime)
+    {
+        nativePlayAt(m_inst, sampleTime);
+    }
+
+    /** Stop the sound at the given sample time of the audio output (see Ck.getSampleTime()).
+      The sound stops at exactly that sample frame; until then, isPlaying() returns true.
+      If that time has already passed, the sound stops as soon as possible.
+      For streams in formats other than .cks or Ogg Vorbis, this takes effect immediately. */
+    public void stopAt(long sampleTime)
+    {
+        nativeStopAt(m_inst, sampleTime);
+    }
+
     /** Gets whether the sound is playing. */
     public boolean isPlaying()
     {
@@ -181,6 +199,15 @@ public final class Sound extends Proxy
         nativeSetVolume(m_inst, volume);
     }
 
+    /** Sets the volume at the given sample time of the audio output (see Ck.getSampleTime()).
+      getVolume() returns the new value immediately; the sound starts changing to it at
+      exactly that sample frame (at the rate set by Ck.setVolumeRampTime()).
+      For streams in formats other than .cks or Ogg Vorbis, this takes effect immediately. */
+    public void setVolumeAt(float volume, long sampleTime)
+    {
+        nativeSetVolumeAt(m_inst, volume, sampleTime);
+    }
+
     /** Gets the volume.
       The volume can range from 0 to 1. The default value is 1. */
     public float getVolume()
@@ -273,6 +300,39 @@ public final class Sound extends Proxy
         return nativeGetSpeed(m_inst);
     }
 
+    /** Sets the method used to resample the sound, when its sample rate or speed
+      does not match the output sample rate.  The default value is ResampleQuality.Default,
+      which uses the value of Config.ResampleQuality.
+      <p>
+      This does not work for streams in formats other than .cks or Ogg Vorbis. */
+    public void setResampleQuality(ResampleQuality quality)
+    {
+        nativeSetResampleQuality(m_inst, quality.value);
+    }
+
+    /** Gets the method used to resample the sound, when its sample rate or speed
+      does not match the output sample rate.  The default value is ResampleQuality.Default. */
+    public ResampleQuality getResampleQuality()
+    {
+        return ResampleQuality.fromInt(nativeGetResampleQuality(m_inst));
+    }
+
+    /** Sets the priority of the sound, for voice limiting.
+      When more sounds are playing than the voice limit allows, the ones
+      with the lowest priority times volume become virtual (see isVirtual()).
+      The default value is 1. */
+    public void setPriority(float priority)
+    {
+        nativeSetPriority(m_inst, priority);
+    }
+
+    /** Gets the priority of the sound, for voice limiting.
+      The default value is 1. */
+    public float getPriority()
+    {
+        return nativeGetPriority(m_inst);
+    }
+
     /** Sets the sound to be played when this sound finishes playing.
       The next sound will play immediately, with no gaps. 
       <p>
@@ -355,11 +415,15 @@ public final class Sound extends Proxy
         return nativeIs3dEnabled(m_inst);
     }
 
-    /** Gets whether a 3D sound is virtual.
+    /** Gets whether a sound is virtual.
       If, due to distance attenuation, a 3D sound's volume becomes near enough to 0
-      to be inaudible, it becomes "virtual".  A virtual sound is effectively paused
-      and is not processed until it would become audible again; this reduces the 
-      amount of audio processing required. */
+      to be inaudible, it becomes "virtual".  A sound also becomes virtual if more
+      sounds are playing than the voice limit allows, and it is one of the least
+      important (see setPriority()).  A virtual sound is not resampled or mixed, but
+      its play position is kept up to date, so it resumes at the right place when it
+      becomes real again; this reduces the amount of audio processing required.
+      <p>
+      Streams in formats other than .cks or Ogg Vorbis are paused while virtual. */
     public boolean isVirtual()
     {
         return nativeIsVirtual(m_inst);
@@ -534,6 +598,31 @@ public final class Sound extends Proxy
         return getSound(inst);
     }
 
+    /** Creates a sound from a bank by id.
+      In the unlikely case that two names in the banks being searched have the
+      same id, either sound may be returned; cktool warns about this within a bank.
+
+      @param bank   The bank; if null, all loaded banks will be searched for a sound with a matching id
+      @param id     Id of the sound in the bank to create, from getSoundId()
+      @return The sound, or null if it could not be created
+      */
+    public static Sound newBankSound(Bank bank, SoundId id)
+    {
+        long inst = nativeNewBankSoundById(bank == null ? 0 : bank.m_inst, id.m_hash);
+        return getSound(inst);
+    }
+
+    /** Returns the id for a bank sound name, for use with newBankSound(Bank, SoundId).
+      Ids do not depend on which banks are loaded, so they can be computed once ahead of time.
+
+      @param name   Name of the sound; should be 31 characters or less
+      @return The id
+      */
+    public static SoundId getSoundId(String name)
+    {
+        return new SoundId(nativeGetSoundId(name));
+    }
+
     /** Creates a streaming sound from an asset in the .apk.
       Equivalent to newStreamSound(filename, PathType.Asset).
 
@@ -643,6 +732,8 @@ public final class Sound extends Proxy
     private static native boolean   nativeIsFailed(long inst);
     private static native void      nativePlay(long inst);
     private static native void      nativeStop(long inst);
+    private static native void      nativePlayAt(long inst, long sampleTime);
+    private static native void      nativeStopAt(long inst, long sampleTime);
     private static native boolean   nativeIsPlaying(long inst);
     private static native void      nativeSetPaused(long inst, boolean paused);
     private static native boolean   nativeIsPaused(long inst);
@@ -659,6 +750,7 @@ public final class Sound extends Proxy
     private static native int       nativeGetPlayPosition(long inst);
     private static native float     nativeGetPlayPositionMs(long inst);
     private static native void      nativeSetVolume(long inst, float volume);
+    private static native void      nativeSetVolumeAt(long inst, float volume, long sampleTime);
     private static native float     nativeGetVolume(long inst);
     private static native float     nativeGetMixedVolume(long inst);
     private static native void      nativeSetPan(long inst, float pan);
@@ -669,6 +761,10 @@ public final class Sound extends Proxy
     private static native float     nativeGetPitchShift(long inst);
     private static native void      nativeSetSpeed(long inst, float speed);
     private static native float     nativeGetSpeed(long inst);
+    private static native void      nativeSetResampleQuality(long inst, int quality);
+    private static native int       nativeGetResampleQuality(long inst);
+    private static native void      nativeSetPriority(long inst, float priority);
+    private static native float     nativeGetPriority(long inst);
     private static native void      nativeSetNextSound(long inst, long nextInst);
     private static native long      nativeGetNextSound(long inst);
     private static native int       nativeGetLength(long inst);
@@ -695,6 +791,8 @@ public final class Sound extends Proxy
 
     private static native long      nativeNewBankSoundByIndex(long bankInst, int index);
     private static native long      nativeNewBankSoundByName(long bankInst, String name);
+    private static native long      nativeNewBankSoundById(long bankInst, int hash);
+    private static native int       nativeGetSoundId(String name);
     private static native long      nativeNewStreamSound(String filename, int pathType, int offset, int length, String extension);
 
     private static native void      nativeDestroy(long inst);
@@ -0,0 +1,14 @@
+package com.crickettechnology.audio;
+
+/** Identifies a bank sound by a hash of its name; see Sound.getSoundId().
+  Creating sounds by id skips hashing and comparing the name. */
+public final class SoundId
+{
+    SoundId(int hash)
+    {
+        m_hash = hash;
+    }
+
+    final int m_hash;
+}
+
@@ -0,0 +1,16 @@
+package com.crickettechnology.audio;
+
+/** Numbers of real and virtual sounds, as of the most recent call to
+  Ck.update(); see Ck.getVoiceStats() and Config.MaxRealVoices. */
+public final class VoiceStats
+{
+    /** Number of playing sounds that are rendered. */
+    public int realVoices;
+
+    /** Number of playing sounds that are virtual (see Sound.isVirtual()). */
+    public int virtualVoices;
+
+    /** Number of sounds that were made virtual in the most recent update because
+      the limit on real voices was exceeded. */
+    public int stolenVoices;
+}
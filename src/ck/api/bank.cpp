@@ -17,6 +17,11 @@ CkBank* CkBank::newBankFromMemory(void* buf, int bytes)
     return (CkBank*) Cki::Bank::newBankFromMemory(buf, bytes);
 }
 
+CkBank* CkBank::newBankMapped(const char* filename, CkPathType pathType, int offset, int length)
+{
+    return (CkBank*) Cki::Bank::newBankMapped(filename, pathType, offset, length);
+}
+
 CkBank* CkBank::find(const char* bankName)
 {
     return (CkBank*) Cki::Bank::find(bankName);
@@ -4,6 +4,9 @@
 #include "ck/core/debug.h"
 #include "ck/audio/audiograph.h"
 #include "ck/audio/audionode.h"
+#include "ck/audio/decodecache.h"
+#include "ck/audio/voicemanager.h"
+#include "ck/audio/rendertrace.h"
 
 
 #if CK_PLATFORM_IOS || CK_PLATFORM_OSX || CK_PLATFORM_TVOS
@@ -12,29 +15,42 @@
 
 using namespace Cki;
 
-extern "C"
-{
-
-int CkInit(CkConfig* config)
+namespace
 {
-    bool success = true;
-
-    if (!System::get())
+    int init(CkConfig* config, bool offline)
     {
+        bool success = true;
+
+        if (!System::get())
+        {
 
 #if CK_PLATFORM_IOS || CK_PLATFORM_OSX || CK_PLATFORM_TVOS
-        CkoInit();
+            CkoInit();
 #endif
-        success &= System::init(*config);
-    }
+            success &= System::init(*config, false, offline);
+        }
 
-    if (!success)
-    {
-        CK_LOG_ERROR("CkInit FAILED!");
-        CkShutdown();
+        if (!success)
+        {
+            CK_LOG_ERROR("%s FAILED!", offline ? "CkInitOffline" : "CkInit");
+            CkShutdown();
+        }
+
+        return (success ? -1 : 0);
     }
+}
+
+extern "C"
+{
+
+int CkInit(CkConfig* config)
+{
+    return init(config, false);
+}
 
-    return (success ? -1 : 0);
+int CkInitOffline(CkConfig* config)
+{
+    return init(config, true);
 }
 
 void CkUpdate()
@@ -87,11 +103,45 @@ void CkResume()
     }
 }
 
+int CkRenderOffline(int frames, float* buf)
+{
+    System* system = System::get();
+    if (!system || !system->isOffline())
+    {
+        CK_LOG_ERROR("You must call CkInitOffline() before calling CkRenderOffline()!");
+        return 0;
+    }
+    else
+    {
+        return AudioGraph::get()->renderOffline(buf, frames);
+    }
+}
+
+int CkGetOutputSampleRate()
+{
+    return AudioNode::getSampleRate();
+}
+
+long long CkGetSampleTime()
+{
+    return AudioGraph::get()->getSampleTime();
+}
+
 float CkGetRenderLoad()
 {
     return AudioGraph::get()->getRenderLoad();
 }
 
+void CkGetDecodeCacheStats(CkDecodeCacheStats* stats)
+{
+    DecodeCache::getStats(*stats);
+}
+
+void CkGetVoiceStats(CkVoiceStats* stats)
+{
+    VoiceManager::getStats(*stats);
+}
+
 int CkGetClipFlag()
 {
     return AudioGraph::get()->getClipFlag();
@@ -102,6 +152,11 @@ void CkResetClipFlag()
     AudioGraph::get()->resetClipFlag();
 }
 
+float CkGetOutputGainReduction()
+{
+    return AudioGraph::get()->getOutputGainReduction();
+}
+
 void CkSetVolumeRampTime(float ms)
 {
     AudioNode::setVolumeRampTime(ms);
@@ -134,4 +189,14 @@ void CkStopCapture()
     AudioGraph::get()->stopCapture();
 }
 
+void CkStartRenderTrace(const char* path, CkPathType pathType)
+{
+    RenderTrace::start(path, pathType);
+}
+
+void CkStopRenderTrace()
+{
+    RenderTrace::stop();
+}
+
 } // extern "C"
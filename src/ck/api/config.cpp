@@ -12,8 +12,15 @@ const float CkConfig_audioUpdateMsDefault = 5.0f;
 #endif
 const float CkConfig_streamBufferMsDefault = 500.0f;
 const float CkConfig_streamFileUpdateMsDefault = 100.0f;
+const float CkConfig_streamPrimeMsDefault = 100.0f;
+const int CkConfig_streamThreadsDefault = 2;
 const int CkConfig_maxAudioTasksDefault = 500;
 const float CkConfig_maxRenderLoadDefault = 0.8f;
+const int CkConfig_renderThreadsDefault = 1;
+const int CkConfig_decodeCacheBytesDefault = 0;
+const int CkConfig_decodeCacheMaxSoundBytesDefault = 256 * 1024;
+const float CkConfig_outputLimiterCeilingDefault = -1.0f;
+const int CkConfig_maxRealVoicesDefault = 0;
 
 extern "C"
 #if CK_PLATFORM_ANDROID
@@ -39,9 +46,19 @@ void CkConfigInit(CkConfig* config)
     config->audioUpdateMs = CkConfig_audioUpdateMsDefault;
     config->streamBufferMs = CkConfig_streamBufferMsDefault;
     config->streamFileUpdateMs = CkConfig_streamFileUpdateMsDefault;
+    config->streamPrimeMs = CkConfig_streamPrimeMsDefault;
+    config->streamThreads = CkConfig_streamThreadsDefault;
     config->maxAudioTasks = CkConfig_maxAudioTasksDefault;
     config->maxRenderLoad = CkConfig_maxRenderLoadDefault;
+    config->renderThreads = CkConfig_renderThreadsDefault;
     config->sampleType = kCkSampleType_Default;
+    config->resampleQuality = kCkResampleQuality_Linear;
+    config->maxSimdLevel = kCkSimdLevel_Default;
+    config->decodeCacheBytes = CkConfig_decodeCacheBytesDefault;
+    config->decodeCacheMaxSoundBytes = CkConfig_decodeCacheMaxSoundBytesDefault;
+    config->outputLimiter = false;
+    config->outputLimiterCeiling = CkConfig_outputLimiterCeilingDefault;
+    config->maxRealVoices = CkConfig_maxRealVoicesDefault;
 }
 
 
@@ -71,6 +71,23 @@ Bank^ Bank::NewBankAsync(String^ path)
     return NewBankAsync(path, PathType::Default, 0, 0);
 }
 
+Bank^ Bank::NewBankMapped(String^ path, PathType pathType, int offset, int length)
+{
+    StringConvert<256> convert(path);
+    CkBank* impl = CkBank::newBankMapped(convert.getCString(), (CkPathType) pathType, offset, length);
+    return Proxy::GetBank(impl);
+}
+
+Bank^ Bank::NewBankMapped(String^ path, PathType pathType)
+{
+    return NewBankMapped(path, pathType, 0, 0);
+}
+
+Bank^ Bank::NewBankMapped(String^ path)
+{
+    return NewBankMapped(path, PathType::Default, 0, 0);
+}
+
 Bank^ Bank::Find(String^ bankName)
 {
     StringConvert<256> convert(bankName);
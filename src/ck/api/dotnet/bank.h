@@ -131,6 +131,44 @@ public:
     /// </summary>
     static Bank^ NewBankAsync(Platform::String^ path, PathType pathType, int offset, int length);
 
+    /// <summary>
+    /// Loads a bank by mapping the file into memory. 
+    /// <para>
+    /// Equivalent to NewBankMapped(path, pathType, 0, 0).
+    /// </para>
+    /// <para>
+    /// This may return null if the bank cannot be loaded.
+    /// </para>
+    /// </summary>
+    static Bank^ NewBankMapped(Platform::String^ path, PathType pathType);
+
+    /// <summary>
+    /// Loads a bank by mapping the file into memory. 
+    /// <para>
+    /// Equivalent to NewBankMapped(path, PathType.Default, 0, 0).
+    /// </para>
+    /// <para>
+    /// This may return null if the bank cannot be loaded.
+    /// </para>
+    /// </summary>
+    static Bank^ NewBankMapped(Platform::String^ path);
+
+    /// <summary>
+    /// Loads a bank by mapping the file into memory. 
+    /// <para>
+    /// Sample data is read from the file as it is first played, rather than
+    /// all at once; only the table of sounds is copied into memory.
+    /// Windows Phone does not support file mapping, so there the bank is
+    /// loaded as with NewBank().
+    /// This may return null if the bank cannot be loaded.
+    /// </para>
+    /// <para>
+    /// If the bank file is embedded in a larger file, specify the offset and 
+    /// length of the embedded data; otherwise, leave them both as 0.
+    /// </para>
+    /// </summary>
+    static Bank^ NewBankMapped(Platform::String^ path, PathType pathType, int offset, int length);
+
     /// <summary>
     /// Finds a loaded bank by name; returns null if not found. 
     /// </summary>
@@ -47,6 +47,11 @@ float Ck::RenderLoad::get()
     return CkGetRenderLoad();
 }
 
+long long Ck::SampleTime::get()
+{
+    return CkGetSampleTime();
+}
+
 bool Ck::ClipFlag::get()
 {
     return CkGetClipFlag();
@@ -57,6 +62,39 @@ void Ck::ResetClipFlag()
     CkResetClipFlag();
 }
 
+float Ck::OutputGainReduction::get()
+{
+    return CkGetOutputGainReduction();
+}
+
+DecodeCacheStats Ck::DecodeCacheStats::get()
+{
+    CkDecodeCacheStats stats;
+    CkGetDecodeCacheStats(&stats);
+
+    CricketTechnology::Audio::DecodeCacheStats result;
+    result.Hits = stats.hits;
+    result.Misses = stats.misses;
+    result.Evictions = stats.evictions;
+    result.Overflows = stats.overflows;
+    result.Entries = stats.entries;
+    result.Bytes = stats.bytes;
+    result.PinnedBytes = stats.pinnedBytes;
+    return result;
+}
+
+VoiceStats Ck::VoiceStats::get()
+{
+    CkVoiceStats stats;
+    CkGetVoiceStats(&stats);
+
+    CricketTechnology::Audio::VoiceStats result;
+    result.RealVoices = stats.realVoices;
+    result.VirtualVoices = stats.virtualVoices;
+    result.StolenVoices = stats.stolenVoices;
+    return result;
+}
+
 float Ck::VolumeRampTime::get()
 {
     return CkGetVolumeRampTime();
@@ -93,6 +131,17 @@ void Ck::StopCapture()
     CkStopCapture();
 }
 
+void Ck::StartRenderTrace(Platform::String^ path, PathType pathType)
+{
+    StringConvert<256> convert(path);
+    CkStartRenderTrace(convert.getCString(), (CkPathType) pathType);
+}
+
+void Ck::StopRenderTrace()
+{
+    CkStopRenderTrace();
+}
+
 
 }
 }
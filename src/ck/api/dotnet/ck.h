@@ -1,6 +1,8 @@
 ﻿#pragma once
 
 #include "pathtype.h"
+#include "decodecachestats.h"
+#include "voicestats.h"
 
 
 namespace CricketTechnology
@@ -53,6 +55,18 @@ public:
         float get();
     }
 
+    /// <summary>
+    /// Returns the sample time of the final audio output: the number of sample frames
+    /// rendered since initialization.  It does not advance while suspended.
+    /// Use it with Sound.PlayAt(), Sound.StopAt(), and Sound.SetVolumeAt() to schedule
+    /// changes to the exact sample frame; to be sure a change arrives in time, schedule
+    /// it at least Config.AudioUpdateMs ahead of this value.
+    /// </summary>
+    static property long long SampleTime
+    {
+        long long get();
+    }
+
     /// <summary>
     /// Returns the value of the clip flag.
     /// The clip flag is set to true whenever the final audio output "clips", i.e. 
@@ -70,6 +84,32 @@ public:
     /// </summary>
     static void ResetClipFlag();
 
+    /// <summary>
+    /// Returns the gain reduction, in dB, applied by the output limiter to the most
+    /// recently rendered audio (see Config.OutputLimiter); 0 if there is no limiter.
+    /// This does not lock the audio thread.
+    /// </summary>
+    static property float OutputGainReduction
+    {
+        float get();
+    }
+
+    /// <summary>
+    /// Gets statistics about the cache of decoded sound data.
+    /// </summary>
+    static property DecodeCacheStats DecodeCacheStats
+    {
+        CricketTechnology::Audio::DecodeCacheStats get();
+    }
+
+    /// <summary>
+    /// Gets the numbers of real and virtual sounds.
+    /// </summary>
+    static property VoiceStats VoiceStats
+    {
+        CricketTechnology::Audio::VoiceStats get();
+    }
+
 
     /// <summary>
     /// Gets/sets the maximum rate at which volumes change on playing sounds, in ms per full volume scale. 
@@ -117,6 +157,20 @@ public:
     /// </summary>
     static void StopCapture();
 
+
+    /// <summary>
+    /// Start recording when each sound, mixer, effect bus and effect is rendered, and how
+    /// long it takes, to a file.  The file is in the Chrome trace event JSON format, which
+    /// can be opened in Perfetto (ui.perfetto.dev) or chrome://tracing.  Events are
+    /// written to the file during Update().
+    /// </summary>
+    static void StartRenderTrace(Platform::String^ path, PathType);
+
+    /// <summary>
+    /// Stop recording the render trace, and close the file.
+    /// </summary>
+    static void StopRenderTrace();
+
 private:
     Ck();
 };
@@ -66,6 +66,66 @@ void Config::MaxRenderLoad::set(float value)
     m_cfg.maxRenderLoad = value;
 }
 
+ResampleQuality Config::ResampleQuality::get()
+{
+    return (CricketTechnology::Audio::ResampleQuality) m_cfg.resampleQuality;
+}
+
+void Config::ResampleQuality::set(CricketTechnology::Audio::ResampleQuality value)
+{
+    m_cfg.resampleQuality = (CkResampleQuality) value;
+}
+
+int Config::DecodeCacheBytes::get()
+{
+    return m_cfg.decodeCacheBytes;
+}
+
+void Config::DecodeCacheBytes::set(int value)
+{
+    m_cfg.decodeCacheBytes = value;
+}
+
+int Config::DecodeCacheMaxSoundBytes::get()
+{
+    return m_cfg.decodeCacheMaxSoundBytes;
+}
+
+void Config::DecodeCacheMaxSoundBytes::set(int value)
+{
+    m_cfg.decodeCacheMaxSoundBytes = value;
+}
+
+bool Config::OutputLimiter::get()
+{
+    return m_cfg.outputLimiter != 0;
+}
+
+void Config::OutputLimiter::set(bool value)
+{
+    m_cfg.outputLimiter = value;
+}
+
+float Config::OutputLimiterCeiling::get()
+{
+    return m_cfg.outputLimiterCeiling;
+}
+
+void Config::OutputLimiterCeiling::set(float value)
+{
+    m_cfg.outputLimiterCeiling = value;
+}
+
+int Config::MaxRealVoices::get()
+{
+    return m_cfg.maxRealVoices;
+}
+
+void Config::MaxRealVoices::set(int value)
+{
+    m_cfg.maxRealVoices = value;
+}
+
 
 }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ck/config.h"
+#include "resamplequality.h"
 
 
 namespace CricketTechnology
@@ -97,6 +98,78 @@ public:
         void set(float);
     }
 
+    /// <summary>
+    /// Method used to resample sounds whose ResampleQuality is
+    /// ResampleQuality.Default (see Sound.ResampleQuality).
+    /// Default is ResampleQuality.Linear.
+    /// </summary>
+    property ResampleQuality ResampleQuality
+    {
+        CricketTechnology::Audio::ResampleQuality get();
+        void set(CricketTechnology::Audio::ResampleQuality);
+    }
+
+    /// <summary>
+    /// Size of the cache of decoded sound data, in bytes.  Bank sounds in ADPCM
+    /// or lossless format that are at most DecodeCacheMaxSoundBytes when decoded,
+    /// or that are marked "hot" in the bank description file, are decoded once,
+    /// and the decoded data is shared by every sound that plays them.  When the cache is full, the least
+    /// recently used data that no sound is using is discarded.  Data for hot sounds is
+    /// kept until their bank is destroyed.  See Ck.DecodeCacheStats.
+    /// Default is 0 (no cache).
+    /// </summary>
+    property int DecodeCacheBytes
+    {
+        int get();
+        void set(int);
+    }
+
+    /// <summary>
+    /// Largest size, in bytes, of the decoded data of a bank sound that is not marked
+    /// "hot" for it to be kept in the decode cache (see DecodeCacheBytes).
+    /// Default is 262144 (256 KB).
+    /// </summary>
+    property int DecodeCacheMaxSoundBytes
+    {
+        int get();
+        void set(int);
+    }
+
+    /// <summary>
+    /// If true, the final mix goes through a true-peak look-ahead limiter,
+    /// instead of being clipped where it exceeds the maximum output level.  The
+    /// limiter delays the output by about 5 ms.  See Ck.OutputGainReduction.
+    /// Default is false (the output is clipped).
+    /// </summary>
+    property bool OutputLimiter
+    {
+        bool get();
+        void set(bool);
+    }
+
+    /// <summary>
+    /// Highest output level of the limiter (see OutputLimiter), in dB below full
+    /// scale.  Default is -1 dB.
+    /// </summary>
+    property float OutputLimiterCeiling
+    {
+        float get();
+        void set(float);
+    }
+
+    /// <summary>
+    /// Maximum number of sounds that are rendered at once.  If more sounds are
+    /// playing, the ones whose priority times volume is lowest become virtual
+    /// (see Sound.Priority and Sound.Virtual); this is updated
+    /// each time Ck.Update() is called.  See Ck.VoiceStats.
+    /// Default is 0 (no limit).
+    /// </summary>
+    property int MaxRealVoices
+    {
+        int get();
+        void set(int);
+    }
+
 internal:
     property CkConfig* Impl
     {
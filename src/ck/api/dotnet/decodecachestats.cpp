@@ -0,0 +1 @@
+#include "decodecachestats.h"
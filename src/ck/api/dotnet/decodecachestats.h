@@ -0,0 +1,56 @@
+#pragma once
+
+
+namespace CricketTechnology
+{
+namespace Audio
+{
+
+
+/// <summary>
+/// Statistics about the cache of decoded sound data; see Ck.DecodeCacheStats
+/// and Config.DecodeCacheBytes.
+/// </summary>
+public value struct DecodeCacheStats
+{
+    /// <summary>
+    /// Number of times a sound used data that was already decoded.
+    /// </summary>
+    int Hits;
+
+    /// <summary>
+    /// Number of times a sound's data was decoded and added to the cache.
+    /// </summary>
+    int Misses;
+
+    /// <summary>
+    /// Number of times data was discarded to make room for other data.
+    /// </summary>
+    int Evictions;
+
+    /// <summary>
+    /// Number of times a sound's data was not cached because the cache was full
+    /// of data in use.
+    /// </summary>
+    int Overflows;
+
+    /// <summary>
+    /// Number of sounds whose data is in the cache.
+    /// </summary>
+    int Entries;
+
+    /// <summary>
+    /// Total size of the data in the cache, in bytes.
+    /// </summary>
+    int Bytes;
+
+    /// <summary>
+    /// Size of the data in the cache that cannot be discarded, because it is in
+    /// use by a sound or belongs to a "hot" sound, in bytes.
+    /// </summary>
+    int PinnedBytes;
+};
+
+
+}
+}
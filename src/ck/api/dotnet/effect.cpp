@@ -1,5 +1,7 @@
 #include "effect.h"
+#include "bank.h"
 #include "proxy.h"
+#include "stringconvert.h"
 #include "ck/core/debug.h"
 #include "ck/effect.h"
 
@@ -38,6 +40,11 @@ void Effect::WetDryRatio::set(float ratio)
     m_impl->setWetDryRatio(ratio);
 }
 
+float Effect::GainReduction::get()
+{
+    return m_impl->getGainReduction();
+}
+
 Effect^ Effect::NewEffect(EffectType type)
 {
     CkEffect* impl = CkEffect::newEffect((CkEffectType) type);
@@ -50,6 +57,25 @@ Effect^ Effect::NewCustomEffect(int id)
     return Proxy::GetEffect(impl);
 }
 
+Effect^ Effect::NewConvolutionReverb(Bank^ bank, Platform::String^ soundName)
+{
+    StringConvert<256> convert(soundName);
+    CkEffect* impl = CkEffect::newConvolutionReverb(bank ? bank->Impl : NULL, convert.getCString());
+    return Proxy::GetEffect(impl);
+}
+
+Effect^ Effect::NewConvolutionReverb(Platform::String^ path, PathType pathType)
+{
+    StringConvert<256> convert(path);
+    CkEffect* impl = CkEffect::newConvolutionReverb(convert.getCString(), (CkPathType) pathType);
+    return Proxy::GetEffect(impl);
+}
+
+Effect^ Effect::NewConvolutionReverb(Platform::String^ path)
+{
+    return NewConvolutionReverb(path, PathType::Default);
+}
+
 void Effect::Destroy()
 {
     if (m_impl)
@@ -2,6 +2,7 @@
 
 #include <stddef.h>
 #include "effecttype.h"
+#include "pathtype.h"
 
 class CkEffect;
 
@@ -11,6 +12,7 @@ namespace CricketTechnology
 namespace Audio
 {
 
+ref class Bank;
 
 /// <summary>
 /// An audio effect. 
@@ -52,6 +54,16 @@ public:
         void set(float);
     }
 
+    /// <summary>
+    /// Gets the gain reduction, in dB, applied by a Compressor effect to the
+    /// most recently processed audio; 0 for other effects.  This does not
+    /// lock the audio thread.
+    /// </summary>
+    property float GainReduction
+    {
+        float get();
+    }
+
     /// <summary>
     /// Create a built-in effect. 
     /// </summary>
@@ -62,6 +74,32 @@ public:
     /// </summary>
     static Effect^ NewCustomEffect(int id);
 
+    /// <summary>
+    /// Create a convolution reverb effect, using a sound in a bank as its impulse response.
+    /// The impulse response may be mono or stereo; it is resampled to the output
+    /// sample rate and normalized.  The reverb output is delayed by 128 frames.
+    /// If bank is null, all loaded banks are searched for the first sound with
+    /// the given name.
+    /// Returns null if the sound is not found or can't be decoded.
+    /// See ConvolutionReverbParam for parameter IDs.
+    /// </summary>
+    static Effect^ NewConvolutionReverb(Bank^ bank, Platform::String^ soundName);
+
+    /// <summary>
+    /// Create a convolution reverb effect, using a .wav file as its impulse response.
+    /// The impulse response may be mono or stereo; it is resampled to the output
+    /// sample rate and normalized.  The reverb output is delayed by 128 frames.
+    /// Returns null if the file can't be read.
+    /// See ConvolutionReverbParam for parameter IDs.
+    /// </summary>
+    static Effect^ NewConvolutionReverb(Platform::String^ path, PathType pathType);
+
+    /// <summary>
+    /// Create a convolution reverb effect, using a .wav file as its impulse response.
+    /// Equivalent to NewConvolutionReverb(path, PathType.Default).
+    /// </summary>
+    static Effect^ NewConvolutionReverb(Platform::String^ path);
+
     /// <summary>
     /// Destroy the effect. 
     /// </summary>
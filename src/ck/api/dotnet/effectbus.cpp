@@ -60,6 +60,11 @@ void EffectBus::WetDryRatio::set(float ratio)
     m_impl->setWetDryRatio(ratio);
 }
 
+float EffectBus::RenderLoad::get()
+{
+    return m_impl->getRenderLoad();
+}
+
 EffectBus^ EffectBus::NewEffectBus()
 {
     return Proxy::GetEffectBus(CkEffectBus::newEffectBus());
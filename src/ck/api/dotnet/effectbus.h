@@ -74,6 +74,16 @@ public:
         void set(float);
     }
 
+    /// <summary>
+    /// Gets the fraction of real time spent rendering this bus, averaged over
+    /// about 100 ms.  This includes the effects on the bus and the sounds and
+    /// buses whose output is sent to it, so it is comparable to Ck.RenderLoad.
+    /// </summary>
+    property float RenderLoad
+    {
+        float get();
+    }
+
     /// <summary>
     /// Create a new effect bus. 
     /// </summary>
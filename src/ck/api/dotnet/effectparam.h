@@ -135,6 +135,94 @@ public enum class DistortionParam
 };
 
 
+////////////////////////////////////////
+
+
+/// <summary>
+/// Parameters for the Reverb effect
+/// </summary>
+public enum class ReverbParam
+{
+    /// <summary>
+    /// Room size, from 0 (small) to 1 (large); the default is 0.5.
+    /// </summary>
+    Size = kCkReverbParam_Size,
+
+    /// <summary>
+    /// Time (in seconds) for the reverb to decay by 60 dB, in [0.1..30]; the default is 1.5.
+    /// </summary>
+    DecayTime = kCkReverbParam_DecayTime,
+
+    /// <summary>
+    /// Damping of high frequencies, from 0 (bright) to 1 (dark); the default is 0.5.
+    /// </summary>
+    Damping = kCkReverbParam_Damping,
+
+    /// <summary>
+    /// Milliseconds before the reverb starts, in [0..100]; the default is 20.
+    /// </summary>
+    PreDelayMs = kCkReverbParam_PreDelayMs,
+};
+
+
+////////////////////////////////////////
+
+
+/// <summary>
+/// Parameters for the Compressor effect
+/// </summary>
+public enum class CompressorParam
+{
+    /// <summary>
+    /// Level (in dB) above which the gain is reduced, in [-60..0]; the default is -12.
+    /// </summary>
+    Threshold = kCkCompressorParam_Threshold,
+
+    /// <summary>
+    /// Amount of compression above the threshold, in [1..1000]; each dB above
+    /// the threshold becomes 1/ratio dB.  The default is 4.  A ratio of 1000 is
+    /// treated as infinite, for a limiter.
+    /// </summary>
+    Ratio = kCkCompressorParam_Ratio,
+
+    /// <summary>
+    /// Look-ahead time (in ms), in [0..20]; the default is 5.  This is also the
+    /// attack time, and the amount the output is delayed.
+    /// </summary>
+    LookaheadMs = kCkCompressorParam_LookaheadMs,
+
+    /// <summary>
+    /// Time (in ms) for the gain to recover, in [1..5000]; the default is 100.
+    /// </summary>
+    ReleaseMs = kCkCompressorParam_ReleaseMs,
+
+    /// <summary>
+    /// Gain (in dB) applied after compression, in [0..40]; the default is 0.
+    /// </summary>
+    MakeupGain = kCkCompressorParam_MakeupGain,
+
+    /// <summary>
+    /// If nonzero, peaks between samples are detected too; the default is 0.
+    /// </summary>
+    TruePeak = kCkCompressorParam_TruePeak,
+};
+
+
+////////////////////////////////////////
+
+
+/// <summary>
+/// Parameters for the Convolution Reverb effect
+/// </summary>
+public enum class ConvolutionReverbParam
+{
+    /// <summary>
+    /// Gain applied to the reverb output; the default is 1.
+    /// </summary>
+    Gain = kCkConvolutionReverbParam_Gain,
+};
+
+
 }
 }
 
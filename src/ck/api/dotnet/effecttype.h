@@ -38,6 +38,20 @@ public enum class EffectType
     /// See DistortionParam enum for parameter IDs. 
     /// </summary>
     Distortion = kCkEffectType_Distortion,
+
+    /// <summary>
+    /// Reverb effect simulates the reflections of a room, with a feedback delay network.
+    /// See ReverbParam enum for parameter IDs. 
+    /// </summary>
+    Reverb = kCkEffectType_Reverb,
+
+    /// <summary>
+    /// Compressor effect reduces the level of loud audio, with a look-ahead
+    /// window so peaks are caught before they are output; with a high ratio, it
+    /// is a limiter.  Output is delayed by the look-ahead time.
+    /// See CompressorParam enum for parameter IDs. 
+    /// </summary>
+    Compressor = kCkEffectType_Compressor,
 };
 
 
@@ -0,0 +1 @@
+#include "resamplequality.h"
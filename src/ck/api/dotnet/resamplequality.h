@@ -0,0 +1,43 @@
+#pragma once
+
+#include "ck/resamplequality.h"
+
+
+namespace CricketTechnology
+{
+namespace Audio
+{
+
+
+/// <summary>
+/// Indicates how sounds are resampled when their sample rate or playback speed
+/// does not match the output sample rate.
+/// </summary>
+public enum class ResampleQuality
+{
+
+    /// <summary>
+    /// Use the value of Config.ResampleQuality.
+    /// </summary>
+    Default = kCkResampleQuality_Default,
+
+    /// <summary>
+    /// Linear interpolation.  This is the cheapest method, but high frequencies
+    /// are attenuated, and sounds played faster than their original speed may
+    /// have audible aliasing.
+    /// </summary>
+    Linear = kCkResampleQuality_Linear,
+
+    /// <summary>
+    /// Band-limited interpolation with a windowed-sinc filter.  This is free
+    /// of audible aliasing, but takes several times as much CPU as linear
+    /// interpolation, and delays the sound by 17 frames.
+    /// </summary>
+    Sinc = kCkResampleQuality_Sinc
+
+};
+
+
+}
+}
+
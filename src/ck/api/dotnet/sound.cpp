@@ -43,6 +43,16 @@ void Sound::Stop()
     m_impl->stop();
 }
 
+void Sound::PlayAt(long long sampleTime)
+{
+    m_impl->playAt(sampleTime);
+}
+
+void Sound::StopAt(long long sampleTime)
+{
+    m_impl->stopAt(sampleTime);
+}
+
 bool Sound::Playing::get()
 {
     return m_impl->isPlaying();
@@ -128,6 +138,11 @@ void Sound::Volume::set(float vol)
     m_impl->setVolume(vol);
 }
 
+void Sound::SetVolumeAt(float vol, long long sampleTime)
+{
+    m_impl->setVolumeAt(vol, sampleTime);
+}
+
 float Sound::MixedVolume::get()
 {
     return m_impl->getMixedVolume();
@@ -183,6 +198,26 @@ void Sound::Speed::set(float speed)
     m_impl->setSpeed(speed);
 }
 
+ResampleQuality Sound::ResampleQuality::get()
+{
+    return (CricketTechnology::Audio::ResampleQuality) m_impl->getResampleQuality();
+}
+
+void Sound::ResampleQuality::set(CricketTechnology::Audio::ResampleQuality quality)
+{
+    m_impl->setResampleQuality((CkResampleQuality) quality);
+}
+
+float Sound::Priority::get()
+{
+    return m_impl->getPriority();
+}
+
+void Sound::Priority::set(float priority)
+{
+    m_impl->setPriority(priority);
+}
+
 int Sound::Length::get()
 {
     return m_impl->getLength();
@@ -327,6 +362,22 @@ Sound^ Sound::NewBankSound(Bank^ bank, Platform::String^ name)
     return Proxy::GetSound(impl);
 }
 
+Sound^ Sound::NewBankSound(Bank^ bank, SoundId id)
+{
+    CkSoundId ckId;
+    ckId.hash = id.Hash;
+    CkSound* impl = CkSound::newBankSound(bank ? bank->Impl : NULL, ckId);
+    return Proxy::GetSound(impl);
+}
+
+SoundId Sound::GetSoundId(Platform::String^ name)
+{
+    StringConvert<256> convert(name);
+    SoundId id;
+    id.Hash = CkSound::getSoundId(convert.getCString()).hash;
+    return id;
+}
+
 Sound^ Sound::NewStreamSound(Platform::String^ path)
 {
     return NewStreamSound(path, PathType::Default);
@@ -3,6 +3,8 @@
 #include <stddef.h>
 #include "attenuationmode.h"
 #include "pathtype.h"
+#include "resamplequality.h"
+#include "soundid.h"
 
 class CkSound;
 
@@ -60,6 +62,20 @@ public:
     /// </summary>
     void Stop();
 
+    /// <summary>
+    /// Play the sound at the given sample time of the audio output (see Ck.SampleTime).
+    /// The sound starts at exactly that sample frame.  If that time has already passed,
+    /// the sound plays as soon as possible.  Any later call to Stop() cancels it.
+    /// </summary>
+    void PlayAt(long long sampleTime);
+
+    /// <summary>
+    /// Stop the sound at the given sample time of the audio output (see Ck.SampleTime).
+    /// The sound stops at exactly that sample frame; until then, this.Playing is true.
+    /// If that time has already passed, the sound stops as soon as possible.
+    /// </summary>
+    void StopAt(long long sampleTime);
+
     /// <summary>
     /// Gets whether the sound is playing. 
     /// </summary>
@@ -170,6 +186,13 @@ public:
         void set(float);
     }
 
+    /// <summary>
+    /// Sets the volume at the given sample time of the audio output (see Ck.SampleTime).
+    /// this.Volume returns the new value immediately; the sound starts changing to it at
+    /// exactly that sample frame (at the rate set by Ck.VolumeRampTime).
+    /// </summary>
+    void SetVolumeAt(float vol, long long sampleTime);
+
     /// <summary>
     /// Gets the volume value used for mixing. 
     /// This is the product of the volume set with this.Volume and the mixed
@@ -231,6 +254,29 @@ public:
         void set(float);
     }
 
+    /// <summary>
+    /// Gets/sets the method used to resample the sound, when its sample rate or speed
+    /// does not match the output sample rate.  The default value is ResampleQuality.Default,
+    /// which uses the value of Config.ResampleQuality.
+    /// </summary>
+    property ResampleQuality ResampleQuality
+    {
+        CricketTechnology::Audio::ResampleQuality get();
+        void set(CricketTechnology::Audio::ResampleQuality);
+    }
+
+    /// <summary>
+    /// Gets/sets the priority of the sound, for voice limiting.
+    /// When more sounds are playing than the voice limit allows, the ones
+    /// with the lowest priority times volume become virtual.
+    /// The default value is 1.
+    /// </summary>
+    property float Priority
+    {
+        float get();
+        void set(float);
+    }
+
     /// <summary>
     /// Gets/sets the sound to be played when this sound finishes playing.
     /// The next sound will play immediately, with no gaps. 
@@ -300,11 +346,13 @@ public:
     }
 
     /// <summary>
-    /// Gets whether a 3D sound is virtual.
+    /// Gets whether a sound is virtual.
     /// If, due to distance attenuation, a 3D sound's volume becomes near enough to 0
-    /// to be inaudible, it becomes "virtual".  A virtual sound is effectively paused
-    /// and is not processed until it would become audible again; this reduces the 
-    /// amount of audio processing required. 
+    /// to be inaudible, it becomes "virtual".  A sound also becomes virtual if more
+    /// sounds are playing than the voice limit allows, and it is one of the least
+    /// important (see Priority).  A virtual sound is not resampled or mixed, but its
+    /// play position is kept up to date, so it resumes at the right place when it
+    /// becomes real again; this reduces the amount of audio processing required.
     /// </summary>
     property bool Virtual
     {
@@ -466,6 +514,20 @@ public:
     /// </summary>
     static Sound^ NewBankSound(Bank^, Platform::String^ name);
 
+    /// <summary>
+    /// Creates a sound from a bank by id. 
+    /// If bank is null, all loaded banks are searched for the first matching sound. 
+    /// In the unlikely case that two names in the banks being searched have the
+    /// same id, either sound may be returned; cktool warns about this within a bank. 
+    /// </summary>
+    static Sound^ NewBankSound(Bank^, SoundId id);
+
+    /// <summary>
+    /// Returns the id for a bank sound name, for use with NewBankSound(Bank, SoundId). 
+    /// Ids do not depend on which banks are loaded, so they can be computed once ahead of time. 
+    /// </summary>
+    static SoundId GetSoundId(Platform::String^ name);
+
     /// <summary>
     /// Creates a stream from a file path. 
     /// Equivalent to NewStreamSound(path, PathType.Default). 
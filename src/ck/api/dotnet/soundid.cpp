@@ -0,0 +1 @@
+#include "soundid.h"
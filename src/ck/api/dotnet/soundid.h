@@ -0,0 +1,24 @@
+#pragma once
+
+#include "ck/soundid.h"
+
+
+namespace CricketTechnology
+{
+namespace Audio
+{
+
+
+/// <summary>
+/// Identifies a bank sound by a hash of its name; see Sound.GetSoundId(). 
+/// Creating sounds by id skips hashing and comparing the name. 
+/// </summary>
+public value struct SoundId
+{
+    unsigned int Hash;
+};
+
+
+}
+}
+
@@ -0,0 +1 @@
+#include "voicestats.h"
@@ -0,0 +1,35 @@
+#pragma once
+
+
+namespace CricketTechnology
+{
+namespace Audio
+{
+
+
+/// <summary>
+/// Numbers of real and virtual sounds, as of the most recent call to
+/// Ck.Update(); see Ck.VoiceStats and Config.MaxRealVoices.
+/// </summary>
+public value struct VoiceStats
+{
+    /// <summary>
+    /// Number of playing sounds that are rendered.
+    /// </summary>
+    int RealVoices;
+
+    /// <summary>
+    /// Number of playing sounds that are virtual (see Sound.Virtual).
+    /// </summary>
+    int VirtualVoices;
+
+    /// <summary>
+    /// Number of sounds that were made virtual in the most recent update because
+    /// the limit on real voices was exceeded.
+    /// </summary>
+    int StolenVoices;
+};
+
+
+}
+}
@@ -1,5 +1,6 @@
 #include "ck/effect.h"
 #include "ck/audio/effect.h"
+#include "ck/audio/bank.h"
 
 
 CkEffect* CkEffect::newEffect(CkEffectType type)
@@ -7,6 +8,16 @@ CkEffect* CkEffect::newEffect(CkEffectType type)
     return (CkEffect*) Cki::Effect::newEffect(type);
 }
 
+CkEffect* CkEffect::newConvolutionReverb(CkBank* bank, const char* soundName)
+{
+    return (CkEffect*) Cki::Effect::newConvolutionReverb((Cki::Bank*) bank, soundName);
+}
+
+CkEffect* CkEffect::newConvolutionReverb(const char* path, CkPathType pathType)
+{
+    return (CkEffect*) Cki::Effect::newConvolutionReverb(path, pathType);
+}
+
 void CkEffect::registerCustomEffect(int id, CustomEffectFunc func)
 {
     Cki::Effect::registerCustomEffect(id, func);
@@ -77,6 +77,23 @@
     return CkoBankProxyGet(impl);
 }
 
++ (CkoBank*) newBankMapped:(NSString*)path 
+{
+    return [CkoBank newBankMapped:path pathType:kCkPathType_Default];
+}
+
++ (CkoBank*) newBankMapped:(NSString*)path pathType:(CkPathType)pathType
+{
+    return [CkoBank newBankMapped:path pathType:pathType offset:0 length:0];
+}
+
++ (CkoBank*) newBankMapped:(NSString*)path pathType:(CkPathType)pathType offset:(int)offset length:(int)length
+{
+    NsStringRef str(path);
+    CkBank* impl = CkBank::newBankMapped(str.getChars(), pathType, offset, length);
+    return CkoBankProxyGet(impl);
+}
+
 + (CkoBank*) find:(NSString*)name
 {
     NsStringRef str(name);
@@ -1,5 +1,8 @@
 #import "ck/objc/effect.h"
+#import "ck/objc/bank.h"
 #import "ck/effect.h"
+#import "ck/api/objc/bank_p.h"
+#import "ck/api/objc/nsstringref.h"
 #import "ck/api/objc/proxy.h"
 
 @implementation CkoEffect
@@ -38,6 +41,11 @@
     return m_impl->getWetDryRatio();
 }
 
+- (float) gainReduction
+{
+    return m_impl->getGainReduction();
+}
+
 + (CkoEffect*) newEffect:(CkEffectType)type;
 {
     CkEffect* effectImpl = CkEffect::newEffect(type);
@@ -50,6 +58,25 @@
     return CkoEffectProxyGet(effectImpl);
 }
 
++ (CkoEffect*) newConvolutionReverb:(CkoBank*)bank name:(NSString*)name
+{
+    NsStringRef str(name);
+    CkEffect* effectImpl = CkEffect::newConvolutionReverb([bank impl], str.getChars());
+    return CkoEffectProxyGet(effectImpl);
+}
+
++ (CkoEffect*) newConvolutionReverb:(NSString*)path
+{
+    return [CkoEffect newConvolutionReverb:path pathType:kCkPathType_Default];
+}
+
++ (CkoEffect*) newConvolutionReverb:(NSString*)path pathType:(CkPathType)pathType
+{
+    NsStringRef str(path);
+    CkEffect* effectImpl = CkEffect::newConvolutionReverb(str.getChars(), pathType);
+    return CkoEffectProxyGet(effectImpl);
+}
+
 ////////////////////////////////////////
 // overrides
 
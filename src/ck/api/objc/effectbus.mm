@@ -61,6 +61,11 @@
     return m_impl->getWetDryRatio();
 }
 
+- (float) renderLoad
+{
+    return m_impl->getRenderLoad();
+}
+
 + (CkoEffectBus*) newEffectBus
 {
     return CkoEffectBusProxyGet(CkEffectBus::newEffectBus());
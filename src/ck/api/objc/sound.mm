@@ -46,6 +46,16 @@
     m_impl->stop();
 }
 
+- (void) playAt:(long long)sampleTime
+{
+    m_impl->playAt(sampleTime);
+}
+
+- (void) stopAt:(long long)sampleTime
+{
+    m_impl->stopAt(sampleTime);
+}
+
 - (BOOL) playing
 {
     return m_impl->isPlaying();
@@ -130,6 +140,11 @@
     m_impl->setVolume(volume);
 }
 
+- (void) setVolume:(float)volume at:(long long)sampleTime
+{
+    m_impl->setVolumeAt(volume, sampleTime);
+}
+
 - (float) volume
 {
     return m_impl->getVolume();
@@ -180,6 +195,26 @@
     return m_impl->getSpeed();
 }
 
+- (void) setResampleQuality:(CkResampleQuality)quality
+{
+    m_impl->setResampleQuality(quality);
+}
+
+- (CkResampleQuality) resampleQuality
+{
+    return m_impl->getResampleQuality();
+}
+
+- (void) setPriority:(float)priority
+{
+    m_impl->setPriority(priority);
+}
+
+- (float) priority
+{
+    return m_impl->getPriority();
+}
+
 - (void) setNextSound:(CkoSound*)next
 {
     m_impl->setNextSound(next ? [next impl] : NULL);
@@ -334,6 +369,18 @@
     return CkoSoundProxyGet(soundImpl);
 }
 
++ newBankSound:(CkoBank*)bank soundId:(CkSoundId)soundId
+{
+    CkSound* soundImpl = CkSound::newBankSound([bank impl], soundId);
+    return CkoSoundProxyGet(soundImpl);
+}
+
++ (CkSoundId) getSoundId:(NSString*)name
+{
+    NsStringRef str(name);
+    return CkSound::getSoundId(str.getChars());
+}
+
 + newStreamSound:(NSString*)path
 {
     return [CkoSound newStreamSound:path pathType:kCkPathType_Default];
@@ -1,5 +1,6 @@
 #include "ck/sound.h"
 #include "ck/audio/sound.h"
+#include "ck/audio/soundname.h"
 
 
 void CkSound::set3dListenerPosition(float eyeX, float eyeY, float eyeZ,
@@ -61,6 +62,18 @@ CkSound* CkSound::newBankSound(CkBank* bank, const char* name)
     return (CkSound*) Cki::Sound::newBankSound((Cki::Bank*) bank, name);
 }
 
+CkSound* CkSound::newBankSound(CkBank* bank, CkSoundId id)
+{
+    return (CkSound*) Cki::Sound::newBankSound((Cki::Bank*) bank, (Cki::uint32) id.hash);
+}
+
+CkSoundId CkSound::getSoundId(const char* name)
+{
+    CkSoundId id;
+    id.hash = Cki::SoundName::hash(name);
+    return id;
+}
+
 CkSound* CkSound::newStreamSound(const char* filename, CkPathType pathType, int offset, int length, const char* extension)
 {
     return (CkSound*) Cki::Sound::newStreamSound(filename, pathType, offset, length, extension);
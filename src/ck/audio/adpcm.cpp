@@ -2,6 +2,7 @@
 #include "ck/core/mem.h"
 #include "ck/core/debug.h"
 #include "ck/core/math.h"
+#include "ck/core/system.h"
 
 namespace Cki
 {
@@ -48,6 +49,71 @@ namespace
     const int k_fixedPointCoefBase = 256;
     const int k_fixedPointAdaptionBase = 256;
     const int k_minDelta = 16;
+
+    // decoded samples, in the format of each output buffer type
+    inline void store(int sample, int16* p) { *p = (int16) sample; }
+    inline void store(int sample, int32* p) { *p = sample << 9; } // 8.24; 9 because of sign bit
+    inline void store(int sample, float* p) { *p = sample * (1.0f / CK_INT16_MAX); }
+
+    template <typename T>
+    int decodeImpl(const byte* input, int inputBytes, T* output, int outputStride)
+    {
+        CK_ASSERT(inputBytes >= 7);
+
+        const byte* inputEnd = input + inputBytes;
+        T* outputStart = output;
+
+        uint8 predictor = *input++;
+        CK_ASSERT(predictor <= k_numCoeffs);
+
+        int16 delta;
+        Mem::copy(&delta, input, sizeof(delta));
+        CK_ASSERT(delta >= k_minDelta);
+        input += sizeof(delta);
+
+        int16 samp2;
+        Mem::copy(&samp2, input, sizeof(samp2));
+        input += sizeof(samp2);
+
+        int16 samp1;
+        Mem::copy(&samp1, input, sizeof(samp1));
+        input += sizeof(samp1);
+
+        store(samp2, output);
+        output += outputStride;
+        store(samp1, output);
+        output += outputStride;
+
+        int coef1 = g_coeffs[predictor][0];
+        int coef2 = g_coeffs[predictor][1];
+
+        while (input < inputEnd)
+        {
+            for (int nybble = 0; nybble < 2; ++nybble)
+            {
+                int predSamp = ((samp1 * coef1) + (samp2 * coef2)) / k_fixedPointCoefBase;
+                int errorDelta = (*input >> (nybble*4)) & 0xf;
+                predSamp += delta * ((errorDelta ^ 0x8) - 0x8); // sign-extend
+                int newSamp = Math::clamp(predSamp, CK_INT16_MIN, CK_INT16_MAX);
+                store(newSamp, output);
+                output += outputStride;
+
+                delta = (int16) (delta * g_adaptionTable[errorDelta] / k_fixedPointAdaptionBase);
+                if (delta < k_minDelta) 
+                {
+                    delta = k_minDelta;
+                }
+
+                samp2 = samp1;
+                samp1 = (int16) newSamp;
+            }
+            ++input;
+        }
+
+        int outputSamples = (int)(output - outputStart) / outputStride;
+        CK_ASSERT(outputSamples == 2*inputBytes - 12);
+        return outputSamples;
+    }
 }
 
 namespace Adpcm
@@ -126,68 +192,74 @@ namespace Adpcm
     int decode(const byte* input, int inputBytes, int16* output, int outputStride)
     {
         CK_ASSERT(outputStride == 1 || outputStride == 2);
-        CK_ASSERT(inputBytes >= 7);
-
-        const byte* inputEnd = input + inputBytes;
-        int16* outputStart = output;
-
-        uint8 predictor = *input++;
-        CK_ASSERT(predictor <= k_numCoeffs);
+        return decodeImpl(input, inputBytes, output, outputStride);
+    }
 
-        int16 delta;
-        Mem::copy(&delta, input, sizeof(delta));
-        CK_ASSERT(delta >= k_minDelta);
-        input += sizeof(delta);
+    ////////////////////////////////////////
 
-        int16 samp2;
-        Mem::copy(&samp2, input, sizeof(samp2));
-        input += sizeof(samp2);
+    namespace
+    {
+        typedef void (*DecodeFixedFunc)(const byte*, int, int, int32*);
+        typedef void (*DecodeFloatFunc)(const byte*, int, int, float*);
+        DecodeFixedFunc g_decodeFixed = decodeBlocks_default;
+        DecodeFloatFunc g_decodeFloat = decodeBlocks_default;
+    }
 
-        int16 samp1;
-        Mem::copy(&samp1, input, sizeof(samp1));
-        input += sizeof(samp1);
+    void init()
+    {
+        g_decodeFixed = decodeBlocks_default;
+        g_decodeFloat = decodeBlocks_default;
+#if CK_X86_SSE
+        if (System::get()->getSimdLevel() >= kCkSimdLevel_Basic)
+        {
+            g_decodeFixed = decodeBlocks_sse;
+            g_decodeFloat = decodeBlocks_sse;
+        }
+#endif
+    }
 
-        *output = samp2;
-        output += outputStride;
-        *output = samp1;
-        output += outputStride;
+    void decodeBlocks(const byte* input, int blocks, int channels, int32* output)
+    {
+        g_decodeFixed(input, blocks, channels, output);
+    }
 
-        int coef1 = g_coeffs[predictor][0];
-        int coef2 = g_coeffs[predictor][1];
+    void decodeBlocks(const byte* input, int blocks, int channels, float* output)
+    {
+        g_decodeFloat(input, blocks, channels, output);
+    }
 
-        while (input < inputEnd)
+    template <typename T>
+    void decodeBlocksImpl(const byte* input, int blocks, int channels, T* output)
+    {
+        CK_ASSERT(channels == 1 || channels == 2);
+        for (int i = 0; i < blocks * channels; ++i)
         {
-            for (int nybble = 0; nybble < 2; ++nybble)
-            {
-                int predSamp = ((samp1 * coef1) + (samp2 * coef2)) / k_fixedPointCoefBase;
-                int errorDelta = (*input >> (nybble*4)) & 0xf;
-                if (errorDelta & 0x8) // negative
-                {
-                    predSamp += delta * (errorDelta - 0x10);
-                }
-                else
-                {
-                    predSamp += delta * errorDelta;
-                }
-                int newSamp = Math::clamp(predSamp, CK_INT16_MIN, CK_INT16_MAX);
-                *output = (int16) newSamp;
-                output += outputStride;
+            int block = i / channels;
+            int channel = i - block * channels;
+            decodeImpl(input + i * k_bytesPerBlock, k_bytesPerBlock, output + block * k_samplesPerBlock * channels + channel, channels);
+        }
+    }
 
-                delta = (int16) (delta * g_adaptionTable[errorDelta] / k_fixedPointAdaptionBase);
-                if (delta < k_minDelta) 
-                {
-                    delta = k_minDelta;
-                }
+    void decodeBlocks_default(const byte* input, int blocks, int channels, int32* output)
+    {
+        decodeBlocksImpl(input, blocks, channels, output);
+    }
 
-                samp2 = samp1;
-                samp1 = (int16) newSamp;
-            }
-            ++input;
-        }
+    void decodeBlocks_default(const byte* input, int blocks, int channels, float* output)
+    {
+        decodeBlocksImpl(input, blocks, channels, output);
+    }
 
-        int outputSamples = (int)(output - outputStart) / outputStride;
-        CK_ASSERT(outputSamples == 2*inputBytes - 12);
-        return outputSamples;
+    void getCoefs(int predictor, int& coef1, int& coef2)
+    {
+        CK_ASSERT(predictor < k_numCoeffs);
+        coef1 = g_coeffs[predictor][0];
+        coef2 = g_coeffs[predictor][1];
+    }
+
+    int getAdaption(int code)
+    {
+        return g_adaptionTable[code & 0xf];
     }
 
 }
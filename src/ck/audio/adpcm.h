@@ -22,6 +22,26 @@ namespace Adpcm
 
     // Returns number of samples decoded (which will be equal to 2*inputBytes - 12)
     int decode(const byte* input, int inputBytes, int16* output, int outputStride);
+
+    // Choose the decodeBlocks() implementation, according to System::getSimdLevel().
+    void init();
+
+    // Decode whole blocks straight to the audio pipeline's sample format (8.24
+    // fixed point or float), with channels interleaved.  Each input block holds
+    // k_bytesPerBlock bytes for each channel in turn, as in banks and streams;
+    // output is blocks*k_samplesPerBlock frames.
+    void decodeBlocks(const byte* input, int blocks, int channels, int32* output);
+    void decodeBlocks_default(const byte* input, int blocks, int channels, int32* output);
+    void decodeBlocks_sse(const byte* input, int blocks, int channels, int32* output);
+
+    void decodeBlocks(const byte* input, int blocks, int channels, float* output);
+    void decodeBlocks_default(const byte* input, int blocks, int channels, float* output);
+    void decodeBlocks_sse(const byte* input, int blocks, int channels, float* output);
+
+    // predictor coefficients, and the step size adaption for each 4-bit code,
+    // as 8.8 fixed point
+    void getCoefs(int predictor, int& coef1, int& coef2);
+    int getAdaption(int code);
 }
 
 
@@ -0,0 +1,244 @@
+#include "ck/audio/adpcm.h"
+#include "ck/core/debug.h"
+#include "ck/core/math.h"
+#include "ck/core/mem.h"
+#include "ck/core/sse.h"
+
+#if CK_X86_SSE
+
+#include <emmintrin.h>
+
+namespace Cki
+{
+
+
+namespace Adpcm
+{
+    namespace
+    {
+        // Decoding is serial within a block, but blocks are independent, so
+        // four blocks (or both channels of two stereo blocks) are decoded at
+        // once, one per lane.
+        enum { k_lanes = 4 };
+        enum { k_headerBytes = 7 };
+        enum { k_dataBytes = k_bytesPerBlock - k_headerBytes };
+
+        // a silent block, for unused lanes
+        const byte k_silentBlock[k_bytesPerBlock] = { 0, 16, 0 };
+
+        // Decodes one block in each lane; out[i] holds sample i of each block.
+        void decode4(const byte* const* input, __m128i* out)
+        {
+            // Samples and coefficients are in pairs of 16-bit values, for _mm_madd_epi16():
+            //   pair = samp1 | samp2 << 16
+            //   coefs = coef1 | coef2 << 16
+            int32 pairs[k_lanes];
+            int32 coefs[k_lanes];
+            int32 deltas[k_lanes];
+            int32 first[2][k_lanes];
+
+            // data bytes, transposed so each step loads one byte of each block
+            int32 data[k_dataBytes][k_lanes];
+
+            for (int lane = 0; lane < k_lanes; ++lane)
+            {
+                const byte* p = input[lane];
+
+                int16 delta;
+                int16 samp2;
+                int16 samp1;
+                Mem::copy(&delta, p + 1, sizeof(delta));
+                Mem::copy(&samp2, p + 3, sizeof(samp2));
+                Mem::copy(&samp1, p + 5, sizeof(samp1));
+                CK_ASSERT(delta >= 16);
+
+                int coef1, coef2;
+                getCoefs(p[0], coef1, coef2);
+
+                pairs[lane] = (uint16) samp1 | ((uint16) samp2 << 16);
+                coefs[lane] = (uint16) coef1 | ((uint16) coef2 << 16);
+                deltas[lane] = delta;
+                first[0][lane] = samp2;
+                first[1][lane] = samp1;
+
+                for (int i = 0; i < k_dataBytes; ++i)
+                {
+                    data[i][lane] = p[k_headerBytes + i];
+                }
+            }
+
+            out[0] = _mm_loadu_si128((const __m128i*) first[0]);
+            out[1] = _mm_loadu_si128((const __m128i*) first[1]);
+
+            __m128i pair = _mm_loadu_si128((const __m128i*) pairs);
+            __m128i coef = _mm_loadu_si128((const __m128i*) coefs);
+            __m128i delta = _mm_loadu_si128((const __m128i*) deltas);
+
+            // The adaption depends only on the magnitude of the signed error
+            // delta (code 8 is -8), and is the same for magnitudes 0-3; it is
+            // built up from the steps between magnitudes, selected by comparisons.
+            const __m128i adaptBase = _mm_set1_epi32(getAdaption(0));
+            __m128i adaptStep[5];
+            __m128i adaptThreshold[5];
+            for (int i = 0; i < 5; ++i)
+            {
+                adaptStep[i] = _mm_set1_epi32(getAdaption(i + 4) - getAdaption(i + 3));
+                adaptThreshold[i] = _mm_set1_epi32(i + 3);
+            }
+
+            const __m128i round = _mm_set1_epi32(255);
+            const __m128i mask16 = _mm_set1_epi32(0xffff);
+            const __m128i minDelta = _mm_set1_epi32(16);
+
+            __m128i* pOut = out + 2;
+            for (int i = 0; i < k_dataBytes; ++i)
+            {
+                __m128i bytes = _mm_loadu_si128((const __m128i*) data[i]);
+                for (int nybble = 0; nybble < 2; ++nybble)
+                {
+                    // signed error delta, low nybble first
+                    __m128i errorDelta = (nybble == 0 ?
+                            _mm_srai_epi32(_mm_slli_epi32(bytes, 28), 28) :
+                            _mm_srai_epi32(_mm_slli_epi32(bytes, 24), 28));
+
+                    // predSamp = (samp1*coef1 + samp2*coef2) / 256, rounding toward 0
+                    __m128i pred = _mm_madd_epi16(pair, coef);
+                    pred = _mm_add_epi32(pred, _mm_and_si128(_mm_srai_epi32(pred, 31), round));
+                    pred = _mm_srai_epi32(pred, 8);
+
+                    // + delta*errorDelta, clamped to int16
+                    pred = _mm_add_epi32(pred, _mm_madd_epi16(delta, _mm_and_si128(errorDelta, mask16)));
+                    __m128i samp = _mm_packs_epi32(pred, pred);
+                    samp = _mm_srai_epi32(_mm_unpacklo_epi16(samp, samp), 16);
+                    *pOut++ = samp;
+
+                    pair = _mm_or_si128(_mm_slli_epi32(pair, 16), _mm_and_si128(samp, mask16));
+
+                    // delta = (int16) (delta * adaption / 256), at least 16
+                    __m128i sign = _mm_srai_epi32(errorDelta, 31);
+                    __m128i magnitude = _mm_sub_epi32(_mm_xor_si128(errorDelta, sign), sign);
+                    __m128i adapt = adaptBase;
+                    for (int j = 0; j < 5; ++j)
+                    {
+                        adapt = _mm_add_epi32(adapt, _mm_and_si128(_mm_cmpgt_epi32(magnitude, adaptThreshold[j]), adaptStep[j]));
+                    }
+                    // only the low 16 bits of delta are used; they are
+                    // compared as int16, as in the scalar code
+                    delta = _mm_srli_epi32(_mm_madd_epi16(delta, adapt), 8);
+                    delta = _mm_max_epi16(delta, minDelta);
+                }
+            }
+        }
+
+        // convert 4 decoded samples to the output format
+        inline __m128i convert(__m128i samples, const int32*)
+        {
+            return _mm_slli_epi32(samples, 9); // 8.24; 9 because of sign bit
+        }
+
+        inline __m128 convert(__m128i samples, const float*)
+        {
+            return _mm_mul_ps(_mm_cvtepi32_ps(samples), _mm_set1_ps(1.0f / CK_INT16_MAX));
+        }
+
+        inline void store4(int32* p, __m128i v) { _mm_storeu_si128((__m128i*) p, v); }
+        inline void store4(float* p, __m128 v) { _mm_storeu_ps(p, v); }
+        inline void storeLow2(int32* p, __m128i v) { _mm_storel_epi64((__m128i*) p, v); }
+        inline void storeLow2(float* p, __m128 v) { _mm_storel_pi((__m64*) p, v); }
+        inline void storeHigh2(int32* p, __m128i v) { _mm_storel_epi64((__m128i*) p, _mm_unpackhi_epi64(v, v)); }
+        inline void storeHigh2(float* p, __m128 v) { _mm_storeh_pi((__m64*) p, v); }
+
+        template <typename T>
+        void decodeMono(const byte* input, int blocks, T* output)
+        {
+            __m128i decoded[k_samplesPerBlock];
+            for (int block = 0; block < blocks; block += k_lanes)
+            {
+                int lanes = Math::min((int) k_lanes, blocks - block);
+                const byte* in[k_lanes];
+                for (int lane = 0; lane < k_lanes; ++lane)
+                {
+                    in[lane] = (lane < lanes ? input + (block + lane) * k_bytesPerBlock : k_silentBlock);
+                }
+                decode4(in, decoded);
+
+                // transpose 4x4 groups, so each block's samples are contiguous
+                T* out = output + block * k_samplesPerBlock;
+                for (int i = 0; i < k_samplesPerBlock; i += 4)
+                {
+                    __m128i t0 = _mm_unpacklo_epi32(decoded[i], decoded[i+1]);
+                    __m128i t1 = _mm_unpacklo_epi32(decoded[i+2], decoded[i+3]);
+                    __m128i t2 = _mm_unpackhi_epi32(decoded[i], decoded[i+1]);
+                    __m128i t3 = _mm_unpackhi_epi32(decoded[i+2], decoded[i+3]);
+
+                    store4(out + i, convert(_mm_unpacklo_epi64(t0, t1), output));
+                    if (lanes > 1) store4(out + k_samplesPerBlock + i, convert(_mm_unpackhi_epi64(t0, t1), output));
+                    if (lanes > 2) store4(out + k_samplesPerBlock*2 + i, convert(_mm_unpacklo_epi64(t2, t3), output));
+                    if (lanes > 3) store4(out + k_samplesPerBlock*3 + i, convert(_mm_unpackhi_epi64(t2, t3), output));
+                }
+            }
+        }
+
+        template <typename T>
+        void decodeStereo(const byte* input, int blocks, T* output)
+        {
+            // lanes are left and right of one block, then left and right of the next
+            __m128i decoded[k_samplesPerBlock];
+            for (int block = 0; block < blocks; block += 2)
+            {
+                bool second = (block + 1 < blocks);
+                const byte* in[k_lanes];
+                in[0] = input + block * k_bytesPerBlock * 2;
+                in[1] = in[0] + k_bytesPerBlock;
+                in[2] = second ? in[1] + k_bytesPerBlock : k_silentBlock;
+                in[3] = second ? in[2] + k_bytesPerBlock : k_silentBlock;
+                decode4(in, decoded);
+
+                T* out = output + block * k_samplesPerBlock * 2;
+                for (int i = 0; i < k_samplesPerBlock; ++i)
+                {
+                    storeLow2(out + i*2, convert(decoded[i], output));
+                }
+                if (second)
+                {
+                    out += k_samplesPerBlock * 2;
+                    for (int i = 0; i < k_samplesPerBlock; ++i)
+                    {
+                        storeHigh2(out + i*2, convert(decoded[i], output));
+                    }
+                }
+            }
+        }
+    }
+
+    void decodeBlocks_sse(const byte* input, int blocks, int channels, int32* output)
+    {
+        CK_ASSERT(channels == 1 || channels == 2);
+        if (channels == 1)
+        {
+            decodeMono(input, blocks, output);
+        }
+        else
+        {
+            decodeStereo(input, blocks, output);
+        }
+    }
+
+    void decodeBlocks_sse(const byte* input, int blocks, int channels, float* output)
+    {
+        CK_ASSERT(channels == 1 || channels == 2);
+        if (channels == 1)
+        {
+            decodeMono(input, blocks, output);
+        }
+        else
+        {
+            decodeStereo(input, blocks, output);
+        }
+    }
+}
+
+
+}
+
+#endif // CK_X86_SSE
@@ -2,7 +2,6 @@
 #include "ck/audio/audiosource.h"
 #include "ck/audio/bufferhandle.h"
 #include "ck/audio/audionode.h"
-#include "ck/audio/audioutil.h"
 #include "ck/core/debug.h"
 #include "ck/core/math.h"
 #include "ck/core/mem.h"
@@ -14,9 +13,9 @@ namespace Cki
 
 AdpcmDecoder::AdpcmDecoder(AudioSource& source) :
     Decoder(source),
-    m_decodedBlock(0),
+    m_decodedBlocks(0),
     m_frameOffset(0),
-    m_valid(false)
+    m_sourceBlock(-1)
 {
 }
 
@@ -33,73 +32,140 @@ int AdpcmDecoder::decode(float* buf, int frames)
 template <typename T> 
 int AdpcmDecoder::decodeImpl(T* buf, int frames)
 {
+    if (!isCacheValid() && m_decodedBlocks > 0)
+    {
+        // source was reset or moved since the cache was filled
+        m_decodedBlocks = 0;
+        m_frameOffset = 0;
+    }
+
     if (isDone())
     {
         return 0;
     }
     else
     {
+        const int blockFrames = Adpcm::k_samplesPerBlock;
         int channels = m_source.getSampleInfo().channels;
 
-        int framesCopied = 0;
+        int framesDecoded = 0;
         T* out = buf;
-        while (framesCopied < frames && !isDone())
+        while (framesDecoded < frames)
         {
-            if (!m_valid)
+            int framesLeft = frames - framesDecoded;
+            if (m_decodedBlocks > 0)
+            {
+                // copy already-decoded frames; usually this is the whole request
+                int framesToCopy = Math::min(framesLeft, m_decodedBlocks * blockFrames - m_frameOffset);
+                Mem::copy(out, (T*) m_decoded + m_frameOffset * channels, framesToCopy * channels * sizeof(T));
+                out += framesToCopy * channels;
+                framesDecoded += framesToCopy;
+
+                m_frameOffset += framesToCopy;
+                CK_ASSERT(m_frameOffset <= m_decodedBlocks * blockFrames);
+                if (m_frameOffset >= m_decodedBlocks * blockFrames)
+                {
+                    m_decodedBlocks = 0;
+                    m_frameOffset = 0;
+                }
+            }
+            else if (m_frameOffset == 0 && framesLeft >= blockFrames)
             {
-                if (!decodeBlock())
+                // whole blocks are decoded straight into the output
+                int blocks = decodeBlocks(out, framesLeft / blockFrames, NULL);
+                if (blocks == 0)
                 {
                     break;
                 }
-                m_valid = true;
+                out += blocks * blockFrames * channels;
+                framesDecoded += blocks * blockFrames;
             }
-
-            int framesToCopy = Math::min(frames - framesCopied, Adpcm::k_samplesPerBlock - m_frameOffset);
-            int bytesToCopy = framesToCopy * channels * sizeof(int16);
-            Mem::copy((int16*) out, &m_decoded[m_frameOffset * channels], bytesToCopy);
-            AudioUtil::convert((int16*) out, out, framesToCopy * channels);
-            out += framesToCopy * channels;
-
-            m_frameOffset += framesToCopy;
-            CK_ASSERT(m_frameOffset <= Adpcm::k_samplesPerBlock);
-            if (m_frameOffset >= Adpcm::k_samplesPerBlock)
+            else
             {
-                m_frameOffset = 0;
-                m_valid = false;
+                // decode ahead for the partial block at the start or end
+                m_decodedBlocks = decodeBlocks((T*) m_decoded, k_cacheBlocks, m_decodedBlock);
+                m_sourceBlock = m_source.getBlockPos();
+                if (m_decodedBlocks == 0)
+                {
+                    break;
+                }
+                CK_ASSERT(m_frameOffset < blockFrames);
             }
-
-            framesCopied += framesToCopy;
-            CK_ASSERT(framesCopied <= frames);
+            CK_ASSERT(framesDecoded <= frames);
         }
 
-        return framesCopied;
+        return framesDecoded;
     }
 }
 
+int AdpcmDecoder::skip(float* buf, int frames)
+{
+    // Nothing is decoded here, since m_decoded must stay in the format that
+    // decode() is called with (buf is always float).
+    const int blockFrames = Adpcm::k_samplesPerBlock;
+
+    if (!isCacheValid() && m_decodedBlocks > 0)
+    {
+        m_decodedBlocks = 0;
+        m_frameOffset = 0;
+    }
+
+    int framesSkipped = 0;
+    if (m_decodedBlocks > 0)
+    {
+        // advance through the decoded blocks
+        framesSkipped = Math::min(frames, m_decodedBlocks * blockFrames - m_frameOffset);
+        m_frameOffset += framesSkipped;
+        if (m_frameOffset < m_decodedBlocks * blockFrames)
+        {
+            return framesSkipped;
+        }
+        m_decodedBlocks = 0;
+        m_frameOffset = 0;
+    }
+
+    return framesSkipped + skipBlocks(frames - framesSkipped, m_frameOffset);
+}
+
 bool AdpcmDecoder::isDone() const
 {
-    return m_source.isDone() && !m_valid;
+    return m_source.isDone() && !isCacheValid();
 }
 
 void AdpcmDecoder::setFramePos(int frame)
 {
-    // TODO don't need to re-decode, if in same block
-    // seek to beginning of block
     int block = frame / Adpcm::k_samplesPerBlock;
+    int offset = frame - (block * Adpcm::k_samplesPerBlock);
+
+    // no need to decode again, if the block has already been decoded
+    if (isCacheValid())
+    {
+        for (int i = 0; i < m_decodedBlocks; ++i)
+        {
+            if (m_decodedBlock[i] == block)
+            {
+                m_frameOffset = i * Adpcm::k_samplesPerBlock + offset;
+                return;
+            }
+        }
+    }
+
+    // seek to beginning of block
     m_source.setBlockPos(block);
-    m_valid = false;
-    m_frameOffset = frame - (block * Adpcm::k_samplesPerBlock);
+    m_decodedBlocks = 0;
+    m_frameOffset = offset;
 }
 
 int AdpcmDecoder::getFramePos() const
 {
-    if (m_valid)
+    if (isCacheValid())
     {
-        return m_decodedBlock * Adpcm::k_samplesPerBlock + m_frameOffset;
+        int i = m_frameOffset / Adpcm::k_samplesPerBlock;
+        return m_decodedBlock[i] * Adpcm::k_samplesPerBlock + (m_frameOffset - i * Adpcm::k_samplesPerBlock);
     }
     else
     {
-        return m_source.getBlockPos() * Adpcm::k_samplesPerBlock + m_frameOffset;
+        return m_source.getBlockPos() * Adpcm::k_samplesPerBlock + (m_decodedBlocks > 0 ? 0 : m_frameOffset);
     }
 }
 
@@ -110,32 +176,57 @@ int AdpcmDecoder::getNumFrames() const
 
 ////////////////////////////////////////
 
-// decode next block
-bool AdpcmDecoder::decodeBlock()
+bool AdpcmDecoder::isCacheValid() const
+{
+    return m_decodedBlocks > 0 && m_source.getBlockPos() == m_sourceBlock;
+}
+
+// Decode up to the given number of blocks; if decodedBlock is not null, it
+// receives the source position of each.  Returns the number of blocks decoded.
+template <typename T>
+int AdpcmDecoder::decodeBlocks(T* buf, int blocks, int* decodedBlock)
 {
+    enum { k_readBlocks = 8 };
+
     int channels = m_source.getSampleInfo().channels;
-    int decodedBlock = m_source.getBlockPos();
+    int blockBytes = Adpcm::k_bytesPerBlock * channels;
 
-    // read block of encoded data (all channels)
-    byte encoded[Adpcm::k_bytesPerBlock * 2];
-    int blocksRead = m_source.read(encoded, 1);
-    CK_ASSERT(blocksRead == 1 || blocksRead == 0);
+    // read blocks of encoded data (all channels), a batch at a time
+    byte encoded[Adpcm::k_bytesPerBlock * 2 * k_readBlocks];
 
-    if (blocksRead == 0)
+    int blocksDecoded = 0;
+    while (blocksDecoded < blocks)
     {
-        return false;
-    }
-    else
-    {
-        // decode
-        Adpcm::decode(encoded, Adpcm::k_bytesPerBlock, m_decoded, channels);
-        if (channels == 2)
+        int blocksToRead = Math::min(blocks - blocksDecoded, (int) k_readBlocks);
+        int blocksRead = 0;
+        if (decodedBlock)
         {
-            Adpcm::decode(encoded + Adpcm::k_bytesPerBlock, Adpcm::k_bytesPerBlock, m_decoded + 1, channels);
+            // one at a time, to record positions (the source may loop between blocks)
+            while (blocksRead < blocksToRead)
+            {
+                decodedBlock[blocksDecoded + blocksRead] = m_source.getBlockPos();
+                if (m_source.read(encoded + blocksRead * blockBytes, 1) == 0)
+                {
+                    break;
+                }
+                ++blocksRead;
+            }
+        }
+        else
+        {
+            blocksRead = m_source.read(encoded, blocksToRead);
+        }
+
+        Adpcm::decodeBlocks(encoded, blocksRead, channels, buf + blocksDecoded * Adpcm::k_samplesPerBlock * channels);
+        blocksDecoded += blocksRead;
+
+        if (blocksRead < blocksToRead)
+        {
+            break;
         }
-        m_decodedBlock = decodedBlock;
-        return true;
     }
+
+    return blocksDecoded;
 }
 
 
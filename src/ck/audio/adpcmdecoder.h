@@ -3,6 +3,7 @@
 #include "ck/core/platform.h"
 #include "ck/audio/decoder.h"
 #include "ck/audio/adpcm.h"
+#include "ck/audio/varsample.h"
 
 namespace Cki
 {
@@ -15,18 +16,25 @@ public:
     virtual int decode(int32* buf, int frames);
     virtual int decode(float* buf, int frames);
     virtual bool isDone() const;
+    virtual int skip(float* buf, int frames);
     virtual void setFramePos(int frame);
     virtual int getFramePos() const;
     virtual int getNumFrames() const;
 
 private:
-    int16 m_decoded[Adpcm::k_samplesPerBlock*2];
-    int m_decodedBlock; // which block m_decoded is from
-    int m_frameOffset; // offset of next frame in m_decoded
-    bool m_valid; // true if decoded data is valid
+    // Blocks are decoded ahead, a batch at a time, into the pipeline's sample
+    // format; requests for whole blocks are decoded straight into the output.
+    enum { k_cacheBlocks = 4 };
+    VarSample m_decoded[Adpcm::k_samplesPerBlock * k_cacheBlocks * 2];
+    int m_decodedBlock[k_cacheBlocks]; // which block each block of m_decoded is from
+    int m_decodedBlocks; // number of blocks in m_decoded; 0 if none
+    int m_frameOffset; // offset of next frame in m_decoded, or in the next block if none
+    int m_sourceBlock; // source position after m_decoded was filled; if it changes, m_decoded is stale
+
+    bool isCacheValid() const;
 
-    bool decodeBlock();
     template <typename T> int decodeImpl(T* buf, int frames);
+    template <typename T> int decodeBlocks(T* buf, int blocks, int* decodedBlock);
 };
 
 
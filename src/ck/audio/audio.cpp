@@ -1,18 +1,24 @@
 #include "ck/audio/audio.h"
 #include "ck/audio/graphsound.h"
-#include "ck/audio/streamsource.h"
+#include "ck/audio/streamscheduler.h"
+#include "ck/audio/convolutionworker.h"
 #include "ck/audio/mixer.h"
 #include "ck/audio/effect.h"
 #include "ck/audio/audionode.h"
 #include "ck/audio/audiograph.h"
+#include "ck/audio/renderworkers.h"
+#include "ck/audio/rendertrace.h"
+#include "ck/audio/resampler.h"
+#include "ck/audio/spatializer.h"
+#include "ck/audio/audioutil.h"
+#include "ck/audio/effectprocessor.h"
+#include "ck/audio/adpcm.h"
+#include "ck/audio/decodecache.h"
+#include "ck/audio/voicemanager.h"
 #include "ck/core/thread.h"
 #include "ck/core/system.h"
 #include <stdio.h>
 
-#if CK_PLATFORM_IOS || CK_PLATFORM_OSX || CK_PLATFORM_TVOS
-#  include "ck/audio/audiohelpers_ios.h"
-#endif
-
 
 namespace Cki
 {
@@ -22,35 +28,6 @@ namespace Audio
     namespace
     {
         bool g_inited = false;
-        bool g_stopFileThread = false;
-
-        void* fileThreadFunc(void* arg)
-        {
-            int fileThreadMs = Math::round(System::get()->getConfig().streamFileUpdateMs);
-
-            while (!g_stopFileThread)
-            {
-#if CK_PLATFORM_IOS || CK_PLATFORM_OSX || CK_PLATFORM_TVOS
-                // need to create/destroy autorelease pools if using Cocoa objects
-                // with autorelease!
-                // TODO use @autoreleasepool {} instead
-                AudioHelpers::createAutoreleasePool();
-#endif
-                // update file loading
-                StreamSource::fileUpdateAll();
-
-                // TODO use condition variable to wait if there are no stream sources
-
-#if CK_PLATFORM_IOS || CK_PLATFORM_OSX || CK_PLATFORM_TVOS
-                AudioHelpers::destroyAutoreleasePool();
-#endif
-
-                Thread::sleepMs(fileThreadMs);
-            }
-            return NULL;
-        }
-
-        Thread g_fileThread(fileThreadFunc);
     }
 
     // these are defined by the platform-specific code (e.g. audio_ios.cpp)
@@ -69,17 +46,23 @@ namespace Audio
 				return false;
 			}
 
-            g_stopFileThread = false;
-#if CK_PLATFORM_ANDROID
-            g_fileThread.setFlags(Thread::k_flagAttachToJvm);
-#endif
-            g_fileThread.setName("CK stream file");
-            g_fileThread.start(NULL);
+            // before anything that processes audio
+            AudioUtil::init();
+            EffectProcessor::init();
+            Adpcm::init();
+
+            StreamScheduler::init();
+            ConvolutionWorker::init();
 
+            Resampler::init();
+            Spatializer::init();
             Mixer::init();
             Effect::init();
             AudioNode::init();
+            RenderWorkers::init();
             AudioGraph::init();
+            DecodeCache::init();
+            VoiceManager::init();
 
             g_inited = true;
         }
@@ -92,15 +75,21 @@ namespace Audio
         if (g_inited)
         {
             AudioGraph::get()->stop();
+            VoiceManager::shutdown();
+            DecodeCache::shutdown();
             AudioGraph::shutdown();
+            RenderWorkers::shutdown();
+            RenderTrace::shutdown(); // after all render threads have stopped
             AudioNode::shutdown();
             Effect::shutdown();
             Mixer::shutdown();
+            Spatializer::shutdown();
+            Resampler::shutdown();
 
             platformShutdown();
 
-            g_stopFileThread = true;
-            g_fileThread.join();
+            ConvolutionWorker::shutdown();
+            StreamScheduler::shutdown();
 
             g_inited = false;
         }
@@ -108,11 +97,16 @@ namespace Audio
 
     void update()
     {
-        // update playing state
+        AudioGraph* graph = AudioGraph::get();
+
+        // update playing state; resulting commands are handed to the audio thread together
+        graph->beginBatch();
         Sound::updateAll();
         platformUpdate();
+        graph->endBatch();
 
-        AudioGraph::get()->update();
+        graph->update();
+        RenderTrace::update();
     }
 
     void suspend()
@@ -15,7 +15,8 @@ namespace AudioFormat
         k_pcmI16 = 0,
         k_pcmI8,
         k_adpcm,
-        k_pcmF32
+        k_pcmF32,
+        k_lossless
     };
 }
 
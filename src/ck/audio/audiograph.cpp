@@ -1,4 +1,6 @@
 #include "ck/audio/audiograph.h"
+#include "ck/audio/graphoutput_dummy.h"
+#include "ck/core/atomic.h"
 #include "ck/core/thread.h"
 #include "ck/core/logger.h"
 #include "ck/core/mem.h"
@@ -8,7 +10,7 @@
 
 // template instantiation
 #include "ck/core/staticsingleton.cpp"
-#include "ck/core/taskqueue.cpp"
+#include "ck/core/spscqueue.cpp"
 
 namespace Cki
 {
@@ -22,11 +24,29 @@ void AudioGraph::start()
 void AudioGraph::stop()
 {
     m_output->stop();
-    consumeGraphTasks();
+    drainGraphTasks();
 }
 
 void AudioGraph::update()
 {
+    flushPendingTasks();
+    flushOverflowTasks();
+    m_graphTasks.publish();
+
+    int retries = m_deferRetryCount;
+    if (retries != m_deferRetryReported)
+    {
+        CK_LOG_WARNING("%d deferred audio tasks did not fit, and had to wait for a later render; consider increasing CkConfig.maxAudioTasks at startup.", retries - m_deferRetryReported);
+        m_deferRetryReported = retries;
+    }
+
+    int early = m_earlyCount;
+    if (early != m_earlyReported)
+    {
+        CK_LOG_WARNING("%d scheduled audio tasks were executed early because too many were waiting; consider increasing CkConfig.maxAudioTasks at startup.", early - m_earlyReported);
+        m_earlyReported = early;
+    }
+
     if (!m_output->isRunning())
     {
         consumeGraphTasks();
@@ -45,6 +65,34 @@ void AudioGraph::execute(CommandObject* obj, int commandId, CommandParam value0,
     produceGraphTask(t);
 }
 
+void AudioGraph::executeAt(int64 time, CommandObject* obj, int commandId, CommandParam value0, CommandParam value1)
+{
+    if (time < 0)
+    {
+        execute(obj, commandId, value0, value1);
+        return;
+    }
+
+    Task t;
+    t.type = k_scheduled;
+    t.data[0] = obj;
+    t.data[1] = commandId;
+    t.data[2] = value0;
+    t.data[3] = value1;
+    t.time = time;
+
+    produceGraphTask(t);
+}
+
+void AudioGraph::cancelScheduled(CommandObject* obj)
+{
+    Task t;
+    t.type = k_cancel;
+    t.data[0] = obj;
+
+    produceGraphTask(t);
+}
+
 void AudioGraph::free(void* p)
 {
     Task t;
@@ -63,11 +111,100 @@ void AudioGraph::deleteObject(Deletable* p)
     produceGraphTask(t);
 }
 
+void AudioGraph::executeCoalesced(CommandObject* obj, int commandId, CommandParam value0, CommandParam value1)
+{
+    executeCoalesced(obj, commandId, value0, value1, commandId);
+}
+
+void AudioGraph::executeCoalesced(CommandObject* obj, int commandId, CommandParam value0, CommandParam value1, int key)
+{
+    Task t;
+    t.type = k_command;
+    t.data[0] = obj;
+    t.data[1] = commandId;
+    t.data[2] = value0;
+    t.data[3] = value1;
+
+    if (!addPendingTask(t, key))
+    {
+        flushPendingTasks();
+        addPendingTask(t, key);
+    }
+
+    // If the audio thread has already consumed everything we've sent, there is
+    // nothing to coalesce with, so send it now; otherwise hold it until the next
+    // ordered task, the end of the batch, or the next update.
+    if (m_batchDepth == 0 && m_graphTasks.isEmpty())
+    {
+        flushPendingTasks();
+        m_graphTasks.publish();
+    }
+}
+
+void AudioGraph::beginBatch()
+{
+    ++m_batchDepth;
+}
+
+void AudioGraph::endBatch()
+{
+    CK_ASSERT(m_batchDepth > 0);
+    if (--m_batchDepth == 0)
+    {
+        flushPendingTasks();
+        m_graphTasks.publish();
+    }
+}
+
+bool AudioGraph::executeDeferred(CommandObject* obj, int commandId, CommandParam value0, CommandParam value1)
+{
+    // may be called from several render threads at once, so reserve a slot atomically
+    int32 index;
+    do
+    {
+        index = m_deferredCount;
+        if (index >= m_deferredCapacity)
+        {
+            int32 retries;
+            do
+            {
+                retries = m_deferRetryCount;
+            }
+            while (!Atomic::compareAndSwap(retries, retries + 1, &m_deferRetryCount));
+            return false;
+        }
+    }
+    while (!Atomic::compareAndSwap(index, index + 1, &m_deferredCount));
+
+    Task& t = m_deferredTasks[index];
+    t.type = k_command;
+    t.data[0] = obj;
+    t.data[1] = commandId;
+    t.data[2] = value0;
+    t.data[3] = value1;
+    return true;
+}
+
+void AudioGraph::getTaskStats(TaskStats& stats) const
+{
+    stats.capacity = m_graphTasks.getCapacity();
+    stats.highWater = m_graphTasks.getHighWater();
+    stats.overflowed = m_overflowCount;
+    stats.deferRetries = m_deferRetryCount;
+    stats.coalesced = m_coalescedCount;
+    stats.early = m_earlyCount;
+}
+
 MixNode* AudioGraph::getOutputMixer()
 {
     return &m_outMix;
 }
 
+MixNode* AudioGraph::getVirtualMixer()
+{
+    return &m_virtualMix;
+}
+
 EffectBus* AudioGraph::getGlobalEffectBus()
 {
     return &m_outFx;
@@ -84,13 +221,41 @@ void AudioGraph::print()
 
 AudioGraph::AudioGraph() :
     m_outFx(true),
-    m_graphTasks(System::get()->getConfig().maxAudioTasks)
+    m_graphTasks(System::get()->getConfig().maxAudioTasks),
+    m_overflowTasks(NULL),
+    m_overflowStart(0),
+    m_overflowSize(0),
+    m_overflowCapacity(System::get()->getConfig().maxAudioTasks),
+    m_batchDepth(0),
+    m_overflowCount(0),
+    m_overflowWarnSize(1),
+    m_coalescedCount(0),
+    m_deferredTasks(NULL),
+    m_deferredCount(0),
+    m_deferredCapacity(System::get()->getConfig().maxAudioTasks),
+    m_deferRetryCount(0),
+    m_deferRetryReported(0),
+    m_timeline(System::get()->getConfig().maxAudioTasks),
+    m_earlyCount(0),
+    m_earlyReported(0),
+    m_pendingTasks(NULL),
+    m_pendingCount(0),
+    m_pendingCapacity(m_graphTasks.getCapacity()),
+    m_pendingIndex(NULL),
+    m_pendingIndexMask(m_graphTasks.getCapacity() * 2 - 1)
 {
+    m_overflowTasks = (Task*) Mem::alloc(sizeof(Task) * m_overflowCapacity);
+    m_deferredTasks = (Task*) Mem::alloc(sizeof(Task) * m_deferredCapacity);
+    m_pendingTasks = (PendingTask*) Mem::alloc(sizeof(PendingTask) * m_pendingCapacity);
+    m_pendingIndex = (int*) Mem::alloc(sizeof(int) * (m_pendingIndexMask + 1));
+    Mem::fill(m_pendingIndex, 0xff, sizeof(int) * (m_pendingIndexMask + 1)); // -1
 
     m_output = GraphOutput::create();
     m_output->setInput(m_outFx.getOutput());
+    m_output->setVirtualInput(&m_virtualMix);
     m_output->setPreRenderCallback(preRenderCallback, this);
     m_output->setPostRenderCallback(postRenderCallback, this);
+    m_output->setTimeline(&m_timeline);
 
     m_outFx.getInput()->addInput(&m_outMix);
 
@@ -103,16 +268,154 @@ AudioGraph::~AudioGraph()
     CK_ASSERT(!m_output->isRunning());
 //    stop();
 
-    consumeGraphTasks();
+    drainGraphTasks();
+
+    Mem::free(m_overflowTasks);
+    Mem::free(m_deferredTasks);
+    Mem::free(m_pendingTasks);
+    Mem::free(m_pendingIndex);
 
     delete m_output;
 }
 
 void AudioGraph::produceGraphTask(const Task& task)
 {
-    if (m_graphTasks.produce(task))
+    // coalesced tasks were issued earlier, so must be sent first
+    flushPendingTasks();
+    writeGraphTask(task);
+
+    if (m_batchDepth == 0)
     {
-        CK_LOG_WARNING("Reallocating audio task buffer to size %d; consider increasing CkConfig.maxAudioTasks at startup.", m_graphTasks.getCapacity());
+        m_graphTasks.publish();
+    }
+}
+
+void AudioGraph::writeGraphTask(const Task& task)
+{
+    // Tasks that don't fit in the ring are held here, on the main thread, until the 
+    // audio thread makes room; once that happens, all later tasks must wait behind 
+    // them to preserve ordering.
+    if (m_overflowSize > 0)
+    {
+        flushOverflowTasks();
+    }
+
+    if (m_overflowSize > 0 || !m_graphTasks.write(task))
+    {
+        appendOverflowTask(task);
+        ++m_overflowCount;
+
+        if (m_overflowSize >= m_overflowWarnSize)
+        {
+            // warn each time the backlog doubles
+            CK_LOG_WARNING("Audio task buffer (size %d) is full; %d tasks are waiting.  Consider increasing CkConfig.maxAudioTasks at startup.", m_graphTasks.getCapacity(), m_overflowSize);
+            m_overflowWarnSize *= 2;
+        }
+    }
+}
+
+void AudioGraph::appendOverflowTask(const Task& task)
+{
+    if (m_overflowStart + m_overflowSize >= m_overflowCapacity)
+    {
+        // move the waiting tasks to the front, growing the buffer if it is
+        // more than half full (this is on the main thread, so may allocate)
+        Task* tasks = m_overflowTasks;
+        if (m_overflowSize * 2 > m_overflowCapacity)
+        {
+            m_overflowCapacity *= 2;
+            tasks = (Task*) Mem::alloc(sizeof(Task) * m_overflowCapacity);
+        }
+        memmove(tasks, m_overflowTasks + m_overflowStart, sizeof(Task) * m_overflowSize);
+        if (tasks != m_overflowTasks)
+        {
+            Mem::free(m_overflowTasks);
+            m_overflowTasks = tasks;
+        }
+        m_overflowStart = 0;
+    }
+    m_overflowTasks[m_overflowStart + m_overflowSize++] = task;
+}
+
+bool AudioGraph::addPendingTask(const Task& task, int key)
+{
+    void* obj = task.data[0].addrValue;
+    uint32 hash = ((uint32) (size_t) obj >> 3) * 2654435761u + (uint32) key * 40503u;
+
+    for (uint32 i = hash & m_pendingIndexMask; ; i = (i + 1) & m_pendingIndexMask)
+    {
+        int index = m_pendingIndex[i];
+        if (index < 0)
+        {
+            if (m_pendingCount >= m_pendingCapacity)
+            {
+                return false;
+            }
+            PendingTask& pending = m_pendingTasks[m_pendingCount];
+            pending.task = task;
+            pending.key = key;
+            pending.slot = (int) i;
+            m_pendingIndex[i] = m_pendingCount++;
+            return true;
+        }
+
+        PendingTask& pending = m_pendingTasks[index];
+        if (pending.key == key && pending.task.data[0].addrValue == obj)
+        {
+            // last value wins
+            pending.task = task;
+            ++m_coalescedCount;
+            return true;
+        }
+    }
+}
+
+void AudioGraph::flushPendingTasks()
+{
+    if (m_pendingCount > 0)
+    {
+        // clear only the hash slots that were used, so a flush costs time in
+        // proportion to the number of pending tasks
+        for (int i = 0; i < m_pendingCount; ++i)
+        {
+            const PendingTask& pending = m_pendingTasks[i];
+            writeGraphTask(pending.task);
+            m_pendingIndex[pending.slot] = -1;
+        }
+        m_pendingCount = 0;
+    }
+}
+
+void AudioGraph::flushOverflowTasks()
+{
+    while (m_overflowSize > 0 && m_graphTasks.write(m_overflowTasks[m_overflowStart]))
+    {
+        ++m_overflowStart;
+        --m_overflowSize;
+    }
+    if (m_overflowSize == 0)
+    {
+        m_overflowStart = 0;
+    }
+}
+
+void AudioGraph::drainGraphTasks()
+{
+    // call only when the graph thread is stopped, since this consumes on the calling thread
+    flushPendingTasks();
+    m_graphTasks.publish();
+    consumeGraphTasks();
+
+    while (m_overflowSize > 0)
+    {
+        int overflow = m_overflowSize;
+        flushOverflowTasks();
+        if (m_overflowSize == overflow)
+        {
+            break; // no progress; audio is locked
+        }
+        m_graphTasks.publish();
+        consumeGraphTasks();
     }
 }
 
@@ -120,34 +423,17 @@ void AudioGraph::consumeGraphTasks()
 {
     if (m_mutex.tryLock())
     {
+        // tasks deferred by the graph thread during the previous render
+        for (int i = 0; i < m_deferredCount; ++i)
+        {
+            executeTask(m_deferredTasks[i]);
+        }
+        m_deferredCount = 0;
+
         Task task;
         while (m_graphTasks.consume(task))
         {
-            switch (task.type)
-            {
-                case k_command:
-                    {
-                        CommandObject* obj = (CommandObject*) task.data[0].addrValue;
-                        obj->execute(task.data[1].intValue, task.data[2], task.data[3]);
-                    }
-                    break;
-
-                case k_free:
-                    {
-                        Mem::free(task.data[0].addrValue);
-                    }
-                    break;
-
-                case k_delete:
-                    {
-                        Deletable* d = (Deletable*) task.data[0].addrValue;
-                        d->deleteOnUpdate();
-                    }
-                    break;
-
-                default:
-                    CK_FAIL("unknown task type");
-            }
+            executeTask(task);
         }
 
         m_mutex.unlock();
@@ -158,6 +444,53 @@ void AudioGraph::consumeGraphTasks()
     }
 }
 
+void AudioGraph::executeTask(const Task& task)
+{
+    switch (task.type)
+    {
+        case k_command:
+            {
+                CommandObject* obj = (CommandObject*) task.data[0].addrValue;
+                obj->execute(task.data[1].intValue, task.data[2], task.data[3]);
+            }
+            break;
+
+        case k_free:
+            {
+                Mem::free(task.data[0].addrValue);
+            }
+            break;
+
+        case k_delete:
+            {
+                Deletable* d = (Deletable*) task.data[0].addrValue;
+                d->deleteOnUpdate();
+            }
+            break;
+
+        case k_scheduled:
+            {
+                CommandObject* obj = (CommandObject*) task.data[0].addrValue;
+                if (!m_timeline.add(task.time, obj, task.data[1].intValue, task.data[2], task.data[3]))
+                {
+                    // better early than never
+                    obj->execute(task.data[1].intValue, task.data[2], task.data[3]);
+                    ++m_earlyCount;
+                }
+            }
+            break;
+
+        case k_cancel:
+            {
+                m_timeline.cancel((CommandObject*) task.data[0].addrValue);
+            }
+            break;
+
+        default:
+            CK_FAIL("unknown task type");
+    }
+}
+
 void AudioGraph::preRenderCallback(void* data)
 {
     AudioGraph* me = (AudioGraph*) data;
@@ -189,7 +522,14 @@ void AudioGraph::stopCapture()
     m_output->stopCapture(); 
 }
 
+bool AudioGraph::renderOffline(float* buf, int frames)
+{
+    CK_ASSERT(System::get()->isOffline());
+    return GraphOutputDummy::renderOffline(buf, frames);
+}
+
 
 template class StaticSingleton<AudioGraph>;
+template class SpscQueue<AudioGraph::Task>;
 
 }
@@ -2,12 +2,13 @@
 
 #include "ck/core/platform.h"
 #include "ck/core/staticsingleton.h"
-#include "ck/core/taskqueue.h"
+#include "ck/core/spscqueue.h"
 #include "ck/core/mutex.h"
 #include "ck/audio/audionode.h"
 #include "ck/audio/graphoutput.h"
 #include "ck/audio/mixnode.h"
 #include "ck/audio/effectbus.h"
+#include "ck/audio/commandtimeline.h"
 
 namespace Cki
 {
@@ -27,14 +28,61 @@ public:
     void free(void*);
     void deleteObject(Deletable* p);
 
+    // Like execute(), but for commands where only the most recent value matters
+    // (volume, speed, parameter values, etc).  If a command with the same object and
+    // key is still waiting to be sent to the audio thread, it is replaced rather than
+    // queued again.  The key identifies the value being set, and defaults to the
+    // command ID.  Ordering with respect to execute(), free(), and deleteObject() is
+    // preserved.
+    void executeCoalesced(CommandObject*, int commandId, CommandParam value0 = 0, CommandParam value1 = 0);
+    void executeCoalesced(CommandObject*, int commandId, CommandParam value0, CommandParam value1, int key);
+
+    // Like execute(), but the command takes effect at the given sample time of the
+    // output (see getSampleTime()), splitting the render quantum if needed.  If
+    // the time is negative, it is executed as soon as possible, as by execute();
+    // if the time has already passed, it is executed at the start of the next render.
+    void executeAt(int64 time, CommandObject*, int commandId, CommandParam value0 = 0, CommandParam value1 = 0);
+
+    // Discards commands for the object that are waiting for their sample time.
+    void cancelScheduled(CommandObject*);
+
+    // Number of frames rendered to the output so far.
+    int64 getSampleTime() const { return m_output->getSampleTime(); }
+
+    // Commands issued between beginBatch() and endBatch() are handed to the audio
+    // thread together, so they take effect in the same render quantum.
+    void beginBatch();
+    void endBatch();
+
+    // Queue a command from the audio thread itself, to be executed before the
+    // next render.  Never allocates or locks; fails (and counts a retry) if too
+    // many commands are already deferred, in which case the caller should try
+    // again on the next render.
+    bool executeDeferred(CommandObject*, int commandId, CommandParam value0 = 0, CommandParam value1 = 0);
+
+    struct TaskStats
+    {
+        int capacity;     // size of the command ring
+        int highWater;    // most commands pending in the ring at once
+        int overflowed;   // commands that did not fit in the ring and were held on the main thread
+        int deferRetries; // times a deferred command did not fit, and was tried again on a later render
+        int coalesced;    // commands merged into an already pending command
+        int early;        // scheduled commands executed early because the timeline was full
+    };
+    void getTaskStats(TaskStats&) const;
+
     MixNode* getOutputMixer();
 
+    // Sources of virtual sounds, which keep their positions up to date but are not heard.
+    MixNode* getVirtualMixer();
+
     EffectBus* getGlobalEffectBus();
 
     float getRenderLoad() const { return m_output->getRenderLoad(); }
     float getRenderMs() const { return m_output->getRenderMs(); }
     bool getClipFlag() const { return m_output->getClipFlag(); }
     void resetClipFlag() { return m_output->resetClipFlag(); }
+    float getOutputGainReduction() const { return m_output->getGainReduction(); }
 
     void lockAudio() { m_mutex.lock(); }
     void unlockAudio() { m_mutex.unlock(); }
@@ -42,6 +90,9 @@ public:
     void startCapture(const char* path, CkPathType);
     void stopCapture();
 
+    // Render the next frames of output into buf; offline mode only.
+    bool renderOffline(float* buf, int frames);
+
 #if CK_DEBUG
     static void print();
 #endif
@@ -51,24 +102,65 @@ private:
     {
         k_command = 1,    // data[0] = CommandObject*; data[1] = int (id); command data follows
         k_free,           // data[0] = pointer
-        k_delete          // data[0] = pointer
+        k_delete,         // data[0] = pointer
+        k_scheduled,      // as k_command, at sample time given by time
+        k_cancel          // data[0] = CommandObject*
     };
 
     struct Task
     {
         TaskType type;
         CommandParam data[4];
+        int64 time;
     };
 
     MixNode m_outMix; // final mixer
+    MixNode m_virtualMix; // sources of virtual sounds; output is discarded
     EffectBus m_outFx; // final effects
     GraphOutput* m_output;
     Mutex m_mutex; // for CkLock()/CkUnlock()
 
-    TaskQueue<Task> m_graphTasks; // tasks for the graph thread
+    SpscQueue<Task> m_graphTasks; // tasks for the graph thread
+    Task* m_overflowTasks;        // tasks waiting for space in m_graphTasks (main thread only)
+    int m_overflowStart;          // index of the oldest waiting task
+    int m_overflowSize;           // number of waiting tasks
+    int m_overflowCapacity;
+    int m_batchDepth;
+    int m_overflowCount;
+    int m_overflowWarnSize;
+    int m_coalescedCount;
+
+    Task* m_deferredTasks;        // tasks queued by the graph thread for itself
+    volatile int32 m_deferredCount;
+    int m_deferredCapacity;
+    volatile int32 m_deferRetryCount;
+    int m_deferRetryReported;
+
+    CommandTimeline m_timeline;   // scheduled tasks waiting for their time (graph thread only)
+    volatile int32 m_earlyCount;
+    int m_earlyReported;
+
+    struct PendingTask
+    {
+        Task task;
+        int key;
+        int slot; // in m_pendingIndex
+    };
+    PendingTask* m_pendingTasks;  // coalesced tasks not yet written to m_graphTasks (main thread only)
+    int m_pendingCount;
+    int m_pendingCapacity;
+    int* m_pendingIndex;          // open-addressed hash table of indices into m_pendingTasks
+    uint32 m_pendingIndexMask;
 
     void produceGraphTask(const Task&);
+    void writeGraphTask(const Task&);
+    bool addPendingTask(const Task&, int key);
+    void flushPendingTasks();
+    void appendOverflowTask(const Task&);
+    void flushOverflowTasks();
+    void drainGraphTasks();
     void consumeGraphTasks();
+    void executeTask(const Task&);
 
     static void preRenderCallback(void* data);
     void preRender();
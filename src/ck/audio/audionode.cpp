@@ -1,4 +1,5 @@
 #include "ck/audio/audionode.h"
+#include "ck/audio/renderworkers.h"
 #include "ck/core/debug.h"
 #include "ck/core/system.h"
 #include "ck/ck.h"
@@ -18,7 +19,7 @@ namespace Cki
 
 void AudioNode::init()
 {
-    CK_ASSERT(!s_pool);
+    CK_ASSERT(!s_arena);
 
 #if CK_PLATFORM_ANDROID
     // match output sample rate to native sample rate to avoid clicking
@@ -32,14 +33,14 @@ void AudioNode::init()
     float bufferMs = System::get()->getConfig().audioUpdateMs;
     int bufferFrames = (int) (s_sampleRate * bufferMs * 0.001f);
     bufferFrames *= 2; // allow space for 2x speed at 48k
-    s_pool = new BufferPool(k_maxChannels * bufferFrames);
+    s_arena = new ScratchArena(k_maxChannels * bufferFrames);
 }
 
 void AudioNode::shutdown()
 {
-    CK_ASSERT(s_pool);
-    delete s_pool;
-    s_pool = NULL;
+    CK_ASSERT(s_arena);
+    delete s_arena;
+    s_arena = NULL;
 }
 
 AudioNode::AudioNode() 
@@ -64,9 +65,16 @@ BufferHandle AudioNode::process<float>(int frames, bool post, bool& needsPost)
 
 ////////////////////////////////////////
 
+ScratchArena* AudioNode::getScratchArena()
+{
+    // parallel render jobs each use their own thread's arena
+    RenderJob* job = RenderJob::getCurrent();
+    return (job ? job->getScratchArena() : s_arena);
+}
+
 BufferHandle AudioNode::acquireBuffer()
 {
-    return s_pool->acquire();
+    return getScratchArena()->acquire();
 }
 
 #if CK_DEBUG
@@ -80,7 +88,7 @@ void AudioNode::printImpl(int level, const char* name)
 }
 #endif
 
-BufferPool* AudioNode::s_pool = NULL;
+ScratchArena* AudioNode::s_arena = NULL;
 int AudioNode::s_sampleRate = k_maxSampleRate;
 
 ////////////////////////////////////////
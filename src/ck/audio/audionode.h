@@ -3,7 +3,7 @@
 #include "ck/core/platform.h"
 #include "ck/core/types.h"
 #include "ck/core/list.h"
-#include "ck/audio/bufferpool.h"
+#include "ck/audio/scratcharena.h"
 #include "ck/audio/bufferhandle.h"
 #include "ck/audio/commandparam.h"
 #include "ck/audio/volumematrix.h"
@@ -34,9 +34,11 @@ public:
 
 #if CK_DEBUG
     virtual void print(int level) = 0;
-    static void verify() { s_pool->verify(); }
 #endif
 
+    // Scratch buffers for the calling thread; the audio thread's arena is reset
+    // by GraphOutput at the start of each quantum.
+    static ScratchArena* getScratchArena();
     static BufferHandle acquireBuffer();
     static int getBufferSamples();
     static int getBufferFrames();
@@ -49,14 +51,13 @@ protected:
     static float s_volRampTime;
 
     float getVolumeRate(); // volume units per sample
-    static BufferPool* getBufferPool();
 
 #if CK_DEBUG
     void printImpl(int level, const char* name);
 #endif
 
 private:
-    static BufferPool* s_pool;
+    static ScratchArena* s_arena;
     static int s_sampleRate;
 };
 
@@ -65,19 +66,13 @@ private:
 inline
 int AudioNode::getBufferSamples()
 {
-    return s_pool->getBufferSize();
+    return s_arena->getBufferSize();
 }
 
 inline
 int AudioNode::getBufferFrames()
 {
-    return s_pool->getBufferSize() / k_maxChannels;
-}
-
-inline
-BufferPool* AudioNode::getBufferPool()
-{
-    return s_pool;
+    return s_arena->getBufferSize() / k_maxChannels;
 }
 
 inline
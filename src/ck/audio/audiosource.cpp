@@ -4,6 +4,11 @@ namespace Cki
 {
 
 
+int AudioSource::getNumFrames() const
+{
+    const SampleInfo& info = getSampleInfo();
+    return info.blocks * info.blockFrames;
+}
 
 
 }
@@ -13,8 +13,12 @@ class AudioSource
 public:
     virtual ~AudioSource() {};
 
+    // Reads blocks from the current position, and advances past them; returns
+    // the number of blocks read.  If buf is NULL, the blocks are skipped
+    // without being copied.
     virtual int read(void* buf, int blocks) = 0;
     virtual int getNumBlocks() const = 0;
+    virtual int getNumFrames() const; // the last block may not be full
     virtual void setBlockPos(int block) = 0;
     virtual int getBlockPos() const = 0;
 
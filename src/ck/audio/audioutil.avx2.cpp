@@ -0,0 +1,710 @@
+#include "ck/audio/audioutil.h"
+#include "ck/core/debug.h"
+#include "ck/core/math.h"
+#include "ck/core/sse.h"
+#include "ck/audio/volumematrix.h"
+
+#if CK_X86_SSE
+
+// These are only used if System::getSimdLevel() is kCkSimdLevel_Avx2, which
+// requires FMA as well as AVX2.
+//
+// If the compiler can't generate AVX2 code for this file, these just call the
+// SSE versions.
+//
+// Each function ends with _mm256_zeroupper(), to avoid the penalty for mixing
+// 256-bit and SSE instructions; GCC doesn't insert it when optimizing for size.
+
+#if CK_X86_AVX2
+
+#include <immintrin.h>
+
+namespace Cki
+{
+
+
+namespace AudioUtil
+{
+    ////////////////////////////////////////
+    // convert float to int16
+
+    void convertF32toI16_avx2(const float* inBuf, int16* outBuf, int samples)
+    {
+        const float* pIn = inBuf;
+        const float* pInEnd16 = inBuf + (samples & ~15);
+        const float* pInEnd = inBuf + samples;
+        int16* pOut = outBuf;
+
+        const __m256 n = _mm256_set1_ps((float) (CK_INT16_MAX));
+
+        while (pIn < pInEnd16)
+        {
+            __m256i out0 = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_loadu_ps(pIn), n));
+            __m256i out1 = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_loadu_ps(pIn + 8), n));
+
+            // packing works within 128-bit lanes, so put the quarters back in order
+            __m256i out = _mm256_packs_epi32(out0, out1);
+            out = _mm256_permute4x64_epi64(out, 0xd8);
+            _mm256_storeu_si256((__m256i*) pOut, out);
+
+            pIn += 16;
+            pOut += 16;
+        }
+
+        while (pIn < pInEnd)
+        {
+            *pOut++ = (int16) (*pIn++ * CK_INT16_MAX);
+        }
+
+        _mm256_zeroupper();
+    }
+
+
+    ////////////////////////////////////////
+    // convert int16 to float
+
+    void convertI16toF32_avx2(const int16* inBuf, float* outBuf, int samples)
+    {
+        // iterate backwards so we can do it in-place
+
+        const int16* pIn = inBuf + samples - 1;
+        const int16* pInEnd8 = inBuf + (samples & ~7) - 1;
+        float* pOut = outBuf + samples - 1;
+        const float factor = 1.0f / CK_INT16_MAX;
+
+        while (pIn > pInEnd8)
+        {
+            *pOut-- = ((float) *pIn--) * factor;
+        }
+        pIn -= 7;
+        pOut -= 7;
+
+        const __m256 factorv = _mm256_set1_ps(factor);
+        while (pIn >= inBuf)
+        {
+            __m256i in = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i*) pIn));
+            __m256 out = _mm256_mul_ps(_mm256_cvtepi32_ps(in), factorv);
+            _mm256_storeu_ps(pOut, out);
+
+            pIn -= 8;
+            pOut -= 8;
+        }
+
+        CK_ASSERT(pIn == inBuf - 8);
+        CK_ASSERT(pOut == outBuf - 8);
+
+        _mm256_zeroupper();
+    }
+
+
+    ////////////////////////////////////////
+    // mix
+
+    void mix_avx2(const float* __restrict inBuf, float* __restrict outBuf, int samples)
+    {
+        CK_ASSERT(inBuf != outBuf);
+
+        const float* pIn = inBuf;
+        const float* pInEnd8 = inBuf + (samples & ~7);
+        const float* pInEnd = inBuf + samples;
+        float* pOut = outBuf;
+
+        while (pIn < pInEnd8)
+        {
+            __m256 out = _mm256_add_ps(_mm256_loadu_ps(pIn), _mm256_loadu_ps(pOut));
+            _mm256_storeu_ps(pOut, out);
+
+            pIn += 8;
+            pOut += 8;
+        }
+
+        while (pIn < pInEnd)
+        {
+            *pOut++ += *pIn++;
+        }
+
+        _mm256_zeroupper();
+    }
+
+    void mixVol_avx2(const float* __restrict inBuf, float inVol, float* __restrict outBuf, float outVol, int samples)
+    {
+        CK_ASSERT(inBuf != outBuf);
+
+        const __m256 outVolv = _mm256_set1_ps(outVol);
+        const __m256 inVolv = _mm256_set1_ps(inVol);
+
+        const float* pIn = inBuf;
+        const float* pInEnd8 = inBuf + (samples & ~7);
+        const float* pInEnd = inBuf + samples;
+        float* pOut = outBuf;
+
+        while (pIn < pInEnd8)
+        {
+            __m256 out = _mm256_mul_ps(_mm256_loadu_ps(pOut), outVolv);
+            out = _mm256_fmadd_ps(_mm256_loadu_ps(pIn), inVolv, out);
+            _mm256_storeu_ps(pOut, out);
+
+            pIn += 8;
+            pOut += 8;
+        }
+
+        while (pIn < pInEnd)
+        {
+            *pOut = *pIn * inVol + *pOut * outVol;
+            ++pIn;
+            ++pOut;
+        }
+
+        _mm256_zeroupper();
+    }
+
+
+    ////////////////////////////////////////
+    // convert to stereo with scale
+
+    void convertToStereoScale_avx2(const float* inBuf, float* outBuf, int frames, float volume)
+    {
+        const __m256 v = _mm256_set1_ps(volume);
+
+        const float* pIn = inBuf;
+        const float* pInEnd8 = inBuf + (frames & ~7);
+        const float* pInEnd = inBuf + frames;
+        float* pOut = outBuf;
+
+        while (pIn < pInEnd8)
+        {
+            __m256 in = _mm256_mul_ps(_mm256_loadu_ps(pIn), v);
+
+            // unpacking works within 128-bit lanes
+            __m256 lo = _mm256_unpacklo_ps(in, in); // 0 0 1 1 4 4 5 5
+            __m256 hi = _mm256_unpackhi_ps(in, in); // 2 2 3 3 6 6 7 7
+            _mm256_storeu_ps(pOut, _mm256_permute2f128_ps(lo, hi, 0x20));
+            _mm256_storeu_ps(pOut + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+
+            pIn += 8;
+            pOut += 16;
+        }
+
+        while (pIn < pInEnd)
+        {
+            float out = *pIn++ * volume;
+            *pOut++ = out;
+            *pOut++ = out;
+        }
+
+        _mm256_zeroupper();
+    }
+
+
+    ////////////////////////////////////////
+    // scale
+
+    void scale_avx2(const float* inBuf, float* outBuf, int samples, float volume)
+    {
+        const __m256 v = _mm256_set1_ps(volume);
+
+        const float* pIn = inBuf;
+        const float* pInEnd8 = inBuf + (samples & ~7);
+        const float* pInEnd = inBuf + samples;
+        float* pOut = outBuf;
+
+        while (pIn < pInEnd8)
+        {
+            _mm256_storeu_ps(pOut, _mm256_mul_ps(_mm256_loadu_ps(pIn), v));
+            pIn += 8;
+            pOut += 8;
+        }
+
+        while (pIn < pInEnd)
+        {
+            *pOut++ = *pIn++ * volume;
+        }
+
+        _mm256_zeroupper();
+    }
+
+
+    ////////////////////////////////////////
+    // stereo pan
+
+    void stereoPan_avx2(float* buf, int frames, const VolumeMatrix& volume)
+    {
+        float ll = volume.ll;
+        float lr = volume.lr;
+        float rl = volume.rl;
+        float rr = volume.rr;
+
+        float* p = buf;
+        const float* pEnd8 = buf + ((frames * 2) & ~7);
+        const float* pEnd = buf + frames * 2;
+
+        // Rather than separating the channels, multiply L R by (ll rr) and
+        // the swapped R L by (lr rl).
+        const __m256 directv = _mm256_setr_ps(ll, rr, ll, rr, ll, rr, ll, rr);
+        const __m256 crossv = _mm256_setr_ps(lr, rl, lr, rl, lr, rl, lr, rl);
+
+        while (p < pEnd8)
+        {
+            __m256 in = _mm256_loadu_ps(p);
+            __m256 swapped = _mm256_permute_ps(in, 0xb1);
+            __m256 out = _mm256_fmadd_ps(in, directv, _mm256_mul_ps(swapped, crossv));
+            _mm256_storeu_ps(p, out);
+
+            p += 8;
+        }
+
+        while (p < pEnd)
+        {
+            float in_l = *p;
+            float in_r = *(p+1);
+
+            *p++ = in_l * ll + in_r * lr;
+            *p++ = in_l * rl + in_r * rr;
+        }
+
+        _mm256_zeroupper();
+    }
+
+
+    ////////////////////////////////////////
+    // mono pan
+
+    void monoPan_avx2(const float* inBuf, float* outBuf, int frames, const VolumeMatrix& volume)
+    {
+        float l = volume.ll;
+        float r = volume.rr;
+
+        const float* pIn = inBuf;
+        const float* pInEnd8 = inBuf + (frames & ~7);
+        const float* pInEnd = inBuf + frames;
+        float* pOut = outBuf;
+
+        const __m256 lrv = _mm256_setr_ps(l, r, l, r, l, r, l, r);
+
+        while (pIn < pInEnd8)
+        {
+            __m256 in = _mm256_loadu_ps(pIn);
+
+            __m256 lo = _mm256_unpacklo_ps(in, in); // 0 0 1 1 4 4 5 5
+            __m256 hi = _mm256_unpackhi_ps(in, in); // 2 2 3 3 6 6 7 7
+            __m256 out0 = _mm256_permute2f128_ps(lo, hi, 0x20);
+            __m256 out1 = _mm256_permute2f128_ps(lo, hi, 0x31);
+
+            _mm256_storeu_ps(pOut, _mm256_mul_ps(out0, lrv));
+            _mm256_storeu_ps(pOut + 8, _mm256_mul_ps(out1, lrv));
+
+            pIn += 8;
+            pOut += 16;
+        }
+
+        while (pIn < pInEnd)
+        {
+            float in = *pIn++;
+
+            *pOut++ = in * l;
+            *pOut++ = in * r;
+        }
+
+        _mm256_zeroupper();
+    }
+
+
+    ////////////////////////////////////////
+    // resample
+
+    void resampleMono_avx2(const float* inBuf, int inFrames, float* outBuf, int outFrames, float* lastInput)
+    {
+        float* pOut = outBuf;
+        const float* pOutEnd8 = outBuf + outFrames - 8;
+        const float* pOutEnd = outBuf + outFrames;
+
+        float factor = (float) inFrames / outFrames;
+
+        float ti = 0.0f; // input frame
+        int ti0 = 0;     // whole number part of input frame
+        float to = 0.0f; // output frame
+        float frac = 0.0f;
+
+        // interpolate between last sample of previous slice and first sample of current slice
+        float sample0 = *lastInput;
+        float sample1 = *inBuf;
+        while (ti0 == 0)
+        {
+            *pOut++ = sample0 + frac * (sample1 - sample0);
+
+            ti = ++to * factor;
+            ti0 = (int) ti;
+            frac = ti - ti0;
+        }
+
+        // resample the rest of the current slice
+        __m256 tov = _mm256_setr_ps(to, to+1, to+2, to+3, to+4, to+5, to+6, to+7);
+        const __m256 dtov = _mm256_set1_ps(8.0f);
+        const __m256 factorv = _mm256_set1_ps(factor);
+
+        while (pOut < pOutEnd8)
+        {
+            __m256 tiv = _mm256_mul_ps(tov, factorv);
+            __m256i ti0vi = _mm256_cvttps_epi32(tiv);
+            __m256 fracv = _mm256_sub_ps(tiv, _mm256_cvtepi32_ps(ti0vi));
+
+            __m256 sample0v = _mm256_i32gather_ps(inBuf - 1, ti0vi, 4);
+            __m256 sample1v = _mm256_i32gather_ps(inBuf, ti0vi, 4);
+
+            __m256 out = _mm256_fmadd_ps(fracv, _mm256_sub_ps(sample1v, sample0v), sample0v);
+            _mm256_storeu_ps(pOut, out);
+            pOut += 8;
+
+            tov = _mm256_add_ps(tov, dtov);
+        }
+
+        to = _mm_cvtss_f32(_mm256_castps256_ps128(tov));
+        ti = to * factor;
+        ti0 = (int) ti;
+        frac = ti - ti0;
+
+        while (pOut < pOutEnd)
+        {
+            sample0 = inBuf[ti0-1];
+            sample1 = inBuf[ti0];
+
+            *pOut++ = sample0 + frac * (sample1 - sample0);
+
+            ti = ++to * factor;
+            ti0 = (int) ti;
+            frac = ti - ti0;
+        }
+
+        lastInput[0] = inBuf[inFrames - 1];
+
+        _mm256_zeroupper();
+    }
+
+    void resampleStereo_avx2(const float* inBuf, int inFrames, float* outBuf, int outFrames, float* lastInput)
+    {
+        float* pOut = outBuf;
+        const float* pOutEnd16 = outBuf + outFrames*2 - 16;
+        const float* pOutEnd = outBuf + outFrames*2;
+
+        float factor = (float) inFrames / outFrames;
+
+        float ti = 0.0f; // input frame
+        int ti0 = 0;     // whole number part of input frame
+        float to = 0.0f; // output frame
+        float frac = 0.0f;
+
+        // interpolate between last sample of previous slice and first sample of current slice
+        float sample0L = lastInput[0];
+        float sample0R = lastInput[1];
+        float sample1L = inBuf[0];
+        float sample1R = inBuf[1];
+        while (ti0 == 0)
+        {
+            *pOut++ = sample0L + frac * (sample1L - sample0L);
+            *pOut++ = sample0R + frac * (sample1R - sample0R);
+
+            ti = ++to * factor;
+            ti0 = (int) ti;
+            frac = ti - ti0;
+        }
+
+        // resample the rest of the current slice
+        __m256 tov = _mm256_setr_ps(to, to+1, to+2, to+3, to+4, to+5, to+6, to+7);
+        const __m256 dtov = _mm256_set1_ps(8.0f);
+        const __m256 factorv = _mm256_set1_ps(factor);
+        const __m256i onev = _mm256_set1_epi32(1);
+
+        while (pOut < pOutEnd16)
+        {
+            __m256 tiv = _mm256_mul_ps(tov, factorv);
+            __m256i ti0vi = _mm256_cvttps_epi32(tiv);
+            __m256 fracv = _mm256_sub_ps(tiv, _mm256_cvtepi32_ps(ti0vi));
+
+            // index of left sample of the frame before ti0
+            __m256i indexv = _mm256_slli_epi32(_mm256_sub_epi32(ti0vi, onev), 1);
+            __m256 sample0v_l = _mm256_i32gather_ps(inBuf, indexv, 4);
+            __m256 sample0v_r = _mm256_i32gather_ps(inBuf + 1, indexv, 4);
+            __m256 sample1v_l = _mm256_i32gather_ps(inBuf + 2, indexv, 4);
+            __m256 sample1v_r = _mm256_i32gather_ps(inBuf + 3, indexv, 4);
+
+            __m256 out_l = _mm256_fmadd_ps(fracv, _mm256_sub_ps(sample1v_l, sample0v_l), sample0v_l);
+            __m256 out_r = _mm256_fmadd_ps(fracv, _mm256_sub_ps(sample1v_r, sample0v_r), sample0v_r);
+
+            __m256 lo = _mm256_unpacklo_ps(out_l, out_r); // frames 0 1 4 5
+            __m256 hi = _mm256_unpackhi_ps(out_l, out_r); // frames 2 3 6 7
+            _mm256_storeu_ps(pOut, _mm256_permute2f128_ps(lo, hi, 0x20));
+            _mm256_storeu_ps(pOut + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+            pOut += 16;
+
+            tov = _mm256_add_ps(tov, dtov);
+        }
+
+        to = _mm_cvtss_f32(_mm256_castps256_ps128(tov));
+        ti = to * factor;
+        ti0 = (int) ti;
+        frac = ti - ti0;
+
+        while (pOut < pOutEnd)
+        {
+            const float* pIn = inBuf + (ti0-1)*2;
+            sample0L = *pIn++;
+            sample0R = *pIn++;
+            sample1L = *pIn++;
+            sample1R = *pIn;
+
+            *pOut++ = sample0L + frac * (sample1L - sample0L);
+            *pOut++ = sample0R + frac * (sample1R - sample0R);
+
+            ti = ++to * factor;
+            ti0 = (int) ti;
+            frac = ti - ti0;
+        }
+
+        lastInput[0] = inBuf[inFrames*2 - 2];
+        lastInput[1] = inBuf[inFrames*2 - 1];
+
+        _mm256_zeroupper();
+    }
+
+
+    ////////////////////////////////////////
+    // sinc filter
+
+    void sincMono_avx2(const float* inBuf, float* outBuf, int outFrames, float pos, float factor, const float* table)
+    {
+        // positions are computed in vectors, as in the SSE version
+        __m128 iv = _mm_setzero_ps();
+        const __m128 onev = _mm_set1_ps(1.0f);
+        const __m128 posv = _mm_set1_ps(pos);
+        const __m128 factorv = _mm_set1_ps(factor);
+        const __m128 phasesv = _mm_set1_ps((float) k_sincPhases);
+
+        for (int i = 0; i < outFrames; ++i)
+        {
+            __m128 tv = _mm_add_ps(posv, _mm_mul_ps(iv, factorv));
+            __m128i t0v = _mm_cvttps_epi32(tv);
+            __m128 phasev = _mm_mul_ps(_mm_sub_ps(tv, _mm_cvtepi32_ps(t0v)), phasesv);
+            __m128i phase0v = _mm_cvttps_epi32(phasev);
+            __m128 fracv = _mm_sub_ps(phasev, _mm_cvtepi32_ps(phase0v));
+            int t0 = _mm_cvtsi128_si32(t0v);
+            int phase0 = _mm_cvtsi128_si32(phase0v);
+            iv = _mm_add_ps(iv, onev);
+
+            const float* coef = table + phase0 * k_sincTaps * 2;
+            const float* delta = coef + k_sincTaps;
+            const float* pIn = inBuf + t0;
+            const __m256 frac8v = _mm256_broadcastss_ps(fracv);
+
+            // two accumulators, to shorten the dependency chain
+            __m256 sum0 = _mm256_setzero_ps();
+            __m256 sum1 = _mm256_setzero_ps();
+            for (int j = 0; j < k_sincTaps; j += 16)
+            {
+                __m256 c0 = _mm256_fmadd_ps(frac8v, _mm256_loadu_ps(delta + j), _mm256_loadu_ps(coef + j));
+                __m256 c1 = _mm256_fmadd_ps(frac8v, _mm256_loadu_ps(delta + j + 8), _mm256_loadu_ps(coef + j + 8));
+                sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(pIn + j), c0, sum0);
+                sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(pIn + j + 8), c1, sum1);
+            }
+
+            // horizontal sum
+            sum0 = _mm256_add_ps(sum0, sum1);
+            __m128 sum = _mm_add_ps(_mm256_castps256_ps128(sum0), _mm256_extractf128_ps(sum0, 1));
+            sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+            sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+            _mm_store_ss(outBuf + i, sum);
+        }
+
+        _mm256_zeroupper();
+    }
+
+    void sincStereo_avx2(const float* inBuf, float* outBuf, int outFrames, float pos, float factor, const float* table)
+    {
+        __m128 iv = _mm_setzero_ps();
+        const __m128 onev = _mm_set1_ps(1.0f);
+        const __m128 posv = _mm_set1_ps(pos);
+        const __m128 factorv = _mm_set1_ps(factor);
+        const __m128 phasesv = _mm_set1_ps((float) k_sincPhases);
+
+        // for duplicating coefficients 0-3 and 4-7 of a vector
+        const __m256i dup03 = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+        const __m256i dup47 = _mm256_setr_epi32(4, 4, 5, 5, 6, 6, 7, 7);
+
+        for (int i = 0; i < outFrames; ++i)
+        {
+            __m128 tv = _mm_add_ps(posv, _mm_mul_ps(iv, factorv));
+            __m128i t0v = _mm_cvttps_epi32(tv);
+            __m128 phasev = _mm_mul_ps(_mm_sub_ps(tv, _mm_cvtepi32_ps(t0v)), phasesv);
+            __m128i phase0v = _mm_cvttps_epi32(phasev);
+            __m128 fracv = _mm_sub_ps(phasev, _mm_cvtepi32_ps(phase0v));
+            int t0 = _mm_cvtsi128_si32(t0v);
+            int phase0 = _mm_cvtsi128_si32(phase0v);
+            iv = _mm_add_ps(iv, onev);
+
+            const float* coef = table + phase0 * k_sincTaps * 2;
+            const float* delta = coef + k_sincTaps;
+            const float* pIn = inBuf + t0 * 2;
+            const __m256 frac8v = _mm256_broadcastss_ps(fracv);
+
+            // accumulate L R L R
+            __m256 sum0 = _mm256_setzero_ps();
+            __m256 sum1 = _mm256_setzero_ps();
+            for (int j = 0; j < k_sincTaps; j += 8)
+            {
+                __m256 c = _mm256_fmadd_ps(frac8v, _mm256_loadu_ps(delta + j), _mm256_loadu_ps(coef + j));
+                __m256 c03 = _mm256_permutevar8x32_ps(c, dup03);
+                __m256 c47 = _mm256_permutevar8x32_ps(c, dup47);
+                sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(pIn + j*2), c03, sum0);
+                sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(pIn + j*2 + 8), c47, sum1);
+            }
+
+            sum0 = _mm256_add_ps(sum0, sum1);
+            __m128 sum = _mm_add_ps(_mm256_castps256_ps128(sum0), _mm256_extractf128_ps(sum0, 1));
+            sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+            _mm_storel_pi((__m64*) (outBuf + i*2), sum);
+        }
+
+        _mm256_zeroupper();
+    }
+
+
+    ////////////////////////////////////////
+    // clamp
+
+    bool clamp_avx2(const float* inBuf, float* outBuf, int samples)
+    {
+        const __m256 minv = _mm256_set1_ps(-1.0f);
+        const __m256 maxv = _mm256_set1_ps(1.0f);
+        __m256 clipv = _mm256_setzero_ps();
+
+        const float* pIn = inBuf;
+        const float* pInEnd8 = inBuf + (samples & ~7);
+        const float* pInEnd = inBuf + samples;
+        float* pOut = outBuf;
+        while (pIn < pInEnd8)
+        {
+            __m256 in = _mm256_loadu_ps(pIn);
+
+            clipv = _mm256_or_ps(clipv, _mm256_cmp_ps(in, maxv, _CMP_GT_OQ));
+            clipv = _mm256_or_ps(clipv, _mm256_cmp_ps(in, minv, _CMP_LT_OQ));
+
+            in = _mm256_min_ps(in, maxv);
+            in = _mm256_max_ps(in, minv);
+            _mm256_storeu_ps(pOut, in);
+
+            pIn += 8;
+            pOut += 8;
+        }
+
+        bool clip = (_mm256_movemask_ps(clipv) != 0);
+        while (pIn < pInEnd)
+        {
+            float val = *pIn++;
+
+            if (val > 1.0f)
+            {
+                *pOut = 1.0f;
+                clip = true;
+            }
+            else if (val < -1.0f)
+            {
+                *pOut = -1.0f;
+                clip = true;
+            }
+            else
+            {
+                *pOut = val;
+            }
+
+            ++pOut;
+        }
+
+        _mm256_zeroupper();
+
+        return clip;
+    }
+
+
+}
+
+}
+
+#else // CK_X86_AVX2
+
+namespace Cki
+{
+
+
+namespace AudioUtil
+{
+    void convertF32toI16_avx2(const float* inBuf, int16* outBuf, int samples)
+    {
+        convertF32toI16_sse(inBuf, outBuf, samples);
+    }
+
+    void convertI16toF32_avx2(const int16* inBuf, float* outBuf, int samples)
+    {
+        convertI16toF32_sse(inBuf, outBuf, samples);
+    }
+
+    void mix_avx2(const float* __restrict inBuf, float* __restrict outBuf, int samples)
+    {
+        mix_sse(inBuf, outBuf, samples);
+    }
+
+    void mixVol_avx2(const float* __restrict inBuf, float inVol, float* __restrict outBuf, float outVol, int samples)
+    {
+        mixVol_sse(inBuf, inVol, outBuf, outVol, samples);
+    }
+
+    void convertToStereoScale_avx2(const float* inBuf, float* outBuf, int frames, float volume)
+    {
+        convertToStereoScale_sse(inBuf, outBuf, frames, volume);
+    }
+
+    void scale_avx2(const float* inBuf, float* outBuf, int samples, float volume)
+    {
+        scale_sse(inBuf, outBuf, samples, volume);
+    }
+
+    void stereoPan_avx2(float* buf, int frames, const VolumeMatrix& volume)
+    {
+        stereoPan_sse(buf, frames, volume);
+    }
+
+    void monoPan_avx2(const float* inBuf, float* outBuf, int frames, const VolumeMatrix& volume)
+    {
+        monoPan_sse(inBuf, outBuf, frames, volume);
+    }
+
+    void resampleMono_avx2(const float* inBuf, int inFrames, float* outBuf, int outFrames, float* lastInput)
+    {
+        resampleMono_sse(inBuf, inFrames, outBuf, outFrames, lastInput);
+    }
+
+    void resampleStereo_avx2(const float* inBuf, int inFrames, float* outBuf, int outFrames, float* lastInput)
+    {
+        resampleStereo_sse(inBuf, inFrames, outBuf, outFrames, lastInput);
+    }
+
+    void sincMono_avx2(const float* inBuf, float* outBuf, int outFrames, float pos, float factor, const float* table)
+    {
+        sincMono_sse(inBuf, outBuf, outFrames, pos, factor, table);
+    }
+
+    void sincStereo_avx2(const float* inBuf, float* outBuf, int outFrames, float pos, float factor, const float* table)
+    {
+        sincStereo_sse(inBuf, outBuf, outFrames, pos, factor, table);
+    }
+
+    bool clamp_avx2(const float* inBuf, float* outBuf, int samples)
+    {
+        return clamp_sse(inBuf, outBuf, samples);
+    }
+}
+
+
+}
+
+#endif // CK_X86_AVX2
+
+#endif // CK_X86_SSE
@@ -25,17 +25,12 @@
 // TODO: figure out why some assembly implementations are so much faster by looking at 
 // disassembly of non-asm version, and see if non-asm version can be improved
 
-#if CK_ARCH_ARM
-#  if CK_PLATFORM_ANDROID && __ARM_ARCH_5TE__
-#    define SIMD_IMPL(func, ...) func ## _default(__VA_ARGS__)
-#  else
-#    define SIMD_IMPL(func, ...) System::get()->isSimdSupported() ? func ## _neon(__VA_ARGS__) : func ## _default(__VA_ARGS__)  // ternary, so "return SIMD_IMPL(...)" is ok
-#  endif
-#elif CK_ARCH_X86
-#  define SIMD_IMPL(func, ...) System::get()->isSimdSupported() ? func ## _sse(__VA_ARGS__) : func ## _default(__VA_ARGS__)
-#else 
-#  define SIMD_IMPL(func, ...) func ## _default(__VA_ARGS__)
-#endif
+// The implementation of each function is chosen once, in init(), according to
+// System::getSimdLevel(), rather than on every call.
+//
+// AVX2 implementations are in audioutil.avx2.cpp, since they must be compiled
+// separately with -mavx2 -mfma.  Only the floating-point functions that do the
+// most work have AVX2 versions; the others use the SSE versions.
 
 
 namespace Cki
@@ -44,13 +39,139 @@ namespace Cki
 
 namespace AudioUtil
 {
+    namespace
+    {
+        struct Impl
+        {
+            void (*convertF32toI32)(const float*, int32*, int);
+            void (*convertF32toI16)(const float*, int16*, int);
+            void (*convertI32toF32)(const int32*, float*, int);
+            void (*convertI32toI16)(const int32*, int16*, int);
+            void (*convertI16toF32)(const int16*, float*, int);
+            void (*convertI16toI32)(const int16*, int32*, int);
+            void (*convertI8toF32)(const int8*, float*, int);
+            void (*convertI8toI32)(const int8*, int32*, int);
+
+            void (*mixI32)(const int32* __restrict, int32* __restrict, int);
+            void (*mixF32)(const float* __restrict, float* __restrict, int);
+            void (*mixVolI32)(const int32* __restrict, float, int32* __restrict, float, int);
+            void (*mixVolF32)(const float* __restrict, float, float* __restrict, float, int);
+            void (*convertToStereoI32)(const int32*, int32*, int);
+            void (*convertToStereoF32)(const float*, float*, int);
+            void (*convertToStereoScaleI32)(const int32*, int32*, int, float);
+            void (*convertToStereoScaleF32)(const float*, float*, int, float);
+            void (*scaleI32)(const int32*, int32*, int, float);
+            void (*scaleF32)(const float*, float*, int, float);
+
+            void (*stereoPanI32)(int32*, int, const VolumeMatrix&);
+            void (*stereoPanF32)(float*, int, const VolumeMatrix&);
+            int (*stereoPanRampI32)(int32*, int, const VolumeMatrix&, VolumeMatrix&, float);
+            int (*stereoPanRampF32)(float*, int, const VolumeMatrix&, VolumeMatrix&, float);
+            void (*monoPanI32)(const int32*, int32*, int, const VolumeMatrix&);
+            void (*monoPanF32)(const float*, float*, int, const VolumeMatrix&);
+            int (*monoPanRampI32)(const int32*, int32*, int, const VolumeMatrix&, VolumeMatrix&, float);
+            int (*monoPanRampF32)(const float*, float*, int, const VolumeMatrix&, VolumeMatrix&, float);
+
+            void (*resampleMonoI32)(const int32*, int, int32*, int, int32*);
+            void (*resampleMonoF32)(const float*, int, float*, int, float*);
+            void (*resampleStereoI32)(const int32*, int, int32*, int, int32*);
+            void (*resampleStereoF32)(const float*, int, float*, int, float*);
+            void (*sincMonoI32)(const int32*, int32*, int, float, float, const int32*);
+            void (*sincMonoF32)(const float*, float*, int, float, float, const float*);
+            void (*sincStereoI32)(const int32*, int32*, int, float, float, const int32*);
+            void (*sincStereoF32)(const float*, float*, int, float, float, const float*);
+
+            bool (*clampI32)(const int32*, int32*, int);
+            bool (*clampF32)(const float*, float*, int);
+        };
+
+        Impl g_impl;
+    }
+
+// Use func_suffix for every function; the assignments pick the right overloads.
+#define CK_SET_IMPL(suffix) \
+    g_impl.convertF32toI32 = convertF32toI32 ## suffix; \
+    g_impl.convertF32toI16 = convertF32toI16 ## suffix; \
+    g_impl.convertI32toF32 = convertI32toF32 ## suffix; \
+    g_impl.convertI32toI16 = convertI32toI16 ## suffix; \
+    g_impl.convertI16toF32 = convertI16toF32 ## suffix; \
+    g_impl.convertI16toI32 = convertI16toI32 ## suffix; \
+    g_impl.convertI8toF32 = convertI8toF32 ## suffix; \
+    g_impl.convertI8toI32 = convertI8toI32 ## suffix; \
+    g_impl.mixI32 = mix ## suffix; \
+    g_impl.mixF32 = mix ## suffix; \
+    g_impl.mixVolI32 = mixVol ## suffix; \
+    g_impl.mixVolF32 = mixVol ## suffix; \
+    g_impl.convertToStereoI32 = convertToStereo ## suffix; \
+    g_impl.convertToStereoF32 = convertToStereo ## suffix; \
+    g_impl.convertToStereoScaleI32 = convertToStereoScale ## suffix; \
+    g_impl.convertToStereoScaleF32 = convertToStereoScale ## suffix; \
+    g_impl.scaleI32 = scale ## suffix; \
+    g_impl.scaleF32 = scale ## suffix; \
+    g_impl.stereoPanI32 = stereoPan ## suffix; \
+    g_impl.stereoPanF32 = stereoPan ## suffix; \
+    g_impl.stereoPanRampI32 = stereoPanRamp ## suffix; \
+    g_impl.stereoPanRampF32 = stereoPanRamp ## suffix; \
+    g_impl.monoPanI32 = monoPan ## suffix; \
+    g_impl.monoPanF32 = monoPan ## suffix; \
+    g_impl.monoPanRampI32 = monoPanRamp ## suffix; \
+    g_impl.monoPanRampF32 = monoPanRamp ## suffix; \
+    g_impl.resampleMonoI32 = resampleMono ## suffix; \
+    g_impl.resampleMonoF32 = resampleMono ## suffix; \
+    g_impl.resampleStereoI32 = resampleStereo ## suffix; \
+    g_impl.resampleStereoF32 = resampleStereo ## suffix; \
+    g_impl.sincMonoI32 = sincMono ## suffix; \
+    g_impl.sincMonoF32 = sincMono ## suffix; \
+    g_impl.sincStereoI32 = sincStereo ## suffix; \
+    g_impl.sincStereoF32 = sincStereo ## suffix; \
+    g_impl.clampI32 = clamp ## suffix; \
+    g_impl.clampF32 = clamp ## suffix;
+
+    void init()
+    {
+        CkSimdLevel level = System::get()->getSimdLevel();
+
+        CK_SET_IMPL(_default);
+#if CK_ARCH_ARM
+#  if !(CK_PLATFORM_ANDROID && __ARM_ARCH_5TE__)
+        if (level >= kCkSimdLevel_Basic)
+        {
+            CK_SET_IMPL(_neon);
+        }
+#  endif
+#elif CK_ARCH_X86
+        if (level >= kCkSimdLevel_Basic)
+        {
+            CK_SET_IMPL(_sse);
+        }
+        if (level >= kCkSimdLevel_Avx2)
+        {
+            g_impl.convertF32toI16 = convertF32toI16_avx2;
+            g_impl.convertI16toF32 = convertI16toF32_avx2;
+            g_impl.mixF32 = mix_avx2;
+            g_impl.mixVolF32 = mixVol_avx2;
+            g_impl.convertToStereoScaleF32 = convertToStereoScale_avx2;
+            g_impl.scaleF32 = scale_avx2;
+            g_impl.stereoPanF32 = stereoPan_avx2;
+            g_impl.monoPanF32 = monoPan_avx2;
+            g_impl.resampleMonoF32 = resampleMono_avx2;
+            g_impl.resampleStereoF32 = resampleStereo_avx2;
+            g_impl.sincMonoF32 = sincMono_avx2;
+            g_impl.sincStereoF32 = sincStereo_avx2;
+            g_impl.clampF32 = clamp_avx2;
+        }
+#endif
+    }
+
+#undef CK_SET_IMPL
+
 
     ////////////////////////////////////////
     // convert float to int32
 
     void convert(const float* inBuf, int32* outBuf, int samples)
     {
-        SIMD_IMPL(convertF32toI32, inBuf, outBuf, samples);
+        g_impl.convertF32toI32(inBuf, outBuf, samples);
     }
 
     void convertF32toI32_default(const float* inBuf, int32* outBuf, int samples)
@@ -70,7 +191,7 @@ namespace AudioUtil
 
     void convert(const float* inBuf, int16* outBuf, int samples)
     {
-        SIMD_IMPL(convertF32toI16, inBuf, outBuf, samples);
+        g_impl.convertF32toI16(inBuf, outBuf, samples);
     }
 
     void convertF32toI16_default(const float* inBuf, int16* outBuf, int samples)
@@ -90,7 +211,7 @@ namespace AudioUtil
 
     void convert(const int32* inBuf, float* outBuf, int samples)
     {
-        SIMD_IMPL(convertI32toF32, inBuf, outBuf, samples);
+        g_impl.convertI32toF32(inBuf, outBuf, samples);
     }
 
     void convertI32toF32_default(const int32* inBuf, float* outBuf, int samples)
@@ -111,7 +232,7 @@ namespace AudioUtil
 
     void convert(const int32* inBuf, int16* outBuf, int samples)
     {
-        SIMD_IMPL(convertI32toI16, inBuf, outBuf, samples);
+        g_impl.convertI32toI16(inBuf, outBuf, samples);
     }
 
     void convertI32toI16_default(const int32* inBuf, int16* outBuf, int samples)
@@ -131,7 +252,7 @@ namespace AudioUtil
 
     void convert(const int16* inBuf, float* outBuf, int samples)
     {
-        SIMD_IMPL(convertI16toF32, inBuf, outBuf, samples);
+        g_impl.convertI16toF32(inBuf, outBuf, samples);
     }
 
     void convertI16toF32_default(const int16* inBuf, float* outBuf, int samples)
@@ -152,7 +273,7 @@ namespace AudioUtil
 
     void convert(const int16* inBuf, int32* outBuf, int samples)
     {
-        SIMD_IMPL(convertI16toI32, inBuf, outBuf, samples);
+        g_impl.convertI16toI32(inBuf, outBuf, samples);
     }
 
     void convertI16toI32_default(const int16* inBuf, int32* outBuf, int samples)
@@ -172,7 +293,7 @@ namespace AudioUtil
 
     void convert(const int8* inBuf, float* outBuf, int samples)
     {
-        SIMD_IMPL(convertI8toF32, inBuf, outBuf, samples); 
+        g_impl.convertI8toF32(inBuf, outBuf, samples);
     }
 
     void convertI8toF32_default(const int8* inBuf, float* outBuf, int samples)
@@ -193,7 +314,7 @@ namespace AudioUtil
 
     void convert(const int8* inBuf, int32* outBuf, int samples)
     {
-        SIMD_IMPL(convertI8toI32, inBuf, outBuf, samples); 
+        g_impl.convertI8toI32(inBuf, outBuf, samples);
     }
 
     void convertI8toI32_default(const int8* inBuf, int32* outBuf, int samples)
@@ -222,7 +343,7 @@ namespace AudioUtil
 
     void mix(const int32* __restrict inBuf, int32* __restrict outBuf, int samples)
     {
-        SIMD_IMPL(mix, inBuf, outBuf, samples);
+        g_impl.mixI32(inBuf, outBuf, samples);
     }
 
     void mix_default(const int32* __restrict inBuf, int32* __restrict outBuf, int samples)
@@ -239,7 +360,7 @@ namespace AudioUtil
 
     void mix(const float* __restrict inBuf, float* __restrict outBuf, int samples)
     {
-        SIMD_IMPL(mix, inBuf, outBuf, samples);
+        g_impl.mixF32(inBuf, outBuf, samples);
     }
 
     void mix_default(const float* __restrict inBuf, float* __restrict outBuf, int samples)
@@ -260,7 +381,7 @@ namespace AudioUtil
 
     void mixVol(const int32* __restrict inBuf, float inVol, int32* __restrict outBuf, float outVol, int samples)
     {
-        SIMD_IMPL(mixVol, inBuf, inVol, outBuf, outVol, samples);
+        g_impl.mixVolI32(inBuf, inVol, outBuf, outVol, samples);
     }
 
     void mixVol_default(const int32* __restrict inBuf, float inVol, int32* __restrict outBuf, float outVol, int samples)
@@ -283,7 +404,7 @@ namespace AudioUtil
 
     void mixVol(const float* __restrict inBuf, float inVol, float* __restrict outBuf, float outVol, int samples)
     {
-        SIMD_IMPL(mixVol, inBuf, inVol, outBuf, outVol, samples);
+        g_impl.mixVolF32(inBuf, inVol, outBuf, outVol, samples);
     }
 
     void mixVol_default(const float* __restrict inBuf, float inVol, float* __restrict outBuf, float outVol, int samples)
@@ -306,7 +427,7 @@ namespace AudioUtil
 
     void convertToStereo(const int32* inBuf, int32* outBuf, int frames)
     {
-        SIMD_IMPL(convertToStereo, inBuf, outBuf, frames);
+        g_impl.convertToStereoI32(inBuf, outBuf, frames);
     }
 
     void convertToStereo_default(const int32* inBuf, int32* outBuf, int frames)
@@ -325,7 +446,7 @@ namespace AudioUtil
 
     void convertToStereo(const float* inBuf, float* outBuf, int frames)
     {
-        SIMD_IMPL(convertToStereo, inBuf, outBuf, frames);
+        g_impl.convertToStereoF32(inBuf, outBuf, frames);
     }
 
     void convertToStereo_default(const float* inBuf, float* outBuf, int frames)
@@ -348,7 +469,7 @@ namespace AudioUtil
 
     void convertToStereoScale(const int32* inBuf, int32* outBuf, int frames, float volume)
     {
-        SIMD_IMPL(convertToStereoScale, inBuf, outBuf, frames, volume);
+        g_impl.convertToStereoScaleI32(inBuf, outBuf, frames, volume);
     }
 
     void convertToStereoScale_default(const int32* inBuf, int32* outBuf, int frames, float volume)
@@ -368,7 +489,7 @@ namespace AudioUtil
 
     void convertToStereoScale(const float* inBuf, float* outBuf, int frames, float volume)
     {
-        SIMD_IMPL(convertToStereoScale, inBuf, outBuf, frames, volume);
+        g_impl.convertToStereoScaleF32(inBuf, outBuf, frames, volume);
     }
 
     void convertToStereoScale_default(const float* inBuf, float* outBuf, int frames, float volume)
@@ -390,7 +511,7 @@ namespace AudioUtil
 
     void scale(const int32* inBuf, int32* outBuf, int samples, float volume)
     {
-        SIMD_IMPL(scale, inBuf, outBuf, samples, volume);
+        g_impl.scaleI32(inBuf, outBuf, samples, volume);
     }
 
     void scale_default(const int32* inBuf, int32* outBuf, int samples, float volume)
@@ -408,7 +529,7 @@ namespace AudioUtil
 
     void scale(const float* inBuf, float* outBuf, int samples, float volume)
     {
-        SIMD_IMPL(scale, inBuf, outBuf, samples, volume);
+        g_impl.scaleF32(inBuf, outBuf, samples, volume);
     }
 
     void scale_default(const float* inBuf, float* outBuf, int samples, float volume)
@@ -471,7 +592,7 @@ namespace AudioUtil
 
     void stereoPan(int32* buf, int frames, const VolumeMatrix& volume)
     {
-        SIMD_IMPL(stereoPan, buf, frames, volume);
+        g_impl.stereoPanI32(buf, frames, volume);
     }
 
     void stereoPan_default(int32* buf, int frames, const VolumeMatrix& volume)
@@ -495,7 +616,7 @@ namespace AudioUtil
 
     int stereoPanRamp(int32* buf, int frames, const VolumeMatrix& targetVolume, VolumeMatrix& volume, float volumeRate)
     {
-        return SIMD_IMPL(stereoPanRamp, buf, frames, targetVolume, volume, volumeRate);
+        return g_impl.stereoPanRampI32(buf, frames, targetVolume, volume, volumeRate);
     }
 
     int stereoPanRamp_default(int32* buf, int frames, const VolumeMatrix& targetVolume, VolumeMatrix& volume, float volumeRate)
@@ -554,7 +675,7 @@ namespace AudioUtil
 
     void stereoPan(float* buf, int frames, const VolumeMatrix& volume)
     {
-        SIMD_IMPL(stereoPan, buf, frames, volume);
+        g_impl.stereoPanF32(buf, frames, volume);
     }
 
     void stereoPan_default(float* buf, int frames, const VolumeMatrix& volume)
@@ -578,7 +699,7 @@ namespace AudioUtil
 
     int stereoPanRamp(float* buf, int frames, const VolumeMatrix& targetVolume, VolumeMatrix& volume, float volumeRate)
     {
-        return SIMD_IMPL(stereoPanRamp, buf, frames, targetVolume, volume, volumeRate);
+        return g_impl.stereoPanRampF32(buf, frames, targetVolume, volume, volumeRate);
     }
 
     int stereoPanRamp_default(float* buf, int frames, const VolumeMatrix& targetVolume, VolumeMatrix& volume, float volumeRate)
@@ -678,7 +799,7 @@ namespace AudioUtil
 
     void monoPan(const int32* inBuf, int32* outBuf, int frames, const VolumeMatrix& volume)
     {
-        SIMD_IMPL(monoPan, inBuf, outBuf, frames, volume);
+        g_impl.monoPanI32(inBuf, outBuf, frames, volume);
     }
 
     void monoPan_default(const int32* inBuf, int32* outBuf, int frames, const VolumeMatrix& volume)
@@ -700,7 +821,7 @@ namespace AudioUtil
 
     int monoPanRamp(const int32* inBuf, int32* outBuf, int frames, const VolumeMatrix& targetVolume, VolumeMatrix& volume, float volumeRate)
     {
-        return SIMD_IMPL(monoPanRamp, inBuf, outBuf, frames, targetVolume, volume, volumeRate);
+        return g_impl.monoPanRampI32(inBuf, outBuf, frames, targetVolume, volume, volumeRate);
     }
 
     int monoPanRamp_default(const int32* inBuf, int32* outBuf, int frames, const VolumeMatrix& targetVolume, VolumeMatrix& volume, float volumeRate)
@@ -754,7 +875,7 @@ namespace AudioUtil
 
     void monoPan(const float* inBuf, float* outBuf, int frames, const VolumeMatrix& volume)
     {
-        SIMD_IMPL(monoPan, inBuf, outBuf, frames, volume);
+        g_impl.monoPanF32(inBuf, outBuf, frames, volume);
     }
 
     void monoPan_default(const float* inBuf, float* outBuf, int frames, const VolumeMatrix& volume)
@@ -775,7 +896,7 @@ namespace AudioUtil
 
     int monoPanRamp(const float* inBuf, float* outBuf, int frames, const VolumeMatrix& targetVolume, VolumeMatrix& volume, float volumeRate)
     {
-        return SIMD_IMPL(monoPanRamp, inBuf, outBuf, frames, targetVolume, volume, volumeRate);
+        return g_impl.monoPanRampF32(inBuf, outBuf, frames, targetVolume, volume, volumeRate);
     }
 
     int monoPanRamp_default(const float* inBuf, float* outBuf, int frames, const VolumeMatrix& targetVolume, VolumeMatrix& volume, float volumeRate)
@@ -846,7 +967,7 @@ namespace AudioUtil
 
     void resampleMono(const int32* inBuf, int inFrames, int32* outBuf, int outFrames, int32* lastInput)
     {
-        SIMD_IMPL(resampleMono, inBuf, inFrames, outBuf, outFrames, lastInput);
+        g_impl.resampleMonoI32(inBuf, inFrames, outBuf, outFrames, lastInput);
     }
 
     void resampleMono_default(const int32* inBuf, int inFrames, int32* outBuf, int outFrames, int32* lastInput)
@@ -896,7 +1017,7 @@ namespace AudioUtil
 
     void resampleStereo(const int32* inBuf, int inFrames, int32* outBuf, int outFrames, int32* lastInput)
     {
-        SIMD_IMPL(resampleStereo, inBuf, inFrames, outBuf, outFrames, lastInput);
+        g_impl.resampleStereoI32(inBuf, inFrames, outBuf, outFrames, lastInput);
     }
 
     void resampleStereo_default(const int32* inBuf, int inFrames, int32* outBuf, int outFrames, int32* lastInput)
@@ -962,7 +1083,7 @@ namespace AudioUtil
 
     void resampleMono(const float* inBuf, int inFrames, float* outBuf, int outFrames, float* lastInput)
     {
-        SIMD_IMPL(resampleMono, inBuf, inFrames, outBuf, outFrames, lastInput);
+        g_impl.resampleMonoF32(inBuf, inFrames, outBuf, outFrames, lastInput);
     }
 
     void resampleMono_default(const float* inBuf, int inFrames, float* outBuf, int outFrames, float* lastInput)
@@ -1007,7 +1128,7 @@ namespace AudioUtil
 
     void resampleStereo(const float* inBuf, int inFrames, float* outBuf, int outFrames, float* lastInput)
     {
-        SIMD_IMPL(resampleStereo, inBuf, inFrames, outBuf, outFrames, lastInput);
+        g_impl.resampleStereoF32(inBuf, inFrames, outBuf, outFrames, lastInput);
     }
 
     void resampleStereo_default(const float* inBuf, int inFrames, float* outBuf, int outFrames, float* lastInput)
@@ -1059,11 +1180,137 @@ namespace AudioUtil
     }
 
 
+    ////////////////////////////////////////
+    // sinc filter
+
+    void sincMono(const int32* inBuf, int32* outBuf, int outFrames, float pos, float factor, const int32* table)
+    {
+        g_impl.sincMonoI32(inBuf, outBuf, outFrames, pos, factor, table);
+    }
+
+    void sincMono_default(const int32* inBuf, int32* outBuf, int outFrames, float pos, float factor, const int32* table)
+    {
+        uint32 t_16_16 = Fixed16_16::fromFloat(pos);
+        uint32 factor_16_16 = Fixed16_16::fromFloat(factor);
+
+        for (int i = 0; i < outFrames; ++i)
+        {
+            // top 6 bits of fraction are the phase; the other 10 interpolate between phases
+            uint32 phase_6_10 = (t_16_16 & 0xffff);
+            const int32* coef = table + (phase_6_10 >> 10) * k_sincTaps * 2;
+            const int32* delta = coef + k_sincTaps;
+            int32 frac = (int32) (phase_6_10 & 0x3ff);
+            const int32* pIn = inBuf + (t_16_16 >> 16);
+
+            int64 sum = 0;
+            for (int j = 0; j < k_sincTaps; ++j)
+            {
+                int32 c = coef[j] + (int32) (((int64) delta[j] * frac) >> 10);
+                sum += (int64) pIn[j] * c;
+            }
+            outBuf[i] = (int32) (sum >> 30);
+
+            t_16_16 += factor_16_16;
+        }
+    }
+
+    void sincStereo(const int32* inBuf, int32* outBuf, int outFrames, float pos, float factor, const int32* table)
+    {
+        g_impl.sincStereoI32(inBuf, outBuf, outFrames, pos, factor, table);
+    }
+
+    void sincStereo_default(const int32* inBuf, int32* outBuf, int outFrames, float pos, float factor, const int32* table)
+    {
+        uint32 t_16_16 = Fixed16_16::fromFloat(pos);
+        uint32 factor_16_16 = Fixed16_16::fromFloat(factor);
+
+        for (int i = 0; i < outFrames; ++i)
+        {
+            uint32 phase_6_10 = (t_16_16 & 0xffff);
+            const int32* coef = table + (phase_6_10 >> 10) * k_sincTaps * 2;
+            const int32* delta = coef + k_sincTaps;
+            int32 frac = (int32) (phase_6_10 & 0x3ff);
+            const int32* pIn = inBuf + (t_16_16 >> 16) * 2;
+
+            int64 sumL = 0;
+            int64 sumR = 0;
+            for (int j = 0; j < k_sincTaps; ++j)
+            {
+                int32 c = coef[j] + (int32) (((int64) delta[j] * frac) >> 10);
+                sumL += (int64) pIn[j*2] * c;
+                sumR += (int64) pIn[j*2+1] * c;
+            }
+            outBuf[i*2] = (int32) (sumL >> 30);
+            outBuf[i*2+1] = (int32) (sumR >> 30);
+
+            t_16_16 += factor_16_16;
+        }
+    }
+
+    void sincMono(const float* inBuf, float* outBuf, int outFrames, float pos, float factor, const float* table)
+    {
+        g_impl.sincMonoF32(inBuf, outBuf, outFrames, pos, factor, table);
+    }
+
+    void sincMono_default(const float* inBuf, float* outBuf, int outFrames, float pos, float factor, const float* table)
+    {
+        for (int i = 0; i < outFrames; ++i)
+        {
+            float t = pos + i * factor;
+            int t0 = (int) t;
+            float phase = (t - t0) * k_sincPhases;
+            int phase0 = (int) phase;
+            float frac = phase - phase0;
+            const float* coef = table + phase0 * k_sincTaps * 2;
+            const float* delta = coef + k_sincTaps;
+            const float* pIn = inBuf + t0;
+
+            float sum = 0.0f;
+            for (int j = 0; j < k_sincTaps; ++j)
+            {
+                sum += pIn[j] * (coef[j] + frac * delta[j]);
+            }
+            outBuf[i] = sum;
+        }
+    }
+
+    void sincStereo(const float* inBuf, float* outBuf, int outFrames, float pos, float factor, const float* table)
+    {
+        g_impl.sincStereoF32(inBuf, outBuf, outFrames, pos, factor, table);
+    }
+
+    void sincStereo_default(const float* inBuf, float* outBuf, int outFrames, float pos, float factor, const float* table)
+    {
+        for (int i = 0; i < outFrames; ++i)
+        {
+            float t = pos + i * factor;
+            int t0 = (int) t;
+            float phase = (t - t0) * k_sincPhases;
+            int phase0 = (int) phase;
+            float frac = phase - phase0;
+            const float* coef = table + phase0 * k_sincTaps * 2;
+            const float* delta = coef + k_sincTaps;
+            const float* pIn = inBuf + t0 * 2;
+
+            float sumL = 0.0f;
+            float sumR = 0.0f;
+            for (int j = 0; j < k_sincTaps; ++j)
+            {
+                float c = coef[j] + frac * delta[j];
+                sumL += pIn[j*2] * c;
+                sumR += pIn[j*2+1] * c;
+            }
+            outBuf[i*2] = sumL;
+            outBuf[i*2+1] = sumR;
+        }
+    }
+
+
     ////////////////////////////////////////
 
     bool clamp(const int32* inBuf, int32* outBuf, int samples)
     {
-        return SIMD_IMPL(clamp, inBuf, outBuf, samples);
+        return g_impl.clampI32(inBuf, outBuf, samples);
     }
 
     bool clamp_default(const int32* inBuf, int32* outBuf, int samples)
@@ -1102,7 +1349,7 @@ namespace AudioUtil
 
     bool clamp(const float* inBuf, float* outBuf, int samples)
     {
-        return SIMD_IMPL(clamp, inBuf, outBuf, samples);
+        return g_impl.clampF32(inBuf, outBuf, samples);
     }
 
     bool clamp_default(const float* inBuf, float* outBuf, int samples)
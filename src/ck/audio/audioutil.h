@@ -10,6 +10,10 @@ struct VolumeMatrix;
 
 namespace AudioUtil
 {
+    // Choose the implementations used by the functions below, according to
+    // System::getSimdLevel().  Call before using them.
+    void init();
+
     // TODO __restrict? versions of the in-place functions
     // TODO separate in-place versions?
     // TODO check for buffer overruuns
@@ -25,6 +29,7 @@ namespace AudioUtil
     void convertF32toI16_default(const float* inBuf, int16* outBuf, int samples);
     void convertF32toI16_neon(const float* inBuf, int16* outBuf, int samples);
     void convertF32toI16_sse(const float* inBuf, int16* outBuf, int samples);
+    void convertF32toI16_avx2(const float* inBuf, int16* outBuf, int samples);
 
     void convert(const int32* inBuf, float* outBuf, int samples);
     void convertI32toF32_default(const int32* inBuf, float* outBuf, int samples);
@@ -40,6 +45,7 @@ namespace AudioUtil
     void convertI16toF32_default(const int16* inBuf, float* outBuf, int samples);
     void convertI16toF32_neon(const int16* inBuf, float* outBuf, int samples);
     void convertI16toF32_sse(const int16* inBuf, float* outBuf, int samples);
+    void convertI16toF32_avx2(const int16* inBuf, float* outBuf, int samples);
 
     void convert(const int16* inBuf, int32* outBuf, int samples);
     void convertI16toI32_default(const int16* inBuf, int32* outBuf, int samples);
@@ -69,6 +75,7 @@ namespace AudioUtil
     void mix_default(const float* __restrict inBuf, float* __restrict outBuf, int samples);
     void mix_neon(const float* __restrict inBuf, float* __restrict outBuf, int samples);
     void mix_sse(const float* __restrict inBuf, float* __restrict outBuf, int samples);
+    void mix_avx2(const float* __restrict inBuf, float* __restrict outBuf, int samples);
 
     // Mix input into output (same number of channels), with volumes
     void mixVol(const int32* __restrict inBuf, float inVol, int32* __restrict outBuf, float outVol, int samples);
@@ -80,6 +87,7 @@ namespace AudioUtil
     void mixVol_default(const float* __restrict inBuf, float inVol, float* __restrict outBuf, float outVol, int samples);
     void mixVol_neon(const float* __restrict inBuf, float inVol, float* __restrict outBuf, float outVol, int samples);
     void mixVol_sse(const float* __restrict inBuf, float inVol, float* __restrict outBuf, float outVol, int samples);
+    void mixVol_avx2(const float* __restrict inBuf, float inVol, float* __restrict outBuf, float outVol, int samples);
 
     // Convert mono to stereo
     void convertToStereo(const int32* inBuf, int32* outBuf, int frames);
@@ -102,6 +110,7 @@ namespace AudioUtil
     void convertToStereoScale_default(const float* inBuf, float* outBuf, int frames, float volume);
     void convertToStereoScale_neon(const float* inBuf, float* outBuf, int frames, float volume);
     void convertToStereoScale_sse(const float* inBuf, float* outBuf, int frames, float volume);
+    void convertToStereoScale_avx2(const float* inBuf, float* outBuf, int frames, float volume);
 
     // Scale (in-place OK)
     void scale(const int32* inBuf, int32* outBuf, int samples, float volume);
@@ -113,6 +122,7 @@ namespace AudioUtil
     void scale_default(const float* inBuf, float* outBuf, int samples, float volume);
     void scale_neon(const float* inBuf, float* outBuf, int samples, float volume);
     void scale_sse(const float* inBuf, float* outBuf, int samples, float volume);
+    void scale_avx2(const float* inBuf, float* outBuf, int samples, float volume);
 
     // Apply pan matrix to stereo
     void stereoPan(int32* buf, int frames, const VolumeMatrix& targetVolume, VolumeMatrix& volume, float volumeRate);
@@ -130,6 +140,7 @@ namespace AudioUtil
     void stereoPan_default(float* buf, int frames, const VolumeMatrix& volume);
     void stereoPan_neon(float* buf, int frames, const VolumeMatrix& volume);
     void stereoPan_sse(float* buf, int frames, const VolumeMatrix& volume);
+    void stereoPan_avx2(float* buf, int frames, const VolumeMatrix& volume);
     int stereoPanRamp(float* buf, int frames, const VolumeMatrix& targetVolume, VolumeMatrix& volume, float volumeRate);
     int stereoPanRamp_default(float* buf, int frames, const VolumeMatrix& targetVolume, VolumeMatrix& volume, float volumeRate);
     int stereoPanRamp_neon(float* buf, int frames, const VolumeMatrix& targetVolume, VolumeMatrix& volume, float volumeRate);
@@ -151,6 +162,7 @@ namespace AudioUtil
     void monoPan_default(const float* inBuf, float* outBuf, int frames, const VolumeMatrix& volume);
     void monoPan_neon(const float* inBuf, float* outBuf, int frames, const VolumeMatrix& volume);
     void monoPan_sse(const float* inBuf, float* outBuf, int frames, const VolumeMatrix& volume);
+    void monoPan_avx2(const float* inBuf, float* outBuf, int frames, const VolumeMatrix& volume);
     int monoPanRamp(const float* inBuf, float* outBuf, int frames, const VolumeMatrix& targetVolume, VolumeMatrix& volume, float volumeRate);
     int monoPanRamp_default(const float* inBuf, float* outBuf, int frames, const VolumeMatrix& targetVolume, VolumeMatrix& volume, float volumeRate);
     int monoPanRamp_neon(const float* inBuf, float* outBuf, int frames, const VolumeMatrix& targetVolume, VolumeMatrix& volume, float volumeRate);
@@ -172,10 +184,40 @@ namespace AudioUtil
     void resampleMono_default(const float* inBuf, int inFrames, float* outBuf, int outFrames, float* lastInput);
     void resampleMono_neon(const float* inBuf, int inFrames, float* outBuf, int outFrames, float* lastInput);
     void resampleMono_sse(const float* inBuf, int inFrames, float* outBuf, int outFrames, float* lastInput);
+    void resampleMono_avx2(const float* inBuf, int inFrames, float* outBuf, int outFrames, float* lastInput);
     void resampleStereo(const float* inBuf, int inFrames, float* outBuf, int outFrames, float* lastInput);
     void resampleStereo_default(const float* inBuf, int inFrames, float* outBuf, int outFrames, float* lastInput);
     void resampleStereo_neon(const float* inBuf, int inFrames, float* outBuf, int outFrames, float* lastInput);
     void resampleStereo_sse(const float* inBuf, int inFrames, float* outBuf, int outFrames, float* lastInput);
+    void resampleStereo_avx2(const float* inBuf, int inFrames, float* outBuf, int outFrames, float* lastInput);
+
+    // Polyphase windowed-sinc filter, for Resampler.
+    // Output frame i is filtered from input frames n through n+k_sincTaps-1, where
+    // n + phase = pos + i*factor; the table holds k_sincPhases sets of k_sincTaps
+    // coefficients, each followed by its differences from the next set, so that
+    // coefficients can be interpolated between phases.
+    // Fixed-point coefficients are 2.30.
+    enum { k_sincTaps = 32, k_sincPhases = 64 };
+
+    void sincMono(const int32* inBuf, int32* outBuf, int outFrames, float pos, float factor, const int32* table);
+    void sincMono_default(const int32* inBuf, int32* outBuf, int outFrames, float pos, float factor, const int32* table);
+    void sincMono_neon(const int32* inBuf, int32* outBuf, int outFrames, float pos, float factor, const int32* table);
+    void sincMono_sse(const int32* inBuf, int32* outBuf, int outFrames, float pos, float factor, const int32* table);
+    void sincStereo(const int32* inBuf, int32* outBuf, int outFrames, float pos, float factor, const int32* table);
+    void sincStereo_default(const int32* inBuf, int32* outBuf, int outFrames, float pos, float factor, const int32* table);
+    void sincStereo_neon(const int32* inBuf, int32* outBuf, int outFrames, float pos, float factor, const int32* table);
+    void sincStereo_sse(const int32* inBuf, int32* outBuf, int outFrames, float pos, float factor, const int32* table);
+
+    void sincMono(const float* inBuf, float* outBuf, int outFrames, float pos, float factor, const float* table);
+    void sincMono_default(const float* inBuf, float* outBuf, int outFrames, float pos, float factor, const float* table);
+    void sincMono_neon(const float* inBuf, float* outBuf, int outFrames, float pos, float factor, const float* table);
+    void sincMono_sse(const float* inBuf, float* outBuf, int outFrames, float pos, float factor, const float* table);
+    void sincMono_avx2(const float* inBuf, float* outBuf, int outFrames, float pos, float factor, const float* table);
+    void sincStereo(const float* inBuf, float* outBuf, int outFrames, float pos, float factor, const float* table);
+    void sincStereo_default(const float* inBuf, float* outBuf, int outFrames, float pos, float factor, const float* table);
+    void sincStereo_neon(const float* inBuf, float* outBuf, int outFrames, float pos, float factor, const float* table);
+    void sincStereo_sse(const float* inBuf, float* outBuf, int outFrames, float pos, float factor, const float* table);
+    void sincStereo_avx2(const float* inBuf, float* outBuf, int outFrames, float pos, float factor, const float* table);
 
     // Clamp 
     bool clamp(const int32* inBuf, int32* outBuf, int samples);
@@ -187,6 +229,7 @@ namespace AudioUtil
     bool clamp_default(const float* inBuf, float* outBuf, int samples);
     bool clamp_neon(const float* inBuf, float* outBuf, int samples);
     bool clamp_sse(const float* inBuf, float* outBuf, int samples);
+    bool clamp_avx2(const float* inBuf, float* outBuf, int samples);
 }
 
 
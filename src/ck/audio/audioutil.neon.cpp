@@ -888,6 +888,12 @@ namespace AudioUtil
             if (nFrames < rrFrames) rrv = vadd_s32(rrv, rrIncv);
             nFrames += 2;
 
+            // once a ramp is done, hold its final value in all lanes
+            if (nFrames == llFrames) llv = vdup_lane_s32(llv, 0);
+            if (nFrames == lrFrames) lrv = vdup_lane_s32(lrv, 0);
+            if (nFrames == rlFrames) rlv = vdup_lane_s32(rlv, 0);
+            if (nFrames == rrFrames) rrv = vdup_lane_s32(rrv, 0);
+
             // left high
             tmp = vmull_s32(in_left_high, llv);
             tmp = vmlal_s32(tmp, in_right_high, lrv);
@@ -904,6 +910,12 @@ namespace AudioUtil
             if (nFrames < rrFrames) rrv = vadd_s32(rrv, rrIncv);
             nFrames += 2;
 
+            // once a ramp is done, hold its final value in all lanes
+            if (nFrames == llFrames) llv = vdup_lane_s32(llv, 0);
+            if (nFrames == lrFrames) lrv = vdup_lane_s32(lrv, 0);
+            if (nFrames == rlFrames) rlv = vdup_lane_s32(rlv, 0);
+            if (nFrames == rrFrames) rrv = vdup_lane_s32(rrv, 0);
+
             out.val[0] = vcombine_s32(out_left_low, out_left_high);
             out.val[1] = vcombine_s32(out_right_low, out_right_high);
 
@@ -1008,6 +1020,12 @@ namespace AudioUtil
             if (nFrames < rrFrames) rrv = vaddq_f32(rrv, rrIncv);
             nFrames += 4;
 
+            // once a ramp is done, hold its final value in all lanes
+            if (nFrames == llFrames) llv = vdupq_lane_f32(vget_low_f32(llv), 0);
+            if (nFrames == lrFrames) lrv = vdupq_lane_f32(vget_low_f32(lrv), 0);
+            if (nFrames == rlFrames) rlv = vdupq_lane_f32(vget_low_f32(rlv), 0);
+            if (nFrames == rrFrames) rrv = vdupq_lane_f32(vget_low_f32(rrv), 0);
+
             vst2q_f32(p, out);
 
             p += 8;
@@ -1202,6 +1220,10 @@ namespace AudioUtil
             if (nFrames < rFrames) rv = vadd_s32(rv, rIncv);
             nFrames += 2;
 
+            // once a ramp is done, hold its final value in all lanes
+            if (nFrames == lFrames) lv = vdup_lane_s32(lv, 0);
+            if (nFrames == rFrames) rv = vdup_lane_s32(rv, 0);
+
             // left high
             tmp = vmull_s32(in_high, lv);
             out_left_high = vshrn_n_s64(tmp, 24);
@@ -1217,6 +1239,10 @@ namespace AudioUtil
             if (nFrames < rFrames) rv = vadd_s32(rv, rIncv);
             nFrames += 2;
 
+            // once a ramp is done, hold its final value in all lanes
+            if (nFrames == lFrames) lv = vdup_lane_s32(lv, 0);
+            if (nFrames == rFrames) rv = vdup_lane_s32(rv, 0);
+
             vst2q_s32(pOut, out);
 
             pOut += 8;
@@ -1293,6 +1319,10 @@ namespace AudioUtil
             if (nFrames < rFrames) rv = vaddq_f32(rv, rIncv);
             nFrames += 4;
 
+            // once a ramp is done, hold its final value in all lanes
+            if (nFrames == lFrames) lv = vdupq_lane_f32(vget_low_f32(lv), 0);
+            if (nFrames == rFrames) rv = vdupq_lane_f32(vget_low_f32(rv), 0);
+
             vst2q_f32(pOut, out);
 
             pOut += 8;
@@ -1921,6 +1951,29 @@ namespace AudioUtil
         return clip;
     }
 
+    ////////////////////////////////////////
+    // sinc filter
+
+    void sincMono_neon(const int32* inBuf, int32* outBuf, int outFrames, float pos, float factor, const int32* table)
+    {
+        sincMono_default(inBuf, outBuf, outFrames, pos, factor, table);
+    }
+
+    void sincStereo_neon(const int32* inBuf, int32* outBuf, int outFrames, float pos, float factor, const int32* table)
+    {
+        sincStereo_default(inBuf, outBuf, outFrames, pos, factor, table);
+    }
+
+    void sincMono_neon(const float* inBuf, float* outBuf, int outFrames, float pos, float factor, const float* table)
+    {
+        sincMono_default(inBuf, outBuf, outFrames, pos, factor, table);
+    }
+
+    void sincStereo_neon(const float* inBuf, float* outBuf, int outFrames, float pos, float factor, const float* table)
+    {
+        sincStereo_default(inBuf, outBuf, outFrames, pos, factor, table);
+    }
+
 }
 
 }
@@ -664,6 +664,12 @@ namespace AudioUtil
             if (nFrames < rrFrames) rrv = _mm_add_ps(rrv, rrIncv);
             nFrames += 4;
 
+            // once a ramp is done, hold its final value in all lanes
+            if (nFrames == llFrames) llv = _mm_shuffle_ps(llv, llv, 0);
+            if (nFrames == lrFrames) lrv = _mm_shuffle_ps(lrv, lrv, 0);
+            if (nFrames == rlFrames) rlv = _mm_shuffle_ps(rlv, rlv, 0);
+            if (nFrames == rrFrames) rrv = _mm_shuffle_ps(rrv, rrv, 0);
+
             _mm_storeu_ps(p, tmp0);
             _mm_storeu_ps(p+4, tmp1);
 
@@ -797,6 +803,10 @@ namespace AudioUtil
             if (nFrames < rFrames) rv = _mm_add_ps(rv, rIncv);
             nFrames += 4;
 
+            // once a ramp is done, hold its final value in all lanes
+            if (nFrames == lFrames) lv = _mm_shuffle_ps(lv, lv, 0);
+            if (nFrames == rFrames) rv = _mm_shuffle_ps(rv, rv, 0);
+
             _mm_storeu_ps(pOut, out0);
             pOut += 4;
             _mm_storeu_ps(pOut, out1);
@@ -1034,6 +1044,105 @@ namespace AudioUtil
         lastInput[1] = inBuf[inFrames*2 - 1];
     }
 
+    ////////////////////////////////////////
+    // sinc filter
+
+    void sincMono_sse(const int32* inBuf, int32* outBuf, int outFrames, float pos, float factor, const int32* table)
+    {
+        sincMono_default(inBuf, outBuf, outFrames, pos, factor, table);
+    }
+
+    void sincStereo_sse(const int32* inBuf, int32* outBuf, int outFrames, float pos, float factor, const int32* table)
+    {
+        sincStereo_default(inBuf, outBuf, outFrames, pos, factor, table);
+    }
+
+    void sincMono_sse(const float* inBuf, float* outBuf, int outFrames, float pos, float factor, const float* table)
+    {
+        // Positions are computed in vectors (all lanes the same); scalar int/float
+        // conversions depend on the previous contents of the register, which
+        // serializes each output with the previous one.
+        __m128 iv = _mm_setzero_ps();
+        const __m128 onev = _mm_set1_ps(1.0f);
+        const __m128 posv = _mm_set1_ps(pos);
+        const __m128 factorv = _mm_set1_ps(factor);
+        const __m128 phasesv = _mm_set1_ps((float) k_sincPhases);
+
+        for (int i = 0; i < outFrames; ++i)
+        {
+            __m128 tv = _mm_add_ps(posv, _mm_mul_ps(iv, factorv));
+            __m128i t0v = _mm_cvttps_epi32(tv);
+            __m128 phasev = _mm_mul_ps(_mm_sub_ps(tv, _mm_cvtepi32_ps(t0v)), phasesv);
+            __m128i phase0v = _mm_cvttps_epi32(phasev);
+            __m128 fracv = _mm_sub_ps(phasev, _mm_cvtepi32_ps(phase0v));
+            int t0 = _mm_cvtsi128_si32(t0v);
+            int phase0 = _mm_cvtsi128_si32(phase0v);
+            iv = _mm_add_ps(iv, onev);
+
+            const float* coef = table + phase0 * k_sincTaps * 2;
+            const float* delta = coef + k_sincTaps;
+            const float* pIn = inBuf + t0;
+
+            // two accumulators, to shorten the dependency chain
+            __m128 sum0 = _mm_setzero_ps();
+            __m128 sum1 = _mm_setzero_ps();
+            for (int j = 0; j < k_sincTaps; j += 8)
+            {
+                __m128 c0 = _mm_add_ps(_mm_loadu_ps(coef + j), _mm_mul_ps(fracv, _mm_loadu_ps(delta + j)));
+                __m128 c1 = _mm_add_ps(_mm_loadu_ps(coef + j + 4), _mm_mul_ps(fracv, _mm_loadu_ps(delta + j + 4)));
+                sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(pIn + j), c0));
+                sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(pIn + j + 4), c1));
+            }
+
+            // horizontal sum
+            sum0 = _mm_add_ps(sum0, sum1);
+            sum0 = _mm_add_ps(sum0, _mm_movehl_ps(sum0, sum0));
+            sum0 = _mm_add_ss(sum0, _mm_shuffle_ps(sum0, sum0, 1));
+            _mm_store_ss(outBuf + i, sum0);
+        }
+    }
+
+    void sincStereo_sse(const float* inBuf, float* outBuf, int outFrames, float pos, float factor, const float* table)
+    {
+        __m128 iv = _mm_setzero_ps();
+        const __m128 onev = _mm_set1_ps(1.0f);
+        const __m128 posv = _mm_set1_ps(pos);
+        const __m128 factorv = _mm_set1_ps(factor);
+        const __m128 phasesv = _mm_set1_ps((float) k_sincPhases);
+
+        for (int i = 0; i < outFrames; ++i)
+        {
+            __m128 tv = _mm_add_ps(posv, _mm_mul_ps(iv, factorv));
+            __m128i t0v = _mm_cvttps_epi32(tv);
+            __m128 phasev = _mm_mul_ps(_mm_sub_ps(tv, _mm_cvtepi32_ps(t0v)), phasesv);
+            __m128i phase0v = _mm_cvttps_epi32(phasev);
+            __m128 fracv = _mm_sub_ps(phasev, _mm_cvtepi32_ps(phase0v));
+            int t0 = _mm_cvtsi128_si32(t0v);
+            int phase0 = _mm_cvtsi128_si32(phase0v);
+            iv = _mm_add_ps(iv, onev);
+
+            const float* coef = table + phase0 * k_sincTaps * 2;
+            const float* delta = coef + k_sincTaps;
+            const float* pIn = inBuf + t0 * 2;
+
+            // accumulate L R L R
+            __m128 sum0 = _mm_setzero_ps();
+            __m128 sum1 = _mm_setzero_ps();
+            for (int j = 0; j < k_sincTaps; j += 4)
+            {
+                __m128 c = _mm_add_ps(_mm_loadu_ps(coef + j), _mm_mul_ps(fracv, _mm_loadu_ps(delta + j)));
+                __m128 c01 = _mm_unpacklo_ps(c, c); // c0 c0 c1 c1
+                __m128 c23 = _mm_unpackhi_ps(c, c); // c2 c2 c3 c3
+                sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(pIn + j*2), c01));
+                sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(pIn + j*2 + 4), c23));
+            }
+
+            sum0 = _mm_add_ps(sum0, sum1);
+            sum0 = _mm_add_ps(sum0, _mm_movehl_ps(sum0, sum0));
+            _mm_storel_pi((__m64*) (outBuf + i*2), sum0);
+        }
+    }
+
     ////////////////////////////////////////
     // clamp
 
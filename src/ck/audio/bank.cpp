@@ -5,12 +5,19 @@
 #include "ck/core/asyncloader.h"
 #include "ck/core/debug.h"
 #include "ck/core/memoryfixup.h"
+#if !CK_PLATFORM_WP8
+#  include "ck/core/filemapping.h"
+#endif
+#include "ck/core/filestream.h"
 #include "ck/core/logger.h"
 #include "ck/core/path.h"
 #include "ck/core/thread.h"
 #include "ck/audio/fileheader.h"
 #include "ck/audio/audiograph.h"
 #include "ck/audio/bank.h"
+#include "ck/audio/soundindex.h"
+#include "ck/audio/decodecache.h"
+#include "ck/core/atomic.h"
 
 #include "ck/core/listable.cpp" // template definition
 #include "ck/core/proxied.cpp" // template definition
@@ -33,6 +40,11 @@ void Bank::destroy()
 
     // remove from list
     Listable<Bank>::destroy();
+    if (m_indexed)
+    {
+        SoundIndex::remove(this);
+        m_indexed = false;
+    }
 
     // unload all sounds
     BankSound* sound = NULL;
@@ -41,6 +53,7 @@ void Bank::destroy()
         sound->unload();
         m_sounds.remove(sound);
     }
+    DecodeCache::removeBank(this);
 
     AudioGraph::get()->deleteObject(this);
     AudioGraph::get()->free(m_buf);
@@ -107,52 +120,41 @@ const Sample* Bank::findSample(const char* name) const
 {
     CK_ASSERT(m_loaded);
     CK_ASSERT(!isFailed());
-    return m_data->findSample(name);
+    updateIndex();
+    int index = m_index.find(*m_data, name);
+    return (index >= 0 ? &m_data->getSample(index) : NULL);
+}
+
+const Sample* Bank::findSample(uint32 hash) const
+{
+    CK_ASSERT(m_loaded);
+    CK_ASSERT(!isFailed());
+    updateIndex();
+    int index = m_index.find(hash);
+    return (index >= 0 ? &m_data->getSample(index) : NULL);
 }
 
 Bank* Bank::find(const char* name)
 {
-    // TODO use hashtable to speed up this search
-    Bank* bank = Listable<Bank>::getFirst();
-    while (bank)
+    updateIndex();
+    Bank* bank = SoundIndex::findBank(name);
+    if (!bank)
     {
-        if (bank->isLoaded() && !bank->isFailed())
-        {
-            if (bank->m_data->getName() == name)
-            {
-                return bank;
-            }
-        }
-        bank = ((List<Bank>::Node*) bank)->getNext();
+        CK_LOG_INFO("Could not find bank named \"%s\"", name);
     }
-    CK_LOG_INFO("Could not find bank named \"%s\"", name);
-    return NULL;
+    return bank;
 }
 
 const Sample* Bank::findSample(const char* name, Bank** bankOut)
 {
-    Bank* bank = Listable<Bank>::getFirst();
-    while (bank)
-    {
-        if (bank->isLoaded() && !bank->isFailed())
-        {
-            const Sample* sample = bank->findSample(name);
-            if (sample)
-            {
-                if (bankOut)
-                {
-                    *bankOut = bank;
-                }
-                return sample;
-            }
-        }
-        bank = ((List<Bank>::Node*) bank)->getNext();
-    }
-    if (bankOut)
-    {
-        *bankOut = NULL;
-    }
-    return NULL;
+    updateIndex();
+    return SoundIndex::findSample(SoundName::hash(name), name, bankOut);
+}
+
+const Sample* Bank::findSample(uint32 hash, Bank** bankOut)
+{
+    updateIndex();
+    return SoundIndex::findSample(hash, NULL, bankOut);
 }
 
 Bank* Bank::newBank(const char* path, CkPathType pathType, int offset, int length)
@@ -241,6 +243,58 @@ Bank* Bank::newBankFromMemory(void* buf, int bytes)
     return bank;
 }
 
+Bank* Bank::newBankMapped(const char* path, CkPathType pathType, int offset, int length)
+{
+#if !CK_PLATFORM_WP8
+    // Custom file handlers and Android assets have no file to map.
+    bool mappable = !ReadStream::hasFileHandler();
+#  if CK_PLATFORM_ANDROID
+    mappable = mappable && (pathType != kCkPathType_Asset);
+#  endif
+
+    if (mappable)
+    {
+        Path fullPath(path, pathType);
+        int fileSize = FileStream::getSize(fullPath.getBuffer());
+        if (fileSize < 0)
+        {
+            CK_LOG_ERROR("Bank file \"%s\" could not be opened", fullPath.getBuffer());
+            return NULL;
+        }
+        if (offset < 0 || offset >= fileSize)
+        {
+            CK_LOG_ERROR("Invalid offset %d for bank file \"%s\"", offset, fullPath.getBuffer());
+            return NULL;
+        }
+        if (length <= 0)
+        {
+            length = fileSize - offset;
+        }
+        if (length > fileSize - offset)
+        {
+            CK_LOG_ERROR("Invalid length %d for bank file \"%s\"", length, fullPath.getBuffer());
+            return NULL;
+        }
+
+        FileMapping* mapping = new FileMapping(fullPath.getBuffer(), offset, length);
+        if (mapping && mapping->isValid())
+        {
+            Bank* bank = Bank::create(mapping);
+            if (!bank)
+            {
+                CK_LOG_ERROR("Bank from file \"%s\" could not be processed", fullPath.getBuffer());
+                delete mapping;
+            }
+            return bank;
+        }
+        delete mapping;
+    }
+#endif
+
+    CK_LOG_INFO("Bank file \"%s\" could not be memory-mapped; loading it instead", Path(path, pathType).getBuffer());
+    return newBank(path, pathType, offset, length);
+}
+
 void Bank::addSound(BankSound* sound)
 {
     m_sounds.addFirst(sound);
@@ -264,11 +318,15 @@ void Bank::destroyAll()
 
 ////////////////////////////////////////
 
-Bank::Bank(BankData* data, void* buf, int size) :
+Bank::Bank(BankData* data, void* buf, int size, FileMapping* mapping) :
     m_data(data),
     m_buf(buf),
     m_size(size),
-    m_loaded(true)
+    m_mapping(mapping),
+    m_loaded(true),
+    m_indexed(false),
+    m_index(),
+    m_serial(s_nextSerial++)
 {
 }
 
@@ -276,7 +334,11 @@ Bank::Bank(void* buf, int offset, int size, const char* path, CkPathType pathTyp
     m_data(NULL),
     m_buf(buf),
     m_size(size),
-    m_loaded(false)
+    m_mapping(NULL),
+    m_loaded(false),
+    m_indexed(false),
+    m_index(),
+    m_serial(s_nextSerial++)
 {
     bool loading = AsyncLoader::get()->load(path, pathType, buf, offset, size, asyncLoadCallback, this);
     if (!loading)
@@ -285,6 +347,14 @@ Bank::Bank(void* buf, int offset, int size, const char* path, CkPathType pathTyp
     }
 }
 
+Bank::~Bank()
+{
+#if !CK_PLATFORM_WP8
+    // deleted only after the audio thread is done with the sample data
+    delete m_mapping;
+#endif
+}
+
 void Bank::asyncLoadCallback(bool result, void* data)
 {
     Bank* bank = (Bank*) data;
@@ -297,7 +367,13 @@ void Bank::onAsyncLoad(bool result)
     CK_ASSERT(!m_data);
     if (result)
     {
-        m_data = process(m_buf, m_size);
+        const void* extra;
+        int extraBytes;
+        m_data = process(m_buf, m_size, extra, extraBytes);
+        if (m_data)
+        {
+            m_index.attach(*m_data, extra, extraBytes);
+        }
     }
     else
     {
@@ -310,11 +386,44 @@ void Bank::onAsyncLoad(bool result)
     __sync_synchronize();
 #endif
     m_loaded = true;
+
+    // this is called on the loader thread; the main thread adds it to the SoundIndex
+    Atomic::storeRelease(&s_indexPending, (int32) 1);
 }
 
-BankData* Bank::process(void* buf, int size)
+void Bank::addToIndex()
 {
-    BufferStream bs(buf, size, size);
+    CK_ASSERT(m_loaded && m_data && !m_indexed);
+    if (!m_index.isValid())
+    {
+        // bank was built without a name index
+        if (!m_index.build(*m_data))
+        {
+            return;
+        }
+    }
+    SoundIndex::add(this);
+    m_indexed = true;
+}
+
+void Bank::updateIndex()
+{
+    if (Atomic::loadAcquire(&s_indexPending))
+    {
+        s_indexPending = 0;
+        for (Bank* bank = Listable<Bank>::getFirst(); bank; bank = ((List<Bank>::Node*) bank)->getNext())
+        {
+            if (bank->m_loaded && bank->m_data && !bank->m_indexed)
+            {
+                bank->addToIndex();
+            }
+        }
+    }
+}
+
+int Bank::readHeader(const void* buf, int size)
+{
+    BufferStream bs((void*) buf, size, size);
     SwapStream swapper(bs);
 
     FileHeader fileHeader;
@@ -323,17 +432,17 @@ BankData* Bank::process(void* buf, int size)
     if ((fileHeader.marker != FileHeader::k_marker))
     {
         CK_LOG_ERROR("Invalid file marker: \"%.4s\" (expecting \"%.4s\")", fileHeader.marker.getData(), FileHeader::k_marker.getData());
-        return NULL;
+        return -1;
     }
     if (!(fileHeader.targets & Target::k_current))
     {
         CK_LOG_ERROR("Invalid file target mask: %x (does not include current target %x)", fileHeader.targets, Target::k_current);
-        return NULL;
+        return -1;
     }
     if (fileHeader.fileType != FileType::k_bank)
     {
         CK_LOG_ERROR("Invalid file type: %d (expecting %d)", fileHeader.fileType, FileType::k_bank);
-        return NULL;
+        return -1;
     }
     if (fileHeader.fileVersion != FileHeader::k_version)
     {
@@ -346,12 +455,24 @@ BankData* Bank::process(void* buf, int size)
         {
             CK_LOG_ERROR(" You may need to rebuild your banks with the latest version of cktool.");
         }
+        return -1;
+    }
+
+    return bs.getPos();
+}
+
+BankData* Bank::process(void* buf, int size, const void*& extra, int& extraBytes)
+{
+    int headerSize = readHeader(buf, size);
+    if (headerSize < 0)
+    {
         return NULL;
     }
 
-    byte* bankBuf = (byte*) buf + bs.getPos();
+    byte* bankBuf = (byte*) buf + headerSize;
     BankData* bankData = (BankData*) (bankBuf);
-    MemoryFixup fixup(bankBuf, bs.getSize() - bs.getPos());
+    int bankSize = size - headerSize;
+    MemoryFixup fixup(bankBuf, bankSize);
     fixup.fixup(*bankData);
     if (fixup.isFailed())
     {
@@ -360,23 +481,41 @@ BankData* Bank::process(void* buf, int size)
     }
     else
     {
+        getExtra(bankBuf, bankSize, fixup.getPos(), extra, extraBytes);
         return bankData;
     }
 }
 
+void Bank::getExtra(const byte* bankBuf, int bankSize, int pos, const void*& extra, int& extraBytes)
+{
+    // anything after the sample data (e.g. the name index) starts 4-byte aligned
+    pos = (pos + 3) & ~3;
+    if (pos < bankSize)
+    {
+        extra = bankBuf + pos;
+        extraBytes = bankSize - pos;
+    }
+    else
+    {
+        extra = NULL;
+        extraBytes = 0;
+    }
+}
+
 Bank* Bank::create(void* buf, int size, bool external)
 {
-    BankData* bankData = process(buf, size);
+    const void* extra;
+    int extraBytes;
+    BankData* bankData = process(buf, size, extra, extraBytes);
     if (bankData)
     {
-        if (external)
-        {
-            return new Bank(bankData, NULL, 0);
-        }
-        else
+        Bank* bank = (external ? new Bank(bankData, NULL, 0) : new Bank(bankData, buf, size));
+        if (bank)
         {
-            return new Bank(bankData, buf, size);
+            bank->m_index.attach(*bankData, extra, extraBytes);
+            bank->addToIndex();
         }
+        return bank;
     }
     else
     {
@@ -407,6 +546,69 @@ Bank* Bank::create(BinaryStream& stream, int offset, int length)
     return NULL;
 }
 
+#if !CK_PLATFORM_WP8
+Bank* Bank::create(FileMapping* mapping)
+{
+    const byte* image = (const byte*) mapping->getData();
+    int size = mapping->getSize();
+
+    int headerSize = readHeader(image, size);
+    if (headerSize < 0)
+    {
+        return NULL;
+    }
+
+    // The mapping is read-only, so copy the bank data and sample table (which
+    // come before the sample data) to fix them up; the samples will point
+    // into the mapping.
+    const byte* bankImage = image + headerSize;
+    int bankSize = size - headerSize;
+    if (bankSize < (int) sizeof(BankData))
+    {
+        CK_LOG_ERROR("Corrupted or truncated bank data");
+        return NULL;
+    }
+    int numSamples = ((const BankData*) bankImage)->getNumSamples();
+    if (numSamples < 0 || numSamples > (bankSize - (int) sizeof(BankData)) / (int) sizeof(Sample))
+    {
+        CK_LOG_ERROR("Corrupted or truncated bank data");
+        return NULL;
+    }
+    int tableSize = sizeof(BankData) + numSamples * sizeof(Sample);
+
+    void* buf = Mem::alloc(tableSize);
+    if (!buf)
+    {
+        return NULL;
+    }
+    Mem::copy(buf, bankImage, tableSize);
+
+    BankData* bankData = (BankData*) buf;
+    MemoryFixup fixup(buf, tableSize, bankImage, bankSize);
+    fixup.fixup(*bankData);
+    if (fixup.isFailed())
+    {
+        CK_LOG_ERROR("Corrupted or truncated bank data");
+        Mem::free(buf);
+        return NULL;
+    }
+
+    Bank* bank = new Bank(bankData, buf, tableSize, mapping);
+    if (bank)
+    {
+        const void* extra;
+        int extraBytes;
+        getExtra(bankImage, bankSize, fixup.getPos(), extra, extraBytes);
+        bank->m_index.attach(*bankData, extra, extraBytes);
+        bank->addToIndex();
+    }
+    return bank;
+}
+#endif
+
+int Bank::s_nextSerial = 0;
+volatile int32 Bank::s_indexPending = 0;
+
 
 template class Proxied<Bank>;
 
@@ -8,12 +8,14 @@
 #include "ck/core/deletable.h"
 #include "ck/audio/bankdata.h"
 #include "ck/audio/banksound.h"
+#include "ck/audio/sampleindex.h"
 #include "ck/pathtype.h"
 
 namespace Cki
 {
 
 class BinaryStream;
+class FileMapping;
 
 class Bank : 
     public CkBank,
@@ -34,13 +36,20 @@ public:
 
     const Sample& getSample(int index) const;
     const Sample* findSample(const char*) const;
+    const Sample* findSample(uint32 hash) const;
+
+    const BankData& getBankData() const { return *m_data; }
+    const SampleIndex& getIndex() const { return m_index; }
+    int getSerial() const { return m_serial; } // later banks have higher serial numbers
 
     static Bank* find(const char* name);
     static const Sample* findSample(const char* name, Bank** bank);
+    static const Sample* findSample(uint32 hash, Bank** bank);
 
     static Bank* newBank(const char* path, CkPathType, int offset, int length);
     static Bank* newBankAsync(const char* path, CkPathType, int offset, int length);
     static Bank* newBankFromMemory(void*, int bytes);
+    static Bank* newBankMapped(const char* path, CkPathType, int offset, int length);
 
     void addSound(BankSound*);
     void removeSound(BankSound*);
@@ -54,19 +63,33 @@ private:
     BankData* m_data;
     void* m_buf; // NULL if memory is managed externally
     int m_size;
+    FileMapping* m_mapping; // sample data, if mapped from the file
     bool m_loaded;
+    bool m_indexed; // in the SoundIndex
+    SampleIndex m_index;
+    int m_serial;
     List<BankSound> m_sounds;
 
-    Bank(BankData* data, void* buf, int size);
+    static int s_nextSerial;
+    static volatile int32 s_indexPending; // an async bank has loaded since the last updateIndex()
+
+    Bank(BankData* data, void* buf, int size, FileMapping* mapping = NULL);
+    ~Bank();
     Bank(void* buf, int offset, int size, const char* path, CkPathType);
 
-    static BankData* process(void* buf, int size);
+    static int readHeader(const void* buf, int size); // returns header size, or -1
+    static BankData* process(void* buf, int size, const void*& extra, int& extraBytes);
+    static void getExtra(const byte* bankBuf, int bankSize, int pos, const void*& extra, int& extraBytes);
+
+    void addToIndex();
+    static void updateIndex();
 
     static void asyncLoadCallback(bool result, void* data);
     void onAsyncLoad(bool result);
 
     static Bank* create(void* buf, int size, bool external);
     static Bank* create(BinaryStream&, int offset, int length);
+    static Bank* create(FileMapping*);
 
 };
 
@@ -33,9 +33,14 @@ const Sample& BankData::getSample(int i) const
     return m_samples[i];
 }
 
+Sample& BankData::getSample(int i)
+{
+    return m_samples[i];
+}
+
 const Sample* BankData::findSample(const char* name) const
 {
-    // TODO use hashtable to speed up this search
+    // linear search; Bank uses its SampleIndex instead
     for (int i = 0; i < m_samples.getSize(); ++i)
     {
         if (m_samples[i].name == name)
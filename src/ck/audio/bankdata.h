@@ -23,6 +23,7 @@ public:
 
     int getNumSamples() const;
     const Sample& getSample(int i) const;
+    Sample& getSample(int i);
     const Sample* findSample(const char* name) const;
 
     void addSample(const Sample&);
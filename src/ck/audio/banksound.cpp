@@ -2,6 +2,7 @@
 #include "ck/audio/bank.h"
 #include "ck/audio/sample.h"
 #include "ck/audio/audiograph.h"
+#include "ck/audio/decodecache.h"
 #include "ck/core/debug.h"
 #include "ck/core/logger.h"
 
@@ -10,10 +11,12 @@ namespace Cki
 
 
 BankSound::BankSound(const Sample& sample, Bank* bank) :
+    m_sample(sample),
     m_source(sample),
     m_bank(bank)
 {
     subInit(&m_source);
+    setName(sample.name.getBuffer());
     bank->addSound(this);
 }
 
@@ -37,7 +40,7 @@ void BankSound::unload()
     removePrevSounds();
 }
 
-void BankSound::play()
+void BankSound::playAt(int64 time)
 {
     if (!m_bank)
     {
@@ -45,18 +48,24 @@ void BankSound::play()
     }
     else
     {
-        GraphSound::play();
+        GraphSound::playAt(time);
     }
 }
 
+DecodeCache::Entry* BankSound::acquireCached()
+{
+    return DecodeCache::acquire(m_sample, m_bank);
+}
+
 void BankSound::setPlayPosition(int frame)
 {
-    AudioGraph::get()->execute(&m_sourceNode, SourceNode::k_setPlayPosition, frame);
+    // frame and ms positions replace each other, so they share a key
+    AudioGraph::get()->executeCoalesced(&m_sourceNode, SourceNode::k_setPlayPosition, frame, 0, SourceNode::k_setPlayPosition);
 }
 
 void BankSound::setPlayPositionMs(float ms)
 {
-    AudioGraph::get()->execute(&m_sourceNode, SourceNode::k_setPlayPositionMs, ms);
+    AudioGraph::get()->executeCoalesced(&m_sourceNode, SourceNode::k_setPlayPositionMs, ms, 0, SourceNode::k_setPlayPosition);
 }
 
 
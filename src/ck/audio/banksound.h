@@ -20,14 +20,18 @@ public:
 
     virtual void destroy();
 
-    virtual void play();
+    virtual void playAt(int64 time);
 
     virtual void setPlayPosition(int);
     virtual void setPlayPositionMs(float);
 
     void unload();
 
+protected:
+    virtual DecodeCache::Entry* acquireCached();
+
 private:
+    const Sample& m_sample;
     BufferSource m_source;
     Bank* m_bank;
 };
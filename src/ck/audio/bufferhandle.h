@@ -1,29 +1,27 @@
 #pragma once
 
 #include "ck/core/platform.h"
-#include "ck/audio/sharedbuffer.h"
 
 namespace Cki
 {
 
 
+// A buffer from a ScratchArena.  Copying or releasing a handle does not affect
+// the buffer, which stays valid until the arena is reset or rewound past it.
+
 class BufferHandle
 {
 public:
-    BufferHandle(); // invalid
-    BufferHandle(SharedBuffer*);
-
-    ~BufferHandle();
-    BufferHandle(const BufferHandle&);
-    BufferHandle& operator=(const BufferHandle&);
+    BufferHandle() : m_mem(NULL) {} // invalid
+    explicit BufferHandle(void* mem) : m_mem(mem) {}
 
-    bool isValid() const   { return (m_buf != NULL); }
-    void* get()   { return (m_buf ? m_buf->getMem() : NULL); }
+    bool isValid() const   { return (m_mem != NULL); }
+    void* get()   { return m_mem; }
 
-    void release();
+    void release()   { m_mem = NULL; }
 
 private:
-    SharedBuffer* m_buf;
+    void* m_mem;
 };
 
 
@@ -1,8 +1,11 @@
 #include "ck/audio/buffersource.h"
 #include "ck/audio/sample.h"
+#include "ck/audio/audioformat.h"
+#include "ck/audio/lossless.h"
 #include "ck/core/debug.h"
 #include "ck/core/math.h"
 #include "ck/core/logger.h"
+#include "ck/core/mem.h"
 #include <memory.h>
 
 namespace Cki
@@ -11,7 +14,11 @@ namespace Cki
 
 BufferSource::BufferSource(const Sample& sample) :
     m_sampleInfo(sample.info),
-    m_stream((void*) sample.data, sample.dataSize, sample.dataSize),
+    m_data(sample.data),
+    m_blockOffsets(NULL),
+    m_numBlocks(sample.info.blocks),
+    m_numFrames(sample.info.blocks * sample.info.blockFrames),
+    m_block(0),
     m_loopCount((int) sample.info.loopCount),
     m_loopCurrent(0),
     m_loopStart((int) sample.info.loopStart),
@@ -19,30 +26,49 @@ BufferSource::BufferSource(const Sample& sample) :
     m_releaseLoop(false)
 {
     CK_ASSERT(sample.data);
-    CK_ASSERT(sample.dataSize == sample.info.blocks * sample.info.blockBytes);
+    if (sample.info.format == AudioFormat::k_lossless)
+    {
+        int tableBytes = Lossless::getTableBytes(sample.info.blocks);
+        CK_ASSERT((int) sample.dataSize >= tableBytes);
+        m_blockOffsets = sample.data + sample.dataSize - tableBytes;
+        if (m_numBlocks > 0)
+        {
+            // the last block is padded
+            m_numFrames -= sample.info.blockFrames - Lossless::getLastBlockFrames(m_blockOffsets, m_numBlocks);
+        }
+    }
+    else
+    {
+        CK_ASSERT(sample.dataSize == sample.info.blocks * sample.info.blockBytes);
+    }
 }
 
 int BufferSource::read(void* buf, int blocks)
 {
-    int bytes = blocks * m_sampleInfo.blockBytes;
+    byte* out = (byte*) buf;
+    int blocksRead = 0;
     if (!m_releaseLoop && (m_loopCount < 0 || m_loopCurrent < m_loopCount))
     {
-        int endBlock = m_stream.getSize() / m_sampleInfo.blockBytes;
+        int endBlock = m_numBlocks;
         int loopStartBlock = Math::clamp(Math::round((float) m_loopStart / m_sampleInfo.blockFrames), 0, endBlock-1);
-        int loopEndBlock = m_loopEnd < 0 ? endBlock : Math::clamp(Math::round((float) m_loopEnd / m_sampleInfo.blockFrames), 1, endBlock);
+        int loopEndBlock = (m_loopEnd < 0 || m_loopEnd >= m_numFrames) ? endBlock : Math::clamp(Math::round((float) m_loopEnd / m_sampleInfo.blockFrames), 1, endBlock);
         if (loopEndBlock <= loopStartBlock)
         {
             loopEndBlock = loopStartBlock + 1;
         }
 
-        int bytesRead = 0;
-        while (bytesRead < bytes)
+        while (blocksRead < blocks)
         {
-            int bytesToRead = Math::min(bytes - bytesRead, loopEndBlock * m_sampleInfo.blockBytes - m_stream.getPos());
-            bytesRead += m_stream.read((byte*) buf + bytesRead, bytesToRead);
-            if (m_stream.getPos() >= loopEndBlock * m_sampleInfo.blockBytes)
+            int blocksToRead = Math::min(blocks - blocksRead, loopEndBlock - m_block);
+            int bytes = copyBlocks(out, blocksToRead);
+            if (out)
             {
-                m_stream.setPos(loopStartBlock * m_sampleInfo.blockBytes);
+                out += bytes;
+            }
+            blocksRead += Math::max(blocksToRead, 0);
+            if (m_block >= loopEndBlock)
+            {
+                m_block = loopStartBlock;
                 ++m_loopCurrent;
             }
             if (m_loopCount >= 0 && m_loopCurrent >= m_loopCount)
@@ -50,34 +76,40 @@ int BufferSource::read(void* buf, int blocks)
                 break;
             }
         }
-        return bytesRead / m_sampleInfo.blockBytes;
     }
     else
     {
-        return m_stream.read(buf, bytes) / m_sampleInfo.blockBytes;
+        int blocksToRead = Math::min(blocks, m_numBlocks - m_block);
+        copyBlocks(out, blocksToRead);
+        blocksRead = Math::max(blocksToRead, 0);
     }
+    return blocksRead;
 }
 
 int BufferSource::getNumBlocks() const
 {
-    CK_ASSERT(m_stream.getSize() % m_sampleInfo.blockBytes == 0);
-    return m_stream.getSize() / m_sampleInfo.blockBytes;
+    return m_numBlocks;
+}
+
+int BufferSource::getNumFrames() const
+{
+    return m_numFrames;
 }
 
 void BufferSource::setBlockPos(int block)
 {
-    m_stream.setPos(block * m_sampleInfo.blockBytes);
+    CK_ASSERT(block >= 0);
+    m_block = block;
 }
 
 int BufferSource::getBlockPos() const
 {
-    CK_ASSERT(m_stream.getPos() % m_sampleInfo.blockBytes == 0);
-    return m_stream.getPos() / m_sampleInfo.blockBytes;
+    return m_block;
 }
 
 void BufferSource::reset()
 {
-    m_stream.setPos(0);
+    m_block = 0;
     m_loopCurrent = 0;
     m_releaseLoop = false;
 }
@@ -110,7 +142,7 @@ bool BufferSource::isFailed() const
 bool BufferSource::isDone() const
 {
     bool looping = !m_releaseLoop && (m_loopCount < 0 || m_loopCurrent < m_loopCount);
-    return !looping && m_stream.isAtEnd();
+    return !looping && m_block >= m_numBlocks;
 }
 
 void BufferSource::setLoop(int loopStart, int loopEnd)
@@ -145,4 +177,38 @@ void BufferSource::releaseLoop()
     m_releaseLoop = true;
 }
 
+////////////////////////////////////////
+
+int BufferSource::getBlockOffset(int block) const
+{
+    if (m_blockOffsets)
+    {
+        // the blocks end where the table starts
+        return block < m_numBlocks ? Lossless::getBlockOffset(m_blockOffsets, block) : (int) (m_blockOffsets - m_data);
+    }
+    else
+    {
+        return block * m_sampleInfo.blockBytes;
+    }
+}
+
+// Copy blocks from the current position (unless buf is NULL), and advance past
+// them; returns the number of bytes copied.
+int BufferSource::copyBlocks(byte* buf, int blocks)
+{
+    if (blocks <= 0)
+    {
+        return 0;
+    }
+    CK_ASSERT(m_block + blocks <= m_numBlocks);
+    int offset = getBlockOffset(m_block);
+    int bytes = getBlockOffset(m_block + blocks) - offset;
+    if (buf)
+    {
+        Mem::copy(buf, m_data + offset, bytes);
+    }
+    m_block += blocks;
+    return bytes;
+}
+
 }
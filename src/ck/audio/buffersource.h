@@ -1,7 +1,6 @@
 #pragma once
 
 #include "ck/core/platform.h"
-#include "ck/core/bufferstream.h"
 #include "ck/audio/audiosource.h"
 #include "ck/audio/sampleinfo.h"
 
@@ -17,6 +16,7 @@ public:
 
     virtual int read(void* buf, int blocks);
     virtual int getNumBlocks() const;
+    virtual int getNumFrames() const;
     virtual void setBlockPos(int block);
     virtual int getBlockPos() const;
 
@@ -39,12 +39,19 @@ public:
 
 private:
     const SampleInfo& m_sampleInfo;
-    BufferStream m_stream;
+    const byte* m_data;
+    const byte* m_blockOffsets; // table of block offsets, for variable-size blocks; otherwise NULL
+    int m_numBlocks;
+    int m_numFrames;
+    int m_block;
     int m_loopCount; // total number of repeats; 0 = play once, -1 = play infinite
     int m_loopCurrent; // number of repeats 
     int m_loopStart;
     int m_loopEnd;
     bool m_releaseLoop;
+
+    int getBlockOffset(int block) const;
+    int copyBlocks(byte* buf, int blocks);
 };
 
 
@@ -0,0 +1,139 @@
+#include "ck/audio/cacheddecoder.h"
+#include "ck/audio/audiosource.h"
+#include "ck/core/debug.h"
+#include "ck/core/math.h"
+#include "ck/core/mem.h"
+
+
+namespace Cki
+{
+
+
+CachedDecoder::CachedDecoder(AudioSource& source, DecodeCache::Entry* entry) :
+    Decoder(source),
+    m_entry(entry),
+    m_block(-1),
+    m_frameOffset(0),
+    m_sourceBlock(-1)
+{
+}
+
+CachedDecoder::~CachedDecoder()
+{
+    DecodeCache::release(m_entry);
+}
+
+int CachedDecoder::decode(int32* buf, int frames)
+{
+    return decodeImpl(buf, frames);
+}
+
+int CachedDecoder::decode(float* buf, int frames)
+{
+    return decodeImpl(buf, frames);
+}
+
+int CachedDecoder::skip(float* buf, int frames)
+{
+    return decodeImpl((float*) NULL, frames);
+}
+
+template <typename T> 
+int CachedDecoder::decodeImpl(T* buf, int frames)
+{
+    if (m_block >= 0 && !isBlockValid())
+    {
+        // source was reset or moved since the block was read
+        m_block = -1;
+        m_frameOffset = 0;
+    }
+
+    if (isDone())
+    {
+        return 0;
+    }
+    else
+    {
+        const SampleInfo& info = m_source.getSampleInfo();
+        int channels = info.channels;
+        const T* data = (const T*) m_entry->getData();
+
+        int framesCopied = 0;
+        T* out = buf;
+        while (framesCopied < frames)
+        {
+            if (m_block < 0)
+            {
+                // advance the source past the block; its data is not needed
+                int block = m_source.getBlockPos();
+                if (m_source.read(NULL, 1) == 0)
+                {
+                    break;
+                }
+                m_block = block;
+                m_sourceBlock = m_source.getBlockPos();
+            }
+
+            int blockFrames = getBlockFrames(m_block);
+            int framesToCopy = Math::clamp(blockFrames - m_frameOffset, 0, frames - framesCopied);
+            if (out)
+            {
+                const T* in = data + (m_block * info.blockFrames + m_frameOffset) * channels;
+                Mem::copy(out, in, framesToCopy * channels * sizeof(T));
+                out += framesToCopy * channels;
+            }
+            framesCopied += framesToCopy;
+
+            m_frameOffset += framesToCopy;
+            if (m_frameOffset >= blockFrames)
+            {
+                m_block = -1;
+                m_frameOffset = 0;
+            }
+        }
+
+        return framesCopied;
+    }
+}
+
+bool CachedDecoder::isDone() const
+{
+    return m_source.isDone() && !isBlockValid();
+}
+
+void CachedDecoder::setFramePos(int frame)
+{
+    int blockFrames = m_source.getSampleInfo().blockFrames;
+    int block = frame / blockFrames;
+    m_source.setBlockPos(block);
+    m_block = -1;
+    m_frameOffset = frame - (block * blockFrames);
+}
+
+int CachedDecoder::getFramePos() const
+{
+    int blockFrames = m_source.getSampleInfo().blockFrames;
+    if (isBlockValid())
+    {
+        return m_block * blockFrames + m_frameOffset;
+    }
+    else
+    {
+        return m_source.getBlockPos() * blockFrames + (m_block >= 0 ? 0 : m_frameOffset);
+    }
+}
+
+int CachedDecoder::getNumFrames() const
+{
+    return m_source.getNumFrames();
+}
+
+////////////////////////////////////////
+
+bool CachedDecoder::isBlockValid() const
+{
+    return m_block >= 0 && m_source.getBlockPos() == m_sourceBlock;
+}
+
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/audio/decoder.h"
+#include "ck/audio/decodecache.h"
+
+namespace Cki
+{
+
+class AudioSource;
+
+// Plays already-decoded data from the DecodeCache.  The source is still
+// advanced a block at a time, so that it keeps track of position and loops,
+// but its data is neither copied nor decoded.
+class CachedDecoder : public Decoder
+{
+public:
+    CachedDecoder(AudioSource&, DecodeCache::Entry*);
+    virtual ~CachedDecoder();
+
+    virtual int decode(int32* buf, int frames);
+    virtual int decode(float* buf, int frames);
+    virtual int skip(float* buf, int frames);
+    virtual bool isDone() const;
+    virtual void setFramePos(int frame);
+    virtual int getFramePos() const;
+    virtual int getNumFrames() const;
+
+private:
+    DecodeCache::Entry* m_entry;
+    int m_block; // block being played, or -1 if none
+    int m_frameOffset; // offset of next frame in m_block, or in the next block if none
+    int m_sourceBlock; // source position after m_block was read; if it changes, m_block is stale
+
+    bool isBlockValid() const;
+    template <typename T> int decodeImpl(T* buf, int frames); // if buf is NULL, nothing is copied
+};
+
+
+}
@@ -1,6 +1,7 @@
 #include "ck/audio/cksaudiostream.h"
 #include "ck/audio/fileheader.h"
 #include "ck/audio/filetype.h"
+#include "ck/audio/audioformat.h"
 #include "ck/core/swapstream.h"
 #include "ck/core/debug.h"
 #include "ck/core/logger.h"
@@ -61,6 +62,13 @@ void CksAudioStream::init()
         }
 
         stream >> m_sampleInfo;
+        if (m_sampleInfo.format == AudioFormat::k_lossless)
+        {
+            // stream data is read a fixed number of bytes per block
+            CK_LOG_ERROR("Lossless format is only supported for bank sounds");
+            m_failed = true;
+            return;
+        }
         m_dataPos = m_subStream.getPos();
     }
 }
@@ -11,7 +11,8 @@ CksStreamSound::CksStreamSound(const char* path, CkPathType pathType, int offset
     m_stream(path, pathType, offset, length),
     m_source(&m_stream)
 {
-    subInit(&m_source);
+    subInitStream(&m_source);
+    setName(Path(path, pathType).getLeaf());
 }
 
 }
@@ -0,0 +1,128 @@
+#include "ck/audio/commandtimeline.h"
+#include "ck/audio/commandobject.h"
+#include "ck/core/debug.h"
+#include "ck/core/mem.h"
+
+namespace Cki
+{
+
+
+CommandTimeline::CommandTimeline(int capacity) :
+    m_heap(NULL),
+    m_count(0),
+    m_capacity(capacity),
+    m_seq(0)
+{
+    m_heap = (Entry*) Mem::alloc(sizeof(Entry) * m_capacity);
+}
+
+CommandTimeline::~CommandTimeline()
+{
+    Mem::free(m_heap);
+}
+
+bool CommandTimeline::add(int64 time, CommandObject* obj, int commandId, CommandParam value0, CommandParam value1)
+{
+    if (m_count >= m_capacity)
+    {
+        return false;
+    }
+
+    Entry& e = m_heap[m_count];
+    e.time = time;
+    e.seq = m_seq++;
+    e.obj = obj;
+    e.commandId = commandId;
+    e.value0 = value0;
+    e.value1 = value1;
+    siftUp(m_count++);
+    return true;
+}
+
+void CommandTimeline::cancel(CommandObject* obj)
+{
+    int count = 0;
+    for (int i = 0; i < m_count; ++i)
+    {
+        if (m_heap[i].obj != obj)
+        {
+            m_heap[count++] = m_heap[i];
+        }
+    }
+
+    if (count < m_count)
+    {
+        m_count = count;
+        for (int i = m_count/2 - 1; i >= 0; --i)
+        {
+            siftDown(i);
+        }
+    }
+}
+
+int CommandTimeline::execute(int64 time, int maxFrames)
+{
+    while (m_count > 0 && m_heap[0].time <= time)
+    {
+        // remove it before executing, in case the command adds or cancels others
+        Entry e = m_heap[0];
+        m_heap[0] = m_heap[--m_count];
+        siftDown(0);
+
+        e.obj->execute(e.commandId, e.value0, e.value1);
+    }
+
+    if (m_count > 0 && m_heap[0].time - time < maxFrames)
+    {
+        return (int) (m_heap[0].time - time);
+    }
+    return maxFrames;
+}
+
+void CommandTimeline::siftUp(int i)
+{
+    Entry e = m_heap[i];
+    while (i > 0)
+    {
+        int parent = (i - 1) / 2;
+        if (!(e < m_heap[parent]))
+        {
+            break;
+        }
+        m_heap[i] = m_heap[parent];
+        i = parent;
+    }
+    m_heap[i] = e;
+}
+
+void CommandTimeline::siftDown(int i)
+{
+    if (i >= m_count)
+    {
+        return;
+    }
+
+    Entry e = m_heap[i];
+    for (;;)
+    {
+        int child = 2*i + 1;
+        if (child >= m_count)
+        {
+            break;
+        }
+        if (child + 1 < m_count && m_heap[child + 1] < m_heap[child])
+        {
+            ++child;
+        }
+        if (!(m_heap[child] < e))
+        {
+            break;
+        }
+        m_heap[i] = m_heap[child];
+        i = child;
+    }
+    m_heap[i] = e;
+}
+
+
+}
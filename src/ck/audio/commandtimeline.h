@@ -0,0 +1,66 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/core/types.h"
+#include "ck/audio/commandparam.h"
+
+namespace Cki
+{
+
+class CommandObject;
+
+
+// Commands waiting to be executed at a given sample time of the output.
+// The output splits its render quanta at the times of these commands, so each
+// one takes effect at exactly its frame.  Commands with the same time are
+// executed in the order they were added.
+// Audio thread only; never allocates after construction.
+class CommandTimeline
+{
+public:
+    CommandTimeline(int capacity);
+    ~CommandTimeline();
+
+    // Returns false if the timeline is full.
+    bool add(int64 time, CommandObject*, int commandId, CommandParam value0, CommandParam value1);
+
+    // Discards all commands for the object.
+    void cancel(CommandObject*);
+
+    // Executes the commands due at or before the given time, and returns the
+    // number of frames (at most maxFrames) until the next one.
+    int execute(int64 time, int maxFrames);
+
+    bool isEmpty() const { return m_count == 0; }
+
+private:
+    struct Entry
+    {
+        int64 time;
+        uint32 seq;
+        CommandObject* obj;
+        int commandId;
+        CommandParam value0;
+        CommandParam value1;
+
+        bool operator<(const Entry& other) const
+        {
+            // seq wraps, so compare the difference
+            return time < other.time || (time == other.time && (int32) (seq - other.seq) < 0);
+        }
+    };
+
+    Entry* m_heap; // binary min-heap by time, then seq
+    int m_count;
+    int m_capacity;
+    uint32 m_seq;
+
+    void siftUp(int);
+    void siftDown(int);
+
+    CommandTimeline(const CommandTimeline&);
+    CommandTimeline& operator=(const CommandTimeline&);
+};
+
+
+}
@@ -0,0 +1,450 @@
+#include "ck/audio/compressorprocessor.h"
+#include "ck/audio/audioutil.h"
+#include "ck/effectparam.h"
+#include "ck/core/atomic.h"
+#include "ck/core/math.h"
+#include "ck/core/mem.h"
+#include "ck/core/debug.h"
+#include "ck/core/logger.h"
+
+namespace Cki
+{
+
+
+namespace
+{
+    const float k_minThresholdDb = -60.0f;
+    const float k_maxRatio = 1000.0f;
+    const float k_minLookaheadMs = 0.0f;
+    const float k_maxLookaheadMs = 20.0f;
+    const float k_minReleaseMs = 1.0f;
+    const float k_maxReleaseMs = 5000.0f;
+    const float k_maxMakeupDb = 40.0f;
+
+    const CompressorProcessor::Kernels k_kernelsDefault = { CompressorProcessor::detect_default, CompressorProcessor::gain_default, CompressorProcessor::apply_default };
+
+    inline float dbToGain(float dB)
+    {
+        return Math::pow(10.0f, dB / 20.0f);
+    }
+
+    union FloatBits
+    {
+        float f;
+        int32 i;
+    };
+}
+
+
+CompressorProcessor::CompressorProcessor() :
+    m_thresholdDb(-12.0f),
+    m_ratio(4.0f),
+    m_lookaheadMs(5.0f),
+    m_releaseMs(100.0f),
+    m_makeupDb(0.0f),
+    m_truePeak(false),
+    m_lookaheadChanged(false),
+    m_threshold(1.0f),
+    m_slope(0.0f),
+    m_releaseCoef(0.0f),
+    m_makeup(1.0f),
+    m_curMakeup(1.0f),
+    m_lookahead(1),
+    m_maxLookahead(1),
+    m_mem(NULL),
+    m_delay(NULL),
+    m_delaySize(0),
+    m_delayWritePos(0),
+    m_detectLeft(NULL),
+    m_detectRight(NULL),
+    m_gain(NULL),
+    m_minFrame(NULL),
+    m_minGain(NULL),
+    m_minSize(0),
+    m_minHead(0),
+    m_minCount(0),
+    m_frame(0),
+    m_release(1.0f),
+    m_avgBuf(NULL),
+    m_avgPos(0),
+    m_avgSum(0.0),
+    m_gainReduction(0)
+{
+    // Interpolation filters for true-peak detection: Hann-windowed sinc, at
+    // 1/4, 1/2, and 3/4 of the way to the next frame, normalized for unity
+    // gain at DC.
+    for (int phase = 0; phase < 3; ++phase)
+    {
+        float* fir = m_fir + phase * k_detectTaps;
+        float offset = (phase + 1) * 0.25f;
+        float sum = 0.0f;
+        for (int i = 0; i < k_detectTaps; ++i)
+        {
+            float x = (i - k_detectBefore) - offset;
+            float sinc = Math::sin(Math::k_pi * x) / (Math::k_pi * x);
+            float window = 0.5f + 0.5f * Math::cos(Math::k_pi * x / (k_detectAfter + 0.5f));
+            fir[i] = sinc * window;
+            sum += fir[i];
+        }
+        for (int i = 0; i < k_detectTaps; ++i)
+        {
+            fir[i] /= sum;
+        }
+    }
+
+    m_maxLookahead = Math::max((int) (k_maxLookaheadMs * getSampleRate() / 1000.0f), 1);
+    m_delaySize = m_maxLookahead + k_detectAfter + k_blockFrames;
+    m_minSize = m_maxLookahead + 1;
+
+    // one allocation for all buffers
+    int detectFrames = k_detectTaps - 1 + k_blockFrames;
+    int bytes =
+        m_delaySize * 2 * sizeof(float) +
+        detectFrames * 2 * sizeof(float) +
+        k_blockFrames * sizeof(float) +
+        m_minSize * (sizeof(int) + sizeof(float)) +
+        m_maxLookahead * sizeof(float);
+
+    m_mem = (float*) Mem::alloc(bytes);
+    if (!m_mem)
+    {
+        return;
+    }
+
+    float* p = m_mem;
+    m_delay = p;
+    p += m_delaySize * 2;
+    m_detectLeft = p;
+    p += detectFrames;
+    m_detectRight = p;
+    p += detectFrames;
+    m_gain = p;
+    p += k_blockFrames;
+    m_minGain = p;
+    p += m_minSize;
+    m_avgBuf = p;
+    p += m_maxLookahead;
+    m_minFrame = (int*) p;
+
+    m_lookahead = getLookaheadFrames();
+    updateParams();
+    reset();
+}
+
+CompressorProcessor::~CompressorProcessor()
+{
+    Mem::free(m_mem);
+}
+
+void CompressorProcessor::setParam(int paramId, float value)
+{
+    switch (paramId)
+    {
+        case kCkCompressorParam_Threshold:
+            m_thresholdDb = Math::clamp(value, k_minThresholdDb, 0.0f);
+            break;
+
+        case kCkCompressorParam_Ratio:
+            m_ratio = Math::clamp(value, 1.0f, k_maxRatio);
+            break;
+
+        case kCkCompressorParam_LookaheadMs:
+            m_lookaheadMs = Math::clamp(value, k_minLookaheadMs, k_maxLookaheadMs);
+            m_lookaheadChanged = true;
+            break;
+
+        case kCkCompressorParam_ReleaseMs:
+            m_releaseMs = Math::clamp(value, k_minReleaseMs, k_maxReleaseMs);
+            break;
+
+        case kCkCompressorParam_MakeupGain:
+            m_makeupDb = Math::clamp(value, 0.0f, k_maxMakeupDb);
+            break;
+
+        case kCkCompressorParam_TruePeak:
+            m_truePeak = (value != 0.0f);
+            break;
+
+        default:
+            CK_LOG_ERROR("Compressor effect: unknown param ID %d", paramId);
+            return;
+    }
+
+    updateParams();
+}
+
+void CompressorProcessor::reset()
+{
+    if (!m_mem)
+    {
+        return;
+    }
+
+    Mem::clear(m_delay, m_delaySize * 2 * sizeof(float));
+    m_delayWritePos = 0;
+    Mem::clear(m_detectLeft, (k_detectTaps - 1) * sizeof(float));
+    Mem::clear(m_detectRight, (k_detectTaps - 1) * sizeof(float));
+    m_release = 1.0f;
+    m_curMakeup = m_makeup;
+    resetGain();
+    Atomic::storeRelease(&m_gainReduction, (int32) 0);
+}
+
+float CompressorProcessor::getGainReduction() const
+{
+    FloatBits bits;
+    bits.i = Atomic::loadAcquire(&m_gainReduction);
+    return bits.f;
+}
+
+void CompressorProcessor::process_default(int* inBuf, int* outBuf, int frames)
+{
+    processFixed(inBuf, frames, k_kernelsDefault, AudioUtil::convertI32toF32_default, AudioUtil::convertF32toI32_default);
+}
+
+void CompressorProcessor::process_default(float* inBuf, float* outBuf, int frames)
+{
+    processFloat(inBuf, frames, k_kernelsDefault);
+}
+
+void CompressorProcessor::detect_default(const float* left, const float* right, const float* fir, bool truePeak, float* peak, int frames)
+{
+    for (int i = 0; i < frames; ++i)
+    {
+        float p = Math::max(Math::abs(left[i + k_detectBefore]), Math::abs(right[i + k_detectBefore]));
+        if (truePeak)
+        {
+            for (int phase = 0; phase < 3; ++phase)
+            {
+                const float* coefs = fir + phase * k_detectTaps;
+                float l = 0.0f;
+                float r = 0.0f;
+                for (int j = 0; j < k_detectTaps; ++j)
+                {
+                    l += coefs[j] * left[i + j];
+                    r += coefs[j] * right[i + j];
+                }
+                p = Math::max(p, Math::max(Math::abs(l), Math::abs(r)));
+            }
+        }
+        peak[i] = p;
+    }
+}
+
+void CompressorProcessor::gain_default(float* peak, float threshold, float slope, int frames)
+{
+    for (int i = 0; i < frames; ++i)
+    {
+        float p = peak[i];
+        peak[i] = (p > threshold ? Math::pow(p / threshold, slope) : 1.0f);
+    }
+}
+
+void CompressorProcessor::apply_default(const float* in, const float* gain, float* out, int frames)
+{
+    for (int i = 0; i < frames; ++i)
+    {
+        out[2*i] = in[2*i] * gain[i];
+        out[2*i + 1] = in[2*i + 1] * gain[i];
+    }
+}
+
+////////////////////////////////////////
+
+void CompressorProcessor::processFloat(float* buf, int frames, const Kernels& kernels)
+{
+    if (!m_mem)
+    {
+        return;
+    }
+
+    if (m_lookaheadChanged)
+    {
+        m_lookaheadChanged = false;
+        int lookahead = getLookaheadFrames();
+        if (lookahead != m_lookahead)
+        {
+            m_lookahead = lookahead;
+            resetGain();
+        }
+    }
+
+    float minGain = 1.0f;
+    while (frames > 0)
+    {
+        int n = Math::min(frames, (int) k_blockFrames);
+        minGain = Math::min(minGain, processBlock(buf, n, kernels));
+        buf += n * 2;
+        frames -= n;
+    }
+
+    FloatBits bits;
+    bits.f = (minGain < 1.0f ? -20.0f * Math::log10(minGain) : 0.0f);
+    Atomic::storeRelease(&m_gainReduction, bits.i);
+}
+
+void CompressorProcessor::processFixed(int32* buf, int frames, const Kernels& kernels,
+        void (*toFloat)(const int32*, float*, int), void (*toFixed)(const float*, int32*, int))
+{
+    // convert in place
+    float* floatBuf = (float*) buf;
+    toFloat(buf, floatBuf, frames * 2);
+    processFloat(floatBuf, frames, kernels);
+    toFixed(floatBuf, buf, frames * 2);
+}
+
+float CompressorProcessor::processBlock(float* buf, int frames, const Kernels& kernels)
+{
+    // planar input for detection, after the history
+    const int history = k_detectTaps - 1;
+    for (int i = 0; i < frames; ++i)
+    {
+        m_detectLeft[history + i] = buf[2*i];
+        m_detectRight[history + i] = buf[2*i + 1];
+    }
+
+    // gain for each frame, k_detectAfter frames back
+    kernels.detect(m_detectLeft, m_detectRight, m_fir, m_truePeak, m_gain, frames);
+    kernels.gain(m_gain, m_threshold, m_slope, frames);
+    float minGain = smoothGain(m_gain, frames);
+
+    for (int i = 0; i < history; ++i)
+    {
+        m_detectLeft[i] = m_detectLeft[frames + i];
+        m_detectRight[i] = m_detectRight[frames + i];
+    }
+
+    // write the input to the delay line
+    int n = Math::min(frames, m_delaySize - m_delayWritePos);
+    Mem::copy(m_delay + m_delayWritePos * 2, buf, n * 2 * sizeof(float));
+    if (n < frames)
+    {
+        Mem::copy(m_delay, buf + n * 2, (frames - n) * 2 * sizeof(float));
+    }
+
+    // The gain for the frame at m_gain[i] reaches its target after the hold
+    // and average windows, when it is applied to frame i + m_lookahead - 1.
+    int delay = m_lookahead - 1 + k_detectAfter;
+    int readPos = m_delayWritePos - delay;
+    if (readPos < 0)
+    {
+        readPos += m_delaySize;
+    }
+    n = Math::min(frames, m_delaySize - readPos);
+    kernels.apply(m_delay + readPos * 2, m_gain, buf, n);
+    if (n < frames)
+    {
+        kernels.apply(m_delay, m_gain + n, buf + n * 2, frames - n);
+    }
+
+    m_delayWritePos += frames;
+    if (m_delayWritePos >= m_delaySize)
+    {
+        m_delayWritePos -= m_delaySize;
+    }
+
+    return minGain;
+}
+
+float CompressorProcessor::smoothGain(float* gain, int frames)
+{
+    const int window = m_lookahead;
+    const double avgScale = 1.0 / window;
+    float minGain = 1.0f;
+
+    for (int i = 0; i < frames; ++i)
+    {
+        float g = gain[i];
+
+        // minimum over the window
+        while (m_minCount > 0)
+        {
+            int back = m_minHead + m_minCount - 1;
+            if (back >= m_minSize)
+            {
+                back -= m_minSize;
+            }
+            if (m_minGain[back] < g)
+            {
+                break;
+            }
+            --m_minCount;
+        }
+        int tail = m_minHead + m_minCount;
+        if (tail >= m_minSize)
+        {
+            tail -= m_minSize;
+        }
+        m_minGain[tail] = g;
+        m_minFrame[tail] = m_frame;
+        ++m_minCount;
+        if ((int) ((uint32) m_frame - (uint32) m_minFrame[m_minHead]) >= window)
+        {
+            if (++m_minHead == m_minSize)
+            {
+                m_minHead = 0;
+            }
+            --m_minCount;
+        }
+        float held = m_minGain[m_minHead];
+        ++m_frame;
+
+        // release; never above the held gain, so the average is never above
+        // the gain of any frame in the window
+        m_release = (held < m_release ? held : held + m_releaseCoef * (m_release - held));
+
+        // average over the window
+        m_avgSum += m_release - m_avgBuf[m_avgPos];
+        m_avgBuf[m_avgPos] = m_release;
+        if (++m_avgPos == window)
+        {
+            m_avgPos = 0;
+        }
+
+        gain[i] = (float) (m_avgSum * avgScale);
+        minGain = Math::min(minGain, gain[i]);
+    }
+
+    // makeup gain, ramped over the block when it changes
+    if (m_curMakeup != m_makeup || m_makeup != 1.0f)
+    {
+        float step = (m_makeup - m_curMakeup) / frames;
+        for (int i = 0; i < frames; ++i)
+        {
+            m_curMakeup += step;
+            gain[i] *= m_curMakeup;
+        }
+        m_curMakeup = m_makeup;
+    }
+
+    return minGain;
+}
+
+void CompressorProcessor::resetGain()
+{
+    // the windows start out full of the current released gain
+    m_minHead = 0;
+    m_minCount = 0;
+    for (int i = 0; i < m_lookahead; ++i)
+    {
+        m_avgBuf[i] = m_release;
+    }
+    m_avgPos = 0;
+    m_avgSum = (double) m_release * m_lookahead;
+}
+
+int CompressorProcessor::getLookaheadFrames()
+{
+    return Math::clamp((int) (m_lookaheadMs * getSampleRate() / 1000.0f), 1, m_maxLookahead);
+}
+
+void CompressorProcessor::updateParams()
+{
+    m_threshold = dbToGain(m_thresholdDb);
+    m_slope = (m_ratio >= k_maxRatio ? -1.0f : 1.0f / m_ratio - 1.0f); // the largest ratio is infinite
+    m_releaseCoef = Math::exp(-1000.0f / (m_releaseMs * getSampleRate()));
+    m_makeup = dbToGain(m_makeupDb);
+}
+
+
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/core/types.h"
+#include "ck/audio/effectprocessor.h"
+
+namespace Cki
+{
+
+
+// Look-ahead compressor/limiter, with stereo-linked peak detection.
+//
+// The gain is computed for each frame from its peak level, then held at the
+// minimum over the look-ahead window, released, and averaged over the window.
+// The audio is delayed by the look-ahead time, so the gain has fully come down
+// by the time a peak is output: with a high ratio, the output never exceeds
+// the threshold (plus makeup gain).  The attack time is the look-ahead time.
+//
+// With true-peak detection, peaks between samples are estimated by 4x
+// oversampling with short interpolation filters, so the output also stays
+// below the threshold after it is converted to analog.
+//
+// Peak detection, the gain computer, and applying the gain are SIMD kernels;
+// the window minimum and release, which are recursive, are scalar.
+class CompressorProcessor : public EffectProcessor
+{
+public:
+    CompressorProcessor();
+    virtual ~CompressorProcessor();
+
+    bool isInited() const { return m_mem != NULL; }
+
+    virtual void setParam(int paramId, float value);
+    virtual void reset();
+    virtual bool isInPlace() const { return true; }
+
+    virtual void process_default(int* inBuf, int* outBuf, int frames);
+    virtual void process_neon(int* inBuf, int* outBuf, int frames);
+    virtual void process_sse(int* inBuf, int* outBuf, int frames);
+    virtual void process_default(float* inBuf, float* outBuf, int frames);
+    virtual void process_neon(float* inBuf, float* outBuf, int frames);
+    virtual void process_sse(float* inBuf, float* outBuf, int frames);
+
+    // Gain reduction (in dB, 0 or more) of the most recently processed audio;
+    // can be called from any thread.
+    float getGainReduction() const;
+
+    enum { k_blockFrames = 64 };
+
+    // Frames of history before, and after, the frame a peak is detected for.
+    enum { k_detectBefore = 3 };
+    enum { k_detectAfter = 4 };
+    enum { k_detectTaps = k_detectBefore + 1 + k_detectAfter };
+
+    // For each frame i, writes to peak[i] the largest absolute value of either
+    // channel at frame i + k_detectBefore of left and right (which are planar),
+    // or, if truePeak, between it and the next frame, using the interpolation
+    // filters in fir (3 phases of k_detectTaps coefficients).
+    typedef void (*DetectFunc)(const float* left, const float* right, const float* fir, bool truePeak, float* peak, int frames);
+
+    // Replaces each peak value with its gain: 1 at or below the threshold,
+    // and (peak/threshold)^slope above it.
+    typedef void (*GainFunc)(float* peak, float threshold, float slope, int frames);
+
+    // Multiplies each stereo frame of in by its gain, and writes it to out.
+    typedef void (*ApplyFunc)(const float* in, const float* gain, float* out, int frames);
+
+    static void detect_default(const float* left, const float* right, const float* fir, bool truePeak, float* peak, int frames);
+    static void detect_neon(const float* left, const float* right, const float* fir, bool truePeak, float* peak, int frames);
+    static void detect_sse(const float* left, const float* right, const float* fir, bool truePeak, float* peak, int frames);
+    static void gain_default(float* peak, float threshold, float slope, int frames);
+    static void gain_neon(float* peak, float threshold, float slope, int frames);
+    static void gain_sse(float* peak, float threshold, float slope, int frames);
+    static void apply_default(const float* in, const float* gain, float* out, int frames);
+    static void apply_neon(const float* in, const float* gain, float* out, int frames);
+    static void apply_sse(const float* in, const float* gain, float* out, int frames);
+
+    // the SIMD variants to use
+    struct Kernels
+    {
+        DetectFunc detect;
+        GainFunc gain;
+        ApplyFunc apply;
+    };
+
+private:
+    // parameter values, as set
+    float m_thresholdDb;
+    float m_ratio;
+    float m_lookaheadMs;
+    float m_releaseMs;
+    float m_makeupDb;
+    bool m_truePeak;
+    bool m_lookaheadChanged;
+
+    // derived from the above
+    float m_threshold;
+    float m_slope;
+    float m_releaseCoef;
+    float m_makeup;      // target
+    float m_curMakeup;   // ramps toward m_makeup over each block
+    int m_lookahead;     // frames; also the length of the hold and average windows
+    int m_maxLookahead;
+
+    float m_fir[3 * k_detectTaps];
+
+    float* m_mem;
+
+    // input delay line (interleaved stereo)
+    float* m_delay;
+    int m_delaySize;     // frames
+    int m_delayWritePos;
+
+    // planar input for detection, with history
+    float* m_detectLeft;
+    float* m_detectRight;
+    float* m_gain;       // k_blockFrames
+
+    // sliding window minimum: a queue of frames whose gain is less than that of
+    // every later frame in the window
+    int* m_minFrame;
+    float* m_minGain;
+    int m_minSize;
+    int m_minHead;
+    int m_minCount;
+    int m_frame;
+
+    float m_release;     // release filter state
+
+    // moving average of the released gain
+    float* m_avgBuf;
+    int m_avgPos;
+    double m_avgSum;
+
+    volatile int32 m_gainReduction; // float bits, published to other threads
+
+    void processFloat(float* buf, int frames, const Kernels&);
+    void processFixed(int32* buf, int frames, const Kernels&,
+            void (*toFloat)(const int32*, float*, int), void (*toFixed)(const float*, int32*, int));
+    // these return the smallest gain, before makeup gain
+    float processBlock(float* buf, int frames, const Kernels&);
+    float smoothGain(float* gain, int frames);
+    void resetGain();
+    int getLookaheadFrames();
+    void updateParams();
+};
+
+
+}
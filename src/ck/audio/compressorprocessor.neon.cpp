@@ -0,0 +1,153 @@
+#include "ck/audio/compressorprocessor.h"
+#include "ck/audio/audioutil.h"
+#include "ck/core/debug.h"
+
+#if CK_ARM_NEON
+#  include <arm_neon.h>
+#endif
+
+namespace Cki
+{
+
+
+#if CK_ARM_NEON
+namespace
+{
+    const CompressorProcessor::Kernels k_kernelsNeon = { CompressorProcessor::detect_neon, CompressorProcessor::gain_neon, CompressorProcessor::apply_neon };
+
+    // log2(x) for x > 0: the exponent, plus log2 of the mantissa (scaled to
+    // [sqrt(1/2), sqrt(2)]) from the series for ln((1+s)/(1-s)).
+    inline float32x4_t log2_4(float32x4_t x)
+    {
+        int32x4_t bits = vreinterpretq_s32_f32(x);
+        int32x4_t e = vsubq_s32(vshrq_n_s32(bits, 23), vdupq_n_s32(127));
+        float32x4_t m = vreinterpretq_f32_s32(vorrq_s32(vandq_s32(bits, vdupq_n_s32(0x007fffff)), vdupq_n_s32(0x3f800000)));
+
+        uint32x4_t big = vcgtq_f32(m, vdupq_n_f32(1.41421356f));
+        m = vbslq_f32(big, vmulq_f32(m, vdupq_n_f32(0.5f)), m);
+        float32x4_t ef = vaddq_f32(vcvtq_f32_s32(e), vbslq_f32(big, vdupq_n_f32(1.0f), vdupq_n_f32(0.0f)));
+
+        // (m - 1)/(m + 1), with a refined reciprocal estimate
+        float32x4_t one = vdupq_n_f32(1.0f);
+        float32x4_t den = vaddq_f32(m, one);
+        float32x4_t rcp = vrecpeq_f32(den);
+        rcp = vmulq_f32(rcp, vrecpsq_f32(den, rcp));
+        rcp = vmulq_f32(rcp, vrecpsq_f32(den, rcp));
+        float32x4_t s = vmulq_f32(vsubq_f32(m, one), rcp);
+
+        float32x4_t s2 = vmulq_f32(s, s);
+        float32x4_t p = vdupq_n_f32(1.0f / 9.0f);
+        p = vaddq_f32(vmulq_f32(p, s2), vdupq_n_f32(1.0f / 7.0f));
+        p = vaddq_f32(vmulq_f32(p, s2), vdupq_n_f32(1.0f / 5.0f));
+        p = vaddq_f32(vmulq_f32(p, s2), vdupq_n_f32(1.0f / 3.0f));
+        p = vaddq_f32(vmulq_f32(p, s2), one);
+        // 2/ln(2)
+        return vaddq_f32(ef, vmulq_f32(vmulq_f32(p, s), vdupq_n_f32(2.88539008f)));
+    }
+
+    // 2^y for y in [-126, 0]: 2 to the nearest integer, times the Taylor
+    // series for the rest.
+    inline float32x4_t exp2_4(float32x4_t y)
+    {
+        y = vmaxq_f32(y, vdupq_n_f32(-126.0f));
+        int32x4_t n = vcvtq_s32_f32(vsubq_f32(y, vdupq_n_f32(0.5f))); // rounds toward 0, so nearest for y <= 0
+        float32x4_t f = vmulq_f32(vsubq_f32(y, vcvtq_f32_s32(n)), vdupq_n_f32(0.69314718f));
+        float32x4_t p = vdupq_n_f32(1.0f / 720.0f);
+        p = vaddq_f32(vmulq_f32(p, f), vdupq_n_f32(1.0f / 120.0f));
+        p = vaddq_f32(vmulq_f32(p, f), vdupq_n_f32(1.0f / 24.0f));
+        p = vaddq_f32(vmulq_f32(p, f), vdupq_n_f32(1.0f / 6.0f));
+        p = vaddq_f32(vmulq_f32(p, f), vdupq_n_f32(0.5f));
+        p = vaddq_f32(vmulq_f32(p, f), vdupq_n_f32(1.0f));
+        p = vaddq_f32(vmulq_f32(p, f), vdupq_n_f32(1.0f));
+        float32x4_t scale = vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(n, vdupq_n_s32(127)), 23));
+        return vmulq_f32(p, scale);
+    }
+}
+
+void CompressorProcessor::process_neon(int* inBuf, int* outBuf, int frames)
+{
+    processFixed(inBuf, frames, k_kernelsNeon, AudioUtil::convertI32toF32_neon, AudioUtil::convertF32toI32_neon);
+}
+
+void CompressorProcessor::process_neon(float* inBuf, float* outBuf, int frames)
+{
+    processFloat(inBuf, frames, k_kernelsNeon);
+}
+
+void CompressorProcessor::detect_neon(const float* left, const float* right, const float* fir, bool truePeak, float* peak, int frames)
+{
+    // 4 frames at a time, with the taps for each frame in the same lane
+    int i = 0;
+    for ( ; i + 4 <= frames; i += 4)
+    {
+        float32x4_t p = vmaxq_f32(vabsq_f32(vld1q_f32(left + i + k_detectBefore)), vabsq_f32(vld1q_f32(right + i + k_detectBefore)));
+        if (truePeak)
+        {
+            float32x4_t l[k_detectTaps];
+            float32x4_t r[k_detectTaps];
+            for (int j = 0; j < k_detectTaps; ++j)
+            {
+                l[j] = vld1q_f32(left + i + j);
+                r[j] = vld1q_f32(right + i + j);
+            }
+            for (int phase = 0; phase < 3; ++phase)
+            {
+                const float* coefs = fir + phase * k_detectTaps;
+                float32x4_t lSum = vmulq_n_f32(l[0], coefs[0]);
+                float32x4_t rSum = vmulq_n_f32(r[0], coefs[0]);
+                for (int j = 1; j < k_detectTaps; ++j)
+                {
+                    lSum = vmlaq_n_f32(lSum, l[j], coefs[j]);
+                    rSum = vmlaq_n_f32(rSum, r[j], coefs[j]);
+                }
+                p = vmaxq_f32(p, vmaxq_f32(vabsq_f32(lSum), vabsq_f32(rSum)));
+            }
+        }
+        vst1q_f32(peak + i, p);
+    }
+    detect_default(left + i, right + i, fir, truePeak, peak + i, frames - i);
+}
+
+void CompressorProcessor::gain_neon(float* peak, float threshold, float slope, int frames)
+{
+    // (peak/threshold)^slope = 2^(slope*(log2(peak) - log2(threshold)))
+    float32x4_t thresh = vdupq_n_f32(threshold);
+    float32x4_t thresh4 = log2_4(thresh);
+    float32x4_t s = vdupq_n_f32(slope);
+    float32x4_t one = vdupq_n_f32(1.0f);
+
+    int i = 0;
+    for ( ; i + 4 <= frames; i += 4)
+    {
+        float32x4_t p = vld1q_f32(peak + i);
+        uint32x4_t over = vcgtq_f32(p, thresh);
+        float32x4_t g = exp2_4(vmulq_f32(s, vsubq_f32(log2_4(vmaxq_f32(p, thresh)), thresh4)));
+        g = vminq_f32(g, one);
+        vst1q_f32(peak + i, vbslq_f32(over, g, one));
+    }
+    gain_default(peak + i, threshold, slope, frames - i);
+}
+
+void CompressorProcessor::apply_neon(const float* in, const float* gain, float* out, int frames)
+{
+    int i = 0;
+    for ( ; i + 4 <= frames; i += 4)
+    {
+        float32x4_t g = vld1q_f32(gain + i);
+        float32x4x2_t lr = vld2q_f32(in + 2*i);
+        lr.val[0] = vmulq_f32(lr.val[0], g);
+        lr.val[1] = vmulq_f32(lr.val[1], g);
+        vst2q_f32(out + 2*i, lr);
+    }
+    apply_default(in + 2*i, gain + i, out + 2*i, frames - i);
+}
+#else
+void CompressorProcessor::process_neon(int* inBuf, int* outBuf, int frames) {}
+void CompressorProcessor::process_neon(float* inBuf, float* outBuf, int frames) {}
+void CompressorProcessor::detect_neon(const float* left, const float* right, const float* fir, bool truePeak, float* peak, int frames) {}
+void CompressorProcessor::gain_neon(float* peak, float threshold, float slope, int frames) {}
+void CompressorProcessor::apply_neon(const float* in, const float* gain, float* out, int frames) {}
+#endif
+
+
+}
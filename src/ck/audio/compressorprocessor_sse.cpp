@@ -0,0 +1,158 @@
+#include "ck/audio/compressorprocessor.h"
+#include "ck/audio/audioutil.h"
+#include "ck/core/debug.h"
+
+#if CK_X86_SSE
+#  include <emmintrin.h>
+#endif
+
+namespace Cki
+{
+
+
+#if CK_X86_SSE
+namespace
+{
+    const CompressorProcessor::Kernels k_kernelsSse = { CompressorProcessor::detect_sse, CompressorProcessor::gain_sse, CompressorProcessor::apply_sse };
+
+    inline __m128 abs4(__m128 v)
+    {
+        return _mm_and_ps(v, _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff)));
+    }
+
+    // log2(x) for x > 0: the exponent, plus log2 of the mantissa (scaled to
+    // [sqrt(1/2), sqrt(2)]) from the series for ln((1+s)/(1-s)).
+    inline __m128 log2_4(__m128 x)
+    {
+        __m128i bits = _mm_castps_si128(x);
+        __m128i e = _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127));
+        __m128 m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)), _mm_set1_epi32(0x3f800000)));
+
+        __m128 big = _mm_cmpgt_ps(m, _mm_set1_ps(1.41421356f));
+        m = _mm_sub_ps(m, _mm_and_ps(big, _mm_mul_ps(m, _mm_set1_ps(0.5f))));
+        __m128 ef = _mm_add_ps(_mm_cvtepi32_ps(e), _mm_and_ps(big, _mm_set1_ps(1.0f)));
+
+        __m128 one = _mm_set1_ps(1.0f);
+        __m128 s = _mm_div_ps(_mm_sub_ps(m, one), _mm_add_ps(m, one));
+        __m128 s2 = _mm_mul_ps(s, s);
+        __m128 p = _mm_set1_ps(1.0f / 9.0f);
+        p = _mm_add_ps(_mm_mul_ps(p, s2), _mm_set1_ps(1.0f / 7.0f));
+        p = _mm_add_ps(_mm_mul_ps(p, s2), _mm_set1_ps(1.0f / 5.0f));
+        p = _mm_add_ps(_mm_mul_ps(p, s2), _mm_set1_ps(1.0f / 3.0f));
+        p = _mm_add_ps(_mm_mul_ps(p, s2), one);
+        // 2/ln(2)
+        return _mm_add_ps(ef, _mm_mul_ps(_mm_mul_ps(p, s), _mm_set1_ps(2.88539008f)));
+    }
+
+    // 2^y for y in [-126, 0]: 2 to the nearest integer, times the Taylor
+    // series for the rest.
+    inline __m128 exp2_4(__m128 y)
+    {
+        y = _mm_max_ps(y, _mm_set1_ps(-126.0f));
+        __m128i n = _mm_cvtps_epi32(y);
+        __m128 f = _mm_mul_ps(_mm_sub_ps(y, _mm_cvtepi32_ps(n)), _mm_set1_ps(0.69314718f));
+        __m128 p = _mm_set1_ps(1.0f / 720.0f);
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.0f / 120.0f));
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.0f / 24.0f));
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.0f / 6.0f));
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(0.5f));
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.0f));
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.0f));
+        __m128 scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23));
+        return _mm_mul_ps(p, scale);
+    }
+}
+
+void CompressorProcessor::process_sse(int* inBuf, int* outBuf, int frames)
+{
+    processFixed(inBuf, frames, k_kernelsSse, AudioUtil::convertI32toF32_sse, AudioUtil::convertF32toI32_sse);
+}
+
+void CompressorProcessor::process_sse(float* inBuf, float* outBuf, int frames)
+{
+    processFloat(inBuf, frames, k_kernelsSse);
+}
+
+void CompressorProcessor::detect_sse(const float* left, const float* right, const float* fir, bool truePeak, float* peak, int frames)
+{
+    // 4 frames at a time, with the taps for each frame in the same lane
+    __m128 c[3 * k_detectTaps];
+    for (int j = 0; j < 3 * k_detectTaps; ++j)
+    {
+        c[j] = _mm_set1_ps(fir[j]);
+    }
+
+    int i = 0;
+    for ( ; i + 4 <= frames; i += 4)
+    {
+        __m128 p = _mm_max_ps(abs4(_mm_loadu_ps(left + i + k_detectBefore)), abs4(_mm_loadu_ps(right + i + k_detectBefore)));
+        if (truePeak)
+        {
+            __m128 l[k_detectTaps];
+            __m128 r[k_detectTaps];
+            for (int j = 0; j < k_detectTaps; ++j)
+            {
+                l[j] = _mm_loadu_ps(left + i + j);
+                r[j] = _mm_loadu_ps(right + i + j);
+            }
+            for (int phase = 0; phase < 3; ++phase)
+            {
+                const __m128* coefs = c + phase * k_detectTaps;
+                __m128 lSum = _mm_mul_ps(coefs[0], l[0]);
+                __m128 rSum = _mm_mul_ps(coefs[0], r[0]);
+                for (int j = 1; j < k_detectTaps; ++j)
+                {
+                    lSum = _mm_add_ps(lSum, _mm_mul_ps(coefs[j], l[j]));
+                    rSum = _mm_add_ps(rSum, _mm_mul_ps(coefs[j], r[j]));
+                }
+                p = _mm_max_ps(p, _mm_max_ps(abs4(lSum), abs4(rSum)));
+            }
+        }
+        _mm_storeu_ps(peak + i, p);
+    }
+    detect_default(left + i, right + i, fir, truePeak, peak + i, frames - i);
+}
+
+void CompressorProcessor::gain_sse(float* peak, float threshold, float slope, int frames)
+{
+    // (peak/threshold)^slope = 2^(slope*(log2(peak) - log2(threshold)))
+    __m128 thresh = _mm_set1_ps(threshold);
+    __m128 thresh4 = log2_4(thresh);
+    __m128 s = _mm_set1_ps(slope);
+    __m128 one = _mm_set1_ps(1.0f);
+
+    int i = 0;
+    for ( ; i + 4 <= frames; i += 4)
+    {
+        __m128 p = _mm_loadu_ps(peak + i);
+        __m128 over = _mm_cmpgt_ps(p, thresh);
+        __m128 g = exp2_4(_mm_mul_ps(s, _mm_sub_ps(log2_4(_mm_max_ps(p, thresh)), thresh4)));
+        g = _mm_min_ps(g, one);
+        _mm_storeu_ps(peak + i, _mm_or_ps(_mm_and_ps(over, g), _mm_andnot_ps(over, one)));
+    }
+    gain_default(peak + i, threshold, slope, frames - i);
+}
+
+void CompressorProcessor::apply_sse(const float* in, const float* gain, float* out, int frames)
+{
+    int i = 0;
+    for ( ; i + 4 <= frames; i += 4)
+    {
+        __m128 g = _mm_loadu_ps(gain + i);
+        __m128 a = _mm_loadu_ps(in + 2*i);
+        __m128 b = _mm_loadu_ps(in + 2*i + 4);
+        _mm_storeu_ps(out + 2*i, _mm_mul_ps(a, _mm_unpacklo_ps(g, g)));
+        _mm_storeu_ps(out + 2*i + 4, _mm_mul_ps(b, _mm_unpackhi_ps(g, g)));
+    }
+    apply_default(in + 2*i, gain + i, out + 2*i, frames - i);
+}
+#else
+void CompressorProcessor::process_sse(int* inBuf, int* outBuf, int frames) {}
+void CompressorProcessor::process_sse(float* inBuf, float* outBuf, int frames) {}
+void CompressorProcessor::detect_sse(const float* left, const float* right, const float* fir, bool truePeak, float* peak, int frames) {}
+void CompressorProcessor::gain_sse(float* peak, float threshold, float slope, int frames) {}
+void CompressorProcessor::apply_sse(const float* in, const float* gain, float* out, int frames) {}
+#endif
+
+
+}
@@ -0,0 +1,69 @@
+#include "ck/audio/convolutionprocessor.h"
+#include "ck/core/debug.h"
+
+#if CK_X86_SSE
+
+// Only used if System::getSimdLevel() is kCkSimdLevel_Avx2; if the compiler
+// can't generate AVX2 code for this file, it calls the SSE version.
+
+#if CK_X86_AVX2
+
+#include <immintrin.h>
+
+namespace Cki
+{
+
+
+void ConvolutionProcessor::multiplyAdd_avx2(const float* aRe, const float* aIm, const float* bRe, const float* bIm, float* outRe, float* outIm, int bins)
+{
+    CK_ASSERT(bins % 8 == 0);
+    for (int i = 0; i < bins; i += 8)
+    {
+        __m256 ar = _mm256_loadu_ps(aRe + i);
+        __m256 ai = _mm256_loadu_ps(aIm + i);
+        __m256 br = _mm256_loadu_ps(bRe + i);
+        __m256 bi = _mm256_loadu_ps(bIm + i);
+
+        __m256 re = _mm256_loadu_ps(outRe + i);
+        __m256 im = _mm256_loadu_ps(outIm + i);
+        re = _mm256_fmadd_ps(ar, br, re);
+        re = _mm256_fnmadd_ps(ai, bi, re);
+        im = _mm256_fmadd_ps(ar, bi, im);
+        im = _mm256_fmadd_ps(ai, br, im);
+        _mm256_storeu_ps(outRe + i, re);
+        _mm256_storeu_ps(outIm + i, im);
+    }
+    _mm256_zeroupper();
+}
+
+
+}
+
+#else // CK_X86_AVX2
+
+namespace Cki
+{
+
+
+void ConvolutionProcessor::multiplyAdd_avx2(const float* aRe, const float* aIm, const float* bRe, const float* bIm, float* outRe, float* outIm, int bins)
+{
+    multiplyAdd_sse(aRe, aIm, bRe, bIm, outRe, outIm, bins);
+}
+
+
+}
+
+#endif // CK_X86_AVX2
+
+#else // CK_X86_SSE
+
+namespace Cki
+{
+
+
+void ConvolutionProcessor::multiplyAdd_avx2(const float* aRe, const float* aIm, const float* bRe, const float* bIm, float* outRe, float* outIm, int bins) {}
+
+
+}
+
+#endif // CK_X86_SSE
@@ -0,0 +1,349 @@
+#include "ck/audio/convolutionprocessor.h"
+#include "ck/audio/convolutionworker.h"
+#include "ck/audio/impulseresponse.h"
+#include "ck/audio/audioutil.h"
+#include "ck/effectparam.h"
+#include "ck/core/atomic.h"
+#include "ck/core/math.h"
+#include "ck/core/mem.h"
+#include "ck/core/debug.h"
+#include "ck/core/logger.h"
+
+// template definitions
+#include "ck/core/list.cpp"
+
+namespace Cki
+{
+
+
+namespace
+{
+    const Convolver::Kernels k_kernelsDefault = { ConvolutionProcessor::multiplyAdd_default, Fft::pass_default };
+}
+
+ConvolutionProcessor::ConvolutionProcessor(const ImpulseResponse& ir) :
+    m_head(k_headBlockFrames, ir, 0, Math::min(ir.getFrames(), (int) k_headFrames)),
+    m_tail(NULL),
+    m_mem(NULL),
+    m_gain(1.0f),
+    m_pos(0),
+    m_block(0),
+    m_gen(0),
+    m_tailGen(0),
+    m_inline(!ConvolutionWorker::get()->isThreaded()),
+    m_busy(false),
+    m_warned(false)
+{
+    if (ir.getFrames() > k_headFrames)
+    {
+        m_tail = new Convolver(k_tailBlockFrames, ir, k_headFrames, ir.getFrames());
+        if (m_tail && !m_tail->isInited())
+        {
+            delete m_tail;
+            m_tail = NULL;
+            return;
+        }
+    }
+
+    int floats = k_channels * 2 * k_headBlockFrames;
+    if (m_tail)
+    {
+        floats += k_channels * k_tailBlockFrames * (1 + 2 * k_tailSlots);
+    }
+    m_mem = (float*) Mem::alloc(floats * sizeof(float));
+    if (!m_mem)
+    {
+        return;
+    }
+    Mem::clear(m_mem, floats * sizeof(float));
+
+    float* p = m_mem;
+    for (int c = 0; c < k_channels; ++c)
+    {
+        m_headIn[c] = p;
+        p += k_headBlockFrames;
+        m_headOut[c] = p;
+        p += k_headBlockFrames;
+        m_tailIn[c] = NULL;
+    }
+    for (int i = 0; i < k_tailSlots; ++i)
+    {
+        TailSlot& slot = m_slots[i];
+        for (int c = 0; c < k_channels; ++c)
+        {
+            slot.in[c] = NULL;
+            slot.out[c] = NULL;
+        }
+        slot.block = -1;
+        slot.gen = -1;
+        slot.kernels = NULL;
+        slot.done = true;
+    }
+
+    if (m_tail)
+    {
+        for (int c = 0; c < k_channels; ++c)
+        {
+            m_tailIn[c] = p;
+            p += k_tailBlockFrames;
+            for (int i = 0; i < k_tailSlots; ++i)
+            {
+                m_slots[i].in[c] = p;
+                p += k_tailBlockFrames;
+                m_slots[i].out[c] = p;
+                p += k_tailBlockFrames;
+            }
+        }
+
+        ConvolutionWorker::get()->add(this);
+    }
+}
+
+ConvolutionProcessor::~ConvolutionProcessor()
+{
+    if (m_tail && m_mem)
+    {
+        ConvolutionWorker::get()->remove(this);
+    }
+    delete m_tail;
+    Mem::free(m_mem);
+}
+
+bool ConvolutionProcessor::isInited() const
+{
+    return m_head.isInited() && m_mem;
+}
+
+void ConvolutionProcessor::setParam(int paramId, float value)
+{
+    switch (paramId)
+    {
+        case kCkConvolutionReverbParam_Gain:
+            m_gain = Math::max(value, 0.0f);
+            break;
+
+        default:
+            CK_LOG_ERROR("Convolution Reverb effect: unknown param ID %d", paramId);
+            break;
+    }
+}
+
+void ConvolutionProcessor::reset()
+{
+    m_head.reset();
+    for (int c = 0; c < k_channels; ++c)
+    {
+        Mem::clear(m_headIn[c], k_headBlockFrames * sizeof(float));
+        Mem::clear(m_headOut[c], k_headBlockFrames * sizeof(float));
+    }
+    m_pos = 0;
+    m_block = 0;
+
+    // The worker may still be busy with tail blocks posted before now; they
+    // will be ignored, and the tail is reset before the next one (see runTail()).
+    Atomic::storeRelease(&m_gen, m_gen + 1);
+}
+
+void ConvolutionProcessor::process_default(int* inBuf, int* outBuf, int frames)
+{
+    processFixed(inBuf, frames, k_kernelsDefault, AudioUtil::convertI32toF32_default, AudioUtil::convertF32toI32_default);
+}
+
+void ConvolutionProcessor::process_default(float* inBuf, float* outBuf, int frames)
+{
+    processFloat(inBuf, frames, k_kernelsDefault);
+}
+
+void ConvolutionProcessor::multiplyAdd_default(const float* aRe, const float* aIm, const float* bRe, const float* bIm, float* outRe, float* outIm, int bins)
+{
+    for (int i = 0; i < bins; ++i)
+    {
+        float ar = aRe[i];
+        float ai = aIm[i];
+        float br = bRe[i];
+        float bi = bIm[i];
+        outRe[i] += ar*br - ai*bi;
+        outIm[i] += ar*bi + ai*br;
+    }
+}
+
+bool ConvolutionProcessor::hasTailWork() const
+{
+    for (int i = 0; i < k_tailSlots; ++i)
+    {
+        if (!Atomic::loadAcquire(&m_slots[i].done))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ConvolutionProcessor::processTail()
+{
+    // run posted blocks in order
+    for (;;)
+    {
+        int32 gen = Atomic::loadAcquire(&m_gen);
+        TailSlot* next = NULL;
+        for (int i = 0; i < k_tailSlots; ++i)
+        {
+            TailSlot& slot = m_slots[i];
+            if (!Atomic::loadAcquire(&slot.done))
+            {
+                if (slot.gen != gen)
+                {
+                    // posted before a reset; no longer needed
+                    Atomic::storeRelease(&slot.done, true);
+                }
+                else if (!next || slot.block < next->block)
+                {
+                    next = &slot;
+                }
+            }
+        }
+
+        if (!next)
+        {
+            break;
+        }
+        runTail(*next);
+    }
+}
+
+////////////////////////////////////////
+
+void ConvolutionProcessor::processFloat(float* buf, int frames, const Convolver::Kernels& kernels)
+{
+    float* p = buf;
+    while (frames > 0)
+    {
+        // take in the next part of the block, and put out the same part of
+        // the output from the last one
+        int n = Math::min(frames, k_headBlockFrames - m_pos);
+        float* in0 = m_headIn[0] + m_pos;
+        float* in1 = m_headIn[1] + m_pos;
+        const float* out0 = m_headOut[0] + m_pos;
+        const float* out1 = m_headOut[1] + m_pos;
+        for (int i = 0; i < n; ++i)
+        {
+            in0[i] = p[0];
+            in1[i] = p[1];
+            p[0] = out0[i] * m_gain;
+            p[1] = out1[i] * m_gain;
+            p += 2;
+        }
+
+        m_pos += n;
+        frames -= n;
+        if (m_pos == k_headBlockFrames)
+        {
+            processBlock(kernels);
+            m_pos = 0;
+        }
+    }
+}
+
+void ConvolutionProcessor::processFixed(int32* buf, int frames, const Convolver::Kernels& kernels,
+        void (*toFloat)(const int32*, float*, int), void (*toFixed)(const float*, int32*, int))
+{
+    // convert in place
+    float* floatBuf = (float*) buf;
+    toFloat(buf, floatBuf, frames * 2);
+    processFloat(floatBuf, frames, kernels);
+    toFixed(floatBuf, buf, frames * 2);
+}
+
+void ConvolutionProcessor::processBlock(const Convolver::Kernels& kernels)
+{
+    m_head.process(m_headIn, m_headOut, kernels);
+
+    if (m_tail)
+    {
+        // Tail block n covers the impulse response from 2 tail blocks in, so
+        // its output starts 2 tail blocks after its input.
+        int subBlock = m_block % k_blocksPerTailBlock;
+        int32 tailBlock = m_block / k_blocksPerTailBlock - 2;
+        if (tailBlock >= 0)
+        {
+            const TailSlot& slot = m_slots[tailBlock % k_tailSlots];
+            if (Atomic::loadAcquire(&slot.done) && slot.block == tailBlock && slot.gen == m_gen)
+            {
+                int offset = subBlock * k_headBlockFrames;
+                for (int c = 0; c < k_channels; ++c)
+                {
+                    AudioUtil::mix(slot.out[c] + offset, m_headOut[c], k_headBlockFrames);
+                }
+            }
+            else if (subBlock == 0)
+            {
+                warnLate();
+            }
+        }
+
+        for (int c = 0; c < k_channels; ++c)
+        {
+            Mem::copy(m_tailIn[c] + subBlock * k_headBlockFrames, m_headIn[c], k_headBlockFrames * sizeof(float));
+        }
+        if (subBlock == k_blocksPerTailBlock - 1)
+        {
+            postTail(m_block / k_blocksPerTailBlock, kernels);
+        }
+    }
+
+    ++m_block;
+}
+
+void ConvolutionProcessor::postTail(int32 tailBlock, const Convolver::Kernels& kernels)
+{
+    TailSlot& slot = m_slots[tailBlock % k_tailSlots];
+    if (!Atomic::loadAcquire(&slot.done))
+    {
+        // the worker is still busy with a block from long ago; skip this one
+        warnLate();
+        return;
+    }
+
+    for (int c = 0; c < k_channels; ++c)
+    {
+        Mem::copy(slot.in[c], m_tailIn[c], k_tailBlockFrames * sizeof(float));
+    }
+    slot.block = tailBlock;
+    slot.gen = m_gen;
+    slot.kernels = &kernels;
+
+    if (m_inline)
+    {
+        runTail(slot);
+    }
+    else
+    {
+        Atomic::storeRelease(&slot.done, false);
+        ConvolutionWorker::get()->wake();
+    }
+}
+
+void ConvolutionProcessor::runTail(TailSlot& slot)
+{
+    if (slot.gen != m_tailGen)
+    {
+        m_tail->reset();
+        m_tailGen = slot.gen;
+    }
+    m_tail->process(slot.in, slot.out, *slot.kernels);
+    Atomic::storeRelease(&slot.done, true);
+}
+
+void ConvolutionProcessor::warnLate()
+{
+    if (!m_warned)
+    {
+        CK_LOG_WARNING("Convolution reverb tail was not ready in time; part of the reverb will be missing.");
+        m_warned = true;
+    }
+}
+
+template class List<ConvolutionProcessor>;
+
+
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/core/types.h"
+#include "ck/core/list.h"
+#include "ck/audio/effectprocessor.h"
+#include "ck/audio/convolver.h"
+
+namespace Cki
+{
+
+class ImpulseResponse;
+
+
+// Convolution reverb.  The impulse response is split in two: the head is
+// convolved on the audio thread in short blocks, and the much longer tail is
+// convolved in long blocks by ConvolutionWorker.  The tail of each block isn't
+// needed until 2 long blocks later, which gives the worker time to finish.
+// Output is delayed by one short block (k_headBlockFrames).
+class ConvolutionProcessor : public EffectProcessor, public List<ConvolutionProcessor>::Node
+{
+public:
+    ConvolutionProcessor(const ImpulseResponse&);
+    virtual ~ConvolutionProcessor();
+
+    bool isInited() const;
+
+    virtual void setParam(int paramId, float value);
+    virtual void reset();
+    virtual bool isInPlace() const { return true; }
+
+    enum { k_headBlockFrames = 128 };
+
+    virtual void process_default(int* inBuf, int* outBuf, int frames);
+    virtual void process_neon(int* inBuf, int* outBuf, int frames);
+    virtual void process_sse(int* inBuf, int* outBuf, int frames);
+    virtual void process_default(float* inBuf, float* outBuf, int frames);
+    virtual void process_neon(float* inBuf, float* outBuf, int frames);
+    virtual void process_sse(float* inBuf, float* outBuf, int frames);
+
+    // complex multiply-add kernels (see const Convolver::Kernels&); each
+    // process_ variant also uses the matching Fft::pass_ variant
+    static void multiplyAdd_default(const float* aRe, const float* aIm, const float* bRe, const float* bIm, float* outRe, float* outIm, int bins);
+    static void multiplyAdd_neon(const float* aRe, const float* aIm, const float* bRe, const float* bIm, float* outRe, float* outIm, int bins);
+    static void multiplyAdd_sse(const float* aRe, const float* aIm, const float* bRe, const float* bIm, float* outRe, float* outIm, int bins);
+    static void multiplyAdd_avx2(const float* aRe, const float* aIm, const float* bRe, const float* bIm, float* outRe, float* outIm, int bins);
+
+    // called by ConvolutionWorker
+    bool hasTailWork() const;
+    void processTail();
+
+private:
+    friend class ConvolutionWorker;
+
+    enum { k_tailBlockFrames = 2048 };
+    enum { k_blocksPerTailBlock = k_tailBlockFrames / k_headBlockFrames };
+    enum { k_headFrames = 2 * k_tailBlockFrames }; // impulse response frames in the head
+    enum { k_tailSlots = 4 };
+    enum { k_channels = 2 };
+
+    // One long block of tail input, and its output.  A slot is owned by the
+    // audio thread while m_done is set, and by the worker otherwise.
+    struct TailSlot
+    {
+        float* in[k_channels];
+        float* out[k_channels];
+        volatile int32 block;  // tail block number
+        volatile int32 gen;    // m_gen when posted
+        const Convolver::Kernels* kernels;
+        volatile bool done;
+    };
+
+    Convolver m_head;
+    Convolver* m_tail;
+    float* m_mem;
+    float* m_headIn[k_channels];
+    float* m_headOut[k_channels];
+    float* m_tailIn[k_channels];   // tail input, collected one short block at a time
+    TailSlot m_slots[k_tailSlots];
+    float m_gain;
+    int m_pos;                     // frames into the current short block
+    int32 m_block;                 // short blocks processed since reset
+    volatile int32 m_gen;          // incremented by reset()
+    int32 m_tailGen;               // worker's copy of m_gen
+    bool m_inline;                 // process the tail on the audio thread (offline mode)
+    bool m_busy;                   // being processed by ConvolutionWorker; guarded by its mutex
+    bool m_warned;
+
+    void processFloat(float* buf, int frames, const Convolver::Kernels&);
+    void processFixed(int32* buf, int frames, const Convolver::Kernels&,
+            void (*toFloat)(const int32*, float*, int), void (*toFixed)(const float*, int32*, int));
+    void processBlock(const Convolver::Kernels&);
+    void postTail(int32 tailBlock, const Convolver::Kernels&);
+    void runTail(TailSlot&);
+    void warnLate();
+};
+
+
+}
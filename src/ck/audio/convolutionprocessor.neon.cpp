@@ -0,0 +1,56 @@
+#include "ck/audio/convolutionprocessor.h"
+#include "ck/audio/audioutil.h"
+#include "ck/core/debug.h"
+
+#if CK_ARM_NEON
+#  include <arm_neon.h>
+#endif
+
+namespace Cki
+{
+
+
+#if CK_ARM_NEON
+namespace
+{
+    const Convolver::Kernels k_kernelsNeon = { ConvolutionProcessor::multiplyAdd_neon, Fft::pass_neon };
+}
+
+void ConvolutionProcessor::process_neon(int* inBuf, int* outBuf, int frames)
+{
+    processFixed(inBuf, frames, k_kernelsNeon, AudioUtil::convertI32toF32_neon, AudioUtil::convertF32toI32_neon);
+}
+
+void ConvolutionProcessor::process_neon(float* inBuf, float* outBuf, int frames)
+{
+    processFloat(inBuf, frames, k_kernelsNeon);
+}
+
+void ConvolutionProcessor::multiplyAdd_neon(const float* aRe, const float* aIm, const float* bRe, const float* bIm, float* outRe, float* outIm, int bins)
+{
+    CK_ASSERT(bins % 4 == 0);
+    for (int i = 0; i < bins; i += 4)
+    {
+        float32x4_t ar = vld1q_f32(aRe + i);
+        float32x4_t ai = vld1q_f32(aIm + i);
+        float32x4_t br = vld1q_f32(bRe + i);
+        float32x4_t bi = vld1q_f32(bIm + i);
+
+        float32x4_t re = vld1q_f32(outRe + i);
+        float32x4_t im = vld1q_f32(outIm + i);
+        re = vmlaq_f32(re, ar, br);
+        re = vmlsq_f32(re, ai, bi);
+        im = vmlaq_f32(im, ar, bi);
+        im = vmlaq_f32(im, ai, br);
+        vst1q_f32(outRe + i, re);
+        vst1q_f32(outIm + i, im);
+    }
+}
+#else
+void ConvolutionProcessor::process_neon(int* inBuf, int* outBuf, int frames) {}
+void ConvolutionProcessor::process_neon(float* inBuf, float* outBuf, int frames) {}
+void ConvolutionProcessor::multiplyAdd_neon(const float* aRe, const float* aIm, const float* bRe, const float* bIm, float* outRe, float* outIm, int bins) {}
+#endif
+
+
+}
@@ -0,0 +1,59 @@
+#include "ck/audio/convolutionprocessor.h"
+#include "ck/audio/audioutil.h"
+#include "ck/core/system.h"
+#include "ck/core/debug.h"
+
+#if CK_X86_SSE
+#  include <xmmintrin.h>
+#endif
+
+namespace Cki
+{
+
+
+#if CK_X86_SSE
+namespace
+{
+    const Convolver::Kernels k_kernelsSse = { ConvolutionProcessor::multiplyAdd_sse, Fft::pass_sse };
+    const Convolver::Kernels k_kernelsAvx2 = { ConvolutionProcessor::multiplyAdd_avx2, Fft::pass_sse };
+
+    const Convolver::Kernels& getKernels()
+    {
+        return (System::get()->getSimdLevel() >= kCkSimdLevel_Avx2 ? k_kernelsAvx2 : k_kernelsSse);
+    }
+}
+
+void ConvolutionProcessor::process_sse(int* inBuf, int* outBuf, int frames)
+{
+    processFixed(inBuf, frames, getKernels(), AudioUtil::convertI32toF32_sse, AudioUtil::convertF32toI32_sse);
+}
+
+void ConvolutionProcessor::process_sse(float* inBuf, float* outBuf, int frames)
+{
+    processFloat(inBuf, frames, getKernels());
+}
+
+void ConvolutionProcessor::multiplyAdd_sse(const float* aRe, const float* aIm, const float* bRe, const float* bIm, float* outRe, float* outIm, int bins)
+{
+    CK_ASSERT(bins % 4 == 0);
+    for (int i = 0; i < bins; i += 4)
+    {
+        __m128 ar = _mm_loadu_ps(aRe + i);
+        __m128 ai = _mm_loadu_ps(aIm + i);
+        __m128 br = _mm_loadu_ps(bRe + i);
+        __m128 bi = _mm_loadu_ps(bIm + i);
+
+        __m128 re = _mm_sub_ps(_mm_mul_ps(ar, br), _mm_mul_ps(ai, bi));
+        __m128 im = _mm_add_ps(_mm_mul_ps(ar, bi), _mm_mul_ps(ai, br));
+        _mm_storeu_ps(outRe + i, _mm_add_ps(_mm_loadu_ps(outRe + i), re));
+        _mm_storeu_ps(outIm + i, _mm_add_ps(_mm_loadu_ps(outIm + i), im));
+    }
+}
+#else
+void ConvolutionProcessor::process_sse(int* inBuf, int* outBuf, int frames) {}
+void ConvolutionProcessor::process_sse(float* inBuf, float* outBuf, int frames) {}
+void ConvolutionProcessor::multiplyAdd_sse(const float* aRe, const float* aIm, const float* bRe, const float* bIm, float* outRe, float* outIm, int bins) {}
+#endif
+
+
+}
@@ -0,0 +1,157 @@
+#include "ck/audio/convolutionworker.h"
+#include "ck/audio/convolutionprocessor.h"
+#include "ck/core/thread.h"
+#include "ck/core/atomic.h"
+#include "ck/core/system.h"
+#include "ck/core/debug.h"
+
+namespace Cki
+{
+
+
+namespace
+{
+    // Longest time to sleep while there are reverbs.  A tail block is posted
+    // every 2048 frames and isn't needed until 2048 frames later, so a
+    // missed wakeup costs little as long as this is well under ~40 ms.
+    const int k_waitMs = 10;
+}
+
+void ConvolutionWorker::init()
+{
+    CK_ASSERT(!s_instance);
+    s_instance = new ConvolutionWorker(!System::get()->isOffline());
+}
+
+void ConvolutionWorker::shutdown()
+{
+    delete s_instance;
+    s_instance = NULL;
+}
+
+void ConvolutionWorker::add(ConvolutionProcessor* processor)
+{
+    m_mutex.lock();
+    processor->m_busy = false;
+    m_list.addFirst(processor);
+    if (m_threaded && !m_thread)
+    {
+        m_thread = new Thread(threadFunc);
+#if CK_PLATFORM_ANDROID
+        m_thread->setFlags(Thread::k_flagAttachToJvm);
+#endif
+        m_thread->setName("CK convolution");
+        m_thread->start(this);
+    }
+    m_mutex.unlock();
+}
+
+void ConvolutionWorker::remove(ConvolutionProcessor* processor)
+{
+    m_mutex.lock();
+    while (processor->m_busy)
+    {
+        // rare; only if a reverb is destroyed while its tail is being convolved
+        m_mutex.unlock();
+        Thread::sleepMs(1);
+        m_mutex.lock();
+    }
+    m_list.remove(processor);
+    m_mutex.unlock();
+}
+
+void ConvolutionWorker::wake()
+{
+    if (m_threaded)
+    {
+        Atomic::storeRelease(&m_wakePending, (int32) 1);
+
+        // Don't wait for the lock; if the thread holds it, it will see
+        // m_wakePending before it sleeps (see StreamScheduler::wake()).
+        if (m_mutex.tryLock())
+        {
+            m_cond.signal();
+            m_mutex.unlock();
+        }
+    }
+}
+
+ConvolutionWorker::ConvolutionWorker(bool threaded) :
+    m_threaded(threaded),
+    m_thread(NULL),
+    m_wakePending(0),
+    m_stop(false)
+{
+}
+
+ConvolutionWorker::~ConvolutionWorker()
+{
+    if (m_thread)
+    {
+        m_mutex.lock();
+        m_stop = true;
+        m_cond.signal();
+        m_mutex.unlock();
+
+        m_thread->join();
+        delete m_thread;
+    }
+    CK_ASSERT(m_list.isEmpty());
+}
+
+ConvolutionProcessor* ConvolutionWorker::findWork()
+{
+    for (ConvolutionProcessor* p = m_list.getFirst(); p; p = p->getNext())
+    {
+        if (!p->m_busy && p->hasTailWork())
+        {
+            return p;
+        }
+    }
+    return NULL;
+}
+
+void ConvolutionWorker::threadLoop()
+{
+    m_mutex.lock();
+    while (!m_stop)
+    {
+        m_wakePending = 0;
+
+        ConvolutionProcessor* processor = findWork();
+        if (processor)
+        {
+            processor->m_busy = true;
+            m_mutex.unlock();
+
+            processor->processTail();
+
+            m_mutex.lock();
+            processor->m_busy = false;
+        }
+        else if (!Atomic::loadAcquire(&m_wakePending))
+        {
+            if (m_list.isEmpty())
+            {
+                m_cond.wait(m_mutex);
+            }
+            else
+            {
+                m_cond.wait(m_mutex, k_waitMs);
+            }
+        }
+    }
+    m_mutex.unlock();
+}
+
+void* ConvolutionWorker::threadFunc(void* arg)
+{
+    ConvolutionWorker* worker = (ConvolutionWorker*) arg;
+    worker->threadLoop();
+    return NULL;
+}
+
+ConvolutionWorker* ConvolutionWorker::s_instance = NULL;
+
+
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/core/allocatable.h"
+#include "ck/core/types.h"
+#include "ck/core/list.h"
+#include "ck/core/mutex.h"
+#include "ck/core/cond.h"
+
+namespace Cki
+{
+
+class ConvolutionProcessor;
+class Thread;
+
+
+// Convolves the tails of convolution reverbs on a background thread, so the
+// audio thread only has to do the short head blocks.  The thread is started
+// when the first reverb with a tail is created.
+// In offline mode there is no thread; tails are convolved on the render thread.
+class ConvolutionWorker : public Allocatable
+{
+public:
+    static void init();
+    static void shutdown();
+    static ConvolutionWorker* get() { return s_instance; }
+
+    bool isThreaded() const { return m_threaded; }
+
+    void add(ConvolutionProcessor*);
+    void remove(ConvolutionProcessor*); // waits if the processor's tail is being convolved
+
+    // Let the thread know that a tail block has been posted.
+    // Never blocks, so it can be called from the audio thread.
+    void wake();
+
+private:
+    bool m_threaded;
+    Thread* m_thread;
+
+    Mutex m_mutex;
+    Cond m_cond;
+    List<ConvolutionProcessor> m_list;  // guarded by m_mutex
+    volatile int32 m_wakePending;
+    bool m_stop;
+
+    static ConvolutionWorker* s_instance;
+
+    ConvolutionWorker(bool threaded);
+    ~ConvolutionWorker();
+
+    ConvolutionProcessor* findWork(); // call with m_mutex locked
+    void threadLoop();
+    static void* threadFunc(void*);
+
+    ConvolutionWorker(const ConvolutionWorker&);
+    ConvolutionWorker& operator=(const ConvolutionWorker&);
+};
+
+
+}
@@ -0,0 +1,156 @@
+#include "ck/audio/convolver.h"
+#include "ck/audio/impulseresponse.h"
+#include "ck/core/mem.h"
+#include "ck/core/math.h"
+#include "ck/core/debug.h"
+
+namespace Cki
+{
+
+
+Convolver::Convolver(int blockFrames, const ImpulseResponse& ir, int startFrame, int endFrame) :
+    m_blockFrames(blockFrames),
+    m_partitions((endFrame - startFrame + blockFrames - 1) / blockFrames),
+    m_irChannels(ir.getChannels()),
+    m_fft(2 * blockFrames),
+    m_mem(NULL),
+    m_ir(NULL),
+    m_delayLine(NULL),
+    m_accRe(NULL),
+    m_accIm(NULL),
+    m_output(NULL),
+    m_delayPos(0)
+{
+    CK_ASSERT(m_partitions > 0);
+    CK_ASSERT(endFrame <= ir.getFrames());
+    m_input[0] = m_input[1] = NULL;
+    if (!m_fft.isInited())
+    {
+        return;
+    }
+
+    int spectrumSize = getSpectrumSize();
+    int irFloats = m_irChannels * m_partitions * spectrumSize;
+    int delayLineFloats = k_channels * m_partitions * spectrumSize;
+    int inputFloats = k_channels * 2 * blockFrames;
+    int scratchFloats = blockFrames * 2 + blockFrames * 2; // accumulator, output
+    m_mem = (float*) Mem::alloc((irFloats + delayLineFloats + inputFloats + scratchFloats) * sizeof(float));
+    if (!m_mem)
+    {
+        return;
+    }
+
+    float* p = m_mem;
+    m_ir = p;
+    p += irFloats;
+    m_delayLine = p;
+    p += delayLineFloats;
+    for (int c = 0; c < k_channels; ++c)
+    {
+        m_input[c] = p;
+        p += 2 * blockFrames;
+    }
+    m_accRe = p;
+    p += blockFrames;
+    m_accIm = p;
+    p += blockFrames;
+    m_output = p;
+
+    // Transform each partition, zero-padded to the FFT size; the 1/size
+    // scaling of the inverse transform is folded in here.
+    float scale = 1.0f / m_fft.getSize();
+    for (int c = 0; c < m_irChannels; ++c)
+    {
+        const float* data = ir.getData(c);
+        for (int i = 0; i < m_partitions; ++i)
+        {
+            int start = startFrame + i * blockFrames;
+            int frames = Math::min(blockFrames, endFrame - start);
+            Mem::clear(m_output, 2 * blockFrames * sizeof(float));
+            for (int j = 0; j < frames; ++j)
+            {
+                m_output[j] = data[start + j] * scale;
+            }
+
+            float* spectrum = m_ir + (c * m_partitions + i) * spectrumSize;
+            m_fft.forward(m_output, spectrum, spectrum + blockFrames, Fft::pass_default);
+        }
+    }
+
+    reset();
+}
+
+Convolver::~Convolver()
+{
+    Mem::free(m_mem);
+}
+
+void Convolver::process(float* const* in, float* const* out, const Kernels& kernels)
+{
+    CK_ASSERT(m_mem);
+    int spectrumSize = getSpectrumSize();
+    int bins = m_blockFrames;
+
+    for (int c = 0; c < k_channels; ++c)
+    {
+        // transform the last 2 input blocks into the delay line
+        float* input = m_input[c];
+        Mem::copy(input + m_blockFrames, in[c], m_blockFrames * sizeof(float));
+
+        float* delayLine = m_delayLine + c * m_partitions * spectrumSize;
+        float* newest = delayLine + m_delayPos * spectrumSize;
+        m_fft.forward(input, newest, newest + bins, kernels.fftPass);
+        Mem::copy(input, input + m_blockFrames, m_blockFrames * sizeof(float));
+
+        // multiply each partition of the impulse response by the input spectrum
+        // from that many blocks ago
+        const float* ir = m_ir + Math::min(c, m_irChannels - 1) * m_partitions * spectrumSize;
+        Mem::clear(m_accRe, bins * sizeof(float));
+        Mem::clear(m_accIm, bins * sizeof(float));
+        float dc = 0.0f;
+        float nyquist = 0.0f;
+        int slot = m_delayPos;
+        for (int i = 0; i < m_partitions; ++i)
+        {
+            const float* x = delayLine + slot * spectrumSize;
+            const float* h = ir + i * spectrumSize;
+            kernels.multiplyAdd(x, x + bins, h, h + bins, m_accRe, m_accIm, bins);
+
+            // bin 0 holds two real values, which the kernel treats as complex
+            dc += x[0] * h[0];
+            nyquist += x[bins] * h[bins];
+
+            if (--slot < 0)
+            {
+                slot = m_partitions - 1;
+            }
+        }
+        m_accRe[0] = dc;
+        m_accIm[0] = nyquist;
+
+        // the second half of the inverse transform is the output for this block
+        m_fft.inverse(m_accRe, m_accIm, m_output, kernels.fftPass);
+        Mem::copy(out[c], m_output + m_blockFrames, m_blockFrames * sizeof(float));
+    }
+
+    if (++m_delayPos >= m_partitions)
+    {
+        m_delayPos = 0;
+    }
+}
+
+void Convolver::reset()
+{
+    if (m_mem)
+    {
+        Mem::clear(m_delayLine, k_channels * m_partitions * getSpectrumSize() * sizeof(float));
+        for (int c = 0; c < k_channels; ++c)
+        {
+            Mem::clear(m_input[c], 2 * m_blockFrames * sizeof(float));
+        }
+        m_delayPos = 0;
+    }
+}
+
+
+}
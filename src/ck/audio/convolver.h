@@ -0,0 +1,66 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/core/allocatable.h"
+#include "ck/audio/fft.h"
+
+namespace Cki
+{
+
+class ImpulseResponse;
+
+
+// Uniformly partitioned convolution of stereo input with part of a mono or
+// stereo impulse response, by overlap-save with a frequency-domain delay line.
+// Input is processed in blocks of blockFrames; each block of output is the
+// convolution up to the end of the corresponding input block.
+class Convolver : public Allocatable
+{
+public:
+    // out += a * b, for complex bins in split form
+    typedef void (*MultiplyAddFunc)(const float* aRe, const float* aIm, const float* bRe, const float* bIm, float* outRe, float* outIm, int bins);
+
+    // the SIMD variants to use
+    struct Kernels
+    {
+        MultiplyAddFunc multiplyAdd;
+        Fft::PassFunc fftPass;
+    };
+
+    // Convolves with the impulse response frames in [startFrame, endFrame).
+    Convolver(int blockFrames, const ImpulseResponse&, int startFrame, int endFrame);
+    ~Convolver();
+
+    bool isInited() const { return m_mem != NULL; }
+    int getBlockFrames() const { return m_blockFrames; }
+
+    // Each of in and out has 2 channels of blockFrames samples; out may equal in.
+    void process(float* const* in, float* const* out, const Kernels&);
+
+    void reset();
+
+private:
+    enum { k_channels = 2 };
+
+    int m_blockFrames;
+    int m_partitions;
+    int m_irChannels;
+    Fft m_fft;
+
+    float* m_mem;
+    float* m_ir;                   // partition spectra, per impulse response channel
+    float* m_delayLine;            // spectra of the last m_partitions input blocks, per channel
+    float* m_input[k_channels];    // last 2 input blocks
+    float* m_accRe;
+    float* m_accIm;
+    float* m_output;
+    int m_delayPos;                // delay line slot of the newest block
+
+    int getSpectrumSize() const { return 2 * m_blockFrames; } // re, then im
+
+    Convolver(const Convolver&);
+    Convolver& operator=(const Convolver&);
+};
+
+
+}
@@ -11,7 +11,7 @@ CustomStreamSound::CustomStreamSound(CkCustomStream* stream) :
     m_stream(stream),
     m_source(&m_stream)
 {
-    subInit(&m_source);
+    subInitStream(&m_source);
 }
 
 
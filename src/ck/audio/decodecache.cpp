@@ -0,0 +1,235 @@
+#include "ck/audio/decodecache.h"
+#include "ck/audio/adpcm.h"
+#include "ck/audio/lossless.h"
+#include "ck/audio/audioformat.h"
+#include "ck/audio/sample.h"
+#include "ck/core/system.h"
+#include "ck/core/mem.h"
+#include "ck/core/debug.h"
+
+// template definitions
+#include "ck/core/list.cpp"
+
+namespace Cki
+{
+
+
+void DecodeCache::init()
+{
+    const CkConfig& config = System::get()->getConfig();
+    s_maxBytes = config.decodeCacheBytes;
+    s_maxSoundBytes = config.decodeCacheMaxSoundBytes;
+}
+
+void DecodeCache::shutdown()
+{
+    Entry* entry = s_entries.getFirst();
+    while (entry)
+    {
+        Entry* next = entry->getNext();
+        if (entry->m_refs == 0)
+        {
+            destroy(entry);
+        }
+        entry = next;
+    }
+    s_maxBytes = 0;
+}
+
+DecodeCache::Entry* DecodeCache::acquire(const Sample& sample, const Bank* bank)
+{
+    if (!isCacheable(sample))
+    {
+        return NULL;
+    }
+
+    for (Entry* entry = s_entries.getFirst(); entry; entry = entry->getNext())
+    {
+        if (entry->m_sample == &sample)
+        {
+            ++entry->m_refs;
+            ++s_hits;
+
+            // most recently used
+            s_entries.remove(entry);
+            s_entries.addFirst(entry);
+            return entry;
+        }
+    }
+
+    int frames = sample.info.blocks * sample.info.blockFrames;
+    int bytes = frames * sample.info.channels * sizeof(int32); // same for float
+    if (!makeRoom(bytes))
+    {
+        ++s_overflows;
+        return NULL;
+    }
+
+    void* data = Mem::alloc(bytes);
+    Entry* entry = new Entry();
+    if (!data || !entry)
+    {
+        Mem::free(data);
+        delete entry;
+        ++s_overflows;
+        return NULL;
+    }
+
+    if (System::get()->getSampleType() == kCkSampleType_Fixed)
+    {
+        decode(sample, (int32*) data);
+    }
+    else
+    {
+        decode(sample, (float*) data);
+    }
+
+    entry->m_sample = &sample;
+    entry->m_bank = bank;
+    entry->m_data = data;
+    entry->m_bytes = bytes;
+    entry->m_refs = 1;
+    entry->m_pinned = (sample.info.flags & SampleInfo::k_hot) != 0;
+    s_entries.addFirst(entry);
+    s_bytes += bytes;
+    ++s_misses;
+
+    return entry;
+}
+
+void DecodeCache::release(Entry* entry)
+{
+    CK_ASSERT(entry->m_refs > 0);
+    --entry->m_refs;
+    if (entry->m_refs == 0 && !entry->m_sample)
+    {
+        destroy(entry);
+    }
+}
+
+void DecodeCache::removeBank(const Bank* bank)
+{
+    Entry* entry = s_entries.getFirst();
+    while (entry)
+    {
+        Entry* next = entry->getNext();
+        if (entry->m_bank == bank)
+        {
+            // sample will no longer be valid
+            entry->m_sample = NULL;
+            entry->m_bank = NULL;
+            entry->m_pinned = false;
+            if (entry->m_refs == 0)
+            {
+                destroy(entry);
+            }
+        }
+        entry = next;
+    }
+}
+
+void DecodeCache::getStats(CkDecodeCacheStats& stats)
+{
+    stats.hits = s_hits;
+    stats.misses = s_misses;
+    stats.evictions = s_evictions;
+    stats.overflows = s_overflows;
+    stats.entries = s_entries.getSize();
+    stats.bytes = s_bytes;
+    stats.pinnedBytes = 0;
+    for (const Entry* entry = s_entries.getFirst(); entry; entry = ((Entry*) entry)->getNext())
+    {
+        if (entry->m_refs > 0 || entry->m_pinned)
+        {
+            stats.pinnedBytes += entry->m_bytes;
+        }
+    }
+}
+
+////////////////////////////////////////
+
+bool DecodeCache::isCacheable(const Sample& sample)
+{
+    if (s_maxBytes <= 0 || 
+        (sample.info.format != AudioFormat::k_adpcm && sample.info.format != AudioFormat::k_lossless))
+    {
+        return false;
+    }
+
+    int frames = sample.info.blocks * sample.info.blockFrames;
+    int bytes = frames * sample.info.channels * sizeof(int32);
+    return bytes <= s_maxBytes && 
+        (bytes <= s_maxSoundBytes || (sample.info.flags & SampleInfo::k_hot));
+}
+
+template <typename T>
+void DecodeCache::decode(const Sample& sample, T* data)
+{
+    const SampleInfo& info = sample.info;
+    if (info.format == AudioFormat::k_lossless)
+    {
+        const byte* input = sample.data;
+        for (int i = 0; i < info.blocks; ++i)
+        {
+            input += Lossless::decodeBlock(input, info.channels, data + i * Lossless::k_blockFrames * info.channels);
+        }
+    }
+    else
+    {
+        Adpcm::decodeBlocks(sample.data, info.blocks, info.channels, data);
+    }
+}
+
+// Evicts unused entries, least recently used first, until there is room for
+// the given number of bytes; returns false if there is not enough unused data.
+bool DecodeCache::makeRoom(int bytes)
+{
+    int evictable = 0;
+    for (Entry* entry = s_entries.getFirst(); entry; entry = entry->getNext())
+    {
+        if (entry->m_refs == 0 && !entry->m_pinned)
+        {
+            evictable += entry->m_bytes;
+        }
+    }
+    if (s_bytes - evictable + bytes > s_maxBytes)
+    {
+        return false;
+    }
+
+    Entry* entry = s_entries.getLast();
+    while (entry && s_bytes + bytes > s_maxBytes)
+    {
+        Entry* prev = entry->getPrev();
+        if (entry->m_refs == 0 && !entry->m_pinned)
+        {
+            destroy(entry);
+            ++s_evictions;
+        }
+        entry = prev;
+    }
+    return true;
+}
+
+void DecodeCache::destroy(Entry* entry)
+{
+    CK_ASSERT(entry->m_refs == 0);
+    s_entries.remove(entry);
+    s_bytes -= entry->m_bytes;
+    Mem::free(entry->m_data);
+    delete entry;
+}
+
+List<DecodeCache::Entry> DecodeCache::s_entries;
+int DecodeCache::s_maxBytes = 0;
+int DecodeCache::s_maxSoundBytes = 0;
+int DecodeCache::s_bytes = 0;
+int DecodeCache::s_hits = 0;
+int DecodeCache::s_misses = 0;
+int DecodeCache::s_evictions = 0;
+int DecodeCache::s_overflows = 0;
+
+template class List<DecodeCache::Entry>;
+
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/core/types.h"
+#include "ck/core/list.h"
+#include "ck/core/allocatable.h"
+#include "ck/ck.h"
+
+namespace Cki
+{
+
+class Bank;
+struct Sample;
+
+
+// Decoded sample data for compressed bank sounds that are small, or that are
+// marked hot in the bank, so sounds that are played over and over are decoded
+// only once.  Data is in the pipeline's sample format (8.24 fixed point or
+// float), and is shared by every sound using the same sample.  Data that no
+// sound is using is discarded, least recently used first, to stay within
+// CkConfig.decodeCacheBytes.  Hot samples stay pinned until their bank is
+// destroyed.
+// Main thread only.
+class DecodeCache
+{
+public:
+    class Entry : 
+        public Allocatable,
+        public List<Entry>::Node
+    {
+    public:
+        const void* getData() const { return m_data; }
+
+    private:
+        const Sample* m_sample; // NULL once its bank is destroyed
+        const Bank* m_bank;
+        void* m_data;
+        int m_bytes;
+        int m_refs; // decoders using this entry
+        bool m_pinned;
+
+        friend class DecodeCache;
+    };
+
+    static void init();
+    static void shutdown();
+
+    // Returns the decoded data for the sample, adding a reference, or NULL if
+    // it should not or cannot be cached.
+    static Entry* acquire(const Sample&, const Bank*);
+    static void release(Entry*);
+
+    // Called when a bank is destroyed; its entries are freed once they are released.
+    static void removeBank(const Bank*);
+
+    static void getStats(CkDecodeCacheStats&);
+
+private:
+    static List<Entry> s_entries; // most recently used first
+    static int s_maxBytes;
+    static int s_maxSoundBytes;
+    static int s_bytes;
+    static int s_hits;
+    static int s_misses;
+    static int s_evictions;
+    static int s_overflows;
+
+    static bool isCacheable(const Sample&);
+    static bool makeRoom(int bytes);
+    template <typename T> static void decode(const Sample&, T* data);
+    static void destroy(Entry*);
+};
+
+
+}
@@ -1,5 +1,7 @@
 #include "ck/audio/decoder.h"
+#include "ck/audio/audiosource.h"
 #include "ck/core/debug.h"
+#include "ck/core/math.h"
 
 namespace Cki
 {
@@ -10,4 +12,71 @@ Decoder::Decoder(AudioSource& source) :
 {
 }
 
+int Decoder::skip(float* buf, int frames)
+{
+    return decode(buf, frames);
+}
+
+int Decoder::getBlockFrames(int block) const
+{
+    int blockFrames = m_source.getSampleInfo().blockFrames;
+    int frames = m_source.getNumFrames();
+    if (frames < 0)
+    {
+        return blockFrames; // length not known yet
+    }
+    return Math::clamp(frames - block * blockFrames, 0, blockFrames);
+}
+
+int Decoder::skipBlocks(int frames, int& frameOffset)
+{
+    int blockFrames = m_source.getSampleInfo().blockFrames;
+    int numFrames = m_source.getNumFrames();
+
+    int framesSkipped = 0;
+    while (framesSkipped < frames && !m_source.isDone())
+    {
+        int framesLeft = frames - framesSkipped;
+        int block = m_source.getBlockPos();
+        int nextFrames = getBlockFrames(block);
+
+        // whole blocks can be skipped up to a last block that is not full
+        int blocks = framesLeft / blockFrames;
+        if (numFrames >= 0)
+        {
+            blocks = Math::min(blocks, numFrames / blockFrames - block);
+        }
+
+        int skipped;
+        if (frameOffset + framesLeft < nextFrames)
+        {
+            // stop partway into the next block
+            frameOffset += framesLeft;
+            skipped = framesLeft;
+        }
+        else if (frameOffset > 0 || blocks <= 0)
+        {
+            // the rest of a block that was partly skipped, or a short last block
+            if (m_source.read(NULL, 1) == 0)
+            {
+                break;
+            }
+            skipped = Math::max(nextFrames - frameOffset, 0);
+            frameOffset = 0;
+        }
+        else
+        {
+            skipped = m_source.read(NULL, blocks) * blockFrames;
+        }
+
+        if (skipped == 0)
+        {
+            break;
+        }
+        framesSkipped += skipped;
+    }
+
+    return framesSkipped;
+}
+
 }
@@ -18,12 +18,27 @@ public:
     virtual int decode(float* buf, int frames) = 0;
     virtual bool isDone() const = 0;
 
+    // Advances by up to the given number of frames, as decode() would, but
+    // without needing to produce the samples; buf is scratch space of the size
+    // decode() would need.  Returns the number of frames skipped.
+    virtual int skip(float* buf, int frames);
+
     virtual void setFramePos(int frame) = 0;
     virtual int getFramePos() const = 0;
     virtual int getNumFrames() const = 0;
 
 protected:
     AudioSource& m_source;
+
+    // Frames of the given block of the source that are played; only the last
+    // block may have fewer than blockFrames.
+    int getBlockFrames(int block) const;
+
+    // For decoders of multi-frame blocks: skips up to the given number of
+    // frames by advancing the source, without reading or decoding the blocks.
+    // frameOffset is the offset into the next block, which is decoded when
+    // needed; it is updated.  Returns the number of frames skipped.
+    int skipBlocks(int frames, int& frameOffset);
 };
 
 
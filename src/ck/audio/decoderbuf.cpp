@@ -20,9 +20,15 @@ DecoderBuf::~DecoderBuf()
     }
 }
 
-void DecoderBuf::init(AudioSource& source)
+void DecoderBuf::init(AudioSource& source, DecodeCache::Entry* cached)
 {
     CK_ASSERT(!m_decoder);
+    if (cached)
+    {
+        m_decoder = new (m_mem) CachedDecoder(source, cached);
+        return;
+    }
+
     switch (source.getSampleInfo().format)
     {
         case AudioFormat::k_pcmI16:
@@ -41,6 +47,10 @@ void DecoderBuf::init(AudioSource& source)
             m_decoder = new (m_mem) AdpcmDecoder(source);
             break;
 
+        case AudioFormat::k_lossless:
+            m_decoder = new (m_mem) LosslessDecoder(source);
+            break;
+
         default:
             CK_FAIL("unknown format");
             break;
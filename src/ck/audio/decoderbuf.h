@@ -6,6 +6,8 @@
 #include "ck/audio/pcmi16decoder.h"
 #include "ck/audio/pcmf32decoder.h"
 #include "ck/audio/adpcmdecoder.h"
+#include "ck/audio/losslessdecoder.h"
+#include "ck/audio/cacheddecoder.h"
 
 namespace Cki
 {
@@ -18,7 +20,8 @@ public:
     DecoderBuf();
     ~DecoderBuf();
 
-    void init(AudioSource&);
+    // if cached is not NULL, it is played instead of decoding the source
+    void init(AudioSource&, DecodeCache::Entry* cached = NULL);
 
     Decoder* get() { return m_decoder; }
     const Decoder* get() const { return m_decoder; }
@@ -26,11 +29,15 @@ public:
 private:
     enum 
     { 
-        k_memSize = Math::Max4<
-             sizeof(PcmI8Decoder), 
-             sizeof(PcmI16Decoder),
-             sizeof(AdpcmDecoder), 
-             sizeof(PcmF32Decoder)
+        k_memSize = Math::Max3<
+             Math::Max4<
+                 sizeof(PcmI8Decoder), 
+                 sizeof(PcmI16Decoder),
+                 sizeof(AdpcmDecoder), 
+                 sizeof(PcmF32Decoder)
+                     >::value,
+             sizeof(LosslessDecoder),
+             sizeof(CachedDecoder)
                  >::value
     };
     Decoder* m_decoder;
@@ -8,6 +8,11 @@
 #include "ck/audio/ringmodprocessor.h"
 #include "ck/audio/biquadfilterprocessor.h"
 #include "ck/audio/distortionprocessor.h"
+#include "ck/audio/reverbprocessor.h"
+#include "ck/audio/compressorprocessor.h"
+#include "ck/audio/convolutionprocessor.h"
+#include "ck/audio/impulseresponse.h"
+#include "ck/audio/bank.h"
 
 // template instantiations
 #include "ck/core/proxied.cpp"
@@ -18,11 +23,13 @@ namespace Cki
 {
 
 
-Effect::Effect(CkEffectProcessor* proc) :
+Effect::Effect(CkEffectProcessor* proc, const char* name) :
     m_proc(proc),
+    m_name(name),
     m_bypass(false),
     m_wetDry(1.0f),
-    m_owner(NULL)
+    m_owner(NULL),
+    m_compressor(NULL)
 {
 }
 
@@ -50,7 +57,8 @@ void Effect::execute(int commandId, CommandParam param0, CommandParam param1)
 
 void Effect::setParam(int paramId, float value)
 {
-    Cki::AudioGraph::get()->execute(this, k_setParam, paramId, value);
+    // coalesce by parameter, so only the latest value of each is sent
+    Cki::AudioGraph::get()->executeCoalesced(this, k_setParam, paramId, value, paramId);
 }
 
 void Effect::reset()
@@ -82,21 +90,52 @@ float Effect::getWetDryRatio() const
     return m_wetDry;
 }
 
+float Effect::getGainReduction() const
+{
+    return m_compressor ? m_compressor->getGainReduction() : 0.0f;
+}
+
 Effect* Effect::newEffect(CkEffectType type)
 {
     switch (type)
     {
         case kCkEffectType_BitCrusher:
-            return new Effect(new BitCrusherProcessor);
+            return new Effect(new BitCrusherProcessor, "bit crusher");
 
         case kCkEffectType_RingMod:
-            return new Effect(new RingModProcessor);
+            return new Effect(new RingModProcessor, "ring mod");
 
         case kCkEffectType_BiquadFilter:
-            return new Effect(new BiquadFilterProcessor);
+            return new Effect(new BiquadFilterProcessor, "biquad filter");
 
         case kCkEffectType_Distortion:
-            return new Effect(new DistortionProcessor);
+            return new Effect(new DistortionProcessor, "distortion");
+
+        case kCkEffectType_Reverb:
+            {
+                ReverbProcessor* proc = new ReverbProcessor;
+                if (!proc || !proc->isInited())
+                {
+                    CK_LOG_ERROR("Reverb effect: could not allocate memory");
+                    delete proc;
+                    return NULL;
+                }
+                return new Effect(proc, "reverb");
+            }
+
+        case kCkEffectType_Compressor:
+            {
+                CompressorProcessor* proc = new CompressorProcessor;
+                if (!proc || !proc->isInited())
+                {
+                    CK_LOG_ERROR("Compressor effect: could not allocate memory");
+                    delete proc;
+                    return NULL;
+                }
+                Effect* effect = new Effect(proc, "compressor");
+                effect->m_compressor = proc;
+                return effect;
+            }
 
         default:
             CK_LOG_ERROR("Unknown effect type %d", type);
@@ -104,6 +143,57 @@ Effect* Effect::newEffect(CkEffectType type)
     }
 }
 
+Effect* Effect::newConvolutionReverb(Bank* bank, const char* soundName)
+{
+    const Sample* sample = NULL;
+    if (bank)
+    {
+        if (bank->isLoaded())
+        {
+            sample = bank->findSample(soundName);
+        }
+    }
+    else
+    {
+        sample = Bank::findSample(soundName, &bank);
+    }
+
+    if (!sample)
+    {
+        CK_LOG_ERROR("Convolution Reverb effect: could not find sound \"%s\"", soundName);
+        return NULL;
+    }
+
+    ImpulseResponse ir;
+    if (!ir.load(*sample))
+    {
+        return NULL;
+    }
+    return newConvolutionReverb(ir);
+}
+
+Effect* Effect::newConvolutionReverb(const char* path, CkPathType pathType)
+{
+    ImpulseResponse ir;
+    if (!ir.load(path, pathType))
+    {
+        return NULL;
+    }
+    return newConvolutionReverb(ir);
+}
+
+Effect* Effect::newConvolutionReverb(const ImpulseResponse& ir)
+{
+    ConvolutionProcessor* proc = new ConvolutionProcessor(ir);
+    if (!proc || !proc->isInited())
+    {
+        CK_LOG_ERROR("Convolution Reverb effect: could not allocate memory");
+        delete proc;
+        return NULL;
+    }
+    return new Effect(proc, "convolution reverb");
+}
+
 void Effect::registerCustomEffect(int id, CustomEffectFunc func)
 {
     int index = -1;
@@ -157,7 +247,7 @@ Effect* Effect::newCustomEffect(int id, void* arg)
             CkEffectProcessor* proc = factory.func(arg);
             if (proc)
             {
-                return new Effect(proc);
+                return new Effect(proc, "custom effect");
             }
             else
             {
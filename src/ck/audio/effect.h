@@ -15,6 +15,9 @@ namespace Cki
 {
 
 class EffectBusNode;
+class Bank;
+class ImpulseResponse;
+class CompressorProcessor;
 
 class Effect : 
     public CkEffect,
@@ -25,7 +28,7 @@ class Effect :
     public List<Effect>::Node
 {
 public:
-    Effect(CkEffectProcessor*);
+    Effect(CkEffectProcessor*, const char* name); // name must be a static string
     virtual ~Effect();
 
     // CommandObject interface
@@ -46,10 +49,15 @@ public:
     void setWetDryRatio(float);
     float getWetDryRatio() const;
 
+    float getGainReduction() const;
+
     CkEffectProcessor* getProcessor() { return m_proc; }
+    const char* getName() const { return m_name; } // identifies the effect type in a render trace
     void setOwner(EffectBusNode*);
 
     static Effect* newEffect(CkEffectType);
+    static Effect* newConvolutionReverb(Bank*, const char* soundName);
+    static Effect* newConvolutionReverb(const char* path, CkPathType);
 
     static void registerCustomEffect(int id, CustomEffectFunc);
     static Effect* newCustomEffect(int id, void* arg);
@@ -61,9 +69,11 @@ public:
 
 private:
     CkEffectProcessor* m_proc;
+    const char* m_name;
     bool m_bypass;
     float m_wetDry;
     EffectBusNode* m_owner;
+    const CompressorProcessor* m_compressor; // for metering; NULL for other effects
 
     struct FactoryInfo
     {
@@ -74,6 +84,8 @@ private:
         void fixup(MemoryFixup&) {}
     };
     static Array<FactoryInfo> s_factories;
+
+    static Effect* newConvolutionReverb(const ImpulseResponse&);
 };
 
 
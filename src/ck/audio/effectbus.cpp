@@ -131,7 +131,7 @@ bool EffectBus::isBypassed() const
 
 void EffectBus::setWetDryRatio(float wetDry)
 {
-    AudioGraph::get()->execute(&m_fx, EffectBusNode::k_setWetDryRatio, wetDry);
+    AudioGraph::get()->executeCoalesced(&m_fx, EffectBusNode::k_setWetDryRatio, wetDry);
 }
 
 float EffectBus::getWetDryRatio() const
@@ -139,6 +139,11 @@ float EffectBus::getWetDryRatio() const
     return m_fx.getWetDryRatio();
 }
 
+float EffectBus::getRenderLoad() const
+{
+    return m_fx.getRenderLoad();
+}
+
 void EffectBus::addInputSound(GraphSound* sound)
 {
     m_inputSounds.addFirst(sound);
@@ -180,7 +185,6 @@ void EffectBus::destroy()
     AudioGraph* graph = AudioGraph::get();
 
     graph->execute(&m_fx, EffectBusNode::k_removeAllEffects);
-    graph->execute(&m_mixer, MixNode::k_detach);
 
     // unhook from output
     if (!m_isOutput)
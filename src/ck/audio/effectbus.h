@@ -44,6 +44,8 @@ public:
     void setWetDryRatio(float);
     float getWetDryRatio() const;
 
+    float getRenderLoad() const;
+
     void addInput(AudioNode*);
     void removeInput(AudioNode*);
 
@@ -1,20 +1,35 @@
 #include "ck/audio/effectbusnode.h"
 #include "ck/audio/effect.h"
 #include "ck/audio/audioutil.h"
+#include "ck/audio/rendertrace.h"
 #include "ck/effectprocessor.h"
+#include "ck/core/atomic.h"
 #include "ck/core/debug.h"
 #include "ck/core/mem.h"
+#include "ck/core/timer.h"
 
 
 namespace Cki
 {
 
 
+namespace
+{
+    union FloatBits
+    {
+        float f;
+        int32 i;
+    };
+}
+
 EffectBusNode::EffectBusNode() :
     m_input(NULL),
     m_bypass(false),
     m_wetDry(1.0f),
-    m_prevActive(false)
+    m_prevActive(false),
+    m_loadTicks(0),
+    m_loadFrames(0),
+    m_renderLoad(0)
 {
 }
 
@@ -30,6 +45,24 @@ BufferHandle EffectBusNode::processFixed(int frames, bool post, bool& needsPost)
 
 template <typename T>
 BufferHandle EffectBusNode::process(int frames, bool post, bool& needsPost)
+{
+    uint64 startTick = Timer::getTick();
+    BufferHandle outBufHandle = processEffects<T>(frames, post, needsPost);
+    uint64 endTick = Timer::getTick();
+
+    if (RenderTrace::isEnabled())
+    {
+        RenderTrace::record(RenderTrace::k_effectBus, this, NULL, startTick, endTick);
+    }
+
+    // post-processing passes re-render part of the same frames
+    updateRenderLoad(endTick - startTick, post ? 0 : frames);
+
+    return outBufHandle;
+}
+
+template <typename T>
+BufferHandle EffectBusNode::processEffects(int frames, bool post, bool& needsPost)
 {
     BufferHandle inBufHandle = m_input ? m_input->process<T>(frames, post, needsPost) : BufferHandle();
     if (!inBufHandle.isValid())
@@ -86,7 +119,10 @@ BufferHandle EffectBusNode::process(int frames, bool post, bool& needsPost)
                 outBufHandle = acquireBuffer();
             }
 
-            proc->process((T*) inBufHandle.get(), (T*) outBufHandle.get(), frames);
+            {
+                RenderTrace::Scope trace(RenderTrace::k_effect, effect, effect->getName());
+                proc->process((T*) inBufHandle.get(), (T*) outBufHandle.get(), frames);
+            }
 
             if (fxDryEnabled)
             {
@@ -225,6 +261,33 @@ void EffectBusNode::setInput(AudioNode* input)
     m_input = input;
 }
 
+float EffectBusNode::getRenderLoad() const
+{
+    FloatBits bits;
+    bits.i = Atomic::loadAcquire(&m_renderLoad);
+    return bits.f;
+}
+
+void EffectBusNode::updateRenderLoad(uint64 ticks, int frames)
+{
+    // average over about 100 ms of audio
+    m_loadTicks += ticks;
+    m_loadFrames += frames;
+    int sampleRate = getSampleRate();
+    if (m_loadFrames >= sampleRate / 10)
+    {
+        float renderMs = Timer::getMsPerTick() * m_loadTicks;
+        float audioMs = m_loadFrames * 1000.0f / sampleRate;
+
+        FloatBits bits;
+        bits.f = renderMs / audioMs;
+        Atomic::storeRelease(&m_renderLoad, bits.i);
+
+        m_loadTicks = 0;
+        m_loadFrames = 0;
+    }
+}
+
 
 }
 
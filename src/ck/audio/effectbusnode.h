@@ -41,6 +41,10 @@ public:
 
     void setInput(AudioNode*);
 
+    // Fraction of real time spent rendering this bus and its inputs, averaged
+    // over about 100 ms; may be called from any thread.
+    float getRenderLoad() const;
+
 #if CK_DEBUG
     virtual void print(int level);
 #endif
@@ -51,8 +55,13 @@ private:
     bool m_bypass;
     float m_wetDry;
     bool m_prevActive;
+    uint64 m_loadTicks;
+    int m_loadFrames;
+    volatile int32 m_renderLoad; // float bits, published to other threads
 
     template <typename T> BufferHandle process(int frames, bool post, bool& needsPost);
+    template <typename T> BufferHandle processEffects(int frames, bool post, bool& needsPost);
+    void updateRenderLoad(uint64 ticks, int frames);
 };
 
 
@@ -6,32 +6,36 @@ namespace Cki
 {
 
 
-void EffectProcessor::process(int* inBuf, int* outBuf, int frames)
+void EffectProcessor::init()
 {
-    processImpl(inBuf, outBuf, frames);
-}
+    s_processFixed = &EffectProcessor::process_default;
+    s_processFloat = &EffectProcessor::process_default;
 
-void EffectProcessor::process(float* inBuf, float* outBuf, int frames)
-{
-    processImpl(inBuf, outBuf, frames);
-}
-
-template <typename T>
-void EffectProcessor::processImpl(T* inBuf, T* outBuf, int frames)
-{
-    if (System::get()->isSimdSupported())
+    // no AVX2 versions; those use SSE
+    if (System::get()->getSimdLevel() >= kCkSimdLevel_Basic)
     {
 #if CK_ARCH_ARM
-        process_neon(inBuf, outBuf, frames);
+        s_processFixed = &EffectProcessor::process_neon;
+        s_processFloat = &EffectProcessor::process_neon;
 #else // CK_ARCH_X86
-        process_sse(inBuf, outBuf, frames);
+        s_processFixed = &EffectProcessor::process_sse;
+        s_processFloat = &EffectProcessor::process_sse;
 #endif
     }
-    else
-    {
-        process_default(inBuf, outBuf, frames);
-    }
 }
 
+void EffectProcessor::process(int* inBuf, int* outBuf, int frames)
+{
+    (this->*s_processFixed)(inBuf, outBuf, frames);
+}
+
+void EffectProcessor::process(float* inBuf, float* outBuf, int frames)
+{
+    (this->*s_processFloat)(inBuf, outBuf, frames);
+}
+
+EffectProcessor::ProcessFixedFunc EffectProcessor::s_processFixed = &EffectProcessor::process_default;
+EffectProcessor::ProcessFloatFunc EffectProcessor::s_processFloat = &EffectProcessor::process_default;
+
 
 }
@@ -10,10 +10,13 @@ namespace Cki
 class EffectProcessor : public CkEffectProcessor, public Allocatable 
 {
 public:
+    // choose the process_*() implementations, according to System::getSimdLevel()
+    static void init();
+
     virtual void process(int* inBuf, int* outBuf, int frames);
     virtual void process(float* inBuf, float* outBuf, int frames);
 
-    // these exposed just for dsptest:
+    // these exposed for ckbench:
     virtual void process_default(int* inBuf, int* outBuf, int frames) = 0;
     virtual void process_neon(int* inBuf, int* outBuf, int frames) = 0;
     virtual void process_sse(int* inBuf, int* outBuf, int frames) = 0;
@@ -22,7 +25,10 @@ public:
     virtual void process_sse(float* inBuf, float* outBuf, int frames) = 0;
 
 private:
-    template <typename T> void processImpl(T* inBuf, T* outBuf, int frames);
+    typedef void (EffectProcessor::*ProcessFixedFunc)(int*, int*, int);
+    typedef void (EffectProcessor::*ProcessFloatFunc)(float*, float*, int);
+    static ProcessFixedFunc s_processFixed;
+    static ProcessFloatFunc s_processFloat;
 };
 
 }
@@ -0,0 +1,238 @@
+#include "ck/audio/fft.h"
+#include "ck/core/mem.h"
+#include "ck/core/math.h"
+#include "ck/core/debug.h"
+#include <math.h>
+
+namespace Cki
+{
+
+
+Fft::Fft(int size) :
+    m_size(size),
+    m_mem(NULL),
+    m_cos(NULL),
+    m_sin(NULL),
+    m_passRe(NULL),
+    m_passImForward(NULL),
+    m_passImInverse(NULL),
+    m_bitRev(NULL)
+{
+    CK_ASSERT(size >= 16 && (size & (size - 1)) == 0);
+
+    int half = size / 2;
+    m_mem = (float*) Mem::alloc(half * 5 * sizeof(float) + half * sizeof(int));
+    if (!m_mem)
+    {
+        return;
+    }
+    m_cos = m_mem;
+    m_sin = m_cos + half;
+    m_passRe = m_sin + half;
+    m_passImForward = m_passRe + half;
+    m_passImInverse = m_passImForward + half;
+    m_bitRev = (int*) (m_passImInverse + half);
+
+    // m_cos[j] and m_sin[j] hold exp(2*pi*i*j/size), for j < size/2
+    for (int j = 0; j < half; ++j)
+    {
+        double angle = 2.0 * 3.14159265358979323846 * j / size;
+        m_cos[j] = (float) ::cos(angle);
+        m_sin[j] = (float) ::sin(angle);
+    }
+
+    // The twiddles for a pass are every (half/halfLen)th of the above; they are
+    // copied so each pass reads them contiguously.
+    for (int halfLen = 4; halfLen < half; halfLen *= 2)
+    {
+        int step = half / halfLen;
+        for (int j = 0; j < halfLen; ++j)
+        {
+            m_passRe[halfLen + j] = m_cos[j * step];
+            m_passImForward[halfLen + j] = -m_sin[j * step];
+            m_passImInverse[halfLen + j] = m_sin[j * step];
+        }
+    }
+
+    int bits = 0;
+    while ((1 << bits) < half)
+    {
+        ++bits;
+    }
+    for (int i = 0; i < half; ++i)
+    {
+        int r = 0;
+        for (int b = 0; b < bits; ++b)
+        {
+            r |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        m_bitRev[i] = r;
+    }
+}
+
+Fft::~Fft()
+{
+    Mem::free(m_mem);
+}
+
+void Fft::forward(const float* in, float* re, float* im, PassFunc pass) const
+{
+    // pack even samples into the real parts and odd samples into the imaginary parts
+    int half = m_size / 2;
+    for (int i = 0; i < half; ++i)
+    {
+        int j = m_bitRev[i];
+        re[j] = in[2*i];
+        im[j] = in[2*i + 1];
+    }
+
+    transform(re, im, m_passImForward, pass);
+
+    // Split into the spectrum of the real signal:
+    //   X[k] = E[k] + W^k O[k],  X[half-k] = conj(E[k] - W^k O[k])
+    // where E and O are the spectra of the even and odd samples, and W = exp(-2*pi*i/size).
+    float dc = re[0] + im[0];
+    float nyquist = re[0] - im[0];
+    re[0] = dc;
+    im[0] = nyquist;
+
+    for (int k = 1; k <= half / 2; ++k)
+    {
+        int k2 = half - k;
+        float ar = re[k];
+        float ai = im[k];
+        float br = re[k2];
+        float bi = -im[k2];
+
+        float er = 0.5f * (ar + br);
+        float ei = 0.5f * (ai + bi);
+        // O = (A - B) / 2i
+        float or_ = 0.5f * (ai - bi);
+        float oi = -0.5f * (ar - br);
+
+        float wr = m_cos[k];
+        float wi = -m_sin[k];
+        float tr = wr*or_ - wi*oi;
+        float ti = wr*oi + wi*or_;
+
+        re[k] = er + tr;
+        im[k] = ei + ti;
+        re[k2] = er - tr;
+        im[k2] = -(ei - ti);
+    }
+}
+
+void Fft::inverse(float* re, float* im, float* out, PassFunc pass) const
+{
+    // undo the split (without the factors of 1/2, so the result is scaled by size)
+    int half = m_size / 2;
+    float dc = re[0];
+    float nyquist = im[0];
+    re[0] = dc + nyquist;
+    im[0] = dc - nyquist;
+
+    for (int k = 1; k <= half / 2; ++k)
+    {
+        int k2 = half - k;
+        float xr = re[k];
+        float xi = im[k];
+        float yr = re[k2];
+        float yi = -im[k2];
+
+        float er = xr + yr;
+        float ei = xi + yi;
+        // O = conj(W^k) (X[k] - conj(X[half-k]))
+        float dr = xr - yr;
+        float di = xi - yi;
+        float wr = m_cos[k];
+        float wi = m_sin[k];
+        float or_ = wr*dr - wi*di;
+        float oi = wr*di + wi*dr;
+
+        // Z[k] = E + iO, Z[half-k] = conj(E - iO)
+        re[k] = er - oi;
+        im[k] = ei + or_;
+        re[k2] = er + oi;
+        im[k2] = -(ei - or_);
+    }
+
+    // bit-reverse in place, then inverse transform
+    for (int i = 0; i < half; ++i)
+    {
+        int j = m_bitRev[i];
+        if (j > i)
+        {
+            float t = re[i]; re[i] = re[j]; re[j] = t;
+            t = im[i]; im[i] = im[j]; im[j] = t;
+        }
+    }
+
+    transform(re, im, m_passImInverse, pass);
+
+    for (int i = 0; i < half; ++i)
+    {
+        out[2*i] = re[i];
+        out[2*i + 1] = im[i];
+    }
+}
+
+void Fft::transform(float* re, float* im, const float* passIm, PassFunc pass) const
+{
+    // Iterative radix-2 decimation in time; input is in bit-reversed order.
+    // The first two passes have trivial twiddles (1, and -i or i), so they
+    // are done together here.
+    int half = m_size / 2;
+    float sign = passIm[4 + 2]; // -1 for forward, 1 for inverse
+    for (int i = 0; i < half; i += 4)
+    {
+        float r0 = re[i] + re[i+1];
+        float i0 = im[i] + im[i+1];
+        float r1 = re[i] - re[i+1];
+        float i1 = im[i] - im[i+1];
+        float r2 = re[i+2] + re[i+3];
+        float i2 = im[i+2] + im[i+3];
+        float r3 = re[i+2] - re[i+3];
+        float i3 = im[i+2] - im[i+3];
+
+        // times sign*i
+        float tr = -sign * i3;
+        float ti = sign * r3;
+
+        re[i]   = r0 + r2;
+        im[i]   = i0 + i2;
+        re[i+2] = r0 - r2;
+        im[i+2] = i0 - i2;
+        re[i+1] = r1 + tr;
+        im[i+1] = i1 + ti;
+        re[i+3] = r1 - tr;
+        im[i+3] = i1 - ti;
+    }
+
+    for (int halfLen = 4; halfLen < half; halfLen *= 2)
+    {
+        pass(re, im, m_passRe + halfLen, passIm + halfLen, half, halfLen);
+    }
+}
+
+void Fft::pass_default(float* re, float* im, const float* wr, const float* wi, int n, int halfLen)
+{
+    for (int start = 0; start < n; start += 2 * halfLen)
+    {
+        float* reA = re + start;
+        float* imA = im + start;
+        float* reB = reA + halfLen;
+        float* imB = imA + halfLen;
+        for (int j = 0; j < halfLen; ++j)
+        {
+            float tr = wr[j]*reB[j] - wi[j]*imB[j];
+            float ti = wr[j]*imB[j] + wi[j]*reB[j];
+            reB[j] = reA[j] - tr;
+            imB[j] = imA[j] - ti;
+            reA[j] += tr;
+            imA[j] += ti;
+        }
+    }
+}
+
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/core/allocatable.h"
+
+namespace Cki
+{
+
+
+// Real FFT of a fixed power-of-2 size, computed with a complex FFT of half
+// the size.  Spectra are stored in split form: size/2 real parts and size/2
+// imaginary parts.  Since the DC and Nyquist terms of a real signal are both
+// real, the Nyquist term is stored in the imaginary part of bin 0.
+class Fft : public Allocatable
+{
+public:
+    // One radix-2 pass of the complex transform, over n complex values in
+    // groups of 2*halfLen (halfLen >= 4); wr and wi are the halfLen twiddles.
+    typedef void (*PassFunc)(float* re, float* im, const float* wr, const float* wi, int n, int halfLen);
+
+    Fft(int size);
+    ~Fft();
+
+    bool isInited() const { return m_cos != NULL; }
+    int getSize() const { return m_size; }
+
+    // in has size samples; re and im have size/2 each.
+    void forward(const float* in, float* re, float* im, PassFunc) const;
+
+    // Inverse of forward(), except that the output is scaled by size.
+    // re and im are overwritten.
+    void inverse(float* re, float* im, float* out, PassFunc) const;
+
+    static void pass_default(float* re, float* im, const float* wr, const float* wi, int n, int halfLen);
+    static void pass_neon(float* re, float* im, const float* wr, const float* wi, int n, int halfLen);
+    static void pass_sse(float* re, float* im, const float* wr, const float* wi, int n, int halfLen);
+
+private:
+    int m_size;
+    float* m_mem;
+    float* m_cos;     // twiddles for splitting the result of the complex FFT
+    float* m_sin;
+    float* m_passRe;  // twiddles for each pass, halfLen of them starting at index halfLen
+    float* m_passImForward;
+    float* m_passImInverse;
+    int* m_bitRev;
+
+    void transform(float* re, float* im, const float* passIm, PassFunc) const;
+
+    Fft(const Fft&);
+    Fft& operator=(const Fft&);
+};
+
+
+}
@@ -0,0 +1,45 @@
+#include "ck/audio/fft.h"
+#include "ck/core/debug.h"
+
+#if CK_ARM_NEON
+#  include <arm_neon.h>
+#endif
+
+namespace Cki
+{
+
+
+#if CK_ARM_NEON
+void Fft::pass_neon(float* re, float* im, const float* wr, const float* wi, int n, int halfLen)
+{
+    CK_ASSERT(halfLen % 4 == 0);
+    for (int start = 0; start < n; start += 2 * halfLen)
+    {
+        float* reA = re + start;
+        float* imA = im + start;
+        float* reB = reA + halfLen;
+        float* imB = imA + halfLen;
+        for (int j = 0; j < halfLen; j += 4)
+        {
+            float32x4_t w_r = vld1q_f32(wr + j);
+            float32x4_t w_i = vld1q_f32(wi + j);
+            float32x4_t br = vld1q_f32(reB + j);
+            float32x4_t bi = vld1q_f32(imB + j);
+            float32x4_t ar = vld1q_f32(reA + j);
+            float32x4_t ai = vld1q_f32(imA + j);
+
+            float32x4_t tr = vmlsq_f32(vmulq_f32(w_r, br), w_i, bi);
+            float32x4_t ti = vmlaq_f32(vmulq_f32(w_r, bi), w_i, br);
+            vst1q_f32(reB + j, vsubq_f32(ar, tr));
+            vst1q_f32(imB + j, vsubq_f32(ai, ti));
+            vst1q_f32(reA + j, vaddq_f32(ar, tr));
+            vst1q_f32(imA + j, vaddq_f32(ai, ti));
+        }
+    }
+}
+#else
+void Fft::pass_neon(float* re, float* im, const float* wr, const float* wi, int n, int halfLen) {}
+#endif
+
+
+}
@@ -0,0 +1,45 @@
+#include "ck/audio/fft.h"
+#include "ck/core/debug.h"
+
+#if CK_X86_SSE
+#  include <xmmintrin.h>
+#endif
+
+namespace Cki
+{
+
+
+#if CK_X86_SSE
+void Fft::pass_sse(float* re, float* im, const float* wr, const float* wi, int n, int halfLen)
+{
+    CK_ASSERT(halfLen % 4 == 0);
+    for (int start = 0; start < n; start += 2 * halfLen)
+    {
+        float* reA = re + start;
+        float* imA = im + start;
+        float* reB = reA + halfLen;
+        float* imB = imA + halfLen;
+        for (int j = 0; j < halfLen; j += 4)
+        {
+            __m128 w_r = _mm_loadu_ps(wr + j);
+            __m128 w_i = _mm_loadu_ps(wi + j);
+            __m128 br = _mm_loadu_ps(reB + j);
+            __m128 bi = _mm_loadu_ps(imB + j);
+            __m128 ar = _mm_loadu_ps(reA + j);
+            __m128 ai = _mm_loadu_ps(imA + j);
+
+            __m128 tr = _mm_sub_ps(_mm_mul_ps(w_r, br), _mm_mul_ps(w_i, bi));
+            __m128 ti = _mm_add_ps(_mm_mul_ps(w_r, bi), _mm_mul_ps(w_i, br));
+            _mm_storeu_ps(reB + j, _mm_sub_ps(ar, tr));
+            _mm_storeu_ps(imB + j, _mm_sub_ps(ai, ti));
+            _mm_storeu_ps(reA + j, _mm_add_ps(ar, tr));
+            _mm_storeu_ps(imA + j, _mm_add_ps(ai, ti));
+        }
+    }
+}
+#else
+void Fft::pass_sse(float* re, float* im, const float* wr, const float* wi, int n, int halfLen) {}
+#endif
+
+
+}
@@ -8,9 +8,14 @@
 #include "ck/core/system.h"
 #include "ck/core/mutexlock.h"
 #include "ck/core/dir.h"
+#include "ck/core/atomic.h"
 #include "ck/core/system_platform.h"
 #include "ck/audio/rawwriter.h"
 #include "ck/audio/wavwriter.h"
+#include "ck/audio/compressorprocessor.h"
+#include "ck/audio/commandtimeline.h"
+#include "ck/audio/rendertrace.h"
+#include "ck/effectparam.h"
 
 //#include "ck/core/profiler.h"
 
@@ -33,7 +38,7 @@ namespace Cki
 
 GraphOutput* GraphOutput::create()
 {
-    if (System::get()->isToolMode())
+    if (System::get()->isToolMode() || System::get()->isOffline())
     {
         return new GraphOutputDummy(true);
     }
@@ -63,18 +68,51 @@ GraphOutput* GraphOutput::create()
 GraphOutput::GraphOutput() :
     m_fixedPoint(System::get()->getSampleType() == kCkSampleType_Fixed),
     m_input(NULL),
+    m_virtualInput(NULL),
     m_playing(false),
     m_clip(false),
+    m_limiter(NULL),
+    m_timeline(NULL),
+    m_sampleTime(0),
     m_captureWriter(NULL),
+    m_sampleTimeSeq(0),
+    m_sampleTimeLo(0),
+    m_sampleTimeHi(0),
     m_renderFrac(0.0f),
     m_renderAvg(m_renderAvgBuf, k_avgCount),
     m_frameAvg(m_frameAvgBuf, k_avgCount)
 {
+    const CkConfig& config = System::get()->getConfig();
+    if (config.outputLimiter)
+    {
+        m_limiter = new CompressorProcessor;
+        if (m_limiter->isInited())
+        {
+            m_limiter->setParam(kCkCompressorParam_Threshold, config.outputLimiterCeiling);
+            m_limiter->setParam(kCkCompressorParam_Ratio, 1000.0f);
+            m_limiter->setParam(kCkCompressorParam_LookaheadMs, 5.0f);
+            m_limiter->setParam(kCkCompressorParam_ReleaseMs, 100.0f);
+            m_limiter->setParam(kCkCompressorParam_TruePeak, 1.0f);
+            m_limiter->reset();
+        }
+        else
+        {
+            CK_LOG_ERROR("Output limiter: could not allocate memory; output will be clipped");
+            delete m_limiter;
+            m_limiter = NULL;
+        }
+    }
 }
 
 GraphOutput::~GraphOutput()
 {
     delete m_captureWriter;
+    delete m_limiter;
+}
+
+float GraphOutput::getGainReduction() const
+{
+    return m_limiter ? m_limiter->getGainReduction() : 0.0f;
 }
 
 void GraphOutput::setInput(AudioNode* input)
@@ -82,6 +120,11 @@ void GraphOutput::setInput(AudioNode* input)
     m_input = input;
 }
 
+void GraphOutput::setVirtualInput(AudioNode* input)
+{
+    m_virtualInput = input;
+}
+
 void GraphOutput::setPreRenderCallback(Callback0::Func cb, void* data)
 {
     m_preRenderCallback.set(cb, data);
@@ -92,6 +135,37 @@ void GraphOutput::setPostRenderCallback(Callback0::Func cb, void* data)
     m_postRenderCallback.set(cb, data);
 }
 
+void GraphOutput::setTimeline(CommandTimeline* timeline)
+{
+    m_timeline = timeline;
+}
+
+int64 GraphOutput::getSampleTime() const
+{
+    // the acquire loads keep these reads in order; retry if the render thread
+    // was writing, or wrote in between
+    for (;;)
+    {
+        int32 seq = Atomic::loadAcquire(&m_sampleTimeSeq);
+        uint32 lo = (uint32) Atomic::loadAcquire(&m_sampleTimeLo);
+        int32 hi = Atomic::loadAcquire(&m_sampleTimeHi);
+        if (!(seq & 1) && Atomic::loadAcquire(&m_sampleTimeSeq) == seq)
+        {
+            return ((int64) hi << 32) | lo;
+        }
+    }
+}
+
+void GraphOutput::publishSampleTime()
+{
+    // render thread only; each release store keeps the stores before it in order
+    int32 seq = m_sampleTimeSeq;
+    Atomic::storeRelease(&m_sampleTimeSeq, seq + 1);
+    Atomic::storeRelease(&m_sampleTimeLo, (int32) (uint32) m_sampleTime);
+    Atomic::storeRelease(&m_sampleTimeHi, (int32) (m_sampleTime >> 32));
+    Atomic::storeRelease(&m_sampleTimeSeq, seq + 2);
+}
+
 void GraphOutput::start()
 {
     if (!m_playing)
@@ -139,6 +213,8 @@ bool GraphOutput::render(T* buf, int frames)
     m_frameTimer.start();
     m_renderTimer.start();
 
+    RenderTrace::Scope trace(RenderTrace::k_render, this);
+
     const int k_numChannels = AudioNode::k_maxChannels;
 
 //prof.start();
@@ -172,6 +248,29 @@ bool GraphOutput::render(T* buf, int frames)
             --divs;
         }
 
+        if (m_timeline)
+        {
+            // run the commands scheduled for this frame, and end this chunk at
+            // the next one, so each takes effect at exactly its frame
+            framesToRender = m_timeline->execute(m_sampleTime, framesToRender);
+        }
+
+        // scratch buffers from the previous quantum are no longer needed
+        AudioNode::getScratchArena()->reset();
+
+        if (m_virtualInput)
+        {
+            // before the input, so sounds started by virtual sounds that
+            // finish in this quantum are rendered in the input's post-process
+            bool post = false;
+            m_virtualInput->process<T>(framesToRender, false, post);
+            while (post)
+            {
+                post = false;
+                m_virtualInput->process<T>(framesToRender, true, post);
+            }
+        }
+
         if (m_input)
         {
             bool post = false;
@@ -188,20 +287,31 @@ bool GraphOutput::render(T* buf, int frames)
                         AudioUtil::mix((const T*) nextHandle.get(), (T*) inHandle.get(), k_numChannels * framesToRender);
                     }
                 }
+                if (m_limiter)
+                {
+                    // the clamp then only catches what the limiter misses,
+                    // such as with a ceiling of 0 dB
+                    m_limiter->process((T*) inHandle.get(), (T*) inHandle.get(), framesToRender);
+                }
                 m_clip |= AudioUtil::clamp((const T*) inHandle.get(), buf, k_numChannels * framesToRender);
             }
         }
 
         if (!inHandle.isValid())
         {
-            Mem::clear(buf, k_numChannels * frames * sizeof(T));
+            Mem::clear(buf, k_numChannels * framesToRender * sizeof(T));
+            if (m_limiter)
+            {
+                // the rest of the audio in the limiter's delay
+                m_limiter->process(buf, buf, framesToRender);
+            }
         }
 
         {
             MutexLock lock(m_captureMutex);
             if (m_captureWriter)
             {
-                int samples = k_numChannels * frames;
+                int samples = k_numChannels * framesToRender;
                 if (m_captureWriter->write(buf, samples) != samples)
                 {
                     CK_LOG_ERROR("Capture failed; closing file");
@@ -211,6 +321,9 @@ bool GraphOutput::render(T* buf, int frames)
             }
         }
 
+        m_sampleTime += framesToRender;
+        publishSampleTime();
+
         frames -= framesToRender;
         buf += framesToRender * k_numChannels;
     }
@@ -13,6 +13,8 @@ namespace Cki
 {
 
 class AudioWriter;
+class CompressorProcessor;
+class CommandTimeline;
 
 class GraphOutput : public Allocatable
 {
@@ -22,9 +24,20 @@ public:
 
     void setInput(AudioNode*);
 
+    // Processed along with the input, but its output is discarded; for
+    // sources that are playing but not heard.
+    void setVirtualInput(AudioNode*);
+
     void setPreRenderCallback(Callback0::Func, void* data);
     void setPostRenderCallback(Callback0::Func, void* data);
 
+    // Commands in the timeline are executed at their sample times during render.
+    void setTimeline(CommandTimeline*);
+
+    // Sample time: the number of frames rendered so far, which is the time of
+    // the next frame to be rendered.  Can be called from any thread.
+    int64 getSampleTime() const;
+
     void start();
     void stop();
     bool isRunning() const;
@@ -32,6 +45,9 @@ public:
     bool getClipFlag() const { return m_clip; }
     void resetClipFlag() { m_clip = false; }
 
+    // gain reduction of the output limiter, in dB; 0 if there is none
+    float getGainReduction() const;
+
     float getRenderLoad() const { return m_renderFrac; }
     float getRenderMs() const { return m_renderTimer.getElapsedMs(); }
 
@@ -50,13 +66,24 @@ protected:
 
 private:
     AudioNode* m_input;
+    AudioNode* m_virtualInput;
     Callback0 m_preRenderCallback;
     Callback0 m_postRenderCallback;
     bool m_playing;
     bool m_clip;
+    CompressorProcessor* m_limiter;
+    CommandTimeline* m_timeline;
+    int64 m_sampleTime;
     AudioWriter* m_captureWriter;
     Mutex m_captureMutex;
 
+    // m_sampleTime, published to other threads; m_sampleTimeSeq is odd while
+    // the halves are being written
+    volatile int32 m_sampleTimeSeq;
+    volatile int32 m_sampleTimeLo;
+    volatile int32 m_sampleTimeHi;
+    void publishSampleTime();
+
     // profiling:
     Timer m_renderTimer;
     Timer m_frameTimer;
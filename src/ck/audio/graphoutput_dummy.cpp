@@ -1,5 +1,9 @@
 #include "ck/audio/graphoutput_dummy.h"
+#include "ck/audio/streamscheduler.h"
+#include "ck/audio/audioutil.h"
 #include "ck/core/debug.h"
+#include "ck/core/math.h"
+#include "ck/core/system.h"
 #include "ck/core/thread.h"
 #include "ck/core/mem.h"
 
@@ -88,6 +92,55 @@ void GraphOutputDummy::poll()
     s_inst->doRender();
 }
 
+bool GraphOutputDummy::renderOffline(float* buf, int frames)
+{
+    CK_ASSERT(!s_inst->m_thread);
+    return s_inst->doRenderOffline(buf, frames);
+}
+
+bool GraphOutputDummy::doRenderOffline(float* buf, int frames)
+{
+    const int k_numChannels = AudioNode::k_maxChannels;
+
+    if (!isRunning())
+    {
+        Mem::clear(buf, k_numChannels * frames * sizeof(float));
+        return false;
+    }
+
+    // There are no stream file threads in offline mode, so stream buffers are
+    // topped up here.  Blocks are never longer than one audio update, which is
+    // much less than half a stream buffer, so streams can't underrun.
+    float updateMs = System::get()->getConfig().audioUpdateMs;
+    int maxBlockFrames = Math::max(1, (int) (AudioNode::getSampleRate() * updateMs * 0.001f));
+    if (m_fixedPoint)
+    {
+        maxBlockFrames = Math::min(maxBlockFrames, k_frames); // rendered into m_buf
+    }
+    bool rendered = false;
+    while (frames > 0)
+    {
+        int blockFrames = Math::min(frames, maxBlockFrames);
+
+        StreamScheduler::get()->fillAll();
+
+        if (m_fixedPoint)
+        {
+            rendered |= render((int32*) m_buf, blockFrames);
+            AudioUtil::convert((const int32*) m_buf, buf, k_numChannels * blockFrames);
+        }
+        else
+        {
+            rendered |= render(buf, blockFrames);
+        }
+
+        frames -= blockFrames;
+        buf += k_numChannels * blockFrames;
+    }
+
+    return rendered;
+}
+
 
 }
 
@@ -16,6 +16,10 @@ public:
 
     static void poll();
 
+    // Render into the caller's buffer (interleaved stereo float), in offline mode.
+    // Returns true if anything was rendered.
+    static bool renderOffline(float* buf, int frames);
+
 protected:
     virtual void startImpl();
     virtual void stopImpl();
@@ -28,6 +32,7 @@ private:
 
     void threadLoop();
     void doRender();
+    bool doRenderOffline(float* buf, int frames);
     static void* threadFunc(void* arg);
 };
 
@@ -3,6 +3,7 @@
 #include "ck/audio/audiosource.h"
 #include "ck/audio/sourcenode.h"
 #include "ck/audio/mixnode.h"
+#include "ck/audio/mixer.h"
 #include "ck/core/logger.h"
 #include "ck/core/math.h"
 
@@ -22,6 +23,7 @@ GraphSound::GraphSound() :
     m_fx(NULL),
     m_inited(false),
     m_playing(false),
+    m_scheduled(false),
     m_loopCount(0),
     m_loopStart(0),
     m_loopEnd(-1),
@@ -147,8 +149,7 @@ int GraphSound::getLength() const
 {
     if (m_source->isInited())
     {
-        const SampleInfo& info = m_source->getSampleInfo();
-        return info.blocks * info.blockFrames;
+        return m_source->getNumFrames();
     }
     else
     {
@@ -161,8 +162,7 @@ float GraphSound::getLengthMs() const
     if (m_source->isInited())
     {
         const SampleInfo& info = m_source->getSampleInfo();
-        int frames = info.blocks * info.blockFrames;
-        return 1000.0f * frames / info.sampleRate;
+        return 1000.0f * m_source->getNumFrames() / info.sampleRate;
     }
     else
     {
@@ -205,17 +205,26 @@ EffectBus* GraphSound::getEffectBus()
     return m_fx;
 }
 
-void GraphSound::updateVolumeAndPan()
+void GraphSound::updateVolumeAndPan(int64 time)
 {
     if (m_inited)
     {
         AudioGraph* graph = AudioGraph::get();
 
         VolumeMatrix volMat;
-        getFinalVolumeMatrix(volMat);
+        getSourceVolumeMatrix(volMat);
 
-        graph->execute(&m_sourceNode, SourceNode::k_setVolumeL, volMat.ll, volMat.lr);
-        graph->execute(&m_sourceNode, SourceNode::k_setVolumeR, volMat.rl, volMat.rr);
+        if (time < 0)
+        {
+            graph->executeCoalesced(&m_sourceNode, SourceNode::k_setVolumeL, volMat.ll, volMat.lr);
+            graph->executeCoalesced(&m_sourceNode, SourceNode::k_setVolumeR, volMat.rl, volMat.rr);
+        }
+        else
+        {
+            graph->executeAt(time, &m_sourceNode, SourceNode::k_setVolumeL, volMat.ll, volMat.lr);
+            graph->executeAt(time, &m_sourceNode, SourceNode::k_setVolumeR, volMat.rl, volMat.rr);
+            m_scheduled = true;
+        }
     }
 }
 
@@ -239,7 +248,7 @@ void GraphSound::subInit(AudioSource* source)
     Sound::update();
 }
 
-void GraphSound::playSub()
+void GraphSound::playSub(int64 time)
 {
     if (!m_inited && m_source->isInited())
     {
@@ -253,14 +262,16 @@ void GraphSound::playSub()
     }
 
     AudioGraph* graph = AudioGraph::get();
-    graph->execute(&m_sourceNode, SourceNode::k_setPlaying, m_playId);
+    graph->executeAt(time, &m_sourceNode, SourceNode::k_setPlaying, m_playId);
 
-    if (!isVirtual())
-    {
-        graph->execute(&m_sourceNode, SourceNode::k_connect);
-    }
+    // virtual sounds are connected to the virtual mixer, to keep track of their position
+    graph->executeAt(time, &m_sourceNode, SourceNode::k_connect);
 
     m_playing = true;
+    if (time >= 0)
+    {
+        m_scheduled = true;
+    }
 }
 
 void GraphSound::updateSub()
@@ -280,12 +291,30 @@ void GraphSound::updateSub()
     }
 }
 
-void GraphSound::stopSub()
+void GraphSound::stopSub(int64 time)
 {
+    AudioGraph* graph = AudioGraph::get();
+
+    if (time < 0 && m_scheduled)
+    {
+        // stopping now overrides anything scheduled; this also ensures nothing
+        // is left in the timeline when the sound is destroyed
+        graph->cancelScheduled(&m_sourceNode);
+        m_scheduled = false;
+    }
+
     if (isPlaying())
     {
-        AudioGraph::get()->execute(&m_sourceNode, SourceNode::k_setPlaying, 0);
-        m_playing = false;
+        graph->executeAt(time, &m_sourceNode, SourceNode::k_setPlaying, 0);
+        if (time < 0)
+        {
+            m_playing = false;
+        }
+        else
+        {
+            // still playing until the audio thread stops it; see updateSub()
+            m_scheduled = true;
+        }
     }
 }
 
@@ -304,25 +333,32 @@ void GraphSound::updateSpeed()
     if (m_inited)
     {
         float speed = getFinalSpeed();
-        AudioGraph::get()->execute(&m_sourceNode, SourceNode::k_setSpeed, speed);
+        AudioGraph::get()->executeCoalesced(&m_sourceNode, SourceNode::k_setSpeed, speed);
     }
 }
 
-void GraphSound::updateVirtual()
+void GraphSound::updateResampleQuality()
 {
-    if (m_playing)
+    if (m_inited)
     {
-        if (isVirtual())
-        {
-            AudioGraph::get()->execute(&m_sourceNode, SourceNode::k_disconnect);
-        }
-        else
-        {
-            AudioGraph::get()->execute(&m_sourceNode, SourceNode::k_connect);
-        }
+        AudioGraph::get()->execute(&m_sourceNode, SourceNode::k_setResampleQuality, (int) getFinalResampleQuality());
+    }
+}
+
+void GraphSound::updateMixerGain()
+{
+    if (m_inited)
+    {
+        AudioGraph::get()->execute(&m_sourceNode, SourceNode::k_setMixerGain, m_mixer->getGain());
     }
 }
 
+void GraphSound::updateVirtual()
+{
+    // the source keeps playing while virtual, but is not resampled or mixed
+    AudioGraph::get()->execute(&m_sourceNode, SourceNode::k_setVirtual, isVirtual());
+}
+
 
 ////////////////////////////////////////
 
@@ -347,12 +383,17 @@ void GraphSound::init()
         m_loopCount = m_source->getLoopCount();
 
         updateMixNode();
+        updateMixerGain();
 
-        m_decoder.init(*m_source);
+        m_decoder.init(*m_source, acquireCached());
         AudioGraph::get()->execute(&m_sourceNode, SourceNode::k_setDecoder, m_decoder.get());
 
         m_inited = true;
         updateVolumeAndPan();
+        if (getFinalResampleQuality() != kCkResampleQuality_Linear)
+        {
+            updateResampleQuality();
+        }
     }
 }
 
@@ -51,24 +51,29 @@ public:
     virtual void setEffectBus(CkEffectBus*);
     virtual EffectBus* getEffectBus();
 
-    virtual void updateVolumeAndPan(); // should be called only by mixer!
+    virtual void updateVolumeAndPan(int64 time = -1); // should be called only by mixer!
 
     virtual SourceNode* getSourceNode();
 
 protected:
     void subInit(AudioSource*); // call in subclass ctor
 
-    virtual void playSub();
+    virtual void playSub(int64 time);
     virtual void updateSub();
-    virtual void stopSub();
+    virtual void stopSub(int64 time);
     virtual bool isReadySub() const;
 
     virtual void updatePaused();
     virtual void updateSpeed();
+    virtual void updateResampleQuality();
     virtual void updateVirtual();
+    virtual void updateMixerGain();
 
     virtual void updateSeek() {}
 
+    // decoded data from the DecodeCache, if any, to play instead of decoding
+    virtual DecodeCache::Entry* acquireCached() { return NULL; }
+
 protected:
     AudioSource* m_source;
     DecoderBuf m_decoder;
@@ -77,6 +82,7 @@ protected:
     EffectBus* m_fx;
     bool m_inited;
     bool m_playing;
+    bool m_scheduled; // if true, commands may be waiting for their sample time
 
 private:
     int m_loopCount;
@@ -0,0 +1,284 @@
+#include "ck/audio/impulseresponse.h"
+#include "ck/audio/sample.h"
+#include "ck/audio/buffersource.h"
+#include "ck/audio/decoderbuf.h"
+#include "ck/audio/audionode.h"
+#include "ck/audio/fourcharcode.h"
+#include "ck/core/readstream.h"
+#include "ck/core/swapstream.h"
+#include "ck/core/math.h"
+#include "ck/core/mem.h"
+#include "ck/core/debug.h"
+#include "ck/core/logger.h"
+
+namespace Cki
+{
+
+
+namespace
+{
+    // Trailing samples quieter than this (relative to the peak) are dropped,
+    // since every frame of the impulse response costs processing time.
+    const float k_silence = 1.0e-4f;
+
+    // reads the sample data of a RIFF WAVE file; see cktool's WavReader
+    float* readWav(BinaryStream& file, int& frames, int& channels, int& sampleRate)
+    {
+        SwapStream stream(file, ByteOrder::k_littleEndian);
+        if (stream.getSize() < 12)
+        {
+            return NULL;
+        }
+
+        FourCharCode chunkId;
+        stream >> chunkId;
+        uint32 riffSize;
+        stream >> riffSize;
+        FourCharCode formatId;
+        stream >> formatId;
+        if (chunkId != FourCharCode('R', 'I', 'F', 'F') || formatId != FourCharCode('W', 'A', 'V', 'E'))
+        {
+            return NULL;
+        }
+
+        int format = 0;
+        int bitsPerSample = 0;
+        channels = 0;
+        sampleRate = 0;
+        while (stream.getPos() + 8 <= stream.getSize())
+        {
+            uint32 chunkSize;
+            stream >> chunkId;
+            stream >> chunkSize;
+            int endPos = stream.getPos() + (int) chunkSize;
+            if (endPos & 1)
+            {
+                endPos += 1; // pad byte
+            }
+
+            if (chunkId == FourCharCode('f', 'm', 't', ' '))
+            {
+                uint16 formatTag, numChannels, blockAlign, bits;
+                uint32 samplesPerSec, bytesPerSec;
+                stream >> formatTag >> numChannels >> samplesPerSec >> bytesPerSec >> blockAlign >> bits;
+                if (formatTag == 0xfffe && chunkSize >= 26)
+                {
+                    // WAVE_FORMAT_EXTENSIBLE; the format is the start of the subformat GUID
+                    stream.skip(8);
+                    stream >> formatTag;
+                }
+                format = formatTag;
+                channels = numChannels;
+                sampleRate = (int) samplesPerSec;
+                bitsPerSample = bits;
+            }
+            else if (chunkId == FourCharCode('d', 'a', 't', 'a') && channels > 0)
+            {
+                bool isFloat = (format == 3 && bitsPerSample == 32);
+                bool isInt = (format == 1 && (bitsPerSample == 8 || bitsPerSample == 16 || bitsPerSample == 24 || bitsPerSample == 32));
+                if (!isFloat && !isInt)
+                {
+                    return NULL;
+                }
+
+                int sampleBytes = bitsPerSample / 8;
+                int samples = Math::min((int) chunkSize, stream.getSize() - stream.getPos()) / sampleBytes;
+                frames = samples / channels;
+                samples = frames * channels;
+                float* data = (float*) Mem::alloc(Math::max(samples, 1) * sizeof(float));
+                if (!data)
+                {
+                    return NULL;
+                }
+
+                for (int i = 0; i < samples; ++i)
+                {
+                    byte b[4] = { 0 };
+                    stream.read(b, sampleBytes);
+                    float value;
+                    if (isFloat)
+                    {
+                        uint32 bits32 = b[0] | (b[1] << 8) | (b[2] << 16) | ((uint32) b[3] << 24);
+                        Mem::copy(&value, &bits32, sizeof(value));
+                    }
+                    else if (sampleBytes == 1)
+                    {
+                        value = (b[0] - 128) * (1.0f / 128.0f); // 8-bit is unsigned
+                    }
+                    else
+                    {
+                        // sign-extend from the top byte
+                        int32 v = (int32) ((uint32) b[sampleBytes - 1] << 24);
+                        for (int j = 0; j < sampleBytes - 1; ++j)
+                        {
+                            v |= (int32) b[j] << (8 * (j + 4 - sampleBytes));
+                        }
+                        value = v * (1.0f / 2147483648.0f);
+                    }
+                    data[i] = value;
+                }
+                return data;
+            }
+
+            stream.setPos(endPos);
+        }
+
+        return NULL;
+    }
+}
+
+
+ImpulseResponse::ImpulseResponse() :
+    m_data(NULL),
+    m_frames(0),
+    m_channels(0)
+{
+}
+
+ImpulseResponse::~ImpulseResponse()
+{
+    Mem::free(m_data);
+}
+
+bool ImpulseResponse::load(const Sample& sample)
+{
+    const SampleInfo& info = sample.info;
+    int frames = info.blocks * info.blockFrames;
+    float* buf = (float*) Mem::alloc(Math::max(frames, 1) * info.channels * sizeof(float));
+    if (!buf)
+    {
+        return false;
+    }
+
+    // play it through once, as a sound would
+    BufferSource source(sample);
+    source.setLoopCount(0);
+    DecoderBuf decoder;
+    decoder.init(source);
+
+    int framesRead = 0;
+    while (framesRead < frames && !decoder.get()->isDone())
+    {
+        int n = decoder.get()->decode(buf + framesRead * info.channels, frames - framesRead);
+        if (n <= 0)
+        {
+            break;
+        }
+        framesRead += n;
+    }
+
+    bool result = setData(buf, framesRead, info.channels, info.sampleRate);
+    Mem::free(buf);
+    return result;
+}
+
+bool ImpulseResponse::load(const char* path, CkPathType pathType)
+{
+    ReadStream stream(path, pathType);
+    if (!stream.isValid())
+    {
+        CK_LOG_ERROR("Could not open impulse response file \"%s\"", path);
+        return false;
+    }
+
+    int frames = 0;
+    int channels = 0;
+    int sampleRate = 0;
+    float* buf = readWav(stream, frames, channels, sampleRate);
+    if (!buf)
+    {
+        CK_LOG_ERROR("Could not read impulse response file \"%s\"; it should be a PCM or 32-bit float .wav file", path);
+        return false;
+    }
+
+    bool result = setData(buf, frames, channels, sampleRate);
+    Mem::free(buf);
+    return result;
+}
+
+bool ImpulseResponse::setData(const float* interleaved, int frames, int channels, int sampleRate)
+{
+    if (channels < 1 || channels > 2 || sampleRate <= 0)
+    {
+        CK_LOG_ERROR("Impulse response must be mono or stereo");
+        return false;
+    }
+
+    // drop trailing silence
+    float peak = 0.0f;
+    for (int i = 0; i < frames * channels; ++i)
+    {
+        peak = Math::max(peak, Math::abs(interleaved[i]));
+    }
+    while (frames > 0)
+    {
+        bool silent = true;
+        for (int c = 0; c < channels; ++c)
+        {
+            silent &= (Math::abs(interleaved[(frames - 1) * channels + c]) <= peak * k_silence);
+        }
+        if (!silent)
+        {
+            break;
+        }
+        --frames;
+    }
+
+    if (frames == 0)
+    {
+        CK_LOG_ERROR("Impulse response is silent");
+        return false;
+    }
+
+    // resample (linearly) to the output rate, and separate the channels
+    int outputRate = AudioNode::getSampleRate();
+    float factor = (float) sampleRate / outputRate;
+    int outFrames = Math::max(1, (int) ((frames - 1) / factor) + 1);
+
+    Mem::free(m_data);
+    m_data = (float*) Mem::alloc(outFrames * channels * sizeof(float));
+    if (!m_data)
+    {
+        m_frames = m_channels = 0;
+        return false;
+    }
+    m_frames = outFrames;
+    m_channels = channels;
+
+    for (int c = 0; c < channels; ++c)
+    {
+        float* out = m_data + c * outFrames;
+        for (int i = 0; i < outFrames; ++i)
+        {
+            float pos = i * factor;
+            int i0 = Math::min((int) pos, frames - 1);
+            int i1 = Math::min(i0 + 1, frames - 1);
+            float frac = pos - i0;
+            out[i] = interleaved[i0 * channels + c] * (1.0f - frac) + interleaved[i1 * channels + c] * frac;
+        }
+    }
+
+    // Normalize so that the louder channel has unit energy; this keeps the
+    // level of a broadband signal about the same after convolution.
+    float maxEnergy = 0.0f;
+    for (int c = 0; c < channels; ++c)
+    {
+        const float* p = getData(c);
+        float energy = 0.0f;
+        for (int i = 0; i < outFrames; ++i)
+        {
+            energy += p[i] * p[i];
+        }
+        maxEnergy = Math::max(maxEnergy, energy);
+    }
+    float scale = 1.0f / Math::sqrt(maxEnergy);
+    for (int i = 0; i < outFrames * channels; ++i)
+    {
+        m_data[i] *= scale;
+    }
+
+    return true;
+}
+
+
+}
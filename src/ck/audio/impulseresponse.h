@@ -0,0 +1,42 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/core/allocatable.h"
+#include "ck/pathtype.h"
+
+namespace Cki
+{
+
+struct Sample;
+
+
+// Impulse response for a convolution reverb, decoded to floating point at the
+// output sample rate.  Mono or stereo; channels are stored one after another.
+class ImpulseResponse : public Allocatable
+{
+public:
+    ImpulseResponse();
+    ~ImpulseResponse();
+
+    // Each returns false (and logs an error) if the impulse response can't be loaded.
+    bool load(const Sample&);
+    bool load(const char* path, CkPathType); // .wav file
+
+    // from interleaved samples at any sample rate
+    bool setData(const float* interleaved, int frames, int channels, int sampleRate);
+
+    int getChannels() const { return m_channels; }
+    int getFrames() const { return m_frames; }
+    const float* getData(int channel) const { return m_data + channel * m_frames; }
+
+private:
+    float* m_data;
+    int m_frames;
+    int m_channels;
+
+    ImpulseResponse(const ImpulseResponse&);
+    ImpulseResponse& operator=(const ImpulseResponse&);
+};
+
+
+}
@@ -0,0 +1,690 @@
+#include "ck/audio/lossless.h"
+#include "ck/core/debug.h"
+#include "ck/core/math.h"
+#include "ck/core/mem.h"
+#ifdef _MSC_VER
+#  include <intrin.h>
+#endif
+
+namespace Cki
+{
+
+namespace
+{
+    // Block layout:
+    //   1 byte: channel mode
+    //   for each channel, packed MSB first:
+    //     3 bits: subblock type
+    //     constant: 1 sample
+    //     verbatim: k_blockFrames samples
+    //     fixed predictor of order N:
+    //       N warmup samples
+    //       2 bits: partition order P
+    //       for each of the 2^P partitions:
+    //         5 bits: Rice parameter K
+    //         residuals of the partition (the first partition omits the
+    //         warmup samples), zigzag and Rice coded with parameter K
+    //   padding to a whole byte
+    // Samples are 16 bits, or 17 bits for a side (difference) channel.
+
+    enum ChannelMode
+    {
+        k_leftRight,
+        k_leftSide,
+        k_sideRight,
+        k_midSide
+    };
+
+    enum SubblockType
+    {
+        // 0 to k_maxOrder: fixed predictor of that order
+        k_constant = 5,
+        k_verbatim = 6
+    };
+
+    const int k_maxOrder = 4;
+    const int k_maxPartitionOrder = 3;
+    const int k_maxPartitions = 1 << k_maxPartitionOrder;
+    const int k_maxRiceParam = 24;
+
+    const int k_modeBytes = 1;
+    const int k_typeBits = 3;
+    const int k_partitionOrderBits = 2;
+    const int k_riceParamBits = 5;
+
+    const int k_sampleBits = 16;
+    const int k_sideSampleBits = 17;
+
+    inline uint32 zigzag(int32 value)
+    {
+        return (uint32) ((value << 1) ^ (value >> 31));
+    }
+
+    inline int32 unzigzag(uint32 value)
+    {
+        return (int32) (value >> 1) ^ -(int32) (value & 1);
+    }
+
+    inline int32 signExtend(uint32 value, int bits)
+    {
+        return ((int32) (value << (32 - bits))) >> (32 - bits);
+    }
+
+    inline int countLeadingZeros(uint32 value)
+    {
+        CK_ASSERT(value);
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanReverse(&index, value);
+        return 31 - (int) index;
+#else
+        return __builtin_clz(value);
+#endif
+    }
+
+    // bytewise, since the block offset table may not be aligned
+    inline uint32 readUint32(const byte* p)
+    {
+        return (uint32) p[0] | ((uint32) p[1] << 8) | ((uint32) p[2] << 16) | ((uint32) p[3] << 24);
+    }
+
+    inline void writeUint32(byte* p, uint32 value)
+    {
+        p[0] = (byte) value;
+        p[1] = (byte) (value >> 8);
+        p[2] = (byte) (value >> 16);
+        p[3] = (byte) (value >> 24);
+    }
+
+    // decoded samples, in the format of each output buffer type (as for PCM)
+    inline void store(int32 sample, int16* p) { *p = (int16) sample; }
+    inline void store(int32 sample, int32* p) { *p = sample << 9; } // 8.24; 9 because of sign bit
+    inline void store(int32 sample, float* p) { *p = sample * (1.0f / CK_INT16_MAX); }
+
+
+    ////////////////////////////////////////
+    // encoding
+
+    class BitWriter
+    {
+    public:
+        BitWriter(byte* output) : m_start(output), m_output(output), m_value(0), m_bits(0) {}
+
+        void write(uint32 value, int bits)
+        {
+            CK_ASSERT(bits >= 0 && bits <= 24);
+            m_value = (m_value << bits) | (value & ((1u << bits) - 1));
+            m_bits += bits;
+            while (m_bits >= 8)
+            {
+                m_bits -= 8;
+                *m_output++ = (byte) (m_value >> m_bits);
+            }
+        }
+
+        void writeRice(uint32 value, int param)
+        {
+            uint32 quotient = value >> param;
+            while (quotient >= 24)
+            {
+                write(0, 24);
+                quotient -= 24;
+            }
+            write(1, (int) quotient + 1); // unary
+            write(value, param);
+        }
+
+        // pad to a whole byte; returns the number of bytes written
+        int finish()
+        {
+            if (m_bits > 0)
+            {
+                write(0, 8 - m_bits);
+            }
+            return (int) (m_output - m_start);
+        }
+
+    private:
+        byte* m_start;
+        byte* m_output;
+        uint32 m_value; // low m_bits bits are not yet written
+        int m_bits;
+    };
+
+    // how one channel of a block is coded
+    struct Subblock
+    {
+        int type;
+        int partitionOrder;
+        int riceParams[k_maxPartitions];
+        uint32 bits;
+    };
+
+    void getResiduals(const int32* x, int order, uint32* residuals)
+    {
+        const int n = Lossless::k_blockFrames;
+        switch (order)
+        {
+            case 0:
+                for (int i = 0; i < n; ++i)
+                {
+                    residuals[i] = zigzag(x[i]);
+                }
+                break;
+
+            case 1:
+                for (int i = 1; i < n; ++i)
+                {
+                    residuals[i] = zigzag(x[i] - x[i-1]);
+                }
+                break;
+
+            case 2:
+                for (int i = 2; i < n; ++i)
+                {
+                    residuals[i] = zigzag(x[i] - 2*x[i-1] + x[i-2]);
+                }
+                break;
+
+            case 3:
+                for (int i = 3; i < n; ++i)
+                {
+                    residuals[i] = zigzag(x[i] - 3*x[i-1] + 3*x[i-2] - x[i-3]);
+                }
+                break;
+
+            case 4:
+                for (int i = 4; i < n; ++i)
+                {
+                    residuals[i] = zigzag(x[i] - 4*x[i-1] + 6*x[i-2] - 4*x[i-3] + x[i-4]);
+                }
+                break;
+        }
+    }
+
+    uint32 getRiceBits(const uint32* residuals, int count, int param)
+    {
+        uint32 bits = (uint32) count * (param + 1);
+        for (int i = 0; i < count; ++i)
+        {
+            bits += residuals[i] >> param;
+        }
+        return bits;
+    }
+
+    // Find the best Rice parameter for a partition, starting from an estimate
+    // from the mean residual; returns the number of bits.
+    uint32 chooseRiceParam(const uint32* residuals, int count, int& param)
+    {
+        uint64 sum = 0;
+        for (int i = 0; i < count; ++i)
+        {
+            sum += residuals[i];
+        }
+        int estimate = 0;
+        while (estimate < k_maxRiceParam && ((uint64) count << (estimate + 1)) <= sum)
+        {
+            ++estimate;
+        }
+
+        uint32 bestBits = 0;
+        int first = Math::max(estimate - 1, 0);
+        int last = Math::min(estimate + 1, k_maxRiceParam);
+        for (int k = first; k <= last; ++k)
+        {
+            uint32 bits = getRiceBits(residuals, count, k);
+            if (k == first || bits < bestBits)
+            {
+                bestBits = bits;
+                param = k;
+            }
+        }
+        return bestBits;
+    }
+
+    void chooseSubblock(const int32* x, int sampleBits, Subblock& subblock)
+    {
+        const int n = Lossless::k_blockFrames;
+
+        bool constant = true;
+        for (int i = 1; i < n && constant; ++i)
+        {
+            constant = (x[i] == x[0]);
+        }
+        if (constant)
+        {
+            subblock.type = k_constant;
+            subblock.bits = k_typeBits + sampleBits;
+            return;
+        }
+
+        subblock.type = k_verbatim;
+        subblock.bits = k_typeBits + n * sampleBits;
+
+        uint32 residuals[Lossless::k_blockFrames];
+        for (int order = 0; order <= k_maxOrder; ++order)
+        {
+            getResiduals(x, order, residuals);
+            for (int partitionOrder = 0; partitionOrder <= k_maxPartitionOrder; ++partitionOrder)
+            {
+                int partitions = 1 << partitionOrder;
+                int partitionFrames = n >> partitionOrder;
+                int riceParams[k_maxPartitions];
+                uint32 bits = k_typeBits + order * sampleBits + k_partitionOrderBits + partitions * k_riceParamBits;
+                for (int p = 0; p < partitions; ++p)
+                {
+                    int begin = (p == 0 ? order : p * partitionFrames);
+                    int end = (p + 1) * partitionFrames;
+                    bits += chooseRiceParam(residuals + begin, end - begin, riceParams[p]);
+                }
+
+                if (bits < subblock.bits)
+                {
+                    subblock.type = order;
+                    subblock.partitionOrder = partitionOrder;
+                    Mem::copy(subblock.riceParams, riceParams, partitions * sizeof(int));
+                    subblock.bits = bits;
+                }
+            }
+        }
+    }
+
+    void writeSubblock(BitWriter& writer, const int32* x, int sampleBits, const Subblock& subblock)
+    {
+        const int n = Lossless::k_blockFrames;
+
+        writer.write(subblock.type, k_typeBits);
+        if (subblock.type == k_constant)
+        {
+            writer.write(x[0], sampleBits);
+        }
+        else if (subblock.type == k_verbatim)
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                writer.write(x[i], sampleBits);
+            }
+        }
+        else
+        {
+            int order = subblock.type;
+            for (int i = 0; i < order; ++i)
+            {
+                writer.write(x[i], sampleBits);
+            }
+
+            uint32 residuals[Lossless::k_blockFrames];
+            getResiduals(x, order, residuals);
+
+            writer.write(subblock.partitionOrder, k_partitionOrderBits);
+            int partitions = 1 << subblock.partitionOrder;
+            int partitionFrames = n >> subblock.partitionOrder;
+            for (int p = 0; p < partitions; ++p)
+            {
+                int param = subblock.riceParams[p];
+                writer.write(param, k_riceParamBits);
+                int begin = (p == 0 ? order : p * partitionFrames);
+                int end = (p + 1) * partitionFrames;
+                for (int i = begin; i < end; ++i)
+                {
+                    writer.writeRice(residuals[i], param);
+                }
+            }
+        }
+    }
+
+
+    ////////////////////////////////////////
+    // decoding
+
+    class BitReader
+    {
+    public:
+        BitReader(const byte* input) : m_start(input), m_input(input), m_value(0), m_bits(0) {}
+
+        // Bytes are only read as they are needed, so a reader never reads
+        // past the end of a valid block.
+        uint32 read(int bits)
+        {
+            CK_ASSERT(bits > 0 && bits <= 24);
+            fill(bits);
+            uint32 value = m_value >> (32 - bits);
+            m_value <<= bits;
+            m_bits -= bits;
+            return value;
+        }
+
+        uint32 readRice(int param)
+        {
+            // unary quotient
+            uint32 quotient = 0;
+            while (!m_value)
+            {
+                // no 1 bits left in m_value
+                quotient += m_bits;
+                m_bits = 0;
+                fill(8);
+            }
+            int zeros = countLeadingZeros(m_value);
+            quotient += zeros;
+            m_value <<= zeros;
+            m_value <<= 1;
+            m_bits -= zeros + 1;
+
+            return param ? (quotient << param) | read(param) : quotient;
+        }
+
+        int getBytesRead() const
+        {
+            return (int) (m_input - m_start) - m_bits / 8;
+        }
+
+    private:
+        const byte* m_start;
+        const byte* m_input;
+        uint32 m_value; // m_bits unread bits, from the top; the rest are 0
+        int m_bits;
+
+        void fill(int bits)
+        {
+            while (m_bits < bits)
+            {
+                m_value |= (uint32) *m_input++ << (24 - m_bits);
+                m_bits += 8;
+            }
+        }
+    };
+
+    void readSubblock(BitReader& reader, int sampleBits, int32* x)
+    {
+        const int n = Lossless::k_blockFrames;
+
+        int type = (int) reader.read(k_typeBits);
+        if (type == k_constant)
+        {
+            int32 value = signExtend(reader.read(sampleBits), sampleBits);
+            for (int i = 0; i < n; ++i)
+            {
+                x[i] = value;
+            }
+        }
+        else if (type == k_verbatim)
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                x[i] = signExtend(reader.read(sampleBits), sampleBits);
+            }
+        }
+        else
+        {
+            CK_ASSERT(type <= k_maxOrder);
+            int order = type;
+            for (int i = 0; i < order; ++i)
+            {
+                x[i] = signExtend(reader.read(sampleBits), sampleBits);
+            }
+
+            int partitionOrder = (int) reader.read(k_partitionOrderBits);
+            int partitions = 1 << partitionOrder;
+            int partitionFrames = n >> partitionOrder;
+            int i = order;
+            for (int p = 0; p < partitions; ++p)
+            {
+                int param = (int) reader.read(k_riceParamBits);
+                int end = (p + 1) * partitionFrames;
+                for (; i < end; ++i)
+                {
+                    x[i] = unzigzag(reader.readRice(param));
+                }
+            }
+
+            // residuals to samples
+            switch (order)
+            {
+                case 1:
+                    for (int j = 1; j < n; ++j)
+                    {
+                        x[j] += x[j-1];
+                    }
+                    break;
+
+                case 2:
+                    for (int j = 2; j < n; ++j)
+                    {
+                        x[j] += 2*x[j-1] - x[j-2];
+                    }
+                    break;
+
+                case 3:
+                    for (int j = 3; j < n; ++j)
+                    {
+                        x[j] += 3*x[j-1] - 3*x[j-2] + x[j-3];
+                    }
+                    break;
+
+                case 4:
+                    for (int j = 4; j < n; ++j)
+                    {
+                        x[j] += 4*x[j-1] - 6*x[j-2] + 4*x[j-3] - x[j-4];
+                    }
+                    break;
+            }
+        }
+    }
+
+    template <typename T>
+    int decodeImpl(const byte* input, int channels, T* output)
+    {
+        CK_ASSERT(channels == 1 || channels == 2);
+        const int n = Lossless::k_blockFrames;
+
+        int mode = input[0];
+        BitReader reader(input + k_modeBytes);
+
+        int32 x[2][Lossless::k_blockFrames];
+        if (channels == 1)
+        {
+            CK_ASSERT(mode == k_leftRight);
+            readSubblock(reader, k_sampleBits, x[0]);
+            for (int i = 0; i < n; ++i)
+            {
+                store(x[0][i], output + i);
+            }
+        }
+        else
+        {
+            readSubblock(reader, (mode == k_sideRight ? k_sideSampleBits : k_sampleBits), x[0]);
+            readSubblock(reader, (mode == k_leftSide || mode == k_midSide ? k_sideSampleBits : k_sampleBits), x[1]);
+
+            const int32* a = x[0];
+            const int32* b = x[1];
+            T* out = output;
+            switch (mode)
+            {
+                case k_leftRight:
+                    for (int i = 0; i < n; ++i, out += 2)
+                    {
+                        store(a[i], out);
+                        store(b[i], out + 1);
+                    }
+                    break;
+
+                case k_leftSide:
+                    for (int i = 0; i < n; ++i, out += 2)
+                    {
+                        store(a[i], out);
+                        store(a[i] - b[i], out + 1);
+                    }
+                    break;
+
+                case k_sideRight:
+                    for (int i = 0; i < n; ++i, out += 2)
+                    {
+                        store(a[i] + b[i], out);
+                        store(b[i], out + 1);
+                    }
+                    break;
+
+                case k_midSide:
+                    for (int i = 0; i < n; ++i, out += 2)
+                    {
+                        int32 sum = (a[i] << 1) | (b[i] & 1);
+                        store((sum + b[i]) >> 1, out);
+                        store((sum - b[i]) >> 1, out + 1);
+                    }
+                    break;
+
+                default:
+                    CK_FAIL("invalid channel mode");
+                    break;
+            }
+        }
+
+        return k_modeBytes + reader.getBytesRead();
+    }
+}
+
+
+namespace Lossless
+{
+    int getMaxBlockBytes(int channels)
+    {
+        // verbatim, with one channel as a side channel
+        int bits = channels * (k_typeBits + k_blockFrames * k_sideSampleBits);
+        int bytes = k_modeBytes + (bits + 7) / 8;
+        CK_ASSERT(bytes <= k_maxBlockBytes);
+        return bytes;
+    }
+
+    int encodeBlock(const int16* input, int channels, byte* output)
+    {
+        CK_ASSERT(channels == 1 || channels == 2);
+        const int n = k_blockFrames;
+
+        BitWriter writer(output + k_modeBytes);
+        if (channels == 1)
+        {
+            int32 x[k_blockFrames];
+            for (int i = 0; i < n; ++i)
+            {
+                x[i] = input[i];
+            }
+
+            Subblock subblock;
+            chooseSubblock(x, k_sampleBits, subblock);
+            output[0] = k_leftRight;
+            writeSubblock(writer, x, k_sampleBits, subblock);
+        }
+        else
+        {
+            int32 left[k_blockFrames];
+            int32 right[k_blockFrames];
+            int32 mid[k_blockFrames];
+            int32 side[k_blockFrames];
+            for (int i = 0; i < n; ++i)
+            {
+                left[i] = input[i*2];
+                right[i] = input[i*2 + 1];
+                mid[i] = (left[i] + right[i]) >> 1;
+                side[i] = left[i] - right[i];
+            }
+
+            Subblock leftSub, rightSub, midSub, sideSub;
+            chooseSubblock(left, k_sampleBits, leftSub);
+            chooseSubblock(right, k_sampleBits, rightSub);
+            chooseSubblock(mid, k_sampleBits, midSub);
+            chooseSubblock(side, k_sideSampleBits, sideSub);
+
+            // use whichever pair of channels is smallest
+            ChannelMode mode = k_leftRight;
+            uint32 bits = leftSub.bits + rightSub.bits;
+            if (leftSub.bits + sideSub.bits < bits)
+            {
+                mode = k_leftSide;
+                bits = leftSub.bits + sideSub.bits;
+            }
+            if (sideSub.bits + rightSub.bits < bits)
+            {
+                mode = k_sideRight;
+                bits = sideSub.bits + rightSub.bits;
+            }
+            if (midSub.bits + sideSub.bits < bits)
+            {
+                mode = k_midSide;
+                bits = midSub.bits + sideSub.bits;
+            }
+
+            output[0] = (byte) mode;
+            switch (mode)
+            {
+                case k_leftRight:
+                    writeSubblock(writer, left, k_sampleBits, leftSub);
+                    writeSubblock(writer, right, k_sampleBits, rightSub);
+                    break;
+
+                case k_leftSide:
+                    writeSubblock(writer, left, k_sampleBits, leftSub);
+                    writeSubblock(writer, side, k_sideSampleBits, sideSub);
+                    break;
+
+                case k_sideRight:
+                    writeSubblock(writer, side, k_sideSampleBits, sideSub);
+                    writeSubblock(writer, right, k_sampleBits, rightSub);
+                    break;
+
+                case k_midSide:
+                    writeSubblock(writer, mid, k_sampleBits, midSub);
+                    writeSubblock(writer, side, k_sideSampleBits, sideSub);
+                    break;
+            }
+        }
+
+        int bytes = k_modeBytes + writer.finish();
+        CK_ASSERT(bytes <= getMaxBlockBytes(channels));
+        return bytes;
+    }
+
+    int decodeBlock(const byte* input, int channels, int16* output)
+    {
+        return decodeImpl(input, channels, output);
+    }
+
+    int decodeBlock(const byte* input, int channels, int32* output)
+    {
+        return decodeImpl(input, channels, output);
+    }
+
+    int decodeBlock(const byte* input, int channels, float* output)
+    {
+        return decodeImpl(input, channels, output);
+    }
+
+    int getTableBytes(int blocks)
+    {
+        return (blocks + 1) * 4; // offsets, then frames in the last block
+    }
+
+    int getBlockOffset(const byte* table, int block)
+    {
+        return (int) readUint32(table + block * 4);
+    }
+
+    void setBlockOffset(byte* table, int block, int offset)
+    {
+        writeUint32(table + block * 4, (uint32) offset);
+    }
+
+    int getLastBlockFrames(const byte* table, int blocks)
+    {
+        return (int) readUint32(table + blocks * 4);
+    }
+
+    void setLastBlockFrames(byte* table, int blocks, int frames)
+    {
+        CK_ASSERT(frames >= 0 && frames <= k_blockFrames);
+        writeUint32(table + blocks * 4, (uint32) frames);
+    }
+}
+
+
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/core/types.h"
+
+
+namespace Cki
+{
+
+
+// Lossless compression of 16-bit audio, in the manner of FLAC: each channel of
+// a block is predicted by a fixed polynomial predictor, and the residuals are
+// Rice coded.  Stereo blocks may code the difference between the channels
+// (or their mean and difference) instead of the channels themselves.
+//
+// Blocks are byte-aligned but vary in size, so sample data is the encoded
+// blocks followed by a table of the offset of each block, for seeking and
+// looping.  The last block is padded with silence; the table ends with the
+// number of frames of it that are used, so sounds keep their exact length.
+namespace Lossless
+{
+    enum { k_blockFrames = 256 };
+
+    // Upper bound on the size of an encoded block (a block is never larger
+    // than its samples stored verbatim); k_maxBlockBytes is for 2 channels.
+    int getMaxBlockBytes(int channels);
+    enum { k_maxBlockBytes = 1 + (2 * (3 + k_blockFrames * 17) + 7) / 8 };
+
+    // Encode one block of k_blockFrames interleaved frames; returns the number
+    // of bytes written, which is at most getMaxBlockBytes(channels).
+    int encodeBlock(const int16* input, int channels, byte* output);
+
+    // Decode one block to k_blockFrames interleaved frames, as 16-bit samples
+    // or in the audio pipeline's sample format (8.24 fixed point or float),
+    // with the same values as the equivalent 16-bit PCM.  Returns the number
+    // of bytes read.
+    int decodeBlock(const byte* input, int channels, int16* output);
+    int decodeBlock(const byte* input, int channels, int32* output);
+    int decodeBlock(const byte* input, int channels, float* output);
+
+    // The block offset table at the end of the sample data; offsets are from
+    // the start of the data, and stored little-endian.
+    int getTableBytes(int blocks);
+    int getBlockOffset(const byte* table, int block);
+    void setBlockOffset(byte* table, int block, int offset);
+    int getLastBlockFrames(const byte* table, int blocks);
+    void setLastBlockFrames(byte* table, int blocks, int frames);
+}
+
+
+}
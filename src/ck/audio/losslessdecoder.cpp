@@ -0,0 +1,200 @@
+#include "ck/audio/losslessdecoder.h"
+#include "ck/audio/audiosource.h"
+#include "ck/core/debug.h"
+#include "ck/core/math.h"
+#include "ck/core/mem.h"
+
+
+namespace Cki
+{
+
+
+LosslessDecoder::LosslessDecoder(AudioSource& source) :
+    Decoder(source),
+    m_decodedBlock(-1),
+    m_frameOffset(0),
+    m_sourceBlock(-1)
+{
+    int channels = source.getSampleInfo().channels;
+    int decodedBytes = Lossless::k_blockFrames * channels * (int) sizeof(VarSample);
+    m_decoded = (VarSample*) Mem::alloc(decodedBytes + Lossless::getMaxBlockBytes(channels));
+    m_encoded = (byte*) m_decoded + decodedBytes;
+}
+
+LosslessDecoder::~LosslessDecoder()
+{
+    Mem::free(m_decoded);
+}
+
+int LosslessDecoder::decode(int32* buf, int frames)
+{
+    return decodeImpl(buf, frames);
+}
+
+int LosslessDecoder::decode(float* buf, int frames)
+{
+    return decodeImpl(buf, frames);
+}
+
+template <typename T>
+int LosslessDecoder::decodeImpl(T* buf, int frames)
+{
+    if (!isCacheValid() && m_decodedBlock >= 0)
+    {
+        // source was reset or moved since the block was decoded
+        m_decodedBlock = -1;
+        m_frameOffset = 0;
+    }
+
+    if (isDone())
+    {
+        return 0;
+    }
+    else
+    {
+        const int blockFrames = Lossless::k_blockFrames;
+        int channels = m_source.getSampleInfo().channels;
+
+        int framesDecoded = 0;
+        T* out = buf;
+        while (framesDecoded < frames)
+        {
+            int framesLeft = frames - framesDecoded;
+            if (m_decodedBlock >= 0)
+            {
+                // copy the rest of the partial block
+                int decodedFrames = getBlockFrames(m_decodedBlock);
+                int framesToCopy = Math::clamp(decodedFrames - m_frameOffset, 0, framesLeft);
+                Mem::copy(out, (T*) m_decoded + m_frameOffset * channels, framesToCopy * channels * sizeof(T));
+                out += framesToCopy * channels;
+                framesDecoded += framesToCopy;
+
+                m_frameOffset += framesToCopy;
+                if (m_frameOffset >= decodedFrames)
+                {
+                    m_decodedBlock = -1;
+                    m_frameOffset = 0;
+                }
+            }
+            else if (m_frameOffset == 0 && framesLeft >= blockFrames)
+            {
+                // whole block; the padding of a short last block is overwritten
+                int block = m_source.getBlockPos();
+                if (!decodeBlock(out))
+                {
+                    break;
+                }
+                int decodedFrames = getBlockFrames(block);
+                out += decodedFrames * channels;
+                framesDecoded += decodedFrames;
+            }
+            else
+            {
+                // partial block at the start or end
+                int block = m_source.getBlockPos();
+                if (!decodeBlock((T*) m_decoded))
+                {
+                    break;
+                }
+                m_decodedBlock = block;
+                m_sourceBlock = m_source.getBlockPos();
+                CK_ASSERT(m_frameOffset < blockFrames);
+            }
+            CK_ASSERT(framesDecoded <= frames);
+        }
+
+        return framesDecoded;
+    }
+}
+
+int LosslessDecoder::skip(float* buf, int frames)
+{
+    // Nothing is decoded here, since m_decoded must stay in the format that
+    // decode() is called with (buf is always float).
+    if (!isCacheValid() && m_decodedBlock >= 0)
+    {
+        m_decodedBlock = -1;
+        m_frameOffset = 0;
+    }
+
+    int framesSkipped = 0;
+    if (m_decodedBlock >= 0)
+    {
+        // advance through the decoded block
+        int decodedFrames = getBlockFrames(m_decodedBlock);
+        framesSkipped = Math::clamp(decodedFrames - m_frameOffset, 0, frames);
+        m_frameOffset += framesSkipped;
+        if (m_frameOffset < decodedFrames)
+        {
+            return framesSkipped;
+        }
+        m_decodedBlock = -1;
+        m_frameOffset = 0;
+    }
+
+    return framesSkipped + skipBlocks(frames - framesSkipped, m_frameOffset);
+}
+
+bool LosslessDecoder::isDone() const
+{
+    return m_source.isDone() && !isCacheValid();
+}
+
+void LosslessDecoder::setFramePos(int frame)
+{
+    int block = frame / Lossless::k_blockFrames;
+    int offset = frame - (block * Lossless::k_blockFrames);
+
+    // no need to decode again, if the block has already been decoded
+    if (isCacheValid() && m_decodedBlock == block)
+    {
+        m_frameOffset = offset;
+        return;
+    }
+
+    // seek to beginning of block
+    m_source.setBlockPos(block);
+    m_decodedBlock = -1;
+    m_frameOffset = offset;
+}
+
+int LosslessDecoder::getFramePos() const
+{
+    if (isCacheValid())
+    {
+        return m_decodedBlock * Lossless::k_blockFrames + m_frameOffset;
+    }
+    else
+    {
+        return m_source.getBlockPos() * Lossless::k_blockFrames + (m_decodedBlock >= 0 ? 0 : m_frameOffset);
+    }
+}
+
+int LosslessDecoder::getNumFrames() const
+{
+    return m_source.getNumFrames();
+}
+
+////////////////////////////////////////
+
+bool LosslessDecoder::isCacheValid() const
+{
+    return m_decodedBlock >= 0 && m_source.getBlockPos() == m_sourceBlock;
+}
+
+// Read and decode the next block; returns false if there are none.
+template <typename T>
+bool LosslessDecoder::decodeBlock(T* buf)
+{
+    const SampleInfo& info = m_source.getSampleInfo();
+    CK_ASSERT(info.blockBytes <= Lossless::getMaxBlockBytes(info.channels));
+    if (m_source.read(m_encoded, 1) == 0)
+    {
+        return false;
+    }
+    Lossless::decodeBlock(m_encoded, info.channels, buf);
+    return true;
+}
+
+
+}
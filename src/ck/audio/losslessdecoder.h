@@ -0,0 +1,43 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/audio/decoder.h"
+#include "ck/audio/lossless.h"
+#include "ck/audio/varsample.h"
+
+namespace Cki
+{
+
+
+class LosslessDecoder : public Decoder
+{
+public:
+    LosslessDecoder(AudioSource&);
+    virtual ~LosslessDecoder();
+    virtual int decode(int32* buf, int frames);
+    virtual int decode(float* buf, int frames);
+    virtual bool isDone() const;
+    virtual int skip(float* buf, int frames);
+    virtual void setFramePos(int frame);
+    virtual int getFramePos() const;
+    virtual int getNumFrames() const;
+
+private:
+    // Requests for whole blocks are decoded straight into the output; a block
+    // that is only partly requested is decoded into m_decoded, in the
+    // pipeline's sample format.  The buffers are allocated, rather than being
+    // members, so DecoderBuf is no bigger than for the other formats.
+    VarSample* m_decoded; // Lossless::k_blockFrames frames
+    byte* m_encoded; // one block, after m_decoded
+    int m_decodedBlock; // which block is in m_decoded; -1 if none
+    int m_frameOffset; // offset of next frame in m_decoded, or in the next block if none
+    int m_sourceBlock; // source position after m_decoded was filled; if it changes, m_decoded is stale
+
+    bool isCacheValid() const;
+
+    template <typename T> int decodeImpl(T* buf, int frames);
+    template <typename T> bool decodeBlock(T* buf);
+};
+
+
+}
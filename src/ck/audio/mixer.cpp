@@ -1,4 +1,5 @@
 #include "ck/audio/mixer.h"
+#include "ck/audio/audiograph.h"
 #include "ck/core/debug.h"
 #include "ck/core/logger.h"
 #include <new>
@@ -20,7 +21,8 @@ Mixer::Mixer() :
     m_localVol(1.0f),
     m_mixVol(1.0f),
     m_localPaused(false),
-    m_mixPaused(false)
+    m_mixPaused(false),
+    m_gain(new MixerGain())
 {
 }
 
@@ -29,7 +31,8 @@ Mixer::Mixer(const char* name, Mixer* parent) :
     m_localVol(1.0f),
     m_mixVol(1.0f),
     m_localPaused(false),
-    m_mixPaused(false)
+    m_mixPaused(false),
+    m_gain(new MixerGain())
 {
     if (this != s_master)
     {
@@ -60,6 +63,14 @@ Mixer::~Mixer()
             parent->addChild(child);
             child->update(); // recalculate volumes since hierarchy has changed
         }
+
+        // after the sources have been switched to other mixers' gains
+        AudioGraph::get()->deleteObject(m_gain);
+    }
+    else
+    {
+        // master; audio graph has already shut down
+        delete m_gain;
     }
 }
 
@@ -220,11 +231,17 @@ void Mixer::update()
         m_mixVol = mixVol;
         updateChildren = true;
 
-        // update child sounds
+        // sounds rendered by the audio graph get the new volume from the gain
+        AudioGraph::get()->executeCoalesced(m_gain, MixerGain::k_setGain, mixVol);
+
+        // update other child sounds
         Sound* sound = m_sounds.getFirst();
         while (sound)
         {
-            sound->updateVolumeAndPan();
+            if (!sound->getSourceNode())
+            {
+                sound->updateVolumeAndPan();
+            }
             sound = ((SoundMixerList::Node*) sound)->getNext();
         }
     }
@@ -7,6 +7,7 @@
 #include "ck/core/list.h"
 #include "ck/audio/soundname.h"
 #include "ck/audio/sound.h"
+#include "ck/audio/mixergain.h"
 
 namespace Cki
 {
@@ -57,6 +58,9 @@ public:
     void addSound(Sound*);
     void removeSound(Sound*);
 
+    // render-side mixed volume, applied by the sources of this mixer's sounds
+    MixerGain* getGain() { return m_gain; }
+
 private:
     SoundName m_name;
     float m_localVol;
@@ -64,6 +68,7 @@ private:
     bool m_localPaused;
     bool m_mixPaused;
     SoundMixerList m_sounds;
+    MixerGain* m_gain;
 
     static Mixer* s_master;
     static char s_masterMem[];
@@ -0,0 +1,27 @@
+#include "ck/audio/mixergain.h"
+#include "ck/core/debug.h"
+
+namespace Cki
+{
+
+
+MixerGain::MixerGain() :
+    m_gain(1.0f)
+{
+}
+
+void MixerGain::execute(int cmdId, CommandParam param0, CommandParam param1)
+{
+    switch (cmdId)
+    {
+        case k_setGain:
+            m_gain = param0.floatValue;
+            break;
+
+        default:
+            CK_FAIL("unknown command");
+    };
+}
+
+
+}
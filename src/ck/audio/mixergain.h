@@ -0,0 +1,37 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/core/allocatable.h"
+#include "ck/core/deletable.h"
+#include "ck/audio/commandobject.h"
+
+namespace Cki
+{
+
+
+// Render-side volume of a Mixer, including its ancestors' volumes.  The sources
+// of the mixer's sounds apply it along with their own volumes, so a change to a
+// mixer's volume is one command, rather than one for each of its sounds.
+class MixerGain : 
+    public Allocatable,
+    public Deletable,
+    public CommandObject
+{
+public:
+    MixerGain();
+
+    // audio thread only
+    float getGain() const { return m_gain; }
+
+    enum
+    {
+        k_setGain
+    };
+    virtual void execute(int cmdId, CommandParam param0, CommandParam param1);
+
+private:
+    float m_gain;
+};
+
+
+}
@@ -1,6 +1,8 @@
 #include "ck/audio/mixnode.h"
 #include "ck/audio/audioutil.h"
 #include "ck/audio/audiograph.h"
+#include "ck/audio/renderworkers.h"
+#include "ck/audio/rendertrace.h"
 #include "ck/core/mem.h"
 #include "ck/core/logger.h"
 #include "ck/core/math.h"
@@ -12,15 +14,12 @@ namespace Cki
 
 
 MixNode::MixNode() :
-    m_inputs(),
-    m_bufMem(NULL)
+    m_inputs()
 {
-    allocateBuffer(); // don't add to pool on main thread
 }
 
 MixNode::~MixNode()
 {
-    Mem::free(m_bufMem);
 }
 
 BufferHandle MixNode::processFloat(int frames, bool post, bool& needsPost)
@@ -36,11 +35,35 @@ BufferHandle MixNode::processFixed(int frames, bool post, bool& needsPost)
 template <typename T>
 BufferHandle MixNode::process(int frames, bool post, bool& needsPost)
 {
+    RenderTrace::Scope trace(RenderTrace::k_mix, this);
+
+    // Render inputs in parallel if we can; but not from inside a render job,
+    // which is already running in parallel with others.
+    RenderWorkers* workers = RenderWorkers::get();
+    if (workers && !RenderJob::getCurrent() && m_inputs.getSize() > 1 &&
+        AudioGraph::get()->getRenderMs() <= getRenderLimitMs())
+    {
+        return processParallel<T>(workers, frames, post, needsPost);
+    }
+    else
+    {
+        return processSerial<T>(frames, post, needsPost);
+    }
+}
+
+template <typename T>
+BufferHandle MixNode::processSerial(int frames, bool post, bool& needsPost)
+{
+    // Once an input's output has been mixed, the scratch buffers used to render
+    // it are no longer needed, so the next input can reuse them.
+    ScratchArena* arena = getScratchArena();
+
     // find first active input
     BufferHandle firstBufHandle;
     AudioNode* input = m_inputs.getFirst();
     while (input)
     {
+        ScratchArena::Mark mark = arena->getMark();
         firstBufHandle = input->process<T>(frames, post, needsPost);
         input = input->getNext();
 
@@ -48,6 +71,7 @@ BufferHandle MixNode::process(int frames, bool post, bool& needsPost)
         {
             break;
         }
+        arena->rewind(mark);
     }
 
     if (!firstBufHandle.isValid())
@@ -55,31 +79,8 @@ BufferHandle MixNode::process(int frames, bool post, bool& needsPost)
         return firstBufHandle; // no active inputs
     }
 
-    if (!m_buf.getMem())
-    {
-        if (!m_bufMem)
-        {
-            allocateBuffer(); // since alloc may have failed first time
-        }
-
-        if (m_bufMem)
-        {
-            m_buf.init(m_bufMem);
-            getBufferPool()->add(m_buf);
-        }
-        else
-        {
-            return firstBufHandle;
-        }
-    }
-
     AudioGraph* graph = AudioGraph::get();
-    const CkConfig& config = System::get()->getConfig();
-    float renderLimitMs = config.audioUpdateMs * config.maxRenderLoad;
-#if CK_PLATFORM_WP8
-    // seem to get "false positives" on wp8; i.e. warning is shown with no audible artifacts.  maybe some internal buffering in xaudio2?
-    renderLimitMs += 2.0f;
-#endif
+    float renderLimitMs = getRenderLimitMs();
 
     // bail out if rendering is taking too long
     if (graph->getRenderMs() > renderLimitMs)
@@ -90,6 +91,7 @@ BufferHandle MixNode::process(int frames, bool post, bool& needsPost)
 
     while (input)
     {
+        ScratchArena::Mark mark = arena->getMark();
         BufferHandle nextBufHandle = input->process<T>(frames, post, needsPost);
         if (nextBufHandle.isValid())
         {
@@ -97,17 +99,73 @@ BufferHandle MixNode::process(int frames, bool post, bool& needsPost)
             if (graph->getRenderMs() > renderLimitMs)
             {
                 printCpuWarning(graph->getRenderMs());
+                arena->rewind(mark);
                 break;
             }
 
             AudioUtil::mix((const T*) nextBufHandle.get(), (T*) firstBufHandle.get(), frames * k_maxChannels);
         }
+        arena->rewind(mark);
         input = input->getNext();
     }
 
     return firstBufHandle;
 }
 
+template <typename T>
+BufferHandle MixNode::processParallel(RenderWorkers* workers, int frames, bool post, bool& needsPost)
+{
+    // The jobs are allocated by RenderWorkers at init; if there are more inputs
+    // than jobs, they are rendered in several runs.
+    RenderJob* jobs = workers->getJobs();
+    int maxJobs = workers->getMaxJobs();
+
+    BufferHandle outBufHandle;
+    AudioNode* input = m_inputs.getFirst();
+    while (input)
+    {
+        int count = 0;
+        while (input && count < maxJobs)
+        {
+            jobs[count++].node = input;
+            input = input->getNext();
+        }
+
+        workers->run<T>(count, frames, post);
+
+        // Mix in input order, as processSerial() does, so the result is the same
+        // no matter which thread rendered which input.  The results are only valid
+        // until the next run, so the mix goes in one of our own scratch buffers.
+        for (int i = 0; i < count; ++i)
+        {
+            RenderJob& job = jobs[i];
+            if (job.needsPost)
+            {
+                needsPost = true;
+            }
+
+            if (job.result.isValid())
+            {
+                if (outBufHandle.isValid())
+                {
+                    AudioUtil::mix((const T*) job.result.get(), (T*) outBufHandle.get(), frames * k_maxChannels);
+                }
+                else
+                {
+                    outBufHandle = acquireBuffer();
+                    Mem::copy(outBufHandle.get(), job.result.get(), frames * k_maxChannels * sizeof(T));
+                }
+                job.result.release();
+            }
+
+            job.applyDeferred();
+            job.node = NULL;
+        }
+    }
+
+    return outBufHandle;
+}
+
 void MixNode::execute(int cmdId, CommandParam param0, CommandParam param1)
 {
     switch (cmdId)
@@ -120,16 +178,6 @@ void MixNode::execute(int cmdId, CommandParam param0, CommandParam param1)
             removeInput((AudioNode*) param0.addrValue);
             break;
 
-        case k_detach:
-            {
-                BufferPool* pool = getBufferPool();
-                if (pool)
-                {
-                    pool->remove(m_buf);
-                }
-            }
-            break;
-
         default:
             CK_FAIL("unknown command");
     };
@@ -158,14 +206,21 @@ void MixNode::print(int level)
 }
 #endif
 
-void MixNode::allocateBuffer()
+float MixNode::getRenderLimitMs()
 {
-    // 64-byte alignment (16 words) for faster ARM NEON accesses
-    m_bufMem = Mem::alloc(getBufferPool()->getBufferSize() * sizeof(int32), 64);
-    if (!m_bufMem)
+    if (System::get()->isOffline())
     {
-        CK_LOG_ERROR("Could not allocate mix buffer");
+        // no deadline; every input is always rendered
+        return 1.0e30f;
     }
+
+    const CkConfig& config = System::get()->getConfig();
+    float renderLimitMs = config.audioUpdateMs * config.maxRenderLoad;
+#if CK_PLATFORM_WP8
+    // seem to get "false positives" on wp8; i.e. warning is shown with no audible artifacts.  maybe some internal buffering in xaudio2?
+    renderLimitMs += 2.0f;
+#endif
+    return renderLimitMs;
 }
 
 Timer MixNode::s_cpuWarningTimer;
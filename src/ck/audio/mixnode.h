@@ -7,6 +7,7 @@
 namespace Cki
 {
 
+class RenderWorkers;
 
 class MixNode : public AudioNode
 {
@@ -20,8 +21,7 @@ public:
     enum
     {
         k_addInput,
-        k_removeInput,
-        k_detach
+        k_removeInput
     };
     virtual void execute(int cmdId, CommandParam param0, CommandParam param1);
 
@@ -34,11 +34,11 @@ public:
 
 private:
     List<AudioNode> m_inputs;
-    void* m_bufMem;
-    SharedBuffer m_buf;
 
     template <typename T> BufferHandle process(int frames, bool post, bool& needsPost);
-    void allocateBuffer();
+    template <typename T> BufferHandle processSerial(int frames, bool post, bool& needsPost);
+    template <typename T> BufferHandle processParallel(RenderWorkers*, int frames, bool post, bool& needsPost);
+    static float getRenderLimitMs();
     static Timer s_cpuWarningTimer;
     static void printCpuWarning(float ms);
 };
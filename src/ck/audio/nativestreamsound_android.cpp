@@ -280,8 +280,9 @@ void NativeStreamSound::resumeAll()
     }
 }
 
-void NativeStreamSound::updateVolumeAndPan()
+void NativeStreamSound::updateVolumeAndPan(int64 time)
 {
+    // not mixed by the audio graph, so changes can't be scheduled; they take effect now
     MutexLock lock(m_mutex);
 
     if (m_playerVolume)
@@ -311,7 +312,7 @@ void NativeStreamSound::updateVolumeAndPan()
 
 ////////////////////////////////////////
 
-void NativeStreamSound::playSub()
+void NativeStreamSound::playSub(int64 time)
 {
     MutexLock lock(m_mutex);
 
@@ -323,7 +324,7 @@ void NativeStreamSound::playSub()
     updatePauseState();
 }
 
-void NativeStreamSound::stopSub()
+void NativeStreamSound::stopSub(int64 time)
 {
     MutexLock lock(m_mutex);
 
@@ -551,7 +552,7 @@ void NativeStreamSound::playStatus(SLuint32 event)
         CK_SL_VERIFY( (*m_playerSeek)->GetLoop(m_playerSeek, &looping, &start, &end) );
         if (!looping)
         {
-            stopSub();
+            stopSub(-1);
         }
     }
 }
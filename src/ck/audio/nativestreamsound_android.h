@@ -62,12 +62,12 @@ public:
     void resume();
     static void resumeAll();
 
-    virtual void updateVolumeAndPan();
+    virtual void updateVolumeAndPan(int64 time = -1);
 
 protected:
-    virtual void playSub();
+    virtual void playSub(int64 time);
     virtual void updateSub() {}
-    virtual void stopSub();
+    virtual void stopSub(int64 time);
     virtual bool isReadySub() const;
 
     virtual void updatePaused();
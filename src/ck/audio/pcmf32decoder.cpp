@@ -40,6 +40,11 @@ int PcmF32Decoder::decodeImpl(T* buf, int frames)
     }
 }
 
+int PcmF32Decoder::skip(float* buf, int frames)
+{
+    return isDone() ? 0 : m_source.read(NULL, frames); // since block == frame
+}
+
 bool PcmF32Decoder::isDone() const
 {
     return m_source.isDone();
@@ -14,6 +14,7 @@ public:
     PcmF32Decoder(AudioSource&);
     virtual int decode(int32* buf, int frames);
     virtual int decode(float* buf, int frames);
+    virtual int skip(float* buf, int frames);
     virtual bool isDone() const;
     virtual void setFramePos(int frame);
     virtual int getFramePos() const;
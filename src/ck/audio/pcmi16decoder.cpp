@@ -39,6 +39,11 @@ int PcmI16Decoder::decodeImpl(T* buf, int frames)
     }
 }
 
+int PcmI16Decoder::skip(float* buf, int frames)
+{
+    return isDone() ? 0 : m_source.read(NULL, frames); // since block == frame
+}
+
 bool PcmI16Decoder::isDone() const
 {
     return m_source.isDone();
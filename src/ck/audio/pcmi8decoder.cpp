@@ -40,6 +40,11 @@ int PcmI8Decoder::decodeImpl(T* buf, int frames)
     }
 }
 
+int PcmI8Decoder::skip(float* buf, int frames)
+{
+    return isDone() ? 0 : m_source.read(NULL, frames); // since block == frame
+}
+
 bool PcmI8Decoder::isDone() const
 {
     return m_source.isDone();
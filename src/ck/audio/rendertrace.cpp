@@ -0,0 +1,306 @@
+#include "ck/audio/rendertrace.h"
+#include "ck/core/atomic.h"
+#include "ck/core/debug.h"
+#include "ck/core/dir.h"
+#include "ck/core/filewriter.h"
+#include "ck/core/logger.h"
+#include "ck/core/mem.h"
+#include "ck/core/path.h"
+#include "ck/core/string.h"
+#include "ck/core/system.h"
+
+// template instantiations
+#include "ck/core/array.cpp"
+
+namespace Cki
+{
+
+
+namespace
+{
+    const char* const k_kindNames[] = { "render", "sound", "mix", "effect bus", "effect" };
+}
+
+void RenderTrace::shutdown()
+{
+    stop();
+
+    Mem::free(s_rings);
+    s_rings = NULL;
+    s_numRings = 0;
+    s_ringsUsed = 0;
+    s_names.clear();
+    s_names.compact();
+}
+
+void RenderTrace::start(const char* path, CkPathType pathType)
+{
+    stop();
+
+    Path outPath(path, pathType);
+
+    Path dirPath(outPath);
+    dirPath.setParent();
+    if (!Dir::exists(dirPath.getBuffer()) && !Dir::create(dirPath.getBuffer()))
+    {
+        CK_LOG_ERROR("Could not create directory %s for render trace", dirPath.getBuffer());
+        return;
+    }
+
+    FileWriter* writer = new FileWriter(outPath.getBuffer());
+    if (!writer || !writer->isValid())
+    {
+        CK_LOG_ERROR("Could not open file %s for render trace", outPath.getBuffer());
+        delete writer;
+        return;
+    }
+
+    if (!s_rings)
+    {
+        // the audio thread and each worker thread, plus a spare in case the
+        // audio thread is restarted; rings are kept until shutdown, since a
+        // render thread may still be recording when the trace is stopped
+        int numRings = System::get()->getConfig().renderThreads + 2;
+        int eventBytes = k_ringEvents * sizeof(Event);
+        s_rings = (Ring*) Mem::alloc(numRings * (sizeof(Ring) + eventBytes));
+        if (!s_rings)
+        {
+            CK_LOG_ERROR("Could not allocate memory for render trace");
+            delete writer;
+            return;
+        }
+
+        byte* events = (byte*) (s_rings + numRings);
+        for (int i = 0; i < numRings; ++i)
+        {
+            Ring& ring = s_rings[i];
+            ring.events = (Event*) (events + i * eventBytes);
+            ring.writePos = 0;
+            ring.readPos = 0;
+        }
+        s_numRings = numRings;
+        s_ringsUsed = 0;
+        ++s_generation; // threads' ring indexes from before shutdown are no longer valid
+    }
+
+    // discard anything recorded after the last trace was stopped
+    for (int i = 0; i < s_numRings; ++i)
+    {
+        Ring& ring = s_rings[i];
+        Atomic::storeRelease(&ring.readPos, Atomic::loadAcquire(&ring.writePos));
+    }
+    s_names.clear();
+    s_dropped = 0;
+    Atomic::storeRelease(&s_droppedCount, (int32) 0);
+
+    writer->write("{\"traceEvents\":[");
+    for (int i = 0; i < s_numRings; ++i)
+    {
+        writer->writef("%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"render thread %d\"}}", i ? "," : "", i, i);
+    }
+
+    CK_LOG_INFO("Render trace started: %s", outPath.getBuffer());
+    s_writer = writer;
+    s_startTick = Timer::getTick();
+    Atomic::storeRelease(&s_enabled, (int32) 1);
+}
+
+void RenderTrace::stop()
+{
+    if (s_writer)
+    {
+        Atomic::storeRelease(&s_enabled, (int32) 0);
+
+        // events from nodes still rendering are discarded by the next start()
+        drain();
+
+        s_writer->write("\n]}\n");
+        delete s_writer;
+        s_writer = NULL;
+
+        if (s_dropped > 0)
+        {
+            CK_LOG_WARNING("%d render trace events were dropped; call CkUpdate() more often while tracing.", s_dropped);
+        }
+        CK_LOG_INFO("Render trace stopped");
+    }
+}
+
+void RenderTrace::update()
+{
+    if (s_writer)
+    {
+        drain();
+    }
+}
+
+void RenderTrace::setName(const void* obj, const char* name)
+{
+    Name entry;
+    entry.obj = obj;
+
+    // names are written as JSON strings
+    int i = 0;
+    for ( ; name[i] && i < (int) sizeof(entry.name) - 1; ++i)
+    {
+        char c = name[i];
+        entry.name[i] = (c == '"' || c == '\\' || (unsigned char) c < ' ') ? '_' : c;
+    }
+    entry.name[i] = '\0';
+
+    int index = findNameIndex(obj);
+    if (index < s_names.getSize() && s_names[index].obj == obj)
+    {
+        s_names[index] = entry;
+    }
+    else
+    {
+        s_names.insert(index, entry);
+    }
+}
+
+void RenderTrace::record(Kind kind, const void* obj, const char* label, uint64 startTick, uint64 endTick)
+{
+    if (!Atomic::loadAcquire(&s_enabled))
+    {
+        return;
+    }
+
+    Ring* ring = getRing();
+    if (ring)
+    {
+        int32 writePos = ring->writePos;
+        if ((uint32) (writePos - Atomic::loadAcquire(&ring->readPos)) < (uint32) k_ringEvents)
+        {
+            Event& e = ring->events[writePos & (k_ringEvents - 1)];
+            e.startTick = startTick;
+            e.endTick = endTick;
+            e.obj = obj;
+            e.label = label;
+            e.kind = kind;
+            Atomic::storeRelease(&ring->writePos, writePos + 1);
+            return;
+        }
+    }
+
+    // ring is full, or there are more render threads than rings
+    int32 dropped;
+    do
+    {
+        dropped = s_droppedCount;
+    }
+    while (!Atomic::compareAndSwap(dropped, dropped + 1, &s_droppedCount));
+}
+
+////////////////////////////////////////
+
+RenderTrace::Ring* RenderTrace::getRing()
+{
+    if (s_threadGeneration != s_generation)
+    {
+        s_threadGeneration = s_generation;
+        s_threadRing = -1;
+
+        int32 used;
+        do
+        {
+            used = s_ringsUsed;
+            if (used >= s_numRings)
+            {
+                return NULL;
+            }
+        }
+        while (!Atomic::compareAndSwap(used, used + 1, &s_ringsUsed));
+        s_threadRing = used;
+    }
+
+    return (s_threadRing >= 0 ? &s_rings[s_threadRing] : NULL);
+}
+
+void RenderTrace::drain()
+{
+    for (int i = 0; i < s_numRings; ++i)
+    {
+        Ring& ring = s_rings[i];
+        int32 writePos = Atomic::loadAcquire(&ring.writePos);
+        int32 readPos = ring.readPos;
+        while (readPos != writePos)
+        {
+            writeEvent(ring.events[readPos & (k_ringEvents - 1)], i);
+            ++readPos;
+        }
+        Atomic::storeRelease(&ring.readPos, readPos);
+    }
+
+    s_dropped = Atomic::loadAcquire(&s_droppedCount);
+}
+
+void RenderTrace::writeEvent(const Event& e, int ring)
+{
+    const char* name = e.label;
+    if (!name)
+    {
+        name = findName(e.obj);
+        if (!name)
+        {
+            name = k_kindNames[e.kind];
+        }
+    }
+
+    // times in microseconds
+    double usPerTick = Timer::getMsPerTick() * 1000.0;
+    double ts = (double) (int64) (e.startTick - s_startTick) * usPerTick;
+    double dur = (double) (e.endTick - e.startTick) * usPerTick;
+
+    s_writer->writef(",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"node\":\"%p\"}}",
+            name, k_kindNames[e.kind], ring, ts, dur, e.obj);
+}
+
+const char* RenderTrace::findName(const void* obj)
+{
+    int index = findNameIndex(obj);
+    if (index < s_names.getSize() && s_names[index].obj == obj)
+    {
+        return s_names[index].name;
+    }
+    return NULL;
+}
+
+int RenderTrace::findNameIndex(const void* obj)
+{
+    // first entry not less than obj
+    int lo = 0;
+    int hi = s_names.getSize();
+    while (lo < hi)
+    {
+        int mid = (lo + hi) / 2;
+        if (s_names[mid].obj < obj)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+volatile int32 RenderTrace::s_enabled = 0;
+RenderTrace::Ring* RenderTrace::s_rings = NULL;
+int RenderTrace::s_numRings = 0;
+volatile int32 RenderTrace::s_ringsUsed = 0;
+int32 RenderTrace::s_generation = 0;
+FileWriter* RenderTrace::s_writer = NULL;
+uint64 RenderTrace::s_startTick = 0;
+int RenderTrace::s_dropped = 0;
+volatile int32 RenderTrace::s_droppedCount = 0;
+Array<RenderTrace::Name> RenderTrace::s_names;
+
+CK_THREAD_LOCAL int RenderTrace::s_threadRing = -1;
+CK_THREAD_LOCAL int32 RenderTrace::s_threadGeneration = 0;
+
+template class Array<RenderTrace::Name>;
+
+
+}
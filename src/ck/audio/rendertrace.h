@@ -0,0 +1,130 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/core/types.h"
+#include "ck/core/timer.h"
+#include "ck/core/array.h"
+#include "ck/pathtype.h"
+
+namespace Cki
+{
+
+class FileWriter;
+class BinaryStream;
+class MemoryFixup;
+
+
+// Records when each node of the audio graph is rendered, and on which thread,
+// so it can be seen where the render time goes; see CkStartRenderTrace().
+// Each render thread records into its own ring of events, without locking;
+// update() takes the events from the rings on the main thread and writes them
+// to the trace file, in the Chrome trace event format (which Perfetto and
+// chrome://tracing can open).
+class RenderTrace
+{
+public:
+    enum Kind
+    {
+        k_render,    // one quantum of the output
+        k_source,    // a sound
+        k_mix,       // mixing the inputs of a mixer or effect bus
+        k_effectBus, // an effect bus, including its inputs
+        k_effect     // one effect
+    };
+
+    static void shutdown();
+
+    // main thread
+    static void start(const char* path, CkPathType);
+    static void stop();
+    static void update(); // writes recorded events to the file
+    static void setName(const void* obj, const char* name); // name of a source node, for update()
+
+    static bool isEnabled() { return s_enabled != 0; }
+
+    // Any render thread.  The label, if not NULL, must be a static string;
+    // otherwise the name from setName() is used.
+    static void record(Kind, const void* obj, const char* label, uint64 startTick, uint64 endTick);
+
+    // Records the time from its construction to its destruction, if tracing
+    // was enabled when it was constructed.
+    class Scope
+    {
+    public:
+        Scope(Kind kind, const void* obj, const char* label = NULL) :
+            m_startTick(isEnabled() ? Timer::getTick() : 0),
+            m_obj(obj),
+            m_label(label),
+            m_kind(kind)
+        {}
+
+        ~Scope()
+        {
+            if (m_startTick)
+            {
+                record(m_kind, m_obj, m_label, m_startTick, Timer::getTick());
+            }
+        }
+
+    private:
+        uint64 m_startTick;
+        const void* m_obj;
+        const char* m_label;
+        Kind m_kind;
+
+        Scope(const Scope&);
+        Scope& operator=(const Scope&);
+    };
+
+private:
+    struct Event
+    {
+        uint64 startTick;
+        uint64 endTick;
+        const void* obj;
+        const char* label;
+        int32 kind;
+    };
+
+    // single producer (its render thread), single consumer (the main thread)
+    struct Ring
+    {
+        Event* events;
+        volatile int32 writePos;
+        volatile int32 readPos;
+    };
+
+    struct Name
+    {
+        const void* obj;
+        char name[32];
+
+        void write(BinaryStream&) const {}
+        void fixup(MemoryFixup&) {}
+    };
+
+    enum { k_ringEvents = 8192 }; // power of 2
+
+    static volatile int32 s_enabled;
+    static Ring* s_rings;
+    static int s_numRings;
+    static volatile int32 s_ringsUsed;
+    static int32 s_generation;
+    static FileWriter* s_writer;
+    static uint64 s_startTick;
+    static int s_dropped;
+    static volatile int32 s_droppedCount;
+    static Array<Name> s_names; // sorted by obj
+
+    static CK_THREAD_LOCAL int s_threadRing;
+    static CK_THREAD_LOCAL int32 s_threadGeneration;
+
+    static Ring* getRing();
+    static void drain();
+    static void writeEvent(const Event&, int ring);
+    static const char* findName(const void* obj);
+    static int findNameIndex(const void* obj);
+};
+
+
+}
@@ -0,0 +1,275 @@
+#include "ck/audio/renderworkers.h"
+#include "ck/audio/audionode.h"
+#include "ck/audio/mixnode.h"
+#include "ck/audio/sourcenode.h"
+#include "ck/audio/scratcharena.h"
+#include "ck/core/atomic.h"
+#include "ck/core/thread.h"
+#include "ck/core/mem.h"
+#include "ck/core/system.h"
+#include "ck/core/logger.h"
+#include "ck/core/debug.h"
+
+// template instantiations
+#include "ck/core/list.cpp"
+
+namespace Cki
+{
+
+
+RenderJob::RenderJob() :
+    node(NULL),
+    result(),
+    needsPost(false),
+    m_arena(NULL),
+    m_deferred()
+{
+}
+
+void RenderJob::deferConnect(SourceNode* source)
+{
+    m_deferred.addLast(source);
+}
+
+void RenderJob::applyDeferred()
+{
+    CK_ASSERT(!s_current);
+    SourceNode* source;
+    while ((source = m_deferred.getFirst()) != NULL)
+    {
+        m_deferred.remove(source);
+        source->getMixer()->addInput(source);
+    }
+}
+
+CK_THREAD_LOCAL RenderJob* RenderJob::s_current = NULL;
+
+////////////////////////////////////////
+
+void RenderWorkers::init()
+{
+    CK_ASSERT(!s_instance);
+    int numThreads = System::get()->getConfig().renderThreads;
+    if (numThreads > 1)
+    {
+        s_instance = new RenderWorkers(numThreads);
+        CK_LOG_INFO("rendering with %d threads", numThreads);
+    }
+}
+
+void RenderWorkers::shutdown()
+{
+    delete s_instance;
+    s_instance = NULL;
+}
+
+template <typename T>
+void RenderWorkers::run(int count, int frames, bool post)
+{
+    CK_ASSERT(count <= m_maxJobs);
+    CK_ASSERT((m_claim & k_indexMask) == k_closed);
+
+    // results of the last run have been consumed by now
+    for (int i = 0; i < m_numThreads; ++i)
+    {
+        m_arenas[i]->reset();
+    }
+
+    m_jobCount = count;
+    m_frames = frames;
+    m_post = post;
+    m_process = process<T>;
+    m_doneCount = 0;
+
+    // publish the run under a new generation, so a worker still looking at the
+    // last run can't claim a job from this one
+    int32 generation = ((m_claim >> k_indexBits) + 1) & 0x7fff;
+    Atomic::storeRelease(&m_claim, (int32) (generation << k_indexBits));
+    wake();
+
+    // help out until there are no jobs left, then wait for the workers to
+    // finish theirs (which they are already rendering, so this is short)
+    runJobs(m_arenas[0]);
+    while (Atomic::loadAcquire(&m_doneCount) < count)
+    {
+    }
+
+    Atomic::storeRelease(&m_claim, (int32) ((generation << k_indexBits) | k_closed));
+}
+
+RenderWorkers::RenderWorkers(int numThreads) :
+    m_numThreads(numThreads),
+    m_threads(NULL),
+    m_arenas(NULL),
+    m_jobs(NULL),
+    m_maxJobs(numThreads * k_jobsPerThread),
+    m_jobCount(0),
+    m_frames(0),
+    m_post(false),
+    m_process(NULL),
+    m_claim(k_closed),
+    m_doneCount(0),
+    m_stop(0),
+    m_numStarted(0)
+{
+    CK_ASSERT(m_maxJobs < k_closed);
+    m_jobs = new RenderJob[m_maxJobs];
+
+    m_arenas = (ScratchArena**) Mem::alloc(sizeof(ScratchArena*) * numThreads);
+    for (int i = 0; i < numThreads; ++i)
+    {
+        m_arenas[i] = new ScratchArena(AudioNode::getBufferSamples());
+    }
+
+    m_threads = (Thread**) Mem::alloc(sizeof(Thread*) * (numThreads - 1));
+    for (int i = 0; i < numThreads - 1; ++i)
+    {
+        Thread* thread = new Thread(threadFunc);
+#if !CK_PLATFORM_WP8
+        thread->setPriority(Thread::k_priorityMax);
+#endif
+#if CK_PLATFORM_ANDROID
+        thread->setFlags(Thread::k_flagAttachToJvm);
+#endif
+        thread->setName("CK render worker");
+        m_threads[i] = thread;
+    }
+
+    // start threads only after all members are set up
+    for (int i = 0; i < numThreads - 1; ++i)
+    {
+        m_threads[i]->start(this);
+    }
+}
+
+RenderWorkers::~RenderWorkers()
+{
+    Atomic::storeRelease(&m_stop, (int32) 1);
+    m_mutex.lock();
+    for (int i = 1; i < m_numThreads; ++i)
+    {
+        m_workCond.signal();
+    }
+    m_mutex.unlock();
+
+    for (int i = 0; i < m_numThreads - 1; ++i)
+    {
+        m_threads[i]->join();
+        delete m_threads[i];
+    }
+    Mem::free(m_threads);
+
+    for (int i = 0; i < m_numThreads; ++i)
+    {
+        delete m_arenas[i];
+    }
+    Mem::free(m_arenas);
+
+    delete[] m_jobs;
+}
+
+void RenderWorkers::wake()
+{
+    // Don't wait for the lock; if a worker holds it, it is about to check
+    // m_claim, or will wake up again within k_waitMs (see StreamScheduler::wake()).
+    if (m_mutex.tryLock())
+    {
+        // one signal per worker, since each signal may wake only one
+        for (int i = 1; i < m_numThreads; ++i)
+        {
+            m_workCond.signal();
+        }
+        m_mutex.unlock();
+    }
+}
+
+bool RenderWorkers::runJobs(ScratchArena* arena)
+{
+    bool ran = false;
+    for (;;)
+    {
+        // The run's parameters are read before the claim; if the claim
+        // succeeds, the run was still open, so they were this run's.
+        int32 claim = Atomic::loadAcquire(&m_claim);
+        int index = claim & k_indexMask;
+        int count = m_jobCount;
+        ProcessFunc process = m_process;
+        int frames = m_frames;
+        bool post = m_post;
+        if (index >= count)
+        {
+            break;
+        }
+        if (!Atomic::compareAndSwap(claim, claim + 1, &m_claim))
+        {
+            continue;
+        }
+
+        RenderJob& job = m_jobs[index];
+        job.m_arena = arena;
+        RenderJob::s_current = &job;
+        process(job, frames, post);
+        RenderJob::s_current = NULL;
+        ran = true;
+
+        int32 done;
+        do
+        {
+            done = m_doneCount;
+        }
+        while (!Atomic::compareAndSwap(done, done + 1, &m_doneCount));
+    }
+    return ran;
+}
+
+void RenderWorkers::threadLoop(int index)
+{
+    ScratchArena* arena = m_arenas[index];
+
+    while (!Atomic::loadAcquire(&m_stop))
+    {
+        int32 claim = Atomic::loadAcquire(&m_claim);
+        if (runJobs(arena))
+        {
+            continue;
+        }
+
+        // sleep until the next run is published
+        m_mutex.lock();
+        if (!m_stop && Atomic::loadAcquire(&m_claim) == claim)
+        {
+            m_workCond.wait(m_mutex, k_waitMs);
+        }
+        m_mutex.unlock();
+    }
+}
+
+void* RenderWorkers::threadFunc(void* arg)
+{
+    RenderWorkers* workers = (RenderWorkers*) arg;
+
+    // each worker takes the next scratch arena; arena 0 belongs to the audio thread
+    workers->m_mutex.lock();
+    int index = ++workers->m_numStarted;
+    workers->m_mutex.unlock();
+
+    workers->threadLoop(index);
+    return NULL;
+}
+
+template <typename T>
+void RenderWorkers::process(RenderJob& job, int frames, bool post)
+{
+    job.needsPost = false;
+    job.result = job.node->process<T>(frames, post, job.needsPost);
+}
+
+RenderWorkers* RenderWorkers::s_instance = NULL;
+
+template void RenderWorkers::run<float>(int, int, bool);
+template void RenderWorkers::run<int32>(int, int, bool);
+
+template class List<SourceNode, 1>;
+
+
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/core/allocatable.h"
+#include "ck/core/list.h"
+#include "ck/core/mutex.h"
+#include "ck/core/cond.h"
+#include "ck/audio/bufferhandle.h"
+
+namespace Cki
+{
+
+class AudioNode;
+class ScratchArena;
+class SourceNode;
+class Thread;
+
+
+// One input of a MixNode, to be rendered by whichever render thread picks it up.
+class RenderJob : public Allocatable
+{
+public:
+    RenderJob();
+
+    AudioNode* node;
+    BufferHandle result;
+    bool needsPost;
+
+    // The job currently being rendered on this thread, or NULL.
+    static RenderJob* getCurrent() { return s_current; }
+
+    // Buffers for nodes rendered in this job come from here.
+    ScratchArena* getScratchArena() const { return m_arena; }
+
+    // Connecting a source to its mixer is not safe while jobs are running, since
+    // another job may be rendering that mixer; instead, the source is connected
+    // when applyDeferred() is called on the audio thread after all jobs are done.
+    // The source is held in an intrusive list, so this never allocates.
+    void deferConnect(SourceNode*);
+    void applyDeferred();
+
+private:
+    friend class RenderWorkers;
+
+    ScratchArena* m_arena;
+    List<SourceNode, 1> m_deferred;
+
+    static CK_THREAD_LOCAL RenderJob* s_current;
+
+    RenderJob(const RenderJob&);
+    RenderJob& operator=(const RenderJob&);
+};
+
+
+// Pool of threads that render MixNode inputs in parallel with the audio thread,
+// when CkConfig.renderThreads > 1.
+//
+// Jobs are handed out without locks: the audio thread publishes a run by
+// storing a new generation in m_claim, and each thread (the audio thread
+// included) claims the next job by incrementing its index with compare-and-swap.
+// The audio thread never waits on a lock or condition; it wakes idle workers
+// only if the lock is free, and once there are no jobs left to claim, spins
+// until the workers finish theirs.  A worker that misses a wakeup sleeps for at
+// most k_waitMs, and the audio thread renders the jobs it would have.
+class RenderWorkers : public Allocatable
+{
+public:
+    static void init();
+    static void shutdown();
+    static RenderWorkers* get() { return s_instance; } // NULL if rendering is single-threaded
+
+    // Jobs to be filled in before calling run(); allocated at init, as
+    // k_jobsPerThread per thread.
+    RenderJob* getJobs() { return m_jobs; }
+    int getMaxJobs() const { return m_maxJobs; }
+
+    // Render the nodes of the first count jobs, using the worker threads and
+    // the calling thread; returns when all jobs are done.  Call from the audio
+    // thread only.  Job results are valid only until the next call.
+    template <typename T>
+    void run(int count, int frames, bool post);
+
+    int getThreadCount() const { return m_numThreads; }
+
+private:
+    typedef void (*ProcessFunc)(RenderJob&, int frames, bool post);
+
+    enum { k_jobsPerThread = 16 };
+    enum { k_waitMs = 10 };
+
+    // m_claim holds the run's generation in the high bits, and the index of
+    // the next job to claim in the low bits; k_closed marks a finished run.
+    enum { k_indexBits = 16 };
+    enum { k_indexMask = (1 << k_indexBits) - 1 };
+    enum { k_closed = k_indexMask };
+
+    int m_numThreads;        // including the audio thread
+    Thread** m_threads;      // m_numThreads - 1 worker threads
+    ScratchArena** m_arenas; // one per thread; arena 0 is used by the audio thread
+    RenderJob* m_jobs;
+    int m_maxJobs;
+
+    // set by the audio thread before each run is published in m_claim
+    int m_jobCount;
+    int m_frames;
+    bool m_post;
+    ProcessFunc m_process;
+
+    volatile int32 m_claim;
+    volatile int32 m_doneCount;
+    volatile int32 m_stop;
+
+    Mutex m_mutex; // only for sleeping and waking workers
+    Cond m_workCond;
+    int m_numStarted;
+
+    static RenderWorkers* s_instance;
+
+    RenderWorkers(int numThreads);
+    ~RenderWorkers();
+
+    void wake();
+    bool runJobs(ScratchArena*); // returns false if there were none to claim
+    void threadLoop(int index);
+    static void* threadFunc(void*);
+
+    template <typename T>
+    static void process(RenderJob&, int frames, bool post);
+
+    RenderWorkers(const RenderWorkers&);
+    RenderWorkers& operator=(const RenderWorkers&);
+};
+
+
+}
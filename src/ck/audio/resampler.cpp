@@ -1,29 +1,128 @@
 #include "ck/audio/resampler.h"
 #include "ck/audio/audioutil.h"
+#include "ck/core/system.h"
+#include "ck/core/math.h"
+#include "ck/core/mem.h"
+#include "ck/core/debug.h"
+#include <math.h>
 
 namespace Cki
 {
 
+namespace
+{
+    // Filter output for input frames n..n+k_sincTaps-1 is centered on frame n+k_center,
+    // so resampled output is delayed by k_sincTaps-k_center frames.
+    const int k_center = AudioUtil::k_sincTaps/2 - 1;
+    const int k_delay = AudioUtil::k_sincTaps - k_center;
+
+    // Kaiser window shape; 6 gives about 60 dB stopband attenuation with 32 taps
+    const double k_beta = 6.0;
+
+    // Cutoff, as a fraction of the input sample rate when not downsampling.
+    // Transition band of a 32-tap filter is about 0.11, so this puts the
+    // start of the stopband at the Nyquist frequency.
+    const double k_cutoff = 0.44;
+
+    // zeroth-order modified Bessel function of the first kind
+    double besselI0(double x)
+    {
+        double sum = 1.0;
+        double term = 1.0;
+        double x_2 = x * 0.5;
+        for (int k = 1; k < 50; ++k)
+        {
+            term *= x_2 / k;
+            double term2 = term * term;
+            sum += term2;
+            if (term2 < sum * 1.0e-12)
+            {
+                break;
+            }
+        }
+        return sum;
+    }
+}
 
-Resampler::Resampler()
+
+void Resampler::init()
+{
+    CK_ASSERT(!s_floatTable && !s_fixedTable);
+
+    // only the pipeline in use needs a table
+    if (System::get()->getSampleType() == kCkSampleType_Fixed)
+    {
+        s_fixedTable = (int32*) Mem::alloc(k_numBands * k_bandSize * sizeof(int32));
+    }
+    else
+    {
+        s_floatTable = (float*) Mem::alloc(k_numBands * k_bandSize * sizeof(float));
+    }
+
+    for (int i = 0; i < k_numBands; ++i)
+    {
+        buildBand(i,
+                s_floatTable ? s_floatTable + i * k_bandSize : NULL,
+                s_fixedTable ? s_fixedTable + i * k_bandSize : NULL);
+    }
+}
+
+void Resampler::shutdown()
+{
+    Mem::free(s_floatTable);
+    s_floatTable = NULL;
+    Mem::free(s_fixedTable);
+    s_fixedTable = NULL;
+}
+
+Resampler::Resampler() :
+    m_quality(kCkResampleQuality_Linear),
+    m_fillHistory(false)
 {
     resetState();
 }
 
+void Resampler::setQuality(CkResampleQuality quality)
+{
+    CK_ASSERT(quality == kCkResampleQuality_Linear || quality == kCkResampleQuality_Sinc);
+    if (quality != m_quality)
+    {
+        // avoid a discontinuity when switching to sinc
+        m_fillHistory = (quality == kCkResampleQuality_Sinc);
+        m_quality = quality;
+    }
+}
+
 void Resampler::resample(const int32* inBuf, int inFrames, int32* outBuf, int outFrames, int channels)
 {
-    AudioUtil::resample(inBuf, inFrames, outBuf, outFrames, channels, (int32*) m_lastSample);
+    if (m_quality == kCkResampleQuality_Sinc)
+    {
+        resampleSinc(inBuf, inFrames, outBuf, outFrames, channels);
+    }
+    else
+    {
+        AudioUtil::resample(inBuf, inFrames, outBuf, outFrames, channels, (int32*) m_lastSample);
+    }
 }
 
 void Resampler::resample(const float* inBuf, int inFrames, float* outBuf, int outFrames, int channels)
 {
-    AudioUtil::resample(inBuf, inFrames, outBuf, outFrames, channels, (float*) m_lastSample);
+    if (m_quality == kCkResampleQuality_Sinc)
+    {
+        resampleSinc(inBuf, inFrames, outBuf, outFrames, channels);
+    }
+    else
+    {
+        AudioUtil::resample(inBuf, inFrames, outBuf, outFrames, channels, (float*) m_lastSample);
+    }
 }
 
 void Resampler::resetState()
 {
     m_lastSample[0] = 0;
     m_lastSample[1] = 0;
+    Mem::clear(m_history);
+    m_fillHistory = false;
 }
 
 void Resampler::copyState(const Resampler& other)
@@ -31,7 +130,168 @@ void Resampler::copyState(const Resampler& other)
     // XXX this isn't quite right, if sample rates are not the same
     m_lastSample[0] = other.m_lastSample[0];
     m_lastSample[1] = other.m_lastSample[1];
+    Mem::copy(m_history, other.m_history, sizeof(m_history));
+    m_fillHistory = other.m_fillHistory;
+}
+
+template <typename T>
+void Resampler::resampleSinc(const T* inBuf, int inFrames, T* outBuf, int outFrames, int channels)
+{
+    const int taps = AudioUtil::k_sincTaps;
+    T* history = (T*) m_history;
+
+    if (m_fillHistory)
+    {
+        // fill history with the last sample resampled linearly
+        for (int i = 0; i < taps * channels; ++i)
+        {
+            history[i] = ((T*) m_lastSample)[i % channels];
+        }
+        m_fillHistory = false;
+    }
+
+    // The filter for output frame i uses input frames up to i*factor - 1; the
+    // filter for the first outputs extends back into the previous slice, so
+    // they are filtered from a buffer holding the history followed by the
+    // start of this slice.
+    T head[taps * 2 * 2];
+    int headFrames = Math::min(taps, inFrames);
+    Mem::copy(head, history, taps * channels * sizeof(T));
+    Mem::copy(head + taps * channels, inBuf, headFrames * channels * sizeof(T));
+    Mem::clear(head + (taps + headFrames) * channels, (taps - headFrames) * channels * sizeof(T));
+
+    if (inFrames == outFrames)
+    {
+        // output frames fall exactly on input frames, so just delay
+        int delayFrames = Math::min(k_delay, outFrames);
+        Mem::copy(outBuf, head + k_center * channels, delayFrames * channels * sizeof(T));
+        if (outFrames > k_delay)
+        {
+            Mem::copy(outBuf + k_delay * channels, inBuf, (outFrames - k_delay) * channels * sizeof(T));
+        }
+    }
+    else
+    {
+        float factor = (float) inFrames / outFrames;
+        const T* table = getTable(factor, (const T*) NULL);
+
+        int headOut = 0;
+        while (headOut < outFrames && headOut * factor < taps)
+        {
+            ++headOut;
+        }
+
+        if (channels == 1)
+        {
+            AudioUtil::sincMono(head, outBuf, headOut, 0.0f, factor, table);
+            if (headOut < outFrames)
+            {
+                float pos = Math::max(0.0f, headOut * factor - taps);
+                AudioUtil::sincMono(inBuf, outBuf + headOut, outFrames - headOut, pos, factor, table);
+            }
+        }
+        else
+        {
+            AudioUtil::sincStereo(head, outBuf, headOut, 0.0f, factor, table);
+            if (headOut < outFrames)
+            {
+                float pos = Math::max(0.0f, headOut * factor - taps);
+                AudioUtil::sincStereo(inBuf, outBuf + headOut * 2, outFrames - headOut, pos, factor, table);
+            }
+        }
+    }
+
+    // keep the last input frames for the next slice
+    if (inFrames >= taps)
+    {
+        Mem::copy(history, inBuf + (inFrames - taps) * channels, taps * channels * sizeof(T));
+    }
+    else
+    {
+        Mem::copy(history, head + inFrames * channels, taps * channels * sizeof(T));
+    }
+
+    // in case we switch to linear
+    for (int i = 0; i < channels; ++i)
+    {
+        ((T*) m_lastSample)[i] = inBuf[(inFrames - 1) * channels + i];
+    }
 }
 
+int Resampler::getBand(float factor)
+{
+    // Use the band with the highest cutoff that doesn't alias audibly.
+    // Aliases of frequencies in the band's transition region fold back only above
+    // 90% of the output Nyquist frequency, so the band factor can be a little
+    // smaller than the resampling factor.
+    float minFactor = factor * 0.9f;
+    for (int i = 0; i < k_numBands; ++i)
+    {
+        if (k_bandFactors[i] >= minFactor)
+        {
+            return i;
+        }
+    }
+    return k_numBands - 1;
+}
+
+void Resampler::buildBand(int band, float* floatTable, int32* fixedTable)
+{
+    const int taps = AudioUtil::k_sincTaps;
+    const int phases = AudioUtil::k_sincPhases;
+
+    double cutoff = k_cutoff / k_bandFactors[band];
+    double halfWidth = taps / 2;
+    double i0Beta = besselI0(k_beta);
+
+    // one extra phase, for interpolating past the last
+    double coefs[phases + 1][taps];
+    for (int p = 0; p <= phases; ++p)
+    {
+        double frac = (double) p / phases;
+        double sum = 0.0;
+        for (int j = 0; j < taps; ++j)
+        {
+            double x = j - k_center - frac;
+            double t = x / halfWidth;
+            double window = (t > -1.0 && t < 1.0) ? besselI0(k_beta * ::sqrt(1.0 - t*t)) / i0Beta : 0.0;
+            double arg = 2.0 * cutoff * x;
+            double sinc = (arg == 0.0) ? 1.0 : ::sin(Math::k_pi * arg) / (Math::k_pi * arg);
+            coefs[p][j] = 2.0 * cutoff * sinc * window;
+            sum += coefs[p][j];
+        }
+
+        // normalize for unity gain at DC
+        for (int j = 0; j < taps; ++j)
+        {
+            coefs[p][j] /= sum;
+        }
+    }
+
+    for (int p = 0; p < phases; ++p)
+    {
+        for (int j = 0; j < taps; ++j)
+        {
+            double coef = coefs[p][j];
+            double delta = coefs[p+1][j] - coef;
+            int index = p * taps * 2 + j;
+            if (floatTable)
+            {
+                floatTable[index] = (float) coef;
+                floatTable[index + taps] = (float) delta;
+            }
+            if (fixedTable)
+            {
+                fixedTable[index] = (int32) ::floor(coef * (1 << 30) + 0.5);
+                fixedTable[index + taps] = (int32) ::floor(delta * (1 << 30) + 0.5);
+            }
+        }
+    }
+}
+
+const float Resampler::k_bandFactors[k_numBands] = { 1.0f, 1.25f, 1.5f, 2.0f, 2.5f, 3.0f, 4.0f };
+float* Resampler::s_floatTable = NULL;
+int32* Resampler::s_fixedTable = NULL;
+
 
 }
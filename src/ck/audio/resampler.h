@@ -3,6 +3,8 @@
 #include "ck/core/platform.h"
 #include "ck/core/types.h"
 #include "ck/audio/varsample.h"
+#include "ck/audio/audioutil.h"
+#include "ck/resamplequality.h"
 
 namespace Cki
 {
@@ -11,8 +13,19 @@ namespace Cki
 class Resampler
 {
 public:
+    // build/free the sinc filter tables
+    static void init();
+    static void shutdown();
+
     Resampler();
 
+    void setQuality(CkResampleQuality); // linear or sinc
+    CkResampleQuality getQuality() const { return m_quality; }
+
+    // If true, input must be passed through resample() even when the input and
+    // output frame counts are the same, to keep the filter delay consistent.
+    bool isDelayed() const { return m_quality == kCkResampleQuality_Sinc; }
+
     void resample(const int32* inBuf, int inFrames, int32* outBuf, int outFrames, int channels);
     void resample(const float* inBuf, int inFrames, float* outBuf, int outFrames, int channels);
 
@@ -20,7 +33,25 @@ public:
     void copyState(const Resampler&);
 
 private:
+    CkResampleQuality m_quality;
     VarSample m_lastSample[2];
+    VarSample m_history[AudioUtil::k_sincTaps * 2]; // last input frames, for sinc filter
+    bool m_fillHistory;
+
+    template <typename T> void resampleSinc(const T* inBuf, int inFrames, T* outBuf, int outFrames, int channels);
+
+    // Each table band is designed for downsampling by a different factor, with
+    // the cutoff frequency lowered accordingly to prevent aliasing.
+    enum { k_numBands = 7 };
+    enum { k_bandSize = AudioUtil::k_sincPhases * AudioUtil::k_sincTaps * 2 };
+    static const float k_bandFactors[k_numBands];
+    static float* s_floatTable;
+    static int32* s_fixedTable;
+
+    static int getBand(float factor);
+    static const float* getTable(float factor, const float*) { return s_floatTable + getBand(factor) * k_bandSize; }
+    static const int32* getTable(float factor, const int32*) { return s_fixedTable + getBand(factor) * k_bandSize; }
+    static void buildBand(int band, float* floatTable, int32* fixedTable);
 };
 
 
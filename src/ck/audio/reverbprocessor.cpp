@@ -0,0 +1,420 @@
+#include "ck/audio/reverbprocessor.h"
+#include "ck/audio/audioutil.h"
+#include "ck/effectparam.h"
+#include "ck/core/math.h"
+#include "ck/core/mem.h"
+#include "ck/core/debug.h"
+#include "ck/core/logger.h"
+
+namespace Cki
+{
+
+
+namespace
+{
+    // Delay line lengths at the largest size; mutually prime at 48 kHz, and
+    // in increasing order.
+    const float k_baseDelayMs[ReverbProcessor::k_lines] =
+    {
+        31.3f, 37.1f, 41.1f, 47.3f, 53.9f, 61.7f, 67.3f, 79.1f
+    };
+
+    const float k_minSizeScale = 0.25f;   // delay scale at size 0
+    const float k_maxPreDelayMs = 100.0f;
+    const float k_minDecayTime = 0.1f;
+    const float k_maxDecayTime = 30.0f;
+    const float k_maxDampCoef = 0.85f;    // damping coefficient at damping 1
+
+    const float k_inputGain = 0.35f;
+    const float k_outputGain = 0.3f;
+    const float k_hadamardScale = 0.35355339f; // 1/sqrt(8), so the matrix is orthogonal
+
+    // Keeps the lines out of the denormal range as the reverb dies away.
+    const float k_antiDenormal = 1.0e-18f;
+
+    // Fraction of the remaining change made each block, and the largest delay
+    // change per frame (which shifts pitch by up to the same fraction).
+    const float k_smoothing = 0.1f;
+    const float k_maxDelayChange = 1.0f / 16.0f;
+
+    const ReverbProcessor::Kernels k_kernelsDefault = { ReverbProcessor::interp_default, ReverbProcessor::feedback_default };
+
+    float smooth(float value, float target, float epsilon, bool& changing)
+    {
+        float diff = target - value;
+        if (Math::abs(diff) <= epsilon)
+        {
+            return target;
+        }
+        changing = true;
+        return value + diff * k_smoothing;
+    }
+}
+
+
+ReverbProcessor::ReverbProcessor() :
+    m_size(0.5f),
+    m_decayTime(1.5f),
+    m_damping(0.5f),
+    m_preDelayMs(20.0f),
+    m_preDelay(0.0f),
+    m_targetPreDelay(0.0f),
+    m_curDecayTime(0.0f),
+    m_curDamping(0.0f),
+    m_changing(false),
+    m_mem(NULL),
+    m_input(NULL),
+    m_scratch(NULL)
+{
+    float framesPerMs = getSampleRate() / 1000.0f;
+
+    // one allocation for all lines and buffers
+    int lineSizes[k_lines];
+    int floats = 0;
+    for (int i = 0; i < k_lines; ++i)
+    {
+        lineSizes[i] = (int) (k_baseDelayMs[i] * framesPerMs) + k_scratchFrames;
+        floats += lineSizes[i];
+    }
+    int preDelaySize = (int) (k_maxPreDelayMs * framesPerMs) + 2 * k_scratchFrames;
+    floats += preDelaySize;
+    floats += (k_lines + 1) * (k_blockFrames + 1) + k_scratchFrames;
+
+    m_mem = (float*) Mem::alloc(floats * sizeof(float));
+    if (!m_mem)
+    {
+        return;
+    }
+
+    float* p = m_mem;
+    for (int i = 0; i < k_lines; ++i)
+    {
+        m_lines[i].buf = p;
+        m_lines[i].size = lineSizes[i];
+        p += lineSizes[i];
+    }
+    m_preDelayLine.buf = p;
+    m_preDelayLine.size = preDelaySize;
+    p += preDelaySize;
+    for (int i = 0; i < k_lines; ++i)
+    {
+        m_taps[i] = p;
+        p += k_blockFrames + 1;
+    }
+    m_input = p;
+    p += k_blockFrames + 1;
+    m_scratch = p;
+
+    reset();
+}
+
+ReverbProcessor::~ReverbProcessor()
+{
+    Mem::free(m_mem);
+}
+
+void ReverbProcessor::setParam(int paramId, float value)
+{
+    switch (paramId)
+    {
+        case kCkReverbParam_Size:
+            m_size = Math::clamp(value, 0.0f, 1.0f);
+            break;
+
+        case kCkReverbParam_DecayTime:
+            m_decayTime = Math::clamp(value, k_minDecayTime, k_maxDecayTime);
+            break;
+
+        case kCkReverbParam_Damping:
+            m_damping = Math::clamp(value, 0.0f, 1.0f);
+            break;
+
+        case kCkReverbParam_PreDelayMs:
+            m_preDelayMs = Math::clamp(value, 0.0f, k_maxPreDelayMs);
+            break;
+
+        default:
+            CK_LOG_ERROR("Reverb effect: unknown param ID %d", paramId);
+            return;
+    }
+
+    setTargets();
+}
+
+void ReverbProcessor::reset()
+{
+    if (!m_mem)
+    {
+        return;
+    }
+
+    for (int i = 0; i < k_lines; ++i)
+    {
+        DelayLine& line = m_lines[i];
+        Mem::clear(line.buf, line.size * sizeof(float));
+        line.writePos = 0;
+        m_dampState[i] = 0.0f;
+    }
+    Mem::clear(m_preDelayLine.buf, m_preDelayLine.size * sizeof(float));
+    m_preDelayLine.writePos = 0;
+
+    // jump straight to the current parameters
+    setTargets();
+    for (int i = 0; i < k_lines; ++i)
+    {
+        m_delays[i] = m_targetDelays[i];
+    }
+    m_preDelay = m_targetPreDelay;
+    m_curDecayTime = m_decayTime;
+    m_curDamping = m_damping;
+    m_changing = true;
+    updateParams(0);
+}
+
+void ReverbProcessor::process_default(int* inBuf, int* outBuf, int frames)
+{
+    processFixed(inBuf, frames, k_kernelsDefault, AudioUtil::convertI32toF32_default, AudioUtil::convertF32toI32_default);
+}
+
+void ReverbProcessor::process_default(float* inBuf, float* outBuf, int frames)
+{
+    processFloat(inBuf, frames, k_kernelsDefault);
+}
+
+void ReverbProcessor::interp_default(const float* in, float frac, float* out, int n)
+{
+    for (int i = 0; i < n; ++i)
+    {
+        out[i] = in[i] + frac * (in[i+1] - in[i]);
+    }
+}
+
+void ReverbProcessor::feedback_default(float* const* taps, const float* gains, float dampCoef, float* damp, const float* input, float outGain, float* out, int frames)
+{
+    for (int i = 0; i < frames; ++i)
+    {
+        float v[k_lines];
+        for (int j = 0; j < k_lines; ++j)
+        {
+            float x = taps[j][i];
+            damp[j] = x + dampCoef * (damp[j] - x);
+            v[j] = damp[j];
+        }
+
+        out[2*i] = (v[0] + v[2] + v[4] + v[6]) * outGain;
+        out[2*i + 1] = (v[1] + v[3] + v[5] + v[7]) * outGain;
+
+        for (int j = 0; j < k_lines; ++j)
+        {
+            v[j] *= gains[j];
+        }
+
+        // fast Walsh-Hadamard transform (the 1/sqrt(8) is in gains)
+        for (int dist = 1; dist < k_lines; dist *= 2)
+        {
+            for (int j = 0; j < k_lines; j += 2 * dist)
+            {
+                for (int k = j; k < j + dist; ++k)
+                {
+                    float a = v[k];
+                    float b = v[k + dist];
+                    v[k] = a + b;
+                    v[k + dist] = a - b;
+                }
+            }
+        }
+
+        for (int j = 0; j < k_lines; ++j)
+        {
+            taps[j][i] = v[j] + input[i];
+        }
+    }
+}
+
+////////////////////////////////////////
+
+void ReverbProcessor::processFloat(float* buf, int frames, const Kernels& kernels)
+{
+    if (!m_mem)
+    {
+        return;
+    }
+
+    while (frames > 0)
+    {
+        // Each line must be longer than a block, so a block is written only
+        // after it has been read.  That is only a limit at very low sample rates.
+        int maxFrames = (int) Math::min(m_delays[0], m_targetDelays[0]) - 2;
+        int n = Math::min(frames, Math::min((int) k_blockFrames, maxFrames));
+        processBlock(buf, n, kernels);
+        buf += n * 2;
+        frames -= n;
+    }
+}
+
+void ReverbProcessor::processFixed(int32* buf, int frames, const Kernels& kernels,
+        void (*toFloat)(const int32*, float*, int), void (*toFixed)(const float*, int32*, int))
+{
+    // convert in place
+    float* floatBuf = (float*) buf;
+    toFloat(buf, floatBuf, frames * 2);
+    processFloat(floatBuf, frames, kernels);
+    toFixed(floatBuf, buf, frames * 2);
+}
+
+void ReverbProcessor::processBlock(float* buf, int frames, const Kernels& kernels)
+{
+    float startDelays[k_lines];
+    for (int i = 0; i < k_lines; ++i)
+    {
+        startDelays[i] = m_delays[i];
+    }
+    float startPreDelay = m_preDelay;
+    updateParams(frames);
+
+    // mono input, through the pre-delay (which is read after it is written,
+    // so it is read from one block further back)
+    const float inputScale = 0.5f * k_inputGain;
+    for (int i = 0; i < frames; ++i)
+    {
+        m_input[i] = (buf[2*i] + buf[2*i + 1]) * inputScale + k_antiDenormal;
+    }
+    write(m_preDelayLine, m_input, frames);
+    read(m_preDelayLine, startPreDelay + frames, m_preDelay + frames, m_input, frames, kernels.interp);
+
+    for (int i = 0; i < k_lines; ++i)
+    {
+        read(m_lines[i], startDelays[i], m_delays[i], m_taps[i], frames, kernels.interp);
+    }
+
+    // damp, mix, and feed back
+    float dampCoef = m_curDamping * k_maxDampCoef;
+    kernels.feedback(m_taps, m_gains, dampCoef, m_dampState, m_input, k_outputGain, buf, frames);
+    for (int i = 0; i < k_lines; ++i)
+    {
+        write(m_lines[i], m_taps[i], frames);
+    }
+}
+
+void ReverbProcessor::setTargets()
+{
+    float framesPerMs = getSampleRate() / 1000.0f;
+    float scale = k_minSizeScale + (1.0f - k_minSizeScale) * m_size;
+    for (int i = 0; i < k_lines; ++i)
+    {
+        m_targetDelays[i] = k_baseDelayMs[i] * scale * framesPerMs;
+    }
+    m_targetPreDelay = Math::max(m_preDelayMs * framesPerMs, 2.0f);
+    m_changing = true;
+}
+
+void ReverbProcessor::updateParams(int frames)
+{
+    if (!m_changing)
+    {
+        return;
+    }
+
+    bool changing = false;
+    float maxChange = frames * k_maxDelayChange;
+    for (int i = 0; i < k_lines; ++i)
+    {
+        float diff = m_targetDelays[i] - m_delays[i];
+        if (Math::abs(diff) <= 0.01f)
+        {
+            m_delays[i] = m_targetDelays[i];
+        }
+        else
+        {
+            m_delays[i] += Math::clamp(diff * k_smoothing, -maxChange, maxChange);
+            changing = true;
+        }
+    }
+    float diff = m_targetPreDelay - m_preDelay;
+    if (Math::abs(diff) <= 0.01f)
+    {
+        m_preDelay = m_targetPreDelay;
+    }
+    else
+    {
+        m_preDelay += Math::clamp(diff * k_smoothing, -maxChange, maxChange);
+        changing = true;
+    }
+    m_curDecayTime = smooth(m_curDecayTime, m_decayTime, m_decayTime * 0.001f, changing);
+    m_curDamping = smooth(m_curDamping, m_damping, 0.001f, changing);
+
+    // gain per pass through each line, for a 60 dB decay in m_curDecayTime
+    float sampleRate = (float) getSampleRate();
+    for (int i = 0; i < k_lines; ++i)
+    {
+        float dB = -60.0f * m_delays[i] / (m_curDecayTime * sampleRate);
+        m_gains[i] = Math::pow(10.0f, dB/20.0f) * k_hadamardScale;
+    }
+
+    m_changing = changing;
+}
+
+void ReverbProcessor::read(const DelayLine& line, float startDelay, float endDelay, float* out, int frames, InterpFunc interp)
+{
+    // position of the first frame
+    float pos = line.writePos - startDelay;
+    if (pos < 0.0f)
+    {
+        pos += line.size;
+    }
+    int first = (int) pos;
+    float frac = pos - first;
+    if (first >= line.size)
+    {
+        // pos rounded up to size
+        first -= line.size;
+    }
+
+    // when the delay is changing, frames are step apart instead of 1
+    float step = 1.0f - (endDelay - startDelay) / frames;
+    int count = (startDelay == endDelay ? frames + 1 : (int) (frac + (frames - 1) * step) + 2);
+    CK_ASSERT(count <= k_scratchFrames);
+
+    const float* src = line.buf + first;
+    if (first + count > line.size)
+    {
+        // wraps around the end of the line
+        int n = line.size - first;
+        Mem::copy(m_scratch, src, n * sizeof(float));
+        Mem::copy(m_scratch + n, line.buf, (count - n) * sizeof(float));
+        src = m_scratch;
+    }
+
+    if (startDelay == endDelay)
+    {
+        interp(src, frac, out, frames);
+    }
+    else
+    {
+        for (int i = 0; i < frames; ++i)
+        {
+            float p = frac + i * step;
+            int index = (int) p;
+            float f = p - index;
+            out[i] = src[index] + f * (src[index + 1] - src[index]);
+        }
+    }
+}
+
+void ReverbProcessor::write(DelayLine& line, const float* in, int frames)
+{
+    int n = Math::min(frames, line.size - line.writePos);
+    Mem::copy(line.buf + line.writePos, in, n * sizeof(float));
+    if (n < frames)
+    {
+        Mem::copy(line.buf, in + n, (frames - n) * sizeof(float));
+    }
+    line.writePos += frames;
+    if (line.writePos >= line.size)
+    {
+        line.writePos -= line.size;
+    }
+}
+
+
+}
@@ -0,0 +1,139 @@
+#include "ck/audio/reverbprocessor.h"
+#include "ck/audio/audioutil.h"
+#include "ck/core/debug.h"
+
+#if CK_ARM_NEON
+#  include <arm_neon.h>
+#endif
+
+namespace Cki
+{
+
+
+#if CK_ARM_NEON
+namespace
+{
+    const ReverbProcessor::Kernels k_kernelsNeon = { ReverbProcessor::interp_neon, ReverbProcessor::feedback_neon };
+
+    inline void transpose4(float32x4_t& a, float32x4_t& b, float32x4_t& c, float32x4_t& d)
+    {
+        float32x4x2_t ab = vtrnq_f32(a, b);
+        float32x4x2_t cd = vtrnq_f32(c, d);
+        a = vcombine_f32(vget_low_f32(ab.val[0]), vget_low_f32(cd.val[0]));
+        b = vcombine_f32(vget_low_f32(ab.val[1]), vget_low_f32(cd.val[1]));
+        c = vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0]));
+        d = vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1]));
+    }
+}
+
+void ReverbProcessor::process_neon(int* inBuf, int* outBuf, int frames)
+{
+    processFixed(inBuf, frames, k_kernelsNeon, AudioUtil::convertI32toF32_neon, AudioUtil::convertF32toI32_neon);
+}
+
+void ReverbProcessor::process_neon(float* inBuf, float* outBuf, int frames)
+{
+    processFloat(inBuf, frames, k_kernelsNeon);
+}
+
+void ReverbProcessor::interp_neon(const float* in, float frac, float* out, int n)
+{
+    float32x4_t f = vdupq_n_f32(frac);
+    int i = 0;
+    for ( ; i + 4 <= n; i += 4)
+    {
+        float32x4_t a = vld1q_f32(in + i);
+        float32x4_t b = vld1q_f32(in + i + 1);
+        vst1q_f32(out + i, vaddq_f32(a, vmulq_f32(f, vsubq_f32(b, a))));
+    }
+    interp_default(in + i, frac, out + i, n - i);
+}
+
+void ReverbProcessor::feedback_neon(float* const* taps, const float* gains, float dampCoef, float* damp, const float* input, float outGain, float* out, int frames)
+{
+    // Each vector holds 4 frames of one line, so the feedback matrix is just
+    // adds and subtracts between vectors.  For the damping filters, each group
+    // of 4 lines is transposed, so a vector holds 4 lines of one frame.
+    float32x4_t og = vdupq_n_f32(outGain);
+    float32x4_t c = vdupq_n_f32(dampCoef);
+    float32x4_t g[k_lines];
+    for (int j = 0; j < k_lines; ++j)
+    {
+        g[j] = vdupq_n_f32(gains[j]);
+    }
+    float32x4_t y0 = vld1q_f32(damp);
+    float32x4_t y1 = vld1q_f32(damp + 4);
+
+    int i = 0;
+    for ( ; i + 4 <= frames; i += 4)
+    {
+        float32x4_t v[k_lines];
+        for (int j = 0; j < k_lines; ++j)
+        {
+            v[j] = vld1q_f32(taps[j] + i);
+        }
+
+        transpose4(v[0], v[1], v[2], v[3]);
+        transpose4(v[4], v[5], v[6], v[7]);
+        for (int k = 0; k < 4; ++k)
+        {
+            y0 = vaddq_f32(v[k], vmulq_f32(c, vsubq_f32(y0, v[k])));
+            y1 = vaddq_f32(v[k+4], vmulq_f32(c, vsubq_f32(y1, v[k+4])));
+            v[k] = y0;
+            v[k+4] = y1;
+        }
+        transpose4(v[0], v[1], v[2], v[3]);
+        transpose4(v[4], v[5], v[6], v[7]);
+
+        float32x4_t left = vmulq_f32(vaddq_f32(vaddq_f32(v[0], v[2]), vaddq_f32(v[4], v[6])), og);
+        float32x4_t right = vmulq_f32(vaddq_f32(vaddq_f32(v[1], v[3]), vaddq_f32(v[5], v[7])), og);
+        float32x4x2_t lr = { { left, right } };
+        vst2q_f32(out + 2*i, lr);
+
+        for (int j = 0; j < k_lines; ++j)
+        {
+            v[j] = vmulq_f32(v[j], g[j]);
+        }
+
+        for (int dist = 1; dist < k_lines; dist *= 2)
+        {
+            for (int j = 0; j < k_lines; j += 2 * dist)
+            {
+                for (int k = j; k < j + dist; ++k)
+                {
+                    float32x4_t a = v[k];
+                    float32x4_t b = v[k + dist];
+                    v[k] = vaddq_f32(a, b);
+                    v[k + dist] = vsubq_f32(a, b);
+                }
+            }
+        }
+
+        float32x4_t in = vld1q_f32(input + i);
+        for (int j = 0; j < k_lines; ++j)
+        {
+            vst1q_f32(taps[j] + i, vaddq_f32(v[j], in));
+        }
+    }
+    vst1q_f32(damp, y0);
+    vst1q_f32(damp + 4, y1);
+
+    if (i < frames)
+    {
+        float* rest[k_lines];
+        for (int j = 0; j < k_lines; ++j)
+        {
+            rest[j] = taps[j] + i;
+        }
+        feedback_default(rest, gains, dampCoef, damp, input + i, outGain, out + 2*i, frames - i);
+    }
+}
+#else
+void ReverbProcessor::process_neon(int* inBuf, int* outBuf, int frames) {}
+void ReverbProcessor::process_neon(float* inBuf, float* outBuf, int frames) {}
+void ReverbProcessor::interp_neon(const float* in, float frac, float* out, int n) {}
+void ReverbProcessor::feedback_neon(float* const* taps, const float* gains, float dampCoef, float* damp, const float* input, float outGain, float* out, int frames) {}
+#endif
+
+
+}
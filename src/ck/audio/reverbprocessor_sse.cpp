@@ -0,0 +1,129 @@
+#include "ck/audio/reverbprocessor.h"
+#include "ck/audio/audioutil.h"
+#include "ck/core/debug.h"
+
+#if CK_X86_SSE
+#  include <xmmintrin.h>
+#endif
+
+namespace Cki
+{
+
+
+#if CK_X86_SSE
+namespace
+{
+    const ReverbProcessor::Kernels k_kernelsSse = { ReverbProcessor::interp_sse, ReverbProcessor::feedback_sse };
+}
+
+void ReverbProcessor::process_sse(int* inBuf, int* outBuf, int frames)
+{
+    processFixed(inBuf, frames, k_kernelsSse, AudioUtil::convertI32toF32_sse, AudioUtil::convertF32toI32_sse);
+}
+
+void ReverbProcessor::process_sse(float* inBuf, float* outBuf, int frames)
+{
+    processFloat(inBuf, frames, k_kernelsSse);
+}
+
+void ReverbProcessor::interp_sse(const float* in, float frac, float* out, int n)
+{
+    __m128 f = _mm_set1_ps(frac);
+    int i = 0;
+    for ( ; i + 4 <= n; i += 4)
+    {
+        __m128 a = _mm_loadu_ps(in + i);
+        __m128 b = _mm_loadu_ps(in + i + 1);
+        _mm_storeu_ps(out + i, _mm_add_ps(a, _mm_mul_ps(f, _mm_sub_ps(b, a))));
+    }
+    interp_default(in + i, frac, out + i, n - i);
+}
+
+void ReverbProcessor::feedback_sse(float* const* taps, const float* gains, float dampCoef, float* damp, const float* input, float outGain, float* out, int frames)
+{
+    // Each vector holds 4 frames of one line, so the feedback matrix is just
+    // adds and subtracts between vectors.  For the damping filters, each group
+    // of 4 lines is transposed, so a vector holds 4 lines of one frame.
+    __m128 og = _mm_set1_ps(outGain);
+    __m128 c = _mm_set1_ps(dampCoef);
+    __m128 g[k_lines];
+    for (int j = 0; j < k_lines; ++j)
+    {
+        g[j] = _mm_set1_ps(gains[j]);
+    }
+    __m128 y0 = _mm_loadu_ps(damp);
+    __m128 y1 = _mm_loadu_ps(damp + 4);
+
+    int i = 0;
+    for ( ; i + 4 <= frames; i += 4)
+    {
+        __m128 v[k_lines];
+        for (int j = 0; j < k_lines; ++j)
+        {
+            v[j] = _mm_loadu_ps(taps[j] + i);
+        }
+
+        _MM_TRANSPOSE4_PS(v[0], v[1], v[2], v[3]);
+        _MM_TRANSPOSE4_PS(v[4], v[5], v[6], v[7]);
+        for (int k = 0; k < 4; ++k)
+        {
+            y0 = _mm_add_ps(v[k], _mm_mul_ps(c, _mm_sub_ps(y0, v[k])));
+            y1 = _mm_add_ps(v[k+4], _mm_mul_ps(c, _mm_sub_ps(y1, v[k+4])));
+            v[k] = y0;
+            v[k+4] = y1;
+        }
+        _MM_TRANSPOSE4_PS(v[0], v[1], v[2], v[3]);
+        _MM_TRANSPOSE4_PS(v[4], v[5], v[6], v[7]);
+
+        __m128 left = _mm_mul_ps(_mm_add_ps(_mm_add_ps(v[0], v[2]), _mm_add_ps(v[4], v[6])), og);
+        __m128 right = _mm_mul_ps(_mm_add_ps(_mm_add_ps(v[1], v[3]), _mm_add_ps(v[5], v[7])), og);
+        _mm_storeu_ps(out + 2*i, _mm_unpacklo_ps(left, right));
+        _mm_storeu_ps(out + 2*i + 4, _mm_unpackhi_ps(left, right));
+
+        for (int j = 0; j < k_lines; ++j)
+        {
+            v[j] = _mm_mul_ps(v[j], g[j]);
+        }
+
+        for (int dist = 1; dist < k_lines; dist *= 2)
+        {
+            for (int j = 0; j < k_lines; j += 2 * dist)
+            {
+                for (int k = j; k < j + dist; ++k)
+                {
+                    __m128 a = v[k];
+                    __m128 b = v[k + dist];
+                    v[k] = _mm_add_ps(a, b);
+                    v[k + dist] = _mm_sub_ps(a, b);
+                }
+            }
+        }
+
+        __m128 in = _mm_loadu_ps(input + i);
+        for (int j = 0; j < k_lines; ++j)
+        {
+            _mm_storeu_ps(taps[j] + i, _mm_add_ps(v[j], in));
+        }
+    }
+    _mm_storeu_ps(damp, y0);
+    _mm_storeu_ps(damp + 4, y1);
+
+    if (i < frames)
+    {
+        float* rest[k_lines];
+        for (int j = 0; j < k_lines; ++j)
+        {
+            rest[j] = taps[j] + i;
+        }
+        feedback_default(rest, gains, dampCoef, damp, input + i, outGain, out + 2*i, frames - i);
+    }
+}
+#else
+void ReverbProcessor::process_sse(int* inBuf, int* outBuf, int frames) {}
+void ReverbProcessor::process_sse(float* inBuf, float* outBuf, int frames) {}
+void ReverbProcessor::interp_sse(const float* in, float frac, float* out, int n) {}
+void ReverbProcessor::feedback_sse(float* const* taps, const float* gains, float dampCoef, float* damp, const float* input, float outGain, float* out, int frames) {}
+#endif
+
+
+}
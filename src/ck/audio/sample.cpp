@@ -22,10 +22,13 @@ void Sample::write(BinaryStream& stream) const
     stream << dataSize;
     stream << (uint64) 0; // data
 
-    int pos = stream.getPos();
-    stream.setPos(stream.getSize());
-    stream.write(data, dataSize);
-    stream.setPos(pos);
+    if (data)
+    {
+        int pos = stream.getPos();
+        stream.setPos(stream.getSize());
+        stream.write(data, dataSize);
+        stream.setPos(pos);
+    }
 }
 
 void Sample::fixup(MemoryFixup& fixup)
@@ -24,6 +24,8 @@ struct Sample
     uint32 pad;
 #endif
 
+    // Data is appended to the end of the stream.  If data is NULL, nothing is
+    // appended; the caller must write dataSize bytes there itself.
     void write(BinaryStream&) const;
     void fixup(MemoryFixup&);
 };
@@ -0,0 +1,218 @@
+#include "ck/audio/sampleindex.h"
+#include "ck/audio/bankdata.h"
+#include "ck/core/binarystream.h"
+#include "ck/core/mem.h"
+#include "ck/core/debug.h"
+
+namespace Cki
+{
+
+
+// Image layout: marker, slot count (a power of 2), then the slots.
+
+SampleIndex::SampleIndex() :
+    m_slots(NULL),
+    m_mask(0),
+    m_owned(false)
+{
+}
+
+SampleIndex::~SampleIndex()
+{
+    if (m_owned)
+    {
+        Mem::free((void*) m_slots);
+    }
+}
+
+bool SampleIndex::attach(const BankData& bankData, const void* buf, int bytes)
+{
+    CK_ASSERT(!m_slots);
+    if (bytes < 8 || !buf)
+    {
+        return false;
+    }
+
+    // the header may not be aligned, so it is copied out
+    const byte* p = (const byte*) buf;
+    FourCharCode marker;
+    int32 numSlots;
+    Mem::copy(&marker, p, sizeof(marker));
+    Mem::copy(&numSlots, p + 4, sizeof(numSlots));
+    if (marker != k_marker)
+    {
+        return false;
+    }
+
+    int numSamples = bankData.getNumSamples();
+    if (numSlots <= numSamples || (numSlots & (numSlots - 1)) != 0 ||
+        numSlots > (bytes - 8) / (int) sizeof(Slot))
+    {
+        return false;
+    }
+
+    // the slots are used in place, so must be aligned; if not, the index is
+    // built on the heap instead
+    if (((size_t) (p + 8) & (sizeof(int32) - 1)) != 0)
+    {
+        return false;
+    }
+
+    // find() stops at an empty slot, so there must be one
+    const Slot* slots = (const Slot*) (p + 8);
+    bool hasEmpty = false;
+    for (int i = 0; i < numSlots; ++i)
+    {
+        if (slots[i].sample < -1 || slots[i].sample >= numSamples)
+        {
+            return false;
+        }
+        if (slots[i].sample == -1)
+        {
+            hasEmpty = true;
+        }
+    }
+    if (!hasEmpty)
+    {
+        return false;
+    }
+
+    m_slots = slots;
+    m_mask = numSlots - 1;
+    m_owned = false;
+    return true;
+}
+
+bool SampleIndex::build(const BankData& bankData)
+{
+    CK_ASSERT(!m_slots);
+    int numSlots = getNumSlots(bankData.getNumSamples());
+    Slot* slots = (Slot*) Mem::alloc(numSlots * sizeof(Slot));
+    if (!slots)
+    {
+        return false;
+    }
+    fill(slots, numSlots, bankData);
+
+    m_slots = slots;
+    m_mask = numSlots - 1;
+    m_owned = true;
+    return true;
+}
+
+bool SampleIndex::isValid() const
+{
+    return m_slots != NULL;
+}
+
+int SampleIndex::find(const BankData& bankData, const char* name) const
+{
+    if (!m_slots)
+    {
+        return -1;
+    }
+
+    uint32 hash = SoundName::hash(name);
+    for (int i = hash & m_mask; m_slots[i].sample >= 0; i = (i + 1) & m_mask)
+    {
+        const Slot& slot = m_slots[i];
+        if (slot.hash == hash && bankData.getSample(slot.sample).name == name)
+        {
+            return slot.sample;
+        }
+    }
+    return -1;
+}
+
+int SampleIndex::find(uint32 hash) const
+{
+    if (!m_slots)
+    {
+        return -1;
+    }
+
+    for (int i = hash & m_mask; m_slots[i].sample >= 0; i = (i + 1) & m_mask)
+    {
+        if (m_slots[i].hash == hash)
+        {
+            return m_slots[i].sample;
+        }
+    }
+    return -1;
+}
+
+int SampleIndex::getNumSlots() const
+{
+    return m_slots ? m_mask + 1 : 0;
+}
+
+const SampleIndex::Slot& SampleIndex::getSlot(int i) const
+{
+    CK_ASSERT(i >= 0 && i <= m_mask);
+    return m_slots[i];
+}
+
+int SampleIndex::write(BinaryStream& stream, const BankData& bankData)
+{
+    int numSlots = getNumSlots(bankData.getNumSamples());
+    Slot* slots = (Slot*) Mem::alloc(numSlots * sizeof(Slot));
+    int collisions = fill(slots, numSlots, bankData);
+
+    stream << k_marker;
+    stream << (int32) numSlots;
+    for (int i = 0; i < numSlots; ++i)
+    {
+        stream << slots[i].hash;
+        stream << slots[i].sample;
+    }
+
+    Mem::free(slots);
+    return collisions;
+}
+
+const FourCharCode SampleIndex::k_marker('c', 'k', 's', 'i');
+
+////////////////////////////////////////
+
+int SampleIndex::getNumSlots(int numSamples)
+{
+    // at most half full, so probe sequences stay short and there is always an empty slot
+    int numSlots = 2;
+    while (numSlots < numSamples * 2)
+    {
+        numSlots *= 2;
+    }
+    return numSlots;
+}
+
+int SampleIndex::fill(Slot* slots, int numSlots, const BankData& bankData)
+{
+    int mask = numSlots - 1;
+    for (int i = 0; i < numSlots; ++i)
+    {
+        slots[i].hash = 0;
+        slots[i].sample = -1;
+    }
+
+    // insert in order, so the first of any samples with the same hash is found first
+    int collisions = 0;
+    for (int sample = 0; sample < bankData.getNumSamples(); ++sample)
+    {
+        uint32 hash = bankData.getSample(sample).name.getHash();
+        int i = hash & mask;
+        while (slots[i].sample >= 0)
+        {
+            if (slots[i].hash == hash)
+            {
+                ++collisions;
+            }
+            i = (i + 1) & mask;
+        }
+        slots[i].hash = hash;
+        slots[i].sample = sample;
+    }
+    return collisions;
+}
+
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/core/types.h"
+#include "ck/audio/fourcharcode.h"
+
+namespace Cki
+{
+
+class BankData;
+class BinaryStream;
+
+
+// Open-addressing hash table of the sample names in a bank.  cktool writes
+// it into the bank file after the sample data; for banks built without one,
+// it is built when the bank is loaded.
+class SampleIndex
+{
+public:
+    SampleIndex();
+    ~SampleIndex();
+
+    // Use the index at the start of buf, if there is a valid one.
+    bool attach(const BankData&, const void* buf, int bytes);
+
+    // Build the index on the heap.
+    bool build(const BankData&);
+
+    bool isValid() const;
+
+    // Return the sample index, or -1 if not found.  If several names have the
+    // same hash, find(hash) returns the first of them.
+    int find(const BankData&, const char* name) const;
+    int find(uint32 hash) const;
+
+    struct Slot
+    {
+        uint32 hash;
+        int32 sample; // -1 if empty
+    };
+
+    int getNumSlots() const;
+    const Slot& getSlot(int) const;
+
+    // Write the index for a bank to a file; returns the number of samples
+    // whose names have the same hash as an earlier one.
+    static int write(BinaryStream&, const BankData&);
+
+    static const FourCharCode k_marker;
+
+private:
+    const Slot* m_slots;
+    int m_mask;
+    bool m_owned;
+
+    static int getNumSlots(int numSamples);
+    static int fill(Slot*, int numSlots, const BankData&);
+
+    SampleIndex(const SampleIndex&);
+    SampleIndex& operator=(const SampleIndex&);
+};
+
+
+}
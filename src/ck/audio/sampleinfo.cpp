@@ -19,6 +19,7 @@ void SampleInfo::reset()
     loopStart = 0;
     loopEnd = (uint32) -1;
     loopCount = 0;
+    flags = 0;
 }
 
 void SampleInfo::write(BinaryStream& stream) const
@@ -34,7 +35,7 @@ void SampleInfo::write(BinaryStream& stream) const
     stream << loopStart;
     stream << loopEnd;
     stream << loopCount;
-    stream << (uint16) 0; // pad
+    stream << flags;
 }
 
 void SampleInfo::read(BinaryStream& stream)
@@ -50,7 +51,7 @@ void SampleInfo::read(BinaryStream& stream)
     stream >> loopStart;
     stream >> loopEnd;
     stream >> loopCount;
-    stream.skip(2); // pad
+    stream >> flags;
 }
 
 byte* SampleInfo::read(byte* data)
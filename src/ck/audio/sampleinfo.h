@@ -23,6 +23,12 @@ struct SampleInfo
     uint32 loopStart; // default 0
     uint32 loopEnd;   // default blocks * blockFrames
     int16 loopCount; // default 0
+    uint16 flags;
+
+    enum
+    {
+        k_hot = 0x1, // keep decoded in the DecodeCache
+    };
 
     void reset();
 
@@ -0,0 +1,127 @@
+#include "ck/audio/scratcharena.h"
+#include "ck/core/debug.h"
+#include "ck/core/mem.h"
+#include "ck/core/math.h"
+#include "ck/core/logger.h"
+
+namespace Cki
+{
+
+
+// Both the fixed-point and floating-point pipelines use 32-bit samples, so one
+// slot size serves either.
+CK_STATIC_ASSERT(sizeof(float) == sizeof(int32));
+
+ScratchArena::ScratchArena(int bufSize) :
+    m_bufSize(bufSize),
+    m_slotBytes(0),
+    m_blocks(NULL),
+    m_numBlocks(0),
+    m_blockCapacity(0),
+    m_count(0),
+    m_quantumPeak(0),
+    m_peak(0)
+{
+    int bytes = bufSize * (int) sizeof(int32);
+    m_slotBytes = (bytes + k_alignment - 1) & ~(k_alignment - 1);
+
+    for (int i = 0; i < k_initialBlocks; ++i)
+    {
+        if (!grow())
+        {
+            break;
+        }
+    }
+}
+
+ScratchArena::~ScratchArena()
+{
+    for (int i = 0; i < m_numBlocks; ++i)
+    {
+        Mem::free(m_blocks[i]);
+    }
+    Mem::free(m_blocks);
+}
+
+BufferHandle ScratchArena::acquire()
+{
+    int block = m_count / k_slotsPerBlock;
+    if (block >= m_numBlocks && !grow())
+    {
+        CK_FAIL("out of buffers");
+        return BufferHandle();
+    }
+
+    void* mem = m_blocks[block] + (m_count % k_slotsPerBlock) * m_slotBytes;
+    if (++m_count > m_quantumPeak)
+    {
+        m_quantumPeak = m_count;
+    }
+    return BufferHandle(mem);
+}
+
+void ScratchArena::rewind(Mark mark)
+{
+    CK_ASSERT(mark >= 0 && mark <= m_count);
+    m_count = mark;
+}
+
+void ScratchArena::reset()
+{
+#if CK_DEBUG
+    verify();
+#endif
+    if (m_quantumPeak > m_peak)
+    {
+        m_peak = m_quantumPeak;
+    }
+    m_quantumPeak = 0;
+    m_count = 0;
+}
+
+int ScratchArena::getPeak() const
+{
+    return Math::max(m_peak, m_quantumPeak);
+}
+
+#if CK_DEBUG
+void ScratchArena::verify()
+{
+    for (int i = 0; i < m_numBlocks; ++i)
+    {
+        Mem::verifyMem(m_blocks[i]);
+    }
+}
+#endif
+
+bool ScratchArena::grow()
+{
+    if (m_numBlocks == m_blockCapacity)
+    {
+        int capacity = Math::max((int) k_initialBlocks * 2, m_blockCapacity * 2);
+        byte** blocks = (byte**) Mem::alloc(capacity * sizeof(byte*));
+        if (!blocks)
+        {
+            return false;
+        }
+        if (m_blocks)
+        {
+            Mem::copy(blocks, m_blocks, m_numBlocks * sizeof(byte*));
+            Mem::free(m_blocks);
+        }
+        m_blocks = blocks;
+        m_blockCapacity = capacity;
+    }
+
+    byte* block = (byte*) Mem::alloc(k_slotsPerBlock * m_slotBytes, k_alignment);
+    if (!block)
+    {
+        CK_LOG_ERROR("Could not allocate scratch buffers");
+        return false;
+    }
+    m_blocks[m_numBlocks++] = block;
+    return true;
+}
+
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/core/types.h"
+#include "ck/core/allocatable.h"
+#include "ck/audio/bufferhandle.h"
+
+namespace Cki
+{
+
+
+// Scratch buffers for rendering.  Buffers are handed out from the top of a stack of
+// fixed-size, 64-byte-aligned slots; reset() frees them all at the start of each
+// render quantum, and rewind() frees everything acquired since a mark, so a node
+// can reuse the space its inputs used once it has consumed their output.
+// Slots are allocated in blocks.  Enough are allocated up front for a deeply
+// nested graph (each level of mixer or effect bus holds only a few buffers while
+// its inputs render), so acquire() does not normally allocate; if a quantum does
+// need more buffers than that, a block is added on the rendering thread.
+
+class ScratchArena : public Allocatable
+{
+public:
+    ScratchArena(int bufSize); // number of samples per buffer
+    ~ScratchArena();
+
+    BufferHandle acquire();
+    int getBufferSize() const { return m_bufSize; }
+
+    typedef int Mark;
+    Mark getMark() const { return m_count; }
+    void rewind(Mark);
+    void reset();
+
+    int getCount() const { return m_count; }        // buffers in use
+    int getCapacity() const { return m_numBlocks * k_slotsPerBlock; }
+    int getPeak() const;                             // most buffers used in a single quantum
+
+#if CK_DEBUG
+    void verify();
+#endif
+
+private:
+    enum { k_slotsPerBlock = 16 };
+    enum { k_initialBlocks = 2 }; // enough for mixers and effect buses nested about 7 deep
+    enum { k_alignment = 64 }; // for faster ARM NEON accesses, and to keep slots on separate cache lines
+
+    int m_bufSize;
+    int m_slotBytes;
+    byte** m_blocks;
+    int m_numBlocks;
+    int m_blockCapacity;
+    int m_count;
+    int m_quantumPeak;
+    int m_peak;
+
+    bool grow();
+
+    ScratchArena(const ScratchArena&);
+    ScratchArena& operator=(const ScratchArena&);
+};
+
+
+}
@@ -6,6 +6,8 @@
 #include "ck/audio/customstreamsound.h"
 #include "ck/audio/vorbisstreamsound.h"
 #include "ck/audio/mixer.h"
+#include "ck/audio/rendertrace.h"
+#include "ck/audio/voicemanager.h"
 #include "ck/core/string.h"
 #include "ck/core/path.h"
 #include "ck/core/debug.h"
@@ -44,45 +46,6 @@ void Sound::AttenParams::set(CkAttenuationMode mode, float nearDist, float farDi
     m_nearDist = Math::max(nearDist, k_minDist);
     m_farDist = Math::max(farDist, m_nearDist + k_minDist);
     m_farVol = Math::clamp(farVol, 0.0f, 1.0f);
-
-    switch (mode)
-    {
-        case kCkAttenuationMode_InvDistance:
-            {
-                // v = a/r + b
-                // a = (vf - 1)/(1/rf - 1/rn)
-                // where vf = far volume
-                //       rf = far distance
-                //       rn = near distance
-                float rnInv = 1.0f / m_nearDist;
-                float rfInv = 1.0f / m_farDist;
-                float a = (m_farVol - 1.0f)/(rfInv - rnInv);
-                float b = 1.0f - a*rnInv;
-                m_consts[0] = a;
-                m_consts[1] = b;
-            }
-            break;
-
-        case kCkAttenuationMode_InvDistanceSquared:
-            {
-                // v = a/r^2 + b
-                // a = (vf - 1)/(1/rf^2 - 1/rn^2)
-                // where vf = far volume
-                //       rf = far distance
-                //       rn = near distance
-                float rnInvSq = 1.0f / (m_nearDist * m_nearDist);
-                float rfInvSq = 1.0f / (m_farDist * m_farDist);
-                float a = (m_farVol - 1.0f)/(rfInvSq - rnInvSq);
-                float b = 1.0f - a*rnInvSq;
-                m_consts[0] = a;
-                m_consts[1] = b;
-            }
-            break;
-
-        default:
-            m_consts[0] = m_consts[1] = 0.0f;
-            break;
-    }
 }
 
 ////////////////////////////////////////
@@ -95,6 +58,7 @@ Vector3 Sound::s_3dListenerLookAt(0.0f, 0.0f, 1.0f);
 Vector3 Sound::s_3dListenerUp(0.0f, 0.1f, 0.0f);
 Sound::AttenParams Sound::s_3dAtten;
 float Sound::s_3dSoundSpeed = 0.0f;
+bool Sound::s_3dComputed = false;
 
 CkSound::CustomStreamFunc Sound::s_handler = NULL;
 void* Sound::s_handlerData = NULL;
@@ -108,6 +72,7 @@ Sound::Sound() :
     m_panSet(false),
     m_paused(false),
     m_speed(1.0f),
+    m_resampleQuality(kCkResampleQuality_Default),
     m_mixer(Mixer::getMaster()),
     m_nextSound(NULL),
     m_3d(false),
@@ -116,11 +81,16 @@ Sound::Sound() :
     m_3dSpeed(1.0f),
     m_3dPos(0.0f, 0.0f, 0.0f),
     m_3dVel(0.0f, 0.0f, 0.0f),
+    m_3dSlot(-1),
     m_virtual(false),
     m_virtualStopMs(-1.0f),
-    m_playWhenReady(false)
+    m_priority(1.0f),
+    m_voiceStolen(false),
+    m_playWhenReady(false),
+    m_playWhenReadyTime(-1)
 {
     m_panMatrix.setZero();
+    m_name[0] = '\0';
     s_soundList.addFirst(this);
     m_mixer->addSound(this); // master
 }
@@ -147,6 +117,7 @@ void Sound::setMixer(CkMixer* mixer)
         m_mixer->removeSound(this);
         m_mixer = (Mixer*) mixer;
         m_mixer->addSound(this);
+        updateMixerGain();
         if (isPlaying() || m_prevSounds.getSize())
         {
             updateVolumeAndPan();
@@ -165,6 +136,16 @@ bool Sound::isReady() const
 }
 
 void Sound::play()
+{
+    playAt(-1);
+}
+
+void Sound::stop()
+{
+    stopAt(-1);
+}
+
+void Sound::playAt(int64 time)
 {
     if (isFailed())
     {
@@ -172,7 +153,7 @@ void Sound::play()
         return;
     }
 
-    stop();
+    stopAt(time);
 
     if (isReadySub())
     {
@@ -183,7 +164,7 @@ void Sound::play()
         updateVolumeAndPan();
         updateSpeed();
 
-        playSub();
+        playSub(time);
 
         if (isVirtual())
         {
@@ -196,12 +177,13 @@ void Sound::play()
     {
         CK_LOG_INFO("sound is not ready; will delay until it is");
         m_playWhenReady = true;
+        m_playWhenReadyTime = time;
     }
 }
 
-void Sound::stop()
+void Sound::stopAt(int64 time)
 {
-    stopSub();
+    stopSub(time);
     m_playWhenReady = false;
 }
 
@@ -235,6 +217,11 @@ bool Sound::getMixedPauseState() const
 }
 
 void Sound::setVolume(float volume)
+{
+    setVolumeAt(volume, -1);
+}
+
+void Sound::setVolumeAt(float volume, int64 time)
 {
     m_volumeSet = true;
     if (m_volume != volume)
@@ -242,7 +229,7 @@ void Sound::setVolume(float volume)
         m_volume = volume;
         if (isPlaying() || m_prevSounds.getSize())
         {
-            updateVolumeAndPan();
+            updateVolumeAndPan(time);
         }
     }
 }
@@ -370,6 +357,36 @@ float Sound::getPitchShift() const
     return Math::log(2.0f, getSpeed()) * 12.0f;
 }
 
+void Sound::setResampleQuality(CkResampleQuality quality)
+{
+    if (quality != kCkResampleQuality_Default && quality != kCkResampleQuality_Linear && quality != kCkResampleQuality_Sinc)
+    {
+        CK_LOG_ERROR("invalid resample quality (%d)", quality);
+        return;
+    }
+
+    if (m_resampleQuality != quality)
+    {
+        m_resampleQuality = quality;
+        updateResampleQuality();
+    }
+}
+
+CkResampleQuality Sound::getResampleQuality() const
+{
+    return m_resampleQuality;
+}
+
+void Sound::setPriority(float priority)
+{
+    m_priority = Math::max(priority, 0.0f);
+}
+
+float Sound::getPriority() const
+{
+    return m_priority;
+}
+
 void Sound::setNextSound(CkSound* nextSound)
 {
     if (nextSound && (!getSourceNode() || !((Sound*)nextSound)->getSourceNode()))
@@ -393,10 +410,30 @@ CkSound* Sound::getNextSound() const
     return (CkSound*) m_nextSound;
 }
 
+bool Sound::getStreamStats(CkStreamStats&) const
+{
+    return false;
+}
+
 void Sound::set3dEnabled(bool enabled)
 {
     if (m_3d != enabled)
     {
+        if (enabled)
+        {
+            if (!Spatializer::add(&m_3dSlot))
+            {
+                CK_LOG_ERROR("Could not allocate memory for 3D sound");
+                return;
+            }
+            Spatializer::setPosition(m_3dSlot, m_3dPos);
+            Spatializer::setVelocity(m_3dSlot, m_3dVel);
+        }
+        else
+        {
+            Spatializer::remove(m_3dSlot);
+        }
+
         m_3d = enabled;
         if (enabled)
         {
@@ -422,12 +459,16 @@ bool Sound::is3dEnabled() const
 
 bool Sound::isVirtual() const
 {
-    return m_3d && m_virtual;
+    return (m_3d && m_virtual) || m_voiceStolen;
 }
 
 void Sound::set3dPosition(float x, float y, float z)
 {
     m_3dPos.set(x, y, z);
+    if (m_3d)
+    {
+        Spatializer::setPosition(m_3dSlot, m_3dPos);
+    }
 }
 
 void Sound::get3dPosition(float& x, float& y, float& z) const
@@ -440,6 +481,10 @@ void Sound::get3dPosition(float& x, float& y, float& z) const
 void Sound::set3dVelocity(float vx, float vy, float vz)
 {
     m_3dVel.set(vx, vy, vz);
+    if (m_3d)
+    {
+        Spatializer::setVelocity(m_3dSlot, m_3dVel);
+    }
 }
 
 void Sound::get3dVelocity(float& vx, float& vy, float& vz) const
@@ -521,12 +566,39 @@ float Sound::get3dSoundSpeed()
 
 void Sound::updateAll()
 {
-    Sound* p = s_soundList.getFirst();
+    bool tracing = RenderTrace::isEnabled();
+
+    // compute 3D volume, pan, and speed of all 3D sounds at once
+    if (Spatializer::getCount() > 0)
+    {
+        Spatializer::Params params;
+        get3dParams(params);
+        Spatializer::computeAll(params);
+        s_3dComputed = true;
+    }
+
+    Sound* first = s_soundList.getFirst();
+    Sound* p = first;
     while (p)
     {
         p->update();
+
+        if (tracing && p->m_name[0])
+        {
+            // source nodes may be reused after a sound is destroyed, so keep the names current
+            SourceNode* node = p->getSourceNode();
+            if (node)
+            {
+                RenderTrace::setName(node, p->m_name);
+            }
+        }
+
         p = ((SoundList::Node*) p)->getNext();
     }
+
+    s_3dComputed = false;
+
+    VoiceManager::update(first);
 }
 
 SourceNode* Sound::getSourceNode()
@@ -534,6 +606,16 @@ SourceNode* Sound::getSourceNode()
     return NULL;
 }
 
+void Sound::setName(const char* name)
+{
+    int i = 0;
+    for ( ; name[i] && i < (int) sizeof(m_name) - 1; ++i)
+    {
+        m_name[i] = name[i];
+    }
+    m_name[i] = '\0';
+}
+
 Sound* Sound::newBankSound(Bank* bank, int index)
 {
     if (index < 0 || index >= bank->getNumSounds())
@@ -568,6 +650,29 @@ Sound* Sound::newBankSound(Bank* bank, const char* name)
     }
 }
 
+Sound* Sound::newBankSound(Bank* bank, uint32 hash)
+{
+    const Sample* sample = NULL;
+    if (bank)
+    {
+        sample = bank->findSample(hash);
+    }
+    else
+    {
+        sample = Bank::findSample(hash, &bank);
+    }
+
+    if (sample)
+    {
+        return new BankSound(*sample, bank);
+    }
+    else
+    {
+        CK_LOG_ERROR("Could not find sample with id %08x", hash);
+        return NULL;
+    }
+}
+
 Sound* Sound::newStreamSound(const char* path, CkPathType pathType, int offset, int length, const char* extension)
 {
     if (s_handler)
@@ -576,7 +681,12 @@ Sound* Sound::newStreamSound(const char* path, CkPathType pathType, int offset,
         CkCustomStream* stream = s_handler(fullPath.getBuffer(), s_handlerData);
         if (stream)
         {
-            return new CustomStreamSound(stream);
+            Sound* sound = new CustomStreamSound(stream);
+            if (sound)
+            {
+                sound->setName(fullPath.getLeaf());
+            }
+            return sound;
         }
     }
 
@@ -686,6 +796,11 @@ void Sound::destroyImpl()
     {
         m_mixer->removeSound(this);
     }
+    if (m_3d)
+    {
+        Spatializer::remove(m_3dSlot);
+        m_3d = false;
+    }
     Proxied<Sound>::destroy();
 }
 
@@ -728,7 +843,7 @@ float Sound::getFinalPan() const
     }
 }
 
-void Sound::getFinalVolumeMatrix(VolumeMatrix& mat) const
+void Sound::getSourceVolumeMatrix(VolumeMatrix& mat) const
 {
     if (!m_3d && m_panMatrixExplicit)
     {
@@ -747,7 +862,12 @@ void Sound::getFinalVolumeMatrix(VolumeMatrix& mat) const
         }
     }
 
-    mat *= getFinalVolume();
+    float vol = getVolume();
+    if (m_3d)
+    {
+        vol *= m_3dVol;
+    }
+    mat *= vol;
 }
 
 float Sound::getFinalSpeed() const
@@ -760,6 +880,15 @@ float Sound::getFinalSpeed() const
     return speed;
 }
 
+CkResampleQuality Sound::getFinalResampleQuality() const
+{
+    if (m_resampleQuality == kCkResampleQuality_Default)
+    {
+        return System::get()->getConfig().resampleQuality;
+    }
+    return m_resampleQuality;
+}
+
 void Sound::update()
 {
     updateSub();
@@ -771,13 +900,16 @@ void Sound::update()
 
     if (m_playWhenReady && isReadySub())
     {
-        play();
+        playAt(m_playWhenReadyTime);
         m_playWhenReady = false;
     }
 
-    if (isPlaying() && isVirtual())
+    if (isPlaying() && isVirtual() && !getSourceNode())
     {
-        // very rough simulation of progress of virtual sound: if it would have stopped by now
+        // Sounds rendered by the audio graph keep decoding while virtual, so
+        // they stop on their own; for others (e.g. native streams, which are
+        // paused while virtual), a very rough simulation of progress of
+        // virtual sound: if it would have stopped by now
         if (m_virtualStopMs >= 0.0f && m_virtualTimer.getElapsedMs() >= m_virtualStopMs)
         {
             stop();
@@ -789,112 +921,21 @@ void Sound::update3d()
 {
     CK_ASSERT(m_3d);
 
-    Vector3 d = m_3dPos - s_3dListenerPos; // vector from listener to object
-
-    // distance attenuation
-    //  when dist > far, volume = farVol
-    //  when dist < near, volume = 1.0f
-    // TODO: sound-specific attenuation
-    float dist = d.getMagnitude();
-    float invDist = 1.0f / dist;
-
-    float vol = 0.0f;
-    if (dist <= s_3dAtten.m_nearDist)
-    {
-        vol = 1.0f;
-    }
-    else if (dist >= s_3dAtten.m_farDist)
-    {
-        vol = s_3dAtten.m_farVol;
-    }
-    else
-    {
-        switch (s_3dAtten.m_mode)
-        {
-            case kCkAttenuationMode_None:
-                vol = 1.0f;
-                break;
-
-            case kCkAttenuationMode_Linear:
-                vol = Math::remap(dist, s_3dAtten.m_nearDist, s_3dAtten.m_farDist, 1.0f, s_3dAtten.m_farVol);
-                break;
-
-            case kCkAttenuationMode_InvDistance:
-                {
-                    // v = a/r + b
-                    // a = (vf - 1)/(1/rf - 1/rn)
-                    // where vf = far volume
-                    //       rf = far distance
-                    //       rn = near distance
-                    vol = s_3dAtten.m_consts[0] * invDist + s_3dAtten.m_consts[1];
-                }
-                break;
-
-            case kCkAttenuationMode_InvDistanceSquared:
-                {
-                    // v = a/r^2 + b
-                    // a = (vf - 1)/(1/rf^2 - 1/rn^2)
-                    // where vf = far volume
-                    //       rf = far distance
-                    //       rn = near distance
-                    vol = s_3dAtten.m_consts[0] * invDist * invDist + s_3dAtten.m_consts[1];
-                }
-                break;
-        }
-        vol = Math::clamp(vol, s_3dAtten.m_farVol, 1.0f);
-    }
-
-
-
-    // panning
-    //   when dist > near, pan based on projection of d on ear plane
-    //   when dist < nearMin, pan = 0
-    //   when dist is between near and nearMin, linearly interpolate
-
-    float nearMinDist = 0.1f * s_3dAtten.m_nearDist; // TODO configurable
-    float pan;
-    if (dist < nearMinDist)
+    if (!s_3dComputed)
     {
-        pan = 0.0f;
-    }
-    else
-    {
-        Vector3 listenerForward = s_3dListenerLookAt - s_3dListenerPos;
-
-        // project onto listener's ear plane:
-        //   up x (d x up) 
-        Vector3 dPlane = s_3dListenerUp.cross(d.cross(s_3dListenerUp));
-        float dMag = dPlane.getMagnitude();
-        if (dMag < 0.0001f)
-        {
-            // object is nearly right above listener
-            pan = 0.0f;
-        }
-        else
-        {
-            Vector3::scale(dPlane, dPlane, 1.0f/dMag);
-
-            Vector3 listenerRight = listenerForward.cross(s_3dListenerUp);
-            listenerRight.normalize();
-            pan = dPlane.dot(listenerRight);
-        }
-        if (dist < s_3dAtten.m_nearDist)
-        {
-            pan = Math::remap(dist, nearMinDist, s_3dAtten.m_nearDist, 0.0f, pan);
-        }
+        Spatializer::Params params;
+        get3dParams(params);
+        Spatializer::compute(m_3dSlot, params);
     }
 
+    float vol = Spatializer::getVolume(m_3dSlot);
+    float pan = Spatializer::getPan(m_3dSlot);
 
     // doppler
     if (s_3dSoundSpeed > 0.0f)
     {
-        float vMin = -s_3dSoundSpeed * 0.99f;
-        float vs = m_3dVel.dot(d) * invDist; // component of source velocity towards listener
-        float vr = s_3dListenerVel.dot(-d) * invDist; // component of source velocity towards listener
-        vs = Math::max(vs, vMin);
-        vr = Math::max(vr, vMin);
-        float freqRatio = (s_3dSoundSpeed + vr) / (s_3dSoundSpeed + vs);
-        if (freqRatio != m_3dSpeed)
+        float freqRatio = Spatializer::getSpeed(m_3dSlot);
+        if (Math::abs(freqRatio - m_3dSpeed) > 0.0001f * m_3dSpeed)
         {
             m_3dSpeed = freqRatio;
             updateSpeed();
@@ -904,7 +945,12 @@ void Sound::update3d()
     // virtual?
     setVirtual(vol < 0.005f);
 
-    if (vol != m_3dVol || (pan != m_3dPan && vol > 0.001f))
+    // only update for audible changes, so sounds that are barely moving
+    // don't send commands to the audio thread every frame
+    bool volChanged = (vol != m_3dVol) &&
+        (Math::abs(vol - m_3dVol) > 0.001f * m_3dVol || vol == 1.0f || vol == s_3dAtten.m_farVol);
+    bool panChanged = Math::abs(pan - m_3dPan) > 0.001f && vol > 0.001f;
+    if (volChanged || panChanged)
     {
         m_3dVol = vol;
         m_3dPan = pan;
@@ -912,11 +958,38 @@ void Sound::update3d()
     }
 }
 
+void Sound::get3dParams(Spatializer::Params& params)
+{
+    params.set(s_3dListenerPos, s_3dListenerVel, s_3dListenerLookAt, s_3dListenerUp,
+               s_3dAtten.m_mode, s_3dAtten.m_nearDist, s_3dAtten.m_farDist, s_3dAtten.m_farVol,
+               s_3dSoundSpeed);
+}
+
 void Sound::setVirtual(bool virt)
 {
     if (virt != m_virtual)
     {
+        bool wasVirtual = isVirtual();
         m_virtual = virt;
+        virtualChanged(wasVirtual);
+    }
+}
+
+void Sound::setVoiceStolen(bool stolen)
+{
+    if (stolen != m_voiceStolen)
+    {
+        bool wasVirtual = isVirtual();
+        m_voiceStolen = stolen;
+        virtualChanged(wasVirtual);
+    }
+}
+
+void Sound::virtualChanged(bool wasVirtual)
+{
+    bool virt = isVirtual();
+    if (virt != wasVirtual)
+    {
         updateVirtual();
 
         if (virt)
@@ -9,6 +9,7 @@
 #include "ck/pathtype.h"
 #include "ck/sound.h"
 #include "ck/audio/volumematrix.h"
+#include "ck/audio/spatializer.h"
 #include "ck/audio/effectbus.h"
 
 namespace Cki
@@ -49,6 +50,8 @@ public:
 
     virtual void play();
     virtual void stop();
+    virtual void playAt(int64 time);
+    virtual void stopAt(int64 time);
     virtual bool isPlaying() const = 0; 
 
     virtual void setPaused(bool);
@@ -69,6 +72,7 @@ public:
     virtual float getPlayPositionMs() const = 0;
 
     void setVolume(float);
+    void setVolumeAt(float, int64 time);
     float getVolume() const;
     float getMixedVolume() const; // affected by mixers (but not 3D attenuation)
 
@@ -84,6 +88,12 @@ public:
     void setPitchShift(float halfSteps);
     float getPitchShift() const;
 
+    void setResampleQuality(CkResampleQuality);
+    CkResampleQuality getResampleQuality() const;
+
+    void setPriority(float);
+    float getPriority() const;
+
     virtual void setNextSound(CkSound*);
     virtual CkSound* getNextSound() const;
 
@@ -91,6 +101,7 @@ public:
     virtual float getLengthMs() const = 0;
     virtual int getSampleRate() const = 0;
     virtual int getChannels() const = 0;
+    virtual bool getStreamStats(CkStreamStats&) const;
 
     void set3dEnabled(bool);
     bool is3dEnabled() const;
@@ -116,13 +127,19 @@ public:
     static void updateAll();
 
     // should be called only by mixer or subclasses:
-    virtual void updateVolumeAndPan() = 0;
+    // time is the sample time at which the change takes effect, or negative for now
+    virtual void updateVolumeAndPan(int64 time = -1) = 0;
     virtual void updatePaused() = 0;
 
     virtual SourceNode* getSourceNode();
 
+    // identifies the sound in a render trace: the bank sound's name, or the
+    // stream's file name; empty if unknown
+    const char* getName() const { return m_name; }
+
     static Sound* newBankSound(Bank* bank, int index);
     static Sound* newBankSound(Bank* bank, const char* name);
+    static Sound* newBankSound(Bank* bank, uint32 hash);
     static Sound* newStreamSound(const char* filename, CkPathType, int offset, int length, const char* extension);
     static void setCustomStreamHandler(CustomStreamFunc, void* data);
 #if CK_PLATFORM_IOS
@@ -138,23 +155,31 @@ protected:
     bool m_panSet; // if true, pan was set explicitly by API (overriding values from data file)
     bool m_paused;
     float m_speed;
+    CkResampleQuality m_resampleQuality;
     Mixer* m_mixer;
     Sound* m_nextSound;
 
+    void setName(const char*); // truncated if too long
     void destroyImpl();
     void removePrevSounds();
 
     float getFinalVolume() const;
     float getFinalPan() const;
-    void  getFinalVolumeMatrix(VolumeMatrix&) const;
+    void  getSourceVolumeMatrix(VolumeMatrix&) const; // without the mixer volume; see MixerGain
     float getFinalSpeed() const;
+    CkResampleQuality getFinalResampleQuality() const;
 
     virtual void update();
     virtual void updateSpeed() = 0;
+    virtual void updateResampleQuality() {} // only for sounds resampled by the audio graph
+    virtual void updateMixerGain() {} // only for sounds rendered by the audio graph
     virtual void updateVirtual() = 0;
 
-    virtual void playSub() = 0;
-    virtual void stopSub() = 0;
+    friend class VoiceManager;
+
+    // time is a sample time, as for updateVolumeAndPan()
+    virtual void playSub(int64 time) = 0;
+    virtual void stopSub(int64 time) = 0;
     virtual void updateSub() = 0;
     virtual bool isReadySub() const = 0;
 
@@ -168,7 +193,6 @@ private:
         float m_nearDist;
         float m_farDist;
         float m_farVol;
-        float m_consts[2]; // cached constants
     };
 
     bool m_3d;
@@ -177,12 +201,17 @@ private:
     float m_3dSpeed;
     Vector3 m_3dPos;
     Vector3 m_3dVel;
+    int m_3dSlot; // in Spatializer, or -1
     bool m_virtual;
 //    AttenParams m_3dAtten;
     Timer m_virtualTimer;
     float m_virtualStopMs;
+    float m_priority;
+    bool m_voiceStolen; // made virtual by VoiceManager
     bool m_playWhenReady;
+    int64 m_playWhenReadyTime;
     SoundPrevList m_prevSounds;
+    char m_name[32];
 
     static SoundList s_soundList;
     static Vector3 s_3dListenerPos;
@@ -191,12 +220,16 @@ private:
     static Vector3 s_3dListenerUp;
     static AttenParams s_3dAtten;
     static float s_3dSoundSpeed;
+    static bool s_3dComputed; // Spatializer results are current for all sounds
 
     static CustomStreamFunc s_handler;
     static void* s_handlerData;
 
     void update3d();
+    static void get3dParams(Spatializer::Params&);
     void setVirtual(bool);
+    void setVoiceStolen(bool);
+    void virtualChanged(bool wasVirtual);
     void startVirtualTimer();
     float getMsLeft();
 };
@@ -0,0 +1,176 @@
+#include "ck/audio/soundindex.h"
+#include "ck/audio/bank.h"
+#include "ck/audio/sample.h"
+#include "ck/core/mem.h"
+#include "ck/core/debug.h"
+
+namespace Cki
+{
+
+
+void SoundIndex::add(Bank* bank)
+{
+    s_banks.insert(SoundName::hash(bank->getName()), bank, -1);
+
+    const SampleIndex& index = bank->getIndex();
+    for (int i = 0; i < index.getNumSlots(); ++i)
+    {
+        const SampleIndex::Slot& slot = index.getSlot(i);
+        if (slot.sample >= 0)
+        {
+            s_samples.insert(slot.hash, bank, slot.sample);
+        }
+    }
+}
+
+void SoundIndex::remove(Bank* bank)
+{
+    s_banks.remove(bank);
+    s_samples.remove(bank);
+}
+
+Bank* SoundIndex::findBank(const char* name)
+{
+    uint32 hash = SoundName::hash(name);
+    Bank* found = NULL;
+    for (const Entry* e = s_banks.getFirst(hash); e; e = s_banks.getNext(e))
+    {
+        if (e->sample != k_removed && e->hash == hash && 
+            (!found || e->bank->getSerial() > found->getSerial()) &&
+            e->bank->getBankData().getName() == name)
+        {
+            found = e->bank;
+        }
+    }
+    return found;
+}
+
+const Sample* SoundIndex::findSample(uint32 hash, const char* name, Bank** bankOut)
+{
+    const Entry* found = NULL;
+    for (const Entry* e = s_samples.getFirst(hash); e; e = s_samples.getNext(e))
+    {
+        if (e->sample != k_removed && e->hash == hash && 
+            (!found || e->bank->getSerial() > found->bank->getSerial()) &&
+            (!name || e->bank->getSample(e->sample).name == name))
+        {
+            found = e;
+        }
+    }
+
+    if (bankOut)
+    {
+        *bankOut = (found ? found->bank : NULL);
+    }
+    return (found ? &found->bank->getSample(found->sample) : NULL);
+}
+
+SoundIndex::Table SoundIndex::s_banks;
+SoundIndex::Table SoundIndex::s_samples;
+
+////////////////////////////////////////
+
+SoundIndex::Table::Table() :
+    m_entries(NULL),
+    m_capacity(0),
+    m_count(0),
+    m_used(0)
+{
+}
+
+void SoundIndex::Table::insert(uint32 hash, Bank* bank, int sample)
+{
+    // keep at most 3/4 full, counting removed entries
+    if ((m_used + 1) * 4 > m_capacity * 3)
+    {
+        int capacity = 16;
+        while (capacity < (m_count + 1) * 2)
+        {
+            capacity *= 2;
+        }
+        resize(capacity);
+    }
+
+    int mask = m_capacity - 1;
+    int i = hash & mask;
+    while (m_entries[i].bank)
+    {
+        i = (i + 1) & mask;
+    }
+    m_entries[i].hash = hash;
+    m_entries[i].bank = bank;
+    m_entries[i].sample = sample;
+    ++m_count;
+    ++m_used;
+}
+
+void SoundIndex::Table::remove(Bank* bank)
+{
+    for (int i = 0; i < m_capacity; ++i)
+    {
+        Entry& e = m_entries[i];
+        if (e.bank == bank && e.sample != k_removed)
+        {
+            // leave the slot occupied so later entries in the probe sequence are still found
+            e.sample = k_removed;
+            --m_count;
+        }
+    }
+
+    if (m_count == 0)
+    {
+        resize(0);
+    }
+}
+
+const SoundIndex::Entry* SoundIndex::Table::getFirst(uint32 hash) const
+{
+    if (m_capacity == 0)
+    {
+        return NULL;
+    }
+    const Entry* e = m_entries + (hash & (m_capacity - 1));
+    return e->bank ? e : NULL;
+}
+
+const SoundIndex::Entry* SoundIndex::Table::getNext(const Entry* e) const
+{
+    int i = (int) (e - m_entries + 1) & (m_capacity - 1);
+    return m_entries[i].bank ? &m_entries[i] : NULL;
+}
+
+void SoundIndex::Table::resize(int capacity)
+{
+    Entry* oldEntries = m_entries;
+    int oldCapacity = m_capacity;
+
+    m_entries = NULL;
+    m_capacity = 0;
+    m_count = 0;
+    m_used = 0;
+
+    if (capacity > 0)
+    {
+        m_entries = (Entry*) Mem::alloc(capacity * sizeof(Entry));
+        m_capacity = capacity;
+        for (int i = 0; i < capacity; ++i)
+        {
+            m_entries[i].bank = NULL;
+        }
+
+        // removed entries are dropped
+        for (int i = 0; i < oldCapacity; ++i)
+        {
+            const Entry& e = oldEntries[i];
+            if (e.bank && e.sample != k_removed)
+            {
+                insert(e.hash, e.bank, e.sample);
+            }
+        }
+    }
+
+    Mem::free(oldEntries);
+}
+
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/core/types.h"
+
+namespace Cki
+{
+
+class Bank;
+struct Sample;
+
+
+// Hash tables of the names of all loaded banks and of the sounds in them,
+// so sounds can be found by name without searching every bank.
+// Main thread only.
+class SoundIndex
+{
+public:
+    static void add(Bank*);
+    static void remove(Bank*);
+
+    // If more than one bank matches, the most recently created one is found.
+    static Bank* findBank(const char* name);
+
+    // If name is NULL, matches on hash alone.
+    static const Sample* findSample(uint32 hash, const char* name, Bank** bank);
+
+private:
+    struct Entry
+    {
+        uint32 hash;
+        Bank* bank;   // NULL if empty
+        int sample;   // -1 for a bank entry; k_removed if removed
+    };
+
+    enum { k_removed = -2 };
+
+    class Table
+    {
+    public:
+        Table();
+
+        void insert(uint32 hash, Bank*, int sample);
+        void remove(Bank*);
+
+        int getCapacity() const { return m_capacity; }
+        const Entry* getFirst(uint32 hash) const;
+        const Entry* getNext(const Entry*) const;
+
+    private:
+        Entry* m_entries;
+        int m_capacity; // power of 2
+        int m_count;    // live entries
+        int m_used;     // live and removed entries
+
+        void resize(int capacity);
+    };
+
+    static Table s_banks;
+    static Table s_samples;
+};
+
+
+}
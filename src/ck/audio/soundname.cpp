@@ -94,6 +94,22 @@ int SoundName::compare(const char* str) const
     return 0;
 }
 
+uint32 SoundName::hash(const char* str)
+{
+    uint32 h = 2166136261u;
+    for (int i = 0; i < k_len-1 && str[i]; ++i)
+    {
+        h ^= (uint8) str[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+uint32 SoundName::getHash() const
+{
+    return hash(m_name);
+}
+
 bool SoundName::operator==(const SoundName& other) const
 {
     return compare(other) == 0;
@@ -43,6 +43,11 @@ public:
 
     const char* getBuffer() const;
 
+    // FNV-1a hash of a name, as truncated to k_len-1 characters; stored in bank
+    // files, so it must not change.
+    static uint32 hash(const char*);
+    uint32 getHash() const;
+
     // memory image
     void write(BinaryStream&) const;
     void fixup(MemoryFixup&) {}
@@ -4,6 +4,9 @@
 #include "ck/audio/decoder.h"
 #include "ck/audio/audiograph.h"
 #include "ck/audio/mixnode.h"
+#include "ck/audio/mixergain.h"
+#include "ck/audio/renderworkers.h"
+#include "ck/audio/rendertrace.h"
 #include "ck/core/debug.h"
 #include "ck/core/mem.h"
 #include "ck/core/math.h"
@@ -20,13 +23,16 @@ SourceNode::SourceNode() :
     m_next(NULL),
     m_output(NULL),
     m_connected(false),
+    m_virtual(false),
+    m_mixerGain(NULL),
     m_playId(0),
     m_doneId(0),
     m_outOffset(0),
     m_paused(false),
     m_nextFrame(-1),
     m_nextMs(-1.0f),
-    m_speed(1.0f)
+    m_speed(1.0f),
+    m_disconnectPending(false)
 {
     m_volMat.setIdentity();
     m_targetVolMat.setIdentity();
@@ -60,8 +66,23 @@ BufferHandle SourceNode::process(int outFramesReq, bool post, bool& needsPost)
         }
         outOffset = m_outOffset;
     }
+    else if (m_outOffset > 0)
+    {
+        // started partway through this quantum by the sound before it, after
+        // this mixer's inputs were processed (as when the previous sound was
+        // virtual); wait for the post-process
+        needsPost = true;
+        return BufferHandle();
+    }
     m_outOffset = -1;
 
+    if (m_disconnectPending)
+    {
+        // finished in an earlier render, but there was no room to defer the disconnect
+        m_disconnectPending = !AudioGraph::get()->executeDeferred(this, k_disconnect);
+        return BufferHandle();
+    }
+
     outFramesReq -= outOffset;
 
     if (!m_source->isInited())
@@ -96,6 +117,7 @@ BufferHandle SourceNode::process(int outFramesReq, bool post, bool& needsPost)
         return BufferHandle(); // inactive
     }
 
+    RenderTrace::Scope trace(RenderTrace::k_source, this);
 
     float factor = m_speed * sampleInfo.sampleRate / getSampleRate();
     int inFramesReq = Math::round(outFramesReq * factor);
@@ -108,6 +130,19 @@ BufferHandle SourceNode::process(int outFramesReq, bool post, bool& needsPost)
         factor = (float) inFramesReq / outFramesReq;
     }
 
+    if (m_virtual)
+    {
+        // keep the position up to date, without resampling or mixing
+        BufferHandle scratchHandle = acquireBuffer();
+        int inFrames = m_decoder->skip((float*) scratchHandle.get(), inFramesReq);
+        int outFrames = (inFrames < inFramesReq ? Math::round(inFrames / factor) : outFramesReq);
+        if (m_decoder->isDone())
+        {
+            finish(outOffset, outFrames, outFramesReq, needsPost);
+        }
+        return BufferHandle();
+    }
+
     BufferHandle inputHandle = acquireBuffer();
     T* inBuf = (T*) inputHandle.get();
 
@@ -127,7 +162,7 @@ BufferHandle SourceNode::process(int outFramesReq, bool post, bool& needsPost)
     // resample 
     BufferHandle resampledHandle;
     T* resampledBuf = NULL;
-    if (inFrames == outFrames)
+    if (inFrames == outFrames && !m_resampler.isDelayed())
     {
         resampledHandle = inputHandle;
         resampledBuf = (T*) resampledHandle.get();
@@ -142,19 +177,21 @@ BufferHandle SourceNode::process(int outFramesReq, bool post, bool& needsPost)
     inputHandle.release();
 
     // pan and convert to stereo
+    VolumeMatrix targetVolMat;
+    getTargetVolume(targetVolMat);
     BufferHandle outputHandle;
     T* outputBuf = NULL;
     if (sampleInfo.channels == 1)
     {
         outputHandle = acquireBuffer();
         outputBuf = (T*) outputHandle.get();
-        AudioUtil::monoPan(resampledBuf + outOffset, outputBuf + outOffset * 2, outFrames, m_targetVolMat, m_volMat, getVolumeRate());
+        AudioUtil::monoPan(resampledBuf + outOffset, outputBuf + outOffset * 2, outFrames, targetVolMat, m_volMat, getVolumeRate());
     }
     else
     {
         outputHandle = resampledHandle;
         outputBuf = (T*) outputHandle.get();
-        AudioUtil::stereoPan(outputBuf + outOffset * 2, outFrames, m_targetVolMat, m_volMat, getVolumeRate());
+        AudioUtil::stereoPan(outputBuf + outOffset * 2, outFrames, targetVolMat, m_volMat, getVolumeRate());
     }
 
     if (outOffset > 0)
@@ -171,36 +208,49 @@ BufferHandle SourceNode::process(int outFramesReq, bool post, bool& needsPost)
 
     if (m_decoder->isDone())
     {
-        if (m_next)
-        {
-            m_next->m_playId = -1;
-            m_next->connect();
-            m_next->m_volMat = m_next->m_targetVolMat; 
-            m_next->m_resampler.copyState(m_resampler);
-            if (outFrames < outFramesReq)
-            {
-                needsPost = true;
-                m_next->m_outOffset = outOffset + outFrames;
-            }
-        }
+        finish(outOffset, outFrames, outFramesReq, needsPost);
+    }
 
-        m_source->reset();
-        if (!(m_next == this && m_playId == -1))
-        {
-            // can't call disconnect() directly, because output is currently iterating through its inputs
-            AudioGraph::get()->execute(this, k_disconnect);
+    return outputHandle;
+}
 
-            m_doneId = m_playId;
-            m_playId = 0;
-            m_resampler.resetState();
+// Called when the decoder is done; starts the next sound, if any.
+void SourceNode::finish(int outOffset, int outFrames, int outFramesReq, bool& needsPost)
+{
+    if (m_next)
+    {
+        m_next->m_playId = -1;
+        m_next->connect();
+        m_next->getTargetVolume(m_next->m_volMat);
+        m_next->m_resampler.copyState(m_resampler);
+        if (outFrames < outFramesReq)
+        {
+            needsPost = true;
+            m_next->m_outOffset = outOffset + outFrames;
         }
     }
 
-    return outputHandle;
+    m_source->reset();
+    if (!(m_next == this && m_playId == -1))
+    {
+        // can't call disconnect() directly, because output is currently iterating
+        // through its inputs; if there is no room to defer it, try again next render
+        m_disconnectPending = !AudioGraph::get()->executeDeferred(this, k_disconnect);
+
+        m_doneId = m_playId;
+        m_playId = 0;
+        m_resampler.resetState();
+    }
 }
 
 void SourceNode::execute(int cmdId, CommandParam param0, CommandParam param1)
 {
+    if (m_disconnectPending)
+    {
+        // as the deferred disconnect would have been, before any other command
+        disconnect();
+    }
+
     switch (cmdId)
     {
         case k_setLoopCount:
@@ -228,14 +278,12 @@ void SourceNode::execute(int cmdId, CommandParam param0, CommandParam param1)
                 MixNode* output = (MixNode*) param0.addrValue;
                 if (output != m_output)
                 {
-                    if (m_connected)
-                    {
-                        m_output->removeInput(this);
-                    }
+                    bool connected = m_connected;
+                    disconnect();
                     m_output = output;
-                    if (m_connected)
+                    if (connected)
                     {
-                        m_output->addInput(this);
+                        connect();
                     }
                 }
             }
@@ -258,6 +306,10 @@ void SourceNode::execute(int cmdId, CommandParam param0, CommandParam param1)
             CK_ASSERT(m_speed >= 0.0f);
             break;
 
+        case k_setResampleQuality:
+            m_resampler.setQuality((CkResampleQuality) param0.intValue);
+            break;
+
         case k_setVolumeL:
             m_targetVolMat.ll = param0.floatValue;
             m_targetVolMat.lr = param1.floatValue;
@@ -278,8 +330,9 @@ void SourceNode::execute(int cmdId, CommandParam param0, CommandParam param1)
                         // stopping, so reset for next time
                         m_source->reset();
                         disconnect();
+                        m_doneId = m_playId; // for a stop scheduled ahead of time
                     }
-                    m_volMat = m_targetVolMat; // reset volume
+                    getTargetVolume(m_volMat); // reset volume
                     m_playId = playId;
                     m_resampler.resetState();
                 }
@@ -292,7 +345,7 @@ void SourceNode::execute(int cmdId, CommandParam param0, CommandParam param1)
                 if (m_paused != paused)
                 {
                     m_paused = paused;
-                    m_volMat = m_targetVolMat; // reset volume
+                    getTargetVolume(m_volMat); // reset volume
                 }
             }
             break;
@@ -307,6 +360,34 @@ void SourceNode::execute(int cmdId, CommandParam param0, CommandParam param1)
             m_nextFrame = -1;
             break;
 
+        case k_setVirtual:
+            {
+                bool virt = param0.boolValue();
+                if (m_virtual != virt)
+                {
+                    // move to the other mixer
+                    bool connected = m_connected;
+                    disconnect();
+                    m_virtual = virt;
+                    if (connected)
+                    {
+                        connect();
+                    }
+
+                    if (!virt)
+                    {
+                        // resume from silence, since the resampler's history is stale
+                        m_volMat.setZero();
+                        m_resampler.resetState();
+                    }
+                }
+            }
+            break;
+
+        case k_setMixerGain:
+            m_mixerGain = (MixerGain*) param0.addrValue;
+            break;
+
         default:
             CK_FAIL("unknown command");
     };
@@ -321,9 +402,10 @@ void SourceNode::print(int level)
 
 void SourceNode::disconnect()
 {
+    m_disconnectPending = false;
     if (m_connected)
     {
-        m_output->removeInput(this);
+        getMixer()->removeInput(this);
         m_connected = false;
     }
 }
@@ -332,10 +414,32 @@ void SourceNode::connect()
 {
     if (!m_connected)
     {
-        m_output->addInput(this);
+        RenderJob* job = RenderJob::getCurrent();
+        if (job)
+        {
+            job->deferConnect(this);
+        }
+        else
+        {
+            getMixer()->addInput(this);
+        }
         m_connected = true;
     }
 }
 
+MixNode* SourceNode::getMixer() const
+{
+    return m_virtual ? AudioGraph::get()->getVirtualMixer() : m_output;
+}
+
+void SourceNode::getTargetVolume(VolumeMatrix& mat) const
+{
+    mat = m_targetVolMat;
+    if (m_mixerGain)
+    {
+        mat *= m_mixerGain->getGain();
+    }
+}
+
 
 }
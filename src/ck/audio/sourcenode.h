@@ -9,9 +9,12 @@ namespace Cki
 
 class AudioSource;
 class MixNode;
+class MixerGain;
 class Decoder;
 
-class SourceNode : public AudioNode
+class SourceNode : 
+    public AudioNode,
+    public List<SourceNode, 1>::Node // connections deferred by a RenderJob
 {
 public:
     SourceNode();
@@ -37,6 +40,7 @@ public:
         k_setNext,
 
         k_setSpeed,
+        k_setResampleQuality,
 
         // volume matrix
         k_setVolumeL, // LL, LR components
@@ -47,6 +51,10 @@ public:
 
         k_setPlayPosition,
         k_setPlayPositionMs,
+
+        k_setVirtual,
+
+        k_setMixerGain,
     };
 
     virtual void execute(int cmdId, CommandParam param0, CommandParam param1);
@@ -64,8 +72,10 @@ private:
     SourceNode* m_next;
     MixNode* m_output;
     bool m_connected;
+    bool m_virtual; // if true, connected to the graph's virtual mixer, and only advances its position
     VolumeMatrix m_volMat;
-    VolumeMatrix m_targetVolMat;
+    VolumeMatrix m_targetVolMat; // without the mixer gain
+    MixerGain* m_mixerGain;
     int m_playId; // 0 if not playing, else id from GraphSound class, or -1
     int m_doneId;
     int m_outOffset;
@@ -73,11 +83,17 @@ private:
     int m_nextFrame;
     float m_nextMs;
     float m_speed;
+    bool m_disconnectPending; // finished, but the deferred disconnect did not fit; retried each render
     Resampler m_resampler;
 
     template <typename T> BufferHandle process(int frames, bool post, bool& needsPost);
+    void finish(int outOffset, int outFrames, int outFramesReq, bool& needsPost);
+    MixNode* getMixer() const;
+    void getTargetVolume(VolumeMatrix&) const;
     void connect();
     void disconnect();
+
+    friend class RenderJob;
 };
 
 
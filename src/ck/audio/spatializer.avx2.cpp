@@ -0,0 +1,126 @@
+#include "ck/audio/spatializer.h"
+#include "ck/core/debug.h"
+
+#if CK_X86_SSE
+
+// Only used if System::getSimdLevel() is kCkSimdLevel_Avx2; if the compiler
+// can't generate AVX2 code for this file, it calls the SSE version.
+
+#if CK_X86_AVX2
+
+#include <immintrin.h>
+
+namespace Cki
+{
+
+
+void Spatializer::compute_avx2(const Params& params, const Emitters& e, int begin, int end)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 lx = _mm256_set1_ps(params.lx);
+    const __m256 ly = _mm256_set1_ps(params.ly);
+    const __m256 lz = _mm256_set1_ps(params.lz);
+    const __m256 ux = _mm256_set1_ps(params.ux);
+    const __m256 uy = _mm256_set1_ps(params.uy);
+    const __m256 uz = _mm256_set1_ps(params.uz);
+    const __m256 uu = _mm256_set1_ps(params.uu);
+    const __m256 rx = _mm256_set1_ps(params.rx);
+    const __m256 ry = _mm256_set1_ps(params.ry);
+    const __m256 rz = _mm256_set1_ps(params.rz);
+    const __m256 nearDist = _mm256_set1_ps(params.nearDist);
+    const __m256 farDist = _mm256_set1_ps(params.farDist);
+    const __m256 farVol = _mm256_set1_ps(params.farVol);
+    const __m256 nearMinDist = _mm256_set1_ps(params.nearMinDist);
+    const __m256 panRampScale = _mm256_set1_ps(params.panRampScale);
+    const __m256 atten0 = _mm256_set1_ps(params.atten[0]);
+    const __m256 atten1 = _mm256_set1_ps(params.atten[1]);
+    const __m256 atten2 = _mm256_set1_ps(params.atten[2]);
+    const __m256 atten3 = _mm256_set1_ps(params.atten[3]);
+    const __m256 minPlaneMagSq = _mm256_set1_ps(0.0001f * 0.0001f);
+    const bool doppler = (params.soundSpeed > 0.0f);
+    const __m256 lvx = _mm256_set1_ps(params.lvx);
+    const __m256 lvy = _mm256_set1_ps(params.lvy);
+    const __m256 lvz = _mm256_set1_ps(params.lvz);
+    const __m256 soundSpeed = _mm256_set1_ps(params.soundSpeed);
+    const __m256 minVel = _mm256_set1_ps(params.minVel);
+
+    int end8 = begin + ((end - begin) & ~7);
+    for (int i = begin; i < end8; i += 8)
+    {
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(e.px + i), lx);
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(e.py + i), ly);
+        __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(e.pz + i), lz);
+        __m256 distSq = _mm256_fmadd_ps(dz, dz, _mm256_fmadd_ps(dy, dy, _mm256_mul_ps(dx, dx)));
+        __m256 dist = _mm256_sqrt_ps(distSq);
+        __m256 invDist = _mm256_and_ps(_mm256_cmp_ps(dist, zero, _CMP_GT_OQ), _mm256_div_ps(one, dist));
+
+        // distance attenuation
+        __m256 vol = _mm256_fmadd_ps(atten3, invDist, atten2);
+        vol = _mm256_fmadd_ps(vol, invDist, _mm256_fmadd_ps(atten1, dist, atten0));
+        vol = _mm256_min_ps(_mm256_max_ps(vol, farVol), one);
+        vol = _mm256_blendv_ps(vol, farVol, _mm256_cmp_ps(dist, farDist, _CMP_GE_OQ));
+        vol = _mm256_blendv_ps(vol, one, _mm256_cmp_ps(dist, nearDist, _CMP_LE_OQ));
+
+        // panning
+        __m256 ud = _mm256_fmadd_ps(uz, dz, _mm256_fmadd_ps(uy, dy, _mm256_mul_ps(ux, dx)));
+        __m256 planeX = _mm256_fnmadd_ps(ux, ud, _mm256_mul_ps(dx, uu));
+        __m256 planeY = _mm256_fnmadd_ps(uy, ud, _mm256_mul_ps(dy, uu));
+        __m256 planeZ = _mm256_fnmadd_ps(uz, ud, _mm256_mul_ps(dz, uu));
+        __m256 planeMagSq = _mm256_fmadd_ps(planeZ, planeZ, _mm256_fmadd_ps(planeY, planeY, _mm256_mul_ps(planeX, planeX)));
+        __m256 planeDotR = _mm256_fmadd_ps(planeZ, rz, _mm256_fmadd_ps(planeY, ry, _mm256_mul_ps(planeX, rx)));
+        __m256 pan = _mm256_and_ps(_mm256_cmp_ps(planeMagSq, minPlaneMagSq, _CMP_GE_OQ), _mm256_div_ps(planeDotR, _mm256_sqrt_ps(planeMagSq)));
+        __m256 ramp = _mm256_blendv_ps(one, _mm256_mul_ps(_mm256_sub_ps(dist, nearMinDist), panRampScale), _mm256_cmp_ps(dist, nearDist, _CMP_LT_OQ));
+        pan = _mm256_and_ps(_mm256_cmp_ps(dist, nearMinDist, _CMP_GE_OQ), _mm256_mul_ps(pan, ramp));
+
+        // doppler
+        __m256 speed = one;
+        if (doppler)
+        {
+            __m256 vs = _mm256_fmadd_ps(_mm256_loadu_ps(e.vz + i), dz, _mm256_fmadd_ps(_mm256_loadu_ps(e.vy + i), dy, _mm256_mul_ps(_mm256_loadu_ps(e.vx + i), dx)));
+            __m256 vr = _mm256_fmadd_ps(lvz, dz, _mm256_fmadd_ps(lvy, dy, _mm256_mul_ps(lvx, dx)));
+            vs = _mm256_max_ps(_mm256_mul_ps(vs, invDist), minVel);
+            vr = _mm256_max_ps(_mm256_sub_ps(zero, _mm256_mul_ps(vr, invDist)), minVel);
+            speed = _mm256_div_ps(_mm256_add_ps(soundSpeed, vr), _mm256_add_ps(soundSpeed, vs));
+        }
+
+        _mm256_storeu_ps(e.vol + i, vol);
+        _mm256_storeu_ps(e.pan + i, pan);
+        _mm256_storeu_ps(e.speed + i, speed);
+    }
+    _mm256_zeroupper();
+
+    compute_sse(params, e, end8, end);
+}
+
+
+}
+
+#else // CK_X86_AVX2
+
+namespace Cki
+{
+
+
+void Spatializer::compute_avx2(const Params& params, const Emitters& e, int begin, int end)
+{
+    compute_sse(params, e, begin, end);
+}
+
+
+}
+
+#endif // CK_X86_AVX2
+
+#else // CK_X86_SSE
+
+namespace Cki
+{
+
+
+void Spatializer::compute_avx2(const Params& params, const Emitters& e, int begin, int end) {}
+
+
+}
+
+#endif // CK_X86_SSE
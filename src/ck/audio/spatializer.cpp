@@ -0,0 +1,314 @@
+#include "ck/audio/spatializer.h"
+#include "ck/core/debug.h"
+#include "ck/core/math.h"
+#include "ck/core/mem.h"
+#include "ck/core/system.h"
+
+namespace Cki
+{
+
+
+void Spatializer::init()
+{
+    CkSimdLevel level = System::get()->getSimdLevel();
+
+    s_compute = compute_default;
+#if CK_ARCH_ARM
+#  if !(CK_PLATFORM_ANDROID && __ARM_ARCH_5TE__)
+    if (level >= kCkSimdLevel_Basic)
+    {
+        s_compute = compute_neon;
+    }
+#  endif
+#elif CK_ARCH_X86
+    if (level >= kCkSimdLevel_Basic)
+    {
+        s_compute = compute_sse;
+    }
+    if (level >= kCkSimdLevel_Avx2)
+    {
+        s_compute = compute_avx2;
+    }
+#endif
+}
+
+void Spatializer::shutdown()
+{
+    CK_ASSERT(s_count == 0);
+    Mem::free(s_emitters.px);
+    Mem::free(s_slots);
+    Mem::clear(&s_emitters, sizeof(s_emitters));
+    s_slots = NULL;
+    s_count = 0;
+    s_capacity = 0;
+}
+
+void Spatializer::Params::set(const Vector3& listenerPos, const Vector3& listenerVel,
+                              const Vector3& listenerLookAt, const Vector3& listenerUp,
+                              CkAttenuationMode mode, float nearDist_, float farDist_, float farVol_,
+                              float soundSpeed_)
+{
+    lx = listenerPos.x;
+    ly = listenerPos.y;
+    lz = listenerPos.z;
+    lvx = listenerVel.x;
+    lvy = listenerVel.y;
+    lvz = listenerVel.z;
+    ux = listenerUp.x;
+    uy = listenerUp.y;
+    uz = listenerUp.z;
+    uu = listenerUp.dot(listenerUp);
+
+    Vector3 listenerForward = listenerLookAt - listenerPos;
+    Vector3 listenerRight = listenerForward.cross(listenerUp);
+    listenerRight.normalize();
+    rx = listenerRight.x;
+    ry = listenerRight.y;
+    rz = listenerRight.z;
+
+    nearDist = nearDist_;
+    farDist = farDist_;
+    farVol = farVol_;
+    nearMinDist = 0.1f * nearDist; // TODO configurable
+    panRampScale = 1.0f / (nearDist - nearMinDist);
+
+    // Volume between the near and far distances, as one expression for all
+    // modes, so it can be computed without branches.
+    atten[0] = 1.0f;
+    atten[1] = 0.0f;
+    atten[2] = 0.0f;
+    atten[3] = 0.0f;
+    switch (mode)
+    {
+        case kCkAttenuationMode_None:
+            break;
+
+        case kCkAttenuationMode_Linear:
+            {
+                float slope = (farVol - 1.0f) / (farDist - nearDist);
+                atten[0] = 1.0f - slope * nearDist;
+                atten[1] = slope;
+            }
+            break;
+
+        case kCkAttenuationMode_InvDistance:
+            {
+                // v = a/r + b
+                // a = (vf - 1)/(1/rf - 1/rn)
+                // where vf = far volume
+                //       rf = far distance
+                //       rn = near distance
+                float rnInv = 1.0f / nearDist;
+                float rfInv = 1.0f / farDist;
+                float a = (farVol - 1.0f)/(rfInv - rnInv);
+                atten[0] = 1.0f - a*rnInv;
+                atten[2] = a;
+            }
+            break;
+
+        case kCkAttenuationMode_InvDistanceSquared:
+            {
+                // v = a/r^2 + b
+                // a = (vf - 1)/(1/rf^2 - 1/rn^2)
+                // where vf = far volume
+                //       rf = far distance
+                //       rn = near distance
+                float rnInvSq = 1.0f / (nearDist * nearDist);
+                float rfInvSq = 1.0f / (farDist * farDist);
+                float a = (farVol - 1.0f)/(rfInvSq - rnInvSq);
+                atten[0] = 1.0f - a*rnInvSq;
+                atten[3] = a;
+            }
+            break;
+    }
+
+    soundSpeed = soundSpeed_;
+    minVel = -soundSpeed * 0.99f;
+}
+
+bool Spatializer::add(int* slot)
+{
+    if (s_count == s_capacity && !grow())
+    {
+        *slot = -1;
+        return false;
+    }
+
+    int i = s_count++;
+    s_emitters.px[i] = s_emitters.py[i] = s_emitters.pz[i] = 0.0f;
+    s_emitters.vx[i] = s_emitters.vy[i] = s_emitters.vz[i] = 0.0f;
+    s_emitters.vol[i] = 1.0f;
+    s_emitters.pan[i] = 0.0f;
+    s_emitters.speed[i] = 1.0f;
+    s_slots[i] = slot;
+    *slot = i;
+    return true;
+}
+
+void Spatializer::remove(int slot)
+{
+    CK_ASSERT(slot >= 0 && slot < s_count);
+
+    // move the last emitter into the slot, so the arrays stay contiguous
+    int last = --s_count;
+    *s_slots[slot] = -1;
+    if (slot != last)
+    {
+        float** arrays = (float**) &s_emitters;
+        for (int i = 0; i < k_numArrays; ++i)
+        {
+            arrays[i][slot] = arrays[i][last];
+        }
+        s_slots[slot] = s_slots[last];
+        *s_slots[slot] = slot;
+    }
+}
+
+void Spatializer::setPosition(int slot, const Vector3& pos)
+{
+    CK_ASSERT(slot >= 0 && slot < s_count);
+    s_emitters.px[slot] = pos.x;
+    s_emitters.py[slot] = pos.y;
+    s_emitters.pz[slot] = pos.z;
+}
+
+void Spatializer::setVelocity(int slot, const Vector3& vel)
+{
+    CK_ASSERT(slot >= 0 && slot < s_count);
+    s_emitters.vx[slot] = vel.x;
+    s_emitters.vy[slot] = vel.y;
+    s_emitters.vz[slot] = vel.z;
+}
+
+void Spatializer::computeAll(const Params& params)
+{
+    s_compute(params, s_emitters, 0, s_count);
+}
+
+void Spatializer::compute(int slot, const Params& params)
+{
+    CK_ASSERT(slot >= 0 && slot < s_count);
+    compute_default(params, s_emitters, slot, slot + 1);
+}
+
+void Spatializer::compute_default(const Params& params, const Emitters& e, int begin, int end)
+{
+    for (int i = begin; i < end; ++i)
+    {
+        // vector from listener to emitter
+        float dx = e.px[i] - params.lx;
+        float dy = e.py[i] - params.ly;
+        float dz = e.pz[i] - params.lz;
+        float dist = Math::sqrt(dx*dx + dy*dy + dz*dz);
+        float invDist = (dist > 0.0f ? 1.0f / dist : 0.0f);
+
+        // distance attenuation
+        //  when dist > far, volume = farVol
+        //  when dist < near, volume = 1.0f
+        // TODO: sound-specific attenuation
+        float vol;
+        if (dist <= params.nearDist)
+        {
+            vol = 1.0f;
+        }
+        else if (dist >= params.farDist)
+        {
+            vol = params.farVol;
+        }
+        else
+        {
+            vol = params.atten[0] + params.atten[1]*dist + (params.atten[2] + params.atten[3]*invDist)*invDist;
+            vol = Math::clamp(vol, params.farVol, 1.0f);
+        }
+
+        // panning
+        //   when dist > near, pan based on projection of d on ear plane
+        //   when dist < nearMin, pan = 0
+        //   when dist is between near and nearMin, linearly interpolate
+        float pan = 0.0f;
+        if (dist >= params.nearMinDist)
+        {
+            // project onto listener's ear plane:
+            //   up x (d x up) = d (up.up) - up (up.d)
+            float ud = params.ux*dx + params.uy*dy + params.uz*dz;
+            float planeX = dx*params.uu - params.ux*ud;
+            float planeY = dy*params.uu - params.uy*ud;
+            float planeZ = dz*params.uu - params.uz*ud;
+            float planeMagSq = planeX*planeX + planeY*planeY + planeZ*planeZ;
+
+            // 0 if object is nearly right above listener
+            if (planeMagSq >= 0.0001f * 0.0001f)
+            {
+                pan = (planeX*params.rx + planeY*params.ry + planeZ*params.rz) / Math::sqrt(planeMagSq);
+            }
+            if (dist < params.nearDist)
+            {
+                pan *= (dist - params.nearMinDist) * params.panRampScale;
+            }
+        }
+
+        // doppler
+        float speed = 1.0f;
+        if (params.soundSpeed > 0.0f)
+        {
+            float vs = (e.vx[i]*dx + e.vy[i]*dy + e.vz[i]*dz) * invDist; // component of source velocity towards listener
+            float vr = -(params.lvx*dx + params.lvy*dy + params.lvz*dz) * invDist; // component of listener velocity towards source
+            vs = Math::max(vs, params.minVel);
+            vr = Math::max(vr, params.minVel);
+            speed = (params.soundSpeed + vr) / (params.soundSpeed + vs);
+        }
+
+        e.vol[i] = vol;
+        e.pan[i] = pan;
+        e.speed[i] = speed;
+    }
+}
+
+////////////////////////////////////////
+
+bool Spatializer::grow()
+{
+    int capacity = Math::max(64, s_capacity * 2);
+
+    // one block for all the arrays; each starts on a 32-byte boundary
+    int arrayBytes = (capacity * sizeof(float) + 31) & ~31;
+    float* buf = (float*) Mem::alloc(arrayBytes * k_numArrays, 32);
+    int** slots = (int**) Mem::alloc(capacity * sizeof(int*));
+    if (!buf || !slots)
+    {
+        Mem::free(buf);
+        Mem::free(slots);
+        return false;
+    }
+
+    float** oldArrays = (float**) &s_emitters;
+    float* newArrays[k_numArrays];
+    for (int i = 0; i < k_numArrays; ++i)
+    {
+        newArrays[i] = (float*) ((byte*) buf + i * arrayBytes);
+        if (s_count > 0)
+        {
+            Mem::copy(newArrays[i], oldArrays[i], s_count * sizeof(float));
+        }
+    }
+    if (s_count > 0)
+    {
+        Mem::copy(slots, s_slots, s_count * sizeof(int*));
+    }
+
+    Mem::free(s_emitters.px);
+    Mem::free(s_slots);
+    Mem::copy(oldArrays, newArrays, sizeof(newArrays));
+    s_slots = slots;
+    s_capacity = capacity;
+    return true;
+}
+
+Spatializer::Emitters Spatializer::s_emitters = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+int** Spatializer::s_slots = NULL;
+int Spatializer::s_count = 0;
+int Spatializer::s_capacity = 0;
+Spatializer::ComputeFunc Spatializer::s_compute = Spatializer::compute_default;
+
+
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/core/types.h"
+#include "ck/core/vector3.h"
+#include "ck/attenuationmode.h"
+
+namespace Cki
+{
+
+
+// Positions and velocities of the sounds with 3D enabled, stored as arrays
+// rather than in each sound, so the volume, pan, and doppler shift of all of
+// them can be computed in one pass with SIMD.
+// Main thread only.
+class Spatializer
+{
+public:
+    static void init();
+    static void shutdown();
+
+    // Listener and attenuation settings used for all emitters.
+    struct Params
+    {
+        void set(const Vector3& listenerPos, const Vector3& listenerVel,
+                 const Vector3& listenerLookAt, const Vector3& listenerUp,
+                 CkAttenuationMode, float nearDist, float farDist, float farVol,
+                 float soundSpeed);
+
+        float lx, ly, lz;    // listener position
+        float lvx, lvy, lvz; // listener velocity
+        float ux, uy, uz;    // listener up
+        float uu;            // up . up
+        float rx, ry, rz;    // listener right, normalized
+        float nearDist;
+        float farDist;
+        float farVol;
+        float nearMinDist;   // pan is 0 closer than this
+        float panRampScale;  // 1/(nearDist - nearMinDist)
+        float atten[4];      // volume = atten[0] + atten[1]*dist + atten[2]/dist + atten[3]/dist^2
+        float soundSpeed;    // no doppler if 0
+        float minVel;
+    };
+
+    // Adds an emitter; its slot is written to *slot, and updated if the
+    // emitter is moved to another slot.  Returns false if out of memory.
+    static bool add(int* slot);
+    static void remove(int slot);
+
+    static int getCount() { return s_count; }
+
+    static void setPosition(int slot, const Vector3&);
+    static void setVelocity(int slot, const Vector3&);
+
+    // Compute the volume, pan, and speed of all emitters, or just one.
+    static void computeAll(const Params&);
+    static void compute(int slot, const Params&);
+
+    static float getVolume(int slot) { return s_emitters.vol[slot]; }
+    static float getPan(int slot) { return s_emitters.pan[slot]; }
+    static float getSpeed(int slot) { return s_emitters.speed[slot]; }
+
+    struct Emitters
+    {
+        float* px;
+        float* py;
+        float* pz;
+        float* vx;
+        float* vy;
+        float* vz;
+        float* vol;
+        float* pan;
+        float* speed;
+    };
+
+    typedef void (*ComputeFunc)(const Params&, const Emitters&, int begin, int end);
+
+    static void compute_default(const Params&, const Emitters&, int begin, int end);
+    static void compute_sse(const Params&, const Emitters&, int begin, int end);
+    static void compute_avx2(const Params&, const Emitters&, int begin, int end);
+    static void compute_neon(const Params&, const Emitters&, int begin, int end);
+
+private:
+    enum { k_numArrays = 9 };
+
+    static Emitters s_emitters;
+    static int** s_slots; // slot pointer of each emitter's owner
+    static int s_count;
+    static int s_capacity;
+    static ComputeFunc s_compute;
+
+    static bool grow();
+};
+
+
+}
@@ -0,0 +1,123 @@
+#include "ck/audio/spatializer.h"
+#include "ck/core/debug.h"
+
+#if CK_ARM_NEON
+#  include <arm_neon.h>
+#endif
+
+namespace Cki
+{
+
+
+#if CK_ARM_NEON
+namespace
+{
+    // 1/sqrt(x), from the estimate with two Newton-Raphson steps
+    inline float32x4_t invSqrt(float32x4_t x)
+    {
+        float32x4_t r = vrsqrteq_f32(x);
+        r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(x, r), r));
+        r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(x, r), r));
+        return r;
+    }
+
+    // 1/x, from the estimate with two Newton-Raphson steps
+    inline float32x4_t recip(float32x4_t x)
+    {
+        float32x4_t r = vrecpeq_f32(x);
+        r = vmulq_f32(r, vrecpsq_f32(x, r));
+        r = vmulq_f32(r, vrecpsq_f32(x, r));
+        return r;
+    }
+
+    // (mask ? x : 0)
+    inline float32x4_t maskf(uint32x4_t mask, float32x4_t x)
+    {
+        return vreinterpretq_f32_u32(vandq_u32(mask, vreinterpretq_u32_f32(x)));
+    }
+}
+
+void Spatializer::compute_neon(const Params& params, const Emitters& e, int begin, int end)
+{
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t lx = vdupq_n_f32(params.lx);
+    const float32x4_t ly = vdupq_n_f32(params.ly);
+    const float32x4_t lz = vdupq_n_f32(params.lz);
+    const float32x4_t ux = vdupq_n_f32(params.ux);
+    const float32x4_t uy = vdupq_n_f32(params.uy);
+    const float32x4_t uz = vdupq_n_f32(params.uz);
+    const float32x4_t uu = vdupq_n_f32(params.uu);
+    const float32x4_t rx = vdupq_n_f32(params.rx);
+    const float32x4_t ry = vdupq_n_f32(params.ry);
+    const float32x4_t rz = vdupq_n_f32(params.rz);
+    const float32x4_t nearDist = vdupq_n_f32(params.nearDist);
+    const float32x4_t farDist = vdupq_n_f32(params.farDist);
+    const float32x4_t farVol = vdupq_n_f32(params.farVol);
+    const float32x4_t nearMinDist = vdupq_n_f32(params.nearMinDist);
+    const float32x4_t panRampScale = vdupq_n_f32(params.panRampScale);
+    const float32x4_t atten0 = vdupq_n_f32(params.atten[0]);
+    const float32x4_t atten1 = vdupq_n_f32(params.atten[1]);
+    const float32x4_t atten2 = vdupq_n_f32(params.atten[2]);
+    const float32x4_t atten3 = vdupq_n_f32(params.atten[3]);
+    const float32x4_t minPlaneMagSq = vdupq_n_f32(0.0001f * 0.0001f);
+    const bool doppler = (params.soundSpeed > 0.0f);
+    const float32x4_t lvx = vdupq_n_f32(params.lvx);
+    const float32x4_t lvy = vdupq_n_f32(params.lvy);
+    const float32x4_t lvz = vdupq_n_f32(params.lvz);
+    const float32x4_t soundSpeed = vdupq_n_f32(params.soundSpeed);
+    const float32x4_t minVel = vdupq_n_f32(params.minVel);
+
+    int end4 = begin + ((end - begin) & ~3);
+    for (int i = begin; i < end4; i += 4)
+    {
+        float32x4_t dx = vsubq_f32(vld1q_f32(e.px + i), lx);
+        float32x4_t dy = vsubq_f32(vld1q_f32(e.py + i), ly);
+        float32x4_t dz = vsubq_f32(vld1q_f32(e.pz + i), lz);
+        float32x4_t distSq = vmlaq_f32(vmlaq_f32(vmulq_f32(dx, dx), dy, dy), dz, dz);
+        uint32x4_t nonZero = vcgtq_f32(distSq, zero);
+        float32x4_t invDist = maskf(nonZero, invSqrt(distSq));
+        float32x4_t dist = vmulq_f32(distSq, invDist);
+
+        // distance attenuation
+        float32x4_t vol = vmlaq_f32(atten2, atten3, invDist);
+        vol = vmlaq_f32(vmlaq_f32(atten0, atten1, dist), vol, invDist);
+        vol = vminq_f32(vmaxq_f32(vol, farVol), one);
+        vol = vbslq_f32(vcgeq_f32(dist, farDist), farVol, vol);
+        vol = vbslq_f32(vcleq_f32(dist, nearDist), one, vol);
+
+        // panning
+        float32x4_t ud = vmlaq_f32(vmlaq_f32(vmulq_f32(ux, dx), uy, dy), uz, dz);
+        float32x4_t planeX = vmlsq_f32(vmulq_f32(dx, uu), ux, ud);
+        float32x4_t planeY = vmlsq_f32(vmulq_f32(dy, uu), uy, ud);
+        float32x4_t planeZ = vmlsq_f32(vmulq_f32(dz, uu), uz, ud);
+        float32x4_t planeMagSq = vmlaq_f32(vmlaq_f32(vmulq_f32(planeX, planeX), planeY, planeY), planeZ, planeZ);
+        float32x4_t planeDotR = vmlaq_f32(vmlaq_f32(vmulq_f32(planeX, rx), planeY, ry), planeZ, rz);
+        float32x4_t pan = maskf(vcgeq_f32(planeMagSq, minPlaneMagSq), vmulq_f32(planeDotR, invSqrt(planeMagSq)));
+        float32x4_t ramp = vbslq_f32(vcltq_f32(dist, nearDist), vmulq_f32(vsubq_f32(dist, nearMinDist), panRampScale), one);
+        pan = maskf(vcgeq_f32(dist, nearMinDist), vmulq_f32(pan, ramp));
+
+        // doppler
+        float32x4_t speed = one;
+        if (doppler)
+        {
+            float32x4_t vs = vmlaq_f32(vmlaq_f32(vmulq_f32(vld1q_f32(e.vx + i), dx), vld1q_f32(e.vy + i), dy), vld1q_f32(e.vz + i), dz);
+            float32x4_t vr = vmlaq_f32(vmlaq_f32(vmulq_f32(lvx, dx), lvy, dy), lvz, dz);
+            vs = vmaxq_f32(vmulq_f32(vs, invDist), minVel);
+            vr = vmaxq_f32(vnegq_f32(vmulq_f32(vr, invDist)), minVel);
+            speed = vmulq_f32(vaddq_f32(soundSpeed, vr), recip(vaddq_f32(soundSpeed, vs)));
+        }
+
+        vst1q_f32(e.vol + i, vol);
+        vst1q_f32(e.pan + i, pan);
+        vst1q_f32(e.speed + i, speed);
+    }
+
+    compute_default(params, e, end4, end);
+}
+#else
+void Spatializer::compute_neon(const Params& params, const Emitters& e, int begin, int end) {}
+#endif
+
+
+}
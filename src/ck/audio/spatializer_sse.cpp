@@ -0,0 +1,103 @@
+#include "ck/audio/spatializer.h"
+#include "ck/core/debug.h"
+
+#if CK_X86_SSE
+#  include <xmmintrin.h>
+#endif
+
+namespace Cki
+{
+
+
+#if CK_X86_SSE
+namespace
+{
+    // mask ? a : b
+    inline __m128 select(__m128 mask, __m128 a, __m128 b)
+    {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+}
+
+void Spatializer::compute_sse(const Params& params, const Emitters& e, int begin, int end)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 lx = _mm_set1_ps(params.lx);
+    const __m128 ly = _mm_set1_ps(params.ly);
+    const __m128 lz = _mm_set1_ps(params.lz);
+    const __m128 ux = _mm_set1_ps(params.ux);
+    const __m128 uy = _mm_set1_ps(params.uy);
+    const __m128 uz = _mm_set1_ps(params.uz);
+    const __m128 uu = _mm_set1_ps(params.uu);
+    const __m128 rx = _mm_set1_ps(params.rx);
+    const __m128 ry = _mm_set1_ps(params.ry);
+    const __m128 rz = _mm_set1_ps(params.rz);
+    const __m128 nearDist = _mm_set1_ps(params.nearDist);
+    const __m128 farDist = _mm_set1_ps(params.farDist);
+    const __m128 farVol = _mm_set1_ps(params.farVol);
+    const __m128 nearMinDist = _mm_set1_ps(params.nearMinDist);
+    const __m128 panRampScale = _mm_set1_ps(params.panRampScale);
+    const __m128 atten0 = _mm_set1_ps(params.atten[0]);
+    const __m128 atten1 = _mm_set1_ps(params.atten[1]);
+    const __m128 atten2 = _mm_set1_ps(params.atten[2]);
+    const __m128 atten3 = _mm_set1_ps(params.atten[3]);
+    const __m128 minPlaneMagSq = _mm_set1_ps(0.0001f * 0.0001f);
+    const bool doppler = (params.soundSpeed > 0.0f);
+    const __m128 lvx = _mm_set1_ps(params.lvx);
+    const __m128 lvy = _mm_set1_ps(params.lvy);
+    const __m128 lvz = _mm_set1_ps(params.lvz);
+    const __m128 soundSpeed = _mm_set1_ps(params.soundSpeed);
+    const __m128 minVel = _mm_set1_ps(params.minVel);
+
+    int end4 = begin + ((end - begin) & ~3);
+    for (int i = begin; i < end4; i += 4)
+    {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(e.px + i), lx);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(e.py + i), ly);
+        __m128 dz = _mm_sub_ps(_mm_loadu_ps(e.pz + i), lz);
+        __m128 dist = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+        __m128 invDist = _mm_and_ps(_mm_cmpgt_ps(dist, zero), _mm_div_ps(one, dist));
+
+        // distance attenuation
+        __m128 vol = _mm_add_ps(atten2, _mm_mul_ps(atten3, invDist));
+        vol = _mm_add_ps(_mm_add_ps(atten0, _mm_mul_ps(atten1, dist)), _mm_mul_ps(vol, invDist));
+        vol = _mm_min_ps(_mm_max_ps(vol, farVol), one);
+        vol = select(_mm_cmpge_ps(dist, farDist), farVol, vol);
+        vol = select(_mm_cmple_ps(dist, nearDist), one, vol);
+
+        // panning
+        __m128 ud = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ux, dx), _mm_mul_ps(uy, dy)), _mm_mul_ps(uz, dz));
+        __m128 planeX = _mm_sub_ps(_mm_mul_ps(dx, uu), _mm_mul_ps(ux, ud));
+        __m128 planeY = _mm_sub_ps(_mm_mul_ps(dy, uu), _mm_mul_ps(uy, ud));
+        __m128 planeZ = _mm_sub_ps(_mm_mul_ps(dz, uu), _mm_mul_ps(uz, ud));
+        __m128 planeMagSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX, planeX), _mm_mul_ps(planeY, planeY)), _mm_mul_ps(planeZ, planeZ));
+        __m128 planeDotR = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX, rx), _mm_mul_ps(planeY, ry)), _mm_mul_ps(planeZ, rz));
+        __m128 pan = _mm_and_ps(_mm_cmpge_ps(planeMagSq, minPlaneMagSq), _mm_div_ps(planeDotR, _mm_sqrt_ps(planeMagSq)));
+        __m128 ramp = select(_mm_cmplt_ps(dist, nearDist), _mm_mul_ps(_mm_sub_ps(dist, nearMinDist), panRampScale), one);
+        pan = _mm_and_ps(_mm_cmpge_ps(dist, nearMinDist), _mm_mul_ps(pan, ramp));
+
+        // doppler
+        __m128 speed = one;
+        if (doppler)
+        {
+            __m128 vs = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(e.vx + i), dx), _mm_mul_ps(_mm_loadu_ps(e.vy + i), dy)), _mm_mul_ps(_mm_loadu_ps(e.vz + i), dz));
+            __m128 vr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(lvx, dx), _mm_mul_ps(lvy, dy)), _mm_mul_ps(lvz, dz));
+            vs = _mm_max_ps(_mm_mul_ps(vs, invDist), minVel);
+            vr = _mm_max_ps(_mm_sub_ps(zero, _mm_mul_ps(vr, invDist)), minVel);
+            speed = _mm_div_ps(_mm_add_ps(soundSpeed, vr), _mm_add_ps(soundSpeed, vs));
+        }
+
+        _mm_storeu_ps(e.vol + i, vol);
+        _mm_storeu_ps(e.pan + i, pan);
+        _mm_storeu_ps(e.speed + i, speed);
+    }
+
+    compute_default(params, e, end4, end);
+}
+#else
+void Spatializer::compute_sse(const Params& params, const Emitters& e, int begin, int end) {}
+#endif
+
+
+}
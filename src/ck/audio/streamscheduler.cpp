@@ -0,0 +1,250 @@
+#include "ck/audio/streamscheduler.h"
+#include "ck/audio/streamsource.h"
+#include "ck/core/thread.h"
+#include "ck/core/atomic.h"
+#include "ck/core/math.h"
+#include "ck/core/mem.h"
+#include "ck/core/system.h"
+#include "ck/core/logger.h"
+#include "ck/core/debug.h"
+
+#if CK_PLATFORM_IOS || CK_PLATFORM_OSX || CK_PLATFORM_TVOS
+#  include "ck/audio/audiohelpers_ios.h"
+#endif
+
+namespace Cki
+{
+
+
+void StreamScheduler::init()
+{
+    CK_ASSERT(!s_instance);
+    const CkConfig& config = System::get()->getConfig();
+
+    // in offline mode, streams are filled from the render call instead
+    int numThreads = System::get()->isOffline() ? 0 : config.streamThreads;
+    s_instance = new StreamScheduler(numThreads);
+}
+
+void StreamScheduler::shutdown()
+{
+    delete s_instance;
+    s_instance = NULL;
+}
+
+void StreamScheduler::add(StreamSource* source)
+{
+    m_mutex.lock();
+    source->m_filling = false;
+    m_list.addFirst(source);
+    m_cond.signal(); // new stream needs to be opened
+    m_mutex.unlock();
+}
+
+void StreamScheduler::remove(StreamSource* source)
+{
+    m_mutex.lock();
+    while (source->m_filling)
+    {
+        // rare; only if a stream is destroyed while a file thread is reading it
+        ++m_removeWaiters;
+        m_fillDoneCond.wait(m_mutex);
+        --m_removeWaiters;
+    }
+    m_list.remove(source);
+    m_mutex.unlock();
+}
+
+void StreamScheduler::getStats(const StreamSource* source, StreamSource::Stats& stats)
+{
+    m_mutex.lock();
+    stats = source->m_stats;
+    m_mutex.unlock();
+}
+
+void StreamScheduler::wake()
+{
+    if (m_numThreads > 0)
+    {
+        Atomic::storeRelease(&m_wakePending, (int32) 1);
+
+        // Don't wait for the lock; if a file thread holds it, it will see
+        // m_wakePending before it sleeps (or, in the rare case that it is just
+        // about to sleep, it will wake up again within m_waitMs).
+        if (m_mutex.tryLock())
+        {
+            m_cond.signal();
+            m_mutex.unlock();
+        }
+    }
+}
+
+void StreamScheduler::fillAll()
+{
+    m_mutex.lock();
+    bool more = true;
+    while (more)
+    {
+        StreamSource* source = findMostUrgent(more);
+        if (!source)
+        {
+            break;
+        }
+        fill(source);
+    }
+    m_mutex.unlock();
+}
+
+StreamScheduler::StreamScheduler(int numThreads) :
+    m_numThreads(numThreads),
+    m_threads(NULL),
+    m_waitMs(0),
+    m_removeWaiters(0),
+    m_wakePending(0),
+    m_stop(false)
+{
+    m_waitMs = Math::max(1, Math::round(System::get()->getConfig().streamFileUpdateMs));
+
+    if (numThreads > 0)
+    {
+        m_threads = (Thread**) Mem::alloc(sizeof(Thread*) * numThreads);
+        for (int i = 0; i < numThreads; ++i)
+        {
+            Thread* thread = new Thread(threadFunc);
+#if CK_PLATFORM_ANDROID
+            thread->setFlags(Thread::k_flagAttachToJvm);
+#endif
+            thread->setName("CK stream file");
+            m_threads[i] = thread;
+        }
+
+        // start threads only after all members are set up
+        for (int i = 0; i < numThreads; ++i)
+        {
+            m_threads[i]->start(this);
+        }
+    }
+}
+
+StreamScheduler::~StreamScheduler()
+{
+    if (m_threads)
+    {
+        m_mutex.lock();
+        m_stop = true;
+        for (int i = 0; i < m_numThreads; ++i)
+        {
+            m_cond.signal();
+        }
+        m_mutex.unlock();
+
+        for (int i = 0; i < m_numThreads; ++i)
+        {
+            m_threads[i]->join();
+            delete m_threads[i];
+        }
+        Mem::free(m_threads);
+    }
+    CK_ASSERT(m_list.isEmpty());
+}
+
+StreamSource* StreamScheduler::findMostUrgent(bool& more)
+{
+    // Streams that are opening or seeking are primed first, since they can't
+    // start playing until they are; after that, the stream with the least audio
+    // buffered is the closest to underrunning.
+    StreamSource* best = NULL;
+    bool bestPriming = false;
+    float bestMs = 0.0f;
+    int count = 0;
+    for (StreamSource* p = m_list.getFirst(); p; p = p->getNext())
+    {
+        if (!p->m_filling && p->needsFill())
+        {
+            ++count;
+            bool priming = p->isPriming();
+            float ms = p->getBufferedMs();
+            if (!best || (priming && !bestPriming) || (priming == bestPriming && ms < bestMs))
+            {
+                best = p;
+                bestPriming = priming;
+                bestMs = ms;
+            }
+        }
+    }
+    more = (count > 1);
+    return best;
+}
+
+void StreamScheduler::fill(StreamSource* source)
+{
+    source->m_filling = true;
+    m_mutex.unlock();
+
+#if CK_PLATFORM_IOS || CK_PLATFORM_OSX || CK_PLATFORM_TVOS
+    // need to create/destroy autorelease pools if using Cocoa objects
+    // with autorelease!
+    AudioHelpers::createAutoreleasePool();
+#endif
+
+    source->fileUpdate();
+
+#if CK_PLATFORM_IOS || CK_PLATFORM_OSX || CK_PLATFORM_TVOS
+    AudioHelpers::destroyAutoreleasePool();
+#endif
+
+    m_mutex.lock();
+    source->m_stats = source->m_fillStats;
+    source->m_filling = false;
+
+    // wake every waiter, since each may be waiting for a different stream
+    for (int i = 0; i < m_removeWaiters; ++i)
+    {
+        m_fillDoneCond.signal();
+    }
+}
+
+void StreamScheduler::threadLoop()
+{
+    m_mutex.lock();
+    while (!m_stop)
+    {
+        m_wakePending = 0;
+
+        bool more = false;
+        StreamSource* source = findMostUrgent(more);
+        if (source)
+        {
+            if (more)
+            {
+                // let another thread start on the next one
+                m_cond.signal();
+            }
+            fill(source);
+        }
+        else if (!Atomic::loadAcquire(&m_wakePending))
+        {
+            if (m_list.isEmpty())
+            {
+                m_cond.wait(m_mutex);
+            }
+            else
+            {
+                m_cond.wait(m_mutex, m_waitMs);
+            }
+        }
+    }
+    m_mutex.unlock();
+}
+
+void* StreamScheduler::threadFunc(void* arg)
+{
+    StreamScheduler* scheduler = (StreamScheduler*) arg;
+    scheduler->threadLoop();
+    return NULL;
+}
+
+StreamScheduler* StreamScheduler::s_instance = NULL;
+
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/core/allocatable.h"
+#include "ck/core/types.h"
+#include "ck/core/list.h"
+#include "ck/core/mutex.h"
+#include "ck/core/cond.h"
+#include "ck/audio/streamsource.h"
+
+namespace Cki
+{
+
+class Thread;
+
+
+// Reads and decodes stream sounds on a pool of file threads (CkConfig.streamThreads).
+// A stream is refilled when its buffer falls to half full; when several streams
+// need refilling, the one with the least audio buffered goes first.  Streams
+// that have just been opened or repositioned go before all others, and are
+// only filled partway (CkConfig.streamPrimeMs) before they are ready to play.
+// A stream is never refilled by more than one thread at a time.
+// In offline mode there are no threads; fillAll() is called before each render.
+class StreamScheduler : public Allocatable
+{
+public:
+    static void init();
+    static void shutdown();
+    static StreamScheduler* get() { return s_instance; }
+
+    void add(StreamSource*);
+    void remove(StreamSource*); // waits if the source is being refilled
+
+    // Copy a stream's statistics, which file threads publish under the
+    // scheduler's lock after each refill.
+    void getStats(const StreamSource*, StreamSource::Stats&);
+
+    // Let the file threads know that a stream needs refilling.
+    // Never blocks, so it can be called from the audio thread.
+    void wake();
+
+    // Refill all streams that need it, on the calling thread.
+    void fillAll();
+
+    int getThreadCount() const { return m_numThreads; }
+
+private:
+    int m_numThreads;
+    Thread** m_threads;
+    int m_waitMs;                 // longest time to sleep when there are streams
+
+    Mutex m_mutex;
+    Cond m_cond;
+    Cond m_fillDoneCond;          // signaled when a refill ends, if m_removeWaiters > 0
+    int m_removeWaiters;          // threads in remove() waiting for a refill to end
+    List<StreamSource> m_list;    // guarded by m_mutex
+    volatile int32 m_wakePending;
+    bool m_stop;
+
+    static StreamScheduler* s_instance;
+
+    StreamScheduler(int numThreads);
+    ~StreamScheduler();
+
+    StreamSource* findMostUrgent(bool& more); // call with m_mutex locked
+    void fill(StreamSource*);                 // call with m_mutex locked
+    void threadLoop();
+    static void* threadFunc(void*);
+
+    StreamScheduler(const StreamScheduler&);
+    StreamScheduler& operator=(const StreamScheduler&);
+};
+
+
+}
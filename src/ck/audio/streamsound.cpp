@@ -11,10 +11,17 @@ namespace Cki
 
 StreamSound::StreamSound() :
     m_nextFrame(-1),
-    m_nextMs(-1.0f)
+    m_nextMs(-1.0f),
+    m_streamSource(NULL)
 {
 }
 
+void StreamSound::subInitStream(StreamSource* source)
+{
+    m_streamSource = source;
+    subInit(source);
+}
+
 bool StreamSound::isReadySub() const
 {
     return m_nextFrame < 0 && m_nextMs < 0.0f && GraphSound::isReadySub();
@@ -22,10 +29,9 @@ bool StreamSound::isReadySub() const
 
 void StreamSound::setPlayPosition(int frame)
 {
-    // unlike with BufferSource, StreamSource protects this call with a mutex,
-    // so it's safe to call it from the main thread.  We want to do it
-    // this way, rather than from SourceNode, so the seek can happen
-    // even before the sound is played.
+    // The seek is handed to StreamSource on the audio thread as soon as the
+    // source is inited, rather than when SourceNode next plays, so the file
+    // thread can refill the buffer even before the sound is played.
     m_nextFrame = frame;
     m_nextMs = -1.0f;
     updateSeek();
@@ -51,6 +57,27 @@ void StreamSound::setLoop(int startFrame, int endFrame)
     }
 }
 
+bool StreamSound::getStreamStats(CkStreamStats& stats) const
+{
+    if (!m_streamSource)
+    {
+        return false;
+    }
+
+    StreamSource::Stats sourceStats;
+    m_streamSource->getStats(sourceStats);
+    stats.underruns = sourceStats.underruns;
+    stats.fills = sourceStats.fills;
+    stats.avgLatencyMs = (sourceStats.fills > 0 ? sourceStats.totalLatencyMs / sourceStats.fills : 0.0f);
+    stats.maxLatencyMs = sourceStats.maxLatencyMs;
+    stats.avgFillMs = (sourceStats.fills > 0 ? sourceStats.totalFillMs / sourceStats.fills : 0.0f);
+    stats.maxFillMs = sourceStats.maxFillMs;
+    stats.primes = sourceStats.primes;
+    stats.maxPrimeMs = sourceStats.maxPrimeMs;
+    stats.bufferedMs = m_streamSource->getBufferedMs();
+    return true;
+}
+
 void StreamSound::updateSeek()
 {
     int nextFrame = -1;
@@ -67,7 +94,7 @@ void StreamSound::updateSeek()
     }
     if (nextFrame >= 0)
     {
-        AudioGraph::get()->execute(&m_sourceNode, SourceNode::k_setNextFrame, nextFrame);
+        AudioGraph::get()->executeCoalesced(&m_sourceNode, SourceNode::k_setNextFrame, nextFrame);
         m_nextFrame = -1;
         m_nextMs = -1.0f;
     }
@@ -6,6 +6,7 @@
 namespace Cki
 {
 
+class StreamSource;
 
 class StreamSound : public GraphSound
 {
@@ -16,13 +17,18 @@ public:
     virtual void setPlayPositionMs(float);
     virtual void setLoop(int startFrame, int endFrame);
 
+    virtual bool getStreamStats(CkStreamStats&) const;
+
 protected:
     virtual void updateSeek();
     virtual bool isReadySub() const;
 
+    void subInitStream(StreamSource*); // call in subclass ctor, instead of subInit()
+
 private:
     int m_nextFrame;
     float m_nextMs;
+    StreamSource* m_streamSource; // NULL if decoded by the platform
 };
 
 
@@ -1,4 +1,5 @@
 #include "ck/audio/streamsource.h"
+#include "ck/audio/streamscheduler.h"
 #include "ck/audio/audiostream.h"
 #include "ck/audio/audioutil.h"
 #include "ck/audio/fileheader.h"
@@ -7,9 +8,10 @@
 #include "ck/core/system.h"
 #include "ck/core/math.h"
 #include "ck/core/debug.h"
-#include "ck/core/mutexlock.h"
+#include "ck/core/atomic.h"
 #include "ck/core/logger.h"
 #include "ck/core/mem.h"
+#include "ck/core/timer.h"
 
 // template definitions
 #include "ck/core/list.cpp"
@@ -22,51 +24,72 @@ namespace Cki
 
 StreamSource::StreamSource(AudioStream* stream) :
     m_stream(stream),
-    m_inited(false),
     m_failed(false),
-    m_primed(false),
-    m_reset(false),
+    m_buf(),
+    m_bufInited(false),
+    m_bytesPerMs(0.0f),
+    m_primeBytes(0),
+    m_filling(false),
+    m_fillStats(),
+    m_stats(),
+    m_underruns(0),
+    m_inited(false),
+    m_readDone(false),
+    m_ackGen(0),
+    m_primedGen(-1),
+    m_seekResultBlock(0),
+    m_resetCountSeen(0),
+    m_readLoopCurrent(0),
+    m_toppingUp(false),
+    m_seekGen(0),
+    m_seekBlock(0),
+    m_resetCount(0),
+    m_playGen(0),
     m_warned(false),
     m_playBlock(0),
-    m_nextBlock(-1),
-    m_loopCount(0),
-    m_loopCountSet(false),
-    m_readLoopCurrent(0),
     m_playLoopCurrent(0),
-    m_readDone(false),
     m_playDone(false),
+    m_loopCount(0),
     m_loopStart(0),
     m_loopEnd(-1),
-    m_loopSet(false),
     m_releaseLoop(false),
-    m_buf()
+    m_loopCountSet(false),
+    m_loopSet(false)
 {
-    MutexLock lock(s_listMutex);
-    s_list.addFirst(this);
+    StreamScheduler::get()->add(this);
 }
 
 StreamSource::~StreamSource()
 {
-    MutexLock lock(s_listMutex);
-    s_list.remove(this);
+    StreamScheduler::get()->remove(this);
 }
 
 int StreamSource::read(void* buf, int blocks)
 {
-    // lock because read is usually called from audio output callback
-    MutexLock lock(m_bufMutex);
-
-    if (m_playDone)
+    // Called from the audio thread, so this must never wait on the file thread.
+    if (m_playDone || isSeeking())
     {
         return 0;
     }
 
+    if (m_playGen != m_seekGen)
+    {
+        // first read since a seek; the stream may not have landed exactly where we asked
+        m_playBlock = m_seekResultBlock;
+        m_playGen = m_seekGen;
+    }
+
     CK_ASSERT(m_inited);
     int blockBytes = m_stream->getSampleInfo().blockBytes;
     int blockFrames = m_stream->getSampleInfo().blockFrames;
 
     int bytes = blocks * blockBytes;
+    bool wasHalfFull = (m_buf.getStoredBytes() >= m_buf.getSize() / 2);
     int bytesRead = m_buf.read(buf, bytes);
+    if (wasHalfFull && m_buf.getStoredBytes() < m_buf.getSize() / 2 && !m_readDone)
+    {
+        StreamScheduler::get()->wake();
+    }
     CK_ASSERT(bytesRead % blockBytes == 0);
     int blocksRead = bytesRead / blockBytes;
 
@@ -78,11 +101,13 @@ int StreamSource::read(void* buf, int blocks)
     // Note that getNumBlocks() can return -1, but will not if we've played to the end,
     // which will be the case if we're looping at the end.
     int numBlocks = m_stream->getNumBlocks();
-    int loopEndBlock = m_loopEnd < 0 ? numBlocks : m_loopEnd / blockFrames;
+    int loopEnd = m_loopEnd;
+    int loopCount = m_loopCount;
+    int loopEndBlock = loopEnd < 0 ? numBlocks : loopEnd / blockFrames;
     if (loopEndBlock > 0)
     {
         int loopStartBlock = Math::clamp(Math::round((float) m_loopStart / blockFrames), 0, loopEndBlock - 1);
-        while ((m_loopCount < 0 || m_playLoopCurrent < m_loopCount) &&
+        while ((loopCount < 0 || m_playLoopCurrent < loopCount) &&
                 m_playBlock >= loopEndBlock)
         {
             m_playBlock -= (loopEndBlock - loopStartBlock);
@@ -93,16 +118,22 @@ int StreamSource::read(void* buf, int blocks)
     bool underrun = false;
     if (blocksRead < blocks)
     {
-        if (m_readDone)
+        if (Atomic::loadAcquire(&m_readDone))
         {
-            m_playDone = true;
-            m_playBlock = 0;
+            // The file thread may have written its last data after we read, so
+            // check again now that we know it's done.
+            if (m_buf.isEmpty())
+            {
+                m_playDone = true;
+                m_playBlock = 0;
+            }
         }
         else
         {
             underrun = true;
             if (!m_warned)
             {
+                Atomic::storeRelease(&m_underruns, m_underruns + 1);
                 CK_LOG_WARNING("Stream buffer underrun! Try increasing CkConfig.streamBufferMs.");
                 m_warned = true;
             }
@@ -124,30 +155,28 @@ int StreamSource::getNumBlocks() const
 
 void StreamSource::setBlockPos(int block)
 {
-    MutexLock lock(m_bufMutex);
     int pos = getBlockPos();
-    if (block != m_nextBlock && block != pos)
+    if (block != pos)
     {
         // if the buffer is primed, and we're seeking forward to within the buffer, don't reset it
-        if (m_primed && !m_reset && block > pos)
+        if (block > pos && !isSeeking() && m_playGen == m_seekGen && Atomic::loadAcquire(&m_primedGen) == m_seekGen)
         {
             const SampleInfo& sampleInfo = m_stream->getSampleInfo();
             int bufBlocks = m_buf.getStoredBytes() / sampleInfo.blockBytes;
             if (bufBlocks > block - pos)
             {
                 m_buf.consume((block - pos) * sampleInfo.blockBytes);
+                m_playBlock = block;
                 if (m_buf.getStoredBytes() < m_buf.getSize() / 2)
                 {
-                    m_primed = false;
+                    StreamScheduler::get()->wake();
                 }
                 return;
             }
         }
 
-        // otherwise reset and fill the buffer from scratch
-        m_reset = true;
-        m_primed = false;
-        m_nextBlock = block;
+        // otherwise have the file thread fill the buffer from scratch
+        requestSeek(block);
     }
 }
 
@@ -160,16 +189,10 @@ void StreamSource::reset()
 {
     if (m_inited)
     {
-        MutexLock lock(m_bufMutex);
-        m_reset = true;
-        m_playBlock = 0;
-        m_nextBlock = 0;
-        m_readLoopCurrent = 0;
         m_playLoopCurrent = 0;
-        m_readDone = false;
-        m_playDone = false;
-        m_primed = false;
         m_releaseLoop = false;
+        ++m_resetCount;
+        requestSeek(0);
     }
 }
 
@@ -186,7 +209,7 @@ bool StreamSource::isInited() const
 
 bool StreamSource::isReady() const
 {
-    return m_inited && !m_failed && !m_stream->isFailed() && m_primed && !m_reset;
+    return m_inited && !m_failed && !m_stream->isFailed() && Atomic::loadAcquire(&m_primedGen) == m_seekGen;
 }
 
 bool StreamSource::isFailed() const
@@ -201,7 +224,6 @@ bool StreamSource::isDone() const
 
 void StreamSource::setLoop(int loopStart, int loopEnd)
 {
-    MutexLock lock(m_bufMutex); 
     m_loopSet = true;
     m_loopStart = loopStart;
     m_loopEnd = loopEnd;
@@ -215,7 +237,6 @@ void StreamSource::getLoop(int& loopStart, int& loopEnd) const
 
 void StreamSource::setLoopCount(int loopCount)
 {
-    MutexLock lock(m_bufMutex); // probably not necessary
     m_loopCountSet = true;
     m_loopCount = loopCount;
 }
@@ -232,7 +253,6 @@ int StreamSource::getCurrentLoop() const
 
 void StreamSource::releaseLoop()
 {
-    MutexLock lock(m_bufMutex); 
     m_releaseLoop = true;
 }
 
@@ -254,6 +274,13 @@ void StreamSource::update()
         m_buf.init(bufBytes);
         if (m_buf.isInited())
         {
+            m_bytesPerMs = bytesPerSec * 0.001f;
+
+            float primeMs = System::get()->getConfig().streamPrimeMs;
+            m_primeBytes = Math::round(primeMs * m_bytesPerMs);
+            m_primeBytes -= (m_primeBytes % sampleInfo.blockBytes);
+            m_primeBytes = Math::clamp(m_primeBytes, (int) sampleInfo.blockBytes, bufBytes);
+
             // set default loops (only if not set earlier explicitly)
             if (!m_loopSet)
             {
@@ -264,6 +291,10 @@ void StreamSource::update()
             {
                 m_loopCount = sampleInfo.loopCount;
             }
+
+            // ready for the first fill
+            Atomic::storeRelease(&m_bufInited, true);
+            StreamScheduler::get()->wake();
         }
         else
         {
@@ -279,8 +310,6 @@ void StreamSource::fileUpdate()
         return;
     }
 
-    MutexLock lock(m_bufMutex);
-
     if (!m_inited)
     {
         m_stream->init();
@@ -290,56 +319,162 @@ void StreamSource::fileUpdate()
         }
         else
         {
-            m_inited = true;
+            Atomic::storeRelease(&m_inited, true);
         }
+    }
 
-        // buffer will be allocated in next update() call (on main thread)
+    if (!Atomic::loadAcquire(&m_bufInited))
+    {
+        return; // buffer will be allocated in next update() call (on main thread)
     }
 
-    if (m_reset)
+    int32 gen = Atomic::loadAcquire(&m_seekGen);
+    if (gen != m_ackGen)
     {
+        // The audio thread won't read from the buffer until we acknowledge
+        // the seek, so it's safe to throw away what's in it.
         m_buf.resetWrite();
-        m_reset = false;
+        m_stream->setBlockPos(m_seekBlock);
+        m_seekResultBlock = m_stream->getBlockPos();
+        int32 resetCount = m_resetCount;
+        if (resetCount != m_resetCountSeen)
+        {
+            m_readLoopCurrent = 0;
+            m_resetCountSeen = resetCount;
+        }
+        m_readDone = false;
+        Atomic::storeRelease(&m_ackGen, gen);
+    }
+
+    // After opening or seeking, fill only enough to start playing, so that
+    // the stream is ready sooner; the rest of the buffer is filled on the
+    // next pass, once any other streams that are priming have been served.
+    bool primed = (m_primedGen == gen);
+    if (!m_readDone && (!primed || m_toppingUp || m_buf.getStoredBytes() < m_buf.getSize() / 2))
+    {
+        bool refill = (primed && !m_toppingUp);
+        if (refill)
+        {
+            // How much has been played since the buffer fell to half full is
+            // how late this refill is.
+            float latencyMs = (m_buf.getSize() / 2 - m_buf.getStoredBytes()) / m_bytesPerMs;
+            m_fillStats.totalLatencyMs += latencyMs;
+            m_fillStats.maxLatencyMs = Math::max(m_fillStats.maxLatencyMs, latencyMs);
+        }
+
+        Timer timer;
+        timer.start();
+        fillBuffer(gen, primed ? m_buf.getSize() : m_primeBytes);
+        timer.stop();
+
+        float fillMs = timer.getElapsedMs();
+        if (refill)
+        {
+            ++m_fillStats.fills;
+            m_fillStats.totalFillMs += fillMs;
+            m_fillStats.maxFillMs = Math::max(m_fillStats.maxFillMs, fillMs);
+        }
+        else if (!primed)
+        {
+            ++m_fillStats.primes;
+            m_fillStats.maxPrimeMs = Math::max(m_fillStats.maxPrimeMs, fillMs);
+        }
+        m_toppingUp = !primed;
     }
 
-    if (!m_readDone && m_buf.isInited() && m_buf.getStoredBytes() < m_buf.getSize() / 2)
+    if (!primed)
     {
-        fillBuffer();
-        m_primed = true;
+        Atomic::storeRelease(&m_primedGen, gen);
     }
 }
 
-void StreamSource::fileUpdateAll()
+bool StreamSource::needsFill() const
 {
-    MutexLock lock(s_listMutex);
-    StreamSource* p = s_list.getFirst();
-    while (p)
+    if (isFailed())
+    {
+        return false;
+    }
+    else if (!m_inited)
     {
-        p->fileUpdate();
-        p = p->getNext();
+        return true;
     }
+    else if (!Atomic::loadAcquire(&m_bufInited))
+    {
+        return false;
+    }
+    else if (isPriming())
+    {
+        return true;
+    }
+    else
+    {
+        return !m_readDone && (m_toppingUp || m_buf.getStoredBytes() < m_buf.getSize() / 2);
+    }
+}
+
+bool StreamSource::isPriming() const
+{
+    // opening, seeking, or not yet filled enough to play since the last seek
+    return !m_inited || isSeeking() || Atomic::loadAcquire(&m_primedGen) != m_seekGen;
+}
+
+float StreamSource::getBufferedMs() const
+{
+    if (m_bytesPerMs > 0.0f && !isSeeking())
+    {
+        return m_buf.getStoredBytes() / m_bytesPerMs;
+    }
+    else
+    {
+        return 0.0f;
+    }
+}
+
+void StreamSource::getStats(Stats& stats) const
+{
+    StreamScheduler::get()->getStats(this, stats);
+    stats.underruns = Atomic::loadAcquire(&m_underruns);
+}
+
+bool StreamSource::isSeeking() const
+{
+    return Atomic::loadAcquire(&m_ackGen) != m_seekGen;
+}
+
+void StreamSource::requestSeek(int block)
+{
+    m_seekBlock = block;
+    m_playBlock = block;
+    m_playDone = false;
+    Atomic::storeRelease(&m_seekGen, m_seekGen + 1);
+    StreamScheduler::get()->wake();
 }
 
 ////////////////////////////////////////
 
-void StreamSource::fillBuffer()
+void StreamSource::fillBuffer(int32 gen, int maxBytes)
 {
-    int freeBytes = m_buf.getFreeBytes();
+    int freeBytes = Math::min(m_buf.getFreeBytes(), maxBytes);
     CK_ASSERT(m_inited);
     const SampleInfo& sampleInfo = m_stream->getSampleInfo();
 
-    if (!m_releaseLoop && (m_loopCount < 0 || m_readLoopCurrent < m_loopCount))
+    // take a copy, since the audio thread may change these while we're reading
+    int loopCount = m_loopCount;
+    int loopStart = m_loopStart;
+    int loopEnd = m_loopEnd;
+
+    if (!m_releaseLoop && (loopCount < 0 || m_readLoopCurrent < loopCount))
     {
         // loop end may be -1 to indicate end of file; note that WE DO NOT KNOW THE FILE LENGTH FOR CERTAIN!
-        int loopStartBlock = Math::round((float) m_loopStart / sampleInfo.blockFrames);
-        int loopEndBlock = m_loopEnd < 0 ? -1 : Math::round((float) m_loopEnd / sampleInfo.blockFrames);
+        int loopStartBlock = Math::round((float) loopStart / sampleInfo.blockFrames);
+        int loopEndBlock = loopEnd < 0 ? -1 : Math::round((float) loopEnd / sampleInfo.blockFrames);
         if (loopEndBlock >= 0 && loopEndBlock <= loopStartBlock)
         {
             loopEndBlock = loopStartBlock + 1;
         }
 
         int totalBytesRead = 0;
-        while (totalBytesRead < freeBytes)
+        while (totalBytesRead < freeBytes && Atomic::loadAcquire(&m_seekGen) == gen)
         {
             int bytesToRead = freeBytes - totalBytesRead;
             if (loopEndBlock >= 0)
@@ -357,13 +492,13 @@ void StreamSource::fillBuffer()
                 m_stream->setBlockPos(loopStartBlock);
                 ++m_readLoopCurrent;
             }
-            if (m_loopCount >= 0)
+            if (loopCount >= 0)
             {
-                if (m_readLoopCurrent > m_loopCount && bytesRead < bytesToRead)
+                if (m_readLoopCurrent > loopCount && bytesRead < bytesToRead)
                 {
-                    m_readDone = true;
+                    Atomic::storeRelease(&m_readDone, true);
                 }
-                if (m_readLoopCurrent >= m_loopCount)
+                if (m_readLoopCurrent >= loopCount)
                 {
                     break;
                 }
@@ -375,20 +510,13 @@ void StreamSource::fillBuffer()
         int bytesRead = readFromStream(freeBytes);
         if (bytesRead < freeBytes)
         {
-            m_readDone = true;
+            Atomic::storeRelease(&m_readDone, true);
         }
     }
 }
 
 int StreamSource::readFromStream(int bytes)
 {
-    if (m_nextBlock >= 0)
-    {
-        m_stream->setBlockPos(m_nextBlock);
-        m_nextBlock = -1;
-        m_playBlock = m_stream->getBlockPos();
-    }
-
     // Some streams do not reliably report their length (I've noticed
     // this with MP3 files, specifically 0001.mp3 in the testbed).
     // So try to read an entire buffer's worth; when we hit the
@@ -403,12 +531,11 @@ int StreamSource::readFromStream(int bytes)
         int bytes1;
         int bytes2;
 
+        // the audio thread can keep reading while we write
         m_buf.beginWrite(bytesToWrite, buf1, bytes1, buf2, bytes2);
         CK_ASSERT(bytes1 % blockBytes == 0);
         CK_ASSERT(bytes2 % blockBytes == 0);
 
-        // unlock mutex during read
-        m_bufMutex.unlock();
         int blocksRead = 0;
         if (buf1)
         {
@@ -418,7 +545,6 @@ int StreamSource::readFromStream(int bytes)
                 blocksRead += m_stream->read(buf2, bytes2 / blockBytes);
             }
         }
-        m_bufMutex.lock();
 
         int bytesRead = blocksRead * blockBytes;
         m_buf.endWrite(bytesRead);
@@ -431,9 +557,6 @@ int StreamSource::readFromStream(int bytes)
 }
 
 
-List<StreamSource> StreamSource::s_list;
-Mutex StreamSource::s_listMutex;
-
 template class List<StreamSource>;
 
 }
@@ -2,7 +2,6 @@
 
 #include "ck/core/platform.h"
 #include "ck/core/ringbuffer.h"
-#include "ck/core/mutex.h"
 #include "ck/core/list.h"
 #include "ck/audio/audiosource.h"
 
@@ -44,34 +43,73 @@ public:
 
     // update from file thread
     void fileUpdate();
-    static void fileUpdateAll();
+
+    struct Stats
+    {
+        int underruns;        // times the buffer ran out while playing
+        int fills;            // refills after the buffer fell to half full
+        float totalLatencyMs; // time from falling to half full until a refill started
+        float maxLatencyMs;
+        float totalFillMs;    // time spent reading and decoding
+        float maxFillMs;
+        int primes;           // partial fills after opening or seeking
+        float maxPrimeMs;
+    };
+    void getStats(Stats&) const;
+    float getBufferedMs() const;
 
 private:
+    friend class StreamScheduler;
+
     AudioStream* m_stream;
-    bool m_inited;
     bool m_failed;
-    bool m_primed;
-    bool m_reset;
+    RingBuffer m_buf;
+    volatile bool m_bufInited; // set by the main thread once m_buf is allocated
+    float m_bytesPerMs;
+    int m_primeBytes; // amount to fill before a seek is complete (CkConfig.streamPrimeMs)
+    bool m_filling; // being refilled by StreamScheduler; guarded by its mutex
+    Stats m_fillStats; // written by the file thread while refilling
+    Stats m_stats; // copy of m_fillStats, published under StreamScheduler's mutex
+    volatile int32 m_underruns; // written by the audio thread
+
+    // No locks: read(), setBlockPos(), reset() and the loop setters are called
+    // on the audio thread, and fileUpdate() on a file thread.  To seek, the
+    // audio thread bumps m_seekGen and leaves the buffer alone until the file
+    // thread has emptied it, moved the stream, and caught up m_ackGen.
+
+    // written by the file thread
+    volatile bool m_inited;
+    volatile bool m_readDone;
+    volatile int32 m_ackGen;    // last seek request handled
+    volatile int32 m_primedGen; // last seek request after which the buffer was filled
+    int m_seekResultBlock;      // stream position after the seek; published by m_ackGen
+    int32 m_resetCountSeen;
+    int m_readLoopCurrent;
+    bool m_toppingUp;           // next fill completes the one that primed the buffer
+
+    // written by the audio thread
+    volatile int32 m_seekGen;   // incremented for each seek request
+    volatile int m_seekBlock;   // published by m_seekGen
+    volatile int32 m_resetCount; // incremented by reset(); published by m_seekGen
+    int32 m_playGen;            // seek request that m_playBlock reflects
     bool m_warned;
     int m_playBlock; // playback position (different from stream pos because of buffering)
-    int m_nextBlock; // next block to jump to, or -1
-    int m_loopCount;
-    bool m_loopCountSet;
-    int m_readLoopCurrent;
     int m_playLoopCurrent;
-    bool m_readDone;
     bool m_playDone;
-    int m_loopStart;
-    int m_loopEnd;
-    bool m_loopSet;
-    bool m_releaseLoop;
-    RingBuffer m_buf;
-    Mutex m_bufMutex;
 
-    static List<StreamSource> s_list;
-    static Mutex s_listMutex;
+    // loop settings, written by the audio thread and read by both
+    volatile int m_loopCount;
+    volatile int m_loopStart;
+    volatile int m_loopEnd;
+    volatile bool m_releaseLoop;
+    bool m_loopCountSet;
+    bool m_loopSet;
 
-    void fillBuffer();
+    bool needsFill() const;
+    bool isPriming() const;
+    bool isSeeking() const;
+    void requestSeek(int block);
+    void fillBuffer(int32 gen, int maxBytes);
     int readFromStream(int bytes);
 
     StreamSource(const StreamSource&);
@@ -0,0 +1,171 @@
+#include "ck/audio/voicemanager.h"
+#include "ck/audio/sound.h"
+#include "ck/core/system.h"
+#include "ck/core/mem.h"
+#include "ck/core/debug.h"
+#include "ck/core/logger.h"
+
+namespace Cki
+{
+
+
+namespace
+{
+    // score bonus for sounds that are already real, so sounds with nearly
+    // equal scores don't switch back and forth every update
+    const float k_hysteresis = 1.1f;
+}
+
+void VoiceManager::init()
+{
+    const CkConfig& config = System::get()->getConfig();
+    if (config.maxRealVoices > 0)
+    {
+        s_heap = (Entry*) Mem::alloc(sizeof(Entry) * config.maxRealVoices);
+        if (s_heap)
+        {
+            s_maxReal = config.maxRealVoices;
+        }
+        else
+        {
+            CK_LOG_ERROR("Could not allocate memory for voice limit; voices will not be limited");
+        }
+    }
+}
+
+void VoiceManager::shutdown()
+{
+    Mem::free(s_heap);
+    s_heap = NULL;
+    s_maxReal = 0;
+    s_count = 0;
+    Mem::clear(&s_stats, sizeof(s_stats));
+}
+
+void VoiceManager::update(Sound* first)
+{
+    s_count = 0;
+    s_stats.realVoices = 0;
+    s_stats.virtualVoices = 0;
+    s_stats.stolenVoices = 0;
+
+    for (Sound* p = first; p; p = ((SoundList::Node*) p)->getNext())
+    {
+        if (!p->isPlaying() || p->getMixedPauseState())
+        {
+            p->setVoiceStolen(false);
+            continue;
+        }
+
+        if (p->m_3d && p->m_virtual)
+        {
+            // inaudible anyway; doesn't need a voice
+            p->setVoiceStolen(false);
+            ++s_stats.virtualVoices;
+            continue;
+        }
+
+        if (s_maxReal <= 0)
+        {
+            ++s_stats.realVoices;
+            continue;
+        }
+
+        Entry e;
+        e.sound = p;
+        e.score = p->getFinalVolume() * p->m_priority;
+        if (!p->m_voiceStolen)
+        {
+            e.score *= k_hysteresis;
+        }
+
+        Sound* loser = NULL;
+        if (s_count < s_maxReal)
+        {
+            s_heap[s_count] = e;
+            siftUp(s_count++);
+        }
+        else if (s_heap[0] < e)
+        {
+            loser = s_heap[0].sound;
+            s_heap[0] = e;
+            siftDown(0);
+        }
+        else
+        {
+            loser = p;
+        }
+
+        if (loser)
+        {
+            if (!loser->m_voiceStolen)
+            {
+                ++s_stats.stolenVoices;
+            }
+            loser->setVoiceStolen(true);
+            ++s_stats.virtualVoices;
+        }
+    }
+
+    for (int i = 0; i < s_count; ++i)
+    {
+        s_heap[i].sound->setVoiceStolen(false);
+    }
+    s_stats.realVoices += s_count;
+    s_count = 0;
+}
+
+void VoiceManager::getStats(CkVoiceStats& stats)
+{
+    stats = s_stats;
+}
+
+////////////////////////////////////////
+
+void VoiceManager::siftUp(int i)
+{
+    Entry e = s_heap[i];
+    while (i > 0)
+    {
+        int parent = (i - 1) / 2;
+        if (!(e < s_heap[parent]))
+        {
+            break;
+        }
+        s_heap[i] = s_heap[parent];
+        i = parent;
+    }
+    s_heap[i] = e;
+}
+
+void VoiceManager::siftDown(int i)
+{
+    Entry e = s_heap[i];
+    for (;;)
+    {
+        int child = 2*i + 1;
+        if (child >= s_count)
+        {
+            break;
+        }
+        if (child + 1 < s_count && s_heap[child + 1] < s_heap[child])
+        {
+            ++child;
+        }
+        if (!(s_heap[child] < e))
+        {
+            break;
+        }
+        s_heap[i] = s_heap[child];
+        i = child;
+    }
+    s_heap[i] = e;
+}
+
+int VoiceManager::s_maxReal = 0;
+VoiceManager::Entry* VoiceManager::s_heap = NULL;
+int VoiceManager::s_count = 0;
+CkVoiceStats VoiceManager::s_stats = { 0, 0, 0 };
+
+
+}
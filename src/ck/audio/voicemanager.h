@@ -0,0 +1,48 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/core/types.h"
+#include "ck/ck.h"
+
+namespace Cki
+{
+
+class Sound;
+
+
+// Limits the number of sounds rendered at once to CkConfig.maxRealVoices.
+// Each update, playing sounds are ranked by final volume times priority, and
+// all but the highest-ranked are made virtual; virtual sounds rendered by the
+// audio graph keep their play position, so they resume at the right frame.
+// Main thread only.
+class VoiceManager
+{
+public:
+    static void init();
+    static void shutdown();
+
+    // Called after all sounds have been updated.
+    static void update(Sound* first);
+
+    static void getStats(CkVoiceStats&);
+
+private:
+    struct Entry
+    {
+        Sound* sound;
+        float score;
+
+        bool operator<(const Entry& other) const { return score < other.score; }
+    };
+
+    static int s_maxReal;
+    static Entry* s_heap; // min-heap of the highest-scoring sounds
+    static int s_count;
+    static CkVoiceStats s_stats;
+
+    static void siftUp(int i);
+    static void siftDown(int i);
+};
+
+
+}
@@ -10,6 +10,10 @@ namespace Cki
 
 namespace
 {
+    // Tremor reads the file in small pieces (CHUNKSIZE bytes), so read ahead
+    // in larger chunks to cut down on file system calls.
+    const int k_readAheadBytes = 32 * 1024;
+
     size_t readFunc(void* ptr, size_t size, size_t nmemb, void* datasource)
     {
         BinaryStream* stream = (BinaryStream*) datasource;
@@ -79,6 +83,7 @@ namespace
 VorbisAudioStream::VorbisAudioStream(const char* path, CkPathType pathType, int offset, int length) :
     m_readStream(path, pathType),
     m_subStream(m_readStream, offset, length),
+    m_readAhead(m_subStream, k_readAheadBytes),
     m_failed(false),
     m_inited(false)
 {
@@ -94,7 +99,7 @@ void VorbisAudioStream::init()
 {
     if (!m_failed && !m_inited)
     {
-        if (ov_open_callbacks(&m_subStream, &m_ovfile, NULL, 0, g_callbacks) == 0)
+        if (ov_open_callbacks(&m_readAhead, &m_ovfile, NULL, 0, g_callbacks) == 0)
         {
             vorbis_info* vinfo = ov_info(&m_ovfile, -1);
             if (vinfo->channels > 2)
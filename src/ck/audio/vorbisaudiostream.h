@@ -5,6 +5,7 @@
 #include "ck/pathtype.h"
 #include "ck/core/readstream.h"
 #include "ck/core/substream.h"
+#include "ck/core/readaheadstream.h"
 #include "tremor/ivorbisfile.h"
 
 namespace Cki
@@ -28,6 +29,7 @@ public:
 private:
     ReadStream m_readStream;
     SubStream m_subStream;
+    ReadAheadStream m_readAhead;
     OggVorbis_File m_ovfile;
     bool m_failed;
     bool m_inited;
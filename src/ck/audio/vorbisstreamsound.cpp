@@ -10,7 +10,8 @@ VorbisStreamSound::VorbisStreamSound(const char* path, CkPathType pathType, int
     m_stream(path, pathType, offset, length),
     m_source(&m_stream)
 {
-    subInit(&m_source);
+    subInitStream(&m_source);
+    setName(Path(path, pathType).getLeaf());
 }
 
 
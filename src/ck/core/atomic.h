@@ -25,8 +25,37 @@ namespace Atomic
         return (__atomic_cmpxchg(oldVal, newVal, value) == oldVal);
 #elif CK_PLATFORM_WIN || CK_PLATFORM_WP8
         return (InterlockedCompareExchange((LONG*)value, (LONG)newVal, (LONG)oldVal) == oldVal);
+#elif CK_PLATFORM_LINUX
+        return __sync_bool_compare_and_swap(value, oldVal, newVal);
 #else
 #  error unsupported platform
+#endif
+    }
+
+    // Load with acquire semantics: reads and writes after the load will not be
+    // reordered before it.  T must be a word-sized (or smaller) integer or pointer.
+    template <typename T>
+    inline T loadAcquire(const volatile T* p)
+    {
+#if CK_PLATFORM_WIN || CK_PLATFORM_WP8
+        T value = *p;
+        MemoryBarrier();
+        return value;
+#else
+        return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+#endif
+    }
+
+    // Store with release semantics: reads and writes before the store will not be
+    // reordered after it.
+    template <typename T>
+    inline void storeRelease(volatile T* p, T value)
+    {
+#if CK_PLATFORM_WIN || CK_PLATFORM_WP8
+        MemoryBarrier();
+        *p = value;
+#else
+        __atomic_store_n(p, value, __ATOMIC_RELEASE);
 #endif
     }
 }
@@ -1,5 +1,9 @@
 #include "ck/core/cond.h"
 #include "ck/core/debug.h"
+#if !CK_PLATFORM_WIN && !CK_PLATFORM_WP8
+#  include <sys/time.h>
+#  include <errno.h>
+#endif
 
 namespace Cki
 {
@@ -54,6 +58,43 @@ void Cond::wait(Mutex& mutex)
 #endif
 }
 
+bool Cond::wait(Mutex& mutex, int timeoutMs)
+{
+#if CK_PLATFORM_WIN || CK_PLATFORM_WP8
+    m_waitersMutex.lock();
+    ++m_waiters;
+    m_waitersMutex.unlock();
+
+    mutex.unlock();
+
+#if CK_PLATFORM_WIN 
+    DWORD result = WaitForSingleObject(m_event, (DWORD) timeoutMs);
+#else // CK_PLATFORM_WP8
+    DWORD result = WaitForSingleObjectEx(m_event, (DWORD) timeoutMs, FALSE);
+#endif
+    CK_ASSERT(result == WAIT_OBJECT_0 || result == WAIT_TIMEOUT);
+
+    m_waitersMutex.lock();
+    --m_waiters;
+    m_waitersMutex.unlock();
+
+    mutex.lock();
+    return result == WAIT_OBJECT_0;
+#else
+    // pthread_cond_timedwait() takes an absolute time
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    long nsec = now.tv_usec * 1000L + (timeoutMs % 1000) * 1000000L;
+    struct timespec abstime;
+    abstime.tv_sec = now.tv_sec + timeoutMs / 1000 + nsec / 1000000000L;
+    abstime.tv_nsec = nsec % 1000000000L;
+
+    int result = pthread_cond_timedwait(&m_cond, &mutex.m_mutex, &abstime);
+    CK_ASSERT(result == 0 || result == ETIMEDOUT);
+    return result == 0;
+#endif
+}
+
 void Cond::signal()
 {
 #if CK_PLATFORM_WIN || CK_PLATFORM_WP8
@@ -43,6 +43,7 @@ public:
     ~Cond();
 
     void wait(Mutex&);
+    bool wait(Mutex&, int timeoutMs); // returns false if timed out
     void signal();
 
 private:
@@ -0,0 +1,119 @@
+#include "ck/core/filemapping.h"
+#include "ck/core/path.h"
+#include "ck/core/debug.h"
+
+// Not built on WP8, which has no file mapping; Bank::newBankMapped() loads the
+// bank there instead.
+
+#if !CK_PLATFORM_WIN
+#  include <sys/mman.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+namespace Cki
+{
+
+
+FileMapping::FileMapping(const char* path, int offset, int length) :
+    m_base(NULL),
+    m_baseOffset(0),
+    m_size(0)
+#if CK_PLATFORM_WIN
+    ,m_file(INVALID_HANDLE_VALUE)
+    ,m_mapping(NULL)
+#endif
+{
+    CK_ASSERT(offset >= 0);
+    CK_ASSERT(length > 0);
+
+#if CK_PLATFORM_WIN
+    wchar_t wpath[Path::k_maxLen];
+    MultiByteToWideChar(CP_UTF8, 0, path, -1, wpath, Path::k_maxLen);
+    m_file = CreateFileW(wpath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (m_file == INVALID_HANDLE_VALUE)
+    {
+        return;
+    }
+
+    m_mapping = CreateFileMappingW(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!m_mapping)
+    {
+        return;
+    }
+
+    // views must start on an allocation granularity boundary
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    int granularity = (int) info.dwAllocationGranularity;
+    int baseOffset = offset % granularity;
+    m_base = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, offset - baseOffset, length + baseOffset);
+    if (m_base)
+    {
+        m_baseOffset = baseOffset;
+        m_size = length;
+    }
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return;
+    }
+
+    // mappings must start on a page boundary
+    int pageSize = (int) sysconf(_SC_PAGESIZE);
+    int baseOffset = offset % pageSize;
+    void* base = mmap(NULL, length + baseOffset, PROT_READ, MAP_SHARED, fd, offset - baseOffset);
+
+    // the mapping keeps its own reference to the file
+    close(fd);
+
+    if (base != MAP_FAILED)
+    {
+        m_base = base;
+        m_baseOffset = baseOffset;
+        m_size = length;
+    }
+#endif
+}
+
+FileMapping::~FileMapping()
+{
+#if CK_PLATFORM_WIN
+    if (m_base)
+    {
+        UnmapViewOfFile(m_base);
+    }
+    if (m_mapping)
+    {
+        CloseHandle(m_mapping);
+    }
+    if (m_file != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(m_file);
+    }
+#else
+    if (m_base)
+    {
+        munmap(m_base, m_size + m_baseOffset);
+    }
+#endif
+}
+
+bool FileMapping::isValid() const
+{
+    return m_base != NULL;
+}
+
+const void* FileMapping::getData() const
+{
+    return (const byte*) m_base + m_baseOffset;
+}
+
+int FileMapping::getSize() const
+{
+    return m_size;
+}
+
+
+}
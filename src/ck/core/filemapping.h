@@ -0,0 +1,42 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/core/types.h"
+#include "ck/core/allocatable.h"
+#if CK_PLATFORM_WIN
+#  include <windows.h>
+#endif
+
+namespace Cki
+{
+
+
+// Read-only memory mapping of part of a file.  Pages are read in when they
+// are first touched, and are shared with any other process mapping the same file.
+
+class FileMapping : public Allocatable
+{
+public:
+    FileMapping(const char* path, int offset, int length);
+    ~FileMapping();
+
+    bool isValid() const;
+
+    const void* getData() const;
+    int getSize() const;
+
+private:
+    void* m_base;      // start of the mapped view (aligned down from offset)
+    int m_baseOffset;  // offset of the requested data from m_base
+    int m_size;
+#if CK_PLATFORM_WIN
+    HANDLE m_file;
+    HANDLE m_mapping;
+#endif
+
+    FileMapping(const FileMapping&);
+    FileMapping& operator=(const FileMapping&);
+};
+
+
+}
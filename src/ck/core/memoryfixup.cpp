@@ -6,12 +6,37 @@ namespace Cki
 
 MemoryFixup::MemoryFixup(void* buf, int size) :
     m_buf((byte*) buf),
-    m_pos(m_buf),
+    m_bufSize(size),
+    m_image(NULL),
+    m_pos(0),
     m_size(size),
     m_failed(false)
 {}
 
+MemoryFixup::MemoryFixup(void* buf, int bufSize, const void* image, int size) :
+    m_buf((byte*) buf),
+    m_bufSize(bufSize),
+    m_image((const byte*) image),
+    m_pos(0),
+    m_size(size),
+    m_failed(false)
+{
+    CK_ASSERT(bufSize <= size);
+}
+
 void* MemoryFixup::getPointer()
+{
+    if (m_pos < m_bufSize)
+    {
+        return m_buf + m_pos;
+    }
+    else
+    {
+        return (void*) (m_image ? m_image + m_pos : m_buf + m_pos);
+    }
+}
+
+int MemoryFixup::getPos() const
 {
     return m_pos;
 }
@@ -19,11 +44,11 @@ void* MemoryFixup::getPointer()
 void MemoryFixup::advance(int bytes)
 {
     m_pos += bytes;
-//    CK_ASSERT(m_pos <= m_buf + m_size);
-    if (m_pos > m_buf + m_size)
+//    CK_ASSERT(m_pos <= m_size);
+    if (m_pos > m_size || m_pos < 0)
     {
         m_failed = true;
-        m_pos = m_buf + m_size;
+        m_pos = m_size;
     }
 }
 
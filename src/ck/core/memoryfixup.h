@@ -12,9 +12,15 @@ namespace Cki
 class MemoryFixup
 {
 public:
+    // Fix up pointers in place in a memory image.
     MemoryFixup(void* buf, int size);
 
+    // Fix up pointers in a writable copy of the first bufSize bytes of a
+    // read-only memory image; pointers past the copy point into the image.
+    MemoryFixup(void* buf, int bufSize, const void* image, int size);
+
     void* getPointer();
+    int getPos() const;
     void advance(int bytes);
     bool isFailed() const;
 
@@ -33,7 +39,7 @@ public:
     inline
     void fixup(T& value)
     {
-        if (m_buf == m_pos)
+        if (m_pos == 0)
         {
             m_pos += sizeof(T);
         }
@@ -45,7 +51,9 @@ public:
 
 private:
     byte* m_buf;
-    byte* m_pos;
+    int m_bufSize;
+    const byte* m_image; // NULL if fixing up in place
+    int m_pos;
     int m_size;
     bool m_failed;
 
@@ -19,6 +19,7 @@
 
 #undef CK_ARM_NEON
 #undef CK_X86_SSE
+#undef CK_X86_AVX2
 
 #undef CK_32_BIT
 #undef CK_64_BIT
@@ -75,6 +76,12 @@
 #  define CK_X86_SSE 1
 #endif
 
+#if CK_X86_SSE && (__AVX2__ || (defined(_MSC_VER) && _MSC_VER >= 1700))
+// Note that with GCC and clang, this will only be defined in compilation units with .avx2 in
+// their name; Visual Studio allows AVX2 intrinsics anywhere.
+#  define CK_X86_AVX2 1
+#endif
+
 // consistency checks
 #if !CK_DEBUG && !CK_NDEBUG
 #  error "Either CK_DEBUG or CK_NDEBUG must be set!"
@@ -129,6 +136,13 @@
 #  define CK_ANDROID_ONLY(x)
 #endif
 
+// thread-local storage, for pointers and other POD types only
+#if CK_PLATFORM_WIN || CK_PLATFORM_WP8
+#  define CK_THREAD_LOCAL __declspec(thread)
+#else
+#  define CK_THREAD_LOCAL __thread
+#endif
+
 // for forward declaration in Objective-C++ files
 #ifdef __OBJC__
 #  define CK_DECLARE_CLASS @class
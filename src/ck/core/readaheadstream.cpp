@@ -0,0 +1,107 @@
+#include "ck/core/readaheadstream.h"
+#include "ck/core/debug.h"
+#include "ck/core/math.h"
+#include "ck/core/mem.h"
+
+namespace Cki
+{
+
+
+ReadAheadStream::ReadAheadStream(BinaryStream& stream, int chunkBytes) :
+    m_stream(stream),
+    m_buf(NULL),
+    m_chunkBytes(chunkBytes),
+    m_bufStart(0),
+    m_bufBytes(0),
+    m_pos(stream.getPos())
+{
+    CK_ASSERT(chunkBytes > 0);
+}
+
+ReadAheadStream::~ReadAheadStream()
+{
+    Mem::free(m_buf);
+}
+
+bool ReadAheadStream::isValid() const
+{
+    return m_stream.isValid();
+}
+
+int ReadAheadStream::read(void* buf, int bytes)
+{
+    CK_ASSERT(buf);
+    CK_ASSERT(bytes >= 0);
+
+    byte* dst = (byte*) buf;
+    int totalBytesRead = 0;
+    while (totalBytesRead < bytes)
+    {
+        if (m_pos < m_bufStart || m_pos >= m_bufStart + m_bufBytes)
+        {
+            // refill from the current position
+            if (!m_buf)
+            {
+                m_buf = (byte*) Mem::alloc(m_chunkBytes);
+                if (!m_buf)
+                {
+                    // fall back to reading directly
+                    m_stream.setPos(m_pos);
+                    int bytesRead = m_stream.read(dst, bytes - totalBytesRead);
+                    m_pos += bytesRead;
+                    return totalBytesRead + bytesRead;
+                }
+            }
+
+            if (m_stream.getPos() != m_pos)
+            {
+                m_stream.setPos(m_pos);
+            }
+            m_bufStart = m_pos;
+            m_bufBytes = m_stream.read(m_buf, m_chunkBytes);
+            if (m_bufBytes <= 0)
+            {
+                m_bufBytes = 0;
+                break;
+            }
+        }
+
+        int offset = m_pos - m_bufStart;
+        int bytesToCopy = Math::min(bytes - totalBytesRead, m_bufBytes - offset);
+        Mem::copy(dst, m_buf + offset, bytesToCopy);
+        dst += bytesToCopy;
+        m_pos += bytesToCopy;
+        totalBytesRead += bytesToCopy;
+    }
+
+    return totalBytesRead;
+}
+
+int ReadAheadStream::write(const void* buf, int bytes)
+{
+    return 0; // read-only!
+}
+
+int ReadAheadStream::getSize() const
+{
+    return m_stream.getSize();
+}
+
+int ReadAheadStream::getPos() const
+{
+    return m_pos;
+}
+
+void ReadAheadStream::setPos(int pos)
+{
+    m_pos = Math::clamp(pos, 0, getSize());
+}
+
+void ReadAheadStream::close()
+{
+    m_stream.close();
+}
+
+
+
+}
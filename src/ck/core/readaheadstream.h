@@ -0,0 +1,41 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/core/binarystream.h"
+
+namespace Cki
+{
+
+
+// Read-only stream that reads from another stream in large chunks, so that
+// many small sequential reads (e.g. by a decoder) turn into a few large ones.
+// Seeking within the current chunk does not touch the underlying stream.
+class ReadAheadStream : public BinaryStream
+{
+public:
+    ReadAheadStream(BinaryStream&, int chunkBytes);
+    virtual ~ReadAheadStream();
+
+    // BinaryStream overrides
+    virtual bool isValid() const;
+    virtual int read(void* buf, int bytes);
+    virtual int write(const void* buf, int bytes);
+    virtual int getSize() const;
+    virtual int getPos() const;
+    virtual void setPos(int pos);
+    virtual void close();
+
+private:
+    BinaryStream& m_stream;
+    byte* m_buf;       // allocated on first read
+    int m_chunkBytes;
+    int m_bufStart;    // stream position of m_buf[0]
+    int m_bufBytes;    // valid bytes in m_buf
+    int m_pos;
+
+    ReadAheadStream(const ReadAheadStream&);
+    ReadAheadStream& operator=(const ReadAheadStream&);
+};
+
+
+}
@@ -36,6 +36,7 @@ public:
     static int getSize(const char* path, CkPathType = kCkPathType_Default); // -1 if file does not exist
 
     static void setFileHandler(CkCustomFileFunc, void*);
+    static bool hasFileHandler() { return s_handler != NULL; }
 
 private:
     BinaryStream* m_stream;
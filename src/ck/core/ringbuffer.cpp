@@ -2,25 +2,21 @@
 #include "ck/core/debug.h"
 #include "ck/core/math.h"
 #include "ck/core/mem.h"
-#include "ck/core/mutexlock.h"
 #include <memory.h>
 
 namespace Cki
 {
 
 // Writes and reads can happen on different threads; at worst we will read
-// or write less than possible.  The one value currently protected by a mutex
-// is m_stored, which is updated by both reads and writes.
-
-// (Could instead keep separate counts of bytes read & written, but we could
-// potentially overflow; is there some lock-free way to do this?)
+// or write less than possible.  Each side only stores to its own position,
+// and loads the other's with acquire semantics, so no lock is needed as long
+// as there is at most one reader and one writer.
 
 RingBuffer::RingBuffer() :
     m_buf(NULL),
     m_bufSize(0),
     m_readPos(0),
     m_writePos(0),
-    m_stored(0),
     m_reading(false),
     m_writing(false)
 {
@@ -31,7 +27,6 @@ RingBuffer::RingBuffer(int bytes) :
     m_bufSize(0),
     m_readPos(0),
     m_writePos(0),
-    m_stored(0),
     m_reading(false),
     m_writing(false)
 {
@@ -105,38 +100,23 @@ void RingBuffer::beginRead(int bytes, const void*& buf1, int& bytes1, const void
     CK_ASSERT(!m_reading);
     m_reading = true;
 
-    // cache write pos, since another thread might be writing
-    int writePos = m_writePos;
+    // data up to the write position is visible once we've loaded it
+    int32 readPos = m_readPos;
+    int32 writePos = Atomic::loadAcquire(&m_writePos);
+    int available = Math::min(getStored(readPos, writePos), bytes);
 
-    if (m_stored == 0)
+    if (available == 0)
     {
         buf1 = buf2 = NULL;
         bytes1 = bytes2 = 0;
     }
     else
     {
-        if (writePos > m_readPos)
-        {
-            buf1 = m_buf + m_readPos;
-            bytes1 = Math::min(writePos - m_readPos, bytes);
-            buf2 = NULL;
-            bytes2 = 0;
-        }
-        else
-        {
-            buf1 = m_buf + m_readPos;
-            bytes1 = Math::min(m_bufSize - m_readPos, bytes);
-            if (bytes > bytes1)
-            {
-                buf2 = m_buf;
-                bytes2 = Math::min(writePos, bytes - bytes1);
-            }
-            else
-            {
-                buf2 = NULL;
-                bytes2 = 0;
-            }
-        }
+        byte* p = getPtr(readPos);
+        buf1 = p;
+        bytes1 = Math::min((int) (m_buf + m_bufSize - p), available);
+        bytes2 = available - bytes1;
+        buf2 = bytes2 ? m_buf : NULL;
     }
 }
 
@@ -145,18 +125,8 @@ void RingBuffer::endRead(int bytes)
     CK_ASSERT(m_reading);
     m_reading = false;
 
-    m_readPos += bytes;
-    if (m_readPos >= m_bufSize)
-    {
-        m_readPos -= m_bufSize;
-    }
-    CK_ASSERT(m_readPos >= 0 && m_readPos <= m_bufSize);
-
-    {
-        MutexLock lock(m_storedMutex);
-        m_stored -= bytes;
-    }
-    CK_ASSERT(m_stored >= 0 && m_stored <= m_bufSize);
+    CK_ASSERT(bytes >= 0 && bytes <= getStoredBytes());
+    Atomic::storeRelease(&m_readPos, advance(m_readPos, bytes));
 }
 
 void RingBuffer::beginWrite(int bytes, void*& buf1, int& bytes1, void*&buf2, int& bytes2)
@@ -165,38 +135,23 @@ void RingBuffer::beginWrite(int bytes, void*& buf1, int& bytes1, void*&buf2, int
     CK_ASSERT(!m_writing);
     m_writing = true;
 
-    // cache read pos, since another thread might be reading
-    int readPos = m_readPos;
+    // space up to the read position has been released by the reader once we've loaded it
+    int32 writePos = m_writePos;
+    int32 readPos = Atomic::loadAcquire(&m_readPos);
+    int available = Math::min(m_bufSize - getStored(readPos, writePos), bytes);
 
-    if (m_stored == m_bufSize)
+    if (available == 0)
     {
         buf1 = buf2 = NULL;
         bytes1 = bytes2 = 0;
     }
     else
     {
-        if (readPos > m_writePos)
-        {
-            buf1 = m_buf + m_writePos;
-            bytes1 = Math::min(readPos - m_writePos, bytes);
-            buf2 = NULL;
-            bytes2 = 0;
-        }
-        else
-        {
-            buf1 = m_buf + m_writePos;
-            bytes1 = Math::min(m_bufSize - m_writePos, bytes);
-            if (bytes > bytes1)
-            {
-                bytes2 = Math::min(readPos, bytes - bytes1);
-                buf2 = bytes2 ? m_buf : NULL;
-            }
-            else
-            {
-                buf2 = NULL;
-                bytes2 = 0;
-            }
-        }
+        byte* p = getPtr(writePos);
+        buf1 = p;
+        bytes1 = Math::min((int) (m_buf + m_bufSize - p), available);
+        bytes2 = available - bytes1;
+        buf2 = bytes2 ? m_buf : NULL;
     }
 }
 
@@ -205,40 +160,20 @@ void RingBuffer::endWrite(int bytes)
     CK_ASSERT(m_writing);
     m_writing = false;
 
-    m_writePos += bytes;
-    if (m_writePos >= m_bufSize)
-    {
-        m_writePos -= m_bufSize;
-    }
-    CK_ASSERT(m_writePos >= 0 && m_writePos <= m_bufSize);
-
-    {
-        MutexLock lock(m_storedMutex);
-        m_stored += bytes;
-    }
-    CK_ASSERT(m_stored >= 0 && m_stored <= m_bufSize);
+    CK_ASSERT(bytes >= 0 && bytes <= getFreeBytes());
+    Atomic::storeRelease(&m_writePos, advance(m_writePos, bytes));
 }
 
 void RingBuffer::resetRead()
 {
     CK_ASSERT(!m_reading);
-    m_readPos = m_writePos;
-
-    {
-        MutexLock lock(m_storedMutex);
-        m_stored = 0;
-    }
+    Atomic::storeRelease(&m_readPos, Atomic::loadAcquire(&m_writePos));
 }
 
 void RingBuffer::resetWrite()
 {
     CK_ASSERT(!m_writing);
-    m_writePos = m_readPos;
-
-    {
-        MutexLock lock(m_storedMutex);
-        m_stored = 0;
-    }
+    Atomic::storeRelease(&m_writePos, Atomic::loadAcquire(&m_readPos));
 }
 
 
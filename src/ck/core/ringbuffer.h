@@ -2,12 +2,15 @@
 
 #include "ck/core/platform.h"
 #include "ck/core/types.h"
-#include "ck/core/mutex.h"
+#include "ck/core/atomic.h"
 
 namespace Cki
 {
 
 
+// Single-producer, single-consumer ring buffer.  One thread may read while
+// another writes, without locking; the reader and writer each own one
+// position, and publish it to the other with a release store.
 class RingBuffer
 {
 public:
@@ -41,12 +44,17 @@ public:
 private:
     byte* m_buf;
     int m_bufSize;
-    int m_readPos;
-    int m_writePos;
-    int m_stored;
+
+    // Positions run from 0 to 2*m_bufSize, so that a full buffer can be told
+    // apart from an empty one without a shared count.
+    volatile int32 m_readPos;  // written only by the reader
+    volatile int32 m_writePos; // written only by the writer
     bool m_reading;
     bool m_writing;
-    Mutex m_storedMutex;
+
+    int getStored(int32 readPos, int32 writePos) const;
+    int32 advance(int32 pos, int bytes) const;
+    byte* getPtr(int32 pos) const;
 
     RingBuffer(const RingBuffer&);
     RingBuffer& operator=(const RingBuffer&);
@@ -70,25 +78,45 @@ int RingBuffer::getSize() const
 inline 
 int RingBuffer::getStoredBytes() const 
 {
-    return m_stored; 
+    return getStored(Atomic::loadAcquire(&m_readPos), Atomic::loadAcquire(&m_writePos));
 }
 
 inline 
 int RingBuffer::getFreeBytes() const 
 {
-    return m_bufSize - m_stored; 
+    return m_bufSize - getStoredBytes(); 
 }
 
 inline 
 int RingBuffer::isEmpty() const 
 {
-    return m_stored == 0; 
+    return getStoredBytes() == 0; 
 }
 
 inline 
 int RingBuffer::isFull() const 
 {
-    return m_stored == m_bufSize; 
+    return getStoredBytes() == m_bufSize; 
+}
+
+inline
+int RingBuffer::getStored(int32 readPos, int32 writePos) const
+{
+    int stored = writePos - readPos;
+    return (stored < 0 ? stored + 2 * m_bufSize : stored);
+}
+
+inline
+int32 RingBuffer::advance(int32 pos, int bytes) const
+{
+    pos += bytes;
+    return (pos >= 2 * m_bufSize ? pos - 2 * m_bufSize : pos);
+}
+
+inline
+byte* RingBuffer::getPtr(int32 pos) const
+{
+    return m_buf + (pos >= m_bufSize ? pos - m_bufSize : pos);
 }
 
 
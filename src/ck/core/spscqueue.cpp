@@ -0,0 +1,106 @@
+#include "ck/core/spscqueue.h"
+#include "ck/core/atomic.h"
+#include "ck/core/debug.h"
+#include "ck/core/mem.h"
+
+namespace Cki
+{
+
+// Read and write positions are free-running counters; they are masked to
+// index the buffer, and their (unsigned) difference is the number of stored items.
+
+template <typename T>
+SpscQueue<T>::SpscQueue(int capacity) :
+    m_buf(NULL),
+    m_mask(0),
+    m_write(0),
+    m_stagedWrite(0),
+    m_cachedRead(0),
+    m_highWater(0),
+    m_read(0),
+    m_cachedWrite(0)
+{
+    CK_ASSERT(capacity > 0);
+    uint32 size = 1;
+    while (size < (uint32) capacity)
+    {
+        size <<= 1;
+    }
+    m_mask = size - 1;
+
+    m_buf = (T*) Mem::alloc(sizeof(T) * size, k_cacheLineSize);
+}
+
+template <typename T>
+SpscQueue<T>::~SpscQueue()
+{
+    Mem::free(m_buf);
+}
+
+template <typename T>
+bool SpscQueue<T>::write(const T& t)
+{
+    if (m_stagedWrite - m_cachedRead > m_mask)
+    {
+        // looks full; see if the consumer has made progress
+        m_cachedRead = Atomic::loadAcquire(&m_read);
+        if (m_stagedWrite - m_cachedRead > m_mask)
+        {
+            return false;
+        }
+    }
+
+    m_buf[m_stagedWrite & m_mask] = t;
+    ++m_stagedWrite;
+    return true;
+}
+
+template <typename T>
+void SpscQueue<T>::publish()
+{
+    if (m_stagedWrite != m_write)
+    {
+        Atomic::storeRelease(&m_write, m_stagedWrite);
+
+        m_cachedRead = Atomic::loadAcquire(&m_read);
+        int count = (int) (m_stagedWrite - m_cachedRead);
+        if (count > m_highWater)
+        {
+            m_highWater = count;
+        }
+    }
+}
+
+template <typename T>
+int SpscQueue<T>::getFreeCount() const
+{
+    uint32 read = Atomic::loadAcquire(&m_read);
+    return (int) (m_mask + 1 - (m_stagedWrite - read));
+}
+
+template <typename T>
+bool SpscQueue<T>::consume(T& result)
+{
+    uint32 read = m_read;
+    if (read == m_cachedWrite)
+    {
+        m_cachedWrite = Atomic::loadAcquire(&m_write);
+        if (read == m_cachedWrite)
+        {
+            return false; // queue is empty
+        }
+    }
+
+    result = m_buf[read & m_mask];
+    Atomic::storeRelease(&m_read, read + 1);
+    return true;
+}
+
+template <typename T>
+bool SpscQueue<T>::isEmpty() const
+{
+    return Atomic::loadAcquire(&m_read) == Atomic::loadAcquire(&m_write);
+}
+
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/core/types.h"
+
+namespace Cki
+{
+
+
+// Bounded, wait-free queue for exactly one producer thread and one consumer thread.
+// Writes are staged by the producer and become visible to the consumer only when
+// publish() is called, so a group of items can be handed over together.
+// Neither side ever allocates or blocks; write() fails when the queue is full.
+
+template <typename T>
+class SpscQueue
+{
+public:
+    SpscQueue(int capacity); // rounded up to a power of 2
+    ~SpscQueue();
+
+    // call from producer thread only:
+    bool write(const T&);
+    void publish();
+    int getFreeCount() const;
+    int getHighWater() const { return m_highWater; }
+
+    // call from consumer thread only:
+    bool consume(T& result);
+
+    // call from either thread (result may be stale)
+    bool isEmpty() const;
+    int getCapacity() const { return m_mask + 1; }
+
+private:
+    enum { k_cacheLineSize = 64 };
+
+    // shared, read-only after construction
+    T* m_buf;
+    uint32 m_mask;
+    byte m_pad0[k_cacheLineSize];
+
+    // written by producer
+    volatile uint32 m_write;   // published write position
+    uint32 m_stagedWrite;      // write position including unpublished items
+    uint32 m_cachedRead;       // last read position seen by producer
+    int m_highWater;
+    byte m_pad1[k_cacheLineSize];
+
+    // written by consumer
+    volatile uint32 m_read;
+    uint32 m_cachedWrite;      // last write position seen by consumer
+    byte m_pad2[k_cacheLineSize];
+
+    SpscQueue(const SpscQueue&);
+    SpscQueue& operator=(const SpscQueue&);
+};
+
+
+}
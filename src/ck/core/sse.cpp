@@ -1,10 +1,12 @@
 #include "ck/core/sse.h"
+#include "ck/core/types.h"
 
 #if CK_X86_SSE
 
 #if CK_PLATFORM_WIN || CK_PLATFORM_WP8
 #  include <intrin.h>
-#elif CK_PLATFORM_LINUX
+#  include <immintrin.h>
+#elif CK_PLATFORM_LINUX || CK_PLATFORM_ANDROID || CK_PLATFORM_OSX
 #  include <cpuid.h>
 #endif
 
@@ -50,6 +52,54 @@ namespace Sse
         return false;
 #endif
     }
+
+    bool isAvx2Supported()
+    {
+        uint32 ecx1 = 0; // leaf 1 features
+        uint32 ebx7 = 0; // leaf 7 extended features
+#if CK_PLATFORM_WIN || CK_PLATFORM_WP8
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+        {
+            return false;
+        }
+        __cpuid(info, 1);
+        ecx1 = info[2];
+        __cpuidex(info, 7, 0);
+        ebx7 = info[1];
+#elif CK_PLATFORM_LINUX || CK_PLATFORM_ANDROID || CK_PLATFORM_OSX
+        if (__get_cpuid_max(0, NULL) < 7)
+        {
+            return false;
+        }
+        uint eax, ebx, ecx, edx;
+        __cpuid(1, eax, ebx, ecx, edx);
+        ecx1 = ecx;
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        ebx7 = ebx;
+#else
+        return false;
+#endif
+
+        const uint32 k_fma = 1 << 12;
+        const uint32 k_osxsave = 1 << 27;
+        const uint32 k_avx = 1 << 28;
+        const uint32 k_avx2 = 1 << 5;
+        if ((ecx1 & (k_fma | k_osxsave | k_avx)) != (k_fma | k_osxsave | k_avx) || !(ebx7 & k_avx2))
+        {
+            return false;
+        }
+
+        // the OS must save the XMM and YMM registers on context switches
+#if CK_PLATFORM_WIN || CK_PLATFORM_WP8
+        uint32 xcr0 = (uint32) _xgetbv(0);
+#else
+        uint32 xcr0, xcr0High;
+        __asm__ ("xgetbv" : "=a" (xcr0), "=d" (xcr0High) : "c" (0));
+#endif
+        return (xcr0 & 0x6) == 0x6;
+    }
 }
 
 
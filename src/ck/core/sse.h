@@ -41,6 +41,9 @@ namespace Sse
 
     bool isSupported();
 
+    // AVX2 and FMA, with OS support for saving the 256-bit registers
+    bool isAvx2Supported();
+
 }
 
 
@@ -8,9 +8,13 @@
 #include "ck/core/asyncloader.h"
 #include "ck/core/deletable.h"
 #include "ck/core/system_platform.h"
+#include "ck/core/sse.h"
+#include "ck/core/math.h"
 #include "ck/audio/audio.h"
 #include "ck/audio/audiograph.h"
 #include <time.h>
+#include <stdlib.h>
+#include <string.h>
 
 #if CK_PLATFORM_ANDROID
 #  include "ck/core/assetmanager_android.h"
@@ -23,7 +27,7 @@ namespace Cki
 {
 
 
-bool System::init(CkConfig& config, bool toolMode)
+bool System::init(CkConfig& config, bool toolMode, bool offline)
 {
     bool success = true;
     if (!get())
@@ -60,11 +64,35 @@ bool System::init(CkConfig& config, bool toolMode)
             CK_LOG_ERROR("Config.streamFileUpdateMs set to invalid value (%f); setting to default (%f) instead.", config.streamFileUpdateMs, CkConfig_streamFileUpdateMsDefault);
             config.streamFileUpdateMs = CkConfig_streamFileUpdateMsDefault;
         }
+        if (config.streamPrimeMs <= 0.0f)
+        {
+            CK_LOG_ERROR("Config.streamPrimeMs set to invalid value (%f); setting to default (%f) instead.", config.streamPrimeMs, CkConfig_streamPrimeMsDefault);
+            config.streamPrimeMs = CkConfig_streamPrimeMsDefault;
+        }
+        if (config.streamThreads < 1)
+        {
+            CK_LOG_ERROR("Config.streamThreads set to invalid value (%d); setting to default (%d) instead.", config.streamThreads, CkConfig_streamThreadsDefault);
+            config.streamThreads = CkConfig_streamThreadsDefault;
+        }
         if (config.maxAudioTasks < 10)
         {
             CK_LOG_ERROR("Config.maxAudioTasks set to invalid value (%d); setting to default (%d) instead.", config.maxAudioTasks, CkConfig_maxAudioTasksDefault);
             config.maxAudioTasks = CkConfig_maxAudioTasksDefault;
         }
+        if (config.resampleQuality == kCkResampleQuality_Default)
+        {
+            config.resampleQuality = kCkResampleQuality_Linear;
+        }
+        else if (config.resampleQuality != kCkResampleQuality_Linear && config.resampleQuality != kCkResampleQuality_Sinc)
+        {
+            CK_LOG_ERROR("Config.resampleQuality set to invalid value (%d); setting to default (%d) instead.", config.resampleQuality, kCkResampleQuality_Linear);
+            config.resampleQuality = kCkResampleQuality_Linear;
+        }
+        if (config.maxSimdLevel < kCkSimdLevel_None || config.maxSimdLevel > kCkSimdLevel_Default)
+        {
+            CK_LOG_ERROR("Config.maxSimdLevel set to invalid value (%d); setting to default (%d) instead.", config.maxSimdLevel, kCkSimdLevel_Default);
+            config.maxSimdLevel = kCkSimdLevel_Default;
+        }
 
         SystemPlatform::init(config);
 
@@ -86,9 +114,10 @@ bool System::init(CkConfig& config, bool toolMode)
         CK_LOG_INFO("using %s pipeline %s",
                 (system->m_sampleType == kCkSampleType_Float ? "floating-point" : "fixed-point"),
                 (system->m_config.sampleType != kCkSampleType_Default ? "(overriding default)" : ""));
-        CK_LOG_INFO("SIMD %s", system->m_simd ? "enabled" : "not supported");
+        system->initSimdLevel(config.maxSimdLevel);
 
         system->m_toolMode = toolMode;
+        system->m_offline = offline;
 
         // these may depend on the above calls having already been made:
         success &= Audio::init();
@@ -172,7 +201,9 @@ System::System(const CkConfig& config) :
     m_suspended(false),
     m_simd(false),
     m_toolMode(false),
-    m_sampleType(kCkSampleType_Default)
+    m_offline(false),
+    m_sampleType(kCkSampleType_Default),
+    m_simdLevel(kCkSimdLevel_None)
 {
     if (config.allocFunc && config.freeFunc)
     {
@@ -233,6 +264,60 @@ void System::printSysInfo()
     CK_LOG_INFO("%s %d-bit %s %s", platform, ptrBits, config, byteOrder);
 }
 
+void System::initSimdLevel(CkSimdLevel maxLevel)
+{
+    // m_simd has been set by the platform-specific code
+    CkSimdLevel supported = kCkSimdLevel_None;
+    if (m_simd)
+    {
+        supported = kCkSimdLevel_Basic;
+#if CK_X86_SSE
+        if (Sse::isAvx2Supported())
+        {
+            supported = kCkSimdLevel_Avx2;
+        }
+#endif
+    }
+
+#if !CK_PLATFORM_WP8
+    // for testing other code paths without rebuilding
+    const char* env = getenv("CK_SIMD");
+    if (env && *env)
+    {
+        if (strcmp(env, "none") == 0)
+        {
+            maxLevel = kCkSimdLevel_None;
+        }
+        else if (strcmp(env, "basic") == 0)
+        {
+            maxLevel = kCkSimdLevel_Basic;
+        }
+        else if (strcmp(env, "avx2") == 0)
+        {
+            maxLevel = kCkSimdLevel_Avx2;
+        }
+        else
+        {
+            CK_LOG_WARNING("CK_SIMD set to unknown value \"%s\"; ignoring", env);
+        }
+    }
+#endif
+
+    // kCkSimdLevel_Default is the highest value
+    m_simdLevel = Math::min(supported, maxLevel);
+    m_simd = (m_simdLevel != kCkSimdLevel_None);
+
+#if CK_ARCH_ARM
+    const char* basicName = "NEON";
+#else
+    const char* basicName = "SSE";
+#endif
+    const char* names[] = { "not used", basicName, "AVX2" };
+    CK_LOG_INFO("SIMD %s%s", 
+            (supported == kCkSimdLevel_None ? "not supported" : names[m_simdLevel]),
+            (m_simdLevel < supported ? " (limited by configuration)" : ""));
+}
+
 
 
 }
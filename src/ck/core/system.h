@@ -11,14 +11,16 @@ namespace Cki
 class System 
 {
 public:
-    static bool init(CkConfig&, bool toolMode = false);
+    static bool init(CkConfig&, bool toolMode = false, bool offline = false);
     static System* get();
     static void shutdown();
 
     CkConfig& getConfig();
     bool isToolMode() const { return m_toolMode; }
+    bool isOffline() const { return m_offline; } // rendering only on request; see CkRenderOffline()
     CkSampleType getSampleType() { return m_sampleType; }
     bool isSimdSupported() const { return m_simd; }
+    CkSimdLevel getSimdLevel() const { return m_simdLevel; }
 
     virtual void update();
     virtual void suspend();
@@ -35,8 +37,11 @@ protected:
 
 private:
     void printSysInfo();
+    void initSimdLevel(CkSimdLevel maxLevel);
     bool m_toolMode;
+    bool m_offline;
     CkSampleType m_sampleType;
+    CkSimdLevel m_simdLevel;
 };
 
 
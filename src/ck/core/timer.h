@@ -64,6 +64,8 @@ public:
 
     static uint64 getTick(float msFromNow);
 
+    static float getMsPerTick() { return s_msPerTick; }
+
 private:
     uint64 m_startTick;
     uint64 m_elapsedTicks;
@@ -0,0 +1,1377 @@
+#include "ck/ck.h"
+#include "ck/config.h"
+#include "ck/effectparam.h"
+#include "ck/core/debug.h"
+#include "ck/core/path.h"
+#include "ck/core/math.h"
+#include "ck/core/mem.h"
+#include "ck/core/timer.h"
+#include "ck/core/system.h"
+#include "ck/core/version.h"
+#include "ck/core/fixedpoint.h"
+#include "ck/audio/adpcm.h"
+#include "ck/audio/lossless.h"
+#include "ck/audio/audioutil.h"
+#include "ck/audio/volumematrix.h"
+#include "ck/audio/effectprocessor.h"
+#include "ck/audio/biquadfilterprocessor.h"
+#include "ck/audio/bitcrusherprocessor.h"
+#include "ck/audio/distortionprocessor.h"
+#include "ck/audio/ringmodprocessor.h"
+#include "ck/audio/reverbprocessor.h"
+#include "ck/audio/compressorprocessor.h"
+#include "ck/audio/convolutionprocessor.h"
+#include "ck/audio/impulseresponse.h"
+#include "ck/audio/spatializer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#undef min
+#undef max
+
+using namespace Cki;
+
+// ckbench runs each AudioUtil kernel, each built-in EffectProcessor, and the
+// Spatializer, in every SIMD variant the CPU supports, over a range of buffer
+// sizes.  The output of each variant is checked against the _default variant,
+// and its speed is reported in nanoseconds per output sample.  Results can also be written as
+// JSON, for tracking performance across releases and instruction sets.
+//
+// The exit code is nonzero if any variant does not match _default.
+
+////////////////////////////////////////
+// variants
+
+enum Variant
+{
+    k_default,
+    k_neon,
+    k_sse,
+    k_avx2,
+
+    k_numVariants
+};
+
+const char* g_variantNames[k_numVariants] = { "default", "neon", "sse", "avx2" };
+
+// variants supported by this CPU, and not disabled by the CK_SIMD environment variable
+bool g_variantEnabled[k_numVariants];
+
+#if CK_ARCH_ARM && !(CK_PLATFORM_ANDROID && __ARM_ARCH_5TE__)
+#  define CK_BENCH_NEON 1
+#  define CK_NEON_IMPL(f) AudioUtil::f##_neon
+#else
+#  define CK_BENCH_NEON 0
+#  define CK_NEON_IMPL(f) NULL
+#endif
+
+#if CK_X86_SSE
+#  define CK_BENCH_SSE 1
+#  define CK_SSE_IMPL(f) AudioUtil::f##_sse
+#  define CK_AVX2_IMPL(f) AudioUtil::f##_avx2
+#else
+#  define CK_BENCH_SSE 0
+#  define CK_SSE_IMPL(f) NULL
+#  define CK_AVX2_IMPL(f) NULL
+#endif
+
+// all variants of an AudioUtil function, in Variant order
+#define CK_VARIANTS(f) AudioUtil::f##_default, CK_NEON_IMPL(f), CK_SSE_IMPL(f), NULL
+#define CK_VARIANTS_AVX2(f) AudioUtil::f##_default, CK_NEON_IMPL(f), CK_SSE_IMPL(f), CK_AVX2_IMPL(f)
+
+void initVariants()
+{
+    CkSimdLevel level = System::get()->getSimdLevel();
+    g_variantEnabled[k_default] = true;
+    g_variantEnabled[k_neon] = CK_BENCH_NEON && level >= kCkSimdLevel_Basic;
+    g_variantEnabled[k_sse] = CK_BENCH_SSE && level >= kCkSimdLevel_Basic;
+    g_variantEnabled[k_avx2] = CK_BENCH_SSE && level >= kCkSimdLevel_Avx2;
+}
+
+const char* getSimdLevelName(CkSimdLevel level)
+{
+    switch (level)
+    {
+#if CK_ARCH_ARM
+        case kCkSimdLevel_Basic: return "neon";
+#else
+        case kCkSimdLevel_Basic: return "sse";
+#endif
+        case kCkSimdLevel_Avx2:  return "avx2";
+        default:                 return "none";
+    }
+}
+
+const char* getArchName()
+{
+#if CK_ARCH_ARM && CK_64_BIT
+    return "arm64";
+#elif CK_ARCH_ARM
+    return "arm";
+#elif CK_ARCH_MIPS
+    return "mips";
+#elif CK_64_BIT
+    return "x64";
+#else
+    return "x86";
+#endif
+}
+
+////////////////////////////////////////
+// buffers
+
+// Every kernel writes the requested number of samples to g_out; inputs are
+// long enough for resampling, with room to spare.
+enum { k_guardSamples = 16 };
+
+// Kernels that work in whole blocks round each size up to a multiple of their
+// block size, which adds at most this many samples.
+enum
+{
+    k_adpcmBlockSamples = Adpcm::k_samplesPerBlock * 2,
+    k_convolutionBlockSamples = ConvolutionProcessor::k_headBlockFrames * 2,
+    k_losslessBlockSamples = Lossless::k_blockFrames * 2,
+    k_maxBlockSamples = k_losslessBlockSamples
+};
+CK_STATIC_ASSERT(k_maxBlockSamples >= k_adpcmBlockSamples && k_maxBlockSamples >= k_convolutionBlockSamples);
+const uint8 k_guardByte = 0xcd;
+
+int g_maxSamples = 0;
+float* g_inF32 = NULL;
+int32* g_inI32 = NULL;
+int16* g_inI16 = NULL;
+int8* g_inI8 = NULL;
+void* g_out = NULL;
+void* g_ref = NULL;
+
+template <typename T> const T* getInput();
+template <> const float* getInput<float>() { return g_inF32; }
+template <> const int32* getInput<int32>() { return g_inI32; }
+template <> const int16* getInput<int16>() { return g_inI16; }
+template <> const int8* getInput<int8>() { return g_inI8; }
+
+int getInputSamples()
+{
+    return g_maxSamples * 2 + AudioUtil::k_sincTaps * 4;
+}
+
+void initBuffers(int maxSamples)
+{
+    g_maxSamples = maxSamples;
+
+    int inSamples = getInputSamples();
+    g_inF32 = Mem::allocArray<float>(inSamples, 32);
+    g_inI32 = Mem::allocArray<int32>(inSamples, 32);
+    g_inI16 = Mem::allocArray<int16>(inSamples, 32);
+    g_inI8 = Mem::allocArray<int8>(inSamples, 32);
+
+    int outBytes = (maxSamples + k_guardSamples) * sizeof(float);
+    g_out = Mem::alloc(outBytes, 32);
+    g_ref = Mem::alloc(outBytes, 32);
+
+    // two tones plus noise, peaking a little below full scale
+    uint32 seed = 12345;
+    for (int i = 0; i < inSamples; ++i)
+    {
+        seed = seed * 1664525 + 1013904223;
+        float noise = (float) (seed >> 8) / (1 << 24) * 2.0f - 1.0f;
+        float value = 0.4f * ::sinf(i * 0.031f) + 0.3f * ::sinf(i * 0.47f) + 0.2f * noise;
+
+        g_inF32[i] = value;
+        g_inI32[i] = Fixed8_24::fromFloat(value);
+        g_inI16[i] = (int16) (value * 32767.0f);
+        g_inI8[i] = (int8) (value * 127.0f);
+    }
+}
+
+void shutdownBuffers()
+{
+    Mem::free(g_inF32);
+    Mem::free(g_inI32);
+    Mem::free(g_inI16);
+    Mem::free(g_inI8);
+    Mem::free(g_out);
+    Mem::free(g_ref);
+}
+
+template <typename T>
+void copyInput(T* outBuf, int offset, int samples)
+{
+    Mem::copy(outBuf, getInput<T>() + offset, samples * sizeof(T));
+}
+
+inline float toFloat(float value) { return value; }
+inline float toFloat(int32 value) { return Fixed8_24::toFloat(value); }
+inline float toFloat(int16 value) { return value * (1.0f / 32768.0f); }
+
+////////////////////////////////////////
+// sinc filter tables
+
+// Hann-windowed sinc, in the layout described in audioutil.h.  This is not the
+// filter Resampler uses, but is close enough for timing and comparison.
+float* g_sincTableF32 = NULL;
+int32* g_sincTableI32 = NULL;
+
+template <typename T> const T* getSincTable();
+template <> const float* getSincTable<float>() { return g_sincTableF32; }
+template <> const int32* getSincTable<int32>() { return g_sincTableI32; }
+
+void initSincTables()
+{
+    const int taps = AudioUtil::k_sincTaps;
+    const int phases = AudioUtil::k_sincPhases;
+    const int center = taps/2 - 1;
+
+    g_sincTableF32 = Mem::allocArray<float>(phases * taps * 2, 32);
+    g_sincTableI32 = Mem::allocArray<int32>(phases * taps * 2, 32);
+
+    for (int p = 0; p < phases; ++p)
+    {
+        for (int j = 0; j < taps; ++j)
+        {
+            double coef[2];
+            for (int k = 0; k < 2; ++k)
+            {
+                double x = j - center - (double) (p + k) / phases;
+                double window = 0.5 + 0.5 * ::cos(Math::k_pi * x / (taps/2));
+                double arg = 0.88 * x;
+                double sinc = (arg == 0.0) ? 1.0 : ::sin(Math::k_pi * arg) / (Math::k_pi * arg);
+                coef[k] = 0.88 * sinc * window;
+            }
+
+            int index = p * taps * 2 + j;
+            g_sincTableF32[index] = (float) coef[0];
+            g_sincTableF32[index + taps] = (float) (coef[1] - coef[0]);
+            g_sincTableI32[index] = (int32) ::floor(coef[0] * (1 << 30) + 0.5);
+            g_sincTableI32[index + taps] = (int32) ::floor((coef[1] - coef[0]) * (1 << 30) + 0.5);
+        }
+    }
+}
+
+void shutdownSincTables()
+{
+    Mem::free(g_sincTableF32);
+    Mem::free(g_sincTableI32);
+}
+
+////////////////////////////////////////
+// kernels
+
+class Kernel
+{
+public:
+    Kernel(const char* name, bool isFloat) : m_name(name), m_float(isFloat) {}
+    virtual ~Kernel() {}
+
+    const char* getName() const { return m_name; }
+    bool isFloat() const { return m_float; }
+
+    virtual bool hasVariant(int variant) const = 0;
+
+    // Output is produced this many samples at a time; sizes are rounded up to
+    // a multiple of it, so every sample run is a sample produced.
+    virtual int getBlockSamples() const { return 1; }
+
+    // restore any input or state that run() changes
+    virtual void prepare(int samples) {}
+
+    // Write samples output samples to g_out with the given variant.
+    // Returns the kernel's return value, if any, which must also match.
+    virtual int run(int variant, int samples) = 0;
+
+    virtual int getSampleSize() const = 0;
+
+    // largest difference between two outputs, as a fraction of full scale
+    virtual float getError(const void* a, const void* b, int samples) const = 0;
+
+private:
+    const char* m_name;
+    bool m_float;
+};
+
+template <typename Out>
+class KernelOut : public Kernel
+{
+public:
+    KernelOut(const char* name, bool isFloat) : Kernel(name, isFloat) {}
+
+    virtual int getSampleSize() const { return sizeof(Out); }
+
+    virtual float getError(const void* a, const void* b, int samples) const
+    {
+        const Out* pa = (const Out*) a;
+        const Out* pb = (const Out*) b;
+        float error = 0.0f;
+        for (int i = 0; i < samples; ++i)
+        {
+            if (pa[i] != pb[i])
+            {
+                // NaN compares unequal to everything, so counts as a full mismatch
+                float diff = Math::abs(toFloat(pa[i]) - toFloat(pb[i]));
+                error = (diff == diff) ? Math::max(error, diff) : 1.0e9f;
+            }
+        }
+        return error;
+    }
+};
+
+template <typename Func, typename Out>
+class FuncKernel : public KernelOut<Out>
+{
+public:
+    FuncKernel(const char* name, bool isFloat, Func f0, Func f1, Func f2, Func f3) :
+        KernelOut<Out>(name, isFloat)
+    {
+        m_funcs[k_default] = f0;
+        m_funcs[k_neon] = f1;
+        m_funcs[k_sse] = f2;
+        m_funcs[k_avx2] = f3;
+    }
+
+    virtual bool hasVariant(int variant) const { return m_funcs[variant] != NULL; }
+
+protected:
+    Func m_funcs[k_numVariants];
+};
+
+template <typename In, typename Out>
+class ConvertKernel : public FuncKernel<void (*)(const In*, Out*, int), Out>
+{
+public:
+    typedef void (*Func)(const In*, Out*, int);
+    ConvertKernel(const char* name, bool isFloat, Func f0, Func f1, Func f2, Func f3) :
+        FuncKernel<Func, Out>(name, isFloat, f0, f1, f2, f3) {}
+
+    virtual int run(int variant, int samples)
+    {
+        this->m_funcs[variant](getInput<In>(), (Out*) g_out, samples);
+        return 0;
+    }
+};
+
+template <typename T>
+class MixKernel : public FuncKernel<void (*)(const T* __restrict, T* __restrict, int), T>
+{
+public:
+    typedef void (*Func)(const T* __restrict, T* __restrict, int);
+    MixKernel(const char* name, bool isFloat, Func f0, Func f1, Func f2, Func f3) :
+        FuncKernel<Func, T>(name, isFloat, f0, f1, f2, f3) {}
+
+    virtual void prepare(int samples)
+    {
+        copyInput((T*) g_out, 100, samples);
+    }
+
+    virtual int run(int variant, int samples)
+    {
+        this->m_funcs[variant](getInput<T>(), (T*) g_out, samples);
+        return 0;
+    }
+};
+
+template <typename T>
+class MixVolKernel : public FuncKernel<void (*)(const T* __restrict, float, T* __restrict, float, int), T>
+{
+public:
+    typedef void (*Func)(const T* __restrict, float, T* __restrict, float, int);
+    MixVolKernel(const char* name, bool isFloat, Func f0, Func f1, Func f2, Func f3) :
+        FuncKernel<Func, T>(name, isFloat, f0, f1, f2, f3) {}
+
+    virtual void prepare(int samples)
+    {
+        copyInput((T*) g_out, 100, samples);
+    }
+
+    virtual int run(int variant, int samples)
+    {
+        this->m_funcs[variant](getInput<T>(), 0.7f, (T*) g_out, 0.4f, samples);
+        return 0;
+    }
+};
+
+template <typename T>
+class ToStereoKernel : public FuncKernel<void (*)(const T*, T*, int), T>
+{
+public:
+    typedef void (*Func)(const T*, T*, int);
+    ToStereoKernel(const char* name, bool isFloat, Func f0, Func f1, Func f2, Func f3) :
+        FuncKernel<Func, T>(name, isFloat, f0, f1, f2, f3) {}
+
+    virtual int run(int variant, int samples)
+    {
+        this->m_funcs[variant](getInput<T>(), (T*) g_out, samples/2);
+        return 0;
+    }
+};
+
+template <typename T>
+class ScaleKernel : public FuncKernel<void (*)(const T*, T*, int, float), T>
+{
+public:
+    typedef void (*Func)(const T*, T*, int, float);
+
+    // if stereo, converts mono to stereo while scaling
+    ScaleKernel(const char* name, bool isFloat, bool stereo, Func f0, Func f1, Func f2, Func f3) :
+        FuncKernel<Func, T>(name, isFloat, f0, f1, f2, f3),
+        m_stereo(stereo)
+    {}
+
+    virtual int run(int variant, int samples)
+    {
+        this->m_funcs[variant](getInput<T>(), (T*) g_out, m_stereo ? samples/2 : samples, 0.8f);
+        return 0;
+    }
+
+private:
+    bool m_stereo;
+};
+
+// pan matrices, and the volume rate for ramps
+const VolumeMatrix k_panVolume(0.5f, 0.25f, 0.25f, 0.75f);
+const VolumeMatrix k_panStartVolume(1.0f, 0.0f, 0.0f, 1.0f);
+
+// The SIMD versions round ramp lengths down to multiples of 4 frames, so the
+// ramp for each matrix element is an exact power of 2 frames long (at least
+// 4), and the longest one fills as much of the buffer as possible.
+float getPanRate(int frames)
+{
+    int rampFrames = 8;
+    while (rampFrames * 2 <= frames)
+    {
+        rampFrames *= 2;
+    }
+    return 0.5f / rampFrames;
+}
+
+template <typename T>
+class StereoPanKernel : public FuncKernel<void (*)(T*, int, const VolumeMatrix&), T>
+{
+public:
+    typedef void (*Func)(T*, int, const VolumeMatrix&);
+    StereoPanKernel(const char* name, bool isFloat, Func f0, Func f1, Func f2, Func f3) :
+        FuncKernel<Func, T>(name, isFloat, f0, f1, f2, f3) {}
+
+    virtual void prepare(int samples)
+    {
+        copyInput((T*) g_out, 0, samples);
+    }
+
+    virtual int run(int variant, int samples)
+    {
+        this->m_funcs[variant]((T*) g_out, samples/2, k_panVolume);
+        return 0;
+    }
+};
+
+template <typename T>
+class StereoPanRampKernel : public FuncKernel<int (*)(T*, int, const VolumeMatrix&, VolumeMatrix&, float), T>
+{
+public:
+    typedef int (*Func)(T*, int, const VolumeMatrix&, VolumeMatrix&, float);
+    StereoPanRampKernel(const char* name, bool isFloat, Func f0, Func f1, Func f2, Func f3) :
+        FuncKernel<Func, T>(name, isFloat, f0, f1, f2, f3) {}
+
+    virtual void prepare(int samples)
+    {
+        copyInput((T*) g_out, 0, samples);
+        m_volume = k_panStartVolume;
+    }
+
+    virtual int run(int variant, int samples)
+    {
+        int frames = samples/2;
+        return this->m_funcs[variant]((T*) g_out, frames, k_panVolume, m_volume, getPanRate(frames));
+    }
+
+private:
+    VolumeMatrix m_volume;
+};
+
+template <typename T>
+class MonoPanKernel : public FuncKernel<void (*)(const T*, T*, int, const VolumeMatrix&), T>
+{
+public:
+    typedef void (*Func)(const T*, T*, int, const VolumeMatrix&);
+    MonoPanKernel(const char* name, bool isFloat, Func f0, Func f1, Func f2, Func f3) :
+        FuncKernel<Func, T>(name, isFloat, f0, f1, f2, f3) {}
+
+    virtual int run(int variant, int samples)
+    {
+        this->m_funcs[variant](getInput<T>(), (T*) g_out, samples/2, k_panVolume);
+        return 0;
+    }
+};
+
+template <typename T>
+class MonoPanRampKernel : public FuncKernel<int (*)(const T*, T*, int, const VolumeMatrix&, VolumeMatrix&, float), T>
+{
+public:
+    typedef int (*Func)(const T*, T*, int, const VolumeMatrix&, VolumeMatrix&, float);
+    MonoPanRampKernel(const char* name, bool isFloat, Func f0, Func f1, Func f2, Func f3) :
+        FuncKernel<Func, T>(name, isFloat, f0, f1, f2, f3) {}
+
+    virtual void prepare(int samples)
+    {
+        m_volume = k_panStartVolume;
+    }
+
+    virtual int run(int variant, int samples)
+    {
+        int frames = samples/2;
+        return this->m_funcs[variant](getInput<T>(), (T*) g_out, frames, k_panVolume, m_volume, getPanRate(frames));
+    }
+
+private:
+    VolumeMatrix m_volume;
+};
+
+// resampling kernels downsample by this factor
+const float k_resampleFactor = 1.25f;
+
+template <typename T>
+class ResampleKernel : public FuncKernel<void (*)(const T*, int, T*, int, T*), T>
+{
+public:
+    typedef void (*Func)(const T*, int, T*, int, T*);
+    ResampleKernel(const char* name, bool isFloat, int channels, Func f0, Func f1, Func f2, Func f3) :
+        FuncKernel<Func, T>(name, isFloat, f0, f1, f2, f3),
+        m_channels(channels)
+    {}
+
+    virtual void prepare(int samples)
+    {
+        copyInput(m_lastInput, 0, 2);
+    }
+
+    virtual int run(int variant, int samples)
+    {
+        int outFrames = samples / m_channels;
+        int inFrames = (int) (outFrames * k_resampleFactor);
+        this->m_funcs[variant](getInput<T>(), inFrames, (T*) g_out, outFrames, m_lastInput);
+        return 0;
+    }
+
+private:
+    int m_channels;
+    T m_lastInput[2];
+};
+
+template <typename T>
+class SincKernel : public FuncKernel<void (*)(const T*, T*, int, float, float, const T*), T>
+{
+public:
+    typedef void (*Func)(const T*, T*, int, float, float, const T*);
+    SincKernel(const char* name, bool isFloat, int channels, Func f0, Func f1, Func f2, Func f3) :
+        FuncKernel<Func, T>(name, isFloat, f0, f1, f2, f3),
+        m_channels(channels)
+    {}
+
+    virtual int run(int variant, int samples)
+    {
+        this->m_funcs[variant](getInput<T>(), (T*) g_out, samples / m_channels, 0.3f, k_resampleFactor, getSincTable<T>());
+        return 0;
+    }
+
+private:
+    int m_channels;
+};
+
+template <typename T>
+class ClampKernel : public FuncKernel<bool (*)(const T*, T*, int), T>
+{
+public:
+    typedef bool (*Func)(const T*, T*, int);
+    ClampKernel(const char* name, bool isFloat, Func f0, Func f1, Func f2, Func f3) :
+        FuncKernel<Func, T>(name, isFloat, f0, f1, f2, f3) {}
+
+    // in place, as used by the mixer, with some samples out of range
+    virtual void prepare(int samples)
+    {
+        T* out = (T*) g_out;
+        const T* in = getInput<T>();
+        for (int i = 0; i < samples; ++i)
+        {
+            out[i] = in[i] + in[i]/2;
+        }
+    }
+
+    virtual int run(int variant, int samples)
+    {
+        return this->m_funcs[variant]((T*) g_out, (T*) g_out, samples);
+    }
+};
+
+// Decodes whole ADPCM blocks.  The input is encoded once, cycling through the
+// predictors.
+template <typename T>
+class AdpcmKernel : public KernelOut<T>
+{
+public:
+    AdpcmKernel(const char* name, bool isFloat, int channels) :
+        KernelOut<T>(name, isFloat),
+        m_channels(channels)
+    {
+        int frames = g_maxSamples / channels;
+        int blocks = frames / Adpcm::k_samplesPerBlock + 1;
+        m_encoded = Mem::allocArray<byte>(blocks * Adpcm::k_bytesPerBlock * channels);
+
+        byte* out = m_encoded;
+        int delta[2] = { 16, 16 };
+        for (int block = 0; block < blocks; ++block)
+        {
+            int predictor = block % Adpcm::getNumPredictors();
+            const int16* in = g_inI16 + block * Adpcm::k_samplesPerBlock * channels;
+            for (int channel = 0; channel < channels; ++channel)
+            {
+                out += Adpcm::encode(in + channel, Adpcm::k_samplesPerBlock, channels, out, predictor, delta[channel]);
+            }
+        }
+    }
+
+    virtual ~AdpcmKernel()
+    {
+        Mem::free(m_encoded);
+    }
+
+    virtual bool hasVariant(int variant) const
+    {
+        return variant == k_default || (variant == k_sse && CK_BENCH_SSE);
+    }
+
+    virtual int getBlockSamples() const { return Adpcm::k_samplesPerBlock * m_channels; }
+
+    virtual int run(int variant, int samples)
+    {
+        typedef void (*Func)(const byte*, int, int, T*);
+        Func func = (variant == k_sse ? (Func) Adpcm::decodeBlocks_sse : (Func) Adpcm::decodeBlocks_default);
+        func(m_encoded, samples / (Adpcm::k_samplesPerBlock * m_channels), m_channels, (T*) g_out);
+        return 0;
+    }
+
+private:
+    int m_channels;
+    byte* m_encoded;
+};
+
+// Encodes blocks of the input in lossless format; returns the number of bytes
+// written to output, which must have room for getMaxBlockBytes() per block.
+int encodeLossless(int channels, int blocks, byte* output)
+{
+    byte* out = output;
+    for (int block = 0; block < blocks; ++block)
+    {
+        const int16* in = g_inI16 + block * Lossless::k_blockFrames * channels;
+        out += Lossless::encodeBlock(in, channels, out);
+    }
+    return (int) (out - output);
+}
+
+// Decodes whole lossless blocks.  There are no SIMD variants, since decoding is
+// serial.
+template <typename T>
+class LosslessKernel : public KernelOut<T>
+{
+public:
+    LosslessKernel(const char* name, bool isFloat, int channels) :
+        KernelOut<T>(name, isFloat),
+        m_channels(channels)
+    {
+        int blocks = g_maxSamples / (Lossless::k_blockFrames * channels) + 1;
+        m_encoded = Mem::allocArray<byte>(blocks * Lossless::getMaxBlockBytes(channels));
+        encodeLossless(channels, blocks, m_encoded);
+    }
+
+    virtual ~LosslessKernel()
+    {
+        Mem::free(m_encoded);
+    }
+
+    virtual bool hasVariant(int variant) const { return variant == k_default; }
+
+    virtual int getBlockSamples() const { return Lossless::k_blockFrames * m_channels; }
+
+    virtual int run(int variant, int samples)
+    {
+        int blocks = samples / (Lossless::k_blockFrames * m_channels);
+        const byte* in = m_encoded;
+        T* out = (T*) g_out;
+        for (int block = 0; block < blocks; ++block)
+        {
+            in += Lossless::decodeBlock(in, m_channels, out);
+            out += Lossless::k_blockFrames * m_channels;
+        }
+        return 0;
+    }
+
+private:
+    int m_channels;
+    byte* m_encoded;
+};
+
+// Prints the size of the compressed formats relative to 16-bit PCM; lossless
+// compression depends on the input, which is noisier than most sounds.
+void printCompression()
+{
+    const int blocks = 64;
+    const int channels = 2;
+    byte* encoded = Mem::allocArray<byte>(blocks * Lossless::getMaxBlockBytes(channels));
+    int bytes = encodeLossless(channels, blocks, encoded);
+    Mem::free(encoded);
+
+    int pcmBytes = blocks * Lossless::k_blockFrames * channels * sizeof(int16);
+    float adpcmBytesPerSample = (float) Adpcm::k_bytesPerBlock / Adpcm::k_samplesPerBlock;
+    CK_PRINT("compressed size of the input, relative to 16-bit PCM: lossless %.1f%%, adpcm %.1f%%\n\n",
+            100.0f * bytes / pcmBytes, 100.0f * adpcmBytesPerSample / sizeof(int16));
+}
+
+// processes interleaved stereo in place, as effect buses do; processors that
+// only do their work once a block of frames is collected give its size
+template <typename T>
+class EffectKernel : public KernelOut<T>
+{
+public:
+    EffectKernel(const char* name, bool isFloat, EffectProcessor* processor, int blockFrames = 1) :
+        KernelOut<T>(name, isFloat),
+        m_processor(processor),
+        m_blockFrames(blockFrames)
+    {}
+
+    virtual ~EffectKernel()
+    {
+        delete m_processor;
+    }
+
+    virtual bool hasVariant(int variant) const
+    {
+        switch (variant)
+        {
+            case k_default: return true;
+            case k_neon:    return CK_BENCH_NEON;
+            case k_sse:     return CK_BENCH_SSE;
+            default:        return false; // no AVX2 versions
+        }
+    }
+
+    virtual int getBlockSamples() const { return m_blockFrames * 2; }
+
+    virtual void prepare(int samples)
+    {
+        copyInput((T*) g_out, 0, samples);
+        m_processor->reset();
+    }
+
+    virtual int run(int variant, int samples)
+    {
+        typedef void (EffectProcessor::*Func)(T*, T*, int);
+        Func func;
+        switch (variant)
+        {
+            case k_neon: func = &EffectProcessor::process_neon; break;
+            case k_sse:  func = &EffectProcessor::process_sse; break;
+            default:     func = &EffectProcessor::process_default; break;
+        }
+        (m_processor->*func)((T*) g_out, (T*) g_out, samples/2);
+        return 0;
+    }
+
+private:
+    EffectProcessor* m_processor;
+    int m_blockFrames;
+};
+
+EffectProcessor* createBiquad()
+{
+    EffectProcessor* processor = new BiquadFilterProcessor();
+    processor->setParam(kCkBiquadFilterParam_FilterType, kCkBiquadFilterParam_FilterType_LowPass);
+    processor->setParam(kCkBiquadFilterParam_Freq, 2000.0f);
+    processor->setParam(kCkBiquadFilterParam_Q, 2.0f);
+    return processor;
+}
+
+EffectProcessor* createBitCrusher()
+{
+    EffectProcessor* processor = new BitCrusherProcessor();
+    processor->setParam(kCkBitCrusherParam_BitResolution, 8.0f);
+    processor->setParam(kCkBitCrusherParam_HoldMs, 0.5f);
+    return processor;
+}
+
+EffectProcessor* createDistortion()
+{
+    EffectProcessor* processor = new DistortionProcessor();
+    processor->setParam(kCkDistortionParam_Drive, 4.0f);
+    processor->setParam(kCkDistortionParam_Offset, 0.1f);
+    return processor;
+}
+
+EffectProcessor* createRingMod()
+{
+    EffectProcessor* processor = new RingModProcessor();
+    processor->setParam(kCkRingModParam_Freq, 500.0f);
+    return processor;
+}
+
+EffectProcessor* createReverb()
+{
+    EffectProcessor* processor = new ReverbProcessor();
+    processor->setParam(kCkReverbParam_DecayTime, 2.0f);
+    return processor;
+}
+
+EffectProcessor* createCompressor()
+{
+    EffectProcessor* processor = new CompressorProcessor();
+    processor->setParam(kCkCompressorParam_Threshold, -12.0f);
+    processor->setParam(kCkCompressorParam_Ratio, 4.0f);
+    processor->setParam(kCkCompressorParam_TruePeak, 1.0f);
+    return processor;
+}
+
+EffectProcessor* createConvolution()
+{
+    // half a second of exponentially decaying noise, long enough to have a tail
+    const int sampleRate = 48000;
+    const int frames = sampleRate / 2;
+    float* data = (float*) Mem::alloc(frames * 2 * sizeof(float));
+    unsigned int seed = 1;
+    for (int i = 0; i < frames * 2; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        float noise = (float) ((seed >> 16) & 0x7fff) / 0x4000 - 1.0f;
+        data[i] = noise * expf(-6.0f * (i/2) / frames);
+    }
+
+    ImpulseResponse ir;
+    ir.setData(data, frames, 2, sampleRate);
+    Mem::free(data);
+
+    ConvolutionProcessor* processor = new ConvolutionProcessor(ir);
+    CK_ASSERT(processor->isInited());
+    return processor;
+}
+
+// 3D volume, pan, and doppler shift of samples/3 emitters; the outputs are
+// written to g_out one after the other
+class SpatializeKernel : public KernelOut<float>
+{
+public:
+    SpatializeKernel(const char* name) :
+        KernelOut<float>(name, true)
+    {
+        int emitters = g_maxSamples / 3;
+        m_pos = Mem::allocArray<float>(emitters * 6);
+        for (int i = 0; i < emitters * 6; ++i)
+        {
+            m_pos[i] = g_inF32[i] * (i < emitters * 3 ? 60.0f : 30.0f);
+        }
+
+        m_params.set(Vector3(1.0f, 2.0f, 3.0f), Vector3(5.0f, 0.0f, 0.0f),
+                     Vector3(1.0f, 2.0f, 4.0f), Vector3(0.0f, 1.0f, 0.0f),
+                     kCkAttenuationMode_InvDistanceSquared, 1.0f, 100.0f, 0.0f, 340.0f);
+    }
+
+    virtual ~SpatializeKernel()
+    {
+        Mem::free(m_pos);
+    }
+
+    virtual bool hasVariant(int variant) const
+    {
+        switch (variant)
+        {
+            case k_neon: return CK_BENCH_NEON;
+            case k_sse:
+            case k_avx2: return CK_BENCH_SSE;
+            default:     return true;
+        }
+    }
+
+    virtual void prepare(int samples)
+    {
+        Mem::clear(g_out, samples * sizeof(float));
+    }
+
+    virtual int run(int variant, int samples)
+    {
+        int emitters = samples / 3;
+        int stride = g_maxSamples / 3;
+        float* out = (float*) g_out;
+        Spatializer::Emitters e;
+        e.px = m_pos;
+        e.py = m_pos + stride;
+        e.pz = m_pos + stride * 2;
+        e.vx = m_pos + stride * 3;
+        e.vy = m_pos + stride * 4;
+        e.vz = m_pos + stride * 5;
+        e.vol = out;
+        e.pan = out + emitters;
+        e.speed = out + emitters * 2;
+
+        switch (variant)
+        {
+            case k_neon: Spatializer::compute_neon(m_params, e, 0, emitters); break;
+            case k_sse:  Spatializer::compute_sse(m_params, e, 0, emitters); break;
+            case k_avx2: Spatializer::compute_avx2(m_params, e, 0, emitters); break;
+            default:     Spatializer::compute_default(m_params, e, 0, emitters); break;
+        }
+        return 0;
+    }
+
+private:
+    float* m_pos; // positions, then velocities, of each axis
+    Spatializer::Params m_params;
+};
+
+int createKernels(Kernel** kernels)
+{
+    int n = 0;
+
+    // fixed-point pipeline
+    kernels[n++] = new ConvertKernel<float, int32>("convertF32toI32", false, CK_VARIANTS(convertF32toI32));
+    kernels[n++] = new ConvertKernel<int32, float>("convertI32toF32", false, CK_VARIANTS(convertI32toF32));
+    kernels[n++] = new ConvertKernel<int32, int16>("convertI32toI16", false, CK_VARIANTS(convertI32toI16));
+    kernels[n++] = new ConvertKernel<int16, int32>("convertI16toI32", false, CK_VARIANTS(convertI16toI32));
+    kernels[n++] = new ConvertKernel<int8, int32>("convertI8toI32", false, CK_VARIANTS(convertI8toI32));
+    kernels[n++] = new MixKernel<int32>("mix", false, CK_VARIANTS(mix));
+    kernels[n++] = new MixVolKernel<int32>("mixVol", false, CK_VARIANTS(mixVol));
+    kernels[n++] = new ToStereoKernel<int32>("convertToStereo", false, CK_VARIANTS(convertToStereo));
+    kernels[n++] = new ScaleKernel<int32>("convertToStereoScale", false, true, CK_VARIANTS(convertToStereoScale));
+    kernels[n++] = new ScaleKernel<int32>("scale", false, false, CK_VARIANTS(scale));
+    kernels[n++] = new StereoPanKernel<int32>("stereoPan", false, CK_VARIANTS(stereoPan));
+    kernels[n++] = new StereoPanRampKernel<int32>("stereoPanRamp", false, CK_VARIANTS(stereoPanRamp));
+    kernels[n++] = new MonoPanKernel<int32>("monoPan", false, CK_VARIANTS(monoPan));
+    kernels[n++] = new MonoPanRampKernel<int32>("monoPanRamp", false, CK_VARIANTS(monoPanRamp));
+    kernels[n++] = new ResampleKernel<int32>("resampleMono", false, 1, CK_VARIANTS(resampleMono));
+    kernels[n++] = new ResampleKernel<int32>("resampleStereo", false, 2, CK_VARIANTS(resampleStereo));
+    kernels[n++] = new SincKernel<int32>("sincMono", false, 1, CK_VARIANTS(sincMono));
+    kernels[n++] = new SincKernel<int32>("sincStereo", false, 2, CK_VARIANTS(sincStereo));
+    kernels[n++] = new ClampKernel<int32>("clamp", false, CK_VARIANTS(clamp));
+    kernels[n++] = new AdpcmKernel<int32>("adpcmMono", false, 1);
+    kernels[n++] = new AdpcmKernel<int32>("adpcmStereo", false, 2);
+    kernels[n++] = new LosslessKernel<int32>("losslessMono", false, 1);
+    kernels[n++] = new LosslessKernel<int32>("losslessStereo", false, 2);
+    kernels[n++] = new EffectKernel<int32>("biquad", false, createBiquad());
+    kernels[n++] = new EffectKernel<int32>("bitcrusher", false, createBitCrusher());
+    kernels[n++] = new EffectKernel<int32>("distortion", false, createDistortion());
+    kernels[n++] = new EffectKernel<int32>("ringmod", false, createRingMod());
+    kernels[n++] = new EffectKernel<int32>("reverb", false, createReverb());
+    kernels[n++] = new EffectKernel<int32>("compressor", false, createCompressor());
+    kernels[n++] = new EffectKernel<int32>("convolution", false, createConvolution(), ConvolutionProcessor::k_headBlockFrames);
+
+    // floating-point pipeline
+    kernels[n++] = new ConvertKernel<float, int16>("convertF32toI16", true, CK_VARIANTS_AVX2(convertF32toI16));
+    kernels[n++] = new ConvertKernel<int16, float>("convertI16toF32", true, CK_VARIANTS_AVX2(convertI16toF32));
+    kernels[n++] = new ConvertKernel<int8, float>("convertI8toF32", true, CK_VARIANTS(convertI8toF32));
+    kernels[n++] = new MixKernel<float>("mix", true, CK_VARIANTS_AVX2(mix));
+    kernels[n++] = new MixVolKernel<float>("mixVol", true, CK_VARIANTS_AVX2(mixVol));
+    kernels[n++] = new ToStereoKernel<float>("convertToStereo", true, CK_VARIANTS(convertToStereo));
+    kernels[n++] = new ScaleKernel<float>("convertToStereoScale", true, true, CK_VARIANTS_AVX2(convertToStereoScale));
+    kernels[n++] = new ScaleKernel<float>("scale", true, false, CK_VARIANTS_AVX2(scale));
+    kernels[n++] = new StereoPanKernel<float>("stereoPan", true, CK_VARIANTS_AVX2(stereoPan));
+    kernels[n++] = new StereoPanRampKernel<float>("stereoPanRamp", true, CK_VARIANTS(stereoPanRamp));
+    kernels[n++] = new MonoPanKernel<float>("monoPan", true, CK_VARIANTS_AVX2(monoPan));
+    kernels[n++] = new MonoPanRampKernel<float>("monoPanRamp", true, CK_VARIANTS(monoPanRamp));
+    kernels[n++] = new ResampleKernel<float>("resampleMono", true, 1, CK_VARIANTS_AVX2(resampleMono));
+    kernels[n++] = new ResampleKernel<float>("resampleStereo", true, 2, CK_VARIANTS_AVX2(resampleStereo));
+    kernels[n++] = new SincKernel<float>("sincMono", true, 1, CK_VARIANTS_AVX2(sincMono));
+    kernels[n++] = new SincKernel<float>("sincStereo", true, 2, CK_VARIANTS_AVX2(sincStereo));
+    kernels[n++] = new ClampKernel<float>("clamp", true, CK_VARIANTS_AVX2(clamp));
+    kernels[n++] = new AdpcmKernel<float>("adpcmMono", true, 1);
+    kernels[n++] = new AdpcmKernel<float>("adpcmStereo", true, 2);
+    kernels[n++] = new LosslessKernel<float>("losslessMono", true, 1);
+    kernels[n++] = new LosslessKernel<float>("losslessStereo", true, 2);
+    kernels[n++] = new EffectKernel<float>("biquad", true, createBiquad());
+    kernels[n++] = new EffectKernel<float>("bitcrusher", true, createBitCrusher());
+    kernels[n++] = new EffectKernel<float>("distortion", true, createDistortion());
+    kernels[n++] = new EffectKernel<float>("ringmod", true, createRingMod());
+    kernels[n++] = new EffectKernel<float>("reverb", true, createReverb());
+    kernels[n++] = new EffectKernel<float>("compressor", true, createCompressor());
+    kernels[n++] = new EffectKernel<float>("convolution", true, createConvolution(), ConvolutionProcessor::k_headBlockFrames);
+    kernels[n++] = new SpatializeKernel("spatialize");
+
+    return n;
+}
+
+enum { k_maxKernels = 64 };
+
+////////////////////////////////////////
+// checking and timing
+
+// Runs a variant once into g_out; returns false if it wrote past the end.
+bool runOnce(Kernel* kernel, int variant, int samples, int& result)
+{
+    int sampleSize = kernel->getSampleSize();
+    uint8* guard = (uint8*) g_out + samples * sampleSize;
+    memset(guard, k_guardByte, k_guardSamples * sampleSize);
+
+    kernel->prepare(samples);
+    result = kernel->run(variant, samples);
+
+    for (int i = 0; i < k_guardSamples * sampleSize; ++i)
+    {
+        if (guard[i] != k_guardByte)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+float timeBatch(Kernel* kernel, int variant, int samples, int iterations, bool run)
+{
+    Timer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i)
+    {
+        kernel->prepare(samples);
+        if (run)
+        {
+            kernel->run(variant, samples);
+        }
+    }
+    timer.stop();
+    return timer.getElapsedMs();
+}
+
+// Returns ns per output sample, not counting prepare().
+float timeKernel(Kernel* kernel, int variant, int samples, float batchMs)
+{
+    const int k_batches = 5;
+
+    int iterations = 1;
+    while (iterations < (1 << 24) && timeBatch(kernel, variant, samples, iterations, true) < batchMs)
+    {
+        iterations *= 2;
+    }
+
+    // best of several batches, to reject interruptions
+    float runMs = 1.0e9f;
+    float prepareMs = 1.0e9f;
+    for (int i = 0; i < k_batches; ++i)
+    {
+        runMs = Math::min(runMs, timeBatch(kernel, variant, samples, iterations, true));
+        prepareMs = Math::min(prepareMs, timeBatch(kernel, variant, samples, iterations, false));
+    }
+
+    return Math::max(0.0f, runMs - prepareMs) * 1.0e6f / ((float) iterations * samples);
+}
+
+////////////////////////////////////////
+
+struct Options
+{
+    int sizes[16];
+    int numSizes;
+    const char* kernel;
+    const char* jsonPath;
+    float tolerance;
+    float batchMs;
+    bool fixed;
+    bool floatingPoint;
+};
+
+bool g_verbose = false;
+
+void logFunc(CkLogType type, const char* msg)
+{
+    if (type == kCkLog_Error || type == kCkLog_Warning || g_verbose)
+    {
+        const char* label;
+        switch (type)
+        {
+            case kCkLog_Info:    label = "INFO";    break;
+            case kCkLog_Warning: label = "WARNING"; break;
+            case kCkLog_Error:   label = "ERROR";   break;
+            default: return;
+        }
+        CK_PRINT("%s: %s\n", label, msg);
+    }
+}
+
+bool parseSizes(const char* str, Options& options)
+{
+    options.numSizes = 0;
+    while (*str)
+    {
+        char* end;
+        long size = strtol(str, &end, 10);
+        if (end == str || size < 16 || size > (1 << 20) || (size & 1) || options.numSizes >= CK_ARRAY_COUNT(options.sizes))
+        {
+            return false;
+        }
+        options.sizes[options.numSizes++] = (int) size;
+        str = end;
+        if (*str == ',')
+        {
+            ++str;
+        }
+        else if (*str)
+        {
+            return false;
+        }
+    }
+    return options.numSizes > 0;
+}
+
+void printUsage(const char* app)
+{
+    Path appPath(app);
+    const char* toolName = appPath.getLeaf();
+    CK_PRINT("\n");
+    CK_PRINT("Usage:\n");
+    CK_PRINT("\n");
+    CK_PRINT(" %s [options]\n", toolName);
+    CK_PRINT("   runs each DSP kernel in every supported SIMD variant, checks the output\n");
+    CK_PRINT("   against the default variant, and reports ns per output sample\n");
+    CK_PRINT("\n");
+    CK_PRINT("Available options are:\n");
+    CK_PRINT("  -sizes <n,n,...>    buffer sizes in samples (default 30,64,256,1024,4096)\n");
+    CK_PRINT("                      kernels that work in blocks round up to whole blocks\n");
+    CK_PRINT("  -kernel <name>      only kernels whose names contain <name>\n");
+    CK_PRINT("  -fixed              only the fixed-point pipeline\n");
+    CK_PRINT("  -float              only the floating-point pipeline\n");
+    CK_PRINT("  -tolerance <value>  largest difference from default, as a fraction of\n");
+    CK_PRINT("                      full scale (default 0.00001)\n");
+    CK_PRINT("  -time <ms>          minimum time per timing batch (default 1)\n");
+    CK_PRINT("  -json <path>        also write results to a JSON file\n");
+    CK_PRINT("  -verbose\n");
+    CK_PRINT("\n");
+    CK_PRINT("Set the CK_SIMD environment variable (none, basic, avx2) to skip variants.\n");
+    CK_PRINT("\n");
+}
+
+int run(const Options& options)
+{
+    CkConfig config;
+    config.logMask = kCkLog_All;
+    config.logFunc = logFunc;
+    if (!CkInitOffline(&config))
+    {
+        return 1;
+    }
+
+    initVariants();
+
+    int maxSamples = 0;
+    for (int i = 0; i < options.numSizes; ++i)
+    {
+        maxSamples = Math::max(maxSamples, options.sizes[i]);
+    }
+    initBuffers(maxSamples + k_maxBlockSamples);
+    initSincTables();
+
+    Kernel* kernels[k_maxKernels];
+    int numKernels = createKernels(kernels);
+    CK_ASSERT(numKernels <= k_maxKernels);
+
+    FILE* json = NULL;
+    if (options.jsonPath)
+    {
+        json = fopen(options.jsonPath, "w");
+        if (!json)
+        {
+            CK_PRINT("Could not open %s for writing\n", options.jsonPath);
+        }
+    }
+
+    CkSimdLevel simdLevel = System::get()->getSimdLevel();
+    if (json)
+    {
+        fprintf(json, "{\n");
+        fprintf(json, "  \"version\": \"%d.%d.%d%s%s\",\n", Version::k_major, Version::k_minor, Version::k_build, (strlen(Version::k_label) ? " " : ""), Version::k_label);
+        fprintf(json, "  \"arch\": \"%s\",\n", getArchName());
+        fprintf(json, "  \"simdLevel\": \"%s\",\n", getSimdLevelName(simdLevel));
+        fprintf(json, "  \"tolerance\": %g,\n", options.tolerance);
+        fprintf(json, "  \"results\": [");
+    }
+
+    printCompression();
+
+    // table header
+    CK_PRINT("arch %s, SIMD %s; = exact, ~ within tolerance, ! mismatch\n\n", getArchName(), getSimdLevelName(simdLevel));
+    CK_PRINT("%-22s %-5s %6s", "ns/sample", "mode", "size");
+    for (int v = 0; v < k_numVariants; ++v)
+    {
+        if (g_variantEnabled[v])
+        {
+            CK_PRINT("  %10s", g_variantNames[v]);
+        }
+    }
+    CK_PRINT("\n");
+
+    int failures = 0;
+    bool firstResult = true;
+    for (int k = 0; k < numKernels; ++k)
+    {
+        Kernel* kernel = kernels[k];
+        if ((options.kernel && !strstr(kernel->getName(), options.kernel)) ||
+            (kernel->isFloat() ? !options.floatingPoint : !options.fixed))
+        {
+            continue;
+        }
+        const char* mode = kernel->isFloat() ? "float" : "fixed";
+
+        int prevSamples = -1;
+        for (int s = 0; s < options.numSizes; ++s)
+        {
+            int blockSamples = kernel->getBlockSamples();
+            int samples = (options.sizes[s] + blockSamples - 1) / blockSamples * blockSamples;
+            CK_ASSERT(blockSamples <= k_maxBlockSamples);
+            if (samples == prevSamples)
+            {
+                // rounds to the same size as the previous row
+                continue;
+            }
+            prevSamples = samples;
+            CK_PRINT("%-22s %-5s %6d", kernel->getName(), mode, samples);
+
+            int refResult = 0;
+            char notes[k_numVariants][128];
+            int numNotes = 0;
+            for (int v = 0; v < k_numVariants; ++v)
+            {
+                if (!g_variantEnabled[v])
+                {
+                    continue;
+                }
+                if (!kernel->hasVariant(v))
+                {
+                    CK_PRINT("  %10s", "-");
+                    continue;
+                }
+
+                int result = 0;
+                bool inBounds = runOnce(kernel, v, samples, result);
+                float error = 0.0f;
+                if (v == k_default)
+                {
+                    Mem::copy(g_ref, g_out, samples * kernel->getSampleSize());
+                    refResult = result;
+                }
+                else
+                {
+                    error = kernel->getError(g_out, g_ref, samples);
+                }
+                bool exact = (error == 0.0f && result == refResult);
+                bool pass = inBounds && result == refResult && error <= options.tolerance;
+
+                float ns = timeKernel(kernel, v, samples, options.batchMs);
+
+                CK_PRINT("  %8.3f %c", ns, (pass ? (exact ? '=' : '~') : '!'));
+                if (json)
+                {
+                    fprintf(json, "%s\n    { \"kernel\": \"%s\", \"mode\": \"%s\", \"size\": %d, \"variant\": \"%s\", "
+                            "\"nsPerSample\": %.4f, \"maxError\": %g, \"exact\": %s, \"inBounds\": %s, \"pass\": %s }",
+                            (firstResult ? "" : ","), kernel->getName(), mode, samples, g_variantNames[v],
+                            ns, error, (exact ? "true" : "false"), (inBounds ? "true" : "false"), (pass ? "true" : "false"));
+                    firstResult = false;
+                }
+
+                if (!pass)
+                {
+                    ++failures;
+                    snprintf(notes[numNotes++], sizeof(notes[0]), "%s: error %g, result %d (default %d)%s",
+                            g_variantNames[v], error, result, refResult, (inBounds ? "" : ", wrote past end of buffer"));
+                }
+            }
+
+            CK_PRINT("\n");
+            for (int i = 0; i < numNotes; ++i)
+            {
+                CK_PRINT("    %s\n", notes[i]);
+            }
+        }
+    }
+
+    if (json)
+    {
+        fprintf(json, "\n  ],\n");
+        fprintf(json, "  \"failures\": %d\n", failures);
+        fprintf(json, "}\n");
+        fclose(json);
+    }
+
+    CK_PRINT("\n%d mismatch%s\n", failures, (failures == 1 ? "" : "es"));
+
+    for (int k = 0; k < numKernels; ++k)
+    {
+        delete kernels[k];
+    }
+    shutdownSincTables();
+    shutdownBuffers();
+
+    CkShutdown();
+
+    return failures > 0 ? 1 : 0;
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    parseSizes("30,64,256,1024,4096", options);
+    options.kernel = NULL;
+    options.jsonPath = NULL;
+    options.tolerance = 1.0e-5f;
+    options.batchMs = 1.0f;
+    options.fixed = true;
+    options.floatingPoint = true;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-sizes") == 0 && i+1 < argc)
+        {
+            if (!parseSizes(argv[++i], options))
+            {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-kernel") == 0 && i+1 < argc)
+        {
+            options.kernel = argv[++i];
+        }
+        else if (strcmp(argv[i], "-fixed") == 0)
+        {
+            options.floatingPoint = false;
+        }
+        else if (strcmp(argv[i], "-float") == 0)
+        {
+            options.fixed = false;
+        }
+        else if (strcmp(argv[i], "-tolerance") == 0 && i+1 < argc)
+        {
+            options.tolerance = (float) atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-time") == 0 && i+1 < argc)
+        {
+            options.batchMs = (float) atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-json") == 0 && i+1 < argc)
+        {
+            options.jsonPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "-verbose") == 0)
+        {
+            g_verbose = true;
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!options.fixed && !options.floatingPoint)
+    {
+        // -fixed and -float together means both
+        options.fixed = options.floatingPoint = true;
+    }
+
+    CK_PRINT("\n");
+    CK_PRINT("Cricket Audio DSP benchmark (version %d.%d.%d%s%s)\n", Version::k_major, Version::k_minor, Version::k_build, (strlen(Version::k_label) ? " " : ""), Version::k_label);
+
+    return run(options);
+}
@@ -0,0 +1,845 @@
+#include "ck/ck.h"
+#include "ck/config.h"
+#include "ck/bank.h"
+#include "ck/sound.h"
+#include "ck/mixer.h"
+#include "ck/effect.h"
+#include "ck/effectbus.h"
+#include "ck/effecttype.h"
+#include "ck/core/debug.h"
+#include "ck/core/path.h"
+#include "ck/core/string.h"
+#include "ck/core/math.h"
+#include "ck/core/mem.h"
+#include "ck/core/timer.h"
+#include "ck/core/version.h"
+#include "ck/audio/audiowriter.h"
+#include "ck/audio/wavwriter.h"
+#include "ck/audio/rawwriter.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+
+#undef min
+#undef max
+
+using namespace Cki;
+
+// ckrender runs a script of Cricket Audio calls against the offline renderer
+// (CkInitOffline/CkRenderOffline), as fast as the CPU allows, and writes the
+// final output to a .wav or .raw file.  No audio device is used.
+//
+// A script has one command per line; anything after # is a comment.
+// Sounds, mixers, effect buses, and effects are referred to by names given
+// when they are created.  Time passes only in "wait" and "waitdone".
+// Commands ending in "at" are scheduled for an exact time from the start of
+// the output, rather than taking effect at the start of the next block.
+
+////////////////////////////////////////
+
+bool g_verbose = false;
+
+void logFunc(CkLogType type, const char* msg)
+{
+    if (type == kCkLog_Error || type == kCkLog_Warning || g_verbose)
+    {
+        const char* label;
+        switch (type)
+        {
+            case kCkLog_Info:    label = "INFO";    break;
+            case kCkLog_Warning: label = "WARNING"; break;
+            case kCkLog_Error:   label = "ERROR";   break;
+            default: return;
+        }
+        CK_PRINT("%s: %s\n", label, msg);
+    }
+}
+
+////////////////////////////////////////
+// effect types
+
+struct EffectTypeName
+{
+    const char* name;
+    CkEffectType value;
+};
+
+EffectTypeName g_effectTypes[] =
+{
+    { "biquad", kCkEffectType_BiquadFilter },
+    { "bitcrusher", kCkEffectType_BitCrusher },
+    { "ringmod", kCkEffectType_RingMod },
+    { "distortion", kCkEffectType_Distortion },
+    { "reverb", kCkEffectType_Reverb },
+    { "compressor", kCkEffectType_Compressor },
+};
+
+bool parseEffectType(const char* str, CkEffectType& type)
+{
+    String typeStr = str;
+    typeStr.makeLowerCase();
+
+    for (int i = 0; i < CK_ARRAY_COUNT(g_effectTypes); ++i)
+    {
+        if (typeStr == g_effectTypes[i].name)
+        {
+            type = g_effectTypes[i].value;
+            return true;
+        }
+    }
+    return false;
+}
+
+////////////////////////////////////////
+// resample qualities
+
+struct ResampleQualityName
+{
+    const char* name;
+    CkResampleQuality value;
+};
+
+ResampleQualityName g_resampleQualities[] =
+{
+    { "default", kCkResampleQuality_Default },
+    { "linear", kCkResampleQuality_Linear },
+    { "sinc", kCkResampleQuality_Sinc },
+};
+
+// (no String here, since this is also used for options parsed before CkInitOffline())
+bool parseResampleQuality(const char* str, CkResampleQuality& quality)
+{
+    for (int i = 0; i < CK_ARRAY_COUNT(g_resampleQualities); ++i)
+    {
+        if (strcmp(str, g_resampleQualities[i].name) == 0)
+        {
+            quality = g_resampleQualities[i].value;
+            return true;
+        }
+    }
+    return false;
+}
+
+// sample time of the output for a time in ms from the start
+long long msToSampleTime(const char* str)
+{
+    return (long long) (atof(str) * 0.001 * CkGetOutputSampleRate() + 0.5);
+}
+
+////////////////////////////////////////
+
+class Renderer
+{
+public:
+    Renderer(AudioWriter* writer, int blockFrames) :
+        m_writer(writer),
+        m_blockFrames(blockFrames),
+        m_buf(NULL),
+        m_frames(0),
+        m_failed(false)
+    {
+        m_buf = (float*) Mem::alloc(blockFrames * 2 * sizeof(float));
+    }
+
+    ~Renderer()
+    {
+        Mem::free(m_buf);
+    }
+
+    bool runScript(const char* path);
+    void destroyAll();
+
+    int getRenderedFrames() const { return m_frames; }
+
+private:
+    typedef std::map<String, CkBank*> BankMap;
+    typedef std::map<String, CkSound*> SoundMap;
+    typedef std::map<String, CkMixer*> MixerMap;
+    typedef std::map<String, CkEffectBus*> BusMap;
+    typedef std::map<String, CkEffect*> EffectMap;
+
+    AudioWriter* m_writer;
+    int m_blockFrames;
+    float* m_buf;
+    int m_frames;
+    bool m_failed;
+
+    BankMap m_banks;
+    SoundMap m_sounds;
+    MixerMap m_mixers;
+    BusMap m_buses;
+    EffectMap m_effects;
+
+    bool runCommand(int argc, char* argv[]);
+    bool render(int frames);
+    bool isAnyPlaying() const;
+
+    CkSound* findSound(const char* name);
+    CkMixer* findMixer(const char* name);
+    CkEffectBus* findBus(const char* name);
+    CkEffect* findEffect(const char* name);
+
+    Renderer(const Renderer&);
+    Renderer& operator=(const Renderer&);
+};
+
+bool Renderer::runScript(const char* path)
+{
+    FILE* file = fopen(path, "r");
+    if (!file)
+    {
+        CK_PRINT("Could not open script %s\n", path);
+        return false;
+    }
+
+    const int k_maxArgs = 8;
+    char line[1024];
+    int lineNum = 0;
+    bool success = true;
+    while (success && fgets(line, sizeof(line), file))
+    {
+        ++lineNum;
+
+        char* comment = strchr(line, '#');
+        if (comment)
+        {
+            *comment = '\0';
+        }
+
+        char* argv[k_maxArgs];
+        int argc = 0;
+        for (char* tok = strtok(line, " \t\r\n"); tok && argc < k_maxArgs; tok = strtok(NULL, " \t\r\n"))
+        {
+            argv[argc++] = tok;
+        }
+
+        if (argc > 0 && !runCommand(argc, argv))
+        {
+            CK_PRINT("%s:%d: error in command \"%s\"\n", path, lineNum, argv[0]);
+            success = false;
+        }
+    }
+
+    fclose(file);
+    return success;
+}
+
+bool Renderer::runCommand(int argc, char* argv[])
+{
+    String cmd = argv[0];
+    cmd.makeLowerCase();
+
+    if (cmd == "bank" && argc == 2)
+    {
+        CkBank* bank = CkBank::newBank(argv[1], kCkPathType_FileSystem);
+        if (!bank)
+        {
+            return false;
+        }
+        m_banks[bank->getName()] = bank;
+    }
+    else if (cmd == "sound" && argc == 4)
+    {
+        BankMap::iterator it = m_banks.find(argv[2]);
+        if (it == m_banks.end())
+        {
+            CK_PRINT("no bank named %s\n", argv[2]);
+            return false;
+        }
+        CkSound* sound = CkSound::newBankSound(it->second, argv[3]);
+        if (!sound)
+        {
+            return false;
+        }
+        m_sounds[argv[1]] = sound;
+    }
+    else if (cmd == "stream" && argc == 3)
+    {
+        CkSound* sound = CkSound::newStreamSound(argv[2], kCkPathType_FileSystem);
+        if (!sound)
+        {
+            return false;
+        }
+        m_sounds[argv[1]] = sound;
+    }
+    else if (cmd == "mixer" && (argc == 2 || argc == 3))
+    {
+        CkMixer* parent = NULL;
+        if (argc == 3 && !(parent = findMixer(argv[2])))
+        {
+            return false;
+        }
+        m_mixers[argv[1]] = CkMixer::newMixer(argv[1], parent);
+    }
+    else if (cmd == "bus" && argc == 2)
+    {
+        m_buses[argv[1]] = CkEffectBus::newEffectBus();
+    }
+    else if (cmd == "effect" && (argc == 5 || argc == 6) && strcmp(argv[3], "convolution") == 0)
+    {
+        // impulse response from a .wav file, or from a bank sound
+        CkEffectBus* bus = findBus(argv[2]);
+        if (!bus)
+        {
+            return false;
+        }
+        CkEffect* effect;
+        if (argc == 5)
+        {
+            effect = CkEffect::newConvolutionReverb(argv[4], kCkPathType_FileSystem);
+        }
+        else
+        {
+            BankMap::iterator it = m_banks.find(argv[4]);
+            if (it == m_banks.end())
+            {
+                CK_PRINT("no bank named %s\n", argv[4]);
+                return false;
+            }
+            effect = CkEffect::newConvolutionReverb(it->second, argv[5]);
+        }
+        if (!effect)
+        {
+            return false;
+        }
+        bus->addEffect(effect);
+        m_effects[argv[1]] = effect;
+    }
+    else if (cmd == "effect" && argc == 4)
+    {
+        CkEffectBus* bus = findBus(argv[2]);
+        CkEffectType type;
+        if (!bus || !parseEffectType(argv[3], type))
+        {
+            return false;
+        }
+        CkEffect* effect = CkEffect::newEffect(type);
+        bus->addEffect(effect);
+        m_effects[argv[1]] = effect;
+    }
+    else if (cmd == "param" && argc == 4)
+    {
+        CkEffect* effect = findEffect(argv[1]);
+        if (!effect)
+        {
+            return false;
+        }
+        effect->setParam(atoi(argv[2]), (float) atof(argv[3]));
+    }
+    else if (cmd == "wetdry" && argc == 3)
+    {
+        // either a bus or an effect
+        if (m_buses.count(argv[1]))
+        {
+            m_buses[argv[1]]->setWetDryRatio((float) atof(argv[2]));
+        }
+        else if (CkEffect* effect = findEffect(argv[1]))
+        {
+            effect->setWetDryRatio((float) atof(argv[2]));
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else if (cmd == "outbus" && argc == 3)
+    {
+        CkEffectBus* bus = findBus(argv[1]);
+        CkEffectBus* outBus = findBus(argv[2]);
+        if (!bus || !outBus)
+        {
+            return false;
+        }
+        bus->setOutputBus(outBus);
+    }
+    else if (cmd == "busload" && argc == 2)
+    {
+        CkEffectBus* bus = (strcmp(argv[1], "global") == 0 ? CkEffectBus::getGlobalEffectBus() : findBus(argv[1]));
+        if (!bus)
+        {
+            return false;
+        }
+        CK_PRINT("bus %s: render load %.4f\n", argv[1], bus->getRenderLoad());
+    }
+    else if (cmd == "voices" && argc == 1)
+    {
+        CkVoiceStats stats;
+        CkGetVoiceStats(&stats);
+        CK_PRINT("voices: %d real, %d virtual, %d stolen\n", stats.realVoices, stats.virtualVoices, stats.stolenVoices);
+    }
+    else if (cmd == "mixervolume" && argc == 3)
+    {
+        CkMixer* mixer = (strcmp(argv[1], "master") == 0 ? CkMixer::getMaster() : findMixer(argv[1]));
+        if (!mixer)
+        {
+            return false;
+        }
+        mixer->setVolume((float) atof(argv[2]));
+    }
+    else if (cmd == "wait" && argc == 2)
+    {
+        return render(Math::round((float) atof(argv[1]) * 0.001f * CkGetOutputSampleRate()));
+    }
+    else if (cmd == "waitdone" && (argc == 1 || argc == 2))
+    {
+        // render until nothing is playing, up to the limit (default 10 minutes)
+        float maxMs = (argc == 2 ? (float) atof(argv[1]) : 600000.0f);
+        int maxFrames = Math::round(maxMs * 0.001f * CkGetOutputSampleRate());
+        int frames = 0;
+        while (frames < maxFrames && isAnyPlaying())
+        {
+            int blockFrames = Math::min(m_blockFrames, maxFrames - frames);
+            if (!render(blockFrames))
+            {
+                return false;
+            }
+            frames += blockFrames;
+        }
+    }
+    else
+    {
+        // commands on a sound
+        if (argc < 2)
+        {
+            return false;
+        }
+        CkSound* sound = findSound(argv[1]);
+        if (!sound)
+        {
+            return false;
+        }
+
+        if (cmd == "play" && argc == 2)
+        {
+            sound->play();
+        }
+        else if (cmd == "stop" && argc == 2)
+        {
+            sound->stop();
+        }
+        else if (cmd == "playat" && argc == 3)
+        {
+            sound->playAt(msToSampleTime(argv[2]));
+        }
+        else if (cmd == "stopat" && argc == 3)
+        {
+            sound->stopAt(msToSampleTime(argv[2]));
+        }
+        else if (cmd == "pause" && argc == 2)
+        {
+            sound->setPaused(true);
+        }
+        else if (cmd == "resume" && argc == 2)
+        {
+            sound->setPaused(false);
+        }
+        else if (cmd == "volume" && argc == 3)
+        {
+            sound->setVolume((float) atof(argv[2]));
+        }
+        else if (cmd == "volumeat" && argc == 4)
+        {
+            sound->setVolumeAt((float) atof(argv[2]), msToSampleTime(argv[3]));
+        }
+        else if (cmd == "pan" && argc == 3)
+        {
+            sound->setPan((float) atof(argv[2]));
+        }
+        else if (cmd == "speed" && argc == 3)
+        {
+            sound->setSpeed((float) atof(argv[2]));
+        }
+        else if (cmd == "pitch" && argc == 3)
+        {
+            sound->setPitchShift((float) atof(argv[2]));
+        }
+        else if (cmd == "priority" && argc == 3)
+        {
+            sound->setPriority((float) atof(argv[2]));
+        }
+        else if (cmd == "resample" && argc == 3)
+        {
+            CkResampleQuality quality;
+            if (!parseResampleQuality(argv[2], quality))
+            {
+                return false;
+            }
+            sound->setResampleQuality(quality);
+        }
+        else if (cmd == "loopcount" && argc == 3)
+        {
+            sound->setLoopCount(atoi(argv[2]));
+        }
+        else if (cmd == "position" && argc == 3)
+        {
+            sound->setPlayPositionMs((float) atof(argv[2]));
+        }
+        else if (cmd == "setmixer" && argc == 3)
+        {
+            CkMixer* mixer = findMixer(argv[2]);
+            if (!mixer)
+            {
+                return false;
+            }
+            sound->setMixer(mixer);
+        }
+        else if (cmd == "setbus" && argc == 3)
+        {
+            CkEffectBus* bus = findBus(argv[2]);
+            if (!bus)
+            {
+                return false;
+            }
+            sound->setEffectBus(bus);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Renderer::render(int frames)
+{
+    while (frames > 0 && !m_failed)
+    {
+        int blockFrames = Math::min(frames, m_blockFrames);
+
+        // same order as a game loop: update, then the audio thread renders
+        CkUpdate();
+        CkRenderOffline(blockFrames, m_buf);
+
+        int samples = blockFrames * 2;
+        if (m_writer->write(m_buf, samples) != samples)
+        {
+            CK_PRINT("Could not write output\n");
+            m_failed = true;
+        }
+
+        m_frames += blockFrames;
+        frames -= blockFrames;
+    }
+    return !m_failed;
+}
+
+bool Renderer::isAnyPlaying() const
+{
+    for (SoundMap::const_iterator it = m_sounds.begin(); it != m_sounds.end(); ++it)
+    {
+        if (it->second->isPlaying())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Renderer::destroyAll()
+{
+    for (SoundMap::iterator it = m_sounds.begin(); it != m_sounds.end(); ++it)
+    {
+        it->second->destroy();
+    }
+    m_sounds.clear();
+
+    for (EffectMap::iterator it = m_effects.begin(); it != m_effects.end(); ++it)
+    {
+        it->second->destroy();
+    }
+    m_effects.clear();
+
+    for (BusMap::iterator it = m_buses.begin(); it != m_buses.end(); ++it)
+    {
+        it->second->destroy();
+    }
+    m_buses.clear();
+
+    for (MixerMap::iterator it = m_mixers.begin(); it != m_mixers.end(); ++it)
+    {
+        it->second->destroy();
+    }
+    m_mixers.clear();
+
+    for (BankMap::iterator it = m_banks.begin(); it != m_banks.end(); ++it)
+    {
+        it->second->destroy();
+    }
+    m_banks.clear();
+}
+
+CkSound* Renderer::findSound(const char* name)
+{
+    SoundMap::iterator it = m_sounds.find(name);
+    if (it == m_sounds.end())
+    {
+        CK_PRINT("no sound named %s\n", name);
+        return NULL;
+    }
+    return it->second;
+}
+
+CkMixer* Renderer::findMixer(const char* name)
+{
+    MixerMap::iterator it = m_mixers.find(name);
+    if (it == m_mixers.end())
+    {
+        CK_PRINT("no mixer named %s\n", name);
+        return NULL;
+    }
+    return it->second;
+}
+
+CkEffectBus* Renderer::findBus(const char* name)
+{
+    BusMap::iterator it = m_buses.find(name);
+    if (it == m_buses.end())
+    {
+        CK_PRINT("no effect bus named %s\n", name);
+        return NULL;
+    }
+    return it->second;
+}
+
+CkEffect* Renderer::findEffect(const char* name)
+{
+    EffectMap::iterator it = m_effects.find(name);
+    if (it == m_effects.end())
+    {
+        CK_PRINT("no effect named %s\n", name);
+        return NULL;
+    }
+    return it->second;
+}
+
+////////////////////////////////////////
+
+void printUsage(const char* app)
+{
+    Path appPath(app);
+    const char* toolName = appPath.getLeaf();
+    CK_PRINT("\n");
+    CK_PRINT("Usage:\n");
+    CK_PRINT("\n");
+    CK_PRINT(" %s [options] <script> <outfile>\n", toolName);
+    CK_PRINT("   runs a script offline, as fast as possible, and writes the output to a\n");
+    CK_PRINT("   .wav file, or a .raw file (32-bit floating-point interleaved stereo)\n");
+    CK_PRINT("\n");
+    CK_PRINT("Available options are:\n");
+    CK_PRINT("  -block <frames>     frames rendered per call (default 1024)\n");
+    CK_PRINT("  -threads <count>    render threads (default 1)\n");
+    CK_PRINT("  -fixed              use the fixed-point pipeline\n");
+    CK_PRINT("  -resample <quality> default resampling (linear or sinc)\n");
+    CK_PRINT("  -decodecache <bytes> size of the decoded sound cache (default 0)\n");
+    CK_PRINT("  -limiter <dB>       limit the output to the given ceiling, instead of clipping\n");
+    CK_PRINT("  -voices <count>     maximum number of real voices (default 0, no limit)\n");
+    CK_PRINT("  -trace <file.json>  record a render trace (open in Perfetto or chrome://tracing)\n");
+    CK_PRINT("  -verbose\n");
+    CK_PRINT("\n");
+    CK_PRINT("Script commands (one per line; # starts a comment):\n");
+    CK_PRINT("  bank <path>                        load a bank\n");
+    CK_PRINT("  sound <name> <bank> <sound>        create a bank sound\n");
+    CK_PRINT("  stream <name> <path>               create a stream sound\n");
+    CK_PRINT("  play|stop|pause|resume <sound>\n");
+    CK_PRINT("  playat|stopat <sound> <ms>         play or stop at a time from the start\n");
+    CK_PRINT("  volumeat <sound> <value> <ms>      set the volume at a time from the start\n");
+    CK_PRINT("  volume|pan|speed|pitch|priority <sound> <value>\n");
+    CK_PRINT("  resample <sound> <quality>         set resampling (default, linear, sinc)\n");
+    CK_PRINT("  loopcount <sound> <count>\n");
+    CK_PRINT("  position <sound> <ms>\n");
+    CK_PRINT("  mixer <name> [<parent>]            create a mixer\n");
+    CK_PRINT("  mixervolume <mixer|master> <volume>\n");
+    CK_PRINT("  setmixer <sound> <mixer>\n");
+    CK_PRINT("  bus <name>                         create an effect bus\n");
+    CK_PRINT("  outbus <bus> <output bus>\n");
+    CK_PRINT("  setbus <sound> <bus>\n");
+    CK_PRINT("  effect <name> <bus> <type>         add an effect (biquad, bitcrusher, ringmod,\n");
+    CK_PRINT("                                     distortion, reverb, compressor)\n");
+    CK_PRINT("  effect <name> <bus> convolution <file.wav>|<bank> <sound>\n");
+    CK_PRINT("                                     add a convolution reverb, with the impulse\n");
+    CK_PRINT("                                     response from a .wav file or a bank sound\n");
+    CK_PRINT("  param <effect> <id> <value>\n");
+    CK_PRINT("  wetdry <bus|effect> <ratio>\n");
+    CK_PRINT("  busload <bus|global>               print the bus's recent render load\n");
+    CK_PRINT("  voices                             print the numbers of real and virtual voices\n");
+    CK_PRINT("  wait <ms>                          render for the given time\n");
+    CK_PRINT("  waitdone [<max ms>]                render until no sounds are playing\n");
+    CK_PRINT("\n");
+}
+
+int run(int argc, char* argv[])
+{
+    int blockFrames = 1024;
+    int threads = 1;
+    bool fixed = false;
+    int decodeCacheBytes = 0;
+    bool limiter = false;
+    float limiterCeiling = 0.0f;
+    int maxRealVoices = 0;
+    CkResampleQuality resampleQuality = kCkResampleQuality_Linear;
+    const char* tracePath = NULL;
+    const char* scriptPath = NULL;
+    const char* outPath = NULL;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-block") == 0 && i+1 < argc)
+        {
+            blockFrames = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-threads") == 0 && i+1 < argc)
+        {
+            threads = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-fixed") == 0)
+        {
+            fixed = true;
+        }
+        else if (strcmp(argv[i], "-resample") == 0 && i+1 < argc)
+        {
+            if (!parseResampleQuality(argv[++i], resampleQuality) || resampleQuality == kCkResampleQuality_Default)
+            {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-decodecache") == 0 && i+1 < argc)
+        {
+            decodeCacheBytes = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-limiter") == 0 && i+1 < argc)
+        {
+            limiter = true;
+            limiterCeiling = (float) atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-voices") == 0 && i+1 < argc)
+        {
+            maxRealVoices = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-trace") == 0 && i+1 < argc)
+        {
+            tracePath = argv[++i];
+        }
+        else if (strcmp(argv[i], "-verbose") == 0)
+        {
+            g_verbose = true;
+        }
+        else if (argv[i][0] != '-' && !scriptPath)
+        {
+            scriptPath = argv[i];
+        }
+        else if (argv[i][0] != '-' && !outPath)
+        {
+            outPath = argv[i];
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!scriptPath || !outPath || blockFrames <= 0 || threads <= 0)
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    CkConfig config;
+    config.logMask = kCkLog_All;
+    config.logFunc = logFunc;
+    config.renderThreads = threads;
+    config.resampleQuality = resampleQuality;
+    config.decodeCacheBytes = decodeCacheBytes;
+    config.outputLimiter = limiter;
+    config.outputLimiterCeiling = limiterCeiling;
+    config.maxRealVoices = maxRealVoices;
+    if (fixed)
+    {
+        config.sampleType = kCkSampleType_Fixed;
+    }
+
+    if (!CkInitOffline(&config))
+    {
+        return 1;
+    }
+
+    int result = 1;
+    {
+        Path path(outPath);
+        AudioWriter* writer = NULL;
+        if (path.hasExtension("raw"))
+        {
+            writer = new RawWriter(outPath, false);
+        }
+        else if (path.hasExtension("wav"))
+        {
+            writer = new WavWriter(outPath, 2, CkGetOutputSampleRate(), false);
+        }
+        else
+        {
+            CK_PRINT("Output file must have extension .wav or .raw\n");
+        }
+
+        if (writer && !writer->isValid())
+        {
+            CK_PRINT("Could not open %s for writing\n", outPath);
+            delete writer;
+            writer = NULL;
+        }
+
+        if (writer)
+        {
+            Renderer renderer(writer, blockFrames);
+
+            if (tracePath)
+            {
+                CkStartRenderTrace(tracePath, kCkPathType_FileSystem);
+            }
+
+            Timer timer;
+            timer.start();
+            bool success = renderer.runScript(scriptPath);
+            timer.stop();
+
+            if (tracePath)
+            {
+                CkStopRenderTrace();
+            }
+
+            renderer.destroyAll();
+            writer->close();
+            delete writer;
+
+            float renderedMs = renderer.getRenderedFrames() * 1000.0f / CkGetOutputSampleRate();
+            float elapsedMs = timer.getElapsedMs();
+            CK_PRINT("rendered %.3f s in %.3f s (%.1fx real time)\n",
+                    renderedMs * 0.001f, elapsedMs * 0.001f,
+                    elapsedMs > 0.0f ? renderedMs / elapsedMs : 0.0f);
+
+            if (decodeCacheBytes > 0)
+            {
+                CkDecodeCacheStats stats;
+                CkGetDecodeCacheStats(&stats);
+                CK_PRINT("decode cache: %d hits, %d misses, %d evictions, %d overflows, %d bytes\n",
+                        stats.hits, stats.misses, stats.evictions, stats.overflows, stats.bytes);
+            }
+
+            result = (success ? 0 : 1);
+        }
+    }
+
+    CkShutdown();
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    CK_PRINT("\n");
+    CK_PRINT("Cricket Audio offline renderer (version %d.%d.%d%s%s)\n", Version::k_major, Version::k_minor, Version::k_build, (strlen(Version::k_label) ? " " : ""), Version::k_label);
+
+    return run(argc, argv);
+}
@@ -0,0 +1,471 @@
+#include "encodequeue.h"
+#include "samplecache.h"
+#include "encoder.h"
+#include "audioreader.h"
+#include "ck/core/filestream.h"
+#include "ck/core/thread.h"
+#include "ck/core/mutexlock.h"
+#include "ck/core/math.h"
+#include "ck/core/debug.h"
+#include "ck/audio/lossless.h"
+#include <stdio.h>
+#if CK_PLATFORM_WIN
+#  include <windows.h>
+#else
+#  include <unistd.h>
+#endif
+
+// template definitions
+#include "ck/core/array.cpp"
+
+namespace Cki
+{
+
+
+namespace
+{
+    const int k_bufSamples = 16 * 1024;
+
+    // Encoded data of a sample, from the cache or a file being read, should
+    // have a size in this range.
+    bool isValidDataSize(const SampleInfo& info, int bytes)
+    {
+        int maxBytes = info.blocks * info.blockBytes;
+        int minBytes = maxBytes;
+        if (info.format == AudioFormat::k_lossless)
+        {
+            // blocks vary in size, and are followed by a table of their offsets
+            int tableBytes = Lossless::getTableBytes(info.blocks);
+            minBytes = info.blocks + tableBytes;
+            maxBytes += tableBytes;
+        }
+        return bytes >= minBytes && bytes <= maxBytes;
+    }
+}
+
+
+EncodeQueue::EncodeQueue(SampleCache* cache, const char* tempPath) :
+    m_nextJob(0),
+    m_file(NULL),
+    m_cache(cache),
+    m_tempPath(tempPath)
+{
+}
+
+EncodeQueue::~EncodeQueue()
+{
+    for (int i = 0; i < m_jobs.getSize(); ++i)
+    {
+        removeTemp(*m_jobs[i]);
+        delete m_jobs[i];
+    }
+}
+
+void EncodeQueue::add(const char* sourcePath, const SampleInfo& info)
+{
+    Job* job = new Job;
+    job->sourcePath = sourcePath;
+    job->info = info;
+    job->index = m_jobs.getSize();
+    job->dataSize = 0;
+    job->filePos = 0;
+    job->cached = false;
+    job->temp = false;
+    job->error = NULL;
+    if (info.format != AudioFormat::k_lossless)
+    {
+        // known in advance; the data is encoded straight into the output file
+        job->dataSize = info.blocks * info.blockBytes;
+    }
+    m_jobs.append(job);
+}
+
+bool EncodeQueue::encode(int numThreads)
+{
+    CK_ASSERT(!m_file);
+    return run(numThreads);
+}
+
+bool EncodeQueue::write(FileStream& outFile, int dataPos, int numThreads)
+{
+    m_file = &outFile;
+
+    int filePos = dataPos;
+    for (int i = 0; i < m_jobs.getSize(); ++i)
+    {
+        Job& job = *m_jobs[i];
+        job.filePos = filePos;
+        filePos += job.dataSize;
+    }
+
+    bool success = run(numThreads);
+    m_file = NULL;
+    return success;
+}
+
+int EncodeQueue::getNumSamples() const
+{
+    return m_jobs.getSize();
+}
+
+int EncodeQueue::getDataSize(int sample) const
+{
+    return m_jobs[sample]->dataSize;
+}
+
+int EncodeQueue::getDataSize() const
+{
+    int bytes = 0;
+    for (int i = 0; i < m_jobs.getSize(); ++i)
+    {
+        bytes += m_jobs[i]->dataSize;
+    }
+    return bytes;
+}
+
+int EncodeQueue::getNumCached() const
+{
+    int count = 0;
+    for (int i = 0; i < m_jobs.getSize(); ++i)
+    {
+        if (m_jobs[i]->cached)
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+int EncodeQueue::getNumProcessors()
+{
+#if CK_PLATFORM_WIN
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    int count = (int) info.dwNumberOfProcessors;
+#else
+    int count = (int) sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return Math::max(count, 1);
+}
+
+////////////////////////////////////////
+
+// Process every job, on the calling thread and numThreads-1 others.
+bool EncodeQueue::run(int numThreads)
+{
+    numThreads = Math::clamp(numThreads, 1, Math::max(m_jobs.getSize(), 1));
+    m_nextJob = 0;
+
+    Array<Thread*> threads;
+    for (int i = 1; i < numThreads; ++i)
+    {
+        Thread* thread = new Thread(threadFunc);
+        thread->setName("encode");
+        thread->start(this);
+        threads.append(thread);
+    }
+
+    work();
+
+    for (int i = 0; i < threads.getSize(); ++i)
+    {
+        threads[i]->join();
+        delete threads[i];
+    }
+
+    bool success = true;
+    for (int i = 0; i < m_jobs.getSize(); ++i)
+    {
+        const Job& job = *m_jobs[i];
+        if (job.error)
+        {
+            CK_PRINT("ERROR: %s: %s\n", job.sourcePath.getBuffer(), job.error);
+            success = false;
+        }
+    }
+    return success;
+}
+
+void* EncodeQueue::threadFunc(void* arg)
+{
+    ((EncodeQueue*) arg)->work();
+    return NULL;
+}
+
+void EncodeQueue::work()
+{
+    for (;;)
+    {
+        Job* job = NULL;
+        {
+            MutexLock lock(m_jobMutex);
+            if (m_nextJob < m_jobs.getSize())
+            {
+                job = m_jobs[m_nextJob++];
+            }
+        }
+        if (!job)
+        {
+            break;
+        }
+        process(*job);
+    }
+}
+
+void EncodeQueue::process(Job& job)
+{
+    if (job.error)
+    {
+        return;
+    }
+
+    if (m_file)
+    {
+        writeData(job);
+    }
+    else if (job.info.format == AudioFormat::k_lossless)
+    {
+        encodeAhead(job);
+    }
+}
+
+// Encode a sample whose size is not known in advance to the cache, or to a
+// temporary file.
+void EncodeQueue::encodeAhead(Job& job)
+{
+    if (m_cache)
+    {
+        SampleCache::Key key;
+        if (!SampleCache::getKey(job.sourcePath.getBuffer(), job.info, key))
+        {
+            job.error = "could not read source file";
+            return;
+        }
+
+        Path path;
+        m_cache->getPath(key, path);
+        int size = FileStream::getSize(path.getBuffer());
+        if (isValidDataSize(job.info, size))
+        {
+            job.dataPath = path;
+            job.dataSize = size;
+            job.cached = true;
+            return;
+        }
+
+        // not in the cache; encode it to the cache
+        Path tempPath;
+        m_cache->getTempPath(key, tempPath);
+        if (encodeToFile(job, tempPath.getBuffer()) && m_cache->commit(key))
+        {
+            job.dataPath = path;
+            return;
+        }
+        FileStream::destroy(tempPath.getBuffer());
+        if (job.error)
+        {
+            return;
+        }
+    }
+
+    // encode it to a temporary file, removed once it has been written
+    char suffix[32];
+    sprintf(suffix, ".%d.tmp", job.index);
+    job.dataPath = m_tempPath;
+    job.dataPath.append(suffix);
+    job.temp = true;
+    if (!encodeToFile(job, job.dataPath.getBuffer()) && !job.error)
+    {
+        job.error = "could not write temporary file";
+    }
+}
+
+// Write a sample to its place in the output file: copied from data encoded
+// ahead, or from the cache, or encoded there (and to the cache).
+void EncodeQueue::writeData(Job& job)
+{
+    if (job.dataPath.getLength() > 0)
+    {
+        FileStream dataFile(job.dataPath.getBuffer(), FileStream::k_read);
+        if (!dataFile.isValid() || dataFile.getSize() != job.dataSize || !copy(job, dataFile))
+        {
+            job.error = "could not read encoded data";
+        }
+        dataFile.close();
+        removeTemp(job);
+        return;
+    }
+
+    if (!m_cache)
+    {
+        encode(job, NULL);
+        return;
+    }
+
+    SampleCache::Key key;
+    if (!SampleCache::getKey(job.sourcePath.getBuffer(), job.info, key))
+    {
+        job.error = "could not read source file";
+        return;
+    }
+
+    Path path;
+    m_cache->getPath(key, path);
+    if (FileStream::getSize(path.getBuffer()) == job.dataSize)
+    {
+        FileStream cacheFile(path.getBuffer(), FileStream::k_read);
+        if (cacheFile.isValid() && copy(job, cacheFile))
+        {
+            job.cached = true;
+            return;
+        }
+    }
+
+    // not in the cache; encode it, and write it to the cache at the same time
+    Path tempPath;
+    m_cache->getTempPath(key, tempPath);
+    bool written;
+    {
+        FileStream cacheFile(tempPath.getBuffer(), FileStream::k_writeTruncate);
+        bool valid = cacheFile.isValid();
+        written = encode(job, valid ? &cacheFile : NULL) && valid &&
+            cacheFile.getSize() == job.dataSize;
+    }
+    if (written)
+    {
+        m_cache->commit(key);
+    }
+    else
+    {
+        FileStream::destroy(tempPath.getBuffer());
+    }
+}
+
+// Encode the sample to its place in the output file, if it is being written,
+// and to dataFile if it is not NULL; returns false, with job.error set if the
+// source was at fault, if it could not be encoded.
+bool EncodeQueue::encode(Job& job, FileStream* dataFile)
+{
+    const SampleInfo& info = job.info;
+
+    AudioReader* reader = AudioReader::create(job.sourcePath.getBuffer());
+    if (!reader)
+    {
+        job.error = "invalid audio file";
+        return false;
+    }
+
+    int inFrames = reader->getFrames();
+    int blocks = (inFrames + info.blockFrames - 1) / info.blockFrames;
+    if (reader->getChannels() != info.channels || blocks != info.blocks)
+    {
+        // file must have been changed since the sample info was built
+        job.error = "source file changed during build";
+        delete reader;
+        return false;
+    }
+
+    Encoder* encoder = Encoder::create((AudioFormat::Value) info.format, info.channels);
+
+    int16* srcSamples = new int16[k_bufSamples];
+    byte* destSamples = new byte[encoder->getMaxBytes(k_bufSamples / info.channels)];
+
+    int pos = job.filePos;
+    int dataBytes = 0;
+    while (!reader->isAtEnd())
+    {
+        int samples = reader->read(srcSamples, k_bufSamples);
+        if (samples <= 0)
+        {
+            break;
+        }
+        int bytes = encoder->encode(srcSamples, destSamples, samples/info.channels, reader->isAtEnd());
+        if (m_file)
+        {
+            write(pos, destSamples, bytes);
+        }
+        if (dataFile)
+        {
+            dataFile->write(destSamples, bytes);
+        }
+        pos += bytes;
+        dataBytes += bytes;
+    }
+
+    int trailerBytes = encoder->getTrailerBytes();
+    if (trailerBytes > 0)
+    {
+        // only for formats encoded ahead, so not written to the output file
+        CK_ASSERT(!m_file);
+        byte* trailer = new byte[trailerBytes];
+        encoder->writeTrailer(trailer);
+        if (dataFile)
+        {
+            dataFile->write(trailer, trailerBytes);
+        }
+        dataBytes += trailerBytes;
+        delete[] trailer;
+    }
+
+    delete[] destSamples;
+    delete[] srcSamples;
+    delete encoder;
+    delete reader;
+
+    if (!isValidDataSize(info, dataBytes) || (m_file && dataBytes != job.dataSize))
+    {
+        job.error = "could not read audio data";
+        return false;
+    }
+    job.dataSize = dataBytes;
+    return true;
+}
+
+// Encode the sample to a file of its own.
+bool EncodeQueue::encodeToFile(Job& job, const char* path)
+{
+    FileStream file(path, FileStream::k_writeTruncate);
+    return file.isValid() && encode(job, &file) && file.getSize() == job.dataSize;
+}
+
+// Copy encoded data to the sample's place in the output file.
+bool EncodeQueue::copy(Job& job, FileStream& dataFile)
+{
+    byte* buf = new byte[k_bufSamples * sizeof(int16)];
+
+    int pos = job.filePos;
+    int bytesLeft = dataFile.getSize();
+    while (bytesLeft > 0)
+    {
+        int bytes = dataFile.read(buf, Math::min(bytesLeft, (int) (k_bufSamples * sizeof(int16))));
+        if (bytes <= 0)
+        {
+            break;
+        }
+        write(pos, buf, bytes);
+        pos += bytes;
+        bytesLeft -= bytes;
+    }
+
+    delete[] buf;
+    return bytesLeft == 0;
+}
+
+void EncodeQueue::write(int pos, const void* buf, int bytes)
+{
+    MutexLock lock(m_fileMutex);
+    m_file->setPos(pos);
+    m_file->write(buf, bytes);
+}
+
+void EncodeQueue::removeTemp(Job& job)
+{
+    if (job.temp)
+    {
+        FileStream::destroy(job.dataPath.getBuffer());
+        job.temp = false;
+    }
+}
+
+
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/core/types.h"
+#include "ck/core/array.h"
+#include "ck/core/path.h"
+#include "ck/core/mutex.h"
+#include "ck/audio/sampleinfo.h"
+
+namespace Cki
+{
+
+class FileStream;
+class SampleCache;
+
+
+// Encodes the sample data of a bank or stream file from the source audio
+// files, on a pool of threads.  Each sample is encoded a piece at a time and
+// written straight to its place in the output file, so memory use does not
+// depend on the number or length of the sounds.  Samples whose encoded size
+// varies (lossless) are encoded ahead to a file of their own (in the cache,
+// or a temporary file), so that their size is known before the output file is
+// written, and are copied into place from there.
+class EncodeQueue
+{
+public:
+    // cache may be NULL.  Samples that are encoded ahead but not cached are
+    // encoded to temporary files whose names start with tempPath.
+    EncodeQueue(SampleCache* cache, const char* tempPath);
+    ~EncodeQueue(); // removes any temporary files
+
+    // Add a sample to be encoded from sourcePath, whose info was built from
+    // the same file.
+    void add(const char* sourcePath, const SampleInfo&);
+
+    // Encode the samples whose size is not known in advance, on the calling
+    // thread and numThreads-1 others; then getDataSize() is known for every
+    // sample.  Returns false (after printing errors) if any sample could not
+    // be encoded.
+    bool encode(int numThreads);
+
+    // Write the samples to outFile starting at dataPos, one after another, in
+    // the order they were added; the ones not encoded yet are encoded on the
+    // calling thread and numThreads-1 others.  Returns false (after printing
+    // errors) if any sample could not be written.
+    bool write(FileStream& outFile, int dataPos, int numThreads);
+
+    int getNumSamples() const;
+    int getDataSize(int sample) const; // bytes, once known
+    int getDataSize() const; // bytes, for all samples
+    int getNumCached() const; // copied from the cache rather than encoded
+
+    static int getNumProcessors();
+
+private:
+    struct Job
+    {
+        Path sourcePath;
+        SampleInfo info;
+        int index;
+        Path dataPath; // data encoded ahead; empty if none
+        int dataSize;
+        int filePos;
+        bool cached;
+        bool temp; // dataPath is a temporary file
+        const char* error;
+    };
+
+    Array<Job*> m_jobs;
+    int m_nextJob;
+    Mutex m_jobMutex;
+    FileStream* m_file; // while writing
+    Mutex m_fileMutex;
+    SampleCache* m_cache;
+    Path m_tempPath;
+
+    bool run(int numThreads);
+    static void* threadFunc(void*);
+    void work();
+    void process(Job&);
+    void encodeAhead(Job&);
+    void writeData(Job&);
+    bool encode(Job&, FileStream* dataFile);
+    bool encodeToFile(Job&, const char* path);
+    bool copy(Job&, FileStream& dataFile);
+    void write(int pos, const void* buf, int bytes);
+    void removeTemp(Job&);
+
+    EncodeQueue(const EncodeQueue&);
+    EncodeQueue& operator=(const EncodeQueue&);
+};
+
+
+}
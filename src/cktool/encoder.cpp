@@ -2,6 +2,7 @@
 #include "pcmi8encoder.h"
 #include "pcmi16encoder.h"
 #include "adpcmencoder.h"
+#include "losslessencoder.h"
 #include "ck/core/debug.h"
 #include "ck/audio/adpcm.h"
 
@@ -14,6 +15,11 @@ Encoder::Encoder(int channels) :
 {
 }
 
+int Encoder::getMaxBytes(int frames) const
+{
+    return (frames / getFramesPerBlock() + 2) * getBytesPerBlock();
+}
+
 Encoder* Encoder::create(AudioFormat::Value format, int channels)
 {
     switch (format)
@@ -27,6 +33,9 @@ Encoder* Encoder::create(AudioFormat::Value format, int channels)
         case AudioFormat::k_adpcm:
             return new AdpcmEncoder(channels, Adpcm::k_samplesPerBlock);
 
+        case AudioFormat::k_lossless:
+            return new LosslessEncoder(channels);
+
         default:
             CK_FAIL("unknown format");
             return NULL;
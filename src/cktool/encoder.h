@@ -14,12 +14,20 @@ public:
     Encoder(int channels);
     virtual ~Encoder() {}
 
-    // writes encoded data into outBuf (size is assumed <= inBuf)
+    // writes encoded data into outBuf (size is assumed >= getMaxBytes(frames))
     // returns number of bytes written
     virtual int encode(const int16* inBuf, byte* outBuf, int frames, bool final) = 0; 
 
+    // data to write after the final block, if any
+    virtual int getTrailerBytes() const { return 0; }
+    virtual void writeTrailer(byte* outBuf) const {}
+
     virtual int getFramesPerBlock() const = 0;
-    virtual int getBytesPerBlock() const = 0;
+    virtual int getBytesPerBlock() const = 0; // for formats whose blocks vary in size, the largest
+
+    // most bytes encode() can write for the given number of frames, including
+    // a partial block left from the previous call
+    int getMaxBytes(int frames) const;
 
     static Encoder* create(AudioFormat::Value format, int channels);
 
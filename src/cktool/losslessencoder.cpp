@@ -0,0 +1,102 @@
+#include "losslessencoder.h"
+#include "ck/audio/lossless.h"
+#include "ck/core/debug.h"
+#include "ck/core/mem.h"
+#include "ck/core/math.h"
+
+// template definitions
+#include "ck/core/array.cpp"
+
+
+namespace Cki
+{
+
+
+LosslessEncoder::LosslessEncoder(int channels) :
+    Encoder(channels),
+    m_inputFrames(0),
+    m_bytesEncoded(0),
+    m_lastBlockFrames(0)
+{
+    CK_ASSERT(channels > 0 && channels <= 2);
+    m_input = Mem::allocArray<int16>(Lossless::k_blockFrames * channels);
+}
+
+LosslessEncoder::~LosslessEncoder()
+{
+    Mem::free(m_input);
+}
+
+int LosslessEncoder::encode(const int16* inBuf, byte* outBuf, int frames, bool final)
+{
+    const int blockFrames = Lossless::k_blockFrames;
+
+    int framesCopied = 0;
+    int bytesEncoded = 0;
+    while (framesCopied < frames)
+    {
+        // copy input data
+        int framesToCopy = Math::min(blockFrames - m_inputFrames, frames - framesCopied);
+        Mem::copy(m_input + m_inputFrames * m_channels, inBuf + framesCopied * m_channels, framesToCopy * m_channels * sizeof(int16));
+        framesCopied += framesToCopy;
+
+        m_inputFrames += framesToCopy;
+        CK_ASSERT(m_inputFrames <= blockFrames);
+        if (m_inputFrames >= blockFrames)
+        {
+            // we have a full block's worth of input
+            bytesEncoded += encodeBlock(outBuf + bytesEncoded);
+            m_inputFrames = 0;
+        }
+    }
+
+    if (final && m_inputFrames)
+    {
+        // fill rest of final buffer with 0s; the decoder only outputs the
+        // frames that were input
+        Mem::clear(m_input + m_inputFrames * m_channels, (blockFrames - m_inputFrames) * m_channels * sizeof(int16));
+        bytesEncoded += encodeBlock(outBuf + bytesEncoded);
+        m_inputFrames = 0;
+    }
+
+    return bytesEncoded;
+}
+
+int LosslessEncoder::getTrailerBytes() const
+{
+    return Lossless::getTableBytes(m_blockOffsets.getSize());
+}
+
+void LosslessEncoder::writeTrailer(byte* outBuf) const
+{
+    // block offset table
+    for (int i = 0; i < m_blockOffsets.getSize(); ++i)
+    {
+        Lossless::setBlockOffset(outBuf, i, m_blockOffsets[i]);
+    }
+    Lossless::setLastBlockFrames(outBuf, m_blockOffsets.getSize(), m_lastBlockFrames);
+}
+
+int LosslessEncoder::getFramesPerBlock() const
+{
+    return Lossless::k_blockFrames;
+}
+
+int LosslessEncoder::getBytesPerBlock() const
+{
+    return Lossless::getMaxBlockBytes(m_channels);
+}
+
+////////////////////////////////////////
+
+int LosslessEncoder::encodeBlock(byte* outBuf)
+{
+    m_blockOffsets.append(m_bytesEncoded);
+    int bytes = Lossless::encodeBlock(m_input, m_channels, outBuf);
+    m_bytesEncoded += bytes;
+    m_lastBlockFrames = m_inputFrames;
+    return bytes;
+}
+
+
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/core/array.h"
+#include "encoder.h"
+
+namespace Cki
+{
+
+
+class LosslessEncoder : public Encoder
+{
+public:
+    LosslessEncoder(int channels);
+    virtual ~LosslessEncoder();
+
+    virtual int encode(const int16* inBuf, byte* outBuf, int frames, bool final); 
+    virtual int getTrailerBytes() const;
+    virtual void writeTrailer(byte* outBuf) const;
+    virtual int getFramesPerBlock() const;
+    virtual int getBytesPerBlock() const;
+
+private:
+    int16* m_input; // interleaved input data
+    int m_inputFrames; 
+    Array<int> m_blockOffsets; // offset of each block written so far
+    int m_bytesEncoded;
+    int m_lastBlockFrames; // input frames in the last block written
+
+    int encodeBlock(byte* outBuf);
+};
+
+
+}
@@ -15,9 +15,13 @@
 #include "ck/audio/sample.h"
 #include "ck/audio/bankdata.h"
 #include "ck/audio/bank.h"
+#include "ck/audio/sampleindex.h"
 #include "ck/audio/wavwriter.h"
 #include "ck/audio/audioutil.h"
+#include "ck/audio/lossless.h"
 #include "encoder.h"
+#include "encodequeue.h"
+#include "samplecache.h"
 #include "argparser.h"
 #include "audioreader.h"
 #include "tinyxml.h"
@@ -69,6 +73,7 @@ Format g_formats[] =
     { "pcm16", AudioFormat::k_pcmI16 },
     { "pcm8", AudioFormat::k_pcmI8 },
     { "adpcm", AudioFormat::k_adpcm },
+    { "lossless", AudioFormat::k_lossless },
 };
 
 AudioFormat::Value parseFormat(const char* str)
@@ -114,11 +119,63 @@ const char* k_panAttr       = "pan";
 const char* k_loopStartAttr = "loopStart";
 const char* k_loopEndAttr   = "loopEnd";
 const char* k_loopCountAttr = "loopCount";
+const char* k_hotAttr       = "hot";
 
 
 ////////////////////////////////////////
+// encoding options
 
-bool buildSampleInfo(SampleInfo& sampleInfo, const char* path, const TiXmlElement* soundElem, Encoder*& encoder, AudioReader*& reader)
+const char* k_jobsOption    = "jobs";
+const char* k_cacheOption   = "cache";
+
+// number of threads to encode samples on (default is one per processor)
+int getEncodeThreads()
+{
+    int threads;
+    if (g_parser->getIntOption(k_jobsOption, threads) && threads > 0)
+    {
+        return threads;
+    }
+    return EncodeQueue::getNumProcessors();
+}
+
+// cache of encoded samples, or NULL if none was specified
+SampleCache* newSampleCache()
+{
+    const char* dir = NULL;
+    if (!g_parser->getStringOption(k_cacheOption, dir))
+    {
+        return NULL;
+    }
+
+    SampleCache* cache = new SampleCache(dir);
+    if (!cache->isValid())
+    {
+        CK_PRINT("WARNING: could not create cache directory %s; samples will not be cached\n", dir);
+        delete cache;
+        cache = NULL;
+    }
+    return cache;
+}
+
+// encode the samples in the queue to the output file at dataPos; those whose
+// size is not known in advance must already have been encoded
+bool writeSamples(EncodeQueue& queue, FileStream& outFile, int dataPos)
+{
+    int threads = getEncodeThreads();
+    CK_PRINT("encoding %d samples (%d threads)\n", queue.getNumSamples(), Math::clamp(threads, 1, Math::max(queue.getNumSamples(), 1)));
+    bool success = queue.write(outFile, dataPos, threads);
+    if (queue.getNumCached() > 0)
+    {
+        CK_PRINT("  %d samples copied from cache\n", queue.getNumCached());
+    }
+    return success;
+}
+
+
+////////////////////////////////////////
+
+bool buildSampleInfo(SampleInfo& sampleInfo, const char* path, const TiXmlElement* soundElem)
 {
     if (!FileStream::exists(path))
     {
@@ -126,7 +183,7 @@ bool buildSampleInfo(SampleInfo& sampleInfo, const char* path, const TiXmlElemen
         return false;
     }
 
-    reader = AudioReader::create(path);
+    AudioReader* reader = AudioReader::create(path);
     if (!reader)
     {
         CK_PRINT("  ERROR: %s: invalid audio file!\n", path);
@@ -262,7 +319,23 @@ bool buildSampleInfo(SampleInfo& sampleInfo, const char* path, const TiXmlElemen
         }
     }
 
-    encoder = Encoder::create(format, reader->getChannels());
+    // hot (keep decoded in the decode cache; bank sounds only)
+    const char* hotStr = soundElem->Attribute(k_hotAttr);
+    bool hot = false;
+    if (hotStr)
+    {
+        if (!strcmp(hotStr, "true") || !strcmp(hotStr, "1"))
+        {
+            hot = true;
+            CK_PRINT("  hot\n");
+        }
+        else if (strcmp(hotStr, "false") && strcmp(hotStr, "0"))
+        {
+            CK_PRINT("  WARNING: could not parse hot \"%s\"\n", hotStr);
+        }
+    }
+
+    Encoder* encoder = Encoder::create(format, reader->getChannels());
 
     // actual frames must be multiple of blocks
     int inFrames = reader->getFrames();
@@ -270,7 +343,12 @@ bool buildSampleInfo(SampleInfo& sampleInfo, const char* path, const TiXmlElemen
     int blocks = (inFrames + framesPerBlock - 1) / framesPerBlock;
     int outFrames = blocks * framesPerBlock;
     CK_ASSERT(outFrames >= inFrames);
-    if (outFrames != inFrames)
+    if (format == AudioFormat::k_lossless)
+    {
+        // the last block is padded, but records how much of it is used
+        outFrames = inFrames;
+    }
+    else if (outFrames != inFrames)
     {
         CK_PRINT("  padding with %d sample frames of silence at end to fill last block\n", outFrames - inFrames);
     }
@@ -317,6 +395,10 @@ bool buildSampleInfo(SampleInfo& sampleInfo, const char* path, const TiXmlElemen
     sampleInfo.loopStart = (uint32) loopStart;
     sampleInfo.loopEnd = (uint32) loopEnd;
     sampleInfo.loopCount = (int16) loopCount;
+    sampleInfo.flags = (uint16) (hot ? SampleInfo::k_hot : 0);
+
+    delete encoder;
+    delete reader;
 
     return true;
 }
@@ -326,7 +408,7 @@ bool buildSampleInfo(SampleInfo& sampleInfo, const char* path, const TiXmlElemen
 ////////////////////////////////////////
 // bank
 
-bool buildSample(Sample& sample, const TiXmlElement* soundElem, const char* inDir)
+bool buildSample(Sample& sample, EncodeQueue& queue, const TiXmlElement* soundElem, const char* inDir)
 {
     // name
     const char* name = soundElem->Attribute(k_nameAttr);
@@ -357,36 +439,12 @@ bool buildSample(Sample& sample, const TiXmlElement* soundElem, const char* inDi
     }
 
 
-    Encoder* encoder;
-    AudioReader* reader;
-    if (buildSampleInfo(sample.info, sourcePath.getBuffer(), soundElem, encoder, reader))
+    if (buildSampleInfo(sample.info, sourcePath.getBuffer(), soundElem))
     {
-        // read source data
-        int outFrames = sample.info.blocks * sample.info.blockFrames;
-        int outSamples = outFrames * sample.info.channels;
-        int inFrames = reader->getFrames();
-        int inSamples = inFrames * sample.info.channels;
-
-        int16* srcSamples = new int16[outSamples];
-        reader->read(srcSamples, inSamples);
-        delete reader;
-
-        // pad with zeroes
-        for (int i = inSamples; i < outSamples; ++i)
-        {
-            srcSamples[i] = 0;
-        }
-
-        // allocate destination data (assume size <= source data)
-        Cki::byte* destSamples = new Cki::byte[outSamples * sizeof(int16)];
-
-        sample.dataSize = encoder->encode(srcSamples, destSamples, outFrames, true);
-        sample.data = destSamples;
-        CK_ASSERT(sample.dataSize == sample.info.blocks * sample.info.blockBytes);
-
-        delete encoder;
-        delete[] srcSamples;
-
+        // data is encoded later; its size is set once it has been encoded
+        sample.dataSize = 0;
+        sample.data = NULL;
+        queue.add(sourcePath.getBuffer(), sample.info);
         return true;
     }
     else
@@ -402,7 +460,8 @@ bool buildBank(TiXmlDocument& bankDoc, const char* inDir, const char* outPath, b
 
     BankData bank;
 
-    Array<Cki::byte*> buffers;
+    SampleCache* cache = newSampleCache();
+    EncodeQueue queue(cache, outPath);
 
     // parse root bank element
     TiXmlElement* bankElem = bankDoc.FirstChildElement("bank");
@@ -437,16 +496,16 @@ bool buildBank(TiXmlDocument& bankDoc, const char* inDir, const char* outPath, b
 
         Sample sample;
 
-        if (buildSample(sample, soundElem, inDir))
+        if (buildSample(sample, queue, soundElem, inDir))
         {
             bank.addSample(sample);
-            buffers.append(sample.data);
         }
         else
         {
             if (single)
             {
                 // don't write bank file, since this is the only sound and it failed
+                delete cache;
                 return false;
             }
         }
@@ -454,6 +513,18 @@ bool buildBank(TiXmlDocument& bankDoc, const char* inDir, const char* outPath, b
         soundElem = soundElem->NextSiblingElement("sound");
     }
 
+    // the size of the sample data is not known for every format until it has
+    // been encoded, so those samples are encoded before the bank is written
+    if (!queue.encode(getEncodeThreads()))
+    {
+        delete cache;
+        return false;
+    }
+    for (int i = 0; i < bank.getNumSamples(); ++i)
+    {
+        bank.getSample(i).dataSize = queue.getDataSize(i);
+    }
+
     bool success;
 
     // TODO check for overwrite?
@@ -471,8 +542,28 @@ bool buildBank(TiXmlDocument& bankDoc, const char* inDir, const char* outPath, b
         fileHeader.fileVersion = FileHeader::k_version;
         stream << fileHeader;
 
+        // the sample data follows the bank, in order; it is written last
         stream << bank;
-        success = true;
+        int dataPos = stream.getSize();
+
+        // name index goes after the sample data, 4-byte aligned
+        stream.setPos(dataPos + queue.getDataSize());
+        while (stream.getPos() % 4 != 0)
+        {
+            stream << (Cki::uint8) 0;
+        }
+        int collisions = SampleIndex::write(stream, bank);
+        if (collisions > 0)
+        {
+            CK_PRINT("WARNING: %d sound names have the same hash as another; CkSound::newBankSound() with a CkSoundId may not find them\n", collisions);
+        }
+
+        success = writeSamples(queue, outFile, dataPos);
+        outFile.close();
+        if (!success)
+        {
+            FileStream::destroy(outPath);
+        }
     }
     else
     {
@@ -480,10 +571,7 @@ bool buildBank(TiXmlDocument& bankDoc, const char* inDir, const char* outPath, b
         success = false;
     }
 
-    for (int i = 0; i < buffers.getSize(); ++i)
-    {
-        delete[] buffers[i];
-    }
+    delete cache;
 
     return success;
 }
@@ -557,6 +645,18 @@ bool buildBankFromXml(const char* inFilename, const char* outFilename)
 ////////////////////////////////////////
 // extract
 
+// frames of a bank sample, which for lossless may end partway into the last block
+int getFrames(const SampleInfo& sampleInfo, const Cki::byte* data, int bytes)
+{
+    int frames = sampleInfo.blocks * sampleInfo.blockFrames;
+    if (sampleInfo.format == AudioFormat::k_lossless && sampleInfo.blocks > 0)
+    {
+        const Cki::byte* table = data + bytes - Lossless::getTableBytes(sampleInfo.blocks);
+        frames -= sampleInfo.blockFrames - Lossless::getLastBlockFrames(table, sampleInfo.blocks);
+    }
+    return frames;
+}
+
 bool extract(const Path& outPath, const SampleInfo& sampleInfo, const Cki::byte* data, int bytes)
 {
     int frames = sampleInfo.blocks * sampleInfo.blockFrames;
@@ -596,12 +696,27 @@ bool extract(const Path& outPath, const SampleInfo& sampleInfo, const Cki::byte*
             AudioUtil::convert((const float*) data, outBuf, outSamples);
             break;
 
+        case AudioFormat::k_lossless:
+            {
+                const Cki::byte* pIn = data;
+                float* pOut = outBuf;
+                for (int i = 0; i < sampleInfo.blocks; ++i)
+                {
+                    pIn += Lossless::decodeBlock(pIn, sampleInfo.channels, pOut);
+                    pOut += Lossless::k_blockFrames * sampleInfo.channels;
+                }
+            }
+            break;
+
         default:
             CK_PRINT("ERROR: unknown sample format: %d\n", sampleInfo.format);
             delete[] outBuf;
             return false;
     }
 
+    // the padding of a lossless sample's last block is not written
+    outSamples = sampleInfo.channels * getFrames(sampleInfo, data, bytes);
+
     WavWriter writer(outPath.getBuffer(), sampleInfo.channels, sampleInfo.sampleRate, false);
     if (!writer.isValid())
     {
@@ -626,10 +741,15 @@ bool buildStream(const char* inFilename, const char* outFilename, TiXmlElement*
 
     SampleInfo sampleInfo;
 
-    Encoder* encoder;
-    AudioReader* reader;
-    if (buildSampleInfo(sampleInfo, inFilename, soundElem, encoder, reader))
+    if (buildSampleInfo(sampleInfo, inFilename, soundElem))
     {
+        if (sampleInfo.format == AudioFormat::k_lossless)
+        {
+            // stream data is read a fixed number of bytes per block
+            CK_PRINT("ERROR: lossless format can only be used for bank sounds\n");
+            return false;
+        }
+
         // if output file not specified, use input file with ".cks" extension
         // TODO test for overwriting?
         Path outPath(outFilename ? outFilename : inFilename);
@@ -659,25 +779,23 @@ bool buildStream(const char* inFilename, const char* outFilename, TiXmlElement*
 
         stream << sampleInfo;
 
-        // dump out data
-        const int k_bufSamples = 1024;
-        int16 srcSamples[k_bufSamples];
-        int16 destSamples[k_bufSamples];
-
-        int dataBytes = 0;
-        while (!reader->isAtEnd())
+        // data follows the sample info
+        SampleCache* cache = newSampleCache();
+        EncodeQueue queue(cache, outPath.getBuffer());
+        queue.add(inFilename, sampleInfo);
+        bool success = queue.encode(1) && queue.write(outFile, stream.getPos(), 1);
+        if (queue.getNumCached() > 0)
         {
-            int samples = reader->read(srcSamples, k_bufSamples);
-            int bytes = encoder->encode(srcSamples, (Cki::byte*) destSamples, samples/sampleInfo.channels, reader->isAtEnd());
-            outFile.write(destSamples, bytes);
-            dataBytes += bytes;
+            CK_PRINT("  copied from cache\n");
         }
-        CK_ASSERT(dataBytes == sampleInfo.blocks * encoder->getBytesPerBlock());
-
-        delete encoder;
-        delete reader;
+        delete cache;
 
-        return true;
+        outFile.close();
+        if (!success)
+        {
+            FileStream::destroy(outPath.getBuffer());
+        }
+        return success;
     }
     else
     {
@@ -766,7 +884,7 @@ bool info(const char* path)
             for (int i = 0; i < bank->getNumSounds(); ++i)
             {
                 const Sample& sample = bank->getSample(i);
-                int frames = sample.info.blocks * sample.info.blockFrames;
+                int frames = getFrames(sample.info, sample.data, sample.dataSize);
                 CK_PRINT("\n");
                 CK_PRINT("  sound %d:\n", i);
                 CK_PRINT("      name:        %s\n", sample.name.getBuffer());
@@ -780,6 +898,10 @@ bool info(const char* path)
                 CK_PRINT("      pan:         %f\n", (float) sample.info.pan / CK_INT16_MAX);
                 CK_PRINT("      loop:        %d,%d\n", (int) sample.info.loopStart, (int) sample.info.loopEnd);
                 CK_PRINT("      loop count:  %d\n", (int) sample.info.loopCount);
+                if (sample.info.flags & SampleInfo::k_hot)
+                {
+                    CK_PRINT("      hot\n");
+                }
             }
             bank->destroy();
         }
@@ -881,13 +1003,13 @@ void printUsage(const char* app)
     CK_PRINT("\n");
     CK_PRINT("Usage:\n");
     CK_PRINT("\n");
-    CK_PRINT(" %s buildbank   [common_options] <infile> [<outfile>]\n", toolName);
+    CK_PRINT(" %s buildbank   [common_options] [encoding_options] <infile> [<outfile>]\n", toolName);
     CK_PRINT("   builds a bank file (.ckb) from an xml bank description file (.ckbx)\n");
     CK_PRINT("\n");
-    CK_PRINT(" %s buildbank   [common_options] -single [sound_attributes] <infile> [<outfile>]\n", toolName);
+    CK_PRINT(" %s buildbank   [common_options] [encoding_options] -single [sound_attributes] <infile> [<outfile>]\n", toolName);
     CK_PRINT("   builds a bank file (.ckb) containing one sound\n");
     CK_PRINT("\n");
-    CK_PRINT(" %s buildstream [common_options] [sound_attributes] <infile> [<outfile>]\n", toolName);
+    CK_PRINT(" %s buildstream [common_options] [encoding_options] [sound_attributes] <infile> [<outfile>]\n", toolName);
     CK_PRINT("   builds a stream file (.cks)\n");
     CK_PRINT("\n");
     CK_PRINT(" %s info [common_options] <file>\n", toolName);
@@ -901,6 +1023,10 @@ void printUsage(const char* app)
     CK_PRINT("Available common options are:\n");
     CK_PRINT("  -verbose\n");
     CK_PRINT("\n");
+    CK_PRINT("Available encoding options are:\n");
+    CK_PRINT("  -jobs <count>       number of samples to encode at once (default: number of processors)\n");
+    CK_PRINT("  -cache <dir>        reuse encoded samples whose source and format haven't changed\n");
+    CK_PRINT("\n");
     CK_PRINT("Available sound attribute options are:\n");
     CK_PRINT("  -format <format>\n");
     CK_PRINT("  -volume <volume>\n");
@@ -938,6 +1064,10 @@ int run(int argc, char* const argv[])
     // common options
     g_parser->addFlag("verbose");
 
+    // encoding options
+    g_parser->addIntOption(k_jobsOption);
+    g_parser->addStringOption(k_cacheOption);
+
     // attribute options
     g_parser->addStringOption(k_formatAttr);
     g_parser->addStringOption(k_volumeAttr);
@@ -0,0 +1,116 @@
+#include "samplecache.h"
+#include "ck/core/dir.h"
+#include "ck/core/filestream.h"
+#include "ck/core/thread.h"
+#include "ck/core/debug.h"
+#include "ck/audio/sampleinfo.h"
+#include <stdio.h>
+#include <string.h>
+#if CK_PLATFORM_WIN
+#  include <process.h>
+#  define getpid _getpid
+#else
+#  include <unistd.h>
+#endif
+
+namespace Cki
+{
+
+
+namespace
+{
+    // change this if the encoders change, so old cached data isn't used
+    const int32 k_cacheVersion = 2;
+
+    void getName(const SampleCache::Key& key, char* name)
+    {
+        for (int i = 0; i < MD5::k_hashLen; ++i)
+        {
+            sprintf(name + i*2, "%02x", key.hash[i]);
+        }
+    }
+
+    void hashValue(MD5& md5, int32 value)
+    {
+        md5.update((const byte*) &value, sizeof(value));
+    }
+}
+
+
+SampleCache::SampleCache(const char* dir) :
+    m_dir(dir),
+    m_valid(false)
+{
+    m_valid = (Dir::exists(dir) || Dir::create(dir));
+}
+
+bool SampleCache::isValid() const
+{
+    return m_valid;
+}
+
+bool SampleCache::getKey(const char* sourcePath, const SampleInfo& info, Key& key)
+{
+    FileStream file(sourcePath, FileStream::k_read);
+    if (!file.isValid())
+    {
+        return false;
+    }
+
+    MD5 md5;
+    hashValue(md5, k_cacheVersion);
+    hashValue(md5, info.format);
+    hashValue(md5, info.channels);
+    hashValue(md5, info.blocks);
+    hashValue(md5, info.blockBytes);
+    hashValue(md5, info.blockFrames);
+
+    const int k_bufBytes = 64 * 1024;
+    byte* buf = new byte[k_bufBytes];
+    int bytes;
+    while ((bytes = file.read(buf, k_bufBytes)) > 0)
+    {
+        md5.update(buf, bytes);
+    }
+    delete[] buf;
+
+    md5.finish();
+    memcpy(key.hash, md5.getHash(), MD5::k_hashLen);
+    return true;
+}
+
+void SampleCache::getPath(const Key& key, Path& path) const
+{
+    char name[MD5::k_hashLen*2 + 1];
+    getName(key, name);
+    path = m_dir;
+    path.appendChild(name);
+    path.setExtension("ckc");
+}
+
+void SampleCache::getTempPath(const Key& key, Path& path) const
+{
+    getPath(key, path);
+    char suffix[32];
+    sprintf(suffix, ".%d.%d", (int) getpid(), Thread::getCurrentThreadId());
+    path.append(suffix);
+}
+
+bool SampleCache::commit(const Key& key)
+{
+    Path tempPath;
+    Path path;
+    getTempPath(key, tempPath);
+    getPath(key, path);
+
+    // if another process has already added it, keep that one
+    if (rename(tempPath.getBuffer(), path.getBuffer()) != 0)
+    {
+        FileStream::destroy(tempPath.getBuffer());
+        return FileStream::exists(path.getBuffer());
+    }
+    return true;
+}
+
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "ck/core/platform.h"
+#include "ck/core/types.h"
+#include "ck/core/path.h"
+#include "ck/core/md5.h"
+
+namespace Cki
+{
+
+struct SampleInfo;
+class FileStream;
+
+
+// Encoded sample data from earlier builds, one file per sample, named by a
+// hash of the source audio file's contents and the encoding settings; a sound
+// whose source file and format have not changed is copied from the cache
+// instead of being encoded again.
+// Other attributes (volume, pan, loops) are not part of the encoded data, so
+// changing them does not invalidate it.
+class SampleCache
+{
+public:
+    SampleCache(const char* dir);
+
+    bool isValid() const;
+
+    struct Key
+    {
+        byte hash[MD5::k_hashLen];
+    };
+
+    // Hash the source file and encoding settings; returns false if the
+    // source could not be read.
+    static bool getKey(const char* sourcePath, const SampleInfo&, Key&);
+
+    // Path of the cached data for a key.
+    void getPath(const Key&, Path&) const;
+
+    // Path to write new data to before it is moved into place with commit();
+    // unique to the thread, so several threads (or several cktool processes
+    // sharing a cache) don't write to the same file.
+    void getTempPath(const Key&, Path&) const;
+    bool commit(const Key&);
+
+private:
+    Path m_dir;
+    bool m_valid;
+};
+
+
+}
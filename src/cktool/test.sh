@@ -24,6 +24,12 @@ function runTest()
    $1 info test.ckb >> test.log || exit 1
    rm test.ckb
 
+   # build twice with a cache; the second build should copy every sound from it
+   $1 buildbank -cache testcache ../test/srcassets/test.ckbx test.ckb >> test.log || exit 1
+   $1 buildbank -cache testcache -jobs 2 ../test/srcassets/test.ckbx test2.ckb >> test.log || exit 1
+   cmp test.ckb test2.ckb || exit 1
+   rm -r test.ckb test2.ckb testcache
+
    $1 buildbank -single ../test/srcassets/benfolds.wav benfolds.ckb >> test.log || exit 1
    $1 info benfolds.ckb >> test.log || exit 1
    rm benfolds.ckb
@@ -32,6 +38,10 @@ function runTest()
    $1 info benfolds.ckb >> test.log || exit 1
    rm benfolds.ckb
 
+   $1 buildbank -single -format lossless ../test/srcassets/benfolds.wav benfolds.ckb >> test.log || exit 1
+   $1 info benfolds.ckb >> test.log || exit 1
+   rm benfolds.ckb
+
    $1 buildstream ../test/srcassets/benfolds.wav benfolds.cks >> test.log || exit 1
    $1 info benfolds.cks >> test.log || exit 1
    rm benfolds.cks